@@ -1,7 +1,12 @@
 #!/opt/local/bin/python
 
+import asyncio
 from pmix import *
 
+async def fetch(client, n):
+    results = await asyncio.gather(*[client.get_nb(None, "my.blob") for i in range(n)])
+    print("Async gets ", sum(1 for rc, val in results if 0 == rc), " of ", n, " succeeded")
+
 def main():
     foo = PMIxClient()
     print("Testing PMIx ", foo.get_version())
@@ -11,7 +16,25 @@ def main():
     if 0 != my_result:
         print("FAILED TO INIT")
         exit(1)
-    # try getting something
+    # post a blob - anything exporting the buffer protocol
+    # is sent straight from its memory
+    blob = bytearray(1024 * 1024)
+    rc = foo.put(PMIX_GLOBAL, "my.blob", blob)
+    print("Put result ", rc)
+    rc = foo.commit()
+    print("Commit result ", rc)
+    rc = foo.fence()
+    print("Fence result ", rc)
+    # try getting something - byte objects come back without
+    # being copied, and can be viewed as-is
+    rc, val = foo.get(None, "my.blob")
+    print("Get result ", rc)
+    if 0 == rc:
+        view = memoryview(val)
+        print("Retrieved ", view.nbytes, " bytes")
+    # the same from asyncio, with many requests in flight
+    # and no thread per request
+    asyncio.run(fetch(foo, 100))
 
     # finalize
     info = {}
@@ -399,6 +399,9 @@ def harvest_constants(options, src, constants, definitions):
             defsrc = True
         definitions.write("\n    # APIS\n")
         for api in apis:
+            # none of the APIs touch Python objects, so let
+            # the bindings call them with the GIL released
+            api[-1] = api[-1] + " nogil"
             definitions.write("    " + api[0] + "\n")
             if len(api) > 1:
                 # find the opening paren
@@ -2,26 +2,216 @@ from libc.string cimport memset,strncpy, strdup
 from libc.stdlib cimport malloc, free
 from libc.string cimport memcpy
 from cpython.mem cimport PyMem_Malloc, PyMem_Realloc, PyMem_Free
+from cpython.buffer cimport PyObject_CheckBuffer, PyBUF_FORMAT, PyBUF_WRITABLE
 
 # pull in all the constant definitions - we
 # store them in a separate file for neatness
 include "pmix_constants.pxi"
 
+# macros used to release what the library hands back
+cdef extern from "pmix_common.h":
+    void PMIX_VALUE_RELEASE(pmix_value_t *m) nogil
+    void PMIX_INFO_DESTRUCT(pmix_info_t *m) nogil
+    void PMIX_INFO_XFER(pmix_info_t *d, pmix_info_t *s) nogil
+    pmix_status_t pmix_value_xfer(pmix_value_t *kv, const pmix_value_t *src) nogil
+    # the C constant, for use without the GIL
+    pmix_status_t PYPMIX_SUCCESS "PMIX_SUCCESS"
+
 # provide conversion programs that translate incoming
 # PMIx structures into Python dictionaries, and incoming
 # arrays into Python lists of objects
 
 
+# A byte object handed to us by the library. Python sees it
+# through the buffer protocol, so memoryview() and
+# numpy.frombuffer() use the library's memory directly - the
+# object owns that memory and frees it when the last view of
+# it is gone
+cdef class PMIxByteObject:
+    cdef char *bytes
+    cdef size_t size
+    cdef Py_ssize_t shape[1]
+
+    def __cinit__(self):
+        self.bytes = NULL
+        self.size = 0
+
+    def __len__(self):
+        return self.size
+
+    def __getbuffer__(self, Py_buffer *buffer, int flags):
+        self.shape[0] = <Py_ssize_t>self.size
+        buffer.buf = self.bytes
+        buffer.obj = self
+        buffer.len = <Py_ssize_t>self.size
+        buffer.itemsize = 1
+        buffer.readonly = 0
+        buffer.ndim = 1
+        buffer.format = 'B' if flags & PyBUF_FORMAT else NULL
+        buffer.shape = self.shape
+        buffer.strides = NULL
+        buffer.suboffsets = NULL
+        buffer.internal = NULL
+
+    def __releasebuffer__(self, Py_buffer *buffer):
+        pass
+
+    def __bytes__(self):
+        # this one does copy
+        return self.bytes[:self.size]
+
+    def __dealloc__(self):
+        if NULL != self.bytes:
+            free(self.bytes)
+
+# take the bytes of a byte object - the caller's copy is
+# left empty so releasing it does not free them
+cdef object pmix_bo_to_py(pmix_byte_object_t *bo):
+    cdef PMIxByteObject pybo = PMIxByteObject()
+    pybo.bytes = bo.bytes
+    pybo.size = bo.size
+    bo.bytes = NULL
+    bo.size = 0
+    return pybo
+
+cdef object pmix_proc_to_py(const pmix_proc_t *proc):
+    return {'nspace': proc.nspace.decode('ascii'), 'rank': proc.rank}
+
+cdef int py_to_pmix_proc(pmix_proc_t *proc, pyproc) except -1:
+    nspace = pyproc['nspace']
+    if isinstance(nspace, str):
+        nspace = nspace.encode('ascii')
+    memset(proc.nspace, 0, sizeof(proc.nspace))
+    strncpy(proc.nspace, nspace, sizeof(proc.nspace) - 1)
+    proc.rank = pyproc['rank']
+    return 0
+
+# convert a value to its Python form - byte objects are
+# taken from the value rather than copied
+cdef object pmix_value_to_py(pmix_value_t *value):
+    cdef size_t n
+    cdef pmix_info_t *iptr
+    cdef pmix_proc_t *pptr
+    if value.type == PMIX_BOOL:
+        return bool(value.data.flag)
+    elif value.type == PMIX_BYTE:
+        return value.data.byte
+    elif value.type == PMIX_STRING:
+        if NULL == value.data.string:
+            return None
+        return value.data.string.decode('utf-8')
+    elif value.type == PMIX_SIZE:
+        return value.data.size
+    elif value.type == PMIX_PID:
+        return value.data.pid
+    elif value.type == PMIX_INT:
+        return value.data.integer
+    elif value.type == PMIX_INT8:
+        return value.data.int8
+    elif value.type == PMIX_INT16:
+        return value.data.int16
+    elif value.type == PMIX_INT32:
+        return value.data.int32
+    elif value.type == PMIX_INT64:
+        return value.data.int64
+    elif value.type == PMIX_UINT:
+        return value.data.uint
+    elif value.type == PMIX_UINT8:
+        return value.data.uint8
+    elif value.type == PMIX_UINT16:
+        return value.data.uint16
+    elif value.type == PMIX_UINT32:
+        return value.data.uint32
+    elif value.type == PMIX_UINT64:
+        return value.data.uint64
+    elif value.type == PMIX_FLOAT:
+        return value.data.fval
+    elif value.type == PMIX_DOUBLE:
+        return value.data.dval
+    elif value.type == PMIX_TIME:
+        return value.data.time
+    elif value.type == PMIX_STATUS:
+        return value.data.status
+    elif value.type == PMIX_PROC_RANK:
+        return value.data.rank
+    elif value.type == PMIX_PROC:
+        return pmix_proc_to_py(value.data.proc)
+    elif value.type == PMIX_BYTE_OBJECT or value.type == PMIX_COMPRESSED_STRING:
+        return pmix_bo_to_py(&value.data.bo)
+    elif value.type == PMIX_DATA_ARRAY:
+        if NULL == value.data.darray:
+            return []
+        if value.data.darray.type == PMIX_INFO:
+            iptr = <pmix_info_t*>value.data.darray.array
+            return {iptr[n].key.decode('ascii'): pmix_value_to_py(&iptr[n].value)
+                    for n in range(value.data.darray.size)}
+        if value.data.darray.type == PMIX_PROC:
+            pptr = <pmix_proc_t*>value.data.darray.array
+            return [pmix_proc_to_py(&pptr[n]) for n in range(value.data.darray.size)]
+    raise TypeError("PMIx data type " + PMIx_Data_type_string(value.type).decode('ascii') +
+                    " has no Python conversion")
+
+# load a Python value into a pmix_value_t without copying it. The
+# value points into the Python object, so the objects appended to
+# keep must outlive any use of the value, and the value must never
+# be destructed - which is fine for passing to the library, as it
+# takes its own copy of anything it retains
+cdef int py_to_pmix_value(pmix_value_t *value, pyval, list keep) except -1:
+    cdef const unsigned char[::1] view
+    if isinstance(pyval, bool):
+        value.type = PMIX_BOOL
+        value.data.flag = pyval
+    elif isinstance(pyval, int):
+        value.type = PMIX_INT64
+        value.data.int64 = pyval
+    elif isinstance(pyval, float):
+        value.type = PMIX_DOUBLE
+        value.data.dval = pyval
+    elif isinstance(pyval, str):
+        pybytes = pyval.encode('utf-8')
+        keep.append(pybytes)
+        value.type = PMIX_STRING
+        value.data.string = pybytes
+    elif isinstance(pyval, dict) and 'nspace' in pyval and 'rank' in pyval:
+        pybytes = bytearray(sizeof(pmix_proc_t))
+        keep.append(pybytes)
+        value.type = PMIX_PROC
+        value.data.proc = <pmix_proc_t*><char*>pybytes
+        py_to_pmix_proc(value.data.proc, pyval)
+    elif PyObject_CheckBuffer(pyval):
+        # bytes, bytearray, memoryview, numpy arrays... - point
+        # at the caller's memory rather than copy it
+        view = memoryview(pyval).cast('B')
+        keep.append(view)
+        value.type = PMIX_BYTE_OBJECT
+        value.data.bo.size = view.shape[0]
+        value.data.bo.bytes = <char*>&view[0] if 0 < view.shape[0] else NULL
+    else:
+        raise TypeError("no PMIx conversion for " + type(pyval).__name__)
+    return 0
+
+cdef int py_to_pmix_key(char *key, pykey) except -1:
+    if isinstance(pykey, str):
+        pykey = pykey.encode('ascii')
+    if len(pykey) > PMIX_MAX_KEYLEN:
+        raise KeyError(pykey)
+    memset(key, 0, PMIX_MAX_KEYLEN+1)
+    memcpy(key, <const char*>pykey, len(pykey))
+    return 0
+
 cdef class PMIxInfoArray:
     cdef pmix_info_t* array
     cdef size_t ninfo
+    cdef list keep
 
     def __cinit__(self, size_t number):
         # allocate some memory (uninitialised, may contain arbitrary data)
         self.array = <pmix_info_t*> PyMem_Malloc(number * sizeof(pmix_info_t))
         if not self.array:
             raise MemoryError()
+        memset(self.array, 0, number * sizeof(pmix_info_t))
         self.ninfo = number
+        self.keep = []
 
     def load(self, keyvals:dict):
         kvkeys = list(keyvals.keys())
@@ -29,29 +219,17 @@ cdef class PMIxInfoArray:
             raise IndexError()
         n = 0
         for key in kvkeys:
-            klen = len(key)
-            if isinstance(key, str):
-                pykey = key.encode('ascii')
-            else:
-                pykey = key
-            pykeyptr = <const char *>(pykey)
-            memset(self.array[n].key, 0, PMIX_MAX_KEYLEN+1)
-            memcpy(self.array[n].key, pykeyptr, klen)
-            # the value also needs to be transferred
-            if (isinstance(keyvals[key], str)):
-                self.array[n].value.type = PMIX_STRING
-                if isinstance(keyvals[key], str):
-                    pykey = keyvals[key].encode('ascii')
-                else:
-                    pykey = keyvals[key]
-                self.array[n].value.data.string = strdup(pykey)
+            py_to_pmix_key(self.array[n].key, key)
+            # the value points into keyvals, which we hold
+            # on to for as long as the array is in use
+            py_to_pmix_value(&self.array[n].value, keyvals[key], self.keep)
             n += 1
 
     def unload(self, infoarray:list):
         for n in range(self.ninfo):
             pyin = {}
-            pyin['key'] = self.array[n].key
-            pyin['value'] = "foo"
+            pyin['key'] = self.array[n].key.decode('ascii')
+            pyin['value'] = pmix_value_to_py(&self.array[n].value)
             infoarray.append(pyin)
 
     def __dealloc__(self):
@@ -3,8 +3,11 @@
 from libc.string cimport memset,strncpy, strdup
 from libc.stdlib cimport malloc, free
 from libc.string cimport memcpy
+from libc.stdint cimport uint64_t
+from posix.unistd cimport usleep, read, write
 from ctypes import addressof, c_int
 from cython.operator import address
+import asyncio
 
 # pull in all the constant definitions - we
 # store them in a separate file for neatness
@@ -12,6 +15,312 @@ include "pmix_constants.pxi"
 include "pmix.pxi"
 
 
+# take our own copy of an info array the library is
+# about to reclaim
+cdef size_t pypmix_copy_info(pmix_info_t *info, size_t ninfo,
+                             pmix_info_t **copy) nogil:
+    cdef size_t n
+    copy[0] = NULL
+    if 0 == ninfo or NULL == info:
+        return 0
+    copy[0] = <pmix_info_t*>malloc(ninfo * sizeof(pmix_info_t))
+    if NULL == copy[0]:
+        return 0
+    memset(copy[0], 0, ninfo * sizeof(pmix_info_t))
+    for n in range(ninfo):
+        PMIX_INFO_XFER(&copy[0][n], &info[n])
+    return ninfo
+
+cdef object pypmix_info_to_dict(pmix_info_t *info, size_t ninfo):
+    cdef size_t n
+    results = {}
+    for n in range(ninfo):
+        results[info[n].key.decode('ascii')] = pmix_value_to_py(&info[n].value)
+    return results
+
+# completion of a non-blocking call, filled in by the
+# library's progress thread while the caller waits with
+# the GIL released
+ctypedef struct pypmix_wait_t:
+    int active
+    pmix_status_t status
+    pmix_info_t *info
+    size_t ninfo
+
+cdef void pypmix_wait(pypmix_wait_t *wt) nogil:
+    while wt.active:
+        usleep(10)
+
+cdef void pypmix_opcb(pmix_status_t status, void *cbdata) nogil:
+    cdef pypmix_wait_t *wt = <pypmix_wait_t*>cbdata
+    wt.status = status
+    wt.active = 0
+
+cdef void pypmix_infocb(pmix_status_t status,
+                        pmix_info_t *info, size_t ninfo,
+                        void *cbdata,
+                        pmix_release_cbfunc_t release_fn,
+                        void *release_cbdata) nogil:
+    cdef pypmix_wait_t *wt = <pypmix_wait_t*>cbdata
+    wt.status = status
+    wt.ninfo = pypmix_copy_info(info, ninfo, &wt.info)
+    if NULL != release_fn:
+        release_fn(release_cbdata)
+    wt.active = 0
+
+
+# Non-blocking calls made from asyncio. Each call carries a
+# pypmix_op_t as its cbdata - the progress thread fills it in,
+# queues it and pokes an eventfd the event loop is watching. The
+# loop then drains the queue and resolves the futures, so any
+# number of calls can be outstanding without a thread apiece
+cdef extern from "sys/eventfd.h":
+    int eventfd(unsigned int initval, int flags) nogil
+    int EFD_NONBLOCK
+    int EFD_CLOEXEC
+
+cdef extern from "pthread.h":
+    ctypedef struct pthread_mutex_t:
+        pass
+    int pthread_mutex_init(pthread_mutex_t *m, void *attr) nogil
+    int pthread_mutex_lock(pthread_mutex_t *m) nogil
+    int pthread_mutex_unlock(pthread_mutex_t *m) nogil
+
+cdef enum:
+    PYPMIX_OP_STATUS        # resolves to the status
+    PYPMIX_OP_VALUE         # resolves to (status, value)
+    PYPMIX_OP_INFO          # resolves to (status, dictionary)
+    PYPMIX_OP_REFID         # resolves to (status, refid, queue)
+    PYPMIX_OP_EVENT         # an event for a registered handler
+
+cdef struct pypmix_op_t:
+    unsigned long id
+    int kind
+    pmix_status_t status
+    pmix_value_t *value
+    pmix_info_t *info
+    size_t ninfo
+    size_t refid
+    pmix_proc_t source
+    pypmix_op_t *next
+
+cdef pthread_mutex_t pypmix_lock
+pthread_mutex_init(&pypmix_lock, NULL)
+cdef pypmix_op_t *pypmix_done = NULL
+cdef int pypmix_efd = -1
+cdef unsigned long pypmix_nextid = 0
+_pypmix_loop = None
+_pypmix_pending = {}    # op id -> (future, objects the call points into, extra)
+_pypmix_handlers = {}   # event handler refid -> asyncio.Queue
+_pypmix_early = {}      # events that beat their handler's registration
+
+cdef void pypmix_complete(pypmix_op_t *op) nogil:
+    cdef uint64_t one = 1
+    pthread_mutex_lock(&pypmix_lock)
+    op.next = pypmix_done
+    pypmix_done = op
+    pthread_mutex_unlock(&pypmix_lock)
+    write(pypmix_efd, &one, sizeof(one))
+
+cdef void pypmix_async_opcb(pmix_status_t status, void *cbdata) nogil:
+    cdef pypmix_op_t *op = <pypmix_op_t*>cbdata
+    op.status = status
+    pypmix_complete(op)
+
+cdef void pypmix_async_valuecb(pmix_status_t status, pmix_value_t *kv,
+                               void *cbdata) nogil:
+    cdef pypmix_op_t *op = <pypmix_op_t*>cbdata
+    op.status = status
+    if NULL != kv:
+        op.value = <pmix_value_t*>malloc(sizeof(pmix_value_t))
+        if NULL != op.value:
+            memset(op.value, 0, sizeof(pmix_value_t))
+            if PYPMIX_SUCCESS != pmix_value_xfer(op.value, kv):
+                PMIX_VALUE_RELEASE(op.value)
+    pypmix_complete(op)
+
+cdef void pypmix_async_infocb(pmix_status_t status,
+                              pmix_info_t *info, size_t ninfo,
+                              void *cbdata,
+                              pmix_release_cbfunc_t release_fn,
+                              void *release_cbdata) nogil:
+    cdef pypmix_op_t *op = <pypmix_op_t*>cbdata
+    op.status = status
+    op.ninfo = pypmix_copy_info(info, ninfo, &op.info)
+    if NULL != release_fn:
+        release_fn(release_cbdata)
+    pypmix_complete(op)
+
+cdef void pypmix_async_regcb(pmix_status_t status, size_t refid,
+                             void *cbdata) nogil:
+    cdef pypmix_op_t *op = <pypmix_op_t*>cbdata
+    op.status = status
+    op.refid = refid
+    pypmix_complete(op)
+
+cdef void pypmix_async_evhdlr(size_t evhdlr_registration_id,
+                              pmix_status_t status,
+                              const pmix_proc_t *source,
+                              pmix_info_t info[], size_t ninfo,
+                              pmix_info_t *results, size_t nresults,
+                              pmix_event_notification_cbfunc_fn_t cbfunc,
+                              void *cbdata) nogil:
+    cdef pypmix_op_t *op = <pypmix_op_t*>malloc(sizeof(pypmix_op_t))
+    if NULL != op:
+        memset(op, 0, sizeof(pypmix_op_t))
+        op.kind = PYPMIX_OP_EVENT
+        op.status = status
+        op.refid = evhdlr_registration_id
+        if NULL != source:
+            memcpy(&op.source, source, sizeof(pmix_proc_t))
+        op.ninfo = pypmix_copy_info(info, ninfo, &op.info)
+        pypmix_complete(op)
+    # Python sees the event whenever its loop gets to it - let
+    # the library go on to any other handlers now
+    if NULL != cbfunc:
+        cbfunc(PYPMIX_SUCCESS, NULL, 0, NULL, NULL, cbdata)
+
+cdef void pypmix_op_free(pypmix_op_t *op):
+    cdef size_t n
+    if NULL != op.value:
+        PMIX_VALUE_RELEASE(op.value)
+    if NULL != op.info:
+        for n in range(op.ninfo):
+            PMIX_INFO_DESTRUCT(&op.info[n])
+        free(op.info)
+    free(op)
+
+cdef pypmix_deliver(pypmix_op_t *op):
+    if PYPMIX_OP_EVENT == op.kind:
+        event = (op.status, pmix_proc_to_py(&op.source),
+                 pypmix_info_to_dict(op.info, op.ninfo))
+        queue = _pypmix_handlers.get(op.refid)
+        if queue is None:
+            _pypmix_early.setdefault(op.refid, []).append(event)
+        else:
+            queue.put_nowait(event)
+        return
+    entry = _pypmix_pending.pop(op.id, None)
+    if entry is None or entry[0].done():
+        return
+    future = entry[0]
+    try:
+        if PYPMIX_OP_STATUS == op.kind:
+            result = op.status
+        elif PYPMIX_OP_VALUE == op.kind:
+            result = (op.status, None if NULL == op.value else pmix_value_to_py(op.value))
+        elif PYPMIX_OP_INFO == op.kind:
+            result = (op.status, pypmix_info_to_dict(op.info, op.ninfo))
+        else:
+            queue = entry[2]
+            if PMIX_SUCCESS == op.status:
+                _pypmix_handlers[op.refid] = queue
+                for event in _pypmix_early.pop(op.refid, []):
+                    queue.put_nowait(event)
+            result = (op.status, op.refid, queue)
+    except Exception as e:
+        future.set_exception(e)
+    else:
+        future.set_result(result)
+
+def _pypmix_drain():
+    global pypmix_done
+    cdef uint64_t count
+    cdef pypmix_op_t *done
+    cdef pypmix_op_t *nxt
+    cdef pypmix_op_t *ordered = NULL
+    read(pypmix_efd, &count, sizeof(count))
+    pthread_mutex_lock(&pypmix_lock)
+    done = pypmix_done
+    pypmix_done = NULL
+    pthread_mutex_unlock(&pypmix_lock)
+    # they were queued newest first
+    while NULL != done:
+        nxt = done.next
+        done.next = ordered
+        ordered = done
+        done = nxt
+    while NULL != ordered:
+        done = ordered
+        ordered = done.next
+        try:
+            pypmix_deliver(done)
+        finally:
+            pypmix_op_free(done)
+
+# hook the eventfd into the running loop and set up an op
+# whose future the caller will hand back
+cdef pypmix_op_t* pypmix_submit(int kind, keep, extra=None) except NULL:
+    global pypmix_efd, pypmix_nextid, _pypmix_loop
+    cdef pypmix_op_t *op
+    loop = asyncio.get_event_loop()
+    if pypmix_efd < 0:
+        pypmix_efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)
+        if pypmix_efd < 0:
+            raise OSError("unable to create an eventfd")
+    if _pypmix_loop is not loop:
+        if _pypmix_loop is not None:
+            _pypmix_loop.remove_reader(pypmix_efd)
+        loop.add_reader(pypmix_efd, _pypmix_drain)
+        _pypmix_loop = loop
+    op = <pypmix_op_t*>malloc(sizeof(pypmix_op_t))
+    if NULL == op:
+        raise MemoryError()
+    memset(op, 0, sizeof(pypmix_op_t))
+    pypmix_nextid += 1
+    op.id = pypmix_nextid
+    op.kind = kind
+    _pypmix_pending[op.id] = (loop.create_future(), keep, extra)
+    return op
+
+# the call has been made - if the library refused it then the
+# callback will never come, so resolve the future here
+cdef object pypmix_submitted(pypmix_op_t *op, pmix_status_t rc):
+    future = _pypmix_pending[op.id][0]
+    if PMIX_SUCCESS != rc:
+        op.status = rc
+        try:
+            pypmix_deliver(op)
+        finally:
+            pypmix_op_free(op)
+    return future
+
+# lay out queries in memory that lives as long as keep does
+cdef pmix_query_t* pypmix_load_queries(queries, list keep) except NULL:
+    cdef pmix_query_t *cq
+    cdef char **ckeys
+    cdef PMIxInfoArray qarray
+    nq = len(queries)
+    if 0 == nq:
+        raise ValueError("no queries given")
+    qbuf = bytearray(nq * sizeof(pmix_query_t))
+    keep.append(qbuf)
+    cq = <pmix_query_t*><char*>qbuf
+    for n in range(nq):
+        keys = [k.encode('ascii') if isinstance(k, str) else k
+                for k in queries[n]['keys']]
+        keep.append(keys)
+        kbuf = bytearray((len(keys) + 1) * sizeof(char*))
+        keep.append(kbuf)
+        ckeys = <char**><char*>kbuf
+        for m in range(len(keys)):
+            ckeys[m] = keys[m]
+        cq[n].keys = ckeys
+        quals = queries[n].get('qualifiers')
+        if quals:
+            qarray = pypmix_info_array(quals)
+            keep.append(qarray)
+            cq[n].qualifiers = qarray.array
+            cq[n].nqual = len(quals)
+    return cq
+
+cdef PMIxInfoArray pypmix_info_array(keyvals):
+    if keyvals is None:
+        keyvals = {}
+    inarray = PMIxInfoArray(max(len(keyvals), 1))
+    inarray.load(keyvals)
+    return inarray
+
 cdef class PMIxClient:
     cdef pmix_proc_t myproc;
     def __init__(self):
@@ -53,10 +362,280 @@ cdef class PMIxClient:
         cdef size_t ninfo = 0
         return PMIx_Finalize(NULL, ninfo)
 
-    # private function to convert key-value tuple
-    # to pmix_info_t
-    def __convert_value(self, char* dest, char* src):
-        strncpy(dest, src, 511)
+    def get_myproc(self):
+        return pmix_proc_to_py(&self.myproc)
+
+    # Post a value for others to retrieve
+    #
+    # @scope [INPUT]
+    #          - PMIX_LOCAL, PMIX_REMOTE or PMIX_GLOBAL
+    #
+    # @key [INPUT]
+    #          - the key to post it under
+    #
+    # @value [INPUT]
+    #          - bool, int, float, str, proc dictionary, or any
+    #            object exporting the buffer protocol - the latter
+    #            are posted as byte objects straight from their
+    #            memory
+    def put(self, scope, key, value):
+        cdef char ckey[512]
+        cdef pmix_value_t val
+        cdef pmix_scope_t cscope = scope
+        cdef pmix_status_t rc
+        keep = []
+        py_to_pmix_key(ckey, key)
+        py_to_pmix_value(&val, value, keep)
+        with nogil:
+            rc = PMIx_Put(cscope, ckey, &val)
+        return rc
+
+    def commit(self):
+        cdef pmix_status_t rc
+        with nogil:
+            rc = PMIx_Commit()
+        return rc
+
+    # Execute a barrier across the given procs
+    #
+    # @procs [INPUT]
+    #          - list of proc dictionaries - None means all
+    #            procs in our nspace
+    #
+    # @keyvals [INPUT]
+    #          - a dictionary of directives
+    def fence(self, procs=None, keyvals=None):
+        cdef pmix_proc_t *cprocs = NULL
+        cdef size_t nprocs = 0
+        cdef pmix_status_t rc
+        cdef PMIxInfoArray inarray = pypmix_info_array(keyvals)
+        cdef size_t ninfo = len(keyvals) if keyvals else 0
+        if procs:
+            nprocs = len(procs)
+            cprocs = <pmix_proc_t*>PyMem_Malloc(nprocs * sizeof(pmix_proc_t))
+            if not cprocs:
+                raise MemoryError()
+            for n in range(nprocs):
+                py_to_pmix_proc(&cprocs[n], procs[n])
+        with nogil:
+            rc = PMIx_Fence(cprocs, nprocs, inarray.array, ninfo)
+        PyMem_Free(cprocs)
+        return rc
+
+    # Retrieve a value posted by a proc
+    #
+    # @proc [INPUT]
+    #          - proc dictionary - None means ourselves
+    #
+    # @key [INPUT]
+    #          - the key to retrieve
+    #
+    # @keyvals [INPUT]
+    #          - a dictionary of directives
+    #
+    # Returns (status, value). Byte objects come back as
+    # PMIxByteObject, which shares the retrieved memory
+    # with any memoryview or NumPy array made from it
+    def get(self, proc, key, keyvals=None):
+        cdef pmix_proc_t cproc
+        cdef char ckey[512]
+        cdef pmix_value_t *val = NULL
+        cdef pmix_status_t rc
+        cdef PMIxInfoArray inarray = pypmix_info_array(keyvals)
+        cdef size_t ninfo = len(keyvals) if keyvals else 0
+        if proc is None:
+            cproc = self.myproc
+        else:
+            py_to_pmix_proc(&cproc, proc)
+        py_to_pmix_key(ckey, key)
+        with nogil:
+            rc = PMIx_Get(&cproc, ckey, inarray.array, ninfo, &val)
+        if PMIX_SUCCESS != rc or NULL == val:
+            return (rc, None)
+        try:
+            pyval = pmix_value_to_py(val)
+        finally:
+            PMIX_VALUE_RELEASE(val)
+        return (rc, pyval)
+
+    # Query the system
+    #
+    # @queries [INPUT]
+    #          - list of dictionaries, each with 'keys' (list of
+    #            query keys) and optional 'qualifiers' (dictionary)
+    #
+    # Returns (status, dictionary of results)
+    def query(self, queries):
+        cdef pmix_query_t *cq
+        cdef size_t nq = len(queries)
+        cdef pypmix_wait_t wt
+        cdef pmix_status_t rc
+        keep = []
+        cq = pypmix_load_queries(queries, keep)
+        wt.active = 1
+        wt.info = NULL
+        wt.ninfo = 0
+        with nogil:
+            rc = PMIx_Query_info_nb(cq, nq, pypmix_infocb, &wt)
+        if PMIX_SUCCESS == rc:
+            with nogil:
+                pypmix_wait(&wt)
+        else:
+            wt.status = rc
+        try:
+            results = pypmix_info_to_dict(wt.info, wt.ninfo)
+        finally:
+            for n in range(wt.ninfo):
+                PMIX_INFO_DESTRUCT(&wt.info[n])
+            free(wt.info)
+        return (wt.status, results)
+
+    # Generate an event
+    #
+    # @status [INPUT]
+    #          - the event code
+    #
+    # @range [INPUT]
+    #          - who may receive it
+    #
+    # @keyvals [INPUT]
+    #          - a dictionary of info to carry with it
+    def notify(self, status, range, keyvals=None):
+        cdef pmix_status_t cstatus = status
+        cdef pmix_data_range_t crange = range
+        cdef PMIxInfoArray inarray = pypmix_info_array(keyvals)
+        cdef size_t ninfo = len(keyvals) if keyvals else 0
+        cdef pmix_proc_t source = self.myproc
+        cdef pypmix_wait_t wt
+        cdef pmix_status_t rc
+        wt.active = 1
+        with nogil:
+            rc = PMIx_Notify_event(cstatus, &source, crange,
+                                   inarray.array, ninfo, pypmix_opcb, &wt)
+        if PMIX_SUCCESS == rc:
+            # wait for the library to be done with the info,
+            # as it points into keyvals
+            with nogil:
+                pypmix_wait(&wt)
+            rc = wt.status
+        return rc
+
+    # The _nb calls below return asyncio futures and must be
+    # made from the thread running the event loop. Whatever
+    # they are given must not be changed until they resolve
+
+    # Future resolving to (status, value) - see get()
+    def get_nb(self, proc, key, keyvals=None):
+        cdef pmix_proc_t cproc
+        cdef PMIxInfoArray inarray = pypmix_info_array(keyvals)
+        cdef size_t ninfo = len(keyvals) if keyvals else 0
+        cdef pypmix_op_t *op
+        cdef pmix_status_t rc
+        cdef const char *ckey
+        if proc is None:
+            cproc = self.myproc
+        else:
+            py_to_pmix_proc(&cproc, proc)
+        # the library holds on to the key until it answers
+        pykey = key.encode('ascii') if isinstance(key, str) else bytes(key)
+        if len(pykey) > PMIX_MAX_KEYLEN:
+            raise KeyError(key)
+        ckey = pykey
+        op = pypmix_submit(PYPMIX_OP_VALUE, (inarray, pykey))
+        with nogil:
+            rc = PMIx_Get_nb(&cproc, ckey, inarray.array, ninfo,
+                             pypmix_async_valuecb, op)
+        return pypmix_submitted(op, rc)
+
+    # Future resolving to the status - see fence()
+    def fence_nb(self, procs=None, keyvals=None):
+        cdef pmix_proc_t *cprocs = NULL
+        cdef size_t nprocs = 0
+        cdef PMIxInfoArray inarray = pypmix_info_array(keyvals)
+        cdef size_t ninfo = len(keyvals) if keyvals else 0
+        cdef pypmix_op_t *op
+        cdef pmix_status_t rc
+        pbuf = None
+        if procs:
+            nprocs = len(procs)
+            pbuf = bytearray(nprocs * sizeof(pmix_proc_t))
+            cprocs = <pmix_proc_t*><char*>pbuf
+            for n in range(nprocs):
+                py_to_pmix_proc(&cprocs[n], procs[n])
+        op = pypmix_submit(PYPMIX_OP_STATUS, (inarray, pbuf))
+        with nogil:
+            rc = PMIx_Fence_nb(cprocs, nprocs, inarray.array, ninfo,
+                               pypmix_async_opcb, op)
+        return pypmix_submitted(op, rc)
+
+    # Future resolving to (status, dictionary of results) - see query()
+    def query_nb(self, queries):
+        cdef pmix_query_t *cq
+        cdef size_t nq = len(queries)
+        cdef pypmix_op_t *op
+        cdef pmix_status_t rc
+        keep = []
+        cq = pypmix_load_queries(queries, keep)
+        op = pypmix_submit(PYPMIX_OP_INFO, keep)
+        with nogil:
+            rc = PMIx_Query_info_nb(cq, nq, pypmix_async_infocb, op)
+        return pypmix_submitted(op, rc)
+
+    # Future resolving to the status - see notify()
+    def notify_nb(self, status, range, keyvals=None):
+        cdef pmix_status_t cstatus = status
+        cdef pmix_data_range_t crange = range
+        cdef pmix_proc_t source = self.myproc
+        cdef PMIxInfoArray inarray = pypmix_info_array(keyvals)
+        cdef size_t ninfo = len(keyvals) if keyvals else 0
+        cdef pypmix_op_t *op
+        cdef pmix_status_t rc
+        op = pypmix_submit(PYPMIX_OP_STATUS, inarray)
+        with nogil:
+            rc = PMIx_Notify_event(cstatus, &source, crange,
+                                   inarray.array, ninfo, pypmix_async_opcb, op)
+        return pypmix_submitted(op, rc)
+
+    # Register for events
+    #
+    # @codes [INPUT]
+    #          - list of event codes - None means all events
+    #
+    # @keyvals [INPUT]
+    #          - a dictionary of directives
+    #
+    # Returns a future resolving to (status, refid, queue). Each
+    # event is put on the asyncio.Queue as (status, source, info)
+    def register_event_handler(self, codes=None, keyvals=None):
+        cdef pmix_status_t *ccodes = NULL
+        cdef size_t ncodes = 0
+        cdef PMIxInfoArray inarray = pypmix_info_array(keyvals)
+        cdef size_t ninfo = len(keyvals) if keyvals else 0
+        cdef pypmix_op_t *op
+        cbuf = None
+        if codes:
+            ncodes = len(codes)
+            cbuf = bytearray(ncodes * sizeof(pmix_status_t))
+            ccodes = <pmix_status_t*><char*>cbuf
+            for n in range(ncodes):
+                ccodes[n] = codes[n]
+        op = pypmix_submit(PYPMIX_OP_REFID, (inarray, cbuf), asyncio.Queue())
+        with nogil:
+            PMIx_Register_event_handler(ccodes, ncodes, inarray.array, ninfo,
+                                        pypmix_async_evhdlr, pypmix_async_regcb, op)
+        return pypmix_submitted(op, PMIX_SUCCESS)
+
+    # Future resolving to the status once the handler is gone - its
+    # queue gets no further events
+    def deregister_event_handler(self, refid):
+        cdef size_t crefid = refid
+        cdef pypmix_op_t *op
+        _pypmix_handlers.pop(refid, None)
+        _pypmix_early.pop(refid, None)
+        op = pypmix_submit(PYPMIX_OP_STATUS, None)
+        with nogil:
+            PMIx_Deregister_event_handler(crefid, pypmix_async_opcb, op)
+        return pypmix_submitted(op, PMIX_SUCCESS)
 
 pmixservermodule = {}
 def setmodulefn(k, f):
@@ -27,22 +27,27 @@ AC_DEFUN([PMIX_CHECK_DSTOR_LOCK],[
         _x_ac_fcntl_lock_found="1"
     ], [], [#include <fcntl.h>])
 
-    if test "$DSTORE_PTHREAD_LOCK" = "1"; then
-        AC_CHECK_FUNC([pthread_rwlockattr_setkind_np],
-            [AC_EGREP_HEADER([PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP],
-                    [pthread.h],[
-                        AC_DEFINE([HAVE_PTHREAD_SETKIND], [1],
-                            [Define to 1 if you have the `pthread_rwlockattr_setkind_np` function.])])])
+    # the fcntl-based lock can also offer a shared rwlock to
+    # its readers, so look for these even when that one is wanted
+    _x_ac_pthread_shared_found="0"
+    AC_CHECK_FUNC([pthread_rwlockattr_setkind_np],
+        [AC_EGREP_HEADER([PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP],
+                [pthread.h],[
+                    AC_DEFINE([HAVE_PTHREAD_SETKIND], [1],
+                        [Define to 1 if you have the `pthread_rwlockattr_setkind_np` function.])])])
 
-        AC_CHECK_FUNC([pthread_rwlockattr_setpshared],
-            [AC_EGREP_HEADER([PTHREAD_PROCESS_SHARED],
-                    [pthread.h],[
-                        AC_DEFINE([HAVE_PTHREAD_SHARED], [1],
-                            [Define to 1 if you have the `PTHREAD_PROCESS_SHARED` definition.
-                        ])
-                        _x_ac_pthread_lock_found="1"
-            ])
+    AC_CHECK_FUNC([pthread_rwlockattr_setpshared],
+        [AC_EGREP_HEADER([PTHREAD_PROCESS_SHARED],
+                [pthread.h],[
+                    AC_DEFINE([HAVE_PTHREAD_SHARED], [1],
+                        [Define to 1 if you have the `PTHREAD_PROCESS_SHARED` definition.
+                    ])
+                    _x_ac_pthread_shared_found="1"
         ])
+    ])
+
+    if test "$DSTORE_PTHREAD_LOCK" = "1"; then
+        _x_ac_pthread_lock_found=$_x_ac_pthread_shared_found
 
         if test "$_x_ac_pthread_lock_found" = "0"; then
             if test "$_x_ac_fcntl_lock_found" = "1"; then
@@ -446,6 +446,38 @@ AC_DEFUN([PMIX_SETUP_CC],[
     AC_DEFINE_UNQUOTED([PMIX_C_HAVE_BUILTIN_CLZ], [$have_cc_builtin_clz],
         [Whether C compiler supports __builtin_clz])
 
+    # see if the C compiler supports __builtin_ctzll
+    AC_CACHE_CHECK([if $CC supports __builtin_ctzll],
+        [pmix_cv_cc_supports___builtin_ctzll],
+        [AC_TRY_LINK([],
+            [unsigned long long value = 0x100; /* we know the low 8 bits are clear */
+             if (8 != __builtin_ctzll(value)) return 0;],
+            [pmix_cv_cc_supports___builtin_ctzll="yes"],
+            [pmix_cv_cc_supports___builtin_ctzll="no"])])
+    if test "$pmix_cv_cc_supports___builtin_ctzll" = "yes" ; then
+        have_cc_builtin_ctzll=1
+    else
+        have_cc_builtin_ctzll=0
+    fi
+    AC_DEFINE_UNQUOTED([PMIX_C_HAVE_BUILTIN_CTZLL], [$have_cc_builtin_ctzll],
+        [Whether C compiler supports __builtin_ctzll])
+
+    # see if the C compiler supports __builtin_popcountll
+    AC_CACHE_CHECK([if $CC supports __builtin_popcountll],
+        [pmix_cv_cc_supports___builtin_popcountll],
+        [AC_TRY_LINK([],
+            [unsigned long long value = 0xffff; /* we know we have 16 bits set */
+             if (16 != __builtin_popcountll(value)) return 0;],
+            [pmix_cv_cc_supports___builtin_popcountll="yes"],
+            [pmix_cv_cc_supports___builtin_popcountll="no"])])
+    if test "$pmix_cv_cc_supports___builtin_popcountll" = "yes" ; then
+        have_cc_builtin_popcountll=1
+    else
+        have_cc_builtin_popcountll=0
+    fi
+    AC_DEFINE_UNQUOTED([PMIX_C_HAVE_BUILTIN_POPCOUNTLL], [$have_cc_builtin_popcountll],
+        [Whether C compiler supports __builtin_popcountll])
+
     # Preload the optflags for the case where the user didn't specify
     # any.  If we're using GNU compilers, use -O3 (since it GNU
     # doesn't require all compilation units to be compiled with the
@@ -212,6 +212,19 @@ PMIX_EXPORT pmix_status_t PMIx_Get_nb(const pmix_proc_t *proc, const pmix_key_t
                                       const pmix_info_t info[], size_t ninfo,
                                       pmix_value_cbfunc_t cbfunc, void *cbdata);
 
+/* Retrieve the values of several (proc, key) pairs at once - e.g., the
+ * endpoints of every peer during wireup. This is a blocking operation:
+ * on return, vals[i] holds the value for keys[i] as published by procs[i]
+ * (or NULL) and rcs[i] the status of that retrieval. Values already held
+ * locally are returned directly, and all remaining requests are issued
+ * together. The info array applies to every request and is used as
+ * described above for PMIx_Get. Returns PMIX_SUCCESS if every value was
+ * found, or else the first error in rcs. The caller is responsible for
+ * freeing all returned values */
+PMIX_EXPORT pmix_status_t PMIx_Get_multi(const pmix_proc_t procs[], const char *keys[], size_t n,
+                                         const pmix_info_t info[], size_t ninfo,
+                                         pmix_value_t *vals[], pmix_status_t rcs[]);
+
 
 /* Publish the data in the info array for lookup. By default,
  * the data will be published into the PMIX_SESSION range and
@@ -527,7 +540,9 @@ PMIX_EXPORT pmix_status_t PMIx_Job_control_nb(const pmix_proc_t targets[], size_
  *         the pmix_info_cbfunc_t array of pmix_info_t structures.
  *
  * Note: a process can send a heartbeat to the server using the PMIx_Heartbeat
- * macro provided below*/
+ * macro provided below. Any other message the process sends to the server
+ * also counts as a heartbeat, so only an otherwise idle process needs to
+ * send one explicitly*/
 PMIX_EXPORT pmix_status_t PMIx_Process_monitor(const pmix_info_t *monitor, pmix_status_t error,
                                                const pmix_info_t directives[], size_t ndirs);
 
@@ -657,6 +657,17 @@ PMIX_EXPORT pmix_status_t PMIx_server_register_client(const pmix_proc_t *proc,
                                                       void *server_object,
                                                       pmix_op_cbfunc_t cbfunc, void *cbdata);
 
+/* Register several client processes with the PMIx server library
+ * in one operation - equivalent to calling PMIx_server_register_client
+ * for each of them, but handled in a single pass. The uids, gids
+ * and (if not NULL) server_objects arrays hold the value for the
+ * proc at the same index. The callback function is executed once
+ * all of the procs have been registered */
+PMIX_EXPORT pmix_status_t PMIx_server_register_clients(const pmix_proc_t procs[], size_t nprocs,
+                                                       const uid_t uids[], const gid_t gids[],
+                                                       void *server_objects[],
+                                                       pmix_op_cbfunc_t cbfunc, void *cbdata);
+
 /* Deregister a client and purge all data relating to it. The
  * deregister_nspace API will automatically delete all client
  * info for that nspace - this API is therefore intended solely
@@ -129,6 +129,40 @@ PMIX_EXPORT pmix_status_t PMIx_tool_finalize(void);
 PMIX_EXPORT pmix_status_t PMIx_tool_connect_to_server(pmix_proc_t *proc,
                                                       pmix_info_t info[], size_t ninfo);
 
+/* Attach to an additional server. Unlike PMIx_tool_connect_to_server,
+ * any existing connections are left in place - the tool must already
+ * be connected to its primary server, and the new server is located
+ * using the same attributes. The tool keeps its existing identifier.
+ * On success, the server parameter (if not _NULL_) is filled with the
+ * identifier of the server that was attached. PMIX_EXISTS is returned
+ * if the tool is already connected to that server
+ *
+ * All operations other than PMIx_tool_query_servers_nb continue to be
+ * directed at the primary server */
+PMIX_EXPORT pmix_status_t PMIx_tool_attach_to_server(pmix_proc_t *server,
+                                                     pmix_info_t info[], size_t ninfo);
+
+/* Gracefully close the connection to a server previously attached
+ * with PMIx_tool_attach_to_server. The primary server cannot be
+ * detached - use PMIx_tool_connect_to_server to switch it */
+PMIX_EXPORT pmix_status_t PMIx_tool_detach_from_server(const pmix_proc_t *server);
+
+/* Get the identifiers of all servers the tool is currently connected
+ * to, primary server first. The returned array is to be released by
+ * the caller using PMIX_PROC_FREE */
+PMIX_EXPORT pmix_status_t PMIx_tool_get_servers(pmix_proc_t **servers, size_t *nservers);
+
+/* Issue the given queries to every server the tool is connected to
+ * in parallel, aggregating the responses into a single callback. The
+ * returned info array holds one PMIX_QUERY_SERVER_RESULTS entry for
+ * each server that answered. The status will be PMIX_SUCCESS if all
+ * servers answered, PMIX_QUERY_PARTIAL_SUCCESS if only some did, or
+ * the error reported by the first server to fail if none did. Servers
+ * whose connection is lost while the query is outstanding are counted
+ * as having failed */
+PMIX_EXPORT pmix_status_t PMIx_tool_query_servers_nb(pmix_query_t queries[], size_t nqueries,
+                                                     pmix_info_cbfunc_t cbfunc, void *cbdata);
+
 #if defined(c_plusplus) || defined(__cplusplus)
 }
 #endif
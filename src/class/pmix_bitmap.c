@@ -34,6 +34,38 @@
  */
 #define SIZE_OF_BASE_TYPE  64
 
+/* number of trailing zero bits in a non-zero word */
+static inline int pmix_bitmap_ctz(uint64_t val)
+{
+#if PMIX_C_HAVE_BUILTIN_CTZLL
+    return __builtin_ctzll(val);
+#else
+    int cnt = 0;
+
+    while (!(val & 0x1)) {
+        ++cnt;
+        val >>= 1;
+    }
+    return cnt;
+#endif
+}
+
+static inline int pmix_bitmap_popcount(uint64_t val)
+{
+#if PMIX_C_HAVE_BUILTIN_POPCOUNTLL
+    return __builtin_popcountll(val);
+#else
+    int cnt;
+
+    /*  Peter Wegner in CACM 3 (1960), 322. This method goes through as many
+     *  iterations as there are set bits. */
+    for (cnt = 0; val; cnt++) {
+        val &= val - 1;  /* clear the least significant bit set */
+    }
+    return cnt;
+#endif
+}
+
 static void pmix_bitmap_construct(pmix_bitmap_t *bm);
 static void pmix_bitmap_destruct(pmix_bitmap_t *bm);
 
@@ -237,15 +269,81 @@ pmix_bitmap_find_and_set_first_unset_bit(pmix_bitmap_t *bm, int *position)
     temp = bm->bitmap[i];
     bm->bitmap[i] |= (bm->bitmap[i] + 1); /* Set the first zero bit */
     temp ^= bm->bitmap[i];  /* Compute the change: the first unset bit in the original number */
-    while( !(temp & 0x1) ) {
-        ++(*position);
-        temp >>= 1;
-    }
 
-    (*position) += i * SIZE_OF_BASE_TYPE;
+    *position = i * SIZE_OF_BASE_TYPE + pmix_bitmap_ctz(temp);
     return PMIX_SUCCESS;
 }
 
+int pmix_bitmap_find_next_set_bit(pmix_bitmap_t *bm, int start)
+{
+    int i;
+    uint64_t val;
+
+    if (NULL == bm || start < 0 || start >= bm->array_size * SIZE_OF_BASE_TYPE) {
+        return -1;
+    }
+
+    /* mask off the bits below start in its word, then
+     * skip whole empty words */
+    i = start / SIZE_OF_BASE_TYPE;
+    val = bm->bitmap[i] & (~0UL << (start % SIZE_OF_BASE_TYPE));
+    while (0 == val) {
+        if (++i == bm->array_size) {
+            return -1;
+        }
+        val = bm->bitmap[i];
+    }
+    return i * SIZE_OF_BASE_TYPE + pmix_bitmap_ctz(val);
+}
+
+int pmix_bitmap_find_next_unset_bit(pmix_bitmap_t *bm, int start)
+{
+    int i;
+    uint64_t val;
+
+    if (NULL == bm || start < 0 || start >= bm->array_size * SIZE_OF_BASE_TYPE) {
+        return -1;
+    }
+
+    i = start / SIZE_OF_BASE_TYPE;
+    val = ~bm->bitmap[i] & (~0UL << (start % SIZE_OF_BASE_TYPE));
+    while (0 == val) {
+        if (++i == bm->array_size) {
+            return -1;
+        }
+        val = ~bm->bitmap[i];
+    }
+    return i * SIZE_OF_BASE_TYPE + pmix_bitmap_ctz(val);
+}
+
+bool pmix_bitmap_are_all_set(pmix_bitmap_t *bm, int len)
+{
+    int i, nwords, rem;
+    uint64_t all = ~0UL;
+
+    if (NULL == bm || len < 0 || len > bm->array_size * SIZE_OF_BASE_TYPE) {
+        return false;
+    }
+
+    /* AND the full words together so the loop has no
+     * early exit to stop it from vectorizing */
+    nwords = len / SIZE_OF_BASE_TYPE;
+    for (i = 0; i < nwords; ++i) {
+        all &= bm->bitmap[i];
+    }
+    if (~0UL != all) {
+        return false;
+    }
+    rem = len % SIZE_OF_BASE_TYPE;
+    if (0 < rem) {
+        uint64_t mask = (1UL << rem) - 1;
+        if (mask != (bm->bitmap[nwords] & mask)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 int pmix_bitmap_bitwise_and_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right)
 {
     int i;
@@ -294,6 +392,30 @@ int pmix_bitmap_bitwise_or_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right)
     return PMIX_SUCCESS;
 }
 
+int pmix_bitmap_bitwise_andnot_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right)
+{
+    int i;
+
+    /*
+     * Sanity check
+     */
+    if( NULL == dest || NULL == right ) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    if( dest->array_size != right->array_size ) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    /*
+     * Bitwise AND NOT
+     */
+    for(i = 0; i < dest->array_size; ++i) {
+        dest->bitmap[i] &= ~right->bitmap[i];
+    }
+
+    return PMIX_SUCCESS;
+}
+
 int pmix_bitmap_bitwise_xor_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right)
 {
     int i;
@@ -389,11 +511,7 @@ int pmix_bitmap_num_set_bits(pmix_bitmap_t *bm, int len)
 
     for(i = 0; i < len; ++i) {
         if( 0 == (val = bm->bitmap[i]) ) continue;
-        /*  Peter Wegner in CACM 3 (1960), 322. This method goes through as many
-         *  iterations as there are set bits. */
-        for( ; val; cnt++ ) {
-            val &= val - 1;  /* clear the least significant bit set */
-        }
+        cnt += pmix_bitmap_popcount(val);
     }
 
     return cnt;
@@ -135,6 +135,51 @@ PMIX_EXPORT int pmix_bitmap_find_and_set_first_unset_bit(pmix_bitmap_t *bm,
                                                            int *position);
 
 
+/**
+ * Find the first set bit at or after a given position
+ *
+ * @param  bitmap     The input bitmap (IN)
+ * @param  start      Position to start looking from (IN)
+ *
+ * @return position of the bit, or -1 if there is none
+ */
+PMIX_EXPORT int pmix_bitmap_find_next_set_bit(pmix_bitmap_t *bm, int start);
+
+
+/**
+ * Find the first clear bit at or after a given position
+ *
+ * @param  bitmap     The input bitmap (IN)
+ * @param  start      Position to start looking from (IN)
+ *
+ * @return position of the bit, or -1 if all remaining bits are set
+ */
+PMIX_EXPORT int pmix_bitmap_find_next_unset_bit(pmix_bitmap_t *bm, int start);
+
+
+/**
+ * Loop over the set bits of a bitmap in increasing order
+ *
+ * @param bit   int variable holding the current bit (OUT)
+ * @param bm    The bitmap (IN)
+ */
+#define PMIX_BITMAP_FOREACH_SET_BIT(bit, bm)                   \
+    for ((bit) = pmix_bitmap_find_next_set_bit((bm), 0);       \
+         0 <= (bit);                                           \
+         (bit) = pmix_bitmap_find_next_set_bit((bm), (bit) + 1))
+
+
+/**
+ * Check that all of the first len bits are set
+ *
+ * @param  bitmap     The input bitmap (IN)
+ * @param  len        Number of bits to check (IN)
+ *
+ * @return true if they all are
+ */
+PMIX_EXPORT bool pmix_bitmap_are_all_set(pmix_bitmap_t *bm, int len);
+
+
 /**
  * Clear all bits in the bitmap
  *
@@ -204,6 +249,15 @@ PMIX_EXPORT int pmix_bitmap_bitwise_and_inplace(pmix_bitmap_t *dest, pmix_bitmap
  */
 PMIX_EXPORT int pmix_bitmap_bitwise_or_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right);
 
+/**
+ * Bitwise AND NOT operator (inplace) - clears in dest every bit set in right
+ *
+ * @param dest Pointer to the bitmap that should be modified
+ * @param right Point to the other bitmap in the operation
+ * @return PMIX error code if the length of the two bitmaps is not equal or one is NULL.
+ */
+PMIX_EXPORT int pmix_bitmap_bitwise_andnot_inplace(pmix_bitmap_t *dest, pmix_bitmap_t *right);
+
 /**
  * Bitwise XOR operator (inplace)
  *
@@ -44,10 +44,49 @@ static void local_eviction_callback(int fd, short flags, void *arg)
 }
 
 
+static void local_sweep_callback(int fd, short flags, void *arg)
+{
+    pmix_hotel_t *hotel = (pmix_hotel_t*)arg;
+    pmix_hotel_room_t *room;
+    void *occupant;
+    int next, room_num;
+
+    /* everyone in the oldest bucket has now stayed at least the
+     * eviction timeout. Anyone checked in by an eviction callback
+     * lands in the current bucket, so empty the oldest one before
+     * making it current. */
+    next = (hotel->current_bucket + 1) % hotel->num_buckets;
+    while (0 <= (room_num = hotel->buckets[next])) {
+        /* Do not change this logic without also changing the same
+           logic in pmix_hotel_checkout() and
+           pmix_hotel_checkout_and_return_occupant(). */
+        _pmix_hotel_bucket_unlink(hotel, room_num);
+        room = &(hotel->rooms[room_num]);
+        occupant = room->occupant;
+        room->occupant = NULL;
+        hotel->last_unoccupied_room++;
+        assert(hotel->last_unoccupied_room < hotel->num_rooms);
+        hotel->unoccupied_rooms[hotel->last_unoccupied_room] = room_num;
+
+        hotel->evict_callback_fn(hotel, room_num, occupant);
+    }
+    hotel->current_bucket = next;
+}
+
 pmix_status_t pmix_hotel_init(pmix_hotel_t *h, int num_rooms,
                               pmix_event_base_t *evbase,
                               uint32_t eviction_timeout,
                               pmix_hotel_eviction_callback_fn_t evict_callback_fn)
+{
+    return pmix_hotel_init_bucketed(h, num_rooms, evbase, eviction_timeout,
+                                    0, evict_callback_fn);
+}
+
+pmix_status_t pmix_hotel_init_bucketed(pmix_hotel_t *h, int num_rooms,
+                                       pmix_event_base_t *evbase,
+                                       uint32_t eviction_timeout,
+                                       uint32_t granularity,
+                                       pmix_hotel_eviction_callback_fn_t evict_callback_fn)
 {
     int i;
 
@@ -70,6 +109,27 @@ pmix_status_t pmix_hotel_init(pmix_hotel_t *h, int num_rooms,
     h->unoccupied_rooms = (int*) malloc(num_rooms * sizeof(int));
     h->last_unoccupied_room = num_rooms - 1;
 
+    if (NULL != evbase && 0 < granularity) {
+        /* an occupant checked in during one tick is swept when that
+         * bucket comes around again - one extra bucket makes sure
+         * that is never before the timeout */
+        h->num_buckets = (eviction_timeout + granularity - 1) / granularity + 1;
+        h->current_bucket = 0;
+        h->buckets = (int*)malloc(h->num_buckets * sizeof(int));
+        h->links = (pmix_hotel_room_link_t*)malloc(num_rooms * sizeof(pmix_hotel_room_link_t));
+        if (NULL == h->buckets || NULL == h->links) {
+            return PMIX_ERR_NOMEM;
+        }
+        for (i = 0; i < h->num_buckets; ++i) {
+            h->buckets[i] = -1;
+        }
+        h->tick.tv_usec = granularity % 1000000;
+        h->tick.tv_sec = granularity / 1000000;
+        pmix_event_assign(&h->tick_event, evbase, -1, EV_PERSIST,
+                          local_sweep_callback, h);
+        pmix_event_add(&h->tick_event, &h->tick);
+    }
+
     for (i = 0; i < num_rooms; ++i) {
         /* Mark this room as unoccupied */
         h->rooms[i].occupant = NULL;
@@ -82,7 +142,7 @@ pmix_status_t pmix_hotel_init(pmix_hotel_t *h, int num_rooms,
         h->eviction_args[i].room_num = i;
 
         /* Create this room's event (but don't add it) */
-        if (NULL != h->evbase) {
+        if (NULL != h->evbase && 0 == h->num_buckets) {
             pmix_event_assign(&(h->rooms[i].eviction_timer_event),
                               h->evbase,
                               -1, 0, local_eviction_callback,
@@ -104,6 +164,10 @@ static void constructor(pmix_hotel_t *h)
     h->eviction_args = NULL;
     h->unoccupied_rooms = NULL;
     h->last_unoccupied_room = -1;
+    h->num_buckets = 0;
+    h->current_bucket = 0;
+    h->buckets = NULL;
+    h->links = NULL;
 }
 
 static void destructor(pmix_hotel_t *h)
@@ -111,7 +175,9 @@ static void destructor(pmix_hotel_t *h)
     int i;
 
     /* Go through all occupied rooms and destroy their events */
-    if (NULL != h->evbase) {
+    if (0 < h->num_buckets) {
+        pmix_event_del(&h->tick_event);
+    } else if (NULL != h->evbase) {
         for (i = 0; i < h->num_rooms; ++i) {
             if (NULL != h->rooms[i].occupant) {
                 pmix_event_del(&(h->rooms[i].eviction_timer_event));
@@ -128,6 +194,12 @@ static void destructor(pmix_hotel_t *h)
     if (NULL != h->unoccupied_rooms) {
         free(h->unoccupied_rooms);
     }
+    if (NULL != h->buckets) {
+        free(h->buckets);
+    }
+    if (NULL != h->links) {
+        free(h->links);
+    }
 }
 
 PMIX_CLASS_INSTANCE(pmix_hotel_t,
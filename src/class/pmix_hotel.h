@@ -42,6 +42,12 @@
  * functionality.  It is intended to be used in performance-critical
  * code paths -- extra functionality would simply add latency.
  *
+ * A hotel that holds many occupants at once can instead be set up with
+ * pmix_hotel_init_bucketed(): rather than a timer per room, a single
+ * periodic timer sweeps rooms grouped by the tick in which they were
+ * checked in, so checkin and checkout never touch the event base.
+ * Occupants are then evicted up to one tick later than the timeout.
+ *
  * There is an pmix_hotel_init() function to create a hotel, but no
  * corresponding finalize; the destructor will handle all finalization
  * issues.  Note that when a hotel is destroyed, it will delete all
@@ -108,6 +114,18 @@ typedef struct {
     int room_num;
 } pmix_hotel_room_eviction_callback_arg_t;
 
+/* Note that this is an internal data structure; it is not part of the
+   public pmix_hotel interface.
+
+   Links of a room into the list of rooms checked in during the same
+   tick of a bucketed hotel.  Kept apart from the rooms for the same
+   reason as the eviction arguments. */
+typedef struct {
+    int prev;
+    int next;
+    int bucket;
+} pmix_hotel_room_link_t;
+
 typedef struct pmix_hotel_t {
     /* make this an object */
     pmix_object_t super;
@@ -131,6 +149,14 @@ typedef struct pmix_hotel_t {
        in any particular order) */
     int *unoccupied_rooms;
     int last_unoccupied_room;
+
+    /* Bucketed eviction - zero buckets means a timer per room */
+    int num_buckets;
+    int current_bucket;
+    int *buckets;               // first room in each bucket, -1 if empty
+    pmix_hotel_room_link_t *links;
+    struct timeval tick;
+    pmix_event_t tick_event;
 } pmix_hotel_t;
 PMIX_CLASS_DECLARATION(pmix_hotel_t);
 
@@ -162,6 +188,58 @@ PMIX_EXPORT pmix_status_t pmix_hotel_init(pmix_hotel_t *hotel, int num_rooms,
                                           uint32_t eviction_timeout,
                                           pmix_hotel_eviction_callback_fn_t evict_callback_fn);
 
+/**
+ * Initialize a hotel that evicts by periodic sweep.
+ *
+ * @param hotel Pointer to a hotel (IN)
+ * @param num_rooms The total number of rooms in the hotel (IN)
+ * @param evbase Pointer to event base used for the sweep (IN)
+ * @param eviction_timeout Minimum length of a stay at the hotel before
+ * the eviction callback is invoked (in microseconds)
+ * @param granularity Time between sweeps (in microseconds) - an
+ * occupant may stay up to this much longer than eviction_timeout
+ * @param evict_callback_fn Callback function invoked for an occupant
+ * that overstays (IN)
+ *
+ * Same rules as pmix_hotel_init() otherwise.  A zero granularity, or
+ * no event base, gives the same hotel pmix_hotel_init() would.
+ */
+PMIX_EXPORT pmix_status_t pmix_hotel_init_bucketed(pmix_hotel_t *hotel, int num_rooms,
+                                                   pmix_event_base_t *evbase,
+                                                   uint32_t eviction_timeout,
+                                                   uint32_t granularity,
+                                                   pmix_hotel_eviction_callback_fn_t evict_callback_fn);
+
+/* Internal: put a room into the bucket being filled */
+static inline void _pmix_hotel_bucket_link(pmix_hotel_t *hotel, int room_num)
+{
+    pmix_hotel_room_link_t *link = &(hotel->links[room_num]);
+    int head = hotel->buckets[hotel->current_bucket];
+
+    link->bucket = hotel->current_bucket;
+    link->prev = -1;
+    link->next = head;
+    if (0 <= head) {
+        hotel->links[head].prev = room_num;
+    }
+    hotel->buckets[hotel->current_bucket] = room_num;
+}
+
+/* Internal: take a room out of whatever bucket it is in */
+static inline void _pmix_hotel_bucket_unlink(pmix_hotel_t *hotel, int room_num)
+{
+    pmix_hotel_room_link_t *link = &(hotel->links[room_num]);
+
+    if (0 <= link->prev) {
+        hotel->links[link->prev].next = link->next;
+    } else {
+        hotel->buckets[link->bucket] = link->next;
+    }
+    if (0 <= link->next) {
+        hotel->links[link->next].prev = link->prev;
+    }
+}
+
 /**
  * Check in an occupant to the hotel.
  *
@@ -199,7 +277,9 @@ static inline pmix_status_t pmix_hotel_checkin(pmix_hotel_t *hotel,
     room->occupant = occupant;
 
     /* Assign the event and make it pending */
-    if (NULL != hotel->evbase) {
+    if (0 < hotel->num_buckets) {
+        _pmix_hotel_bucket_link(hotel, *room_num);
+    } else if (NULL != hotel->evbase) {
         pmix_event_add(&(room->eviction_timer_event),
                        &(hotel->eviction_timeout));
     }
@@ -224,7 +304,9 @@ static inline void pmix_hotel_checkin_with_res(pmix_hotel_t *hotel,
     room->occupant = occupant;
 
     /* Assign the event and make it pending */
-    if (NULL != hotel->evbase) {
+    if (0 < hotel->num_buckets) {
+        _pmix_hotel_bucket_link(hotel, *room_num);
+    } else if (NULL != hotel->evbase) {
         pmix_event_add(&(room->eviction_timer_event),
                        &(hotel->eviction_timeout));
     }
@@ -255,7 +337,9 @@ static inline void pmix_hotel_checkout(pmix_hotel_t *hotel, int room_num)
            logic in pmix_hotel_checkout_and_return_occupant() and
            pmix_hotel.c:local_eviction_callback(). */
         room->occupant = NULL;
-        if (NULL != hotel->evbase) {
+        if (0 < hotel->num_buckets) {
+            _pmix_hotel_bucket_unlink(hotel, room_num);
+        } else if (NULL != hotel->evbase) {
             pmix_event_del(&(room->eviction_timer_event));
         }
         hotel->last_unoccupied_room++;
@@ -295,7 +379,9 @@ static inline void pmix_hotel_checkout_and_return_occupant(pmix_hotel_t *hotel,
            pmix_hotel.c:local_eviction_callback(). */
         *occupant = room->occupant;
         room->occupant = NULL;
-        if (NULL != hotel->evbase) {
+        if (0 < hotel->num_buckets) {
+            _pmix_hotel_bucket_unlink(hotel, room_num);
+        } else if (NULL != hotel->evbase) {
             event_del(&(room->eviction_timer_event));
         }
         hotel->last_unoccupied_room++;
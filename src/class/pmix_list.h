@@ -828,7 +828,7 @@ static inline void pmix_list_insert_pos(pmix_list_t *list, pmix_list_item_t *pos
      * containers remain valid, including those that point to elements
      * in \c xlist.
      */
-    void pmix_list_join(pmix_list_t *thislist, pmix_list_item_t *pos,
+    PMIX_EXPORT void pmix_list_join(pmix_list_t *thislist, pmix_list_item_t *pos,
                                       pmix_list_t *xlist);
 
 
@@ -62,6 +62,31 @@ static int num_classes = 0;
 static int max_classes = 0;
 static const int increment = 10;
 
+/* slots are kept across finalize so a class always maps to the same one */
+pmix_class_t *pmix_obj_cache_classes[PMIX_OBJ_CACHE_SLOTS] = {NULL};
+volatile int pmix_obj_cache_nslots = 0;
+#if PMIX_ENABLE_DEBUG
+pmix_atomic_int32_t pmix_obj_cache_live[PMIX_OBJ_CACHE_SLOTS] = {0};
+#endif
+
+#if PMIX_HAVE_THREAD_LOCAL
+/* per-thread caches of released objects for classes that asked
+ * for one - a slot is assigned to the class when it is first
+ * initialized, slot 0 is never used */
+typedef struct {
+    pmix_object_t *head;
+    int count;
+} pmix_obj_cache_t;
+
+static pmix_thread_local pmix_obj_cache_t obj_cache[PMIX_OBJ_CACHE_SLOTS];
+/* the key that drains a thread's cache when it exits - it is deleted
+ * at finalize, so a thread registers again if it is a new one */
+static pmix_thread_local int obj_cache_registered = 0;
+static pthread_key_t obj_cache_key;
+static int obj_cache_key_gen = 0;
+static bool obj_cache_key_valid = false;
+#endif
+
 
 /*
  * Local functions
@@ -101,6 +126,16 @@ void pmix_class_initialize(pmix_class_t *cls)
         return;
     }
 
+    /* assign a cache slot if one was requested */
+    if (0 > cls->cls_depth) {
+        if (PMIX_HAVE_THREAD_LOCAL && pmix_obj_cache_nslots < PMIX_OBJ_CACHE_SLOTS - 1) {
+            pmix_obj_cache_classes[pmix_obj_cache_nslots + 1] = cls;
+            /* the class must be visible before the count is */
+            pmix_atomic_wmb();
+            ++pmix_obj_cache_nslots;
+        }
+    }
+
     /*
      * First calculate depth of class hierarchy
      * And the number of constructors and destructors
@@ -166,6 +201,86 @@ void pmix_class_initialize(pmix_class_t *cls)
 }
 
 
+#if PMIX_HAVE_THREAD_LOCAL
+static void drain_cache(pmix_obj_cache_t *cache)
+{
+    pmix_object_t *obj;
+    int i;
+
+    for (i=1; i < PMIX_OBJ_CACHE_SLOTS; i++) {
+        while (NULL != (obj = cache[i].head)) {
+            cache[i].head = *(pmix_object_t**)obj;
+            free(obj);
+        }
+        cache[i].count = 0;
+    }
+}
+
+static void cache_key_destruct(void *cache)
+{
+    drain_cache((pmix_obj_cache_t*)cache);
+}
+
+/* make sure whatever this thread holds is released when it exits */
+static void cache_register(void)
+{
+    pthread_mutex_lock(&class_mutex);
+    if (!obj_cache_key_valid) {
+        if (0 != pthread_key_create(&obj_cache_key, cache_key_destruct)) {
+            pthread_mutex_unlock(&class_mutex);
+            return;
+        }
+        obj_cache_key_valid = true;
+        ++obj_cache_key_gen;
+    }
+    pthread_setspecific(obj_cache_key, obj_cache);
+    obj_cache_registered = obj_cache_key_gen;
+    pthread_mutex_unlock(&class_mutex);
+}
+#endif
+
+pmix_object_t *pmix_obj_cache_get(int slot)
+{
+#if PMIX_HAVE_THREAD_LOCAL
+    pmix_obj_cache_t *cache = &obj_cache[slot];
+    pmix_object_t *obj;
+
+    if (NULL == (obj = cache->head)) {
+        return NULL;
+    }
+    cache->head = *(pmix_object_t**)obj;
+    --cache->count;
+    return obj;
+#else
+    return NULL;
+#endif
+}
+
+bool pmix_obj_cache_put(pmix_object_t *object, int slot)
+{
+#if PMIX_HAVE_THREAD_LOCAL
+    pmix_obj_cache_t *cache = &obj_cache[slot];
+
+    if (PMIX_OBJ_CACHE_DEPTH <= cache->count) {
+        return false;
+    }
+    if (obj_cache_registered != obj_cache_key_gen || !obj_cache_key_valid) {
+        cache_register();
+        if (obj_cache_registered != obj_cache_key_gen) {
+            /* nothing would release it */
+            return false;
+        }
+    }
+    /* the object is dead, so reuse its storage for the link */
+    *(pmix_object_t**)object = cache->head;
+    cache->head = object;
+    ++cache->count;
+    return true;
+#else
+    return false;
+#endif
+}
+
 /*
  * Note that this is finalize for *all* classes.
  */
@@ -173,6 +288,21 @@ int pmix_class_finalize(void)
 {
     int i;
 
+#if PMIX_HAVE_THREAD_LOCAL
+    /* release what the finalizing thread has cached - other
+     * threads release theirs as they exit. The key goes too, as
+     * its destructor must not outlive the library, so a thread
+     * that exits after this only releases its cache if it has
+     * registered again in the meantime */
+    drain_cache(obj_cache);
+    pthread_mutex_lock(&class_mutex);
+    if (obj_cache_key_valid) {
+        pthread_key_delete(obj_cache_key);
+        obj_cache_key_valid = false;
+    }
+    pthread_mutex_unlock(&class_mutex);
+#endif
+
     if (INT_MAX == pmix_class_init_epoch) {
         pmix_class_init_epoch = 1;
     } else {
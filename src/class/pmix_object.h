@@ -232,6 +232,32 @@ struct pmix_object_t {
     }
 
 
+/**
+ * Static initializer for a class descriptor whose instances are
+ * recycled through a small per-thread cache on PMIX_RELEASE instead
+ * of being returned to malloc. Intended for short-lived objects that
+ * are created at a high rate - the number of such classes is limited
+ * to PMIX_OBJ_CACHE_SLOTS, and any beyond that are simply not cached.
+ *
+ * The request is carried in the (not yet computed) hierarchy depth so
+ * that the class descriptor keeps its layout.
+ *
+ * Put this in NAME.c
+ */
+#define PMIX_CLASS_INSTANCE_CACHED(NAME, PARENT, CONSTRUCTOR, DESTRUCTOR) \
+    pmix_class_t NAME ## _class = {                                     \
+        # NAME,                                                         \
+        PMIX_CLASS(PARENT),                                              \
+        (pmix_construct_t) CONSTRUCTOR,                                 \
+        (pmix_destruct_t) DESTRUCTOR,                                   \
+        0, -1, NULL, NULL,                                              \
+        sizeof(NAME)                                                    \
+    }
+
+#define PMIX_OBJ_CACHE_SLOTS    16
+#define PMIX_OBJ_CACHE_DEPTH    32
+
+
 /**
  * Declaration for class descriptor
  *
@@ -322,7 +348,7 @@ static inline pmix_object_t *pmix_obj_new_debug(pmix_class_t* type, const char*
             PMIX_SET_MAGIC_ID((object), 0);                              \
             pmix_obj_run_destructors((pmix_object_t *) (object));       \
             PMIX_REMEMBER_FILE_AND_LINENO( object, __FILE__, __LINE__ ); \
-            free(object);                                               \
+            pmix_obj_free((pmix_object_t *) (object));                  \
             object = NULL;                                              \
         }                                                               \
     } while (0)
@@ -331,7 +357,7 @@ static inline pmix_object_t *pmix_obj_new_debug(pmix_class_t* type, const char*
     do {                                                                \
         if (0 == pmix_obj_update((pmix_object_t *) (object), -1)) {     \
             pmix_obj_run_destructors((pmix_object_t *) (object));       \
-            free(object);                                               \
+            pmix_obj_free((pmix_object_t *) (object));                  \
             object = NULL;                                              \
         }                                                               \
     } while (0)
@@ -457,6 +483,81 @@ static inline void pmix_obj_run_destructors(pmix_object_t * object)
 }
 
 
+/**
+ * Take a recycled instance from the calling thread's cache slot, or
+ * return NULL if none is available.
+ *
+ * Do not use this function directly: it is called via PMIX_NEW()
+ */
+PMIX_EXPORT pmix_object_t *pmix_obj_cache_get(int slot);
+
+/**
+ * Offer an instance whose destructors have run to the calling
+ * thread's cache slot. Returns false if the cache is full, in which
+ * case the caller must free it.
+ *
+ * Do not use this function directly: it is called via PMIX_RELEASE()
+ */
+PMIX_EXPORT bool pmix_obj_cache_put(pmix_object_t *object, int slot);
+
+/* the classes that have been given a cache slot, indexed by slot -
+ * slot 0 is never used */
+PMIX_EXPORT extern pmix_class_t *pmix_obj_cache_classes[PMIX_OBJ_CACHE_SLOTS];
+PMIX_EXPORT extern volatile int pmix_obj_cache_nslots;
+
+/**
+ * Return the cache slot of a class, or 0 if it is not cached
+ */
+static inline int pmix_obj_cache_slot(pmix_class_t *cls)
+{
+    int i;
+
+    for (i=1; i <= pmix_obj_cache_nslots; i++) {
+        if (cls == pmix_obj_cache_classes[i]) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+#if PMIX_ENABLE_DEBUG
+/* live instances of each cached class, indexed by slot */
+PMIX_EXPORT extern pmix_atomic_int32_t pmix_obj_cache_live[PMIX_OBJ_CACHE_SLOTS];
+#endif
+
+/**
+ * Number of dynamically allocated instances of a cached class that
+ * have not yet been released - useful for spotting leaks of the
+ * high-rate classes. Always zero in non-debug builds.
+ */
+#if PMIX_ENABLE_DEBUG
+#define PMIX_CLASS_LIVE(NAME)   \
+    ((int) pmix_obj_cache_live[pmix_obj_cache_slot(PMIX_CLASS(NAME))])
+#else
+#define PMIX_CLASS_LIVE(NAME)   0
+#endif
+
+/**
+ * Release the storage of an object whose destructors have run
+ *
+ * Do not use this function directly: use PMIX_RELEASE() instead.
+ */
+static inline void pmix_obj_free(pmix_object_t *object)
+{
+    int slot = pmix_obj_cache_slot(object->obj_class);
+
+#if PMIX_ENABLE_DEBUG
+    if (0 < slot) {
+        PMIX_THREAD_ADD_FETCH32(&pmix_obj_cache_live[slot], -1);
+    }
+#endif
+    if (0 < slot && pmix_obj_cache_put(object, slot)) {
+        return;
+    }
+    free(object);
+}
+
+
 /**
  * Create new object: dynamically allocate storage and run the class
  * constructor.
@@ -469,16 +570,27 @@ static inline void pmix_obj_run_destructors(pmix_object_t * object)
  */
 static inline pmix_object_t *pmix_obj_new(pmix_class_t * cls)
 {
-    pmix_object_t *object;
+    pmix_object_t *object = NULL;
+    int slot;
     assert(cls->cls_sizeof >= sizeof(pmix_object_t));
 
-    object = (pmix_object_t *) malloc(cls->cls_sizeof);
     if (pmix_class_init_epoch != cls->cls_initialized) {
         pmix_class_initialize(cls);
     }
+    if (0 < (slot = pmix_obj_cache_slot(cls))) {
+        object = pmix_obj_cache_get(slot);
+    }
+    if (NULL == object) {
+        object = (pmix_object_t *) malloc(cls->cls_sizeof);
+    }
     if (NULL != object) {
         object->obj_class = cls;
         object->obj_reference_count = 1;
+#if PMIX_ENABLE_DEBUG
+        if (0 < slot) {
+            PMIX_THREAD_ADD_FETCH32(&pmix_obj_cache_live[slot], 1);
+        }
+#endif
         pmix_obj_run_constructors(object);
     }
     return object;
@@ -395,12 +395,61 @@ int pmix_pointer_array_set_size(pmix_pointer_array_t *array, int new_size)
     return PMIX_SUCCESS;
 }
 
+void pmix_pointer_array_shrink(pmix_pointer_array_t *table)
+{
+    int i, used, new_size, new_size_int;
+    uint64_t bits;
+    void *p;
+
+    /* find the highest slot in use from the free bits */
+    used = 0;
+    for (i = (int)TYPE_ELEM_COUNT(uint64_t, table->size) - 1; 0 <= i; i--) {
+        if (0 != (bits = table->free_bits[i])) {
+            used = i * 8 * sizeof(uint64_t);
+            while (0 != bits) {
+                ++used;
+                bits >>= 1;
+            }
+            break;
+        }
+    }
+
+    new_size = table->block_size * ((used + table->block_size - 1) / table->block_size);
+    if (0 == new_size) {
+        new_size = table->block_size;
+    }
+    if (new_size > table->size / 2) {
+        return;
+    }
+
+    p = realloc(table->addr, new_size * sizeof(void *));
+    if (NULL == p) {
+        return;
+    }
+    table->addr = (void**)p;
+    new_size_int = TYPE_ELEM_COUNT(uint64_t, new_size);
+    p = realloc(table->free_bits, new_size_int * sizeof(uint64_t));
+    if (NULL != p) {
+        table->free_bits = (uint64_t*)p;
+    }
+    table->number_free -= (table->size - new_size);
+    table->size = new_size;
+    if (table->lowest_free >= new_size) {
+        table->lowest_free = new_size;
+    }
+}
+
 static bool grow_table(pmix_pointer_array_t *table, int at_least)
 {
     int i, new_size, new_size_int;
     void *p;
 
     new_size = table->block_size * ((at_least + 1 + table->block_size - 1) / table->block_size);
+    /* grow geometrically so that filling the array one element
+     * at a time does not realloc it on every block */
+    if (new_size < 2 * table->size && table->size <= table->max_size - table->size) {
+        new_size = 2 * table->size;
+    }
     if( new_size >= table->max_size ) {
         new_size = table->max_size;
         if( at_least >= table->max_size ) {
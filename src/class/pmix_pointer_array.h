@@ -160,6 +160,18 @@ static inline int pmix_pointer_array_get_size(pmix_pointer_array_t *array)
  */
 PMIX_EXPORT int pmix_pointer_array_set_size(pmix_pointer_array_t *array, int size);
 
+/**
+ * Release the unused tail of the pointer array
+ *
+ * @param array Pointer to array (IN)
+ *
+ * Elements keep their index, so only the free slots above the
+ * highest one in use can be given back. Nothing is done unless
+ * that would at least halve the array - call this after removing
+ * a large number of elements.
+ */
+PMIX_EXPORT void pmix_pointer_array_shrink(pmix_pointer_array_t *array);
+
 /**
  * Test whether a certain element is already in use. If not yet
  * in use, reserve it.
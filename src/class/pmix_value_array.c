@@ -46,6 +46,9 @@ PMIX_CLASS_INSTANCE(
 
 int pmix_value_array_set_size(pmix_value_array_t* array, size_t size)
 {
+    unsigned char *items;
+    size_t alloc_size;
+
 #if PMIX_ENABLE_DEBUG
     if(array->array_item_sizeof == 0) {
         pmix_output(0, "pmix_value_array_set_size: item size must be initialized");
@@ -60,6 +63,18 @@ int pmix_value_array_set_size(pmix_value_array_t* array, size_t size)
             array->array_alloc_size * array->array_item_sizeof);
         if (NULL == array->array_items)
             return PMIX_ERR_OUT_OF_RESOURCE;
+    } else if (0 < size && size < array->array_alloc_size / 4) {
+        /* give back most of the storage once the array has
+         * shrunk well below it, keeping room to grow again */
+        alloc_size = array->array_alloc_size;
+        while (size < alloc_size / 4)
+            alloc_size >>= 1;
+        items = (unsigned char *)realloc(array->array_items,
+            alloc_size * array->array_item_sizeof);
+        if (NULL != items) {
+            array->array_items = items;
+            array->array_alloc_size = alloc_size;
+        }
     }
     array->array_size = size;
     return PMIX_SUCCESS;
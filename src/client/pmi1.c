@@ -34,6 +34,7 @@
 
 #define ANL_MAPPING "PMI_process_mapping"
 
+#include "src/client/pmix_client_ops.h"
 #include "src/mca/bfrops/bfrops.h"
 #include "src/util/argv.h"
 #include "src/util/error.h"
@@ -55,10 +56,25 @@
 /* local functions */
 static pmix_status_t convert_int(int *value, pmix_value_t *kv);
 static int convert_err(pmix_status_t rc);
+static pmix_status_t get_job_int(const char *key, int *value);
 static pmix_proc_t myproc;
 static int pmi_init = 0;
 static bool pmi_singleton = false;
 
+/* job-level integers that legacy codes ask for over and over -
+ * fetched once at init, -1 if they weren't available then */
+static int pmi_size = -1;
+static int pmi_usize = -1;
+static int pmi_appnum = -1;
+static int pmi_lsize = -1;
+
+/* puts are held here until commit so they reach the client's
+ * store in a single trip rather than one per key */
+static pmix_info_t *pmi_puts = NULL;
+static size_t pmi_nputs = 0;
+static size_t pmi_maxputs = 0;
+static pmix_status_t flush_puts(void);
+
 PMIX_EXPORT int PMI_Init(int *spawned)
 {
     pmix_status_t rc = PMIX_SUCCESS;
@@ -106,6 +122,13 @@ PMIX_EXPORT int PMI_Init(int *spawned)
             *spawned = 0;
         }
     }
+
+    (void)get_job_int(PMIX_JOB_SIZE, &pmi_size);
+    (void)get_job_int(PMIX_UNIV_SIZE, &pmi_usize);
+    if (PMIX_ERR_NOT_FOUND == get_job_int(PMIX_APPNUM, &pmi_appnum)) {
+        pmi_appnum = 0;
+    }
+    (void)get_job_int(PMIX_LOCAL_SIZE, &pmi_lsize);
     pmi_init = 1;
 
     rc = PMIX_SUCCESS;
@@ -142,6 +165,12 @@ PMIX_EXPORT int PMI_Finalize(void)
     }
 
     pmi_init = 0;
+    pmi_size = pmi_usize = pmi_appnum = pmi_lsize = -1;
+    if (NULL != pmi_puts) {
+        PMIX_INFO_FREE(pmi_puts, pmi_nputs);
+        pmi_puts = NULL;
+        pmi_nputs = pmi_maxputs = 0;
+    }
     rc = PMIx_Finalize(NULL, 0);
     return convert_err(rc);
 }
@@ -164,8 +193,8 @@ PMIX_EXPORT int PMI_Abort(int flag, const char msg[])
  * provided kvsname as we only put into our own nspace */
 PMIX_EXPORT int PMI_KVS_Put(const char kvsname[], const char key[], const char value[])
 {
-    pmix_status_t rc = PMIX_SUCCESS;
-    pmix_value_t val;
+    pmix_info_t *tmp;
+    size_t max;
 
     PMI_CHECK();
 
@@ -185,10 +214,18 @@ PMIX_EXPORT int PMI_KVS_Put(const char kvsname[], const char key[], const char v
     pmix_output_verbose(2, pmix_globals.debug_output,
             "PMI_KVS_Put: KVS=%s, key=%s value=%s", kvsname, key, value);
 
-    val.type = PMIX_STRING;
-    val.data.string = (char*)value;
-    rc = PMIx_Put(PMIX_GLOBAL, key, &val);
-    return convert_err(rc);
+    if (pmi_nputs == pmi_maxputs) {
+        max = (0 == pmi_maxputs) ? 64 : 2 * pmi_maxputs;
+        tmp = (pmix_info_t*)realloc(pmi_puts, max * sizeof(pmix_info_t));
+        if (NULL == tmp) {
+            return PMI_FAIL;
+        }
+        pmi_puts = tmp;
+        pmi_maxputs = max;
+    }
+    PMIX_INFO_LOAD(&pmi_puts[pmi_nputs], key, value, PMIX_STRING);
+    ++pmi_nputs;
+    return PMI_SUCCESS;
 }
 
 /* KVS_Commit */
@@ -208,6 +245,9 @@ PMIX_EXPORT int PMI_KVS_Commit(const char kvsname[])
     pmix_output_verbose(2, pmix_globals.debug_output, "PMI_KVS_Commit: KVS=%s",
             kvsname);
 
+    if (PMIX_SUCCESS != (rc = flush_puts())) {
+        return convert_err(rc);
+    }
     rc = PMIx_Commit();
     return convert_err(rc);
 }
@@ -240,6 +280,10 @@ PMIX_EXPORT int PMI_KVS_Get( const char kvsname[], const char key[], char value[
          * we don't want to look in rank's data, thus set rank to widcard */
         proc = myproc;
         proc.rank = PMIX_RANK_WILDCARD;
+        /* the server works it out once for the job */
+        if (PMIX_SUCCESS == pmix_client_get_string(&proc, PMIX_ANL_MAP, value, length, NULL)) {
+            return PMI_SUCCESS;
+        }
         if (PMIX_SUCCESS == PMIx_Get(&proc, PMIX_ANL_MAP, NULL, 0, &val) &&
                (NULL != val) && (PMIX_STRING == val->type)) {
             pmix_strncpy(value, val->data.string, length-1);
@@ -262,6 +306,16 @@ PMIX_EXPORT int PMI_KVS_Get( const char kvsname[], const char key[], char value[
     pmix_strncpy(proc.nspace, kvsname, PMIX_MAX_NSLEN);
     proc.rank = PMIX_RANK_UNDEF;
 
+    /* we might be asked for one of our own uncommitted values */
+    if (PMIX_SUCCESS != (rc = flush_puts())) {
+        return convert_err(rc);
+    }
+
+    rc = pmix_client_get_string(&proc, key, value, length, NULL);
+    if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+        return convert_err(rc);
+    }
+
     rc = PMIx_Get(&proc, key, NULL, 0, &val);
     if (PMIX_SUCCESS == rc && NULL != val) {
         if (PMIX_STRING != val->type) {
@@ -304,12 +358,7 @@ PMIX_EXPORT int PMI_Barrier(void)
 
 PMIX_EXPORT int PMI_Get_size(int *size)
 {
-    pmix_status_t rc = PMIX_SUCCESS;
-    pmix_value_t *val;
-    pmix_info_t info[1];
-    bool  val_optinal = 1;
-    pmix_proc_t proc = myproc;
-    proc.rank = PMIX_RANK_WILDCARD;
+    pmix_status_t rc;
 
     PMI_CHECK();
 
@@ -322,21 +371,14 @@ PMIX_EXPORT int PMI_Get_size(int *size)
         return PMI_SUCCESS;
     }
 
-    /* set controlling parameters
-     * PMIX_OPTIONAL - expect that these keys should be available on startup
-     */
-    PMIX_INFO_CONSTRUCT(&info[0]);
-    PMIX_INFO_LOAD(&info[0], PMIX_OPTIONAL, &val_optinal, PMIX_BOOL);
-
-    rc = PMIx_Get(&proc, PMIX_JOB_SIZE, info, 1, &val);
-    if (PMIX_SUCCESS == rc) {
-        rc = convert_int(size, val);
-        PMIX_VALUE_RELEASE(val);
+    if (0 > pmi_size) {
+        rc = get_job_int(PMIX_JOB_SIZE, &pmi_size);
+        if (PMIX_SUCCESS != rc) {
+            return convert_err(rc);
+        }
     }
-
-    PMIX_INFO_DESTRUCT(&info[0]);
-
-    return convert_err(rc);
+    *size = pmi_size;
+    return PMI_SUCCESS;
 }
 
 PMIX_EXPORT int PMI_Get_rank(int *rk)
@@ -353,12 +395,7 @@ PMIX_EXPORT int PMI_Get_rank(int *rk)
 
 PMIX_EXPORT int PMI_Get_universe_size(int *size)
 {
-    pmix_status_t rc = PMIX_SUCCESS;
-    pmix_value_t *val;
-    pmix_info_t info[1];
-    bool  val_optinal = 1;
-    pmix_proc_t proc = myproc;
-    proc.rank = PMIX_RANK_WILDCARD;
+    pmix_status_t rc;
 
     PMI_CHECK();
 
@@ -371,31 +408,19 @@ PMIX_EXPORT int PMI_Get_universe_size(int *size)
         return PMI_SUCCESS;
     }
 
-    /* set controlling parameters
-     * PMIX_OPTIONAL - expect that these keys should be available on startup
-     */
-    PMIX_INFO_CONSTRUCT(&info[0]);
-    PMIX_INFO_LOAD(&info[0], PMIX_OPTIONAL, &val_optinal, PMIX_BOOL);
-
-    rc = PMIx_Get(&proc, PMIX_UNIV_SIZE, info, 1, &val);
-    if (PMIX_SUCCESS == rc) {
-        rc = convert_int(size, val);
-        PMIX_VALUE_RELEASE(val);
+    if (0 > pmi_usize) {
+        rc = get_job_int(PMIX_UNIV_SIZE, &pmi_usize);
+        if (PMIX_SUCCESS != rc) {
+            return convert_err(rc);
+        }
     }
-
-    PMIX_INFO_DESTRUCT(&info[0]);
-
-    return convert_err(rc);
+    *size = pmi_usize;
+    return PMI_SUCCESS;
 }
 
 PMIX_EXPORT int PMI_Get_appnum(int *appnum)
 {
-    pmix_status_t rc = PMIX_SUCCESS;
-    pmix_value_t *val;
-    pmix_info_t info[1];
-    bool  val_optinal = 1;
-    pmix_proc_t proc = myproc;
-    proc.rank = PMIX_RANK_WILDCARD;
+    pmix_status_t rc;
 
     PMI_CHECK();
 
@@ -408,25 +433,17 @@ PMIX_EXPORT int PMI_Get_appnum(int *appnum)
         return PMI_SUCCESS;
     }
 
-    /* set controlling parameters
-     * PMIX_OPTIONAL - expect that these keys should be available on startup
-     */
-    PMIX_INFO_CONSTRUCT(&info[0]);
-    PMIX_INFO_LOAD(&info[0], PMIX_OPTIONAL, &val_optinal, PMIX_BOOL);
-
-    rc = PMIx_Get(&proc, PMIX_APPNUM, info, 1, &val);
-    if (PMIX_SUCCESS == rc) {
-        rc = convert_int(appnum, val);
-        PMIX_VALUE_RELEASE(val);
-    } else if( PMIX_ERR_NOT_FOUND == rc ){
-        /* this is optional value, set to 0 */
-        *appnum = 0;
-        rc = PMIX_SUCCESS;
+    if (0 > pmi_appnum) {
+        rc = get_job_int(PMIX_APPNUM, &pmi_appnum);
+        if (PMIX_ERR_NOT_FOUND == rc) {
+            /* this is optional value, set to 0 */
+            pmi_appnum = 0;
+        } else if (PMIX_SUCCESS != rc) {
+            return convert_err(rc);
+        }
     }
-
-    PMIX_INFO_DESTRUCT(&info[0]);
-
-    return convert_err(rc);
+    *appnum = pmi_appnum;
+    return PMI_SUCCESS;
 }
 
 PMIX_EXPORT int PMI_Publish_name(const char service_name[], const char port[])
@@ -561,12 +578,7 @@ PMIX_EXPORT int PMI_Get_id_length_max(int *length)
 
 PMIX_EXPORT int PMI_Get_clique_size(int *size)
 {
-    pmix_status_t rc = PMIX_SUCCESS;
-    pmix_value_t *val;
-    pmix_info_t info[1];
-    bool  val_optinal = 1;
-    pmix_proc_t proc = myproc;
-    proc.rank = PMIX_RANK_WILDCARD;
+    pmix_status_t rc;
 
     PMI_CHECK();
 
@@ -579,21 +591,14 @@ PMIX_EXPORT int PMI_Get_clique_size(int *size)
         return PMI_SUCCESS;
     }
 
-    /* set controlling parameters
-     * PMIX_OPTIONAL - expect that these keys should be available on startup
-     */
-    PMIX_INFO_CONSTRUCT(&info[0]);
-    PMIX_INFO_LOAD(&info[0], PMIX_OPTIONAL, &val_optinal, PMIX_BOOL);
-
-    rc = PMIx_Get(&proc, PMIX_LOCAL_SIZE, info, 1, &val);
-    if (PMIX_SUCCESS == rc) {
-        rc = convert_int(size, val);
-        PMIX_VALUE_RELEASE(val);
+    if (0 > pmi_lsize) {
+        rc = get_job_int(PMIX_LOCAL_SIZE, &pmi_lsize);
+        if (PMIX_SUCCESS != rc) {
+            return convert_err(rc);
+        }
     }
-
-    PMIX_INFO_DESTRUCT(&info[0]);
-
-    return convert_err(rc);
+    *size = pmi_lsize;
+    return PMI_SUCCESS;
 }
 
 PMIX_EXPORT int PMI_Get_clique_ranks(int ranks[], int length)
@@ -805,6 +810,51 @@ PMIX_EXPORT int PMI_Get_options(char *str, int *length)
 
 /***   UTILITY FUNCTIONS   ***/
 /* internal function */
+static pmix_status_t flush_puts(void)
+{
+    pmix_status_t rc;
+    size_t n;
+
+    rc = pmix_client_put_multi(PMIX_GLOBAL, pmi_puts, pmi_nputs);
+    /* keep the array for the next round */
+    for (n=0; n < pmi_nputs; n++) {
+        PMIX_INFO_DESTRUCT(&pmi_puts[n]);
+    }
+    pmi_nputs = 0;
+    return rc;
+}
+
+static pmix_status_t get_job_int(const char *key, int *value)
+{
+    pmix_status_t rc;
+    pmix_value_t *val;
+    pmix_info_t info[1];
+    bool  val_optinal = 1;
+    pmix_proc_t proc = myproc;
+    proc.rank = PMIX_RANK_WILDCARD;
+
+    rc = pmix_client_get_int(&proc, key, value);
+    if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+        return rc;
+    }
+
+    /* set controlling parameters
+     * PMIX_OPTIONAL - expect that these keys should be available on startup
+     */
+    PMIX_INFO_CONSTRUCT(&info[0]);
+    PMIX_INFO_LOAD(&info[0], PMIX_OPTIONAL, &val_optinal, PMIX_BOOL);
+
+    rc = PMIx_Get(&proc, key, info, 1, &val);
+    if (PMIX_SUCCESS == rc) {
+        rc = convert_int(value, val);
+        PMIX_VALUE_RELEASE(val);
+    }
+
+    PMIX_INFO_DESTRUCT(&info[0]);
+
+    return rc;
+}
+
 static pmix_status_t convert_int(int *value, pmix_value_t *kv)
 {
     switch (kv->type) {
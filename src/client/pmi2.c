@@ -30,6 +30,7 @@
 #include <pmi2.h>
 #include <pmix.h>
 
+#include "src/client/pmix_client_ops.h"
 #include "src/mca/bfrops/bfrops.h"
 #include "src/util/argv.h"
 #include "src/util/error.h"
@@ -48,11 +49,25 @@
 /* local functions */
 static pmix_status_t convert_int(int *value, pmix_value_t *kv);
 static int convert_err(pmix_status_t rc);
+static pmix_status_t get_job_int(const char *key, int *value);
 static pmix_proc_t myproc;
 static int pmi2_init = 0;
 static bool commit_reqd = false;
 static bool pmi2_singleton = false;
 
+/* job-level integers that legacy codes ask for over and over -
+ * fetched once at init, -1 if they weren't available then */
+static int pmi2_usize = -1;
+static int pmi2_appnum = -1;
+static int pmi2_lsize = -1;
+
+/* puts are held here until the fence so they reach the client's
+ * store in a single trip rather than one per key */
+static pmix_info_t *pmi2_puts = NULL;
+static size_t pmi2_nputs = 0;
+static size_t pmi2_maxputs = 0;
+static pmix_status_t flush_puts(void);
+
 PMIX_EXPORT int PMI2_Init(int *spawned, int *size, int *rank, int *appnum)
 {
     pmix_status_t rc = PMIX_SUCCESS;
@@ -96,22 +111,18 @@ PMIX_EXPORT int PMI2_Init(int *spawned, int *size, int *rank, int *appnum)
     PMIX_INFO_CONSTRUCT(&info[0]);
     PMIX_INFO_LOAD(&info[0], PMIX_OPTIONAL, &val_optinal, PMIX_BOOL);
 
-    if (NULL != size) {
-        /* get the universe size - this will likely pull
-         * down all attributes assigned to the job, thus
-         * making all subsequent "get" operations purely
-         * local */
-        if (PMIX_SUCCESS == PMIx_Get(&proc, PMIX_UNIV_SIZE, info, 1, &val)) {
-            rc = convert_int(size, val);
-            PMIX_VALUE_RELEASE(val);
-            if (PMIX_SUCCESS != rc) {
-                goto error;
-            }
-        } else {
-            /* cannot continue without this info */
-            rc = PMIX_ERR_INIT;
-            goto error;
+    /* get the universe size - this will likely pull
+     * down all attributes assigned to the job, thus
+     * making all subsequent "get" operations purely
+     * local */
+    if (PMIX_SUCCESS == get_job_int(PMIX_UNIV_SIZE, &pmi2_usize)) {
+        if (NULL != size) {
+            *size = pmi2_usize;
         }
+    } else if (NULL != size) {
+        /* cannot continue without this info */
+        rc = PMIX_ERR_INIT;
+        goto error;
     }
 
     if (NULL != spawned) {
@@ -128,19 +139,18 @@ PMIX_EXPORT int PMI2_Init(int *spawned, int *size, int *rank, int *appnum)
         }
     }
 
+    /* get our appnum */
+    rc = get_job_int(PMIX_APPNUM, &pmi2_appnum);
+    if (PMIX_ERR_BAD_PARAM == rc) {
+        goto error;
+    } else if (PMIX_SUCCESS != rc) {
+        /* if not found, default to 0 */
+        pmi2_appnum = 0;
+    }
     if (NULL != appnum) {
-        /* get our appnum */
-        if (PMIX_SUCCESS == PMIx_Get(&proc, PMIX_APPNUM, info, 1, &val)) {
-            rc = convert_int(appnum, val);
-            PMIX_VALUE_RELEASE(val);
-            if (PMIX_SUCCESS != rc) {
-                goto error;
-            }
-        } else {
-            /* if not found, default to 0 */
-            *appnum = 0;
-        }
+        *appnum = pmi2_appnum;
     }
+    (void)get_job_int(PMIX_LOCAL_SIZE, &pmi2_lsize);
     pmi2_init = 1;
 
     rc = PMIX_SUCCESS;
@@ -169,6 +179,12 @@ PMIX_EXPORT int PMI2_Finalize(void)
     PMI2_CHECK();
 
     pmi2_init = 0;
+    pmi2_usize = pmi2_appnum = pmi2_lsize = -1;
+    if (NULL != pmi2_puts) {
+        PMIX_INFO_FREE(pmi2_puts, pmi2_nputs);
+        pmi2_puts = NULL;
+        pmi2_nputs = pmi2_maxputs = 0;
+    }
     if (pmi2_singleton) {
         return PMI2_SUCCESS;
     }
@@ -288,13 +304,7 @@ PMIX_EXPORT int PMI2_Job_GetRank(int *rank)
 
 PMIX_EXPORT int PMI2_Info_GetSize(int *size)
 {
-    pmix_status_t rc = PMIX_ERROR;
-    pmix_value_t *val;
-    pmix_info_t info[1];
-    bool  val_optinal = 1;
-    pmix_proc_t proc = myproc;
-    proc.rank = PMIX_RANK_WILDCARD;
-
+    pmix_status_t rc;
 
     PMI2_CHECK();
 
@@ -307,20 +317,14 @@ PMIX_EXPORT int PMI2_Info_GetSize(int *size)
         return PMI2_SUCCESS;
     }
 
-    /* set controlling parameters
-     * PMIX_OPTIONAL - expect that these keys should be available on startup
-     */
-    PMIX_INFO_CONSTRUCT(&info[0]);
-    PMIX_INFO_LOAD(&info[0], PMIX_OPTIONAL, &val_optinal, PMIX_BOOL);
-
-    if (PMIX_SUCCESS == PMIx_Get(&proc, PMIX_LOCAL_SIZE, info, 1, &val)) {
-        rc = convert_int(size, val);
-        PMIX_VALUE_RELEASE(val);
+    if (0 > pmi2_lsize) {
+        rc = get_job_int(PMIX_LOCAL_SIZE, &pmi2_lsize);
+        if (PMIX_SUCCESS != rc) {
+            return convert_err(rc);
+        }
     }
-
-    PMIX_INFO_DESTRUCT(&info[0]);
-
-    return convert_err(rc);
+    *size = pmi2_lsize;
+    return PMI2_SUCCESS;
 }
 
 PMIX_EXPORT int PMI2_Job_Connect(const char jobid[], PMI2_Connect_comm_t *conn)
@@ -366,8 +370,8 @@ PMIX_EXPORT int PMI2_Job_Disconnect(const char jobid[])
 /* KVS_Put - we default to PMIX_GLOBAL scope */
 PMIX_EXPORT int PMI2_KVS_Put(const char key[], const char value[])
 {
-    pmix_status_t rc = PMIX_SUCCESS;
-    pmix_value_t val;
+    pmix_info_t *tmp;
+    size_t max;
 
     PMI2_CHECK();
 
@@ -382,12 +386,19 @@ PMIX_EXPORT int PMI2_KVS_Put(const char key[], const char value[])
     pmix_output_verbose(3, pmix_globals.debug_output,
             "PMI2_KVS_Put: key=%s value=%s", key, value);
 
-    val.type = PMIX_STRING;
-    val.data.string = (char*)value;
-    if (PMIX_SUCCESS == (rc = PMIx_Put(PMIX_GLOBAL, key, &val))) {
-        commit_reqd = true;
+    if (pmi2_nputs == pmi2_maxputs) {
+        max = (0 == pmi2_maxputs) ? 64 : 2 * pmi2_maxputs;
+        tmp = (pmix_info_t*)realloc(pmi2_puts, max * sizeof(pmix_info_t));
+        if (NULL == tmp) {
+            return PMI2_FAIL;
+        }
+        pmi2_puts = tmp;
+        pmi2_maxputs = max;
     }
-    return convert_err(rc);
+    PMIX_INFO_LOAD(&pmi2_puts[pmi2_nputs], key, value, PMIX_STRING);
+    ++pmi2_nputs;
+    commit_reqd = true;
+    return PMI2_SUCCESS;
 }
 
 /* KVS_Fence */
@@ -403,7 +414,8 @@ PMIX_EXPORT int PMI2_KVS_Fence(void)
         return PMI2_SUCCESS;
     }
 
-    if (PMIX_SUCCESS != (rc = PMIx_Commit())) {
+    if (PMIX_SUCCESS != (rc = flush_puts()) ||
+        PMIX_SUCCESS != (rc = PMIx_Commit())) {
         return convert_err(rc);
     }
     commit_reqd = false;
@@ -438,6 +450,7 @@ PMIX_EXPORT int PMI2_KVS_Get(const char *jobid, int src_pmi_id,
     pmix_status_t rc = PMIX_SUCCESS;
     pmix_value_t *val;
     pmix_proc_t proc;
+    size_t len = 0;
 
     PMI2_CHECK();
 
@@ -463,6 +476,12 @@ PMIX_EXPORT int PMI2_KVS_Get(const char *jobid, int src_pmi_id,
         proc.rank = src_pmi_id;
     }
 
+    rc = pmix_client_get_string(&proc, key, value, maxvalue, &len);
+    if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+        *vallen = len;
+        return convert_err(rc);
+    }
+
     rc = PMIx_Get(&proc, key, NULL, 0, &val);
     if (PMIX_SUCCESS == rc && NULL != val) {
         if (PMIX_STRING != val->type) {
@@ -506,6 +525,14 @@ PMIX_EXPORT int PMI2_Info_GetNodeAttr(const char name[],
 
     *found = 0;
     /* TODO: does PMI2's "name" makes sense to PMIx? */
+    rc = pmix_client_get_string(&proc, name, value, valuelen, NULL);
+    if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+        PMIX_INFO_DESTRUCT(&info[0]);
+        if (PMIX_SUCCESS == rc) {
+            *found = 1;
+        }
+        return convert_err(rc);
+    }
     rc = PMIx_Get(&proc, name, info, 1, &val);
     if (PMIX_SUCCESS == rc && NULL != val) {
         if (PMIX_STRING != val->type) {
@@ -584,6 +611,12 @@ PMIX_EXPORT int PMI2_Info_GetJobAttr(const char name[], char value[], int valuel
          * we don't want to look in rank's data, thus set rank to widcard */
         proc = myproc;
         proc.rank = PMIX_RANK_WILDCARD;
+        /* the server works it out once for the job */
+        if (PMIX_SUCCESS == pmix_client_get_string(&proc, PMIX_ANL_MAP, value, valuelen, NULL)) {
+            PMIX_INFO_DESTRUCT(&info[0]);
+            *found = 1;
+            return PMI2_SUCCESS;
+        }
         if (PMIX_SUCCESS == PMIx_Get(&proc, PMIX_ANL_MAP, NULL, 0, &val) &&
                (NULL != val) && (PMIX_STRING == val->type)) {
             pmix_strncpy(value, val->data.string, valuelen);
@@ -605,6 +638,14 @@ PMIX_EXPORT int PMI2_Info_GetJobAttr(const char name[], char value[], int valuel
 
 
     *found = 0;
+    rc = pmix_client_get_string(&proc, name, value, valuelen, NULL);
+    if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+        PMIX_INFO_DESTRUCT(&info[0]);
+        if (PMIX_SUCCESS == rc) {
+            *found = 1;
+        }
+        return convert_err(rc);
+    }
     rc = PMIx_Get(&proc, name, info, 1, &val);
     if (PMIX_SUCCESS == rc && NULL != val) {
         if (PMIX_STRING != val->type) {
@@ -757,6 +798,51 @@ PMIX_EXPORT int PMI2_Nameserv_unpublish(const char service_name[],
 }
 
 /****    CONVERSION ROUTINES    ****/
+static pmix_status_t flush_puts(void)
+{
+    pmix_status_t rc;
+    size_t n;
+
+    rc = pmix_client_put_multi(PMIX_GLOBAL, pmi2_puts, pmi2_nputs);
+    /* keep the array for the next round */
+    for (n=0; n < pmi2_nputs; n++) {
+        PMIX_INFO_DESTRUCT(&pmi2_puts[n]);
+    }
+    pmi2_nputs = 0;
+    return rc;
+}
+
+static pmix_status_t get_job_int(const char *key, int *value)
+{
+    pmix_status_t rc;
+    pmix_value_t *val;
+    pmix_info_t info[1];
+    bool  val_optinal = 1;
+    pmix_proc_t proc = myproc;
+    proc.rank = PMIX_RANK_WILDCARD;
+
+    rc = pmix_client_get_int(&proc, key, value);
+    if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+        return rc;
+    }
+
+    /* set controlling parameters
+     * PMIX_OPTIONAL - expect that these keys should be available on startup
+     */
+    PMIX_INFO_CONSTRUCT(&info[0]);
+    PMIX_INFO_LOAD(&info[0], PMIX_OPTIONAL, &val_optinal, PMIX_BOOL);
+
+    rc = PMIx_Get(&proc, key, info, 1, &val);
+    if (PMIX_SUCCESS == rc) {
+        rc = convert_int(value, val);
+        PMIX_VALUE_RELEASE(val);
+    }
+
+    PMIX_INFO_DESTRUCT(&info[0]);
+
+    return rc;
+}
+
 static pmix_status_t convert_int(int *value, pmix_value_t *kv)
 {
     switch(kv->type) {
@@ -57,12 +57,15 @@ static pmix_status_t pmix_init_result = PMIX_ERR_INIT;
 
 #include "src/class/pmix_list.h"
 #include "src/event/pmix_event.h"
+#include "src/event/pmix_event_ring.h"
 #include "src/util/argv.h"
 #include "src/util/compress.h"
+#include "src/util/counters.h"
 #include "src/util/error.h"
 #include "src/util/hash.h"
 #include "src/util/name_fns.h"
 #include "src/util/output.h"
+#include "src/util/timings.h"
 #include "src/runtime/pmix_progress_threads.h"
 #include "src/runtime/pmix_rte.h"
 #include "src/threads/threads.h"
@@ -72,6 +75,7 @@ static pmix_status_t pmix_init_result = PMIX_ERR_INIT;
 #include "src/mca/ptl/base/base.h"
 #include "src/include/pmix_globals.h"
 #include "src/common/pmix_iof.h"
+#include "src/hwloc/hwloc-internal.h"
 
 #include "pmix_client_ops.h"
 
@@ -233,6 +237,11 @@ static void job_data(struct pmix_peer_t *pr,
     PMIX_GDS_STORE_JOB_INFO(cb->status,
                             pmix_client_globals.myserver,
                             nspace, buf);
+    pmix_client_resolve_invalidate(nspace);
+    if (PMIX_SUCCESS == cb->status &&
+        0 == strncmp(nspace, pmix_globals.myid.nspace, PMIX_MAX_NSLEN)) {
+        pmix_client_snapshot_build();
+    }
     free(nspace);
     cb->status = PMIX_SUCCESS;
     PMIX_POST_OBJECT(cb);
@@ -479,10 +488,23 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc,
     rcv->cbfunc = client_iof_handler;
     /* add it to the end of the list of recvs */
     pmix_list_append(&pmix_ptl_globals.posted_recvs, &rcv->super);
+    /* and the one for output sent in batches */
+    rcv = PMIX_NEW(pmix_ptl_posted_recv_t);
+    rcv->tag = PMIX_PTL_TAG_IOF_BATCH;
+    rcv->cbfunc = pmix_iof_batch_recv;
+    pmix_list_append(&pmix_ptl_globals.posted_recvs, &rcv->super);
 
 
     /* setup the globals */
     PMIX_CONSTRUCT(&pmix_client_globals.pending_requests, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_client_globals.stage_lock, pmix_mutex_t);
+    PMIX_CONSTRUCT(&pmix_client_globals.staged, pmix_list_t);
+    pmix_client_globals.stage_puts = true;
+    pmix_client_globals.dirty_local = NULL;
+    pmix_client_globals.dirty_remote = NULL;
+    pmix_client_globals.commit_delta = -1;
+    pmix_client_globals.procset_ranges = -1;
+    PMIX_CONSTRUCT(&pmix_client_globals.resolved, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_client_globals.peers, pmix_pointer_array_t);
     pmix_pointer_array_init(&pmix_client_globals.peers, 1, INT_MAX, 1);
     pmix_client_globals.myserver = PMIX_NEW(pmix_peer_t);
@@ -627,6 +649,11 @@ PMIX_EXPORT pmix_status_t PMIx_Init(pmix_proc_t *proc,
     /* mark that we are using the same module as used for the server */
     pmix_globals.mypeer->nptr->compat.ptl = pmix_client_globals.myserver->nptr->compat.ptl;
 
+    /* if our server gave us an event ring, start reading it */
+    if (PMIX_SUCCESS != (rc = pmix_event_ring_attach(pmix_client_notify_recv))) {
+        PMIX_ERROR_LOG(rc);
+    }
+
     /* send a request for our job info - we do this as a non-blocking
      * transaction because some systems cannot handle very large
      * blocking operations and error out if we try them. */
@@ -834,6 +861,10 @@ PMIX_EXPORT pmix_status_t PMIx_Finalize(const pmix_info_t info[], size_t ninfo)
                              pmix_globals.myid.nspace, pmix_globals.myid.rank);
     }
 
+    /* stop reading the event ring before the progress
+     * thread it hands events to goes away */
+    pmix_event_ring_detach();
+
     if (!pmix_globals.external_evbase) {
         /* stop the progress thread, but leave the event base
          * still constructed. This will allow us to safely
@@ -843,12 +874,22 @@ PMIX_EXPORT pmix_status_t PMIx_Finalize(const pmix_info_t info[], size_t ninfo)
     }
 
     PMIX_LIST_DESTRUCT(&pmix_client_globals.pending_requests);
+    pmix_client_globals.stage_puts = false;
+    PMIX_LIST_DESTRUCT(&pmix_client_globals.staged);
+    PMIX_DESTRUCT(&pmix_client_globals.stage_lock);
+    pmix_argv_free(pmix_client_globals.dirty_local);
+    pmix_client_globals.dirty_local = NULL;
+    pmix_argv_free(pmix_client_globals.dirty_remote);
+    pmix_client_globals.dirty_remote = NULL;
+    PMIX_LIST_DESTRUCT(&pmix_client_globals.resolved);
     for (i=0; i < pmix_client_globals.peers.size; i++) {
         if (NULL != (peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_client_globals.peers, i))) {
             PMIX_RELEASE(peer);
         }
     }
     PMIX_DESTRUCT(&pmix_client_globals.peers);
+    pmix_client_snapshot_release();
+    pmix_hwloc_cleanup();
 
     if (0 <= pmix_client_globals.myserver->sd) {
         CLOSE_THE_SOCKET(pmix_client_globals.myserver->sd);
@@ -955,31 +996,55 @@ PMIX_EXPORT pmix_status_t PMIx_Abort(int flag, const char msg[],
      return PMIX_SUCCESS;
  }
 
-static void _putfn(int sd, short args, void *cbdata)
+typedef struct {
+    pmix_list_item_t super;
+    pmix_scope_t scope;
+    pmix_kval_t *kv;
+} pmix_client_staged_t;
+static void stcon(pmix_client_staged_t *p)
+{
+    p->scope = PMIX_SCOPE_UNDEF;
+    p->kv = NULL;
+}
+static void stdes(pmix_client_staged_t *p)
+{
+    if (NULL != p->kv) {
+        PMIX_RELEASE(p->kv);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_client_staged_t,
+                           pmix_list_item_t,
+                           stcon, stdes);
+
+/* build the kval for a put - this touches nothing global and
+ * so can be done in the caller's thread. Returns with *kvout
+ * left NULL if the key need not be stored */
+static pmix_status_t _load_kv(const char *key, pmix_value_t *val,
+                              pmix_kval_t **kvout)
 {
-    pmix_cb_t *cb = (pmix_cb_t*)cbdata;
     pmix_status_t rc;
-    pmix_kval_t *kv = NULL;
+    pmix_kval_t *kv;
     uint8_t *tmp;
     size_t len;
 
-    /* need to acquire the cb object from its originating thread */
-    PMIX_ACQUIRE_OBJECT(cb);
+    *kvout = NULL;
 
     /* no need to push info that starts with "pmix" as that is
      * info we would have been provided at startup */
-    if (0 == strncmp(cb->key, "pmix", 4)) {
-        rc = PMIX_SUCCESS;
-        goto done;
+    if (0 == strncmp(key, "pmix", 4)) {
+        return PMIX_SUCCESS;
     }
 
     /* setup to xfer the data */
     kv = PMIX_NEW(pmix_kval_t);
-    kv->key = strdup(cb->key);  // need to copy as the input belongs to the user
+    if (NULL == kv) {
+        return PMIX_ERR_NOMEM;
+    }
+    kv->key = strdup(key);  // need to copy as the input belongs to the user
     kv->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
-    if (PMIX_STRING_SIZE_CHECK(cb->value)) {
+    if (PMIX_STRING_SIZE_CHECK(val)) {
         /* compress large strings */
-        if (pmix_util_compress_string(cb->value->data.string, &tmp, &len)) {
+        if (pmix_util_compress_string(val->data.string, &tmp, &len)) {
             if (NULL == tmp) {
                 PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
                 rc = PMIX_ERR_NOMEM;
@@ -992,34 +1057,118 @@ static void _putfn(int sd, short args, void *cbdata)
             rc = PMIX_SUCCESS;
         } else {
             PMIX_BFROPS_VALUE_XFER(rc, pmix_globals.mypeer,
-                                   kv->value, cb->value);
+                                   kv->value, val);
         }
     } else {
         PMIX_BFROPS_VALUE_XFER(rc, pmix_globals.mypeer,
-                               kv->value, cb->value);
+                               kv->value, val);
     }
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         goto done;
     }
+    *kvout = kv;
+    return PMIX_SUCCESS;
+
+  done:
+    PMIX_RELEASE(kv);
+    return rc;
+}
+
+static pmix_status_t _store_kv(pmix_scope_t scope, pmix_kval_t *kv)
+{
+    pmix_status_t rc;
 
-    /* store it */
     PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer,
                        &pmix_globals.myid,
-                       cb->scope, kv);
+                       scope, kv);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
+        return rc;
     }
 
     /* mark that fresh values have been stored so we know
      * to commit them later */
     pmix_globals.commits_pending = true;
+    if (PMIX_PROC_IS_CLIENT(pmix_globals.mypeer)) {
+        if (PMIX_LOCAL == scope || PMIX_GLOBAL == scope) {
+            pmix_argv_append_unique_nosize(&pmix_client_globals.dirty_local, kv->key, false);
+        }
+        if (PMIX_REMOTE == scope || PMIX_GLOBAL == scope) {
+            pmix_argv_append_unique_nosize(&pmix_client_globals.dirty_remote, kv->key, false);
+        }
+    }
+    return rc;
+}
 
-  done:
-    if (NULL != kv) {
-        PMIX_RELEASE(kv);  // maintain accounting
+static pmix_status_t _put(pmix_scope_t scope, const char *key, pmix_value_t *val)
+{
+    pmix_status_t rc;
+    pmix_kval_t *kv;
+
+    rc = _load_kv(key, val, &kv);
+    if (PMIX_SUCCESS != rc || NULL == kv) {
+        return rc;
     }
-    cb->pstatus = rc;
+    rc = _store_kv(scope, kv);
+    PMIX_RELEASE(kv);  // maintain accounting
+    return rc;
+}
+
+void pmix_client_drain_puts(void)
+{
+    pmix_list_t batch;
+    pmix_client_staged_t *st;
+
+    if (!pmix_client_globals.stage_puts) {
+        return;
+    }
+    PMIX_CONSTRUCT(&batch, pmix_list_t);
+    pmix_mutex_lock(&pmix_client_globals.stage_lock);
+    pmix_list_join(&batch, pmix_list_get_end(&batch), &pmix_client_globals.staged);
+    pmix_mutex_unlock(&pmix_client_globals.stage_lock);
+
+    /* errors were already logged - the caller of the put
+     * was told of success when it was staged */
+    PMIX_LIST_FOREACH(st, &batch, pmix_client_staged_t) {
+        (void)_store_kv(st->scope, st->kv);
+    }
+    PMIX_LIST_DESTRUCT(&batch);
+}
+
+bool pmix_client_puts_staged(void)
+{
+    bool staged;
+
+    if (!pmix_client_globals.stage_puts) {
+        return false;
+    }
+    pmix_mutex_lock(&pmix_client_globals.stage_lock);
+    staged = !pmix_list_is_empty(&pmix_client_globals.staged);
+    pmix_mutex_unlock(&pmix_client_globals.stage_lock);
+    return staged;
+}
+
+static void _putfn(int sd, short args, void *cbdata)
+{
+    pmix_cb_t *cb = (pmix_cb_t*)cbdata;
+    size_t n;
+
+    /* need to acquire the cb object from its originating thread */
+    PMIX_ACQUIRE_OBJECT(cb);
+
+    /* keep the order in which the values were put */
+    pmix_client_drain_puts();
+
+    if (NULL != cb->info) {
+        cb->pstatus = PMIX_SUCCESS;
+        for (n=0; n < cb->ninfo && PMIX_SUCCESS == cb->pstatus; n++) {
+            cb->pstatus = _put(cb->scope, cb->info[n].key, &cb->info[n].value);
+        }
+    } else {
+        cb->pstatus = _put(cb->scope, cb->key, cb->value);
+    }
+
     /* post the data so the receiving thread can acquire it */
     PMIX_POST_OBJECT(cb);
     PMIX_WAKEUP_THREAD(&cb->lock);
@@ -1031,6 +1180,8 @@ PMIX_EXPORT pmix_status_t PMIx_Put(pmix_scope_t scope,
 {
     pmix_cb_t *cb;
     pmix_status_t rc;
+    pmix_kval_t *kv;
+    pmix_client_staged_t *st;
 
     pmix_output_verbose(2, pmix_client_globals.base_output,
                         "pmix: executing put for key %s type %d",
@@ -1043,6 +1194,27 @@ PMIX_EXPORT pmix_status_t PMIx_Put(pmix_scope_t scope,
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
+    /* a client only needs its values in the GDS when it commits
+     * or reads them back, so hold the put here rather than take
+     * a trip through the event library for every key */
+    if (pmix_client_globals.stage_puts) {
+        rc = _load_kv(key, val, &kv);
+        if (PMIX_SUCCESS != rc || NULL == kv) {
+            return rc;
+        }
+        st = PMIX_NEW(pmix_client_staged_t);
+        if (NULL == st) {
+            PMIX_RELEASE(kv);
+            return PMIX_ERR_NOMEM;
+        }
+        st->scope = scope;
+        st->kv = kv;
+        pmix_mutex_lock(&pmix_client_globals.stage_lock);
+        pmix_list_append(&pmix_client_globals.staged, &st->super);
+        pmix_mutex_unlock(&pmix_client_globals.stage_lock);
+        return PMIX_SUCCESS;
+    }
+
     /* create a callback object */
     cb = PMIX_NEW(pmix_cb_t);
     cb->scope = scope;
@@ -1060,6 +1232,120 @@ PMIX_EXPORT pmix_status_t PMIx_Put(pmix_scope_t scope,
     return rc;
 }
 
+pmix_status_t pmix_client_put_multi(pmix_scope_t scope,
+                                   pmix_info_t *info, size_t ninfo)
+{
+    pmix_cb_t *cb;
+    pmix_status_t rc;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (0 == ninfo) {
+        return PMIX_SUCCESS;
+    }
+
+    /* one trip into the event library for all of them */
+    cb = PMIX_NEW(pmix_cb_t);
+    cb->scope = scope;
+    cb->info = info;
+    cb->ninfo = ninfo;
+    PMIX_THREADSHIFT(cb, _putfn);
+
+    /* wait for the result */
+    PMIX_WAIT_THREAD(&cb->lock);
+    rc = cb->pstatus;
+    cb->info = NULL;
+    cb->ninfo = 0;
+    PMIX_RELEASE(cb);
+
+    return rc;
+}
+
+/* see if our server told us it will merge a commit of just
+ * the values that changed into those we sent before */
+static bool _commit_delta(void)
+{
+    pmix_cb_t cb;
+    pmix_proc_t wildcard;
+    pmix_status_t rc;
+
+    if (0 > pmix_client_globals.commit_delta) {
+        PMIX_LOAD_PROCID(&wildcard, pmix_globals.myid.nspace, PMIX_RANK_WILDCARD);
+        PMIX_CONSTRUCT(&cb, pmix_cb_t);
+        cb.proc = &wildcard;
+        cb.key = PMIX_COMMIT_DELTA_KEY;
+        cb.scope = PMIX_INTERNAL;
+        cb.copy = false;
+        PMIX_GDS_FETCH_KV(rc, pmix_client_globals.myserver, &cb);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+        }
+        pmix_client_globals.commit_delta = (PMIX_SUCCESS == rc) ? 1 : 0;
+        PMIX_DESTRUCT(&cb);
+    }
+    return (0 < pmix_client_globals.commit_delta);
+}
+
+pmix_status_t pmix_client_pack_procs(pmix_buffer_t *msg,
+                                     const pmix_proc_t *procs,
+                                     size_t nprocs)
+{
+    pmix_cb_t cb;
+    pmix_proc_t wildcard;
+    pmix_status_t rc;
+
+    /* see if our server told us it takes rank ranges */
+    if (0 > pmix_client_globals.procset_ranges) {
+        PMIX_LOAD_PROCID(&wildcard, pmix_globals.myid.nspace, PMIX_RANK_WILDCARD);
+        PMIX_CONSTRUCT(&cb, pmix_cb_t);
+        cb.proc = &wildcard;
+        cb.key = PMIX_PROCSET_RANGES_KEY;
+        cb.scope = PMIX_INTERNAL;
+        cb.copy = false;
+        PMIX_GDS_FETCH_KV(rc, pmix_client_globals.myserver, &cb);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+        }
+        pmix_client_globals.procset_ranges = (PMIX_SUCCESS == rc) ? 1 : 0;
+        PMIX_DESTRUCT(&cb);
+    }
+    rc = pmix_bfrops_base_pack_procset(pmix_client_globals.myserver, msg, procs, nprocs,
+                                       0 < pmix_client_globals.procset_ranges);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    return rc;
+}
+
+/* collect our values for the given scope - all of them, or just
+ * those named in dirty if that is given */
+static pmix_status_t _commit_fetch(pmix_cb_t *cb, pmix_scope_t scope,
+                                   bool copy, char **dirty, bool delta)
+{
+    pmix_status_t rc;
+    size_t n;
+
+    cb->proc = &pmix_globals.myid;
+    cb->scope = scope;
+    cb->copy = copy;
+    if (!delta) {
+        cb->key = NULL;
+        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
+        return rc;
+    }
+    for (n=0; NULL != dirty && NULL != dirty[n]; n++) {
+        cb->key = dirty[n];
+        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
+    }
+    cb->key = NULL;
+    return pmix_list_is_empty(&cb->kvs) ? PMIX_ERR_NOT_FOUND : PMIX_SUCCESS;
+}
+
 static void _commitfn(int sd, short args, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t*)cbdata;
@@ -1068,10 +1354,20 @@ static void _commitfn(int sd, short args, void *cbdata)
     pmix_buffer_t *msgout, bkt;
     pmix_cmd_t cmd=PMIX_COMMIT_CMD;
     pmix_kval_t *kv, *kvn;
+    bool delta;
 
     /* need to acquire the cb object from its originating thread */
     PMIX_ACQUIRE_OBJECT(cb);
 
+    pmix_client_drain_puts();
+
+    /* once the server has our values, it only needs to
+     * hear about those that have changed */
+    delta = _commit_delta();
+    if (delta) {
+        cmd = PMIX_COMMIT_DELTA_CMD;
+    }
+
     msgout = PMIX_NEW(pmix_buffer_t);
     /* pack the cmd */
     PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
@@ -1089,10 +1385,7 @@ static void _commitfn(int sd, short args, void *cbdata)
         /* allow the GDS module to pass us this info
          * as a local connection as this data would
          * only go to another local client */
-        cb->proc = &pmix_globals.myid;
-        cb->scope = scope;
-        cb->copy = false;
-        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
+        rc = _commit_fetch(cb, scope, false, pmix_client_globals.dirty_local, delta);
         if (PMIX_SUCCESS == rc) {
             PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
                              msgout, &scope, 1, PMIX_SCOPE);
@@ -1130,10 +1423,7 @@ static void _commitfn(int sd, short args, void *cbdata)
         /* we need real copies here as this data will
          * go to remote procs - so a connection will
          * not suffice */
-        cb->proc = &pmix_globals.myid;
-        cb->scope = scope;
-        cb->copy = true;
-        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
+        rc = _commit_fetch(cb, scope, true, pmix_client_globals.dirty_remote, delta);
         if (PMIX_SUCCESS == rc) {
             PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
                              msgout, &scope, 1, PMIX_SCOPE);
@@ -1168,6 +1458,10 @@ static void _commitfn(int sd, short args, void *cbdata)
 
         /* record that all committed data to-date has been sent */
         pmix_globals.commits_pending = false;
+        pmix_argv_free(pmix_client_globals.dirty_local);
+        pmix_client_globals.dirty_local = NULL;
+        pmix_argv_free(pmix_client_globals.dirty_remote);
+        pmix_client_globals.dirty_remote = NULL;
     }
 
     /* always send, even if we have nothing to contribute, so the server knows
@@ -1192,6 +1486,7 @@ static void _commitfn(int sd, short args, void *cbdata)
  {
     pmix_cb_t *cb;
     pmix_status_t rc;
+    uint64_t start = pmix_counter_now();
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
     if (pmix_globals.init_cntr <= 0) {
@@ -1219,16 +1514,131 @@ static void _commitfn(int sd, short args, void *cbdata)
     PMIX_WAIT_THREAD(&cb->lock);
     rc = cb->pstatus;
     PMIX_RELEASE(cb);
+    pmix_counter_time(PMIX_CTR_COMMIT, start);
+    PMIX_TRACE_SPAN("PMIx_Commit", start);
 
     return rc;
 }
 
+/* Rank-placement-aware libraries resolve every node of their job at
+ * init, and each resolution otherwise refetches and reparses the node
+ * and proc maps. So remember the answers for each nspace until its
+ * job-level info is stored again. Servers see their nspaces change
+ * underneath them and so always ask the preg framework */
+typedef struct {
+    pmix_list_item_t super;
+    char *nspace;
+    char *nodes;                // answer to Resolve_nodes, if asked
+    pmix_hash_table_t peers;    // node -> pmix_client_peers_t
+} pmix_client_resolved_t;
+
+typedef struct {
+    size_t nprocs;
+    pmix_proc_t procs[];
+} pmix_client_peers_t;
+
+static void rslvcon(pmix_client_resolved_t *p)
+{
+    p->nspace = NULL;
+    p->nodes = NULL;
+    PMIX_CONSTRUCT(&p->peers, pmix_hash_table_t);
+    pmix_hash_table_init(&p->peers, 16);
+}
+static void rslvdes(pmix_client_resolved_t *p)
+{
+    void *key, *node, *next;
+    size_t keylen;
+    pmix_client_peers_t *pr;
+    int rc;
+
+    if (NULL != p->nspace) {
+        free(p->nspace);
+    }
+    if (NULL != p->nodes) {
+        free(p->nodes);
+    }
+    rc = pmix_hash_table_get_first_key_ptr(&p->peers, &key, &keylen, (void**)&pr, &node);
+    while (PMIX_SUCCESS == rc) {
+        free(pr);
+        rc = pmix_hash_table_get_next_key_ptr(&p->peers, &key, &keylen, (void**)&pr, node, &next);
+        node = next;
+    }
+    PMIX_DESTRUCT(&p->peers);
+}
+static PMIX_CLASS_INSTANCE(pmix_client_resolved_t,
+                           pmix_list_item_t,
+                           rslvcon, rslvdes);
+
+static pmix_client_resolved_t* resolved_find(const char *nspace, bool create)
+{
+    pmix_client_resolved_t *rs;
+
+    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        return NULL;
+    }
+    PMIX_LIST_FOREACH(rs, &pmix_client_globals.resolved, pmix_client_resolved_t) {
+        if (0 == strncmp(rs->nspace, nspace, PMIX_MAX_NSLEN)) {
+            return rs;
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+    rs = PMIX_NEW(pmix_client_resolved_t);
+    rs->nspace = strdup(nspace);
+    pmix_list_append(&pmix_client_globals.resolved, &rs->super);
+    return rs;
+}
+
+void pmix_client_resolve_invalidate(const char *nspace)
+{
+    pmix_client_resolved_t *rs, *rsnext;
+
+    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        return;
+    }
+    PMIX_LIST_FOREACH_SAFE(rs, rsnext, &pmix_client_globals.resolved, pmix_client_resolved_t) {
+        if (NULL == nspace || 0 == strncmp(rs->nspace, nspace, PMIX_MAX_NSLEN)) {
+            pmix_list_remove_item(&pmix_client_globals.resolved, &rs->super);
+            PMIX_RELEASE(rs);
+        }
+    }
+}
+
 static void _resolve_peers(int sd, short args, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t*)cbdata;
+    const char *node = (NULL == cb->key) ? "" : cb->key;
+    pmix_client_resolved_t *rs;
+    pmix_client_peers_t *pr;
+
+    if (NULL != (rs = resolved_find(cb->pname.nspace, false)) &&
+        PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&rs->peers, node,
+                                                      strlen(node), (void**)&pr)) {
+        cb->procs = NULL;
+        cb->nprocs = pr->nprocs;
+        if (0 < pr->nprocs) {
+            PMIX_PROC_CREATE(cb->procs, pr->nprocs);
+            memcpy(cb->procs, pr->procs, pr->nprocs * sizeof(pmix_proc_t));
+        }
+        cb->status = PMIX_SUCCESS;
+        goto done;
+    }
 
     cb->status = pmix_preg.resolve_peers(cb->key, cb->pname.nspace,
                                          &cb->procs, &cb->nprocs);
+    if (PMIX_SUCCESS == cb->status &&
+        NULL != (rs = resolved_find(cb->pname.nspace, true)) &&
+        NULL != (pr = (pmix_client_peers_t*)malloc(sizeof(pmix_client_peers_t) +
+                                                   cb->nprocs * sizeof(pmix_proc_t)))) {
+        pr->nprocs = cb->nprocs;
+        if (0 < cb->nprocs) {
+            memcpy(pr->procs, cb->procs, cb->nprocs * sizeof(pmix_proc_t));
+        }
+        pmix_hash_table_set_value_ptr(&rs->peers, node, strlen(node), pr);
+    }
+
+  done:
     /* post the data so the receiving thread can acquire it */
     PMIX_POST_OBJECT(cb);
     PMIX_WAKEUP_THREAD(&cb->lock);
@@ -1289,20 +1699,33 @@ static void _resolve_nodes(int fd, short args, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t*)cbdata;
     char *regex, **names;
+    pmix_client_resolved_t *rs;
+
+    if (NULL != (rs = resolved_find(cb->pname.nspace, false)) &&
+        NULL != rs->nodes) {
+        cb->key = strdup(rs->nodes);
+        cb->status = PMIX_SUCCESS;
+        goto done;
+    }
 
     /* get a regular expression describing the PMIX_NODE_MAP */
     cb->status = pmix_preg.resolve_nodes(cb->pname.nspace, &regex);
     if (PMIX_SUCCESS == cb->status) {
         /* parse it into an argv array of names */
         cb->status = pmix_preg.parse_nodes(regex, &names);
+        free(regex);
         if (PMIX_SUCCESS == cb->status) {
             /* assemble it into a comma-delimited list */
             cb->key = pmix_argv_join(names, ',');
             pmix_argv_free(names);
-        } else {
-            free(regex);
+            if (NULL != cb->key &&
+                NULL != (rs = resolved_find(cb->pname.nspace, true))) {
+                rs->nodes = strdup(cb->key);
+            }
         }
     }
+
+  done:
     /* post the data so the receiving thread can acquire it */
     PMIX_POST_OBJECT(cb);
     PMIX_WAKEUP_THREAD(&cb->lock);
@@ -149,17 +149,9 @@ PMIX_EXPORT pmix_status_t PMIx_Connect_nb(const pmix_proc_t procs[], size_t npro
         return rc;
     }
 
-    /* pack the number of procs */
-    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
-                     msg, &nprocs, 1, PMIX_SIZE);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
-                     msg, procs, nprocs, PMIX_PROC);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
+    /* pack the procs */
+    if (PMIX_SUCCESS != (rc = pmix_client_pack_procs(msg, procs, nprocs))) {
+        PMIX_RELEASE(msg);
         return rc;
     }
 
@@ -254,7 +246,16 @@ PMIX_EXPORT pmix_status_t PMIx_Disconnect_nb(const pmix_proc_t procs[], size_t n
                         "pmix: disconnect called");
 
     size_t cnt;
-    for (cnt = 0; cnt < nprocs; cnt++) {
+    bool cache = false;
+    for (cnt = 0; cnt < ninfo; cnt++) {
+        if (PMIX_CHECK_KEY(&info[cnt], PMIX_CONNECT_CACHE)) {
+            cache = PMIX_INFO_TRUE(&info[cnt]);
+            break;
+        }
+    }
+    /* keep the other nspaces' data if asked - the server will
+     * then only send what has changed on the next connect */
+    for (cnt = 0; !cache && cnt < nprocs; cnt++) {
         if (0 != strcmp(pmix_globals.myid.nspace, procs[cnt].nspace)) {
             PMIX_GDS_DEL_NSPACE(rc, procs[cnt].nspace);
         }
@@ -286,17 +287,9 @@ PMIX_EXPORT pmix_status_t PMIx_Disconnect_nb(const pmix_proc_t procs[], size_t n
         return rc;
     }
 
-    /* pack the number of procs */
-    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
-                     msg, &nprocs, 1, PMIX_SIZE);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
-                     msg, procs, nprocs, PMIX_PROC);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
+    /* pack the procs */
+    if (PMIX_SUCCESS != (rc = pmix_client_pack_procs(msg, procs, nprocs))) {
+        PMIX_RELEASE(msg);
         return rc;
     }
 
@@ -399,6 +392,7 @@ static void wait_cbfunc(struct pmix_peer_t *pr,
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
         }
+        pmix_client_resolve_invalidate(nspace);
         free(nspace);
         PMIX_DESTRUCT(&bkt);
         /* get the next one */
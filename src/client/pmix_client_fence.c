@@ -49,9 +49,11 @@
 #include "src/class/pmix_list.h"
 #include "src/mca/bfrops/bfrops.h"
 #include "src/util/argv.h"
+#include "src/util/counters.h"
 #include "src/util/error.h"
 #include "src/util/hash.h"
 #include "src/util/output.h"
+#include "src/util/timings.h"
 #include "src/mca/ptl/ptl.h"
 
 #include "pmix_client_ops.h"
@@ -70,6 +72,7 @@ PMIX_EXPORT pmix_status_t PMIx_Fence(const pmix_proc_t procs[], size_t nprocs,
 {
     pmix_cb_t *cb;
     pmix_status_t rc;
+    uint64_t start = pmix_counter_now();
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
 
@@ -105,6 +108,8 @@ PMIX_EXPORT pmix_status_t PMIx_Fence(const pmix_proc_t procs[], size_t nprocs,
     PMIX_WAIT_THREAD(&cb->lock);
     rc = cb->status;
     PMIX_RELEASE(cb);
+    pmix_counter_time(PMIX_CTR_FENCE, start);
+    PMIX_TRACE_SPAN("PMIx_Fence", start);
 
     pmix_output_verbose(2, pmix_globals.debug_output,
                         "pmix: fence released");
@@ -215,18 +220,8 @@ static pmix_status_t pack_fence(pmix_buffer_t *msg, pmix_cmd_t cmd,
         return rc;
     }
 
-    /* pack the number of procs */
-    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
-                     msg, &nprocs, 1, PMIX_SIZE);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
     /* pack any provided procs - must always be at least one (our own) */
-    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
-                     msg, procs, nprocs, PMIX_PROC);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
+    if (PMIX_SUCCESS != (rc = pmix_client_pack_procs(msg, procs, nprocs))) {
         return rc;
     }
     /* pack the number of info */
@@ -51,6 +51,7 @@
 #include PMIX_EVENT_HEADER
 
 #include "src/class/pmix_list.h"
+#include "src/hwloc/hwloc-internal.h"
 #include "src/mca/bfrops/bfrops.h"
 #include "src/threads/threads.h"
 #include "src/util/argv.h"
@@ -58,12 +59,13 @@
 #include "src/util/error.h"
 #include "src/util/hash.h"
 #include "src/util/output.h"
+#include "src/util/timings.h"
 #include "src/mca/gds/gds.h"
 #include "src/mca/ptl/ptl.h"
 
 #include "pmix_client_ops.h"
 
-static pmix_buffer_t* _pack_get(char *nspace, pmix_rank_t rank,
+static pmix_buffer_t* _pack_get(char *nspace, pmix_rank_t rank, const char *key,
                                const pmix_info_t info[], size_t ninfo,
                                pmix_cmd_t cmd);
 
@@ -89,6 +91,7 @@ PMIX_EXPORT pmix_status_t PMIx_Get(const pmix_proc_t *proc,
 {
     pmix_cb_t *cb;
     pmix_status_t rc;
+    PMIX_TRACE_START(start);
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
 
@@ -104,6 +107,26 @@ PMIX_EXPORT pmix_status_t PMIx_Get(const pmix_proc_t *proc,
                         (NULL == proc) ? PMIX_RANK_UNDEF : proc->rank,
                         (NULL == key) ? "NULL" : key);
 
+#if PMIX_HAVE_HWLOC
+    /* our topology comes from whatever the server published
+     * for it - never from a round-trip */
+    if (NULL != key && 0 == strncmp(key, PMIX_TOPOLOGY, PMIX_MAX_KEYLEN)) {
+        if (NULL == val) {
+            return PMIX_ERR_BAD_PARAM;
+        }
+        if (PMIX_SUCCESS != (rc = pmix_hwloc_load_topology())) {
+            return rc;
+        }
+        PMIX_VALUE_CREATE(*val, 1);
+        if (NULL == *val) {
+            return PMIX_ERR_NOMEM;
+        }
+        (*val)->type = PMIX_POINTER;
+        (*val)->data.ptr = pmix_hwloc_topology;
+        goto done;
+    }
+#endif
+
     /* try to get data directly, without threadshift */
     if (PMIX_SUCCESS == (rc = _getfn_fastpath(proc, key, info, ninfo, val))) {
         goto done;
@@ -128,6 +151,7 @@ PMIX_EXPORT pmix_status_t PMIx_Get(const pmix_proc_t *proc,
     PMIX_RELEASE(cb);
 
   done:
+    PMIX_TRACE_SPAN("PMIx_Get", start);
     pmix_output_verbose(2, pmix_client_globals.get_output,
                         "pmix:client get completed");
 
@@ -210,6 +234,181 @@ PMIX_EXPORT pmix_status_t PMIx_Get_nb(const pmix_proc_t *proc, const pmix_key_t
     return PMIX_SUCCESS;
 }
 
+/* tracker for a PMIx_Get_multi request */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_lock_t lock;
+    const pmix_proc_t *procs;
+    const char **keys;
+    const pmix_info_t *info;
+    size_t ninfo;
+    pmix_value_t **vals;
+    pmix_status_t *rcs;
+    struct pmix_get_item_t {
+        void *trk;
+        size_t idx;
+    } *items;                   // requests that weren't satisfied locally
+    size_t nitems;
+    size_t pending;             // #items still outstanding
+} pmix_get_multi_t;
+
+static void gmcon(pmix_get_multi_t *p)
+{
+    PMIX_CONSTRUCT_LOCK(&p->lock);
+    p->items = NULL;
+    p->nitems = 0;
+    p->pending = 0;
+}
+static void gmdes(pmix_get_multi_t *p)
+{
+    PMIX_DESTRUCT_LOCK(&p->lock);
+    if (NULL != p->items) {
+        free(p->items);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_get_multi_t,
+                           pmix_object_t,
+                           gmcon, gmdes);
+
+static void _multi_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata)
+{
+    struct pmix_get_item_t *item = (struct pmix_get_item_t*)cbdata;
+    pmix_get_multi_t *trk = (pmix_get_multi_t*)item->trk;
+    pmix_status_t rc;
+
+    trk->rcs[item->idx] = status;
+    if (PMIX_SUCCESS == status && NULL != kv) {
+        PMIX_BFROPS_COPY(rc, pmix_client_globals.myserver,
+                         (void**)&trk->vals[item->idx], kv, PMIX_VALUE);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            trk->rcs[item->idx] = rc;
+        }
+    }
+    if (0 == --trk->pending) {
+        PMIX_POST_OBJECT(trk);
+        PMIX_WAKEUP_THREAD(&trk->lock);
+    }
+}
+
+static void _getmultifn(int sd, short args, void *cbdata)
+{
+    pmix_get_multi_t *trk = (pmix_get_multi_t*)cbdata;
+    struct pmix_get_item_t *items;
+    const pmix_proc_t *proc;
+    pmix_cb_t *cb;
+    size_t n, nitems;
+
+    PMIX_ACQUIRE_OBJECT(trk);
+
+    /* our own values may still be waiting to be stored */
+    pmix_client_drain_puts();
+
+    /* the last completion may release the caller, so we
+     * cannot refer to the tracker once it is issued */
+    items = trk->items;
+    nitems = trk->nitems;
+    trk->pending = nitems;
+    for (n=0; n < nitems; n++) {
+        proc = &trk->procs[items[n].idx];
+        cb = PMIX_NEW(pmix_cb_t);
+        if (0 == strlen(proc->nspace)) {
+            cb->pname.nspace = strdup(pmix_globals.myid.nspace);
+        } else {
+            cb->pname.nspace = strdup(proc->nspace);
+        }
+        cb->pname.rank = proc->rank;
+        cb->key = (char*)trk->keys[items[n].idx];
+        cb->info = (pmix_info_t*)trk->info;
+        cb->ninfo = trk->ninfo;
+        cb->cbfunc.valuefn = _multi_cbfunc;
+        cb->cbdata = &items[n];
+        /* we are already in the progress thread - requests for a proc
+         * that already has one pending are simply added to it */
+        _getnbfn(sd, args, cb);
+    }
+}
+
+PMIX_EXPORT pmix_status_t PMIx_Get_multi(const pmix_proc_t procs[], const char *keys[], size_t n,
+                                         const pmix_info_t info[], size_t ninfo,
+                                         pmix_value_t *vals[], pmix_status_t rcs[])
+{
+    pmix_get_multi_t *trk;
+    pmix_status_t rc;
+    size_t i;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (NULL == procs || NULL == keys || NULL == vals || NULL == rcs) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    if (0 == n) {
+        return PMIX_SUCCESS;
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix:client get_multi for %lu values", (unsigned long)n);
+
+    trk = PMIX_NEW(pmix_get_multi_t);
+    if (NULL == trk) {
+        return PMIX_ERR_NOMEM;
+    }
+    trk->items = (struct pmix_get_item_t*)malloc(n * sizeof(struct pmix_get_item_t));
+    if (NULL == trk->items) {
+        PMIX_RELEASE(trk);
+        return PMIX_ERR_NOMEM;
+    }
+    trk->procs = procs;
+    trk->keys = keys;
+    trk->info = info;
+    trk->ninfo = ninfo;
+    trk->vals = vals;
+    trk->rcs = rcs;
+
+    /* resolve everything we hold locally before going to the server */
+    for (i=0; i < n; i++) {
+        vals[i] = NULL;
+        /* we cannot return all info from every rank */
+        if (PMIX_RANK_WILDCARD == procs[i].rank && NULL == keys[i]) {
+            rcs[i] = PMIX_ERR_BAD_PARAM;
+            continue;
+        }
+        rcs[i] = _getfn_fastpath(&procs[i], keys[i], info, ninfo, &vals[i]);
+        if (PMIX_SUCCESS != rcs[i]) {
+            vals[i] = NULL;
+            trk->items[trk->nitems].trk = trk;
+            trk->items[trk->nitems].idx = i;
+            ++trk->nitems;
+        }
+    }
+
+    if (0 < trk->nitems) {
+        PMIX_THREADSHIFT(trk, _getmultifn);
+        PMIX_WAIT_THREAD(&trk->lock);
+    }
+    PMIX_RELEASE(trk);
+
+    rc = PMIX_SUCCESS;
+    for (i=0; i < n; i++) {
+        if (PMIX_SUCCESS != rcs[i]) {
+            rc = rcs[i];
+            break;
+        }
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix:client get_multi completed");
+
+    return rc;
+}
+
 static void _value_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata)
 {
     pmix_cb_t *cb = (pmix_cb_t*)cbdata;
@@ -228,12 +427,14 @@ static void _value_cbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata)
     PMIX_WAKEUP_THREAD(&cb->lock);
 }
 
-static pmix_buffer_t* _pack_get(char *nspace, pmix_rank_t rank,
+static pmix_buffer_t* _pack_get(char *nspace, pmix_rank_t rank, const char *key,
                                const pmix_info_t info[], size_t ninfo,
                                pmix_cmd_t cmd)
 {
     pmix_buffer_t *msg;
     pmix_status_t rc;
+    pmix_info_t *iptr = NULL;
+    size_t n;
 
     /* nope - see if we can get it */
     msg = PMIX_NEW(pmix_buffer_t);
@@ -246,7 +447,7 @@ static pmix_buffer_t* _pack_get(char *nspace, pmix_rank_t rank,
         return NULL;
     }
     /* pack the request information - we'll get the entire blob
-     * for this proc, so we don't need to pass the key */
+     * for this proc, so the key itself is only passed as a hint */
     PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
                      msg, &nspace, 1, PMIX_STRING);
     if (PMIX_SUCCESS != rc) {
@@ -261,23 +462,41 @@ static pmix_buffer_t* _pack_get(char *nspace, pmix_rank_t rank,
         PMIX_RELEASE(msg);
         return NULL;
     }
+    /* tell the server which key we are after - if a fence only
+     * collected some of this proc's keys, it will fetch the rest
+     * rather than hand back a blob without it */
+    if (NULL != key) {
+        PMIX_INFO_CREATE(iptr, ninfo + 1);
+        if (NULL == iptr) {
+            PMIX_RELEASE(msg);
+            return NULL;
+        }
+        for (n=0; n < ninfo; n++) {
+            PMIX_INFO_XFER(&iptr[n], &info[n]);
+        }
+        PMIX_INFO_LOAD(&iptr[ninfo], PMIX_GET_REQ_KEY, key, PMIX_STRING);
+        info = iptr;
+        ninfo++;
+    }
     /* pack the number of info structs */
     PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
                      msg, &ninfo, 1, PMIX_SIZE);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(msg);
-        return NULL;
-    }
-    if (0 < ninfo) {
+        msg = NULL;
+    } else if (0 < ninfo) {
         PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
                          msg, info, ninfo, PMIX_INFO);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(msg);
-            return NULL;
+            msg = NULL;
         }
     }
+    if (NULL != iptr) {
+        PMIX_INFO_FREE(iptr, ninfo);
+    }
     return msg;
 }
 
@@ -335,6 +554,10 @@ static void _getnb_cbfunc(struct pmix_peer_t *pr,
     if (PMIX_SUCCESS != rc) {
         goto done;
     }
+    /* a wildcard request brings down the job-level info */
+    if (PMIX_RANK_WILDCARD == proc.rank) {
+        pmix_client_resolve_invalidate(proc.nspace);
+    }
 
   done:
     /* now search any pending requests (including the one this was in
@@ -389,6 +612,7 @@ static pmix_status_t process_values(pmix_value_t **v, pmix_cb_t *cb)
     pmix_value_t *val;
     pmix_info_t *info;
     size_t ninfo, n;
+    char **keys = NULL;
 
     if (NULL != cb->key && 1 == pmix_list_get_size(kvs)) {
         kv = (pmix_kval_t*)pmix_list_get_first(kvs);
@@ -396,6 +620,36 @@ static pmix_status_t process_values(pmix_value_t **v, pmix_cb_t *cb)
         kv->value = NULL;  // protect the value
         return PMIX_SUCCESS;
     }
+    /* if they asked for a subset of the keys, drop the others - the
+     * storage may have returned all of the proc's data */
+    if (NULL == cb->key) {
+        for (n=0; n < cb->ninfo; n++) {
+            if (PMIX_CHECK_KEY(&cb->info[n], PMIX_GET_KEYS) &&
+                PMIX_STRING == cb->info[n].value.type &&
+                NULL != cb->info[n].value.data.string) {
+                keys = pmix_argv_split(cb->info[n].value.data.string, ',');
+                break;
+            }
+        }
+    }
+    if (NULL != keys) {
+        pmix_kval_t *next;
+        PMIX_LIST_FOREACH_SAFE(kv, next, kvs, pmix_kval_t) {
+            for (n=0; NULL != keys[n]; n++) {
+                if (0 == strncmp(kv->key, keys[n], PMIX_MAX_KEYLEN)) {
+                    break;
+                }
+            }
+            if (NULL == keys[n]) {
+                pmix_list_remove_item(kvs, &kv->super);
+                PMIX_RELEASE(kv);
+            }
+        }
+        pmix_argv_free(keys);
+        if (0 == pmix_list_get_size(kvs)) {
+            return PMIX_ERR_NOT_FOUND;
+        }
+    }
     /* we will return the data as an array of pmix_info_t
      * in the kvs pmix_value_t */
     val = (pmix_value_t*)malloc(sizeof(pmix_value_t));
@@ -417,11 +671,14 @@ static pmix_status_t process_values(pmix_value_t **v, pmix_cb_t *cb)
         PMIX_VALUE_RELEASE(val);
         return PMIX_ERR_NOMEM;
     }
-    /* copy the list elements */
+    /* move the list elements - the fetched values are our own
+     * copies, so there is no need to duplicate them again */
     n=0;
     PMIX_LIST_FOREACH(kv, kvs, pmix_kval_t) {
         pmix_strncpy(info[n].key, kv->key, PMIX_MAX_KEYLEN);
-        pmix_value_xfer(&info[n].value, kv->value);
+        memcpy(&info[n].value, kv->value, sizeof(pmix_value_t));
+        free(kv->value);
+        kv->value = NULL;
         ++n;
     }
     val->data.darray->size = ninfo;
@@ -453,7 +710,7 @@ static void infocb(pmix_status_t status,
                     /* if this is a compressed string, then uncompress it */
                     if (PMIX_COMPRESSED_STRING == info[0].value.type) {
                         kv->type = PMIX_STRING;
-                        pmix_util_uncompress_string(&kv->data.string, (uint8_t*)info[0].value.data.bo.bytes, info[0].value.data.bo.size);
+                        pmix_util_uncompress_string_cached(&kv->data.string, (uint8_t*)info[0].value.data.bo.bytes, info[0].value.data.bo.size);
                         if (NULL == kv->data.string) {
                             PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
                             rc = PMIX_ERR_NOMEM;
@@ -485,52 +742,372 @@ static void infocb(pmix_status_t status,
     }
 }
 
+static void snapcon(pmix_job_snapshot_t *p)
+{
+    p->info = NULL;
+    p->ninfo = 0;
+    p->retired = NULL;
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->locality);
+    p->npeers = 0;
+    p->peers = NULL;
+    p->matrix = NULL;
+}
+static void snapdes(pmix_job_snapshot_t *p)
+{
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->locality);
+}
+PMIX_CLASS_INSTANCE(pmix_job_snapshot_t,
+                    pmix_object_t,
+                    snapcon, snapdes);
+
+/* take ownership of the locality matrix, provided it is the
+ * size its header says it is */
+static void snapshot_locality(pmix_job_snapshot_t *snap, pmix_byte_object_t *bo)
+{
+    uint32_t npeers;
+
+    if (bo->size < sizeof(uint32_t)) {
+        return;
+    }
+    memcpy(&npeers, bo->bytes, sizeof(uint32_t));
+    if (bo->size != sizeof(uint32_t) + npeers * sizeof(pmix_rank_t) +
+                    (size_t)npeers * npeers * sizeof(pmix_locality_t)) {
+        return;
+    }
+    snap->locality.bytes = bo->bytes;
+    snap->locality.size = bo->size;
+    bo->bytes = NULL;
+    bo->size = 0;
+    snap->npeers = npeers;
+    snap->peers = (pmix_rank_t*)(snap->locality.bytes + sizeof(uint32_t));
+    snap->matrix = (pmix_locality_t*)(snap->peers + npeers);
+}
+
+static int rank_cmp(const void *a, const void *b)
+{
+    pmix_rank_t ra = *(const pmix_rank_t*)a;
+    pmix_rank_t rb = *(const pmix_rank_t*)b;
+
+    if (ra < rb) {
+        return -1;
+    }
+    return (ra > rb) ? 1 : 0;
+}
+
+static int snapshot_cmp(const void *a, const void *b)
+{
+    return strncmp(((const pmix_info_t*)a)->key,
+                   ((const pmix_info_t*)b)->key, PMIX_MAX_KEYLEN);
+}
+
+static int snapshot_find(const void *key, const void *b)
+{
+    return strncmp((const char*)key, ((const pmix_info_t*)b)->key, PMIX_MAX_KEYLEN);
+}
+
+void pmix_client_snapshot_build(void)
+{
+    pmix_job_snapshot_t *snap;
+    pmix_cb_t cb;
+    pmix_proc_t wildcard;
+    pmix_kval_t *kv;
+    pmix_status_t rc;
+
+    pmix_strncpy(wildcard.nspace, pmix_globals.myid.nspace, PMIX_MAX_NSLEN);
+    wildcard.rank = PMIX_RANK_WILDCARD;
+
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = &wildcard;
+    cb.copy = true;
+    PMIX_GDS_FETCH_KV(rc, pmix_client_globals.myserver, &cb);
+    if (PMIX_SUCCESS != rc || 0 == pmix_list_get_size(&cb.kvs)) {
+        PMIX_DESTRUCT(&cb);
+        return;
+    }
+
+    snap = PMIX_NEW(pmix_job_snapshot_t);
+    if (NULL == snap) {
+        PMIX_DESTRUCT(&cb);
+        return;
+    }
+    PMIX_INFO_CREATE(snap->info, pmix_list_get_size(&cb.kvs));
+    if (NULL == snap->info) {
+        PMIX_RELEASE(snap);
+        PMIX_DESTRUCT(&cb);
+        return;
+    }
+    PMIX_LIST_FOREACH(kv, &cb.kvs, pmix_kval_t) {
+        /* the locality matrix is kept in its raw form so
+         * PMIX_LOCALITY lookups are a pair of array reads */
+        if (NULL != kv->value && PMIX_BYTE_OBJECT == kv->value->type &&
+            0 == strncmp(kv->key, PMIX_LOCALITY_MATRIX, PMIX_MAX_KEYLEN)) {
+            snapshot_locality(snap, &kv->value->data.bo);
+            continue;
+        }
+        /* arrays and blobs (e.g., the proc maps) are large and
+         * rarely asked for repeatedly - leave them in the GDS */
+        if (NULL == kv->value ||
+            PMIX_DATA_ARRAY == kv->value->type ||
+            PMIX_BYTE_OBJECT == kv->value->type ||
+            PMIX_COMPRESSED_STRING == kv->value->type) {
+            continue;
+        }
+        /* move the fetched copy into the snapshot */
+        pmix_strncpy(snap->info[snap->ninfo].key, kv->key, PMIX_MAX_KEYLEN);
+        memcpy(&snap->info[snap->ninfo].value, kv->value, sizeof(pmix_value_t));
+        free(kv->value);
+        kv->value = NULL;
+        ++snap->ninfo;
+    }
+    PMIX_DESTRUCT(&cb);
+    qsort(snap->info, snap->ninfo, sizeof(pmix_info_t), snapshot_cmp);
+
+    pmix_output_verbose(2, pmix_client_globals.get_output,
+                        "pmix:client captured %lu job-level values",
+                        (unsigned long)snap->ninfo);
+
+    snap->retired = pmix_client_globals.snapshot;
+    PMIX_POST_OBJECT(snap);
+    pmix_client_globals.snapshot = snap;
+}
+
+void pmix_client_snapshot_invalidate(void)
+{
+    pmix_job_snapshot_t *snap;
+
+    if (NULL == pmix_client_globals.snapshot) {
+        return;
+    }
+    /* publish an empty snapshot so every lookup falls through */
+    if (NULL == (snap = PMIX_NEW(pmix_job_snapshot_t))) {
+        return;
+    }
+    snap->retired = pmix_client_globals.snapshot;
+    PMIX_POST_OBJECT(snap);
+    pmix_client_globals.snapshot = snap;
+}
+
+void pmix_client_snapshot_release(void)
+{
+    pmix_job_snapshot_t *snap, *next;
+
+    for (snap = pmix_client_globals.snapshot; NULL != snap; snap = next) {
+        next = snap->retired;
+        PMIX_RELEASE(snap);
+    }
+    pmix_client_globals.snapshot = NULL;
+}
+
 static pmix_status_t _getfn_fastpath(const pmix_proc_t *proc, const pmix_key_t key,
                                      const pmix_info_t info[], size_t ninfo,
                                      pmix_value_t **val)
 {
-    pmix_cb_t *cb = PMIX_NEW(pmix_cb_t);
+    pmix_cb_t cb;
     pmix_status_t rc = PMIX_SUCCESS;
     size_t n;
+    pmix_job_snapshot_t *snap;
+    pmix_info_t *hit;
+    pmix_rank_t *me, *peer;
+    pmix_locality_t loc;
+
+    snap = pmix_client_globals.snapshot;
+
+    /* the locality of a peer relative to us comes straight out
+     * of the matrix the server computed for our node */
+    if (NULL != snap && NULL != proc && NULL != key && NULL != val &&
+        PMIX_RANK_WILDCARD != proc->rank &&
+        0 == strncmp(key, PMIX_LOCALITY, PMIX_MAX_KEYLEN) &&
+        0 == strncmp(proc->nspace, pmix_globals.myid.nspace, PMIX_MAX_NSLEN)) {
+        PMIX_ACQUIRE_OBJECT(snap);
+        if (0 < snap->npeers &&
+            NULL != (me = (pmix_rank_t*)bsearch(&pmix_globals.myid.rank, snap->peers,
+                                                snap->npeers, sizeof(pmix_rank_t),
+                                                rank_cmp))) {
+            peer = (pmix_rank_t*)bsearch(&proc->rank, snap->peers, snap->npeers,
+                                         sizeof(pmix_rank_t), rank_cmp);
+            if (NULL == peer) {
+                loc = PMIX_LOCALITY_NONLOCAL;
+            } else {
+                loc = snap->matrix[(me - snap->peers) * snap->npeers + (peer - snap->peers)];
+            }
+            PMIX_VALUE_CREATE(*val, 1);
+            if (NULL == *val) {
+                return PMIX_ERR_NOMEM;
+            }
+            PMIX_VALUE_LOAD(*val, &loc, PMIX_UINT16);
+            return PMIX_SUCCESS;
+        }
+    }
+
+    /* undirected job-level requests on our own nspace are answered
+     * from the snapshot we took when the job info arrived */
+    if (NULL != snap && NULL != proc && NULL != key && 0 == ninfo &&
+        PMIX_RANK_WILDCARD == proc->rank &&
+        0 == strncmp(proc->nspace, pmix_globals.myid.nspace, PMIX_MAX_NSLEN)) {
+        PMIX_ACQUIRE_OBJECT(snap);
+        hit = (pmix_info_t*)bsearch(key, snap->info, snap->ninfo,
+                                    sizeof(pmix_info_t), snapshot_find);
+        if (NULL != hit) {
+            PMIX_VALUE_CREATE(*val, 1);
+            if (NULL == *val) {
+                return PMIX_ERR_NOMEM;
+            }
+            PMIX_BFROPS_VALUE_XFER(rc, pmix_globals.mypeer, *val, &hit->value);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_VALUE_RELEASE(*val);
+            }
+            return rc;
+        }
+    }
+
+    /* the GDS does not yet hold anything we have staged, so
+     * leave those Gets to the progress thread */
+    if (pmix_client_puts_staged()) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    /* this is called on every PMIx_Get, so keep the tracker
+     * on the stack - the fetched value is handed to the caller
+     * as-is, leaving nothing that has to outlive this call */
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
 
     /* scan the incoming directives */
     if (NULL != info) {
         for (n=0; n < ninfo; n++) {
-            if (0 == strncmp(info[n].key, PMIX_DATA_SCOPE, PMIX_MAX_KEYLEN)) {
-                cb->scope = info[n].value.data.scope;
+            if (PMIX_CHECK_KEY(&info[n], PMIX_DATA_SCOPE)) {
+                cb.scope = info[n].value.data.scope;
                 break;
             }
         }
     }
-    cb->proc = (pmix_proc_t*)proc;
-    cb->copy = true;
-    cb->key = (char*)key;
-    cb->info = (pmix_info_t*)info;
-    cb->ninfo = ninfo;
+    cb.proc = (pmix_proc_t*)proc;
+    cb.copy = true;
+    cb.key = (char*)key;
+    cb.info = (pmix_info_t*)info;
+    cb.ninfo = ninfo;
 
     PMIX_GDS_FETCH_IS_TSAFE(rc, pmix_globals.mypeer);
     if (PMIX_SUCCESS == rc) {
-        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
+        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
         if (PMIX_SUCCESS == rc) {
             goto done;
         }
     }
     PMIX_GDS_FETCH_IS_TSAFE(rc, pmix_client_globals.myserver);
     if (PMIX_SUCCESS == rc) {
-        PMIX_GDS_FETCH_KV(rc, pmix_client_globals.myserver, cb);
+        PMIX_GDS_FETCH_KV(rc, pmix_client_globals.myserver, &cb);
         if (PMIX_SUCCESS == rc) {
             goto done;
         }
     }
-    PMIX_RELEASE(cb);
+    PMIX_DESTRUCT(&cb);
     return rc;
 
   done:
-    rc = process_values(val, cb);
+    rc = process_values(val, &cb);
     if (NULL != *val) {
         PMIX_VALUE_COMPRESSED_STRING_UNPACK(*val);
     }
-    PMIX_RELEASE(cb);
+    PMIX_DESTRUCT(&cb);
+    return rc;
+}
+
+/* find a value without a threadshift and without copying it -
+ * the caller must be done with it before destructing the cb */
+static pmix_value_t* _get_direct(const pmix_proc_t *proc, const char *key,
+                                 pmix_cb_t *cb)
+{
+    pmix_job_snapshot_t *snap;
+    pmix_info_t *hit;
+    pmix_kval_t *kv;
+    pmix_status_t rc;
+
+    if (NULL == proc || NULL == key) {
+        return NULL;
+    }
+
+    snap = pmix_client_globals.snapshot;
+    if (NULL != snap && PMIX_RANK_WILDCARD == proc->rank &&
+        0 == strncmp(proc->nspace, pmix_globals.myid.nspace, PMIX_MAX_NSLEN)) {
+        PMIX_ACQUIRE_OBJECT(snap);
+        hit = (pmix_info_t*)bsearch(key, snap->info, snap->ninfo,
+                                    sizeof(pmix_info_t), snapshot_find);
+        if (NULL != hit) {
+            return &hit->value;
+        }
+    }
+
+    if (pmix_client_puts_staged()) {
+        return NULL;
+    }
+
+    cb->proc = (pmix_proc_t*)proc;
+    cb->key = (char*)key;
+    cb->copy = false;
+    PMIX_GDS_FETCH_IS_TSAFE(rc, pmix_globals.mypeer);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, cb);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_GDS_FETCH_IS_TSAFE(rc, pmix_client_globals.myserver);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_GDS_FETCH_KV(rc, pmix_client_globals.myserver, cb);
+        }
+    }
+    if (PMIX_SUCCESS != rc || 1 != pmix_list_get_size(&cb->kvs)) {
+        return NULL;
+    }
+    kv = (pmix_kval_t*)pmix_list_get_first(&cb->kvs);
+    return kv->value;
+}
+
+pmix_status_t pmix_client_get_string(const pmix_proc_t *proc, const char *key,
+                                     char *value, size_t len, size_t *vlen)
+{
+    pmix_cb_t cb;
+    pmix_value_t *val;
+    pmix_status_t rc;
+
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    if (NULL == (val = _get_direct(proc, key, &cb)) ||
+        PMIX_COMPRESSED_STRING == val->type) {
+        /* leave the uncompress to the full path */
+        rc = PMIX_ERR_TAKE_NEXT_OPTION;
+    } else if (PMIX_STRING != val->type) {
+        rc = PMIX_ERROR;
+    } else {
+        rc = PMIX_SUCCESS;
+        if (NULL != val->data.string) {
+            pmix_strncpy(value, val->data.string, len-1);
+            if (NULL != vlen) {
+                *vlen = strlen(val->data.string);
+            }
+        }
+    }
+    PMIX_DESTRUCT(&cb);
+    return rc;
+}
+
+pmix_status_t pmix_client_get_int(const pmix_proc_t *proc, const char *key,
+                                  int *value)
+{
+    pmix_cb_t cb;
+    pmix_value_t *val;
+    pmix_status_t rc;
+
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    if (NULL == (val = _get_direct(proc, key, &cb))) {
+        rc = PMIX_ERR_TAKE_NEXT_OPTION;
+    } else if (PMIX_BOOL == val->type) {
+        *value = val->data.flag;
+        rc = PMIX_SUCCESS;
+    } else {
+        PMIX_VALUE_GET_NUMBER(rc, val, *value, int);
+    }
+    PMIX_DESTRUCT(&cb);
     return rc;
 }
 
@@ -551,6 +1128,9 @@ static void _getnbfn(int fd, short flags, void *cbdata)
     /* cb was passed to us from another thread - acquire it */
     PMIX_ACQUIRE_OBJECT(cb);
 
+    /* our own values may still be waiting to be stored */
+    pmix_client_drain_puts();
+
     pmix_output_verbose(2, pmix_client_globals.get_output,
                         "pmix: getnbfn value for proc %s:%u key %s",
                         cb->pname.nspace, cb->pname.rank,
@@ -573,9 +1153,7 @@ static void _getnbfn(int fd, short flags, void *cbdata)
                 if (0 < cb->info[n].value.data.integer) {
                     tv.tv_sec = cb->info[n].value.data.integer;
                     tv.tv_usec = 0;
-                    pmix_event_evtimer_set(pmix_globals.evbase, &cb->ev,
-                                           timeout, cb);
-                    pmix_event_evtimer_add(&cb->ev, &tv);
+                    pmix_timer_add(&cb->timer, timeout, cb, &tv);
                     cb->timer_running = true;
                 }
             } else if (0 == strncmp(cb->info[n].key, PMIX_DATA_SCOPE, PMIX_MAX_KEYLEN)) {
@@ -592,7 +1170,10 @@ static void _getnbfn(int fd, short flags, void *cbdata)
         pmix_output_verbose(5, pmix_client_globals.get_output,
                             "pmix:client data found in internal storage");
         rc = process_values(&val, cb);
-        goto respond;
+        /* a PMIX_GET_KEYS subset may not be held internally */
+        if (PMIX_ERR_NOT_FOUND != rc) {
+            goto respond;
+        }
     }
     pmix_output_verbose(5, pmix_client_globals.get_output,
                         "pmix:client data NOT found in internal storage");
@@ -715,7 +1296,8 @@ static void _getnbfn(int fd, short flags, void *cbdata)
 
     /* we don't have a pending request, so let's create one - don't worry
      * about packing the key as we return everything from that proc */
-    msg = _pack_get(cb->pname.nspace, cb->pname.rank, cb->info, cb->ninfo, PMIX_GETNB_CMD);
+    msg = _pack_get(cb->pname.nspace, cb->pname.rank, cb->key,
+                    cb->info, cb->ninfo, PMIX_GETNB_CMD);
     if (NULL == msg) {
         rc = PMIX_ERROR;
         goto respond;
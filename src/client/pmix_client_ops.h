@@ -21,10 +21,40 @@
 
 BEGIN_C_DECLS
 
+/* an immutable copy of our own job-level values, sorted by key so
+ * wildcard-rank Gets can be answered without going through the GDS.
+ * A snapshot is never modified once published - a newer one replaces
+ * it and the old one is kept until finalize, as a reader on another
+ * thread may still be looking at it */
+typedef struct pmix_job_snapshot_t {
+    pmix_object_t super;
+    pmix_info_t *info;
+    size_t ninfo;
+    struct pmix_job_snapshot_t *retired;    // snapshot this one replaced
+    pmix_byte_object_t locality;            // locality matrix of our local peers
+    uint32_t npeers;                        // ranks covered by the matrix
+    pmix_rank_t *peers;                     // those ranks, ascending - points into locality
+    pmix_locality_t *matrix;                // npeers x npeers - points into locality
+} pmix_job_snapshot_t;
+PMIX_CLASS_DECLARATION(pmix_job_snapshot_t);
+
 typedef struct {
     pmix_peer_t *myserver;          // messaging support to/from my server
     pmix_list_t pending_requests;   // list of pmix_cb_t pending data requests
     pmix_pointer_array_t peers;     // array of pmix_peer_t cached for data ops
+    pmix_pointer_array_t servers;   // additional servers a tool is attached to
+    pmix_job_snapshot_t *snapshot;  // our job-level values, if captured
+    pmix_mutex_t stage_lock;        // protects the staged puts
+    pmix_list_t staged;             // puts not yet stored in the GDS
+    bool stage_puts;                // hold puts in the caller's thread
+    char **dirty_local;             // local keys stored since the last commit
+    char **dirty_remote;            // remote keys stored since the last commit
+    int commit_delta;               // server merges deltas: -1 if not yet known
+    int procset_ranges;             // server takes ranged proc sets: -1 if not yet known
+    size_t iof_stdin_chunk;         // bytes of stdin read for each push
+    int iof_stdin_window;           // pushes awaiting an ack before we stop reading
+    bool iof_stdin_bcast;           // ask that stdin go once to each node
+    pmix_list_t resolved;           // per-nspace answers to earlier PMIx_Resolve_peers/nodes
     // verbosity for client get operations
     int get_output;
     int get_verbose;
@@ -56,6 +86,48 @@ typedef struct {
 
 PMIX_EXPORT extern pmix_client_globals_t pmix_client_globals;
 
+/* capture (or recapture) our job-level values - must be called
+ * from the progress thread once they have been stored */
+void pmix_client_snapshot_build(void);
+
+/* stop answering Gets from the snapshot - called when our
+ * job-level values are changed after it was taken */
+void pmix_client_snapshot_invalidate(void);
+
+/* release all snapshots at finalize */
+void pmix_client_snapshot_release(void);
+
+/* forget what PMIx_Resolve_peers/nodes found for an nspace (all of
+ * them if NULL) - called from the progress thread whenever its
+ * job-level info is (re)stored */
+void pmix_client_resolve_invalidate(const char *nspace);
+
+/* pack the procs of a collective the way our server
+ * reads them most cheaply */
+pmix_status_t pmix_client_pack_procs(pmix_buffer_t *msg,
+                                     const pmix_proc_t *procs,
+                                     size_t nprocs);
+
+/* copy a value straight into the caller's storage if it can be had
+ * without a threadshift - returns PMIX_ERR_TAKE_NEXT_OPTION if
+ * PMIx_Get is required. Used by the PMI compatibility libraries */
+PMIX_EXPORT pmix_status_t pmix_client_get_string(const pmix_proc_t *proc, const char *key,
+                                                 char *value, size_t len, size_t *vlen);
+PMIX_EXPORT pmix_status_t pmix_client_get_int(const pmix_proc_t *proc, const char *key,
+                                              int *value);
+
+/* store a batch of values with a single threadshift - used by
+ * the PMI compatibility libraries to hold puts until commit */
+PMIX_EXPORT pmix_status_t pmix_client_put_multi(pmix_scope_t scope,
+                                                pmix_info_t *info, size_t ninfo);
+
+/* store any puts staged by the application threads - must be
+ * called from the progress thread before our own values are read */
+void pmix_client_drain_puts(void);
+
+/* true if puts are staged that the GDS has not yet seen */
+bool pmix_client_puts_staged(void);
+
 END_C_DECLS
 
 #endif /* PMIX_CLIENT_OPS_H */
@@ -260,6 +260,7 @@ static void wait_cbfunc(struct pmix_peer_t *pr,
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
         }
+        pmix_client_resolve_invalidate(nspace);
     }
 
   report:
@@ -16,6 +16,10 @@
 #include <src/include/pmix_stdint.h>
 #include <src/include/pmix_socket_errno.h>
 
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
 #include <pmix.h>
 #include <pmix_common.h>
 #include <pmix_server.h>
@@ -321,6 +325,9 @@ PMIX_EXPORT pmix_status_t PMIx_Process_monitor_nb(const pmix_info_t *monitor, pm
     pmix_cmd_t cmd = PMIX_MONITOR_CMD;
     pmix_status_t rc;
     pmix_query_caddy_t *cb;
+    pmix_info_t *dirs;
+    size_t n, ndirs2;
+    pid_t mypid;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
 
@@ -403,23 +410,46 @@ PMIX_EXPORT pmix_status_t PMIx_Process_monitor_nb(const pmix_info_t *monitor, pm
         return rc;
     }
 
+    /* the server has no way of learning our pid, so add it
+     * if we are asking to have our usage sampled */
+    dirs = (pmix_info_t*)directives;
+    ndirs2 = ndirs;
+    if (0 == strncmp(monitor->key, PMIX_MONITOR_USAGE, PMIX_MAX_KEYLEN)) {
+        for (n=0; n < ndirs; n++) {
+            if (PMIX_CHECK_KEY(&directives[n], PMIX_PROC_PID)) {
+                break;
+            }
+        }
+        if (n == ndirs) {
+            ndirs2 = ndirs + 1;
+            PMIX_INFO_CREATE(dirs, ndirs2);
+            if (NULL == dirs) {
+                PMIX_RELEASE(msg);
+                return PMIX_ERR_NOMEM;
+            }
+            for (n=0; n < ndirs; n++) {
+                PMIX_INFO_XFER(&dirs[n], (pmix_info_t*)&directives[n]);
+            }
+            mypid = getpid();
+            PMIX_INFO_LOAD(&dirs[ndirs], PMIX_PROC_PID, &mypid, PMIX_PID);
+        }
+    }
+
     /* pack the directives */
     PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
-                     msg, &ndirs, 1, PMIX_SIZE);
+                     msg, &ndirs2, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS == rc && 0 < ndirs2) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
+                         msg, dirs, ndirs2, PMIX_INFO);
+    }
+    if (dirs != directives) {
+        PMIX_INFO_FREE(dirs, ndirs2);
+    }
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(msg);
         return rc;
     }
-    if (0 < ndirs) {
-        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
-                         msg, directives, ndirs, PMIX_INFO);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(msg);
-            return rc;
-        }
-    }
 
     /* create a callback object as we need to pass it to the
      * recv routine so we know which callback to use when
@@ -280,3 +280,114 @@ PMIX_EXPORT pmix_status_t PMIx_Data_copy_payload(pmix_data_buffer_t *dest,
     /* no need to cleanup as all storage was xfered */
     return rc;
 }
+
+PMIX_EXPORT pmix_status_t PMIx_Data_load(pmix_data_buffer_t *buffer,
+                                         pmix_byte_object_t *payload)
+{
+    if (NULL == buffer || NULL == payload) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    /* discard whatever the buffer held - it now owns the payload */
+    PMIX_DATA_BUFFER_DESTRUCT(buffer);
+    if (NULL == payload->bytes || 0 == payload->size) {
+        return PMIX_SUCCESS;
+    }
+    PMIX_DATA_BUFFER_LOAD(buffer, payload->bytes, payload->size);
+    payload->bytes = NULL;
+    payload->size = 0;
+
+    return PMIX_SUCCESS;
+}
+
+PMIX_EXPORT pmix_status_t PMIx_Data_unload(pmix_data_buffer_t *buffer,
+                                           pmix_byte_object_t *payload)
+{
+    size_t offset;
+
+    if (NULL == buffer || NULL == payload) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    payload->bytes = NULL;
+    payload->size = 0;
+    if (NULL == buffer->base_ptr) {
+        return PMIX_SUCCESS;
+    }
+
+    /* hand over whatever hasn't been unpacked yet - if some of it
+     * has, slide the rest down rather than copying it elsewhere */
+    offset = buffer->unpack_ptr - buffer->base_ptr;
+    if (offset < buffer->bytes_used) {
+        if (0 < offset) {
+            memmove(buffer->base_ptr, buffer->unpack_ptr, buffer->bytes_used - offset);
+        }
+        payload->bytes = buffer->base_ptr;
+        payload->size = buffer->bytes_used - offset;
+    } else {
+        free(buffer->base_ptr);
+    }
+    buffer->base_ptr = NULL;
+    PMIX_DATA_BUFFER_DESTRUCT(buffer);
+
+    return PMIX_SUCCESS;
+}
+
+PMIX_EXPORT pmix_status_t PMIx_Data_embed(pmix_data_buffer_t *buffer,
+                                          const pmix_byte_object_t *payload)
+{
+    pmix_status_t rc;
+    pmix_buffer_t buf;
+
+    if (NULL == buffer || NULL == payload) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    if (NULL == payload->bytes || 0 == payload->size) {
+        return PMIX_SUCCESS;
+    }
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_EMBED_DATA_BUFFER(&buf, buffer);
+
+    /* size the buffer for the payload in one step */
+    rc = pmix_bfrops_base_reserve(&buf, payload->size);
+    if (PMIX_SUCCESS == rc) {
+        memcpy(buf.pack_ptr, payload->bytes, payload->size);
+        buf.pack_ptr += payload->size;
+        buf.bytes_used += payload->size;
+    }
+
+    PMIX_EXTRACT_DATA_BUFFER(&buf, buffer);
+    return rc;
+}
+
+PMIX_EXPORT pmix_status_t PMIx_Data_reserve(pmix_data_buffer_t *buffer,
+                                            size_t bytes)
+{
+    pmix_status_t rc;
+    pmix_buffer_t buf;
+
+    if (NULL == buffer) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_EMBED_DATA_BUFFER(&buf, buffer);
+
+    rc = pmix_bfrops_base_reserve(&buf, bytes);
+
+    PMIX_EXTRACT_DATA_BUFFER(&buf, buffer);
+    return rc;
+}
+
+PMIX_EXPORT pmix_status_t PMIx_Data_size_hint(size_t *size, void *src,
+                                              int32_t num_vals,
+                                              pmix_data_type_t type)
+{
+    if (NULL == size || 0 > num_vals) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    *size = pmix_bfrops_base_sizeof(src, num_vals, type);
+    return PMIX_SUCCESS;
+}
@@ -23,6 +23,7 @@
 
 #include "src/threads/threads.h"
 #include "src/util/argv.h"
+#include "src/util/compress.h"
 #include "src/util/error.h"
 #include "src/util/name_fns.h"
 #include "src/util/output.h"
@@ -71,6 +72,8 @@ PMIX_EXPORT pmix_status_t PMIx_IOF_pull(const pmix_proc_t procs[], size_t nprocs
     pmix_cmd_t cmd = PMIX_IOF_PULL_CMD;
     pmix_buffer_t *msg;
     pmix_status_t rc;
+    pmix_info_t *dirs;
+    size_t n, ndirs2;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
 
@@ -146,20 +149,24 @@ PMIX_EXPORT pmix_status_t PMIx_IOF_pull(const pmix_proc_t procs[], size_t nprocs
         PMIX_ERROR_LOG(rc);
         goto cleanup;
     }
+    /* let the server know we can take our output in batches */
+    ndirs2 = ndirs + 1;
+    PMIX_INFO_CREATE(dirs, ndirs2);
+    for (n=0; n < ndirs; n++) {
+        PMIX_INFO_XFER(&dirs[n], (pmix_info_t*)&directives[n]);
+    }
+    PMIX_INFO_LOAD(&dirs[ndirs], PMIX_IOF_BATCH_KEY, NULL, PMIX_BOOL);
     PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
-                     msg, &ndirs, 1, PMIX_SIZE);
+                     msg, &ndirs2, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
+                         msg, dirs, ndirs2, PMIX_INFO);
+    }
+    PMIX_INFO_FREE(dirs, ndirs2);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         goto cleanup;
     }
-    if (0 < ndirs) {
-        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
-                         msg, directives, ndirs, PMIX_INFO);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            goto cleanup;
-        }
-    }
     PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
                      msg, &channel, 1, PMIX_IOF_CHANNEL);
     if (PMIX_SUCCESS != rc) {
@@ -296,6 +303,8 @@ pmix_status_t PMIx_IOF_push(const pmix_proc_t targets[], size_t ntargets,
             rc = PMIX_ERR_NOMEM;
             return rc;
         }
+        cd->cbfunc = cbfunc;
+        cd->cbdata = cbdata;
         PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver,
                            msg, stdincbfunc, cd);
         if (PMIX_SUCCESS != rc) {
@@ -317,6 +326,86 @@ pmix_status_t PMIx_IOF_push(const pmix_proc_t targets[], size_t ntargets,
     return PMIX_SUCCESS;
 }
 
+/* output a server held for us and sent in one message - a
+ * count of runs, each with its source, channel and data */
+void pmix_iof_batch_recv(struct pmix_peer_t *pr,
+                         pmix_ptl_hdr_t *hdr,
+                         pmix_buffer_t *buf, void *cbdata)
+{
+    pmix_peer_t *peer = (pmix_peer_t*)pr;
+    pmix_buffer_t bucket;
+    pmix_byte_object_t bo;
+    pmix_proc_t source;
+    pmix_iof_channel_t channel;
+    bool compressed;
+    uint8_t *bytes;
+    size_t len, n, nruns;
+    int32_t cnt;
+    pmix_status_t rc;
+
+    pmix_output_verbose(2, pmix_client_globals.iof_output,
+                        "recvd IOF batch with %d bytes", (int)buf->bytes_used);
+
+    /* if the buffer is empty, they are simply closing the channel */
+    if (0 == buf->bytes_used) {
+        return;
+    }
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &compressed, &cnt, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &bo, &cnt, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
+    if (compressed) {
+        if (!pmix_util_uncompress_block(&bytes, &len, (uint8_t*)bo.bytes, bo.size)) {
+            PMIX_ERROR_LOG(PMIX_ERR_UNPACK_FAILURE);
+            PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+            PMIX_DESTRUCT(&bucket);
+            return;
+        }
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        PMIX_LOAD_BUFFER(peer, &bucket, bytes, len);
+    } else {
+        PMIX_LOAD_BUFFER(peer, &bucket, bo.bytes, bo.size);
+    }
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, &bucket, &nruns, &cnt, PMIX_SIZE);
+    for (n=0; PMIX_SUCCESS == rc && n < nruns; n++) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, peer, &bucket, &source, &cnt, PMIX_PROC);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, peer, &bucket, &channel, &cnt, PMIX_IOF_CHANNEL);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, peer, &bucket, &bo, &cnt, PMIX_BYTE_OBJECT);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        if (NULL != bo.bytes && 0 < bo.size) {
+            pmix_iof_write_output(&source, channel, &bo, NULL);
+        }
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    PMIX_DESTRUCT(&bucket);
+}
+
 pmix_status_t pmix_iof_write_output(const pmix_proc_t *name,
                                     pmix_iof_channel_t stream,
                                     const pmix_byte_object_t *bo,
@@ -324,7 +413,7 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name,
 {
     char starttag[PMIX_IOF_BASE_TAG_MAX], endtag[PMIX_IOF_BASE_TAG_MAX], *suffix;
     pmix_iof_write_output_t *output;
-    size_t i;
+    size_t i, nlines, size;
     int j, k, starttaglen, endtaglen, num_buffered;
     bool endtagged;
     char qprint[10];
@@ -358,6 +447,9 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name,
 
     /* setup output object */
     output = PMIX_NEW(pmix_iof_write_output_t);
+    if (NULL == output) {
+        return PMIX_ERR_NOMEM;
+    }
     memset(starttag, 0, PMIX_IOF_BASE_TAG_MAX);
     memset(endtag, 0, PMIX_IOF_BASE_TAG_MAX);
 
@@ -369,6 +461,10 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name,
              * the zero bytes so the fd can be closed
              * after it writes everything out
              */
+            if (NULL == (output->data = (char*)malloc(bo->size))) {
+                PMIX_RELEASE(output);
+                return PMIX_ERR_NOMEM;
+            }
             memcpy(output->data, bo->bytes, bo->size);
         }
         output->numbytes = bo->size;
@@ -387,6 +483,7 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name,
         PMIX_ERROR_LOG(PMIX_ERR_VALUE_OUT_OF_BOUNDS);
         PMIX_OUTPUT_VERBOSE((1, pmix_client_globals.iof_output,
                              "%s stream %0x", PMIX_NAME_PRINT(&pmix_globals.myid), stream));
+        PMIX_RELEASE(output);
         return PMIX_ERR_VALUE_OUT_OF_BOUNDS;
     }
 
@@ -435,6 +532,10 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name,
          * the zero bytes so the fd can be closed
          * after it writes everything out
          */
+        if (NULL == (output->data = (char*)malloc(bo->size))) {
+            PMIX_RELEASE(output);
+            return PMIX_ERR_NOMEM;
+        }
         memcpy(output->data, bo->bytes, bo->size);
     }
     output->numbytes = bo->size;
@@ -444,6 +545,22 @@ pmix_status_t pmix_iof_write_output(const pmix_proc_t *name,
     starttaglen = strlen(starttag);
     endtaglen = strlen(endtag);
     endtagged = false;
+    /* size the buffer for the worst case - every byte escaped and
+     * every line re-tagged - rather than the maximum tagged chunk */
+    for (i=0, nlines=0; i < bo->size; i++) {
+        if ('\n' == bo->bytes[i]) {
+            ++nlines;
+        }
+    }
+    size = starttaglen + bo->size * (myflags.xml ? 7 : 1) +
+           nlines * (starttaglen + endtaglen + 1) + endtaglen + 1;
+    if (PMIX_IOF_BASE_TAGGED_OUT_MAX < size) {
+        size = PMIX_IOF_BASE_TAGGED_OUT_MAX;
+    }
+    if (NULL == (output->data = (char*)malloc(size))) {
+        PMIX_RELEASE(output);
+        return PMIX_ERR_NOMEM;
+    }
     /* start with the tag */
     for (j=0, k=0; j < starttaglen && k < PMIX_IOF_BASE_TAGGED_OUT_MAX; j++) {
         output->data[k++] = starttag[j];
@@ -588,9 +705,11 @@ void pmix_iof_write_handler(int _fd, short event, void *cbdata)
 {
     pmix_iof_sink_t *sink = (pmix_iof_sink_t*)cbdata;
     pmix_iof_write_event_t *wev = &sink->wev;
-    pmix_list_item_t *item;
     pmix_iof_write_output_t *output;
-    int num_written, total_written = 0;
+    struct iovec iov[PMIX_IOF_WRITE_BATCH];
+    int niov, total_written = 0;
+    ssize_t num_written;
+    bool partial;
 
     PMIX_ACQUIRE_OBJECT(sink);
 
@@ -599,18 +718,28 @@ void pmix_iof_write_handler(int _fd, short event, void *cbdata)
                          PMIX_NAME_PRINT(&pmix_globals.myid),
                          wev->fd));
 
-    while (NULL != (item = pmix_list_remove_first(&wev->outputs))) {
-        output = (pmix_iof_write_output_t*)item;
-        if (0 == output->numbytes) {
+    while (!pmix_list_is_empty(&wev->outputs)) {
+        /* hand the kernel as many queued chunks as we can at once,
+         * stopping short of any zero-byte chunk */
+        niov = 0;
+        PMIX_LIST_FOREACH(output, &wev->outputs, pmix_iof_write_output_t) {
+            if (0 == output->numbytes || PMIX_IOF_WRITE_BATCH == niov) {
+                break;
+            }
+            iov[niov].iov_base = output->data;
+            iov[niov].iov_len = output->numbytes;
+            ++niov;
+        }
+        if (0 == niov) {
             /* indicates we are to close this stream */
+            output = (pmix_iof_write_output_t*)pmix_list_remove_first(&wev->outputs);
+            PMIX_RELEASE(output);
             PMIX_RELEASE(sink);
             return;
         }
-        num_written = write(wev->fd, output->data, output->numbytes);
+        num_written = writev(wev->fd, iov, niov);
         if (num_written < 0) {
             if (EAGAIN == errno || EINTR == errno) {
-                /* push this item back on the front of the list */
-                pmix_list_prepend(&wev->outputs, item);
                 /* if the list is getting too large, abort */
                 if (pmix_globals.output_limit < pmix_list_get_size(&wev->outputs)) {
                     pmix_output(0, "IO Forwarding is running too far behind - something is blocking us from writing");
@@ -624,15 +753,29 @@ void pmix_iof_write_handler(int _fd, short event, void *cbdata)
             /* otherwise, something bad happened so all we can do is abort
              * this attempt
              */
+            output = (pmix_iof_write_output_t*)pmix_list_remove_first(&wev->outputs);
             PMIX_RELEASE(output);
             goto ABORT;
-        } else if (num_written < output->numbytes) {
-            /* incomplete write - adjust data to avoid duplicate output */
-            memmove(output->data, &output->data[num_written], output->numbytes - num_written);
-            /* adjust the number of bytes remaining to be written */
-            output->numbytes -= num_written;
-            /* push this item back on the front of the list */
-            pmix_list_prepend(&wev->outputs, item);
+        }
+        total_written += num_written;
+
+        /* release the chunks that went out completely */
+        partial = false;
+        while (0 < num_written) {
+            output = (pmix_iof_write_output_t*)pmix_list_get_first(&wev->outputs);
+            if (num_written < output->numbytes) {
+                /* incomplete write - adjust data to avoid duplicate output */
+                memmove(output->data, &output->data[num_written], output->numbytes - num_written);
+                /* adjust the number of bytes remaining to be written */
+                output->numbytes -= num_written;
+                partial = true;
+                break;
+            }
+            num_written -= output->numbytes;
+            pmix_list_remove_first(&wev->outputs);
+            PMIX_RELEASE(output);
+        }
+        if (partial) {
             /* if the list is getting too large, abort */
             if (pmix_globals.output_limit < pmix_list_get_size(&wev->outputs)) {
                 pmix_output(0, "IO Forwarding is running too far behind - something is blocking us from writing");
@@ -643,9 +786,7 @@ void pmix_iof_write_handler(int _fd, short event, void *cbdata)
              */
             goto NEXT_CALL;
         }
-        PMIX_RELEASE(output);
 
-        total_written += num_written;
         if(wev->always_writable && (PMIX_IOF_SINK_BLOCKSIZE <= total_written)){
             /* If this is a regular file it will never tell us it will block
              * Write no more than PMIX_IOF_REGULARF_BLOCK at a time allowing
@@ -702,16 +843,62 @@ static void restart_stdin(int fd, short event, void *cbdata)
     }
 }
 
+static void stdinackfunc(struct pmix_peer_t *peer,
+                         pmix_ptl_hdr_t *hdr,
+                         pmix_buffer_t *buf, void *cbdata)
+{
+    pmix_iof_read_event_t *rev = (pmix_iof_read_event_t*)cbdata;
+    int cnt;
+    pmix_status_t rc, status;
+
+    PMIX_ACQUIRE_OBJECT(rev);
+    rev->inflight--;
+
+    /* a zero-byte buffer indicates that this recv is being
+     * completed due to a lost connection - nobody is left
+     * to take any more of our stdin */
+    if (PMIX_BUFFER_IS_EMPTY(buf)) {
+        rev->stalled = false;
+        PMIX_RELEASE(rev);
+        return;
+    }
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &status, &cnt, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        status = rc;
+    }
+    if (PMIX_SUCCESS != status) {
+        PMIX_OUTPUT_VERBOSE((1, pmix_client_globals.iof_output,
+                             "%s iof:stdin push returned %s",
+                             PMIX_NAME_PRINT(&pmix_globals.myid),
+                             PMIx_Error_string(status)));
+    }
+
+    /* if we stopped reading because too many pushes were
+     * outstanding, then pick up again now there is room */
+    if (rev->stalled && rev->inflight < pmix_client_globals.iof_stdin_window) {
+        rev->stalled = false;
+        if (!rev->active && pmix_iof_stdin_check(rev->fd)) {
+            PMIX_IOF_READ_ACTIVATE(rev);
+        }
+    }
+    PMIX_RELEASE(rev);
+}
+
 /* this is the read handler for stdin */
 void pmix_iof_read_local_handler(int unusedfd, short event, void *cbdata)
 {
     pmix_iof_read_event_t *rev = (pmix_iof_read_event_t*)cbdata;
-    unsigned char data[PMIX_IOF_BASE_MSG_MAX];
+    unsigned char *data;
     int32_t numbytes;
     int fd;
     pmix_status_t rc;
     pmix_buffer_t *msg;
     pmix_cmd_t cmd = PMIX_IOF_PUSH_CMD;
+    pmix_byte_object_t bo;
+    pmix_info_t bcast;
+    size_t ntargets = 0, ndirs = 0;
 
     PMIX_ACQUIRE_OBJECT(rev);
 
@@ -720,15 +907,22 @@ void pmix_iof_read_local_handler(int unusedfd, short event, void *cbdata)
      */
     fd = fileno(stdin);
 
-    /* read up to the fragment size */
-    memset(data, 0, PMIX_IOF_BASE_MSG_MAX);
-    numbytes = read(fd, data, sizeof(data));
+    /* read up to the fragment size - a large fragment means
+     * fewer trips through our server and the host when the
+     * input is arriving in bulk */
+    data = (unsigned char*)malloc(pmix_client_globals.iof_stdin_chunk);
+    if (NULL == data) {
+        PMIX_IOF_READ_ACTIVATE(rev);
+        return;
+    }
+    numbytes = read(fd, data, pmix_client_globals.iof_stdin_chunk);
 
     if (numbytes < 0) {
         /* either we have a connection error or it was a non-blocking read */
 
         /* non-blocking, retry */
         if (EAGAIN == errno || EINTR == errno) {
+            free(data);
             PMIX_IOF_READ_ACTIVATE(rev);
             return;
         }
@@ -748,10 +942,13 @@ void pmix_iof_read_local_handler(int unusedfd, short event, void *cbdata)
     rev->active = false;
 
     /* pass the data to our PMIx server so it can relay it
-     * to the host RM for distribution */
+     * to the host RM for distribution - this is the same
+     * request PMIx_IOF_push would send, with the targets
+     * left to the host */
     msg = PMIX_NEW(pmix_buffer_t);
     if (NULL == msg) {
         /* don't restart the event - just return */
+        free(data);
         return;
     }
     PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
@@ -762,31 +959,67 @@ void pmix_iof_read_local_handler(int unusedfd, short event, void *cbdata)
         goto restart;
     }
     PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
-                     msg, &numbytes, 1, PMIX_INT32);
+                     msg, &ntargets, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(msg);
+        goto restart;
+    }
+    if (pmix_client_globals.iof_stdin_bcast) {
+        ndirs = 1;
+    }
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
+                     msg, &ndirs, 1, PMIX_SIZE);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(msg);
         goto restart;
     }
+    if (0 < ndirs) {
+        PMIX_INFO_LOAD(&bcast, PMIX_IOF_BCAST, NULL, PMIX_BOOL);
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
+                         msg, &bcast, 1, PMIX_INFO);
+        PMIX_INFO_DESTRUCT(&bcast);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(msg);
+            goto restart;
+        }
+    }
+    bo.bytes = (char*)data;
+    bo.size = numbytes;
     PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
-                     msg, data, numbytes, PMIX_BYTE);
+                     msg, &bo, 1, PMIX_BYTE_OBJECT);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(msg);
         goto restart;
     }
+    /* each push holds the event until our server acks it */
+    PMIX_RETAIN(rev);
+    rev->inflight++;
     PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver,
-                       msg, stdincbfunc, NULL);
+                       msg, stdinackfunc, rev);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(msg);
+        rev->inflight--;
+        PMIX_RELEASE(rev);
     }
 
   restart:
+    free(data);
     /* if num_bytes was zero, or we read the last piece of the file, then we need to terminate the event */
     if (0 == numbytes) {
        /* this will also close our stdin file descriptor */
+        rev->stalled = false;
         PMIX_RELEASE(rev);
+    } else if (0 < pmix_client_globals.iof_stdin_window &&
+               rev->inflight >= pmix_client_globals.iof_stdin_window) {
+        /* too much is still on its way - the ack that
+         * opens the window will restart us */
+        rev->stalled = true;
+        PMIX_POST_OBJECT(rev);
     } else {
         /* if we are looking at a tty, then we just go ahead and restart the
          * read event assuming we are not backgrounded
@@ -837,6 +1070,8 @@ static void iof_read_event_construct(pmix_iof_read_event_t* rev)
     rev->active = false;
     rev->tv.tv_sec = 0;
     rev->tv.tv_usec = 0;
+    rev->inflight = 0;
+    rev->stalled = false;
 }
 static void iof_read_event_destruct(pmix_iof_read_event_t* rev)
 {
@@ -879,6 +1114,18 @@ PMIX_CLASS_INSTANCE(pmix_iof_write_event_t,
                     iof_write_event_construct,
                     iof_write_event_destruct);
 
+static void iof_write_output_construct(pmix_iof_write_output_t* output)
+{
+    output->data = NULL;
+    output->numbytes = 0;
+}
+static void iof_write_output_destruct(pmix_iof_write_output_t* output)
+{
+    if (NULL != output->data) {
+        free(output->data);
+    }
+}
 PMIX_CLASS_INSTANCE(pmix_iof_write_output_t,
                     pmix_list_item_t,
-                    NULL, NULL);
+                    iof_write_output_construct,
+                    iof_write_output_destruct);
@@ -88,7 +88,7 @@ PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_iof_sink_t);
 
 typedef struct {
     pmix_list_item_t super;
-    char data[PMIX_IOF_BASE_TAGGED_OUT_MAX];
+    char *data;         // sized to the (tagged) chunk it holds
     int numbytes;
 } pmix_iof_write_output_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_iof_write_output_t);
@@ -100,6 +100,8 @@ typedef struct {
     int fd;
     bool active;
     bool always_readable;
+    int inflight;       // pushes not yet acked by our server
+    bool stalled;       // reading stopped until the window opens
 } pmix_iof_read_event_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_iof_read_event_t);
 
@@ -125,6 +127,9 @@ pmix_iof_fd_always_ready(int fd)
 
 #define PMIX_IOF_SINK_BLOCKSIZE (1024)
 
+/* max number of queued chunks handed to a single writev */
+#define PMIX_IOF_WRITE_BATCH      16
+
 #define PMIX_IOF_SINK_ACTIVATE(wev)                                     \
     do {                                                                \
         struct timeval *tv = NULL;                                      \
@@ -200,6 +205,9 @@ PMIX_EXPORT void pmix_iof_stdin_write_handler(int fd, short event, void *cbdata)
 PMIX_EXPORT bool pmix_iof_stdin_check(int fd);
 PMIX_EXPORT void pmix_iof_stdin_cb(int fd, short event, void *cbdata);
 PMIX_EXPORT void pmix_iof_read_local_handler(int fd, short event, void *cbdata);
+PMIX_EXPORT void pmix_iof_batch_recv(struct pmix_peer_t *peer,
+                                     pmix_ptl_hdr_t *hdr,
+                                     pmix_buffer_t *buf, void *cbdata);
 
 END_C_DECLS
 
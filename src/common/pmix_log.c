@@ -28,6 +28,7 @@
 #include "src/util/output.h"
 #include "src/mca/bfrops/bfrops.h"
 #include "src/mca/plog/base/base.h"
+#include "src/runtime/pmix_rte.h"
 
 #include "src/client/pmix_client_ops.h"
 #include "src/server/pmix_server_ops.h"
@@ -237,6 +238,14 @@ PMIX_EXPORT pmix_status_t PMIx_Log_nb(const pmix_info_t data[], size_t ndata,
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
+    /* a client only gets here when it has no server to pass
+     * the request to, and it doesn't open plog until then */
+    if (PMIX_SUCCESS != (rc = pmix_rte_open_framework(&pmix_plog_base_framework,
+                                                      pmix_plog_base_select))) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
     /* if no recorded source was found, then we must be it */
     if (NULL == source) {
         source = &pmix_globals.myid;
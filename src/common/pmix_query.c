@@ -23,6 +23,7 @@
 
 #include "src/threads/threads.h"
 #include "src/util/argv.h"
+#include "src/util/counters.h"
 #include "src/util/error.h"
 #include "src/util/name_fns.h"
 #include "src/util/output.h"
@@ -144,6 +145,7 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
     pmix_list_t results;
     pmix_kval_t *kv, *kvnxt;
     pmix_proc_t proc;
+    bool localonly;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
 
@@ -172,6 +174,9 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
     memset(proc.nspace, 0, PMIX_MAX_NSLEN+1);
     proc.rank = PMIX_RANK_INVALID;
     for (n=0; n < nqueries; n++) {
+        /* a server reports its own counters - anyone
+         * else asks their server unless told otherwise */
+        localonly = PMIX_PROC_IS_SERVER(pmix_globals.mypeer);
         for (m=0; m < queries[n].nqual; m++) {
             if (NULL != queries[n].qualifiers) {
                 for (p=0; p < queries[n].nqual; p++) {
@@ -185,6 +190,8 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
                         PMIX_LOAD_NSPACE(proc.nspace, queries[n].qualifiers[p].value.data.string);
                     } else if (PMIX_CHECK_KEY(&queries[n].qualifiers[p], PMIX_RANK)) {
                         proc.rank = queries[n].qualifiers[p].value.data.rank;
+                    } else if (PMIX_CHECK_KEY(&queries[n].qualifiers[p], PMIX_QUERY_LOCAL_ONLY)) {
+                        localonly |= PMIX_INFO_TRUE(&queries[n].qualifiers[p]);
                     }
                 }
             }
@@ -210,6 +217,21 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
             cb.proc = &proc;
         }
         for (p=0; NULL != queries[n].keys[p]; p++) {
+            if (localonly && 0 == strcmp(queries[n].keys[p], PMIX_QUERY_COUNTERS)) {
+                kv = PMIX_NEW(pmix_kval_t);
+                kv->key = strdup(PMIX_QUERY_COUNTERS);
+                PMIX_VALUE_CREATE(kv->value, 1);
+                if (NULL == kv->value ||
+                    PMIX_SUCCESS != (rc = pmix_counters_load(kv->value))) {
+                    PMIX_RELEASE(kv);
+                    PMIX_LIST_DESTRUCT(&results);
+                    PMIX_DESTRUCT(&cb);
+                    PMIX_RELEASE_THREAD(&pmix_global_lock);
+                    return PMIX_ERR_NOMEM;
+                }
+                pmix_list_append(&results, &kv->super);
+                continue;
+            }
             cb.key = queries[n].keys[p];
             PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
             if (PMIX_SUCCESS != rc) {
@@ -248,6 +270,7 @@ PMIX_EXPORT pmix_status_t PMIx_Query_info_nb(pmix_query_t queries[], size_t nque
     }
     /* done with the list of results */
     PMIX_LIST_DESTRUCT(&results);
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
     /* we need to thread-shift as we are not allowed to
      * execute the callback function prior to returning
      * from the API */
@@ -192,6 +192,8 @@ PMIX_EXPORT const char* pmix_command_string(pmix_cmd_t cmd)
             return "ABORT";
         case PMIX_COMMIT_CMD:
             return "COMMIT";
+        case PMIX_COMMIT_DELTA_CMD:
+            return "COMMIT DELTA";
         case PMIX_FENCENB_CMD:
             return "FENCE";
         case PMIX_GETNB_CMD:
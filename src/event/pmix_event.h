@@ -26,6 +26,7 @@
 #include PMIX_EVENT_HEADER
 
 #include <pmix_common.h>
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/util/output.h"
 
@@ -46,11 +47,26 @@
 #define PMIX_SERVER_INTERNAL_NOTIFY   "pmix.srvr.internal.notify"
 
 
+/* define an object holding a set of procs that can be probed
+ * without comparing nspaces pairwise - nspaces are interned to
+ * small ids so each proc is a single 64-bit key. Range and
+ * affected checks build one, on first use, for proc arrays of
+ * at least PMIX_PROC_SET_MIN entries */
+#define PMIX_PROC_SET_MIN   8
+
+typedef struct {
+    pmix_object_t super;
+    pmix_hash_table_t procs;        // (nspace id, rank) of each member
+    pmix_hash_table_t nspaces;      // ids of the nspaces with any member
+} pmix_proc_set_t;
+PMIX_CLASS_DECLARATION(pmix_proc_set_t);
+
 /* define a struct for tracking registration ranges */
 typedef struct {
     pmix_data_range_t range;
     pmix_proc_t *procs;
     size_t nprocs;
+    pmix_proc_set_t *set;           // procs as a set, if large
 } pmix_range_trkr_t;
 
 /* define a common struct for tracking event handlers */
@@ -76,6 +92,7 @@ typedef struct {
      */
     pmix_proc_t *affected;
     size_t naffected;
+    pmix_proc_set_t *affected_set;  // affected as a set, if large
     pmix_notification_fn_t evhdlr;
     void *cbobject;
     pmix_status_t *codes;
@@ -92,6 +109,17 @@ typedef struct {
 } pmix_active_code_t;
 PMIX_CLASS_DECLARATION(pmix_active_code_t);
 
+/* define an object for indexing the coded handlers by status
+ * code - each entry holds the handlers registered for that code
+ * in the order they are to be called */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_hdlr_t **hdlrs;
+    size_t nhdlrs;
+    size_t size;
+} pmix_event_index_t;
+PMIX_CLASS_DECLARATION(pmix_event_index_t);
+
 /* define an object for housing the different lists of events
  * we have registered so we can easily scan them in precedent
  * order when we get an event */
@@ -104,6 +132,8 @@ typedef struct {
     pmix_list_t single_events;
     pmix_list_t multi_events;
     pmix_list_t default_events;
+    pmix_hash_table_t index;    // code -> pmix_event_index_t
+    bool reindex;               // single/multi lists changed since last index
 } pmix_events_t;
 PMIX_CLASS_DECLARATION(pmix_events_t);
 
@@ -132,6 +162,7 @@ typedef struct pmix_event_chain_t {
     /* the processes that we affected by the event */
     pmix_proc_t *affected;
     size_t naffected;
+    pmix_proc_set_t *affected_set;
     /* any info provided by the event generator */
     pmix_info_t *info;
     size_t ninfo;
@@ -159,8 +190,11 @@ void pmix_invoke_local_event_hdlr(pmix_event_chain_t *chain);
 bool pmix_notify_check_range(pmix_range_trkr_t *rng,
                              const pmix_proc_t *proc);
 
+/* either array can be given a place to cache its set in, or NULL */
 bool pmix_notify_check_affected(pmix_proc_t *interested, size_t ninterested,
-                                pmix_proc_t *affected, size_t naffected);
+                                pmix_proc_set_t **iset,
+                                pmix_proc_t *affected, size_t naffected,
+                                pmix_proc_set_t **aset);
 
 
 /* invoke the server event notification handler */
@@ -19,6 +19,7 @@
 #include <pmix_rename.h>
 
 #include "src/threads/threads.h"
+#include "src/util/counters.h"
 #include "src/util/error.h"
 #include "src/util/output.h"
 
@@ -26,6 +27,7 @@
 #include "src/client/pmix_client_ops.h"
 #include "src/server/pmix_server_ops.h"
 #include "src/include/pmix_globals.h"
+#include "src/event/pmix_event_ring.h"
 
 static pmix_status_t notify_server_of_event(pmix_status_t status,
                                             const pmix_proc_t *source,
@@ -110,6 +112,132 @@ static void notify_event_cbfunc(struct pmix_peer_t *pr, pmix_ptl_hdr_t *hdr,
     PMIX_RELEASE(cb);
 }
 
+static pmix_status_t notify_index(pmix_notify_caddy_t *cd)
+{
+    pmix_notify_index_t *idx;
+    int *tmp;
+    void *ptr;
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&pmix_globals.notify_index,
+                                                          (uint32_t)cd->status, &ptr)) {
+        idx = (pmix_notify_index_t*)ptr;
+    } else {
+        if (NULL == (idx = PMIX_NEW(pmix_notify_index_t))) {
+            return PMIX_ERR_NOMEM;
+        }
+        pmix_hash_table_set_value_uint32(&pmix_globals.notify_index,
+                                         (uint32_t)cd->status, idx);
+    }
+    if (idx->nrooms == idx->size) {
+        tmp = (int*)realloc(idx->rooms, 2 * (idx->size + 1) * sizeof(int));
+        if (NULL == tmp) {
+            return PMIX_ERR_NOMEM;
+        }
+        idx->rooms = tmp;
+        idx->size = 2 * (idx->size + 1);
+    }
+    idx->rooms[idx->nrooms++] = cd->room;
+    return PMIX_SUCCESS;
+}
+
+void pmix_notify_cache_unindex(pmix_notify_caddy_t *cd)
+{
+    pmix_notify_index_t *idx;
+    void *ptr;
+    size_t n;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&pmix_globals.notify_index,
+                                                         (uint32_t)cd->status, &ptr)) {
+        return;
+    }
+    idx = (pmix_notify_index_t*)ptr;
+    for (n=0; n < idx->nrooms; n++) {
+        if (idx->rooms[n] == cd->room) {
+            /* preserve checkin order */
+            memmove(&idx->rooms[n], &idx->rooms[n+1], (idx->nrooms - n - 1) * sizeof(int));
+            --idx->nrooms;
+            break;
+        }
+    }
+    if (0 == idx->nrooms) {
+        pmix_hash_table_remove_value_uint32(&pmix_globals.notify_index, (uint32_t)cd->status);
+        PMIX_RELEASE(idx);
+    }
+}
+
+pmix_status_t pmix_notify_cache_rooms(pmix_status_t *codes, size_t ncodes,
+                                      int **rooms, size_t *nrooms)
+{
+    pmix_notify_index_t *idx;
+    size_t n, k, total = 0;
+    void *ptr;
+    int *r;
+
+    *rooms = NULL;
+    *nrooms = 0;
+
+    if (NULL == codes) {
+        if (0 >= pmix_globals.max_events) {
+            return PMIX_SUCCESS;
+        }
+        if (NULL == (r = (int*)malloc(pmix_globals.max_events * sizeof(int)))) {
+            return PMIX_ERR_NOMEM;
+        }
+        for (k=0; k < (size_t)pmix_globals.max_events; k++) {
+            r[k] = k;
+        }
+        *rooms = r;
+        *nrooms = pmix_globals.max_events;
+        return PMIX_SUCCESS;
+    }
+
+    /* hand back a copy as the caller may add or evict
+     * notifications while working thru the list */
+    for (n=0; n < ncodes; n++) {
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&pmix_globals.notify_index,
+                                                             (uint32_t)codes[n], &ptr)) {
+            total += ((pmix_notify_index_t*)ptr)->nrooms;
+        }
+    }
+    if (0 == total) {
+        return PMIX_SUCCESS;
+    }
+    if (NULL == (r = (int*)malloc(total * sizeof(int)))) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (n=0; n < ncodes; n++) {
+        /* don't report the same code twice */
+        for (k=0; k < n && codes[k] != codes[n]; k++);
+        if (k < n) {
+            continue;
+        }
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&pmix_globals.notify_index,
+                                                             (uint32_t)codes[n], &ptr)) {
+            idx = (pmix_notify_index_t*)ptr;
+            memcpy(&r[*nrooms], idx->rooms, idx->nrooms * sizeof(int));
+            *nrooms += idx->nrooms;
+        }
+    }
+    *rooms = r;
+    return PMIX_SUCCESS;
+}
+
+void pmix_notify_cache_clear(void)
+{
+    pmix_notify_index_t *idx;
+    uint32_t key;
+    void *ptr, *node;
+    int rc;
+
+    rc = pmix_hash_table_get_first_key_uint32(&pmix_globals.notify_index, &key, &ptr, &node);
+    while (PMIX_SUCCESS == rc) {
+        idx = (pmix_notify_index_t*)ptr;
+        PMIX_RELEASE(idx);
+        rc = pmix_hash_table_get_next_key_uint32(&pmix_globals.notify_index, &key, &ptr, node, &node);
+    }
+    pmix_hash_table_remove_all(&pmix_globals.notify_index);
+}
+
 static pmix_status_t notify_event_cache(pmix_notify_caddy_t *cd)
 {
     pmix_status_t rc;
@@ -130,26 +258,25 @@ static pmix_status_t notify_event_cache(pmix_notify_caddy_t *cd)
             if (NULL == pk) {
                 /* hey, there is room! */
                 pmix_hotel_checkin_with_res(&pmix_globals.notifications, cd, &cd->room);
-                return PMIX_SUCCESS;
+                return notify_index(cd);
             }
             /* check the age */
-            if (0 == j) {
-                etime = cd->ts;
+            if (0 > idx || difftime(pk->ts, etime) < 0) {
+                etime = pk->ts;
                 idx = j;
-            } else {
-                if (difftime(cd->ts, etime) < 0) {
-                    etime = cd->ts;
-                    idx = j;
-                }
             }
         }
         if (0 <= idx) {
             /* we found the oldest occupant - evict it */
             pmix_hotel_checkout_and_return_occupant(&pmix_globals.notifications, idx, (void**)&pk);
+            pmix_notify_cache_unindex(pk);
             PMIX_RELEASE(pk);
             rc = pmix_hotel_checkin(&pmix_globals.notifications, cd, &cd->room);
         }
     }
+    if (PMIX_SUCCESS == rc) {
+        rc = notify_index(cd);
+    }
     return rc;
 }
 
@@ -313,6 +440,121 @@ static pmix_status_t notify_server_of_event(pmix_status_t status,
 }
 
 
+static pmix_status_t index_hdlr(pmix_event_hdlr_t *evhdlr)
+{
+    pmix_event_index_t *idx;
+    pmix_event_hdlr_t **tmp;
+    void *ptr;
+    size_t n;
+
+    for (n=0; n < evhdlr->ncodes; n++) {
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&pmix_globals.events.index,
+                                                              (uint32_t)evhdlr->codes[n], &ptr)) {
+            idx = (pmix_event_index_t*)ptr;
+        } else {
+            idx = PMIX_NEW(pmix_event_index_t);
+            if (NULL == idx) {
+                return PMIX_ERR_NOMEM;
+            }
+            pmix_hash_table_set_value_uint32(&pmix_globals.events.index,
+                                             (uint32_t)evhdlr->codes[n], idx);
+        }
+        /* a handler may list the same code more than once */
+        if (0 < idx->nhdlrs && evhdlr == idx->hdlrs[idx->nhdlrs-1]) {
+            continue;
+        }
+        if (idx->nhdlrs == idx->size) {
+            tmp = (pmix_event_hdlr_t**)realloc(idx->hdlrs, 2 * (idx->size + 1) * sizeof(pmix_event_hdlr_t*));
+            if (NULL == tmp) {
+                return PMIX_ERR_NOMEM;
+            }
+            idx->hdlrs = tmp;
+            idx->size = 2 * (idx->size + 1);
+        }
+        idx->hdlrs[idx->nhdlrs++] = evhdlr;
+    }
+    return PMIX_SUCCESS;
+}
+
+static void clear_index(pmix_hash_table_t *index)
+{
+    pmix_event_index_t *idx;
+    uint32_t key;
+    void *ptr, *node;
+    int rc;
+
+    rc = pmix_hash_table_get_first_key_uint32(index, &key, &ptr, &node);
+    while (PMIX_SUCCESS == rc) {
+        idx = (pmix_event_index_t*)ptr;
+        PMIX_RELEASE(idx);
+        rc = pmix_hash_table_get_next_key_uint32(index, &key, &ptr, node, &node);
+    }
+    pmix_hash_table_remove_all(index);
+}
+
+/* return the handlers registered against the given code, in the
+ * order they are to be called - single code handlers first, then
+ * multi code ones */
+static pmix_event_index_t* code_index(pmix_status_t code)
+{
+    pmix_event_hdlr_t *evhdlr;
+    void *ptr;
+
+    if (pmix_globals.events.reindex) {
+        clear_index(&pmix_globals.events.index);
+        PMIX_LIST_FOREACH(evhdlr, &pmix_globals.events.single_events, pmix_event_hdlr_t) {
+            if (PMIX_SUCCESS != index_hdlr(evhdlr)) {
+                return NULL;
+            }
+        }
+        PMIX_LIST_FOREACH(evhdlr, &pmix_globals.events.multi_events, pmix_event_hdlr_t) {
+            if (PMIX_SUCCESS != index_hdlr(evhdlr)) {
+                return NULL;
+            }
+        }
+        pmix_globals.events.reindex = false;
+    }
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&pmix_globals.events.index,
+                                                         (uint32_t)code, &ptr)) {
+        return NULL;
+    }
+    return (pmix_event_index_t*)ptr;
+}
+
+/* find the next coded handler that wants this event, starting
+ * after the given one - or at the beginning if it is NULL */
+static pmix_event_hdlr_t* next_coded_hdlr(pmix_event_chain_t *chain,
+                                          pmix_event_hdlr_t *after)
+{
+    pmix_event_index_t *idx;
+    pmix_event_hdlr_t *evhdlr;
+    size_t n = 0;
+
+    if (NULL == (idx = code_index(chain->status))) {
+        return NULL;
+    }
+    if (NULL != after) {
+        for (n=0; n < idx->nhdlrs && after != idx->hdlrs[n]; n++);
+        if (n == idx->nhdlrs) {
+            /* the handler has since been deregistered, so we
+             * no longer know where we were in the chain */
+            return NULL;
+        }
+        ++n;
+    }
+    for (; n < idx->nhdlrs; n++) {
+        evhdlr = idx->hdlrs[n];
+        if (pmix_notify_check_range(&evhdlr->rng, &chain->source) &&
+            pmix_notify_check_affected(evhdlr->affected, evhdlr->naffected,
+                                       &evhdlr->affected_set,
+                                       chain->affected, chain->naffected,
+                                       &chain->affected_set)) {
+            return evhdlr;
+        }
+    }
+    return NULL;
+}
+
 static void progress_local_event_hdlr(pmix_status_t status,
                                       pmix_info_t *results, size_t nresults,
                                       pmix_op_cbfunc_t cbfunc, void *thiscbdata,
@@ -386,87 +628,34 @@ static void progress_local_event_hdlr(pmix_status_t status,
     }
     item = NULL;
 
-    /* see if we need to continue, starting with the single code events */
-    if (1 == chain->evhdlr->ncodes) {
-        /* the last handler was for a single code - see if there are
-         * any others that match this event */
-        item = &chain->evhdlr->super;
-        while (pmix_list_get_end(&pmix_globals.events.single_events) != (item = pmix_list_get_next(item))) {
-            nxt = (pmix_event_hdlr_t*)item;
-            if (nxt->codes[0] == chain->status &&
-                pmix_notify_check_range(&nxt->rng, &chain->source) &&
-                pmix_notify_check_affected(nxt->affected, nxt->naffected,
-                                           chain->affected, chain->naffected)) {
-                chain->evhdlr = nxt;
-                /* reset our count to the info provided by the caller */
-                chain->ninfo = chain->nallocated - 2;
-                /* if the handler has a name, then provide it */
-                if (NULL != chain->evhdlr->name) {
-                    PMIX_INFO_LOAD(&chain->info[chain->ninfo], PMIX_EVENT_HDLR_NAME, chain->evhdlr->name, PMIX_STRING);
-                    chain->ninfo++;
-                }
-
-                /* if there is an evhdlr cbobject, provide it */
-                if (NULL != chain->evhdlr->cbobject) {
-                    PMIX_INFO_LOAD(&chain->info[chain->ninfo], PMIX_EVENT_RETURN_OBJECT, chain->evhdlr->cbobject, PMIX_POINTER);
-                    chain->ninfo++;
-                }
-                nxt->evhdlr(nxt->index,
-                            chain->status, &chain->source,
-                            chain->info, chain->ninfo,
-                            chain->results, chain->nresults,
-                            progress_local_event_hdlr, (void*)chain);
-                return;
+    /* see if we need to continue with the coded handlers - if the
+     * last one was the overall "first", then start at the beginning */
+    if (NULL != chain->evhdlr->codes) {
+        nxt = next_coded_hdlr(chain, (chain->evhdlr == pmix_globals.events.first) ?
+                                     NULL : chain->evhdlr);
+        if (NULL != nxt) {
+            chain->evhdlr = nxt;
+            /* reset our count to the info provided by the caller */
+            chain->ninfo = chain->nallocated - 2;
+            /* if the handler has a name, then provide it */
+            if (NULL != chain->evhdlr->name) {
+                PMIX_INFO_LOAD(&chain->info[chain->ninfo], PMIX_EVENT_HDLR_NAME, chain->evhdlr->name, PMIX_STRING);
+                chain->ninfo++;
             }
-        }
-        /* if we get here, then there are no more single code
-         * events that match */
-        item = pmix_list_get_begin(&pmix_globals.events.multi_events);
-    }
 
-    /* see if we need to continue with the multi code events */
-    if (NULL != chain->evhdlr->codes || NULL != item) {
-        /* the last handler was for a multi-code event, or we exhausted
-         * all the single code events */
-        if (NULL == item) {
-            /* if the last handler was multi-code, then start from that point */
-            item = &chain->evhdlr->super;
-        }
-        while (pmix_list_get_end(&pmix_globals.events.multi_events) != (item = pmix_list_get_next(item))) {
-            nxt = (pmix_event_hdlr_t*)item;
-            if (!pmix_notify_check_range(&nxt->rng, &chain->source) ||
-                !pmix_notify_check_affected(nxt->affected, nxt->naffected,
-                                            chain->affected, chain->naffected)) {
-                continue;
-            }
-            for (n=0; n < nxt->ncodes; n++) {
-                /* if this event handler provided a range, check to see if
-                 * the source fits within it */
-                if (nxt->codes[n] == chain->status) {
-                    chain->evhdlr = nxt;
-                    /* reset our count to the info provided by the caller */
-                    chain->ninfo = chain->nallocated - 2;
-                    /* if the handler has a name, then provide it */
-                    if (NULL != chain->evhdlr->name) {
-                        PMIX_INFO_LOAD(&chain->info[chain->ninfo], PMIX_EVENT_HDLR_NAME, chain->evhdlr->name, PMIX_STRING);
-                        chain->ninfo++;
-                    }
-
-                    /* if there is an evhdlr cbobject, provide it */
-                    if (NULL != chain->evhdlr->cbobject) {
-                        PMIX_INFO_LOAD(&chain->info[chain->ninfo], PMIX_EVENT_RETURN_OBJECT, chain->evhdlr->cbobject, PMIX_POINTER);
-                        chain->ninfo++;
-                    }
-                    nxt->evhdlr(nxt->index,
-                                chain->status, &chain->source,
-                                chain->info, chain->ninfo,
-                                chain->results, chain->nresults,
-                                progress_local_event_hdlr, (void*)chain);
-                    return;
-                }
+            /* if there is an evhdlr cbobject, provide it */
+            if (NULL != chain->evhdlr->cbobject) {
+                PMIX_INFO_LOAD(&chain->info[chain->ninfo], PMIX_EVENT_RETURN_OBJECT, chain->evhdlr->cbobject, PMIX_POINTER);
+                chain->ninfo++;
             }
+            nxt->evhdlr(nxt->index,
+                        chain->status, &chain->source,
+                        chain->info, chain->ninfo,
+                        chain->results, chain->nresults,
+                        progress_local_event_hdlr, (void*)chain);
+            return;
         }
-        /* if we get here, then there are no more multi-mode
+        /* if we get here, then there are no more coded
          * events that match */
         item = pmix_list_get_begin(&pmix_globals.events.default_events);
     }
@@ -482,7 +671,9 @@ static void progress_local_event_hdlr(pmix_status_t status,
              * the source fits within it */
             if (pmix_notify_check_range(&nxt->rng, &chain->source) &&
                 pmix_notify_check_affected(nxt->affected, nxt->naffected,
-                                           chain->affected, chain->naffected)) {
+                                           &nxt->affected_set,
+                                           chain->affected, chain->naffected,
+                                           &chain->affected_set)) {
                 chain->evhdlr = nxt;
                 /* reset our count to the info provided by the caller */
                 chain->ninfo = chain->nallocated - 2;
@@ -512,7 +703,9 @@ static void progress_local_event_hdlr(pmix_status_t status,
     if (NULL != pmix_globals.events.last &&
         pmix_notify_check_range(&pmix_globals.events.last->rng, &chain->source) &&
         pmix_notify_check_affected(pmix_globals.events.last->affected, pmix_globals.events.last->naffected,
-                                   chain->affected, chain->naffected)) {
+                                   &pmix_globals.events.last->affected_set,
+                                   chain->affected, chain->naffected,
+                                   &chain->affected_set)) {
         chain->endchain = true;  // ensure we don't do this again
         if (1 == pmix_globals.events.last->ncodes &&
             pmix_globals.events.last->codes[0] == chain->status) {
@@ -653,7 +846,9 @@ void pmix_invoke_local_event_hdlr(pmix_event_chain_t *chain)
             pmix_globals.events.first->codes[0] == chain->status &&
             pmix_notify_check_range(&pmix_globals.events.first->rng, &chain->source) &&
             pmix_notify_check_affected(pmix_globals.events.first->affected, pmix_globals.events.first->naffected,
-                                       chain->affected, chain->naffected)) {
+                                       &pmix_globals.events.first->affected_set,
+                                       chain->affected, chain->naffected,
+                                       &chain->affected_set)) {
             /* invoke the handler */
             chain->evhdlr = pmix_globals.events.first;
             goto invk;
@@ -684,33 +879,11 @@ void pmix_invoke_local_event_hdlr(pmix_event_chain_t *chain)
         /* get here if there is no match, so fall thru */
     }
 
-    /* cycle thru the single-event registrations first */
-    PMIX_LIST_FOREACH(evhdlr, &pmix_globals.events.single_events, pmix_event_hdlr_t) {
-        if (evhdlr->codes[0] == chain->status) {
-            if (pmix_notify_check_range(&evhdlr->rng, &chain->source) &&
-                pmix_notify_check_affected(evhdlr->affected, evhdlr->naffected,
-                                           chain->affected, chain->naffected)) {
-                /* invoke the handler */
-                chain->evhdlr = evhdlr;
-                goto invk;
-            }
-        }
-    }
-
-    /* if we didn't find any match in the single-event registrations,
-     * then cycle thru the multi-event registrations next */
-    PMIX_LIST_FOREACH(evhdlr, &pmix_globals.events.multi_events, pmix_event_hdlr_t) {
-        for (i=0; i < evhdlr->ncodes; i++) {
-            if (evhdlr->codes[i] == chain->status) {
-                if (pmix_notify_check_range(&evhdlr->rng, &chain->source) &&
-                    pmix_notify_check_affected(evhdlr->affected, evhdlr->naffected,
-                                               chain->affected, chain->naffected)) {
-                    /* invoke the handler */
-                    chain->evhdlr = evhdlr;
-                    goto invk;
-                }
-            }
-        }
+    /* cycle thru the single and multi-event registrations for this code */
+    if (NULL != (evhdlr = next_coded_hdlr(chain, NULL))) {
+        /* invoke the handler */
+        chain->evhdlr = evhdlr;
+        goto invk;
     }
 
     /* if they didn't want it to go to a default handler, then ignore them */
@@ -719,7 +892,9 @@ void pmix_invoke_local_event_hdlr(pmix_event_chain_t *chain)
         PMIX_LIST_FOREACH(evhdlr, &pmix_globals.events.default_events, pmix_event_hdlr_t) {
             if (pmix_notify_check_range(&evhdlr->rng, &chain->source) &&
                 pmix_notify_check_affected(evhdlr->affected, evhdlr->naffected,
-                                           chain->affected, chain->naffected)) {
+                                           &evhdlr->affected_set,
+                                           chain->affected, chain->naffected,
+                                           &chain->affected_set)) {
                 /* invoke the handler */
                 chain->evhdlr = evhdlr;
                 goto invk;
@@ -732,7 +907,9 @@ void pmix_invoke_local_event_hdlr(pmix_event_chain_t *chain)
     if (NULL != pmix_globals.events.last &&
         pmix_notify_check_range(&pmix_globals.events.last->rng, &chain->source) &&
         pmix_notify_check_affected(pmix_globals.events.last->affected, pmix_globals.events.last->naffected,
-                                   chain->affected, chain->naffected)) {
+                                   &pmix_globals.events.last->affected_set,
+                                   chain->affected, chain->naffected,
+                                   &chain->affected_set)) {
         chain->endchain = true;  // ensure we don't do this again
         if (1 == pmix_globals.events.last->ncodes &&
             pmix_globals.events.last->codes[0] == chain->status) {
@@ -804,28 +981,89 @@ static void local_cbfunc(pmix_status_t status, void *cbdata)
     PMIX_RELEASE(cd);
 }
 
-static void _notify_client_event(int sd, short args, void *cbdata)
+/* number of distinct client personalities we keep a packed
+ * copy of the notification for */
+#define PMIX_NOTIFY_PACKED_MAX  4
+
+static pmix_buffer_t* pack_notification(pmix_notify_caddy_t *cd,
+                                        pmix_peer_t *peer)
 {
-    pmix_notify_caddy_t *cd = (pmix_notify_caddy_t*)cbdata;
-    pmix_regevents_info_t *reginfoptr;
-    pmix_peer_events_info_t *pr;
-    pmix_event_chain_t *chain;
-    size_t n;
-    bool matched, holdcd;
     pmix_buffer_t *bfr;
     pmix_cmd_t cmd = PMIX_NOTIFY_CMD;
     pmix_status_t rc;
-    pmix_list_t trk;
-    pmix_namelist_t *nm;
 
-    /* need to acquire the object from its originating thread */
-    PMIX_ACQUIRE_OBJECT(cd);
+    bfr = PMIX_NEW(pmix_buffer_t);
+    if (NULL == bfr) {
+        return NULL;
+    }
+    /* pack the command */
+    PMIX_BFROPS_PACK(rc, peer, bfr, &cmd, 1, PMIX_COMMAND);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(bfr);
+        return NULL;
+    }
+
+    /* pack the status */
+    PMIX_BFROPS_PACK(rc, peer, bfr, &cd->status, 1, PMIX_STATUS);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(bfr);
+        return NULL;
+    }
+
+    /* pack the source */
+    PMIX_BFROPS_PACK(rc, peer, bfr, &cd->source, 1, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(bfr);
+        return NULL;
+    }
+    /* pack any info */
+    PMIX_BFROPS_PACK(rc, peer, bfr, &cd->ninfo, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(bfr);
+        return NULL;
+    }
+
+    if (0 < cd->ninfo) {
+        PMIX_BFROPS_PACK(rc, peer, bfr, cd->info, cd->ninfo, PMIX_INFO);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(bfr);
+            return NULL;
+        }
+    }
+    return bfr;
+}
+
+static void notify_clients(pmix_notify_caddy_t *cd)
+{
+    pmix_regevents_info_t *regs[2];
+    pmix_peer_t *peer;
+    pmix_event_chain_t *chain;
+    size_t n, m, npacked = 0;
+    int r, i;
+    bool matched, holdcd;
+    pmix_buffer_t *bfr;
+    struct {
+        pmix_bfrops_module_t *bfrops;
+        pmix_bfrop_buffer_type_t type;
+        pmix_buffer_t *bfr;
+    } packed[PMIX_NOTIFY_PACKED_MAX];
+    pmix_status_t rc;
+    pmix_buffer_t *ringbfr = NULL;
+    pmix_bitmap_t ringreaders;
+    bool ringok = true;
+    size_t nring = 0;
 
     pmix_output_verbose(2, pmix_server_globals.event_output,
                         "pmix_server: _notify_client_event notifying clients of event %s range %s type %s",
                         PMIx_Error_string(cd->status),
                         PMIx_Data_range_string(cd->range),
                         cd->nondefault ? "NONDEFAULT" : "OPEN");
+    pmix_counter_add(PMIX_CTR_NOTIFY, 1);
 
     /* check for caching instructions */
     holdcd = true;
@@ -946,105 +1184,114 @@ static void _notify_client_event(int sd, short args, void *cbdata)
     }
     holdcd = false;
     if (PMIX_RANGE_PROC_LOCAL != cd->range) {
-        PMIX_CONSTRUCT(&trk, pmix_list_t);
-        /* cycle across our registered events and send the message to
-         * any client who registered for it */
-        PMIX_LIST_FOREACH(reginfoptr, &pmix_server_globals.events, pmix_regevents_info_t) {
-            if ((PMIX_MAX_ERR_CONSTANT == reginfoptr->code && !cd->nondefault) ||
-                cd->status == reginfoptr->code) {
-                PMIX_LIST_FOREACH(pr, &reginfoptr->peers, pmix_peer_events_info_t) {
-                    /* if this client was the source of the event, then
-                     * don't send it back as they will have processed it
-                     * when they generated it */
-                    if (PMIX_CHECK_PROCID(&cd->source, &pr->peer->info->pname)) {
-                        continue;
-                    }
-                    /* if we have already notified this client, then don't do it again */
+        PMIX_CONSTRUCT(&ringreaders, pmix_bitmap_t);
+        /* send the message to any client who registered for this code
+         * or, unless it is meant only for those, for all events - each
+         * registration knows its clients by their index */
+        regs[0] = pmix_server_reg_lookup(cd->status);
+        regs[1] = cd->nondefault ? NULL : pmix_server_reg_lookup(PMIX_MAX_ERR_CONSTANT);
+        for (r=0; r < 2; r++) {
+            if (NULL == regs[r]) {
+                continue;
+            }
+            for (i = pmix_bitmap_find_next_set_bit(&regs[r]->members, 0); 0 <= i;
+                 i = pmix_bitmap_find_next_set_bit(&regs[r]->members, i+1)) {
+                /* a client registered both ways only gets it once */
+                if (1 == r && NULL != regs[0] &&
+                    pmix_bitmap_is_set_bit(&regs[0]->members, i)) {
+                    continue;
+                }
+                peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, i);
+                if (NULL == peer) {
+                    continue;
+                }
+                /* if this client was the source of the event, then
+                 * don't send it back as they will have processed it
+                 * when they generated it */
+                if (PMIX_CHECK_PROCID(&cd->source, &peer->info->pname)) {
+                    continue;
+                }
+                /* if we were given specific targets, check if this is one */
+                if (NULL != cd->targets) {
                     matched = false;
-                    PMIX_LIST_FOREACH(nm, &trk, pmix_namelist_t) {
-                        if (nm->pname == &pr->peer->info->pname) {
+                    for (n=0; n < cd->ntargets; n++) {
+                        if (PMIX_CHECK_PROCID(&peer->info->pname, &cd->targets[n])) {
                             matched = true;
                             break;
                         }
                     }
-                    if (matched) {
+                    if (!matched) {
+                        /* do not notify this one */
                         continue;
                     }
-                    /* if we were given specific targets, check if this is one */
-                    if (NULL != cd->targets) {
-                        matched = false;
-                        for (n=0; n < cd->ntargets; n++) {
-                            if (PMIX_CHECK_PROCID(&pr->peer->info->pname, &cd->targets[n])) {
-                                matched = true;
-                                break;
-                            }
-                        }
-                        if (!matched) {
-                            /* do not notify this one */
-                            continue;
+                }
+                pmix_output_verbose(2, pmix_server_globals.event_output,
+                                    "pmix_server: notifying client %s:%u on status %s",
+                                    peer->info->pname.nspace, peer->info->pname.rank,
+                                    PMIx_Error_string(cd->status));
+
+                /* clients reading the event ring just get their bit
+                 * set in the one entry we write for all of them */
+                if (ringok && 0 <= peer->evring_idx) {
+                    if (NULL == ringbfr) {
+                        ringbfr = pack_notification(cd, pmix_globals.mypeer);
+                        if (NULL == ringbfr || !pmix_event_ring_fits(ringbfr->bytes_used)) {
+                            /* too big for a slot - use the socket */
+                            ringok = false;
                         }
                     }
-                    pmix_output_verbose(2, pmix_server_globals.event_output,
-                                        "pmix_server: notifying client %s:%u on status %s",
-                                        pr->peer->info->pname.nspace, pr->peer->info->pname.rank,
-                                        PMIx_Error_string(cd->status));
-
-                    /* record that we notified this client */
-                    nm = PMIX_NEW(pmix_namelist_t);
-                    nm->pname = &pr->peer->info->pname;
-                    pmix_list_append(&trk, &nm->super);
-
-                    bfr = PMIX_NEW(pmix_buffer_t);
-                    if (NULL == bfr) {
-                        continue;
-                    }
-                    /* pack the command */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cmd, 1, PMIX_COMMAND);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
-                    }
-
-                    /* pack the status */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cd->status, 1, PMIX_STATUS);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
+                    if (ringok) {
+                        pmix_bitmap_set_bit(&ringreaders, peer->evring_idx);
+                        ++nring;
                         continue;
                     }
+                }
 
-                    /* pack the source */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cd->source, 1, PMIX_PROC);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
-                        continue;
+                /* peers that share a personality can all be sent the
+                 * same packed buffer - each send holds its own reference */
+                bfr = NULL;
+                for (m=0; m < npacked; m++) {
+                    if (packed[m].bfrops == peer->nptr->compat.bfrops &&
+                        packed[m].type == peer->nptr->compat.type) {
+                        bfr = packed[m].bfr;
+                        PMIX_RETAIN(bfr);
+                        break;
                     }
-                    /* pack any info */
-                    PMIX_BFROPS_PACK(rc, pr->peer, bfr, &cd->ninfo, 1, PMIX_SIZE);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(bfr);
+                }
+                if (NULL == bfr) {
+                    if (NULL == (bfr = pack_notification(cd, peer))) {
                         continue;
                     }
-
-                    if (0 < cd->ninfo) {
-                        PMIX_BFROPS_PACK(rc, pr->peer, bfr, cd->info, cd->ninfo, PMIX_INFO);
-                        if (PMIX_SUCCESS != rc) {
-                            PMIX_ERROR_LOG(rc);
-                            PMIX_RELEASE(bfr);
-                            continue;
-                        }
-                    }
-                    PMIX_SERVER_QUEUE_REPLY(rc, pr->peer, 0, bfr);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_RELEASE(bfr);
+                    if (npacked < PMIX_NOTIFY_PACKED_MAX) {
+                        packed[npacked].bfrops = peer->nptr->compat.bfrops;
+                        packed[npacked].type = peer->nptr->compat.type;
+                        packed[npacked].bfr = bfr;
+                        PMIX_RETAIN(bfr);
+                        ++npacked;
                     }
                 }
+                PMIX_SERVER_QUEUE_REPLY(rc, peer, 0, bfr);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_RELEASE(bfr);
+                }
             }
         }
-        PMIX_LIST_DESTRUCT(&trk);
+        for (m=0; m < npacked; m++) {
+            PMIX_RELEASE(packed[m].bfr);
+        }
+        if (0 < nring) {
+            pmix_output_verbose(2, pmix_server_globals.event_output,
+                                "pmix_server: writing status %s to the event ring for %lu clients",
+                                PMIx_Error_string(cd->status), (unsigned long)nring);
+            rc = pmix_event_ring_publish(ringbfr, &ringreaders);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+            }
+        }
+        if (NULL != ringbfr) {
+            PMIX_RELEASE(ringbfr);
+        }
+        PMIX_DESTRUCT(&ringreaders);
         if (PMIX_RANGE_LOCAL != cd->range && PMIX_CHECK_PROCID(&cd->source, &pmix_globals.myid)) {
             /* if we are the source, then we need to post this upwards as
              * well so the host RM can broadcast it as necessary */
@@ -1070,6 +1317,159 @@ static void _notify_client_event(int sd, short args, void *cbdata)
     }
 }
 
+/* return the number of affected procs carried by the event, or
+ * zero if it carries anything else - only events that say nothing
+ * beyond which procs they affect can safely be merged */
+static size_t aggregate_count(pmix_notify_caddy_t *cd)
+{
+    size_t n, nprocs = 0;
+
+    for (n=0; n < cd->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&cd->info[n], PMIX_EVENT_AFFECTED_PROC) &&
+            PMIX_PROC == cd->info[n].value.type) {
+            ++nprocs;
+        } else if (PMIX_CHECK_KEY(&cd->info[n], PMIX_EVENT_AFFECTED_PROCS) &&
+                   PMIX_DATA_ARRAY == cd->info[n].value.type &&
+                   NULL != cd->info[n].value.data.darray &&
+                   PMIX_PROC == cd->info[n].value.data.darray->type) {
+            nprocs += cd->info[n].value.data.darray->size;
+        } else {
+            return 0;
+        }
+    }
+    return nprocs;
+}
+
+static pmix_status_t aggregate_procs(pmix_event_aggregate_t *agg,
+                                     pmix_notify_caddy_t *cd, size_t nprocs)
+{
+    pmix_proc_t *procs;
+    size_t n, size;
+
+    if (agg->size < agg->nprocs + nprocs) {
+        size = 2 * (agg->nprocs + nprocs);
+        procs = (pmix_proc_t*)realloc(agg->procs, size * sizeof(pmix_proc_t));
+        if (NULL == procs) {
+            return PMIX_ERR_NOMEM;
+        }
+        agg->procs = procs;
+        agg->size = size;
+    }
+    for (n=0; n < cd->ninfo; n++) {
+        if (PMIX_PROC == cd->info[n].value.type) {
+            memcpy(&agg->procs[agg->nprocs], cd->info[n].value.data.proc, sizeof(pmix_proc_t));
+            ++agg->nprocs;
+        } else {
+            memcpy(&agg->procs[agg->nprocs], cd->info[n].value.data.darray->array,
+                   cd->info[n].value.data.darray->size * sizeof(pmix_proc_t));
+            agg->nprocs += cd->info[n].value.data.darray->size;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static void aggregate_timeout(int sd, short args, void *cbdata)
+{
+    pmix_event_aggregate_t *agg = (pmix_event_aggregate_t*)cbdata;
+    pmix_notify_caddy_t *cd = agg->cd;
+    pmix_data_array_t *darray;
+
+    agg->active = false;
+    agg->cd = NULL;
+    pmix_list_remove_item(&pmix_server_globals.aggregates, &agg->super);
+
+    pmix_output_verbose(2, pmix_server_globals.event_output,
+                        "pmix_server: delivering %lu aggregated events %s affecting %lu procs",
+                        (unsigned long)(agg->nevents + 1), PMIx_Error_string(cd->status),
+                        (unsigned long)agg->nprocs);
+
+    if (0 < agg->nevents) {
+        /* replace the first event's procs with those of the whole burst */
+        darray = (pmix_data_array_t*)malloc(sizeof(pmix_data_array_t));
+        if (NULL == darray) {
+            PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+        } else {
+            PMIX_INFO_FREE(cd->info, cd->ninfo);
+            cd->ninfo = 1;
+            PMIX_INFO_CREATE(cd->info, cd->ninfo);
+            darray->type = PMIX_PROC;
+            darray->size = agg->nprocs;
+            darray->array = agg->procs;
+            pmix_strncpy(cd->info[0].key, PMIX_EVENT_AFFECTED_PROCS, PMIX_MAX_KEYLEN);
+            cd->info[0].value.type = PMIX_DATA_ARRAY;
+            cd->info[0].value.data.darray = darray;
+            agg->procs = NULL;
+            agg->nprocs = 0;
+            agg->size = 0;
+        }
+    }
+    PMIX_RELEASE(agg);
+
+    notify_clients(cd);
+}
+
+/* coalesce a host event into any pending burst of the same code,
+ * range, and source. Returns true if the event was absorbed and
+ * will be delivered when the burst's window expires */
+static bool aggregate_event(pmix_notify_caddy_t *cd)
+{
+    pmix_event_aggregate_t *agg;
+    size_t nprocs;
+    struct timeval tv;
+
+    if (0 >= pmix_server_globals.event_aggregation ||
+        0 == (nprocs = aggregate_count(cd))) {
+        return false;
+    }
+
+    PMIX_LIST_FOREACH(agg, &pmix_server_globals.aggregates, pmix_event_aggregate_t) {
+        if (agg->cd->status == cd->status && agg->cd->range == cd->range &&
+            agg->cd->source.rank == cd->source.rank &&
+            0 == strncmp(agg->cd->source.nspace, cd->source.nspace, PMIX_MAX_NSLEN)) {
+            if (PMIX_SUCCESS != aggregate_procs(agg, cd, nprocs)) {
+                return false;
+            }
+            ++agg->nevents;
+            /* the event has been accepted - the host need not
+             * wait for the burst to be delivered */
+            if (NULL != cd->cbfunc) {
+                cd->cbfunc(PMIX_SUCCESS, cd->cbdata);
+            }
+            PMIX_RELEASE(cd);
+            return true;
+        }
+    }
+
+    /* start a new burst with this event */
+    agg = PMIX_NEW(pmix_event_aggregate_t);
+    if (PMIX_SUCCESS != aggregate_procs(agg, cd, nprocs)) {
+        PMIX_RELEASE(agg);
+        return false;
+    }
+    agg->cd = cd;
+    pmix_list_append(&pmix_server_globals.aggregates, &agg->super);
+    tv.tv_sec = pmix_server_globals.event_aggregation / 1000;
+    tv.tv_usec = (pmix_server_globals.event_aggregation % 1000) * 1000;
+    pmix_event_evtimer_set(pmix_globals.evbase, &agg->ev,
+                           aggregate_timeout, agg);
+    pmix_event_evtimer_add(&agg->ev, &tv);
+    agg->active = true;
+    return true;
+}
+
+static void _notify_client_event(int sd, short args, void *cbdata)
+{
+    pmix_notify_caddy_t *cd = (pmix_notify_caddy_t*)cbdata;
+
+    /* need to acquire the object from its originating thread */
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    if (aggregate_event(cd)) {
+        return;
+    }
+    notify_clients(cd);
+}
+
 
 /* as a server, we must do two things:
  *
@@ -1134,6 +1534,72 @@ pmix_status_t pmix_server_notify_client_of_event(pmix_status_t status,
     return PMIX_SUCCESS;
 }
 
+#define PMIX_PROC_SET_KEY(id, rank)  ((((uint64_t)(id)) << 32) | (uint64_t)(rank))
+
+static pmix_proc_set_t* proc_set_get(pmix_proc_set_t **cache,
+                                     const pmix_proc_t *procs, size_t nprocs)
+{
+    pmix_proc_set_t *set;
+    pmix_nsid_t id;
+    size_t n;
+
+    if (NULL == cache || nprocs < PMIX_PROC_SET_MIN) {
+        return NULL;
+    }
+    if (NULL != *cache) {
+        return *cache;
+    }
+    if (NULL == (set = PMIX_NEW(pmix_proc_set_t))) {
+        return NULL;
+    }
+    for (n=0; n < nprocs; n++) {
+        id = pmix_nsid_intern(procs[n].nspace);
+        pmix_hash_table_set_value_uint64(&set->procs,
+                                         PMIX_PROC_SET_KEY(id, procs[n].rank), set);
+        pmix_hash_table_set_value_uint32(&set->nspaces, id, set);
+    }
+    *cache = set;
+    return set;
+}
+
+/* true if the set holds the proc itself or its whole nspace */
+static bool proc_set_contains(pmix_proc_set_t *set, const pmix_proc_t *proc)
+{
+    pmix_nsid_t id;
+    void *val;
+
+    /* a name that was never interned cannot be in any set */
+    if (PMIX_NSID_INVALID == (id = pmix_nsid_find(proc->nspace))) {
+        return false;
+    }
+    return (PMIX_SUCCESS == pmix_hash_table_get_value_uint64(&set->procs,
+                                PMIX_PROC_SET_KEY(id, proc->rank), &val) ||
+            PMIX_SUCCESS == pmix_hash_table_get_value_uint64(&set->procs,
+                                PMIX_PROC_SET_KEY(id, PMIX_RANK_WILDCARD), &val));
+}
+
+/* true if any of the procs matches a member, a wildcard
+ * rank on either side matching the whole nspace */
+static bool proc_set_overlaps(pmix_proc_set_t *set,
+                              const pmix_proc_t *procs, size_t nprocs)
+{
+    pmix_nsid_t id;
+    void *val;
+    size_t n;
+
+    for (n=0; n < nprocs; n++) {
+        if (PMIX_RANK_WILDCARD == procs[n].rank) {
+            if (PMIX_NSID_INVALID != (id = pmix_nsid_find(procs[n].nspace)) &&
+                PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&set->nspaces, id, &val)) {
+                return true;
+            }
+        } else if (proc_set_contains(set, &procs[n])) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool pmix_notify_check_range(pmix_range_trkr_t *rng,
                              const pmix_proc_t *proc)
 {
@@ -1161,6 +1627,9 @@ bool pmix_notify_check_range(pmix_range_trkr_t *rng,
     if (PMIX_RANGE_CUSTOM == rng->range) {
         if (NULL != rng->procs) {
             /* see if this proc was included */
+            if (NULL != proc_set_get(&rng->set, rng->procs, rng->nprocs)) {
+                return proc_set_contains(rng->set, proc);
+            }
             for (n=0; n < rng->nprocs; n++) {
                 if (0 != strncmp(rng->procs[n].nspace, proc->nspace, PMIX_MAX_NSLEN)) {
                     continue;
@@ -1184,8 +1653,11 @@ bool pmix_notify_check_range(pmix_range_trkr_t *rng,
 }
 
 bool pmix_notify_check_affected(pmix_proc_t *interested, size_t ninterested,
-                                pmix_proc_t *affected, size_t naffected)
+                                pmix_proc_set_t **iset,
+                                pmix_proc_t *affected, size_t naffected,
+                                pmix_proc_set_t **aset)
 {
+    pmix_proc_set_t *set;
     size_t m, n;
 
     /* if they didn't restrict their interests, then accept it */
@@ -1196,6 +1668,15 @@ bool pmix_notify_check_affected(pmix_proc_t *interested, size_t ninterested,
     if (NULL == affected) {
         return true;
     }
+    /* probe the set of the larger array with the procs of the
+     * smaller, if we can */
+    if (naffected >= ninterested) {
+        if (NULL != (set = proc_set_get(aset, affected, naffected))) {
+            return proc_set_overlaps(set, interested, ninterested);
+        }
+    } else if (NULL != (set = proc_set_get(iset, interested, ninterested))) {
+        return proc_set_overlaps(set, affected, naffected);
+    }
     /* check if the two overlap */
     for (n=0; n < naffected; n++) {
         for (m=0; m < ninterested; m++) {
@@ -1307,8 +1788,10 @@ static void sevcon(pmix_event_hdlr_t *p)
     p->rng.range = PMIX_RANGE_UNDEF;
     p->rng.procs = NULL;
     p->rng.nprocs = 0;
+    p->rng.set = NULL;
     p->affected = NULL;
     p->naffected = 0;
+    p->affected_set = NULL;
     p->evhdlr = NULL;
     p->cbobject = NULL;
     p->codes = NULL;
@@ -1325,9 +1808,15 @@ static void sevdes(pmix_event_hdlr_t *p)
     if (NULL != p->rng.procs) {
         free(p->rng.procs);
     }
+    if (NULL != p->rng.set) {
+        PMIX_RELEASE(p->rng.set);
+    }
     if (NULL != p->affected) {
         PMIX_PROC_FREE(p->affected, p->naffected);
     }
+    if (NULL != p->affected_set) {
+        PMIX_RELEASE(p->affected_set);
+    }
     if (NULL != p->codes) {
         free(p->codes);
     }
@@ -1353,6 +1842,9 @@ static void evcon(pmix_events_t *p)
     PMIX_CONSTRUCT(&p->single_events, pmix_list_t);
     PMIX_CONSTRUCT(&p->multi_events, pmix_list_t);
     PMIX_CONSTRUCT(&p->default_events, pmix_list_t);
+    PMIX_CONSTRUCT(&p->index, pmix_hash_table_t);
+    pmix_hash_table_init(&p->index, 64);
+    p->reindex = false;
 }
 static void evdes(pmix_events_t *p)
 {
@@ -1366,11 +1858,45 @@ static void evdes(pmix_events_t *p)
     PMIX_LIST_DESTRUCT(&p->single_events);
     PMIX_LIST_DESTRUCT(&p->multi_events);
     PMIX_LIST_DESTRUCT(&p->default_events);
+    clear_index(&p->index);
+    PMIX_DESTRUCT(&p->index);
 }
 PMIX_CLASS_INSTANCE(pmix_events_t,
                     pmix_object_t,
                     evcon, evdes);
 
+static void idxcon(pmix_event_index_t *p)
+{
+    p->hdlrs = NULL;
+    p->nhdlrs = 0;
+    p->size = 0;
+}
+static void idxdes(pmix_event_index_t *p)
+{
+    if (NULL != p->hdlrs) {
+        free(p->hdlrs);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_event_index_t,
+                    pmix_object_t,
+                    idxcon, idxdes);
+
+static void nidxcon(pmix_notify_index_t *p)
+{
+    p->rooms = NULL;
+    p->nrooms = 0;
+    p->size = 0;
+}
+static void nidxdes(pmix_notify_index_t *p)
+{
+    if (NULL != p->rooms) {
+        free(p->rooms);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_notify_index_t,
+                    pmix_object_t,
+                    nidxcon, nidxdes);
+
 static void chcon(pmix_event_chain_t *p)
 {
     p->timer_active = false;
@@ -1383,6 +1909,7 @@ static void chcon(pmix_event_chain_t *p)
     p->range = PMIX_RANGE_UNDEF;
     p->affected = NULL;
     p->naffected = 0;
+    p->affected_set = NULL;
     p->info = NULL;
     p->ninfo = 0;
     p->nallocated = 0;
@@ -1403,6 +1930,9 @@ static void chdes(pmix_event_chain_t *p)
     if (NULL != p->affected) {
         PMIX_PROC_FREE(p->affected, p->naffected);
     }
+    if (NULL != p->affected_set) {
+        PMIX_RELEASE(p->affected_set);
+    }
     if (NULL != p->info) {
         PMIX_INFO_FREE(p->info, p->nallocated);
     }
@@ -1413,3 +1943,19 @@ static void chdes(pmix_event_chain_t *p)
 PMIX_CLASS_INSTANCE(pmix_event_chain_t,
                     pmix_list_item_t,
                     chcon, chdes);
+
+static void pscon(pmix_proc_set_t *p)
+{
+    PMIX_CONSTRUCT(&p->procs, pmix_hash_table_t);
+    pmix_hash_table_init(&p->procs, 32);
+    PMIX_CONSTRUCT(&p->nspaces, pmix_hash_table_t);
+    pmix_hash_table_init(&p->nspaces, 4);
+}
+static void psdes(pmix_proc_set_t *p)
+{
+    PMIX_DESTRUCT(&p->procs);
+    PMIX_DESTRUCT(&p->nspaces);
+}
+PMIX_CLASS_INSTANCE(pmix_proc_set_t,
+                    pmix_object_t,
+                    pscon, psdes);
@@ -25,6 +25,7 @@
 #include "src/include/pmix_globals.h"
 #include "src/mca/bfrops/bfrops.h"
 #include "src/event/pmix_event.h"
+#include "src/event/pmix_event_ring.h"
 
  typedef struct {
     pmix_object_t super;
@@ -112,6 +113,7 @@ static void regevents_cbfunc(struct pmix_peer_t *peer, pmix_ptl_hdr_t *hdr,
             }
         } else if (NULL != rb->hdlr) {
             pmix_list_remove_item(rb->list, &rb->hdlr->super);
+            pmix_globals.events.reindex = true;
             PMIX_RELEASE(rb->hdlr);
         }
         ret = PMIX_ERR_SERVER_FAILED_REQUEST;
@@ -158,6 +160,7 @@ static void reg_cbfunc(pmix_status_t status, void *cbdata)
             }
         } else if (NULL != rb->hdlr) {
             pmix_list_remove_item(rb->list, &rb->hdlr->super);
+            pmix_globals.events.reindex = true;
             PMIX_RELEASE(rb->hdlr);
         }
         rc = PMIX_ERR_SERVER_FAILED_REQUEST;
@@ -186,6 +189,8 @@ static pmix_status_t _send_to_server(pmix_rshift_caddy_t *rcd)
     pmix_status_t rc;
     pmix_buffer_t *msg;
     pmix_cmd_t cmd=PMIX_REGEVENTS_CMD;
+    pmix_info_t *info = rcd->info;
+    size_t n, ninfo = rcd->ninfo;
 
     msg = PMIX_NEW(pmix_buffer_t);
     /* pack the cmd */
@@ -209,20 +214,34 @@ static pmix_status_t _send_to_server(pmix_rshift_caddy_t *rcd)
         }
     }
 
+    /* if we read the event ring, tell the server so it
+     * can write these events there instead of sending them */
+    if (pmix_event_ring_attached()) {
+        PMIX_INFO_CREATE(info, ninfo + 1);
+        for (n=0; n < ninfo; n++) {
+            PMIX_INFO_XFER(&info[n], &rcd->info[n]);
+        }
+        PMIX_INFO_LOAD(&info[ninfo], PMIX_EVENT_RING_READER, NULL, PMIX_BOOL);
+        ++ninfo;
+    }
+
     /* pack the number of info */
-    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &rcd->ninfo, 1, PMIX_SIZE);
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, &ninfo, 1, PMIX_SIZE);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        return rc;
+        goto done;
     }
     /* pack any provided info */
-    if (0 < rcd->ninfo) {
-        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, rcd->info, rcd->ninfo, PMIX_INFO);
+    if (0 < ninfo) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver, msg, info, ninfo, PMIX_INFO);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
-            return rc;
+            goto done;
         }
     }
+    if (info != rcd->info) {
+        PMIX_INFO_FREE(info, ninfo);
+    }
     PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver, msg, regevents_cbfunc, rcd);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
@@ -230,6 +249,13 @@ static pmix_status_t _send_to_server(pmix_rshift_caddy_t *rcd)
     }
 
     return rc;
+
+  done:
+    if (info != rcd->info) {
+        PMIX_INFO_FREE(info, ninfo);
+    }
+    PMIX_RELEASE(msg);
+    return rc;
 }
 
 static pmix_status_t _add_hdlr(pmix_rshift_caddy_t *cd, pmix_list_t *xfer)
@@ -364,10 +390,16 @@ static void check_cached_events(pmix_rshift_caddy_t *cd)
     pmix_notify_caddy_t *ncd;
     bool found, matched;
     pmix_event_chain_t *chain;
-    int j;
+    pmix_proc_set_t *iset = NULL;
+    int *rooms;
+    size_t j, nrooms;
 
-    for (j=0; j < pmix_globals.max_events; j++) {
-        pmix_hotel_knock(&pmix_globals.notifications, j, (void**)&ncd);
+    /* only visit the notifications cached against these codes */
+    if (PMIX_SUCCESS != pmix_notify_cache_rooms(cd->codes, cd->ncodes, &rooms, &nrooms)) {
+        return;
+    }
+    for (j=0; j < nrooms; j++) {
+        pmix_hotel_knock(&pmix_globals.notifications, rooms[j], (void**)&ncd);
         if (NULL == ncd) {
             continue;
         }
@@ -407,8 +439,8 @@ static void check_cached_events(pmix_rshift_caddy_t *cd)
             }
         }
        /* if they specified affected proc(s) they wanted to know about, check */
-       if (!pmix_notify_check_affected(cd->affected, cd->naffected,
-                                       ncd->affected, ncd->naffected)) {
+       if (!pmix_notify_check_affected(cd->affected, cd->naffected, &iset,
+                                       ncd->affected, ncd->naffected, NULL)) {
            continue;
        }
        /* create the chain */
@@ -430,6 +462,10 @@ static void check_cached_events(pmix_rshift_caddy_t *cd)
                     PMIX_PROC_CREATE(chain->affected, 1);
                     if (NULL == chain->affected) {
                         PMIX_RELEASE(chain);
+                        free(rooms);
+                        if (NULL != iset) {
+                            PMIX_RELEASE(iset);
+                        }
                         return;
                     }
                     chain->naffected = 1;
@@ -440,6 +476,10 @@ static void check_cached_events(pmix_rshift_caddy_t *cd)
                     if (NULL == chain->affected) {
                         chain->naffected = 0;
                         PMIX_RELEASE(chain);
+                        free(rooms);
+                        if (NULL != iset) {
+                            PMIX_RELEASE(iset);
+                        }
                         return;
                     }
                     memcpy(chain->affected, ncd->info[n].value.data.darray->array, chain->naffected * sizeof(pmix_proc_t));
@@ -452,6 +492,12 @@ static void check_cached_events(pmix_rshift_caddy_t *cd)
         /* now notify any matching registered callbacks we have */
         pmix_invoke_local_event_hdlr(chain);
     }
+    if (NULL != rooms) {
+        free(rooms);
+    }
+    if (NULL != iset) {
+        PMIX_RELEASE(iset);
+    }
 }
 
 static void reg_event_hdlr(int sd, short args, void *cbdata)
@@ -814,6 +860,7 @@ static void reg_event_hdlr(int sd, short args, void *cbdata)
             goto ack;
         }
     }
+    pmix_globals.events.reindex = true;
     if (PMIX_ERR_WOULD_BLOCK == rc) {
         /* the callback will provide our response */
         PMIX_RELEASE(cd);
@@ -998,6 +1045,7 @@ static void dereg_event_hdlr(int sd, short args, void *cbdata)
         if (evhdlr->index == cd->ref) {
             /* found it */
             pmix_list_remove_item(&pmix_globals.events.single_events, &evhdlr->super);
+            pmix_globals.events.reindex = true;
             if (NULL != msg) {
                 /* see if this is the last registration we have for this code */
                 PMIX_LIST_FOREACH(active, &pmix_globals.events.actives, pmix_active_code_t) {
@@ -1029,6 +1077,7 @@ static void dereg_event_hdlr(int sd, short args, void *cbdata)
         if (evhdlr->index == cd->ref) {
             /* found it */
             pmix_list_remove_item(&pmix_globals.events.multi_events, &evhdlr->super);
+            pmix_globals.events.reindex = true;
             for (n=0; n < evhdlr->ncodes; n++) {
                 /* see if this is the last registration we have for this code */
                 PMIX_LIST_FOREACH(active, &pmix_globals.events.actives, pmix_active_code_t) {
@@ -0,0 +1,549 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <pmix_common.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+#ifdef __linux__
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include "src/atomics/sys/atomic.h"
+#include "src/class/pmix_list.h"
+#include "src/threads/threads.h"
+#include "src/util/error.h"
+#include "src/util/output.h"
+#include "src/util/pmix_environ.h"
+#include "src/client/pmix_client_ops.h"
+#include "src/server/pmix_server_ops.h"
+
+#include "src/event/pmix_event_ring.h"
+
+#define PMIX_EVENT_RING_MAGIC   0x504d4552   // "PMER"
+
+/* the ring starts with this header - the slots follow it, each
+ * one a slot header, its reader bitmap and then the payload */
+typedef struct {
+    uint32_t magic;
+    uint32_t nslots;
+    uint32_t slot_size;         // bytes of payload a slot can hold
+    uint32_t nwords;            // 64-bit words in each reader bitmap
+    uint64_t stride;            // bytes between the start of two slots
+    volatile uint32_t wake;     // bumped on every publish - readers sleep on it
+    uint32_t pad;
+    volatile uint64_t head;     // #entries published
+} pmix_event_ring_hdr_t;
+
+typedef struct {
+    volatile uint64_t seq;      // entry number + 1, or 0 while being written
+    uint64_t len;
+} pmix_event_ring_slot_t;
+
+#define PMIX_EVENT_RING_ALIGN(x)    (((x) + 63) & ~((size_t)63))
+
+#define PMIX_EVENT_RING_SLOT(h, n)                                      \
+    ((pmix_event_ring_slot_t*)((char*)(h) +                             \
+                               PMIX_EVENT_RING_ALIGN(sizeof(pmix_event_ring_hdr_t)) + \
+                               ((n) % (h)->nslots) * (h)->stride))
+
+#define PMIX_EVENT_RING_READERS(s)  ((volatile uint64_t*)((s) + 1))
+
+#define PMIX_EVENT_RING_PAYLOAD(h, s) \
+    ((char*)(PMIX_EVENT_RING_READERS(s) + (h)->nwords))
+
+/* a reader index given to a local client */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_proc_t proc;
+    int idx;
+} pmix_event_ring_reader_t;
+static PMIX_CLASS_INSTANCE(pmix_event_ring_reader_t,
+                           pmix_list_item_t,
+                           NULL, NULL);
+
+/* an entry handed to the progress thread */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_buffer_t *buf;
+} pmix_event_ring_caddy_t;
+static PMIX_CLASS_INSTANCE(pmix_event_ring_caddy_t,
+                           pmix_object_t,
+                           NULL, NULL);
+
+static struct {
+    pmix_event_ring_hdr_t *hdr;
+    size_t size;
+    char *path;
+    /* server side - the index tracking is touched by setup_fork
+     * from the host's thread, so it has its own lock */
+    pmix_mutex_t lock;
+    pmix_bitmap_t assigned;
+    pmix_list_t readers;
+    /* client side */
+    int idx;
+    uint64_t next;
+    volatile bool active;
+    pmix_thread_t engine;
+    pmix_ptl_cbfunc_t cbfunc;
+} ring = {
+    .hdr = NULL,
+    .size = 0,
+    .path = NULL,
+    .idx = -1
+};
+
+static void ring_wake(void)
+{
+#ifdef __linux__
+    (void)syscall(SYS_futex, &ring.hdr->wake, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+static void ring_wait(uint32_t seen)
+{
+#ifdef __linux__
+    struct timespec ts = {1, 0};
+    /* returns at once if the ring moved since we looked - the timeout
+     * only bounds how long a detach has to wait for us */
+    (void)syscall(SYS_futex, &ring.hdr->wake, FUTEX_WAIT, seen, &ts, NULL, 0);
+#else
+    (void)seen;
+    usleep(1000);
+#endif
+}
+
+/****    SERVER    ****/
+
+pmix_status_t pmix_event_ring_create(void)
+{
+    pmix_event_ring_hdr_t *hdr;
+    uint32_t nwords;
+    size_t stride, size;
+    int fd;
+
+    if (0 >= pmix_server_globals.event_ring_slots ||
+        0 >= pmix_server_globals.event_ring_slot_size ||
+        0 >= pmix_server_globals.event_ring_readers ||
+        NULL == pmix_server_globals.tmpdir) {
+        return PMIX_SUCCESS;
+    }
+
+    nwords = (pmix_server_globals.event_ring_readers + 63) / 64;
+    stride = PMIX_EVENT_RING_ALIGN(sizeof(pmix_event_ring_slot_t) +
+                                   nwords * sizeof(uint64_t) +
+                                   pmix_server_globals.event_ring_slot_size);
+    size = PMIX_EVENT_RING_ALIGN(sizeof(pmix_event_ring_hdr_t)) +
+           (size_t)pmix_server_globals.event_ring_slots * stride;
+
+    if (0 > asprintf(&ring.path, "%s/pmix_evring.%lu",
+                     pmix_server_globals.tmpdir, (unsigned long)getpid())) {
+        ring.path = NULL;
+        return PMIX_ERR_NOMEM;
+    }
+    fd = open(ring.path, O_CREAT | O_RDWR | O_TRUNC, 0600);
+    if (0 > fd) {
+        pmix_output_verbose(2, pmix_server_globals.event_output,
+                            "pmix:evring cannot create %s: %s",
+                            ring.path, strerror(errno));
+        free(ring.path);
+        ring.path = NULL;
+        return PMIX_ERR_FILE_OPEN_FAILURE;
+    }
+    if (0 != ftruncate(fd, size)) {
+        close(fd);
+        unlink(ring.path);
+        free(ring.path);
+        ring.path = NULL;
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    hdr = (pmix_event_ring_hdr_t*)mmap(NULL, size, PROT_READ | PROT_WRITE,
+                                       MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == hdr) {
+        unlink(ring.path);
+        free(ring.path);
+        ring.path = NULL;
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    /* the file was just extended, so all slots read as empty */
+    hdr->nslots = pmix_server_globals.event_ring_slots;
+    hdr->slot_size = pmix_server_globals.event_ring_slot_size;
+    hdr->nwords = nwords;
+    hdr->stride = stride;
+    hdr->wake = 0;
+    hdr->head = 0;
+    pmix_atomic_wmb();
+    hdr->magic = PMIX_EVENT_RING_MAGIC;
+
+    ring.hdr = hdr;
+    ring.size = size;
+    PMIX_CONSTRUCT(&ring.lock, pmix_mutex_t);
+    PMIX_CONSTRUCT(&ring.assigned, pmix_bitmap_t);
+    pmix_bitmap_init(&ring.assigned, pmix_server_globals.event_ring_readers);
+    PMIX_CONSTRUCT(&ring.readers, pmix_list_t);
+
+    pmix_output_verbose(2, pmix_server_globals.event_output,
+                        "pmix:evring created %s with %u slots of %u bytes for %d readers",
+                        ring.path, hdr->nslots, hdr->slot_size,
+                        pmix_server_globals.event_ring_readers);
+    return PMIX_SUCCESS;
+}
+
+void pmix_event_ring_destroy(void)
+{
+    if (NULL == ring.hdr) {
+        return;
+    }
+    munmap(ring.hdr, ring.size);
+    ring.hdr = NULL;
+    unlink(ring.path);
+    free(ring.path);
+    ring.path = NULL;
+    PMIX_LIST_DESTRUCT(&ring.readers);
+    PMIX_DESTRUCT(&ring.assigned);
+    PMIX_DESTRUCT(&ring.lock);
+}
+
+static pmix_event_ring_reader_t* find_reader(const pmix_proc_t *proc)
+{
+    pmix_event_ring_reader_t *rd;
+
+    PMIX_LIST_FOREACH(rd, &ring.readers, pmix_event_ring_reader_t) {
+        if (PMIX_CHECK_PROCID(&rd->proc, proc)) {
+            return rd;
+        }
+    }
+    return NULL;
+}
+
+pmix_status_t pmix_event_ring_setup_fork(const pmix_proc_t *proc, char ***env)
+{
+    pmix_event_ring_reader_t *rd;
+    char *val;
+    int idx;
+    pmix_status_t rc;
+
+    if (NULL == ring.hdr) {
+        return PMIX_SUCCESS;
+    }
+
+    pmix_mutex_lock(&ring.lock);
+    if (NULL == (rd = find_reader(proc))) {
+        if (PMIX_SUCCESS != pmix_bitmap_find_and_set_first_unset_bit(&ring.assigned, &idx)) {
+            pmix_mutex_unlock(&ring.lock);
+            return PMIX_SUCCESS;
+        }
+        if (idx >= pmix_server_globals.event_ring_readers) {
+            /* all reader bits are in use - this one stays on the socket */
+            pmix_bitmap_clear_bit(&ring.assigned, idx);
+            pmix_mutex_unlock(&ring.lock);
+            return PMIX_SUCCESS;
+        }
+        rd = PMIX_NEW(pmix_event_ring_reader_t);
+        PMIX_LOAD_PROCID(&rd->proc, proc->nspace, proc->rank);
+        rd->idx = idx;
+        pmix_list_append(&ring.readers, &rd->super);
+    }
+    idx = rd->idx;
+    pmix_mutex_unlock(&ring.lock);
+
+    if (0 > asprintf(&val, "%s:%d", ring.path, idx)) {
+        return PMIX_ERR_NOMEM;
+    }
+    rc = pmix_setenv(PMIX_EVENT_RING_ENV, val, true, env);
+    free(val);
+    return rc;
+}
+
+void pmix_event_ring_release_reader(const pmix_proc_t *proc)
+{
+    pmix_event_ring_reader_t *rd, *rdnext;
+
+    if (NULL == ring.hdr) {
+        return;
+    }
+    pmix_mutex_lock(&ring.lock);
+    /* a wildcard rank releases the whole nspace */
+    PMIX_LIST_FOREACH_SAFE(rd, rdnext, &ring.readers, pmix_event_ring_reader_t) {
+        if (PMIX_CHECK_PROCID(&rd->proc, proc)) {
+            pmix_bitmap_clear_bit(&ring.assigned, rd->idx);
+            pmix_list_remove_item(&ring.readers, &rd->super);
+            PMIX_RELEASE(rd);
+        }
+    }
+    pmix_mutex_unlock(&ring.lock);
+}
+
+int pmix_event_ring_lookup_reader(const pmix_proc_t *proc)
+{
+    pmix_event_ring_reader_t *rd;
+    int idx = -1;
+
+    if (NULL == ring.hdr) {
+        return -1;
+    }
+    pmix_mutex_lock(&ring.lock);
+    if (NULL != (rd = find_reader(proc))) {
+        idx = rd->idx;
+    }
+    pmix_mutex_unlock(&ring.lock);
+    return idx;
+}
+
+bool pmix_event_ring_fits(size_t size)
+{
+    return (NULL != ring.hdr && size <= ring.hdr->slot_size);
+}
+
+pmix_status_t pmix_event_ring_publish(pmix_buffer_t *bfr,
+                                      pmix_bitmap_t *readers)
+{
+    pmix_event_ring_hdr_t *hdr = ring.hdr;
+    pmix_event_ring_slot_t *slot;
+    volatile uint64_t *bits;
+    uint64_t seq;
+    uint32_t n;
+
+    if (!pmix_event_ring_fits(bfr->bytes_used)) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    seq = hdr->head;
+    slot = PMIX_EVENT_RING_SLOT(hdr, seq);
+
+    /* mark the slot as being rewritten so a reader that is still
+     * copying the entry it held will see the change */
+    slot->seq = 0;
+    pmix_atomic_wmb();
+    slot->len = bfr->bytes_used;
+    bits = PMIX_EVENT_RING_READERS(slot);
+    for (n=0; n < hdr->nwords; n++) {
+        bits[n] = ((int)n < readers->array_size) ? readers->bitmap[n] : 0;
+    }
+    memcpy(PMIX_EVENT_RING_PAYLOAD(hdr, slot), bfr->base_ptr, bfr->bytes_used);
+    pmix_atomic_wmb();
+    slot->seq = seq + 1;
+    pmix_atomic_wmb();
+    hdr->head = seq + 1;
+    hdr->wake++;
+    pmix_atomic_mb();
+    ring_wake();
+
+    return PMIX_SUCCESS;
+}
+
+/****    CLIENT    ****/
+
+static void deliver(int sd, short args, void *cbdata)
+{
+    pmix_event_ring_caddy_t *cd = (pmix_event_ring_caddy_t*)cbdata;
+
+    PMIX_ACQUIRE_OBJECT(cd);
+    if (ring.active && NULL != ring.cbfunc) {
+        ring.cbfunc((struct pmix_peer_t*)pmix_client_globals.myserver,
+                    NULL, cd->buf, NULL);
+    }
+    PMIX_RELEASE(cd->buf);
+    PMIX_RELEASE(cd);
+}
+
+/* try to take the entry at ring.next - returns PMIX_SUCCESS with *buf
+ * set if it was for us, PMIX_SUCCESS with *buf NULL if it was not,
+ * and PMIX_ERR_WOULD_BLOCK if the writer is still filling it */
+static pmix_status_t take_entry(pmix_buffer_t **buf)
+{
+    pmix_event_ring_hdr_t *hdr = ring.hdr;
+    pmix_event_ring_slot_t *slot;
+    uint64_t seq, len, head;
+    bool mine;
+    char *data = NULL;
+
+    *buf = NULL;
+    slot = PMIX_EVENT_RING_SLOT(hdr, ring.next);
+    seq = slot->seq;
+    pmix_atomic_rmb();
+    if (seq != ring.next + 1) {
+        if (seq > ring.next + 1) {
+            /* the writer lapped us - skip to the oldest entry still held */
+            head = hdr->head;
+            pmix_output_verbose(2, pmix_client_globals.event_output,
+                                "pmix:evring overrun - lost %lu events",
+                                (unsigned long)(head - hdr->nslots - ring.next));
+            ring.next = head - hdr->nslots;
+            return PMIX_SUCCESS;
+        }
+        return PMIX_ERR_WOULD_BLOCK;
+    }
+    mine = (0 != (PMIX_EVENT_RING_READERS(slot)[ring.idx / 64] & (1ULL << (ring.idx % 64))));
+    len = slot->len;
+    if (mine && len <= hdr->slot_size) {
+        data = (char*)malloc(len);
+        if (NULL == data) {
+            return PMIX_ERR_NOMEM;
+        }
+        memcpy(data, PMIX_EVENT_RING_PAYLOAD(hdr, slot), len);
+    }
+    /* if the slot was rewritten while we copied, what we hold is torn */
+    pmix_atomic_rmb();
+    if (slot->seq != seq) {
+        free(data);
+        return PMIX_SUCCESS;
+    }
+    ring.next++;
+    if (NULL != data) {
+        *buf = PMIX_NEW(pmix_buffer_t);
+        PMIX_LOAD_BUFFER(pmix_client_globals.myserver, *buf, data, len);
+    }
+    return PMIX_SUCCESS;
+}
+
+static void* reader_thread(pmix_object_t *obj)
+{
+    pmix_event_ring_hdr_t *hdr = ring.hdr;
+    pmix_event_ring_caddy_t *cd;
+    pmix_buffer_t *buf;
+    uint32_t seen;
+    pmix_status_t rc;
+
+    while (ring.active) {
+        seen = hdr->wake;
+        pmix_atomic_rmb();
+        if (ring.next == hdr->head) {
+            ring_wait(seen);
+            continue;
+        }
+        rc = take_entry(&buf);
+        if (PMIX_ERR_WOULD_BLOCK == rc) {
+            sched_yield();
+            continue;
+        }
+        if (NULL != buf) {
+            cd = PMIX_NEW(pmix_event_ring_caddy_t);
+            cd->buf = buf;
+            PMIX_THREADSHIFT(cd, deliver);
+        }
+    }
+    return PMIX_THREAD_CANCELLED;
+}
+
+pmix_status_t pmix_event_ring_attach(pmix_ptl_cbfunc_t cbfunc)
+{
+    pmix_event_ring_hdr_t *hdr;
+    struct stat st;
+    char *path, *ptr;
+    int fd;
+
+    if (NULL != ring.hdr || NULL == (ptr = getenv(PMIX_EVENT_RING_ENV))) {
+        return PMIX_SUCCESS;
+    }
+    path = strdup(ptr);
+    if (NULL == (ptr = strrchr(path, ':'))) {
+        free(path);
+        return PMIX_ERR_BAD_PARAM;
+    }
+    *ptr = '\0';
+    ++ptr;
+    ring.idx = strtol(ptr, NULL, 10);
+
+    fd = open(path, O_RDWR);
+    if (0 > fd) {
+        /* the ring is an optimization - without it we use the socket */
+        pmix_output_verbose(2, pmix_client_globals.event_output,
+                            "pmix:evring cannot open %s: %s", path, strerror(errno));
+        free(path);
+        ring.idx = -1;
+        return PMIX_SUCCESS;
+    }
+    if (0 != fstat(fd, &st) || (size_t)st.st_size < sizeof(pmix_event_ring_hdr_t)) {
+        close(fd);
+        free(path);
+        ring.idx = -1;
+        return PMIX_SUCCESS;
+    }
+    hdr = (pmix_event_ring_hdr_t*)mmap(NULL, st.st_size, PROT_READ | PROT_WRITE,
+                                       MAP_SHARED, fd, 0);
+    close(fd);
+    free(path);
+    if (MAP_FAILED == hdr) {
+        ring.idx = -1;
+        return PMIX_SUCCESS;
+    }
+    if (PMIX_EVENT_RING_MAGIC != hdr->magic ||
+        ring.idx < 0 || (uint32_t)ring.idx >= hdr->nwords * 64) {
+        munmap(hdr, st.st_size);
+        ring.idx = -1;
+        return PMIX_SUCCESS;
+    }
+    pmix_atomic_rmb();
+
+    ring.hdr = hdr;
+    ring.size = st.st_size;
+    ring.cbfunc = cbfunc;
+    /* only what is published from here on is for us - anything older
+     * the server will have sent over the socket */
+    ring.next = hdr->head;
+    ring.active = true;
+    PMIX_CONSTRUCT(&ring.engine, pmix_thread_t);
+    ring.engine.t_run = reader_thread;
+    ring.engine.t_arg = NULL;
+    if (PMIX_SUCCESS != pmix_thread_start(&ring.engine)) {
+        ring.active = false;
+        PMIX_DESTRUCT(&ring.engine);
+        munmap(hdr, st.st_size);
+        ring.hdr = NULL;
+        ring.idx = -1;
+        return PMIX_SUCCESS;
+    }
+
+    pmix_output_verbose(2, pmix_client_globals.event_output,
+                        "pmix:evring attached as reader %d", ring.idx);
+    return PMIX_SUCCESS;
+}
+
+void pmix_event_ring_detach(void)
+{
+    if (NULL == ring.hdr || !ring.active) {
+        return;
+    }
+    ring.active = false;
+    pmix_atomic_mb();
+    /* nudge the reader out of its wait - the server is done
+     * with us, so a spurious wakeup of its other readers is harmless */
+    ring_wake();
+    pmix_thread_join(&ring.engine, NULL);
+    PMIX_DESTRUCT(&ring.engine);
+    munmap(ring.hdr, ring.size);
+    ring.hdr = NULL;
+    ring.idx = -1;
+}
+
+bool pmix_event_ring_attached(void)
+{
+    return ring.active;
+}
@@ -0,0 +1,86 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * Node-local event ring
+ *
+ * A server can publish the notifications it sends to its local
+ * clients into a single shared-memory ring instead of packing and
+ * sending a copy to each of them. The ring has one writer (the
+ * server's progress thread) and any number of readers (one per
+ * local client). Each entry carries the packed notification and a
+ * bitmap of the readers it is meant for, so a job-wide event costs
+ * the server one write no matter how many ranks registered for it.
+ *
+ * Clients learn where the ring is, and which reader bit is theirs,
+ * from the environment given to them by PMIx_server_setup_fork. A
+ * client that attaches tells the server so when it registers for
+ * events - until then, and for tools, notifications continue to be
+ * sent over the socket.
+ */
+
+#ifndef PMIX_EVENT_RING_H
+#define PMIX_EVENT_RING_H
+
+#include <src/include/pmix_config.h>
+
+#include <pmix_common.h>
+#include "src/class/pmix_bitmap.h"
+#include "src/include/pmix_globals.h"
+#include "src/mca/ptl/ptl_types.h"
+
+BEGIN_C_DECLS
+
+/* environment variable giving "<path>:<reader index>" to a client */
+#define PMIX_EVENT_RING_ENV     "PMIX_EVRING"
+
+/* internal key a client includes when it registers for events to say
+ * it is reading the ring */
+#define PMIX_EVENT_RING_READER  "pmix.evring.rdr"
+
+/****    SERVER    ****/
+
+/* create the ring - a no-op unless pmix_server_event_ring_slots is set */
+PMIX_EXPORT pmix_status_t pmix_event_ring_create(void);
+PMIX_EXPORT void pmix_event_ring_destroy(void);
+
+/* assign a reader index to a local client and add the ring's env
+ * variable to its environment. Calling it again for the same proc
+ * reuses the index it was given */
+PMIX_EXPORT pmix_status_t pmix_event_ring_setup_fork(const pmix_proc_t *proc,
+                                                     char ***env);
+PMIX_EXPORT void pmix_event_ring_release_reader(const pmix_proc_t *proc);
+
+/* return the reader index assigned to the proc, or -1 if none */
+PMIX_EXPORT int pmix_event_ring_lookup_reader(const pmix_proc_t *proc);
+
+/* return true if a packed notification of this size can go in the ring */
+PMIX_EXPORT bool pmix_event_ring_fits(size_t size);
+
+/* publish a packed notification for the given readers */
+PMIX_EXPORT pmix_status_t pmix_event_ring_publish(pmix_buffer_t *bfr,
+                                                  pmix_bitmap_t *readers);
+
+/****    CLIENT    ****/
+
+/* attach to the ring given in our environment, if any, and start
+ * the thread that passes entries for us to cbfunc in the progress
+ * thread - the buffer is released once cbfunc returns */
+PMIX_EXPORT pmix_status_t pmix_event_ring_attach(pmix_ptl_cbfunc_t cbfunc);
+PMIX_EXPORT void pmix_event_ring_detach(void);
+
+/* true if we are attached and reading the ring */
+PMIX_EXPORT bool pmix_event_ring_attached(void);
+
+END_C_DECLS
+
+#endif /* PMIX_EVENT_RING_H */
@@ -53,8 +53,17 @@ typedef enum {
 } pmix_hwloc_vm_map_kind_t;
 
 PMIX_EXPORT pmix_status_t pmix_hwloc_get_topology(pmix_info_t *info, size_t ninfo);
+PMIX_EXPORT pmix_status_t pmix_hwloc_load_topology(void);
 PMIX_EXPORT void pmix_hwloc_cleanup(void);
 
+/* compute the relative locality of every pair of local peers
+ * described by the given job info. The result is laid out as
+ * a uint32_t count N, the N local ranks in ascending order, and
+ * then N*N pmix_locality_t values - row i holds the locality
+ * of the i-th rank relative to each of the others */
+PMIX_EXPORT pmix_status_t pmix_hwloc_compute_locality(pmix_info_t info[], size_t ninfo,
+                                                      pmix_byte_object_t *bo);
+
 END_C_DECLS
 
 #endif /* PMIX_HWLOC_INTERNAL_H */
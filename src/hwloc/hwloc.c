@@ -11,6 +11,7 @@
 
 #include <src/include/pmix_config.h>
 #include <pmix_common.h>
+#include <pmix.h>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -29,7 +30,10 @@
 #include <fcntl.h>
 #endif
 
+#include "src/threads/mutex.h"
+#include "src/util/argv.h"
 #include "src/util/error.h"
+#include "src/util/output.h"
 #include "src/util/fd.h"
 #include "src/util/path.h"
 #include "src/mca/bfrops/bfrops_types.h"
@@ -67,7 +71,9 @@ static int enough_space(const char *filename,
                         size_t space_req,
                         uint64_t *space_avail,
                         bool *result);
+static pmix_status_t share_topology(pmix_hwloc_vm_hole_kind_t hole);
 #endif
+static pmix_status_t store_xml(const char *key);
 
 static int set_flags(hwloc_topology_t topo, unsigned int flags)
 {
@@ -82,6 +88,155 @@ static int set_flags(hwloc_topology_t topo, unsigned int flags)
     }
     return PMIX_SUCCESS;
 }
+
+/* export the topology as XML and pass it along to every client */
+static pmix_status_t store_xml(const char *key)
+{
+    pmix_kval_t *kp2;
+    char *xml;
+    int sz;
+    int ret;
+
+#if HWLOC_API_VERSION >= 0x20000
+    if (0 == strcmp(key, PMIX_HWLOC_XML_V1)) {
+        ret = hwloc_topology_export_xmlbuffer(pmix_hwloc_topology, &xml, &sz,
+                                              HWLOC_TOPOLOGY_EXPORT_XML_FLAG_V1);
+    } else {
+        ret = hwloc_topology_export_xmlbuffer(pmix_hwloc_topology, &xml, &sz, 0);
+    }
+#else
+    ret = hwloc_topology_export_xmlbuffer(pmix_hwloc_topology, &xml, &sz);
+#endif
+    if (0 != ret) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    kp2 = PMIX_NEW(pmix_kval_t);
+    if (NULL == kp2) {
+        hwloc_free_xmlbuffer(pmix_hwloc_topology, xml);
+        return PMIX_ERR_NOMEM;
+    }
+    kp2->key = strdup(key);
+    PMIX_VALUE_CREATE(kp2->value, 1);
+    if (NULL == kp2->value) {
+        hwloc_free_xmlbuffer(pmix_hwloc_topology, xml);
+        PMIX_RELEASE(kp2);
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_VALUE_LOAD(kp2->value, xml, PMIX_STRING);
+    hwloc_free_xmlbuffer(pmix_hwloc_topology, xml);
+    pmix_list_append(&pmix_server_globals.gdata, &kp2->super);
+    return PMIX_SUCCESS;
+}
+
+#if HWLOC_API_VERSION >= 0x20000
+static pmix_status_t store_shmem_key(const char *key, void *data, pmix_data_type_t type)
+{
+    pmix_kval_t *kp2;
+
+    kp2 = PMIX_NEW(pmix_kval_t);
+    if (NULL == kp2) {
+        return PMIX_ERR_NOMEM;
+    }
+    kp2->key = strdup(key);
+    PMIX_VALUE_CREATE(kp2->value, 1);
+    if (NULL == kp2->value) {
+        PMIX_RELEASE(kp2);
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_VALUE_LOAD(kp2->value, data, type);
+    pmix_list_append(&pmix_server_globals.gdata, &kp2->super);
+    return PMIX_SUCCESS;
+}
+
+/* write the topology into a shmem segment that clients can adopt.
+ * Neither the hole we are told to use nor the session directory
+ * is guaranteed to work, so walk through the alternatives before
+ * giving up - clients only fall back to parsing XML if every
+ * combination fails */
+static pmix_status_t share_topology(pmix_hwloc_vm_hole_kind_t hole)
+{
+    pmix_hwloc_vm_hole_kind_t holes[] = {
+        hole, VM_HOLE_BIGGEST, VM_HOLE_IN_LIBS,
+        VM_HOLE_BEFORE_STACK, VM_HOLE_AFTER_HEAP
+    };
+    const char *dirs[] = {pmix_server_globals.tmpdir, "/dev/shm"};
+    size_t h, d, k;
+    bool space_available;
+    uint64_t amount_space_avail;
+    pmix_status_t rc;
+
+    /* get the size of the topology shared memory segment */
+    if (0 != hwloc_shmem_topology_get_length(pmix_hwloc_topology, &shmemsize, 0)) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+
+    /* find somewhere to back the segment */
+    for (d=0; d < sizeof(dirs)/sizeof(dirs[0]); d++) {
+        if (NULL == dirs[d]) {
+            continue;
+        }
+        if (0 > asprintf(&shmemfile, "%s/pmix_hwloc.%lu.sm",
+                         dirs[d], (unsigned long)getpid())) {
+            shmemfile = NULL;
+            continue;
+        }
+        space_available = false;
+        if (PMIX_SUCCESS == enough_space(shmemfile, shmemsize,
+                                         &amount_space_avail, &space_available) &&
+            space_available &&
+            0 <= (shmemfd = open(shmemfile, O_CREAT | O_RDWR, 0600))) {
+            break;
+        }
+        free(shmemfile);
+        shmemfile = NULL;
+    }
+    if (NULL == shmemfile) {
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    /* ensure nobody inherits this fd */
+    pmix_fd_set_cloexec(shmemfd);
+
+    /* try each kind of hole until the segment lands in one */
+    rc = PMIX_ERR_NOT_SUPPORTED;
+    for (h=0; h < sizeof(holes)/sizeof(holes[0]); h++) {
+        /* don't retry a kind we already tried */
+        for (k=0; k < h && holes[k] != holes[h]; k++);
+        if (k < h) {
+            continue;
+        }
+        if (PMIX_SUCCESS != find_hole(holes[h], &shmemaddr, shmemsize)) {
+            continue;
+        }
+        if (0 == hwloc_shmem_topology_write(pmix_hwloc_topology, shmemfd, 0,
+                                            (void*)shmemaddr, shmemsize, 0)) {
+            rc = PMIX_SUCCESS;
+            break;
+        }
+        /* the address may have been taken while we looked */
+        if (0 != ftruncate(shmemfd, 0)) {
+            break;
+        }
+    }
+    if (PMIX_SUCCESS != rc) {
+        unlink(shmemfile);
+        free(shmemfile);
+        shmemfile = NULL;
+        close(shmemfd);
+        shmemfd = -1;
+        return rc;
+    }
+
+    /* store the rendezvous info */
+    if (PMIX_SUCCESS != (rc = store_shmem_key(PMIX_HWLOC_SHMEM_FILE, shmemfile, PMIX_STRING)) ||
+        PMIX_SUCCESS != (rc = store_shmem_key(PMIX_HWLOC_SHMEM_ADDR, &shmemaddr, PMIX_SIZE)) ||
+        PMIX_SUCCESS != (rc = store_shmem_key(PMIX_HWLOC_SHMEM_SIZE, &shmemsize, PMIX_SIZE))) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    return PMIX_SUCCESS;
+}
+#endif
 #endif // have_hwloc
 
 pmix_status_t pmix_hwloc_get_topology(pmix_info_t *info, size_t ninfo)
@@ -96,8 +251,7 @@ pmix_status_t pmix_hwloc_get_topology(pmix_info_t *info, size_t ninfo)
     bool share_topo = false;
     bool share_reqd = false;
     pmix_kval_t *kp2;
-    char *xml;
-    int sz;
+    bool xml_given = false;
     pmix_status_t rc;
 #if HWLOC_API_VERSION >= 0x20000
     pmix_hwloc_vm_hole_kind_t hole = VM_HOLE_BIGGEST;
@@ -197,6 +351,7 @@ pmix_status_t pmix_hwloc_get_topology(pmix_info_t *info, size_t ninfo)
                     return rc;
                 }
                 pmix_list_append(&pmix_server_globals.gdata, &kp2->super);
+                xml_given = true;
             }
         } else if (0 == strncmp(info[n].key, PMIX_HWLOC_XML_V2, PMIX_MAX_KEYLEN)) {
             /* if the string pointer is NULL or empty, then they
@@ -247,6 +402,7 @@ pmix_status_t pmix_hwloc_get_topology(pmix_info_t *info, size_t ninfo)
                     return rc;
                 }
                 pmix_list_append(&pmix_server_globals.gdata, &kp2->super);
+                xml_given = true;
             }
         } else if (0 == strncmp(info[n].key, PMIX_TOPOLOGY_FILE, PMIX_MAX_KEYLEN)) {
             if (NULL == info[n].value.data.string) {
@@ -288,6 +444,7 @@ pmix_status_t pmix_hwloc_get_topology(pmix_info_t *info, size_t ninfo)
                     return rc;
                 }
                 pmix_list_append(&pmix_server_globals.gdata, &kp2->super);
+                xml_given = true;
             }
         } else if (0 == strncmp(info[n].key, PMIX_HWLOC_SHARE_TOPO, PMIX_MAX_KEYLEN)) {
             share_topo = PMIX_INFO_TRUE(&info[n]);
@@ -314,45 +471,23 @@ pmix_status_t pmix_hwloc_get_topology(pmix_info_t *info, size_t ninfo)
         }
     }
 
-    if (save_xml_v1) {
-        /* create the XML string */
-#if HWLOC_API_VERSION >= 0x20000
-        if (0 != hwloc_topology_export_xmlbuffer(pmix_hwloc_topology, &xml, &sz, HWLOC_TOPOLOGY_EXPORT_XML_FLAG_V1)) {
-            PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
-            return PMIX_ERR_NOT_SUPPORTED;
-        }
-#else
-        if (0 != hwloc_topology_export_xmlbuffer(pmix_hwloc_topology, &xml, &sz)) {
-            PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
-            return PMIX_ERR_NOT_SUPPORTED;
+    /* anything we are asked to export needs a topology to export */
+    if ((save_xml_v1 || save_xml_v2 || share_topo) && NULL == pmix_hwloc_topology) {
+        if (PMIX_SUCCESS != (rc = pmix_hwloc_get_topology(NULL, 0))) {
+            return rc;
         }
-#endif
-        /* store it */
-        kp2 = PMIX_NEW(pmix_kval_t);
-        if (NULL == kp2) {
-            return PMIX_ERR_NOMEM;
+    }
+
+    if (save_xml_v1) {
+        if (PMIX_SUCCESS != (rc = store_xml(PMIX_HWLOC_XML_V1))) {
+            return rc;
         }
-        kp2->key = strdup(PMIX_HWLOC_XML_V1);
-        PMIX_VALUE_LOAD(kp2->value, xml, PMIX_STRING);
-        hwloc_free_xmlbuffer(pmix_hwloc_topology, xml);
-        pmix_list_append(&pmix_server_globals.gdata, &kp2->super);
     }
     if (save_xml_v2) {
-        /* create the XML string */
 #if HWLOC_API_VERSION >= 0x20000
-        if (0 != hwloc_topology_export_xmlbuffer(pmix_hwloc_topology, &xml, &sz, 0)) {
-            PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
-            return PMIX_ERR_NOT_SUPPORTED;
-        }
-        /* store it */
-        kp2 = PMIX_NEW(pmix_kval_t);
-        if (NULL == kp2) {
-            return PMIX_ERR_NOMEM;
+        if (PMIX_SUCCESS != (rc = store_xml(PMIX_HWLOC_XML_V2))) {
+            return rc;
         }
-        kp2->key = strdup(PMIX_HWLOC_XML_V1);
-        PMIX_VALUE_LOAD(kp2->value, xml, PMIX_STRING);
-        hwloc_free_xmlbuffer(pmix_hwloc_topology, xml);
-        pmix_list_append(&pmix_server_globals.gdata, &kp2->super);
 #else
         if (save_xml_v2_reqd) {
             PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
@@ -362,138 +497,413 @@ pmix_status_t pmix_hwloc_get_topology(pmix_info_t *info, size_t ninfo)
     }
 
     if (share_topo) {
-#if HWLOC_API_VERSION < 0x20000
-        if (share_reqd) {
-            return PMIX_ERR_NOT_SUPPORTED;
+#if HWLOC_API_VERSION >= 0x20000
+        if (VM_HOLE_NONE != hole) {
+            rc = share_topology(hole);
+        } else {
+            rc = PMIX_ERR_NOT_SUPPORTED;
         }
 #else
-        pmix_status_t rc;
-        bool space_available = false;
-        uint64_t amount_space_avail = 0;
+        rc = PMIX_ERR_NOT_SUPPORTED;
+#endif
+        if (PMIX_SUCCESS != rc) {
+            if (share_reqd) {
+                PMIX_ERROR_LOG(rc);
+                return rc;
+            }
+            /* clients must still never have to discover the topology
+             * on their own - give them the serialized form instead */
+            if (!save_xml_v1 && !save_xml_v2 && !xml_given) {
+#if HWLOC_API_VERSION >= 0x20000
+                rc = store_xml(PMIX_HWLOC_XML_V2);
+#else
+                rc = store_xml(PMIX_HWLOC_XML_V1);
+#endif
+                if (PMIX_SUCCESS != rc) {
+                    return rc;
+                }
+            }
+        }
+    }
 
-        if (VM_HOLE_NONE == hole) {
-            return PMIX_SUCCESS;
+    return PMIX_SUCCESS;
+#else  // PMIX_HAVE_HWLOC
+    return PMIX_SUCCESS;
+#endif
+}
+
+#if PMIX_HAVE_HWLOC
+static char* get_string(const pmix_proc_t *wildcard, const char *key)
+{
+    pmix_info_t optional;
+    pmix_value_t *val = NULL;
+    char *str = NULL;
+
+    PMIX_INFO_LOAD(&optional, PMIX_OPTIONAL, NULL, PMIX_BOOL);
+    if (PMIX_SUCCESS == PMIx_Get(wildcard, key, &optional, 1, &val)) {
+        if (PMIX_STRING == val->type && NULL != val->data.string) {
+            str = strdup(val->data.string);
         }
+        PMIX_VALUE_RELEASE(val);
+    }
+    PMIX_INFO_DESTRUCT(&optional);
+    return str;
+}
 
-        /* get the size of the topology shared memory segment */
-        if (0 != hwloc_shmem_topology_get_length(pmix_hwloc_topology, &shmemsize, 0)) {
-            if (share_reqd) {
-                PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
-                return PMIX_ERR_NOT_SUPPORTED;
-            }
-            return PMIX_SUCCESS;
+#if HWLOC_API_VERSION >= 0x20000
+static bool adopt_shmem(const pmix_proc_t *wildcard)
+{
+    pmix_info_t optional;
+    pmix_value_t *val;
+    char *file;
+    size_t addr = 0, size = 0;
+    int fd;
+    bool adopted = false;
+
+    if (NULL == (file = get_string(wildcard, PMIX_HWLOC_SHMEM_FILE))) {
+        return false;
+    }
+    PMIX_INFO_LOAD(&optional, PMIX_OPTIONAL, NULL, PMIX_BOOL);
+    val = NULL;
+    if (PMIX_SUCCESS == PMIx_Get(wildcard, PMIX_HWLOC_SHMEM_ADDR, &optional, 1, &val)) {
+        if (PMIX_SIZE == val->type) {
+            addr = val->data.size;
+        }
+        PMIX_VALUE_RELEASE(val);
+    }
+    val = NULL;
+    if (PMIX_SUCCESS == PMIx_Get(wildcard, PMIX_HWLOC_SHMEM_SIZE, &optional, 1, &val)) {
+        if (PMIX_SIZE == val->type) {
+            size = val->data.size;
         }
+        PMIX_VALUE_RELEASE(val);
+    }
+    PMIX_INFO_DESTRUCT(&optional);
 
-        if (PMIX_SUCCESS != (rc = find_hole(hole, &shmemaddr, shmemsize))) {
-            /* we couldn't find a hole, so don't use the shmem support */
-            if (share_reqd) {
-                PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
-                return PMIX_ERR_NOT_SUPPORTED;
-            }
-            return PMIX_SUCCESS;
-        }
-        /* create the shmem file in our session dir so it
-         * will automatically get cleaned up */
-        asprintf(&shmemfile, "%s/hwloc.sm", pmix_server_globals.tmpdir);
-        /* let's make sure we have enough space for the backing file */
-        if (PMIX_SUCCESS != (rc = enough_space(shmemfile, shmemsize,
-                                               &amount_space_avail,
-                                               &space_available))) {
-            free(shmemfile);
-            shmemfile = NULL;
-            if (share_reqd) {
-                PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
-                return PMIX_ERR_NOT_SUPPORTED;
-            } else {
-                return PMIX_SUCCESS;
-            }
+    if (0 != addr && 0 != size &&
+        0 <= (fd = open(file, O_RDONLY))) {
+        /* the mapping outlives the fd */
+        if (0 == hwloc_shmem_topology_adopt(&pmix_hwloc_topology, fd, 0,
+                                            (void*)addr, size, 0)) {
+            adopted = true;
+        } else {
+            pmix_hwloc_topology = NULL;
         }
-        if (!space_available) {
-            free(shmemfile);
-            shmemfile = NULL;
-            if (share_reqd) {
-                PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
-                return PMIX_ERR_NOT_SUPPORTED;
-            } else {
-                return PMIX_SUCCESS;
-            }
+        close(fd);
+    }
+    free(file);
+    return adopted;
+}
+#endif
+
+static bool load_xml(const char *xml, bool isfile)
+{
+    int ret;
+
+    if (0 != hwloc_topology_init(&pmix_hwloc_topology)) {
+        pmix_hwloc_topology = NULL;
+        return false;
+    }
+    if (isfile) {
+        ret = hwloc_topology_set_xml(pmix_hwloc_topology, xml);
+    } else {
+        ret = hwloc_topology_set_xmlbuffer(pmix_hwloc_topology, xml, strlen(xml));
+    }
+    if (0 != ret ||
+        0 != set_flags(pmix_hwloc_topology, HWLOC_TOPOLOGY_FLAG_IS_THISSYSTEM) ||
+        0 != hwloc_topology_load(pmix_hwloc_topology)) {
+        hwloc_topology_destroy(pmix_hwloc_topology);
+        pmix_hwloc_topology = NULL;
+        return false;
+    }
+    return true;
+}
+#endif
+
+/* give a client the topology its server published, trying the
+ * cheapest representation first. Discovery is only done when the
+ * server published nothing we can use */
+pmix_status_t pmix_hwloc_load_topology(void)
+{
+#if PMIX_HAVE_HWLOC
+    static pmix_mutex_t loadlock = PMIX_MUTEX_STATIC_INIT;
+    pmix_proc_t wildcard;
+    const char *keys[] = {
+#if HWLOC_API_VERSION >= 0x20000
+        PMIX_HWLOC_XML_V2,
+#endif
+        PMIX_HWLOC_XML_V1, PMIX_TOPOLOGY_FILE
+    };
+    size_t n;
+    char *xml;
+    bool loaded = false;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    pmix_mutex_lock(&loadlock);
+    if (NULL != pmix_hwloc_topology) {
+        pmix_mutex_unlock(&loadlock);
+        return PMIX_SUCCESS;
+    }
+    PMIX_LOAD_PROCID(&wildcard, pmix_globals.myid.nspace, PMIX_RANK_WILDCARD);
+
+#if HWLOC_API_VERSION >= 0x20000
+    loaded = adopt_shmem(&wildcard);
+#endif
+    for (n=0; !loaded && n < sizeof(keys)/sizeof(keys[0]); n++) {
+        if (NULL != (xml = get_string(&wildcard, keys[n]))) {
+            loaded = load_xml(xml, 0 == strcmp(keys[n], PMIX_TOPOLOGY_FILE));
+            free(xml);
         }
-        /* enough space is available, so create the segment */
-        if (-1 == (shmemfd = open(shmemfile, O_CREAT | O_RDWR, 0600))) {
-            free(shmemfile);
-            shmemfile = NULL;
-            if (share_reqd) {
-                PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
-                return PMIX_ERR_NOT_SUPPORTED;
-            } else {
-                return PMIX_SUCCESS;
-            }
+    }
+    if (!loaded) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                            "hwloc: no usable topology published - discovering");
+        rc = pmix_hwloc_get_topology(NULL, 0);
+    }
+    pmix_mutex_unlock(&loadlock);
+    return rc;
+#else
+    return PMIX_ERR_NOT_SUPPORTED;
+#endif
+}
+
+#if PMIX_HAVE_HWLOC
+typedef struct {
+    pmix_rank_t rank;
+    hwloc_bitmap_t cpuset;      // NULL if the proc isn't bound
+} locpeer_t;
+
+/* topology levels checked for sharing, from the widest down */
+#define PMIX_HWLOC_NLEVELS  7
+static const pmix_locality_t level_flags[PMIX_HWLOC_NLEVELS] = {
+    PMIX_LOCALITY_SHARE_NUMA,
+    PMIX_LOCALITY_SHARE_PACKAGE,
+    PMIX_LOCALITY_SHARE_L3CACHE,
+    PMIX_LOCALITY_SHARE_L2CACHE,
+    PMIX_LOCALITY_SHARE_L1CACHE,
+    PMIX_LOCALITY_SHARE_CORE,
+    PMIX_LOCALITY_SHARE_HWTHREAD
+};
+
+static int level_depth(int lvl)
+{
+#if HWLOC_API_VERSION >= 0x20000
+    static const hwloc_obj_type_t types[PMIX_HWLOC_NLEVELS] = {
+        HWLOC_OBJ_NUMANODE, HWLOC_OBJ_PACKAGE, HWLOC_OBJ_L3CACHE,
+        HWLOC_OBJ_L2CACHE, HWLOC_OBJ_L1CACHE, HWLOC_OBJ_CORE, HWLOC_OBJ_PU
+    };
+    return hwloc_get_type_depth(pmix_hwloc_topology, types[lvl]);
+#else
+    switch (lvl) {
+        case 0:
+            return hwloc_get_type_depth(pmix_hwloc_topology, HWLOC_OBJ_NUMANODE);
+        case 1:
+            return hwloc_get_type_depth(pmix_hwloc_topology, HWLOC_OBJ_PACKAGE);
+        case 2:
+        case 3:
+        case 4:
+            /* levels 2-4 are the L3, L2 and L1 caches */
+            return hwloc_get_cache_type_depth(pmix_hwloc_topology, 5 - lvl,
+                                              (hwloc_obj_cache_type_t)-1);
+        case 5:
+            return hwloc_get_type_depth(pmix_hwloc_topology, HWLOC_OBJ_CORE);
+        default:
+            return hwloc_get_type_depth(pmix_hwloc_topology, HWLOC_OBJ_PU);
+    }
+#endif
+}
+
+static int locpeer_cmp(const void *a, const void *b)
+{
+    const locpeer_t *pa = (const locpeer_t*)a;
+    const locpeer_t *pb = (const locpeer_t*)b;
+
+    if (pa->rank < pb->rank) {
+        return -1;
+    }
+    return (pa->rank > pb->rank) ? 1 : 0;
+}
+
+/* find the cpuset given for a rank in its proc data */
+static const char* proc_cpuset(pmix_info_t info[], size_t ninfo, pmix_rank_t rank)
+{
+    pmix_info_t *iptr;
+    size_t n, m, size;
+
+    for (n=0; n < ninfo; n++) {
+        if (!PMIX_CHECK_KEY(&info[n], PMIX_PROC_DATA) ||
+            PMIX_DATA_ARRAY != info[n].value.type ||
+            NULL == info[n].value.data.darray) {
+            continue;
         }
-        /* ensure nobody inherits this fd */
-        pmix_fd_set_cloexec(shmemfd);
-        /* populate the shmem segment with the topology */
-        if (0 != (rc = hwloc_shmem_topology_write(pmix_hwloc_topology, shmemfd, 0,
-                                                  (void*)shmemaddr, shmemsize, 0))) {
-            unlink(shmemfile);
-            free(shmemfile);
-            shmemfile = NULL;
-            close(shmemfd);
-            shmemfd = -1;
-            if (share_reqd) {
-                PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
-                return PMIX_ERR_NOT_SUPPORTED;
-            } else {
-                return PMIX_SUCCESS;
+        iptr = (pmix_info_t*)info[n].value.data.darray->array;
+        size = info[n].value.data.darray->size;
+        /* the first element is always the rank */
+        if (0 == size || PMIX_PROC_RANK != iptr[0].value.type ||
+            rank != iptr[0].value.data.rank) {
+            continue;
+        }
+        for (m=1; m < size; m++) {
+            if (PMIX_CHECK_KEY(&iptr[m], PMIX_CPUSET) &&
+                PMIX_STRING == iptr[m].value.type) {
+                return iptr[m].value.data.string;
             }
         }
-        /* store the rendezvous info */
-        kp2 = PMIX_NEW(pmix_kval_t);
-        if (NULL == kp2) {
-            return PMIX_ERR_NOMEM;
+        return NULL;
+    }
+    return NULL;
+}
+#endif
+
+pmix_status_t pmix_hwloc_compute_locality(pmix_info_t info[], size_t ninfo,
+                                          pmix_byte_object_t *bo)
+{
+#if PMIX_HAVE_HWLOC
+    char **peers = NULL, **cpus = NULL;
+    const char *cpustr;
+    locpeer_t *lp = NULL;
+    hwloc_bitmap_t *objs = NULL;
+    hwloc_obj_t obj;
+    pmix_rank_t *ranks;
+    pmix_locality_t *mat, loc;
+    uint32_t npeers = 0, i, j;
+    size_t n;
+    int lvl, depth, k, nobjs;
+    bool bound = false;
+    pmix_status_t rc = PMIX_ERR_NOT_FOUND;
+
+    bo->bytes = NULL;
+    bo->size = 0;
+
+    for (n=0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_LOCAL_PEERS) &&
+            PMIX_STRING == info[n].value.type) {
+            peers = pmix_argv_split(info[n].value.data.string, ',');
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_LOCAL_CPUSETS) &&
+                   PMIX_STRING == info[n].value.type) {
+            cpus = pmix_argv_split(info[n].value.data.string, ':');
         }
-        kp2->key = strdup(PMIX_HWLOC_SHMEM_FILE);
-        PMIX_VALUE_CREATE(kp2->value, 1);
-        PMIX_VALUE_LOAD(kp2->value, shmemfile, PMIX_STRING);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(kp2);
-            return rc;
+    }
+    if (NULL == peers || 0 == (npeers = pmix_argv_count(peers))) {
+        goto cleanup;
+    }
+    /* the cpusets string only helps if it lines up with the peers */
+    if (NULL != cpus && pmix_argv_count(cpus) != (int)npeers) {
+        pmix_argv_free(cpus);
+        cpus = NULL;
+    }
+
+    if (NULL == (lp = (locpeer_t*)calloc(npeers, sizeof(locpeer_t)))) {
+        rc = PMIX_ERR_NOMEM;
+        goto cleanup;
+    }
+    for (i=0; i < npeers; i++) {
+        lp[i].rank = strtoul(peers[i], NULL, 10);
+        if (NULL != cpus) {
+            cpustr = cpus[i];
+        } else {
+            cpustr = proc_cpuset(info, ninfo, lp[i].rank);
         }
-        pmix_list_append(&pmix_server_globals.gdata, &kp2->super);
-        kp2 = PMIX_NEW(pmix_kval_t);
-        if (NULL == kp2) {
-            return PMIX_ERR_NOMEM;
+        if (NULL == cpustr || '\0' == *cpustr) {
+            continue;
         }
-        kp2->key = strdup(PMIX_HWLOC_SHMEM_ADDR);
-        PMIX_VALUE_CREATE(kp2->value, 1);
-        PMIX_VALUE_LOAD(kp2->value, &shmemaddr, PMIX_SIZE);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(kp2);
-            return rc;
+        lp[i].cpuset = hwloc_bitmap_alloc();
+        if (0 != hwloc_bitmap_list_sscanf(lp[i].cpuset, cpustr)) {
+            hwloc_bitmap_free(lp[i].cpuset);
+            lp[i].cpuset = NULL;
+            continue;
         }
-        pmix_list_append(&pmix_server_globals.gdata, &kp2->super);
-        kp2 = PMIX_NEW(pmix_kval_t);
-        if (NULL == kp2) {
-            return PMIX_ERR_NOMEM;
+        bound = true;
+    }
+    /* nothing to compute from */
+    if (!bound) {
+        goto cleanup;
+    }
+    if (NULL == pmix_hwloc_topology &&
+        PMIX_SUCCESS != (rc = pmix_hwloc_get_topology(NULL, 0))) {
+        goto cleanup;
+    }
+    qsort(lp, npeers, sizeof(locpeer_t), locpeer_cmp);
+
+    /* record the objects each proc touches at every level so
+     * that each pair only costs one intersection per level */
+    objs = (hwloc_bitmap_t*)calloc(npeers * PMIX_HWLOC_NLEVELS, sizeof(hwloc_bitmap_t));
+    if (NULL == objs) {
+        rc = PMIX_ERR_NOMEM;
+        goto cleanup;
+    }
+    for (lvl=0; lvl < PMIX_HWLOC_NLEVELS; lvl++) {
+        depth = level_depth(lvl);
+        if (HWLOC_TYPE_DEPTH_UNKNOWN == depth ||
+            HWLOC_TYPE_DEPTH_MULTIPLE == depth) {
+            continue;
         }
-        kp2->key = strdup(PMIX_HWLOC_SHMEM_SIZE);
-        PMIX_VALUE_CREATE(kp2->value, 1);
-        PMIX_VALUE_LOAD(kp2->value, &shmemsize, PMIX_SIZE);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(kp2);
-            return rc;
+        nobjs = hwloc_get_nbobjs_by_depth(pmix_hwloc_topology, depth);
+        for (i=0; i < npeers; i++) {
+            if (NULL == lp[i].cpuset) {
+                continue;
+            }
+            objs[i*PMIX_HWLOC_NLEVELS+lvl] = hwloc_bitmap_alloc();
+            for (k=0; k < nobjs; k++) {
+                obj = hwloc_get_obj_by_depth(pmix_hwloc_topology, depth, k);
+                if (NULL != obj && NULL != obj->cpuset &&
+                    hwloc_bitmap_intersects(obj->cpuset, lp[i].cpuset)) {
+                    hwloc_bitmap_set(objs[i*PMIX_HWLOC_NLEVELS+lvl], k);
+                }
+            }
         }
-        pmix_list_append(&pmix_server_globals.gdata, &kp2->super);
-
+    }
 
-#endif
+    bo->size = sizeof(uint32_t) + npeers * sizeof(pmix_rank_t) +
+               (size_t)npeers * npeers * sizeof(pmix_locality_t);
+    if (NULL == (bo->bytes = (char*)malloc(bo->size))) {
+        bo->size = 0;
+        rc = PMIX_ERR_NOMEM;
+        goto cleanup;
     }
+    memcpy(bo->bytes, &npeers, sizeof(uint32_t));
+    ranks = (pmix_rank_t*)(bo->bytes + sizeof(uint32_t));
+    mat = (pmix_locality_t*)(ranks + npeers);
+    for (i=0; i < npeers; i++) {
+        ranks[i] = lp[i].rank;
+        for (j=i; j < npeers; j++) {
+            loc = PMIX_LOCALITY_SHARE_NODE;
+            for (lvl=0; lvl < PMIX_HWLOC_NLEVELS; lvl++) {
+                if (NULL != objs[i*PMIX_HWLOC_NLEVELS+lvl] &&
+                    NULL != objs[j*PMIX_HWLOC_NLEVELS+lvl] &&
+                    hwloc_bitmap_intersects(objs[i*PMIX_HWLOC_NLEVELS+lvl],
+                                            objs[j*PMIX_HWLOC_NLEVELS+lvl])) {
+                    loc |= level_flags[lvl];
+                }
+            }
+            mat[i*npeers+j] = loc;
+            mat[j*npeers+i] = loc;
+        }
+    }
+    rc = PMIX_SUCCESS;
 
-    return PMIX_SUCCESS;
-#else  // PMIX_HAVE_HWLOC
-    return PMIX_SUCCESS;
+  cleanup:
+    if (NULL != objs) {
+        for (i=0; i < npeers * PMIX_HWLOC_NLEVELS; i++) {
+            if (NULL != objs[i]) {
+                hwloc_bitmap_free(objs[i]);
+            }
+        }
+        free(objs);
+    }
+    if (NULL != lp) {
+        for (i=0; i < npeers; i++) {
+            if (NULL != lp[i].cpuset) {
+                hwloc_bitmap_free(lp[i].cpuset);
+            }
+        }
+        free(lp);
+    }
+    pmix_argv_free(peers);
+    pmix_argv_free(cpus);
+    return rc;
+#else
+    return PMIX_ERR_NOT_SUPPORTED;
 #endif
 }
 
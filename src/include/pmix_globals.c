@@ -41,6 +41,7 @@
 #endif /* HAVE_SYS_STAT_H */
 #ifdef HAVE_DIRENT_H
 #include <dirent.h>
+#include <time.h>
 #endif  /* HAVE_DIRENT_H */
 
 #include <pmix_common.h>
@@ -99,6 +100,7 @@ PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_cleanup_dir_t,
 static void nscon(pmix_namespace_t *p)
 {
     p->nspace = NULL;
+    p->id = PMIX_NSID_INVALID;
     p->nprocs = 0;
     p->nlocalprocs = 0;
     p->all_registered = false;
@@ -107,11 +109,20 @@ static void nscon(pmix_namespace_t *p)
     p->ndelivered = 0;
     p->nfinalized = 0;
     PMIX_CONSTRUCT(&p->ranks, pmix_list_t);
+    PMIX_CONSTRUCT(&p->rankidx, pmix_hash_table_t);
+    pmix_hash_table_init(&p->rankidx, 16);
     memset(&p->compat, 0, sizeof(p->compat));
     PMIX_CONSTRUCT(&p->epilog.cleanup_dirs, pmix_list_t);
     PMIX_CONSTRUCT(&p->epilog.cleanup_files, pmix_list_t);
     PMIX_CONSTRUCT(&p->epilog.ignores, pmix_list_t);
     PMIX_CONSTRUCT(&p->setup_data, pmix_list_t);
+    PMIX_CONSTRUCT(&p->dmdxmiss, pmix_bitmap_t);
+    PMIX_CONSTRUCT(&p->mdxpart, pmix_bitmap_t);
+    p->fork_env = NULL;
+    p->gds_modes = NULL;
+    p->jobgen = 0;
+    p->ptable = NULL;
+    p->nptable = 0;
 }
 static void nsdes(pmix_namespace_t *p)
 {
@@ -121,6 +132,7 @@ static void nsdes(pmix_namespace_t *p)
     if (NULL != p->jobbkt) {
         PMIX_RELEASE(p->jobbkt);
     }
+    PMIX_DESTRUCT(&p->rankidx);
     PMIX_LIST_DESTRUCT(&p->ranks);
     /* perform any epilog */
     pmix_execute_epilog(&p->epilog);
@@ -129,6 +141,17 @@ static void nsdes(pmix_namespace_t *p)
     PMIX_LIST_DESTRUCT(&p->epilog.cleanup_files);
     PMIX_LIST_DESTRUCT(&p->epilog.ignores);
     PMIX_LIST_DESTRUCT(&p->setup_data);
+    PMIX_DESTRUCT(&p->dmdxmiss);
+    PMIX_DESTRUCT(&p->mdxpart);
+    if (NULL != p->fork_env) {
+        pmix_argv_free(p->fork_env);
+    }
+    if (NULL != p->gds_modes) {
+        free(p->gds_modes);
+    }
+    if (NULL != p->ptable) {
+        PMIX_PROC_INFO_FREE(p->ptable, p->nptable);
+    }
 }
 PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_namespace_t,
                                 pmix_list_item_t,
@@ -155,7 +178,9 @@ static void info_con(pmix_rank_info_t *info)
     info->pname.nspace = NULL;
     info->pname.rank = PMIX_RANK_UNDEF;
     info->modex_recvd = false;
+    PMIX_BYTE_OBJECT_CONSTRUCT(&info->modex);
     info->proc_cnt = 0;
+    info->pid = 0;
     info->server_object = NULL;
 }
 static void info_des(pmix_rank_info_t *info)
@@ -163,6 +188,7 @@ static void info_des(pmix_rank_info_t *info)
     if (NULL != info->pname.nspace) {
         free(info->pname.nspace);
     }
+    PMIX_BYTE_OBJECT_DESTRUCT(&info->modex);
 }
 PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_rank_info_t,
                                 pmix_list_item_t,
@@ -183,6 +209,17 @@ static void pcon(pmix_peer_t *p)
     p->send_msg = NULL;
     p->recv_msg = NULL;
     p->commit_cnt = 0;
+    p->msgs_sent = 0;
+    p->msgs_recvd = 0;
+    p->bytes_sent = 0;
+    p->bytes_recvd = 0;
+    p->queued_bytes = 0;
+    p->queued_hwm = 0;
+    p->msgs_dropped = 0;
+    p->cnct_ns = NULL;
+    p->evring_idx = -1;
+    PMIX_CONSTRUCT(&p->collectives, pmix_list_t);
+    PMIX_CONSTRUCT(&p->evregs, pmix_list_t);
     PMIX_CONSTRUCT(&p->epilog.cleanup_dirs, pmix_list_t);
     PMIX_CONSTRUCT(&p->epilog.cleanup_files, pmix_list_t);
     PMIX_CONSTRUCT(&p->epilog.ignores, pmix_list_t);
@@ -212,6 +249,11 @@ static void pdes(pmix_peer_t *p)
     if (NULL != p->recv_msg) {
         PMIX_RELEASE(p->recv_msg);
     }
+    if (NULL != p->cnct_ns) {
+        pmix_argv_free(p->cnct_ns);
+    }
+    PMIX_LIST_DESTRUCT(&p->collectives);
+    PMIX_LIST_DESTRUCT(&p->evregs);
     /* perform any epilog */
     pmix_execute_epilog(&p->epilog);
     /* cleanup the epilog */
@@ -226,6 +268,14 @@ PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_peer_t,
                                 pmix_object_t,
                                 pcon, pdes);
 
+static void prefcon(pmix_peer_ref_t *p)
+{
+    p->member = NULL;
+}
+PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_peer_ref_t,
+                                pmix_list_item_t,
+                                prefcon, NULL);
+
 static void iofreqcon(pmix_iof_req_t *p)
 {
     p->peer = NULL;
@@ -305,12 +355,13 @@ static void cbcon(pmix_cb_t *p)
     p->nvals = 0;
     PMIX_CONSTRUCT(&p->kvs, pmix_list_t);
     p->copy = false;
+    memset(&p->timer, 0, sizeof(pmix_timer_t));
     p->timer_running = false;
 }
 static void cbdes(pmix_cb_t *p)
 {
     if (p->timer_running) {
-        pmix_event_del(&p->ev);
+        pmix_timer_del(&p->timer);
     }
     if (NULL != p->pname.nspace) {
         free(p->pname.nspace);
@@ -318,9 +369,9 @@ static void cbdes(pmix_cb_t *p)
     PMIX_DESTRUCT(&p->data);
     PMIX_LIST_DESTRUCT(&p->kvs);
 }
-PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_cb_t,
-                                pmix_list_item_t,
-                                cbcon, cbdes);
+PMIX_EXPORT PMIX_CLASS_INSTANCE_CACHED(pmix_cb_t,
+                                       pmix_list_item_t,
+                                       cbcon, cbdes);
 
 PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_info_caddy_t,
                                 pmix_list_item_t,
@@ -421,6 +472,50 @@ void pmix_execute_epilog(pmix_epilog_t *epi)
     }
 }
 
+void pmix_nspace_add_rank(pmix_namespace_t *nptr, pmix_rank_info_t *info)
+{
+    pmix_list_append(&nptr->ranks, &info->super);
+    pmix_hash_table_set_value_uint32(&nptr->rankidx, info->pname.rank, info);
+}
+
+void pmix_nspace_remove_rank(pmix_namespace_t *nptr, pmix_rank_info_t *info)
+{
+    void *ptr;
+
+    pmix_list_remove_item(&nptr->ranks, &info->super);
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&nptr->rankidx, info->pname.rank, &ptr) &&
+        ptr == (void*)info) {
+        pmix_hash_table_remove_value_uint32(&nptr->rankidx, info->pname.rank);
+    }
+}
+
+pmix_rank_info_t* pmix_nspace_find_rank(pmix_namespace_t *nptr, pmix_rank_t rank)
+{
+    void *ptr;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&nptr->rankidx, rank, &ptr)) {
+        return NULL;
+    }
+    return (pmix_rank_info_t*)ptr;
+}
+
+pmix_namespace_t* pmix_nspace_lookup(pmix_list_t *nspaces, const char *nspace)
+{
+    pmix_namespace_t *ns;
+    pmix_nsid_t id;
+
+    /* a name that was never interned can't be on the list */
+    if (PMIX_NSID_INVALID == (id = pmix_nsid_find(nspace))) {
+        return NULL;
+    }
+    PMIX_LIST_FOREACH(ns, nspaces, pmix_namespace_t) {
+        if (id == ns->id) {
+            return ns;
+        }
+    }
+    return NULL;
+}
+
 static void dirpath_destroy(char *path, pmix_cleanup_dir_t *cd, pmix_epilog_t *epi)
 {
     int rc;
@@ -556,3 +651,228 @@ static bool dirpath_is_empty(const char *path )
 
     return true;
 }
+
+/* the queue node overlays the (much larger) pmix_event_t
+ * embedded in the shifted object */
+typedef struct pmix_shift_node_t {
+    struct pmix_shift_node_t *next;
+    void (*cbfunc)(int, short, void*);
+    void *cbdata;
+} pmix_shift_node_t;
+
+static pmix_atomic_intptr_t shift_head = 0;
+static pmix_event_t shift_ev;
+static bool shift_active = false;
+
+static void shift_drain(int sd, short args, void *cbdata)
+{
+    pmix_shift_node_t *batch, *fifo = NULL, *nd, *next;
+    void (*cbfunc)(int, short, void*);
+    void *arg;
+
+    /* take everything queued so far - producers push LIFO, so
+     * reverse the batch to run the shifts in the order posted */
+    batch = (pmix_shift_node_t*)pmix_atomic_swap_ptr(&shift_head, 0);
+    pmix_atomic_rmb();
+    while (NULL != batch) {
+        next = batch->next;
+        batch->next = fifo;
+        fifo = batch;
+        batch = next;
+    }
+
+    for (nd = fifo; NULL != nd; nd = next) {
+        next = nd->next;
+        cbfunc = nd->cbfunc;
+        arg = nd->cbdata;
+        /* leave the event as the callback would have found it
+         * had it been activated directly */
+        pmix_event_assign((pmix_event_t*)nd, pmix_globals.evbase,
+                          -1, EV_WRITE, cbfunc, arg);
+        cbfunc(-1, EV_WRITE, arg);
+    }
+}
+
+void pmix_threadshift(pmix_event_t *ev,
+                      void (*cbfunc)(int, short, void*),
+                      void *cbdata)
+{
+    pmix_shift_node_t *nd = (pmix_shift_node_t*)ev;
+    intptr_t head;
+
+    if (!shift_active) {
+        /* no drain yet - go straight to the event base */
+        pmix_event_assign(ev, pmix_globals.evbase, -1, EV_WRITE, cbfunc, cbdata);
+        pmix_event_active(ev, EV_WRITE, 1);
+        return;
+    }
+
+    nd->cbfunc = cbfunc;
+    nd->cbdata = cbdata;
+    head = shift_head;
+    do {
+        nd->next = (pmix_shift_node_t*)head;
+    } while (!pmix_atomic_compare_exchange_strong_ptr(&shift_head, &head, (intptr_t)nd));
+
+    /* only the push that found the queue empty needs to wake
+     * the progress thread - later pushes ride along */
+    if (0 == head) {
+        pmix_event_active(&shift_ev, EV_WRITE, 1);
+    }
+}
+
+void pmix_threadshift_init(void)
+{
+    if (shift_active) {
+        return;
+    }
+    shift_head = 0;
+    pmix_event_assign(&shift_ev, pmix_globals.evbase, -1, EV_WRITE, shift_drain, NULL);
+    shift_active = true;
+}
+
+void pmix_threadshift_finalize(void)
+{
+    if (!shift_active) {
+        return;
+    }
+    shift_active = false;
+    pmix_event_del(&shift_ev);
+    shift_head = 0;
+}
+
+/* PMIX_TIMEOUT is given in seconds, so a tenth of a second is fine
+ * enough - and one turn of the wheel covers most timeouts without
+ * their having to go round more than once */
+#define PMIX_TIMER_TICK_USEC    100000
+#define PMIX_TIMER_SLOTS        512     // power of two
+
+static pmix_timer_t wheel_slots[PMIX_TIMER_SLOTS];
+static pmix_event_t wheel_ev;
+static bool wheel_running = false;
+static uint64_t wheel_tick = 0;         // last tick processed
+static size_t wheel_armed = 0;
+
+static uint64_t wheel_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000) / PMIX_TIMER_TICK_USEC;
+}
+
+/* slots are circular lists headed by a sentinel */
+static void wheel_link(pmix_timer_t *head, pmix_timer_t *t)
+{
+    if (NULL == head->next) {
+        head->prev = head;
+        head->next = head;
+    }
+    t->prev = head->prev;
+    t->next = head;
+    head->prev->next = t;
+    head->prev = t;
+}
+
+static void wheel_unlink(pmix_timer_t *t)
+{
+    t->prev->next = t->next;
+    t->next->prev = t->prev;
+    t->prev = NULL;
+    t->next = NULL;
+}
+
+static void wheel_turn(int sd, short args, void *cbdata)
+{
+    pmix_timer_t expired, *head, *t, *next;
+    uint64_t now = wheel_now(), last;
+
+    expired.prev = &expired;
+    expired.next = &expired;
+
+    /* visit every slot whose tick has come since the last turn -
+     * if we fell more than a full turn behind, that is all of them */
+    last = wheel_tick + PMIX_TIMER_SLOTS;
+    if (now < last) {
+        last = now;
+    }
+    while (wheel_tick < last) {
+        ++wheel_tick;
+        head = &wheel_slots[wheel_tick & (PMIX_TIMER_SLOTS - 1)];
+        if (NULL == head->next) {
+            continue;
+        }
+        /* timers more than a turn away stay for a later pass */
+        for (t = head->next; t != head; t = next) {
+            next = t->next;
+            if (t->expiry <= now) {
+                wheel_unlink(t);
+                wheel_link(&expired, t);
+            }
+        }
+    }
+    wheel_tick = now;
+
+    /* a callback may cancel any timer still waiting to fire here */
+    while (expired.next != &expired) {
+        t = expired.next;
+        wheel_unlink(t);
+        --wheel_armed;
+        t->cbfunc(-1, EV_TIMEOUT, t->cbdata);
+    }
+
+    if (0 == wheel_armed && wheel_running) {
+        pmix_event_del(&wheel_ev);
+        wheel_running = false;
+    }
+}
+
+void pmix_timer_add(pmix_timer_t *timer,
+                    void (*cbfunc)(int, short, void*),
+                    void *cbdata, const struct timeval *tv)
+{
+    struct timeval tick;
+    uint64_t now, delta;
+
+    pmix_timer_del(timer);
+
+    now = wheel_now();
+    if (!wheel_running) {
+        /* nothing is armed, so there is nothing to catch up on */
+        wheel_tick = now;
+        tick.tv_sec = 0;
+        tick.tv_usec = PMIX_TIMER_TICK_USEC;
+        pmix_event_assign(&wheel_ev, pmix_globals.evbase, -1, EV_PERSIST,
+                          wheel_turn, NULL);
+        pmix_event_add(&wheel_ev, &tick);
+        wheel_running = true;
+    }
+    /* part of the current tick has already gone, so count one
+     * more - otherwise the timer could fire before its time */
+    delta = ((uint64_t)tv->tv_sec * 1000000 + tv->tv_usec +
+             PMIX_TIMER_TICK_USEC - 1) / PMIX_TIMER_TICK_USEC + 1;
+    timer->expiry = now + delta;
+    timer->cbfunc = cbfunc;
+    timer->cbdata = cbdata;
+    wheel_link(&wheel_slots[timer->expiry & (PMIX_TIMER_SLOTS - 1)], timer);
+    ++wheel_armed;
+}
+
+void pmix_timer_del(pmix_timer_t *timer)
+{
+    if (NULL == timer->prev) {
+        return;
+    }
+    wheel_unlink(timer);
+    --wheel_armed;
+}
+
+void pmix_timer_finalize(void)
+{
+    if (wheel_running) {
+        pmix_event_del(&wheel_ev);
+        wheel_running = false;
+    }
+    memset(wheel_slots, 0, sizeof(wheel_slots));
+    wheel_armed = 0;
+}
@@ -34,11 +34,13 @@
 #include <pmix.h>
 #include <pmix_common.h>
 
+#include "src/class/pmix_bitmap.h"
 #include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/class/pmix_hotel.h"
 #include "src/event/pmix_event.h"
 #include "src/threads/threads.h"
+#include "src/util/nsid.h"
 
 #include "src/mca/bfrops/bfrops.h"
 #include "src/mca/gds/gds.h"
@@ -55,6 +57,8 @@ BEGIN_C_DECLS
 #define PMIX_BFROPS_MODULE                  "pmix.bfrops.mod"       // (char*) name of bfrops plugin in-use by a given nspace
 #define PMIX_PNET_SETUP_APP                 "pmix.pnet.setapp"      // (pmix_byte_object_t) blob containing info to be given to
                                                                     //      pnet framework on remote nodes
+#define PMIX_LOCALITY_MATRIX                "pmix.locmat"           // (pmix_byte_object_t) relative locality of every pair of
+                                                                    //      local peers, computed once at nspace registration
 
 #define PMIX_INFO_OP_COMPLETE    0x80000000
 #define PMIX_INFO_OP_COMPLETED(m)            \
@@ -77,6 +81,16 @@ typedef struct {
 } pmix_namelist_t;
 PMIX_CLASS_DECLARATION(pmix_namelist_t);
 
+/* an operation timeout on the shared timer wheel - embed one in
+ * the object being timed. Not armed while prev is NULL */
+typedef struct pmix_timer_t {
+    struct pmix_timer_t *prev;
+    struct pmix_timer_t *next;
+    uint64_t expiry;                // tick at which it fires
+    void (*cbfunc)(int, short, void*);
+    void *cbdata;
+} pmix_timer_t;
+
 /* define a command type for communicating to the
  * pmix server */
 typedef uint8_t pmix_cmd_t;
@@ -111,6 +125,28 @@ typedef uint8_t pmix_cmd_t;
 #define PMIX_GROUP_INVITE_CMD       26
 #define PMIX_GROUP_LEAVE_CMD        27
 #define PMIX_GROUP_DESTRUCT_CMD     28
+#define PMIX_COMMIT_DELTA_CMD       29
+
+/* job-level key a server caches for its clients when it will
+ * merge a PMIX_COMMIT_DELTA_CMD into what they committed before */
+#define PMIX_COMMIT_DELTA_KEY       "pmix.cmt.delta"
+
+/* job-level key a server caches for its clients when it accepts
+ * range-encoded proc sets in fence and [dis]connect requests */
+#define PMIX_PROCSET_RANGES_KEY     "pmix.pset.rng"
+
+/* get directive naming the key a client is after - the server
+ * otherwise returns the whole blob for the proc regardless */
+#define PMIX_GET_REQ_KEY            "pmix.get.rqkey"
+
+/* job-level key naming the server instance and generation of the
+ * job-level info, so a tool can ask for it to be resent only if
+ * it has changed since it last attached */
+#define PMIX_JOB_INFO_TAG_KEY       "pmix.jinfo.tag"
+
+/* IOF pull directive telling the server that the requestor
+ * accepts batched output on PMIX_PTL_TAG_IOF_BATCH */
+#define PMIX_IOF_BATCH_KEY          "pmix.iof.batch"
 
 /* provide a "pretty-print" function for cmds */
 const char* pmix_command_string(pmix_cmd_t cmd);
@@ -124,6 +160,10 @@ typedef enum {
     PMIX_COLLECT_MAX
 } pmix_collect_t;
 
+/* flag OR'd into the collection marker of a fence bucket when the
+ * contributions that follow were compressed as a single block */
+#define PMIX_COLLECT_COMPRESSED     0x80
+
 /****    PEER STRUCTURES    ****/
 
 /* clients can only talk to their server, and servers are
@@ -162,10 +202,19 @@ typedef struct {
 } pmix_cleanup_dir_t;
 PMIX_CLASS_DECLARATION(pmix_cleanup_dir_t);
 
+/* entry on a peer's list of the server structures it has an
+ * entry in, so those can be cleaned up without searching them all */
+typedef struct {
+    pmix_list_item_t super;
+    void *member;                   // the peer's entry in the structure (not retained)
+} pmix_peer_ref_t;
+PMIX_CLASS_DECLARATION(pmix_peer_ref_t);
+
 /* objects used by servers for tracking active nspaces */
 typedef struct {
     pmix_list_item_t super;
     char *nspace;
+    pmix_nsid_t id;              // interned ID of nspace - use pmix_nspace_id
     pmix_rank_t nprocs;          // num procs in this nspace
     size_t nlocalprocs;
     bool all_registered;         // all local ranks have been defined
@@ -174,6 +223,7 @@ typedef struct {
     size_t ndelivered;           // count of #local clients that have received the jobinfo
     size_t nfinalized;           // count of #local clients that have finalized
     pmix_list_t ranks;           // list of pmix_rank_info_t for connection support of my clients
+    pmix_hash_table_t rankidx;   // index of ranks by rank
     /* all members of an nspace are required to have the
      * same personality, but it can differ between nspaces.
      * Since servers may support clients from multiple nspaces,
@@ -183,6 +233,13 @@ typedef struct {
                                 // from this nspace
     pmix_list_t setup_data;     // list of pmix_kval_t containing info structs having blobs
                                 // for setting up the local node for this nspace/application
+    pmix_bitmap_t dmdxmiss;     // ranks whose data the host reported as not found
+    pmix_bitmap_t mdxpart;      // remote ranks for which a fence collected only some keys
+    char **fork_env;            // envars given to every local child of this nspace
+    char *gds_modes;            // gds modules offered to this nspace's clients (NULL => all)
+    uint32_t jobgen;            // bumped each time the job-level info is (re)stored
+    pmix_proc_info_t *ptable;   // proc table of our local clients, built on first query
+    size_t nptable;
 } pmix_namespace_t;
 PMIX_CLASS_DECLARATION(pmix_namespace_t);
 
@@ -201,7 +258,9 @@ typedef struct pmix_rank_info_t {
     uid_t uid;
     gid_t gid;
     bool modex_recvd;
+    pmix_byte_object_t modex;   // pre-packed remote/global contribution to collectives
     int proc_cnt;              // #clones of this rank we know about
+    pid_t pid;                  // pid of the client as seen when it connected
     void *server_object;       // pointer to rank-specific object provided by server
 } pmix_rank_info_t;
 PMIX_CLASS_DECLARATION(pmix_rank_info_t);
@@ -240,6 +299,17 @@ typedef struct pmix_peer_t {
     pmix_ptl_send_t *send_msg;      /**< current send in progress */
     pmix_ptl_recv_t *recv_msg;      /**< current recv in progress */
     int commit_cnt;
+    uint64_t msgs_sent;             // messages queued to this peer
+    uint64_t msgs_recvd;            // messages delivered from this peer
+    uint64_t bytes_sent;
+    uint64_t bytes_recvd;
+    size_t queued_bytes;            // bytes in send_msg and send_queue
+    size_t queued_hwm;              // high-water mark of queued_bytes
+    uint64_t msgs_dropped;          // msgs dropped because the queue was over its limit
+    char **cnct_ns;                 // "nspace:jobgen" of foreign job info already given to this peer
+    int evring_idx;                 // bit this client reads from the event ring (-1 => socket)
+    pmix_list_t collectives;        // pmix_peer_ref_t to our caddies on local collective trackers
+    pmix_list_t evregs;             // pmix_peer_ref_t to our event registrations
     pmix_epilog_t epilog;           /**< things to be performed upon
                                          termination of this peer */
 } pmix_peer_t;
@@ -284,13 +354,17 @@ PMIX_CLASS_DECLARATION(pmix_query_caddy_t);
 typedef struct {
     pmix_list_item_t super;
     pmix_event_t ev;
-    bool event_active;
+    pmix_timer_t timer;
+    bool event_active;              // timer is armed
     bool lost_connection;           // tracker went thru lost connection procedure
     bool local;                     // operation is strictly local
     char *id;                       // string identifier for the collective
+    uint64_t digest;                // digest of the id or participants
+    bool indexed;                   // tracker is in the server's index of collectives
     pmix_cmd_t type;
     pmix_proc_t pname;
     bool hybrid;                    // true if participating procs are from more than one nspace
+    bool multi_ns;                  // true if the procs given to a fence or connect span more than one nspace
     pmix_proc_t *pcs;               // copy of the original array of participants
     size_t   npcs;                  // number of procs in the array
     pmix_lock_t lock;               // flag for waiting for completion
@@ -299,13 +373,24 @@ typedef struct {
                                     //    Note: there may be multiple entries for a given proc if that proc
                                     //    has fork/exec'd clones that are also participating
     uint32_t nlocal;                // number of local participants
-    uint32_t local_cnt;             // number of local participants who have contributed
+    uint32_t local_cnt;             // number of local participants who have arrived
+    uint32_t ndata;                 // number of local contributions added to the bucket
     pmix_info_t *info;              // array of info structs
     size_t ninfo;                   // number of info structs in array
     pmix_collect_t collect_type;    // whether or not data is to be returned at completion
+    char **collect_keys;            // collect only these keys (NULL => all)
+    pmix_buffer_t bucket;           // running collection of local contributions
+    pmix_bitmap_t arrivals;         // ranks whose contribution is already in the bucket
     pmix_modex_cbfunc_t modexcbfunc;
     pmix_op_cbfunc_t op_cbfunc;
     void *cbdata;
+    /* phase timestamps (nsec) for tracing slow fences */
+    uint64_t t_start;               // first local participant arrived
+    uint64_t t_local;               // last local participant arrived
+    uint64_t t_upcall;              // local contribution handed to the host
+    uint64_t t_host;                // host returned the collective result
+    size_t upcall_bytes;            // size of the local contribution
+    bool slow;                      // already reported by the watchdog
 } pmix_server_trkr_t;
 PMIX_CLASS_DECLARATION(pmix_server_trkr_t);
 
@@ -316,10 +401,15 @@ PMIX_CLASS_DECLARATION(pmix_server_trkr_t);
 typedef struct {
     pmix_list_item_t super;
     pmix_event_t ev;
-    bool event_active;
+    pmix_timer_t timer;
+    bool event_active;              // timer is armed
     pmix_server_trkr_t *trk;
+    pmix_server_trkr_t *member;     // tracker whose local_cbs we are on (not retained)
+    pmix_peer_ref_t *ref;           // our entry on peer->collectives
     pmix_ptl_hdr_t hdr;
     pmix_peer_t *peer;
+    uint64_t start;                 // arrival time if the watchdog is tracking it, else 0
+    bool slow;                      // already reported by the watchdog
 } pmix_server_caddy_t;
 PMIX_CLASS_DECLARATION(pmix_server_caddy_t);
 
@@ -389,18 +479,48 @@ typedef struct {
     size_t nvals;
     pmix_list_t kvs;
     bool copy;
+    pmix_timer_t timer;
     bool timer_running;
 } pmix_cb_t;
 PMIX_CLASS_DECLARATION(pmix_cb_t);
 
+/* Shifting into the progress thread pushes the object onto a
+ * lock-free queue that a single event drains, so a burst of shifts
+ * costs one wakeup of the progress thread rather than one libevent
+ * activation (and base lock acquisition) apiece. The object's own
+ * event storage serves as the queue node until the drain reassigns
+ * it and runs the callback */
 #define PMIX_THREADSHIFT(r, c)                              \
  do {                                                       \
-    pmix_event_assign(&((r)->ev), pmix_globals.evbase,      \
-                      -1, EV_WRITE, (c), (r));              \
     PMIX_POST_OBJECT((r));                                  \
-    pmix_event_active(&((r)->ev), EV_WRITE, 1);             \
+    pmix_threadshift(&((r)->ev),                            \
+                     (void (*)(int, short, void*)) (c),     \
+                     (r));                                  \
 } while (0)
 
+PMIX_EXPORT void pmix_threadshift(pmix_event_t *ev,
+                                  void (*cbfunc)(int, short, void*),
+                                  void *cbdata);
+
+/* setup the drain event once the event base exists, and
+ * tear it down before the base goes away */
+PMIX_EXPORT void pmix_threadshift_init(void);
+PMIX_EXPORT void pmix_threadshift_finalize(void);
+
+/* Operation timeouts (PMIX_TIMEOUT on fence, get, connect, group
+ * and lookup) share one hashed timer wheel turned by a single
+ * periodic event, rather than each putting a timer of its own into
+ * the event base - arming and cancelling are O(1) list operations.
+ * Timeouts fire up to two ticks late. Both calls must be made from
+ * the progress thread. The callback is given EV_TIMEOUT, and the
+ * timer is disarmed before it is called */
+PMIX_EXPORT void pmix_timer_add(pmix_timer_t *timer,
+                                void (*cbfunc)(int, short, void*),
+                                void *cbdata, const struct timeval *tv);
+/* a no-op if the timer is not armed */
+PMIX_EXPORT void pmix_timer_del(pmix_timer_t *timer);
+PMIX_EXPORT void pmix_timer_finalize(void);
+
 
 typedef struct {
     pmix_object_t super;
@@ -444,6 +564,30 @@ typedef struct {
 } pmix_notify_caddy_t;
 PMIX_CLASS_DECLARATION(pmix_notify_caddy_t);
 
+/* the hotel rooms holding cached notifications for a given
+ * status code, in the order they were checked in */
+typedef struct {
+    pmix_object_t super;
+    int *rooms;
+    size_t nrooms;
+    size_t size;
+} pmix_notify_index_t;
+PMIX_CLASS_DECLARATION(pmix_notify_index_t);
+
+/* drop a notification from the code index - must be called
+ * whenever it leaves the notifications hotel */
+PMIX_EXPORT void pmix_notify_cache_unindex(pmix_notify_caddy_t *cd);
+
+/* return the rooms that may hold cached notifications for the
+ * given codes, oldest first for each code - a NULL codes array
+ * (i.e., a default handler) returns every room. The caller must
+ * free the array */
+PMIX_EXPORT pmix_status_t pmix_notify_cache_rooms(pmix_status_t *codes, size_t ncodes,
+                                                  int **rooms, size_t *nrooms);
+
+/* release the code index at finalize */
+PMIX_EXPORT void pmix_notify_cache_clear(void);
+
 
 /****    GLOBAL STORAGE    ****/
 /* define a global construct that includes values that must be shared
@@ -467,7 +611,9 @@ typedef struct {
     pmix_list_t iof_requests;           // list of pmix_iof_req_t IOF requests
     int max_events;                     // size of the notifications hotel
     int event_eviction_time;            // max time to cache notifications
+    int event_eviction_granularity;     // time between sweeps of that cache
     pmix_hotel_t notifications;         // hotel of pending notifications
+    pmix_hash_table_t notify_index;     // status code -> pmix_notify_index_t
     /* processes also need a place where they can store
      * their own internal data - e.g., data provided by
      * the user via the store_internal interface, as well
@@ -485,6 +631,35 @@ typedef struct {
 /* provide access to a function to cleanup epilogs */
 PMIX_EXPORT void pmix_execute_epilog(pmix_epilog_t *ep);
 
+/* add a local client to, remove it from, or find it in the
+ * ranks of its nspace - always use these so the index of
+ * the ranks stays in step with the list */
+PMIX_EXPORT void pmix_nspace_add_rank(pmix_namespace_t *nptr, pmix_rank_info_t *info);
+PMIX_EXPORT void pmix_nspace_remove_rank(pmix_namespace_t *nptr, pmix_rank_info_t *info);
+PMIX_EXPORT pmix_rank_info_t* pmix_nspace_find_rank(pmix_namespace_t *nptr, pmix_rank_t rank);
+
+/* the interned ID of an nspace object - assigned on first use as
+ * the name is filled in after the object is created */
+static inline pmix_nsid_t pmix_nspace_id(pmix_namespace_t *nptr)
+{
+    if (PMIX_NSID_INVALID == nptr->id) {
+        nptr->id = pmix_nsid_intern(nptr->nspace);
+    }
+    return nptr->id;
+}
+
+/* add an nspace object, with its name filled in, to a list that is
+ * searched with pmix_nspace_lookup. This is where names are interned -
+ * a lookup never adds to the table */
+static inline void pmix_nspace_add(pmix_list_t *nspaces, pmix_namespace_t *nptr)
+{
+    (void)pmix_nspace_id(nptr);
+    pmix_list_append(nspaces, &nptr->super);
+}
+
+/* find the nspace object of the given name in a list of them */
+PMIX_EXPORT pmix_namespace_t* pmix_nspace_lookup(pmix_list_t *nspaces, const char *nspace);
+
 PMIX_EXPORT extern pmix_globals_t pmix_globals;
 PMIX_EXPORT extern pmix_lock_t pmix_global_lock;
 
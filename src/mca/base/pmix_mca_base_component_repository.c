@@ -34,6 +34,9 @@
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
 
 #include "src/class/pmix_list.h"
 #include "src/mca/mca.h"
@@ -54,6 +57,11 @@ static void ri_destructor(pmix_mca_base_component_repository_item_t *ri);
 PMIX_CLASS_INSTANCE(pmix_mca_base_component_repository_item_t, pmix_list_item_t,
                     ri_constructor, ri_destructor);
 
+static void bundle_constructor(pmix_mca_base_component_bundle_t *bundle);
+static void bundle_destructor(pmix_mca_base_component_bundle_t *bundle);
+PMIX_CLASS_INSTANCE(pmix_mca_base_component_bundle_t, pmix_object_t,
+                    bundle_constructor, bundle_destructor);
+
 #endif /* PMIX_HAVE_PDL_SUPPORT */
 
 static void clf_constructor(pmix_object_t *obj)
@@ -91,36 +99,21 @@ static pmix_hash_table_t pmix_mca_base_component_repository;
 #define STRINGIFYX(x) #x
 #define STRINGIFY(x) STRINGIFYX(x)
 
-static int process_repository_item (const char *filename, void *data)
+/*
+ * Add a component to the repository. The base name is consumed. If
+ * the component lives in a bundle, its struct is already resolved
+ * and the bundle takes the place of a file of its own - including
+ * that of an earlier-found file that hasn't been opened yet.
+ */
+static int add_repository_item (const char *filename, char *base,
+                                const char *type, const char *name,
+                                pmix_mca_base_component_bundle_t *bundle,
+                                const pmix_mca_base_component_t *component)
 {
-    char name[PMIX_MCA_BASE_MAX_COMPONENT_NAME_LEN + 1];
-    char type[PMIX_MCA_BASE_MAX_TYPE_NAME_LEN + 1];
     pmix_mca_base_component_repository_item_t *ri;
     pmix_list_t *component_list;
-    char *base;
     int ret;
 
-    base = pmix_basename (filename);
-    if (NULL == base) {
-        return PMIX_ERROR;
-    }
-
-    /* check if the plugin has the appropriate prefix */
-    if (0 != strncmp (base, "mca_", 4)) {
-        free (base);
-        return PMIX_SUCCESS;
-    }
-
-    /* read framework and component names. framework names may not include an _
-     * but component names may */
-    ret = sscanf(base, "mca_%" STRINGIFY(PMIX_MCA_BASE_MAX_TYPE_NAME_LEN) "[^_]_%"
-                 STRINGIFY(PMIX_MCA_BASE_MAX_COMPONENT_NAME_LEN) "s", type, name);
-    if (0 > ret) {
-        /* does not patch the expected template. skip */
-        free(base);
-        return PMIX_SUCCESS;
-    }
-
     /* lookup the associated framework list and create if it doesn't already exist */
     ret = pmix_hash_table_get_value_ptr(&pmix_mca_base_component_repository, type,
                                         strlen (type), (void **) &component_list);
@@ -145,6 +138,17 @@ static int process_repository_item (const char *filename, void *data)
     PMIX_LIST_FOREACH(ri, component_list, pmix_mca_base_component_repository_item_t) {
         if (0 == strcmp (ri->ri_name, name)) {
             /* already scanned this component */
+            if (NULL != bundle && NULL == ri->ri_bundle && NULL == ri->ri_dlhandle) {
+                free (ri->ri_path);
+                ri->ri_path = strdup (filename);
+                if (NULL == ri->ri_path) {
+                    free (base);
+                    return PMIX_ERR_OUT_OF_RESOURCE;
+                }
+                PMIX_RETAIN(bundle);
+                ri->ri_bundle = bundle;
+                ri->ri_component_struct = component;
+            }
             free (base);
             return PMIX_SUCCESS;
         }
@@ -171,11 +175,118 @@ static int process_repository_item (const char *filename, void *data)
     ri->ri_name[PMIX_MCA_BASE_MAX_TYPE_NAME_LEN] = '\0';
     pmix_strncpy (ri->ri_name, name, PMIX_MCA_BASE_MAX_COMPONENT_NAME_LEN);
 
+    if (NULL != bundle) {
+        PMIX_RETAIN(bundle);
+        ri->ri_bundle = bundle;
+        ri->ri_component_struct = component;
+    }
+
     pmix_list_append (component_list, &ri->super);
 
     return PMIX_SUCCESS;
 }
 
+/*
+ * Open a bundle and add every component in its table to the
+ * repository. A bundle that can't be used is not an error - its
+ * components may still be found in files of their own.
+ */
+static int process_repository_bundle (const char *filename)
+{
+    pmix_mca_base_component_bundle_t *bundle;
+    const pmix_mca_base_component_t **table, *component;
+    char *base, *err_msg = NULL;
+    int n, vl, ret = PMIX_SUCCESS;
+
+    vl = pmix_mca_base_component_show_load_errors ? PMIX_MCA_BASE_VERBOSE_ERROR : PMIX_MCA_BASE_VERBOSE_INFO;
+
+    bundle = PMIX_NEW(pmix_mca_base_component_bundle_t);
+    if (NULL == bundle) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    if (PMIX_SUCCESS != pmix_pdl_open(filename, true, false, &bundle->dlhandle, &err_msg)) {
+        pmix_output_verbose(vl, 0, "pmix_mca_base_component_repository: unable to open bundle %s: %s (ignored)",
+                            filename, (NULL == err_msg) ? "unknown error" : err_msg);
+        PMIX_RELEASE(bundle);
+        return PMIX_SUCCESS;
+    }
+    if (PMIX_SUCCESS != pmix_pdl_lookup(bundle->dlhandle, PMIX_MCA_BASE_COMPONENT_BUNDLE_TABLE,
+                                        (void**) &table, &err_msg) || NULL == table) {
+        pmix_output_verbose(vl, 0, "pmix_mca_base_component_repository: %s has no component table (ignored)",
+                            filename);
+        PMIX_RELEASE(bundle);
+        return PMIX_SUCCESS;
+    }
+    bundle->path = strdup (filename);
+
+    for (n=0; NULL != (component = table[n]); n++) {
+        if (!(PMIX_MCA_BASE_VERSION_MAJOR == component->pmix_mca_major_version &&
+              PMIX_MCA_BASE_VERSION_MINOR == component->pmix_mca_minor_version)) {
+            pmix_output_verbose(vl, 0, "pmix_mca_base_component_repository: %s \"%s\" in bundle %s uses an MCA "
+                                "interface that is not recognized (component MCA v%d.%d.%d != supported MCA "
+                                "v%d.%d.%d) -- ignored", component->pmix_mca_type_name,
+                                component->pmix_mca_component_name, filename,
+                                component->pmix_mca_major_version, component->pmix_mca_minor_version,
+                                component->pmix_mca_release_version, PMIX_MCA_BASE_VERSION_MAJOR,
+                                PMIX_MCA_BASE_VERSION_MINOR, PMIX_MCA_BASE_VERSION_RELEASE);
+            continue;
+        }
+        if (0 > asprintf(&base, "mca_%s_%s", component->pmix_mca_type_name,
+                         component->pmix_mca_component_name)) {
+            ret = PMIX_ERR_OUT_OF_RESOURCE;
+            break;
+        }
+        ret = add_repository_item (filename, base, component->pmix_mca_type_name,
+                                   component->pmix_mca_component_name, bundle, component);
+        if (PMIX_SUCCESS != ret) {
+            break;
+        }
+    }
+
+    /* the repository items hold the bundle open from here on */
+    PMIX_RELEASE(bundle);
+    return ret;
+}
+
+static int process_repository_item (const char *filename, void *data)
+{
+    char name[PMIX_MCA_BASE_MAX_COMPONENT_NAME_LEN + 1];
+    char type[PMIX_MCA_BASE_MAX_TYPE_NAME_LEN + 1];
+    char *base;
+    int ret;
+
+    base = pmix_basename (filename);
+    if (NULL == base) {
+        return PMIX_ERROR;
+    }
+
+    if (0 == strcmp (base, PMIX_MCA_BASE_COMPONENT_BUNDLE)) {
+        free (base);
+        if (!pmix_mca_base_component_use_bundle) {
+            return PMIX_SUCCESS;
+        }
+        return process_repository_bundle (filename);
+    }
+
+    /* check if the plugin has the appropriate prefix */
+    if (0 != strncmp (base, "mca_", 4)) {
+        free (base);
+        return PMIX_SUCCESS;
+    }
+
+    /* read framework and component names. framework names may not include an _
+     * but component names may */
+    ret = sscanf(base, "mca_%" STRINGIFY(PMIX_MCA_BASE_MAX_TYPE_NAME_LEN) "[^_]_%"
+                 STRINGIFY(PMIX_MCA_BASE_MAX_COMPONENT_NAME_LEN) "s", type, name);
+    if (0 > ret) {
+        /* does not patch the expected template. skip */
+        free(base);
+        return PMIX_SUCCESS;
+    }
+
+    return add_repository_item (filename, base, type, name, NULL, NULL);
+}
+
 static int file_exists(const char *filename, const char *ext)
 {
     char *final;
@@ -195,6 +306,58 @@ static int file_exists(const char *filename, const char *ext)
     return (0 == ret);
 }
 
+/*
+ * Register the components listed in the index for this directory,
+ * saving us from a directory walk and a stat of every file in it.
+ * Adding or removing a file updates the directory's mtime, so the
+ * index is only trusted if it is at least as new as the directory.
+ */
+static int process_repository_index(const char *dir)
+{
+    char *index = NULL, *filename;
+    char line[PMIX_PATH_MAX];
+    struct stat dbuf, ibuf;
+    size_t len;
+    FILE *fp;
+    int ret = PMIX_SUCCESS;
+
+    if (0 > asprintf(&index, "%s/%s", dir, PMIX_MCA_BASE_COMPONENT_INDEX)) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    if (0 != stat(index, &ibuf) || 0 != stat(dir, &dbuf) ||
+        ibuf.st_mtime < dbuf.st_mtime) {
+        free(index);
+        return PMIX_ERR_NOT_FOUND;
+    }
+    fp = fopen(index, "r");
+    free(index);
+    if (NULL == fp) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    while (NULL != fgets(line, sizeof(line), fp)) {
+        len = strlen(line);
+        while (0 < len && ('\n' == line[len-1] || '\r' == line[len-1])) {
+            line[--len] = '\0';
+        }
+        if (0 == len || '#' == line[0]) {
+            continue;
+        }
+        if (0 > asprintf(&filename, "%s/%s", dir, line)) {
+            ret = PMIX_ERR_OUT_OF_RESOURCE;
+            break;
+        }
+        ret = process_repository_item(filename, NULL);
+        free(filename);
+        if (PMIX_SUCCESS != ret) {
+            break;
+        }
+    }
+    fclose(fp);
+
+    return ret;
+}
+
 #endif /* PMIX_HAVE_PDL_SUPPORT */
 
 int pmix_mca_base_component_repository_add (const char *path)
@@ -220,6 +383,10 @@ int pmix_mca_base_component_repository_add (const char *path)
             dir = pmix_mca_base_system_default_path;
         }
 
+        if (pmix_mca_base_component_use_index &&
+            PMIX_SUCCESS == process_repository_index(dir)) {
+            continue;
+        }
         if (0 != pmix_pdl_foreachfile(dir, process_repository_item, NULL)) {
             break;
         }
@@ -386,6 +553,24 @@ int pmix_mca_base_component_repository_open(pmix_mca_base_framework_t *framework
     /* silence coverity issue (invalid free) */
     mitem = NULL;
 
+    if (NULL != ri->ri_bundle) {
+        /* the bundle was opened and the struct found when the
+         * repository was built - there is no file to open */
+        mitem = PMIX_NEW(pmix_mca_base_component_list_item_t);
+        if (NULL == mitem) {
+            return PMIX_ERR_OUT_OF_RESOURCE;
+        }
+
+        mitem->cli_component = ri->ri_component_struct;
+        ++ri->ri_refcnt;
+        pmix_list_append (&framework->framework_components, &mitem->super);
+
+        pmix_output_verbose (PMIX_MCA_BASE_VERBOSE_INFO, 0, "pmix_mca_base_component_repository_open: opened %s MCA "
+                             "component \"%s\" from bundle %s", ri->ri_type, ri->ri_name, ri->ri_bundle->path);
+
+        return PMIX_SUCCESS;
+    }
+
     if (NULL != ri->ri_dlhandle) {
         pmix_output_verbose (PMIX_MCA_BASE_VERBOSE_INFO, 0, "pmix_mca_base_component_repository_open: already loaded. returning cached component");
         mitem = PMIX_NEW(pmix_mca_base_component_list_item_t);
@@ -574,6 +759,7 @@ static void ri_constructor (pmix_mca_base_component_repository_item_t *ri)
     memset(ri->ri_type, 0, sizeof(ri->ri_type));
     ri->ri_dlhandle = NULL;
     ri->ri_component_struct = NULL;
+    ri->ri_bundle = NULL;
     ri->ri_path = NULL;
 }
 
@@ -598,6 +784,30 @@ static void ri_destructor (pmix_mca_base_component_repository_item_t *ri)
     if (ri->ri_base) {
         free (ri->ri_base);
     }
+
+    if (ri->ri_bundle) {
+        PMIX_RELEASE(ri->ri_bundle);
+    }
+}
+
+static void bundle_constructor (pmix_mca_base_component_bundle_t *bundle)
+{
+    bundle->path = NULL;
+    bundle->dlhandle = NULL;
+}
+
+/*
+ * Close a bundle once no repository item refers to it
+ */
+static void bundle_destructor (pmix_mca_base_component_bundle_t *bundle)
+{
+    if (bundle->dlhandle) {
+        pmix_pdl_close(bundle->dlhandle);
+    }
+
+    if (bundle->path) {
+        free (bundle->path);
+    }
 }
 
 #endif /* PMIX_HAVE_PDL_SUPPORT */
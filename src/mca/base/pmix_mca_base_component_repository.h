@@ -43,6 +43,29 @@
 #include "src/mca/pdl/base/base.h"
 
 BEGIN_C_DECLS
+
+/* name of the file, written into each component directory at install
+ * time, that lists the components found there - one per line, as the
+ * filename without directory or suffix */
+#define PMIX_MCA_BASE_COMPONENT_INDEX "pmix-mca-components.idx"
+
+/* name (without suffix) of the optional module that holds many
+ * components at once, and of the NULL-terminated array of
+ * pmix_mca_base_component_t pointers it exports */
+#define PMIX_MCA_BASE_COMPONENT_BUNDLE "pmix_mca_bundle"
+#define PMIX_MCA_BASE_COMPONENT_BUNDLE_TABLE "pmix_mca_bundle_components"
+
+/* a bundle is opened once and shared by the repository items of
+ * all the components it holds */
+struct pmix_mca_base_component_bundle_t {
+    pmix_object_t super;
+    char *path;
+    pmix_pdl_handle_t *dlhandle;
+};
+typedef struct pmix_mca_base_component_bundle_t pmix_mca_base_component_bundle_t;
+
+PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_mca_base_component_bundle_t);
+
 struct pmix_mca_base_component_repository_item_t {
     pmix_list_item_t super;
 
@@ -54,6 +77,7 @@ struct pmix_mca_base_component_repository_item_t {
 
     pmix_pdl_handle_t *ri_dlhandle;
     const pmix_mca_base_component_t *ri_component_struct;
+    pmix_mca_base_component_bundle_t *ri_bundle;    // non-NULL if the component lives in a bundle
 
     int ri_refcnt;
 };
@@ -51,6 +51,8 @@ char *pmix_mca_base_user_default_path = NULL;
 bool pmix_mca_base_component_show_load_errors = (bool) PMIX_SHOW_LOAD_ERRORS_DEFAULT;
 bool pmix_mca_base_component_track_load_errors = false;
 bool pmix_mca_base_component_disable_dlopen = false;
+bool pmix_mca_base_component_use_index = true;
+bool pmix_mca_base_component_use_bundle = true;
 
 static char *pmix_mca_base_verbose = NULL;
 
@@ -138,6 +140,26 @@ int pmix_mca_base_open(void)
     (void) pmix_mca_base_var_register_synonym(var_id, "pmix", "mca", NULL, "component_disable_dlopen",
                                               PMIX_MCA_BASE_VAR_SYN_FLAG_DEPRECATED);
 
+    pmix_mca_base_component_use_index = true;
+    var_id = pmix_mca_base_var_register("pmix", "mca", "base", "component_use_index",
+                                        "Whether to find components through the index written at install "
+                                        "time, when it is newer than its directory, instead of scanning "
+                                        "the directory",
+                                        PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                        PMIX_INFO_LVL_9,
+                                        PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                        &pmix_mca_base_component_use_index);
+
+    pmix_mca_base_component_use_bundle = true;
+    var_id = pmix_mca_base_var_register("pmix", "mca", "base", "component_use_bundle",
+                                        "Whether to load components from the \"" PMIX_MCA_BASE_COMPONENT_BUNDLE
+                                        "\" module, opened once for all of them, in preference to "
+                                        "opening each component's own file",
+                                        PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                        PMIX_INFO_LVL_9,
+                                        PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                        &pmix_mca_base_component_use_bundle);
+
     /* What verbosity level do we want for the default 0 stream? */
     pmix_mca_base_verbose = "stderr";
     var_id = pmix_mca_base_var_register("pmix", "mca", "base", "verbose",
@@ -55,6 +55,7 @@
  */
 static pmix_pointer_array_t pmix_mca_base_vars;
 static const char *mca_prefix = "PMIX_MCA_";
+static const char *mca_source_prefix = "PMIX_MCA_SOURCE_";
 static char *home = NULL;
 static char *cwd  = NULL;
 bool pmix_mca_base_var_initialized = false;
@@ -71,6 +72,7 @@ static char *pmix_mca_base_env_list = NULL;
 static char *pmix_mca_base_env_list_sep = PMIX_MCA_BASE_ENV_LIST_SEP_DEFAULT;
 static char *pmix_mca_base_env_list_internal = NULL;
 static bool pmix_mca_base_var_suppress_override_warning = false;
+static bool pmix_mca_base_var_export_files = true;
 static pmix_list_t pmix_mca_base_var_file_values;
 static pmix_list_t pmix_mca_base_envar_file_values;
 static pmix_list_t pmix_mca_base_var_override_values;
@@ -79,6 +81,17 @@ static int pmix_mca_base_var_count = 0;
 
 static pmix_hash_table_t pmix_mca_base_var_index_hash;
 
+/* index of the PMIX_MCA_ entries in environ, built in one pass so
+ * that registering a variable doesn't cost a getenv scan per name.
+ * The environment can change underneath us, so remember enough of
+ * what it looked like to notice */
+static pmix_hash_table_t pmix_mca_base_env_values;
+static pmix_hash_table_t pmix_mca_base_env_sources;
+static char **env_cache_environ = NULL;
+static size_t env_cache_count = 0;
+static char *env_cache_last = NULL;
+static bool env_cache_valid = false;
+
 const char *pmix_var_type_names[] = {
     "int",
     "unsigned_int",
@@ -267,6 +280,18 @@ int pmix_mca_base_var_init(void)
             return ret;
         }
 
+        PMIX_CONSTRUCT(&pmix_mca_base_env_values, pmix_hash_table_t);
+        ret = pmix_hash_table_init (&pmix_mca_base_env_values, 128);
+        if (PMIX_SUCCESS != ret) {
+            return ret;
+        }
+        PMIX_CONSTRUCT(&pmix_mca_base_env_sources, pmix_hash_table_t);
+        ret = pmix_hash_table_init (&pmix_mca_base_env_sources, 128);
+        if (PMIX_SUCCESS != ret) {
+            return ret;
+        }
+        env_cache_valid = false;
+
         ret = pmix_mca_base_var_group_init ();
         if  (PMIX_SUCCESS != ret) {
             return ret;
@@ -480,6 +505,17 @@ int pmix_mca_base_var_cache_files(bool rel_path_search)
         return ret;
     }
 
+    pmix_mca_base_var_export_files = true;
+    ret = pmix_mca_base_var_register ("pmix", "mca", "base", "param_files_export",
+                                 "Whether a server passes the values it read from MCA parameter files "
+                                 "to its clients in their environment, so the clients need not read "
+                                 "the files themselves (default: true)",
+                                 PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, PMIX_INFO_LVL_3,
+                                 PMIX_MCA_BASE_VAR_SCOPE_READONLY, &pmix_mca_base_var_export_files);
+    if (0 > ret) {
+        return ret;
+    }
+
     /* Disable reading MCA parameter files. */
     if (0 == strcmp (pmix_mca_base_var_files, "none")) {
         return PMIX_SUCCESS;
@@ -572,6 +608,51 @@ int pmix_mca_base_var_cache_files(bool rel_path_search)
     return PMIX_SUCCESS;
 }
 
+int pmix_mca_base_var_export_file_values(char ***env)
+{
+    pmix_mca_base_var_file_value_t *fv;
+    char *name, *files;
+    size_t len;
+    int n, ret;
+
+    if (!pmix_mca_base_var_export_files) {
+        return PMIX_SUCCESS;
+    }
+
+    /* if the child was pointed at files of its own, it has to read them */
+    if (PMIX_SUCCESS != (ret = pmix_mca_base_var_env_name("mca_base_param_files", &files))) {
+        return ret;
+    }
+    len = strlen(files);
+    for (n=0; NULL != *env && NULL != (*env)[n]; n++) {
+        if (0 == strncmp((*env)[n], files, len) && '=' == (*env)[n][len]) {
+            free(files);
+            return PMIX_SUCCESS;
+        }
+    }
+
+    /* values from the regular files only apply where the environment
+     * doesn't already set them, while the override file wins */
+    PMIX_LIST_FOREACH(fv, &pmix_mca_base_var_file_values, pmix_mca_base_var_file_value_t) {
+        if (PMIX_SUCCESS == pmix_mca_base_var_env_name(fv->mbvfv_var, &name)) {
+            pmix_setenv(name, fv->mbvfv_value, false, env);
+            free(name);
+        }
+    }
+    PMIX_LIST_FOREACH(fv, &pmix_mca_base_var_override_values, pmix_mca_base_var_file_value_t) {
+        if (PMIX_SUCCESS == pmix_mca_base_var_env_name(fv->mbvfv_var, &name)) {
+            pmix_setenv(name, fv->mbvfv_value, true, env);
+            free(name);
+        }
+    }
+
+    /* everything the files hold is now in the environment */
+    pmix_setenv(files, "none", true, env);
+    free(files);
+
+    return PMIX_SUCCESS;
+}
+
 /*
  * Look up an integer MCA parameter.
  */
@@ -1176,6 +1257,9 @@ int pmix_mca_base_var_finalize(void)
         (void) pmix_mca_base_var_group_finalize ();
 
         PMIX_DESTRUCT(&pmix_mca_base_var_index_hash);
+        PMIX_DESTRUCT(&pmix_mca_base_env_values);
+        PMIX_DESTRUCT(&pmix_mca_base_env_sources);
+        env_cache_valid = false;
 
         free (pmix_mca_base_envar_files);
         pmix_mca_base_envar_files = NULL;
@@ -1606,27 +1690,87 @@ int pmix_mca_base_var_register_synonym (int synonym_for, const char *project_nam
                               synonym_for, NULL);
 }
 
-static int var_get_env (pmix_mca_base_var_t *var, const char *name, char **source, char **value)
+static void env_cache_add(pmix_hash_table_t *table, const char *name,
+                          size_t len, size_t index)
 {
-    char *source_env, *value_env;
-    int ret;
+    void *prev;
 
-    ret = asprintf (&source_env, "%sSOURCE_%s", mca_prefix, name);
-    if (0 > ret) {
-        return PMIX_ERROR;
+    /* getenv returns the first match, so keep that one */
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(table, name, len, &prev)) {
+        (void) pmix_hash_table_set_value_ptr(table, name, len, (void *)(uintptr_t) index);
     }
+}
 
-    ret = asprintf (&value_env, "%s%s", mca_prefix, name);
-    if (0 > ret) {
-        free (source_env);
-        return PMIX_ERROR;
+static void env_cache_build(void)
+{
+    size_t n, plen = strlen(mca_prefix), slen = strlen(mca_source_prefix) - plen;
+    char *name, *eq;
+
+    pmix_hash_table_remove_all(&pmix_mca_base_env_values);
+    pmix_hash_table_remove_all(&pmix_mca_base_env_sources);
+
+    for (n = 0 ; NULL != environ && NULL != environ[n] ; ++n) {
+        if (0 != strncmp(environ[n], mca_prefix, plen)) {
+            continue;
+        }
+        name = environ[n] + plen;
+        if (NULL == (eq = strchr(name, '='))) {
+            continue;
+        }
+        env_cache_add(&pmix_mca_base_env_values, name, eq - name, n);
+        if (0 == strncmp(environ[n], mca_source_prefix, plen + slen)) {
+            env_cache_add(&pmix_mca_base_env_sources, name + slen, eq - name - slen, n);
+        }
     }
 
-    *source = getenv (source_env);
-    *value = getenv (value_env);
+    env_cache_environ = environ;
+    env_cache_count = n;
+    env_cache_last = (0 < n) ? environ[n-1] : NULL;
+    env_cache_valid = true;
+}
+
+static bool env_cache_current(void)
+{
+    /* setenv and unsetenv either move the array, add or drop entries
+     * at its end, or shift the entries down - any of which changes
+     * the entry we saw last. Replacing a value in place is caught
+     * when the entry is read */
+    return (env_cache_valid && environ == env_cache_environ &&
+            (NULL == environ ||
+             (NULL == environ[env_cache_count] &&
+              (0 == env_cache_count || environ[env_cache_count-1] == env_cache_last))));
+}
 
-    free (source_env);
-    free (value_env);
+static char *env_cache_lookup(pmix_hash_table_t *table, const char *prefix, const char *name)
+{
+    size_t plen = strlen(prefix), len = strlen(name);
+    void *index;
+    char *entry;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(table, name, len, &index)) {
+        return NULL;
+    }
+    entry = environ[(uintptr_t) index];
+    if (0 != strncmp(entry, prefix, plen) || 0 != strncmp(entry + plen, name, len) ||
+        '=' != entry[plen + len]) {
+        /* the environment was rearranged - start over */
+        env_cache_build();
+        if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(table, name, len, &index)) {
+            return NULL;
+        }
+        entry = environ[(uintptr_t) index];
+    }
+
+    return entry + plen + len + 1;
+}
+
+static int var_get_env (pmix_mca_base_var_t *var, const char *name, char **source, char **value)
+{
+    if (!env_cache_current()) {
+        env_cache_build();
+    }
+    *source = env_cache_lookup(&pmix_mca_base_env_sources, mca_source_prefix, name);
+    *value = env_cache_lookup(&pmix_mca_base_env_values, mca_prefix, name);
 
     if (NULL == *value) {
         *source = NULL;
@@ -728,6 +728,14 @@ PMIX_EXPORT int pmix_mca_base_var_dump(int vari, char ***out, pmix_mca_base_var_
 
 PMIX_EXPORT int pmix_mca_base_var_cache_files (bool rel_path_search);
 
+/*
+ * Add the values read from MCA parameter files to the given
+ * environment, and tell the process that receives it not to read
+ * the files again. Does nothing if the environment names parameter
+ * files of its own.
+ */
+PMIX_EXPORT int pmix_mca_base_var_export_file_values(char ***env);
+
 /*
  * Parse a provided list of envars and add their local value, or
  * their assigned value, to the provided argv
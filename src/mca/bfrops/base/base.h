@@ -662,6 +662,9 @@ PMIX_EXPORT pmix_status_t pmix_bfrop_get_data_type(pmix_buffer_t *buffer, pmix_d
 PMIX_EXPORT pmix_status_t pmix_bfrops_base_copy_payload(pmix_buffer_t *dest,
                                                         pmix_buffer_t *src);
 
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_borrow(pmix_buffer_t *buffer,
+                                                         pmix_byte_object_t *bo);
+
 PMIX_EXPORT void pmix_bfrops_base_value_load(pmix_value_t *v, const void *data,
                                              pmix_data_type_t type);
 
@@ -675,6 +678,23 @@ PMIX_EXPORT pmix_status_t pmix_bfrops_base_value_xfer(pmix_value_t *p,
 PMIX_EXPORT pmix_value_cmp_t pmix_bfrops_base_value_cmp(pmix_value_t *p,
                                                         pmix_value_t *p1);
 
+/* marker sent in place of the proc count when a proc set
+ * follows in the range encoding */
+#define PMIX_BFROPS_PROCSET_RANGES  SIZE_MAX
+
+/* pack an array of procs - as per-nspace rank ranges if the
+ * receiver is known to accept them, as a plain PMIX_PROC array
+ * otherwise. The unpack side accepts either and returns an
+ * allocated array, or NULL if the sender passed no procs */
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_pack_procset(struct pmix_peer_t *peer,
+                                                        pmix_buffer_t *buf,
+                                                        const pmix_proc_t *procs,
+                                                        size_t nprocs, bool ranges);
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_unpack_procset(struct pmix_peer_t *peer,
+                                                          pmix_buffer_t *buf,
+                                                          pmix_proc_t **procs,
+                                                          size_t *nprocs);
+
 END_C_DECLS
 
 #endif
@@ -703,6 +703,243 @@ char* pmix_bfrop_buffer_extend(pmix_buffer_t *buffer, size_t bytes_to_add)
     return buffer->pack_ptr;
 }
 
+/*
+ * Ensure the buffer can hold the given number of additional bytes
+ * without further growth. Unlike pmix_bfrop_buffer_extend, the
+ * allocation is sized exactly to the request so that a caller who
+ * knows (or has estimated) the final size pays for a single realloc.
+ */
+pmix_status_t pmix_bfrops_base_reserve(pmix_buffer_t *buffer, size_t bytes)
+{
+    size_t to_alloc;
+    size_t pack_offset, unpack_offset;
+    char *ptr;
+
+    if ((buffer->bytes_allocated - buffer->bytes_used) >= bytes) {
+        return PMIX_SUCCESS;
+    }
+
+    to_alloc = buffer->bytes_used + bytes;
+    if (NULL == buffer->base_ptr) {
+        pack_offset = 0;
+        unpack_offset = 0;
+        buffer->bytes_used = 0;
+    } else {
+        pack_offset = ((char*) buffer->pack_ptr) - ((char*) buffer->base_ptr);
+        unpack_offset = ((char*) buffer->unpack_ptr) -
+            ((char*) buffer->base_ptr);
+    }
+    ptr = (char*)realloc(buffer->base_ptr, to_alloc);
+    if (NULL == ptr) {
+        return PMIX_ERR_NOMEM;
+    }
+    buffer->base_ptr = ptr;
+    buffer->pack_ptr = buffer->base_ptr + pack_offset;
+    buffer->unpack_ptr = buffer->base_ptr + unpack_offset;
+    buffer->bytes_allocated = to_alloc;
+    return PMIX_SUCCESS;
+}
+
+/*
+ * Share a kval's value instead of copying it. The returned kval
+ * holds a reference on the kval that owns the value, which keeps
+ * the value alive for as long as the share exists. Stores replace
+ * rather than modify kvals, so the value will not change under us.
+ */
+pmix_kval_t* pmix_bfrops_base_kval_share(pmix_kval_t *kv)
+{
+    pmix_kval_t *kp;
+    pmix_kval_t *owner;
+
+    kp = PMIX_NEW(pmix_kval_t);
+    if (NULL == kp) {
+        return NULL;
+    }
+    if (NULL != kv->key) {
+        kp->key = strdup(kv->key);
+    }
+    /* always point at the kval that owns the value so chains
+     * of shares don't build up */
+    owner = (NULL == kv->shared) ? kv : kv->shared;
+    PMIX_RETAIN(owner);
+    kp->shared = owner;
+    kp->value = owner->value;
+    return kp;
+}
+
+pmix_status_t pmix_bfrops_base_kval_own(pmix_kval_t *kv)
+{
+    pmix_value_t *val = NULL;
+    pmix_status_t rc;
+
+    if (NULL == kv->shared) {
+        return PMIX_SUCCESS;
+    }
+    if (NULL != kv->value) {
+        PMIX_VALUE_CREATE(val, 1);
+        if (NULL == val) {
+            return PMIX_ERR_NOMEM;
+        }
+        rc = pmix_bfrops_base_value_xfer(val, kv->value);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_VALUE_RELEASE(val);
+            return rc;
+        }
+    }
+    PMIX_RELEASE(kv->shared);
+    kv->shared = NULL;
+    kv->value = val;
+    return PMIX_SUCCESS;
+}
+
+/* space taken by a packed data type descriptor */
+#define PMIX_BFROP_DESC_SIZE    sizeof(pmix_data_type_t)
+/* allowance for types whose encoding we don't bother to compute */
+#define PMIX_BFROP_EST_DEFAULT  (2 * PMIX_BFROP_DESC_SIZE + sizeof(uint64_t))
+
+static size_t est_string(const char *s)
+{
+    size_t sz = sizeof(int32_t);
+
+    if (NULL != s) {
+        sz += strlen(s) + 1;
+    }
+    return sz;
+}
+
+static size_t est_value(const pmix_value_t *v)
+{
+    size_t sz = PMIX_BFROP_DESC_SIZE;
+
+    switch (v->type) {
+        case PMIX_STRING:
+            sz += est_string(v->data.string);
+            break;
+        case PMIX_BYTE_OBJECT:
+        case PMIX_COMPRESSED_STRING:
+            sz += PMIX_BFROP_DESC_SIZE + sizeof(size_t) + v->data.bo.size;
+            break;
+        case PMIX_PROC:
+            if (NULL != v->data.proc) {
+                sz += pmix_bfrops_base_sizeof(v->data.proc, 1, PMIX_PROC);
+            }
+            break;
+        case PMIX_DATA_ARRAY:
+            sz += PMIX_BFROP_DESC_SIZE + sizeof(size_t);
+            if (NULL != v->data.darray && NULL != v->data.darray->array) {
+                sz += pmix_bfrops_base_sizeof(v->data.darray->array,
+                                              v->data.darray->size,
+                                              v->data.darray->type);
+            }
+            break;
+        default:
+            sz += PMIX_BFROP_EST_DEFAULT;
+            break;
+    }
+    return sz;
+}
+
+/*
+ * Estimate the number of bytes the given values will occupy once
+ * packed. This is intended for sizing a buffer ahead of time with
+ * pmix_bfrops_base_reserve - it errs on the high side for fully
+ * described buffers and callers must not rely on it being exact.
+ */
+size_t pmix_bfrops_base_sizeof(const void *src, size_t num_vals,
+                               pmix_data_type_t type)
+{
+    size_t n, sz;
+    const pmix_info_t *info;
+    const pmix_pdata_t *pdata;
+    const pmix_kval_t *kv;
+    const pmix_proc_t *proc;
+    const pmix_byte_object_t *bo;
+    char * const *str;
+
+    /* count of values plus their declared type */
+    sz = 2 * PMIX_BFROP_DESC_SIZE + sizeof(int32_t);
+
+    switch (type) {
+        case PMIX_BOOL:
+        case PMIX_BYTE:
+        case PMIX_INT8:
+        case PMIX_UINT8:
+            sz += num_vals;
+            break;
+        case PMIX_INT16:
+        case PMIX_UINT16:
+            sz += num_vals * sizeof(uint16_t);
+            break;
+        case PMIX_INT32:
+        case PMIX_UINT32:
+        case PMIX_STATUS:
+        case PMIX_PROC_RANK:
+        case PMIX_INFO_DIRECTIVES:
+            sz += num_vals * sizeof(uint32_t);
+            break;
+        case PMIX_INT64:
+        case PMIX_UINT64:
+            sz += num_vals * sizeof(uint64_t);
+            break;
+        case PMIX_SIZE:
+        case PMIX_PID:
+        case PMIX_INT:
+        case PMIX_UINT:
+            sz += PMIX_BFROP_DESC_SIZE + num_vals * sizeof(uint64_t);
+            break;
+        case PMIX_STRING:
+            str = (char * const *)src;
+            for (n=0; n < num_vals; n++) {
+                sz += est_string(str[n]);
+            }
+            break;
+        case PMIX_BYTE_OBJECT:
+            bo = (const pmix_byte_object_t*)src;
+            for (n=0; n < num_vals; n++) {
+                sz += PMIX_BFROP_DESC_SIZE + sizeof(size_t) + bo[n].size;
+            }
+            break;
+        case PMIX_PROC:
+            proc = (const pmix_proc_t*)src;
+            for (n=0; n < num_vals; n++) {
+                sz += est_string(proc[n].nspace) + sizeof(uint32_t);
+            }
+            break;
+        case PMIX_VALUE:
+            for (n=0; n < num_vals; n++) {
+                sz += est_value(&((const pmix_value_t*)src)[n]);
+            }
+            break;
+        case PMIX_INFO:
+            info = (const pmix_info_t*)src;
+            for (n=0; n < num_vals; n++) {
+                sz += est_string(info[n].key) + sizeof(uint32_t) +
+                      est_value(&info[n].value);
+            }
+            break;
+        case PMIX_PDATA:
+            pdata = (const pmix_pdata_t*)src;
+            for (n=0; n < num_vals; n++) {
+                sz += est_string(pdata[n].proc.nspace) + sizeof(uint32_t) +
+                      est_string(pdata[n].key) + est_value(&pdata[n].value);
+            }
+            break;
+        case PMIX_KVAL:
+            kv = (const pmix_kval_t*)src;
+            for (n=0; n < num_vals; n++) {
+                sz += est_string(kv[n].key);
+                if (NULL != kv[n].value) {
+                    sz += est_value(kv[n].value);
+                }
+            }
+            break;
+        default:
+            sz += num_vals * PMIX_BFROP_EST_DEFAULT;
+            break;
+    }
+    return sz;
+}
+
 /*
  * Internal function that checks to see if the specified number of bytes
  * remain in the buffer for unpacking
@@ -144,7 +144,7 @@ static void pmix_buffer_destruct (pmix_buffer_t* buffer)
     }
 }
 
-PMIX_CLASS_INSTANCE(pmix_buffer_t,
+PMIX_CLASS_INSTANCE_CACHED(pmix_buffer_t,
                    pmix_object_t,
                    pmix_buffer_construct,
                    pmix_buffer_destruct);
@@ -174,16 +174,20 @@ static void kvcon(pmix_kval_t *k)
 {
     k->key = NULL;
     k->value = NULL;
+    k->shared = NULL;
 }
 static void kvdes(pmix_kval_t *k)
 {
     if (NULL != k->key) {
         free(k->key);
     }
-    if (NULL != k->value) {
+    if (NULL != k->shared) {
+        /* the value isn't ours */
+        PMIX_RELEASE(k->shared);
+    } else if (NULL != k->value) {
         PMIX_VALUE_RELEASE(k->value);
     }
 }
-PMIX_CLASS_INSTANCE(pmix_kval_t,
+PMIX_CLASS_INSTANCE_CACHED(pmix_kval_t,
                    pmix_list_item_t,
                    kvcon, kvdes);
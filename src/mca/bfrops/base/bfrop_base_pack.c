@@ -27,6 +27,7 @@
 
 #include "src/class/pmix_pointer_array.h"
 #include "src/util/argv.h"
+#include "src/util/counters.h"
 #include "src/util/error.h"
 #include "src/util/output.h"
 #include "src/include/pmix_globals.h"
@@ -40,12 +41,14 @@ pmix_status_t pmix_bfrops_base_pack(pmix_pointer_array_t *regtypes,
                                     pmix_data_type_t type)
 {
     pmix_status_t rc;
+    size_t used;
 
     /* check for error */
     if (NULL == buffer || NULL == src) {
         PMIX_ERROR_LOG(PMIX_ERR_BAD_PARAM);
         return PMIX_ERR_BAD_PARAM;
     }
+    used = buffer->bytes_used;
 
      /* Pack the number of values */
     if (PMIX_BFROP_BUFFER_FULLY_DESC == buffer->type) {
@@ -58,7 +61,9 @@ pmix_status_t pmix_bfrops_base_pack(pmix_pointer_array_t *regtypes,
     }
 
     /* Pack the value(s) */
-    return pmix_bfrops_base_pack_buffer(regtypes, buffer, src, num_vals, type);
+    rc = pmix_bfrops_base_pack_buffer(regtypes, buffer, src, num_vals, type);
+    pmix_counter_add(PMIX_CTR_PACK, buffer->bytes_used - used);
+    return rc;
 }
 
 
@@ -253,11 +258,17 @@ pmix_status_t pmix_bfrops_base_pack_int16(pmix_buffer_t *buffer, const void *src
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
 
+#if defined(WORDS_BIGENDIAN)
+    /* already in network order */
+    memcpy(dst, srctmp, num_vals * sizeof(tmp));
+#else
+    /* keep the loop free of buffer updates so the
+     * compiler can vectorize the conversion */
     for (i = 0; i < num_vals; ++i) {
         tmp = pmix_htons(srctmp[i]);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
+        memcpy(dst + i * sizeof(tmp), &tmp, sizeof(tmp));
     }
+#endif
     buffer->pack_ptr += num_vals * sizeof(tmp);
     buffer->bytes_used += num_vals * sizeof(tmp);
 
@@ -281,11 +292,14 @@ pmix_status_t pmix_bfrops_base_pack_int32(pmix_buffer_t *buffer, const void *src
     if (NULL == (dst = pmix_bfrop_buffer_extend(buffer, num_vals*sizeof(tmp)))) {
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
+#if defined(WORDS_BIGENDIAN)
+    memcpy(dst, srctmp, num_vals * sizeof(tmp));
+#else
     for (i = 0; i < num_vals; ++i) {
         tmp = htonl(srctmp[i]);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
+        memcpy(dst + i * sizeof(tmp), &tmp, sizeof(tmp));
     }
+#endif
     buffer->pack_ptr += num_vals * sizeof(tmp);
     buffer->bytes_used += num_vals * sizeof(tmp);
 
@@ -311,12 +325,15 @@ pmix_status_t pmix_bfrops_base_pack_int64(pmix_buffer_t *buffer, const void *src
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
 
+#if defined(WORDS_BIGENDIAN)
+    memcpy(dst, src, bytes_packed);
+#else
     for (i = 0; i < num_vals; ++i) {
         memcpy(&tmp2, (char *)src+i*sizeof(uint64_t), sizeof(uint64_t));
         tmp = pmix_hton64(tmp2);
-        memcpy(dst, &tmp, sizeof(tmp));
-        dst += sizeof(tmp);
+        memcpy(dst + i * sizeof(tmp), &tmp, sizeof(tmp));
     }
+#endif
     buffer->pack_ptr += bytes_packed;
     buffer->bytes_used += bytes_packed;
 
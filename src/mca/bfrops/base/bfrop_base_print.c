@@ -65,20 +65,11 @@ int pmix_bfrops_base_print_bool(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_BOOL\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -88,9 +79,6 @@ int pmix_bfrops_base_print_bool(char **output, char *prefix,
 
     ret = asprintf(output, "%sData type: PMIX_BOOL\tValue: %s", prefix,
              (*src) ? "TRUE" : "FALSE");
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -106,20 +94,11 @@ int pmix_bfrops_base_print_byte(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_BYTE\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -128,9 +107,6 @@ int pmix_bfrops_base_print_byte(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_BYTE\tValue: %x", prefix, *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -146,20 +122,11 @@ int pmix_bfrops_base_print_string(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_STRING\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -168,9 +135,6 @@ int pmix_bfrops_base_print_string(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_STRING\tValue: %s", prefx, src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -186,20 +150,11 @@ int pmix_bfrops_base_print_size(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_SIZE\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -208,9 +163,6 @@ int pmix_bfrops_base_print_size(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_SIZE\tValue: %lu", prefx, (unsigned long) *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -226,20 +178,11 @@ int pmix_bfrops_base_print_pid(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_PID\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -248,9 +191,6 @@ int pmix_bfrops_base_print_pid(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_PID\tValue: %lu", prefx, (unsigned long) *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
     } else {
@@ -265,20 +205,11 @@ int pmix_bfrops_base_print_int(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_INT\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -287,9 +218,6 @@ int pmix_bfrops_base_print_int(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_INT\tValue: %ld", prefx, (long) *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -305,20 +233,11 @@ int pmix_bfrops_base_print_uint(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_UINT\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -327,9 +246,6 @@ int pmix_bfrops_base_print_uint(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_UINT\tValue: %lu", prefx, (unsigned long) *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -345,20 +261,11 @@ int pmix_bfrops_base_print_uint8(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_UINT8\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -367,9 +274,6 @@ int pmix_bfrops_base_print_uint8(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_UINT8\tValue: %u", prefx, (unsigned int) *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -385,20 +289,11 @@ int pmix_bfrops_base_print_uint16(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_UINT16\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -407,9 +302,6 @@ int pmix_bfrops_base_print_uint16(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_UINT16\tValue: %u", prefx, (unsigned int) *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -425,20 +317,11 @@ int pmix_bfrops_base_print_uint32(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_UINT32\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -447,9 +330,6 @@ int pmix_bfrops_base_print_uint32(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_UINT32\tValue: %u", prefx, (unsigned int) *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -465,20 +345,11 @@ int pmix_bfrops_base_print_int8(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_INT8\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -487,9 +358,6 @@ int pmix_bfrops_base_print_int8(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_INT8\tValue: %d", prefx, (int) *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -505,20 +373,11 @@ int pmix_bfrops_base_print_int16(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_INT16\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -527,9 +386,6 @@ int pmix_bfrops_base_print_int16(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_INT16\tValue: %d", prefx, (int) *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -545,20 +401,11 @@ int pmix_bfrops_base_print_int32(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_INT32\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -567,9 +414,6 @@ int pmix_bfrops_base_print_int32(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_INT32\tValue: %d", prefx, (int) *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -585,20 +429,11 @@ int pmix_bfrops_base_print_uint64(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_UINT64\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -607,9 +442,6 @@ int pmix_bfrops_base_print_uint64(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_UINT64\tValue: %lu", prefx, (unsigned long) *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -626,20 +458,11 @@ int pmix_bfrops_base_print_int64(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_INT64\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -648,9 +471,6 @@ int pmix_bfrops_base_print_int64(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_INT64\tValue: %ld", prefx, (long) *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -666,20 +486,11 @@ int pmix_bfrops_base_print_float(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_FLOAT\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -688,9 +499,6 @@ int pmix_bfrops_base_print_float(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_FLOAT\tValue: %f", prefx, *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -706,20 +514,11 @@ int pmix_bfrops_base_print_double(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_DOUBLE\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -728,9 +527,6 @@ int pmix_bfrops_base_print_double(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_DOUBLE\tValue: %f", prefx, *src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -747,20 +543,11 @@ int pmix_bfrops_base_print_time(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_TIME\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -772,9 +559,6 @@ int pmix_bfrops_base_print_time(char **output, char *prefix,
     t[strlen(t)-1] = '\0';  // remove trailing newline
 
     ret = asprintf(output, "%sData type: PMIX_TIME\tValue: %s", prefx, t);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -790,20 +574,11 @@ int pmix_bfrops_base_print_timeval(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_TIMEVAL\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -813,9 +588,6 @@ int pmix_bfrops_base_print_timeval(char **output, char *prefix,
 
     ret = asprintf(output, "%sData type: PMIX_TIMEVAL\tValue: %ld.%06ld", prefx,
                    (long)src->tv_sec, (long)src->tv_usec);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -831,20 +603,11 @@ int pmix_bfrops_base_print_status(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_STATUS\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -853,9 +616,6 @@ int pmix_bfrops_base_print_status(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_STATUS\tValue: %s", prefx, PMIx_Error_string(*src));
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -867,166 +627,189 @@ int pmix_bfrops_base_print_status(char **output, char *prefix,
 
 /* PRINT FUNCTIONS FOR GENERIC PMIX TYPES */
 
-/*
- * PMIX_VALUE
- */
- int pmix_bfrops_base_print_value(char **output, char *prefix,
-                                  pmix_value_t *src, pmix_data_type_t type)
- {
-    char *prefx;
-    int rc;
-
-    /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+/* print into a buffer on the stack and copy out just what was
+ * used - the output is usually short, and this saves asprintf's
+ * sizing pass and the allocations for the pieces of a composite */
+#define PMIX_PRINT_BUFSIZE  512
 
-    /* if src is NULL, just print data type and return */
-    if (NULL == src) {
-        rc = asprintf(output, "%sData type: PMIX_VALUE\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
-        if (0 > rc) {
-            return PMIX_ERR_OUT_OF_RESOURCE;
-        } else {
-            return PMIX_SUCCESS;
-        }
-    }
+static int format_value(char *buf, size_t size, const char *prefx,
+                        const pmix_value_t *src)
+{
+    int rc;
 
     switch (src->type) {
         case PMIX_UNDEF:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_UNDEF", prefx);
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_UNDEF", prefx);
             break;
         case PMIX_BYTE:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_BYTE\tValue: %x",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_BYTE\tValue: %x",
                           prefx, src->data.byte);
             break;
         case PMIX_STRING:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_STRING\tValue: %s",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_STRING\tValue: %s",
                           prefx, src->data.string);
             break;
         case PMIX_SIZE:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_SIZE\tValue: %lu",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_SIZE\tValue: %lu",
                           prefx, (unsigned long)src->data.size);
             break;
         case PMIX_PID:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_PID\tValue: %lu",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_PID\tValue: %lu",
                           prefx, (unsigned long)src->data.pid);
             break;
         case PMIX_INT:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_INT\tValue: %d",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_INT\tValue: %d",
                           prefx, src->data.integer);
             break;
         case PMIX_INT8:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_INT8\tValue: %d",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_INT8\tValue: %d",
                           prefx, (int)src->data.int8);
             break;
         case PMIX_INT16:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_INT16\tValue: %d",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_INT16\tValue: %d",
                           prefx, (int)src->data.int16);
             break;
         case PMIX_INT32:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_INT32\tValue: %d",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_INT32\tValue: %d",
                           prefx, src->data.int32);
             break;
         case PMIX_INT64:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_INT64\tValue: %ld",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_INT64\tValue: %ld",
                           prefx, (long)src->data.int64);
             break;
         case PMIX_UINT:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_UINT\tValue: %u",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_UINT\tValue: %u",
                           prefx, src->data.uint);
             break;
         case PMIX_UINT8:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_UINT8\tValue: %u",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_UINT8\tValue: %u",
                           prefx, (unsigned int)src->data.uint8);
             break;
         case PMIX_UINT16:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_UINT16\tValue: %u",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_UINT16\tValue: %u",
                           prefx, (unsigned int)src->data.uint16);
             break;
         case PMIX_UINT32:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_UINT32\tValue: %u",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_UINT32\tValue: %u",
                           prefx, src->data.uint32);
             break;
         case PMIX_UINT64:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_UINT64\tValue: %lu",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_UINT64\tValue: %lu",
                           prefx, (unsigned long)src->data.uint64);
             break;
         case PMIX_FLOAT:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_FLOAT\tValue: %f",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_FLOAT\tValue: %f",
                           prefx, src->data.fval);
             break;
         case PMIX_DOUBLE:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_DOUBLE\tValue: %f",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_DOUBLE\tValue: %f",
                           prefx, src->data.dval);
             break;
         case PMIX_TIMEVAL:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_TIMEVAL\tValue: %ld.%06ld", prefx,
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_TIMEVAL\tValue: %ld.%06ld", prefx,
                           (long)src->data.tv.tv_sec, (long)src->data.tv.tv_usec);
             break;
         case PMIX_TIME:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_TIME\tValue: %ld", prefx,
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_TIME\tValue: %ld", prefx,
                           (long)src->data.time);
             break;
         case PMIX_STATUS:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_STATUS\tValue: %s", prefx,
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_STATUS\tValue: %s", prefx,
                           PMIx_Error_string(src->data.status));
             break;
         case PMIX_PROC:
             if (NULL == src->data.proc) {
-                rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_PROC\tNULL", prefx);
+                rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_PROC\tNULL", prefx);
             } else {
-                rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_PROC\t%s:%lu",
+                rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_PROC\t%s:%lu",
                               prefx, src->data.proc->nspace, (unsigned long)src->data.proc->rank);
             }
             break;
         case PMIX_BYTE_OBJECT:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: BYTE_OBJECT\tSIZE: %ld",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: BYTE_OBJECT\tSIZE: %ld",
                           prefx, (long)src->data.bo.size);
             break;
         case PMIX_PERSIST:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_PERSIST\tValue: %d",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_PERSIST\tValue: %d",
                           prefx, (int)src->data.persist);
             break;
         case PMIX_SCOPE:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_SCOPE\tValue: %d",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_SCOPE\tValue: %d",
                           prefx, (int)src->data.scope);
             break;
         case PMIX_DATA_RANGE:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_DATA_RANGE\tValue: %d",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_DATA_RANGE\tValue: %d",
                           prefx, (int)src->data.range);
             break;
         case PMIX_PROC_STATE:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_STATE\tValue: %d",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_STATE\tValue: %d",
                           prefx, (int)src->data.state);
             break;
         case PMIX_PROC_INFO:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_PROC_INFO\tValue: %s:%lu",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_PROC_INFO\tValue: %s:%lu",
                           prefx, src->data.proc->nspace, (unsigned long)src->data.proc->rank);
             break;
         case PMIX_DATA_ARRAY:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: DATA_ARRAY\tARRAY SIZE: %ld",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: DATA_ARRAY\tARRAY SIZE: %ld",
                           prefx, (long)src->data.darray->size);
             break;
         case PMIX_ENVAR:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: PMIX_ENVAR\tName: %s\tValue: %s\tSeparator: %c",
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: PMIX_ENVAR\tName: %s\tValue: %s\tSeparator: %c",
                           prefx, (NULL == src->data.envar.envar) ? "NULL" : src->data.envar.envar,
                           (NULL == src->data.envar.value) ? "NULL" : src->data.envar.value,
                           src->data.envar.separator);
             break;
 
         default:
-            rc = asprintf(output, "%sPMIX_VALUE: Data type: UNKNOWN\tValue: UNPRINTABLE", prefx);
+            rc = snprintf(buf, size, "%sPMIX_VALUE: Data type: UNKNOWN\tValue: UNPRINTABLE", prefx);
             break;
     }
-    if (prefx != prefix) {
-        free(prefx);
+    return rc;
+}
+
+static int copy_out(char **output, char *buf, int len)
+{
+    *output = (char*)malloc(len + 1);
+    if (NULL == *output) {
+        return -1;
+    }
+    memcpy(*output, buf, len + 1);
+    return len;
+}
+
+/*
+ * PMIX_VALUE
+ */
+int pmix_bfrops_base_print_value(char **output, char *prefix,
+                                 pmix_value_t *src, pmix_data_type_t type)
+{
+    char buf[PMIX_PRINT_BUFSIZE];
+    char *prefx;
+    int rc;
+
+    /* deal with NULL prefix */
+    prefx = (NULL == prefix) ? " " : prefix;
+
+    /* if src is NULL, just print data type and return */
+    if (NULL == src) {
+        rc = asprintf(output, "%sData type: PMIX_VALUE\tValue: NULL pointer", prefx);
+        if (0 > rc) {
+            return PMIX_ERR_OUT_OF_RESOURCE;
+        } else {
+            return PMIX_SUCCESS;
+        }
+    }
+
+    rc = format_value(buf, sizeof(buf), prefx, src);
+    if (0 <= rc && rc < (int)sizeof(buf)) {
+        rc = copy_out(output, buf, rc);
+    } else if (0 <= rc) {
+        /* too long for the stack - size it exactly */
+        if (NULL == (*output = (char*)malloc(rc + 1))) {
+            rc = -1;
+        } else {
+            rc = format_value(*output, rc + 1, prefx, src);
+        }
     }
     if (0 > rc) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -1038,15 +821,26 @@ int pmix_bfrops_base_print_status(char **output, char *prefix,
 int pmix_bfrops_base_print_info(char **output, char *prefix,
                                 pmix_info_t *src, pmix_data_type_t type)
 {
-    char *tmp=NULL, *tmp2=NULL;
+    char buf[PMIX_PRINT_BUFSIZE];
+    char *tmp = buf;
     int ret;
 
-    pmix_bfrops_base_print_value(&tmp, NULL, &src->value, PMIX_VALUE);
-    pmix_bfrops_base_print_info_directives(&tmp2, NULL, &src->flags, PMIX_INFO_DIRECTIVES);
-    ret = asprintf(output, "%sKEY: %s\n%s\t%s\n%s\t%s", prefix, src->key,
-                   prefix, tmp2, prefix, tmp);
-    free(tmp);
-    free(tmp2);
+    /* the value goes on the stack unless it is too long */
+    ret = format_value(buf, sizeof(buf), " ", &src->value);
+    if (0 <= ret && ret >= (int)sizeof(buf)) {
+        if (NULL == (tmp = (char*)malloc(ret + 1))) {
+            return PMIX_ERR_OUT_OF_RESOURCE;
+        }
+        format_value(tmp, ret + 1, " ", &src->value);
+    } else if (0 > ret) {
+        buf[0] = '\0';
+    }
+    ret = asprintf(output, "%sKEY: %s\n%s\t Data type: PMIX_INFO_DIRECTIVES\tValue: %s\n%s\t%s",
+                   prefix, src->key, prefix, PMIx_Info_directives_string(src->flags),
+                   prefix, tmp);
+    if (tmp != buf) {
+        free(tmp);
+    }
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
     } else {
@@ -1057,17 +851,25 @@ int pmix_bfrops_base_print_info(char **output, char *prefix,
 int pmix_bfrops_base_print_pdata(char **output, char *prefix,
                                  pmix_pdata_t *src, pmix_data_type_t type)
 {
-    char *tmp1, *tmp2;
+    char buf[PMIX_PRINT_BUFSIZE];
+    char *tmp1, *tmp2 = buf;
     int ret;
 
     pmix_bfrops_base_print_proc(&tmp1, NULL, &src->proc, PMIX_PROC);
-    pmix_bfrops_base_print_value(&tmp2, NULL, &src->value, PMIX_VALUE);
+    ret = format_value(buf, sizeof(buf), " ", &src->value);
+    if (0 <= ret && ret >= (int)sizeof(buf)) {
+        if (NULL != (tmp2 = (char*)malloc(ret + 1))) {
+            format_value(tmp2, ret + 1, " ", &src->value);
+        }
+    } else if (0 > ret) {
+        tmp2 = NULL;
+    }
     ret = asprintf(output, "%s  %s  KEY: %s %s", prefix, tmp1, src->key,
                    (NULL == tmp2) ? "NULL" : tmp2);
     if (NULL != tmp1) {
         free(tmp1);
     }
-    if (NULL != tmp2) {
+    if (NULL != tmp2 && tmp2 != buf) {
         free(tmp2);
     }
     if (0 > ret) {
@@ -1096,13 +898,7 @@ int pmix_bfrops_base_print_proc(char **output, char *prefix,
     int rc;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     switch(src->rank) {
         case PMIX_RANK_UNDEF:
@@ -1122,9 +918,6 @@ int pmix_bfrops_base_print_proc(char **output, char *prefix,
                           "%sPROC: %s:%lu", prefx, src->nspace,
                           (unsigned long)(src->rank));
     }
-    if (prefx != prefix) {
-        free(prefx);
-    }
     if (0 > rc) {
         return PMIX_ERR_NOMEM;
     }
@@ -1143,31 +936,19 @@ int pmix_bfrops_base_print_persist(char **output, char *prefix,
     char *prefx;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         if (0 > asprintf(output, "%sData type: PMIX_PERSIST\tValue: NULL pointer", prefx)) {
             return PMIX_ERR_NOMEM;
         }
-        if (prefx != prefix) {
-            free(prefx);
-        }
         return PMIX_SUCCESS;
     }
 
     if (0 > asprintf(output, "%sData type: PMIX_PERSIST\tValue: %ld", prefx, (long) *src)) {
         return PMIX_ERR_NOMEM;
     }
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     return PMIX_SUCCESS;
 }
@@ -1179,21 +960,12 @@ pmix_status_t pmix_bfrops_base_print_scope(char **output, char *prefix,
     char *prefx;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     if (0 > asprintf(output, "%sData type: PMIX_SCOPE\tValue: %s",
                      prefx, PMIx_Scope_string(*src))) {
         return PMIX_ERR_NOMEM;
     }
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     return PMIX_SUCCESS;
 }
@@ -1205,21 +977,12 @@ pmix_status_t pmix_bfrops_base_print_range(char **output, char *prefix,
     char *prefx;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     if (0 > asprintf(output, "%sData type: PMIX_DATA_RANGE\tValue: %s",
                      prefx, PMIx_Data_range_string(*src))) {
         return PMIX_ERR_NOMEM;
     }
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     return PMIX_SUCCESS;
 }
@@ -1230,21 +993,12 @@ pmix_status_t pmix_bfrops_base_print_cmd(char **output, char *prefix,
     char *prefx;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     if (0 > asprintf(output, "%sData type: PMIX_COMMAND\tValue: %s",
                      prefx, pmix_command_string(*src))) {
         return PMIX_ERR_NOMEM;
     }
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     return PMIX_SUCCESS;
 }
@@ -1256,21 +1010,12 @@ pmix_status_t pmix_bfrops_base_print_info_directives(char **output, char *prefix
     char *prefx;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     if (0 > asprintf(output, "%sData type: PMIX_INFO_DIRECTIVES\tValue: %s",
                      prefx, PMIx_Info_directives_string(*src))) {
         return PMIX_ERR_NOMEM;
     }
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     return PMIX_SUCCESS;
 }
@@ -1283,20 +1028,11 @@ pmix_status_t pmix_bfrops_base_print_datatype(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_DATA_TYPE\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -1305,9 +1041,6 @@ pmix_status_t pmix_bfrops_base_print_datatype(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_DATA_TYPE\tValue: %s", prefx, PMIx_Data_type_string(*src));
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -1323,20 +1056,11 @@ int pmix_bfrops_base_print_bo(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     /* if src is NULL, just print data type and return */
     if (NULL == src) {
         ret = asprintf(output, "%sData type: PMIX_BYTE_OBJECT\tValue: NULL pointer", prefx);
-        if (prefx != prefix) {
-            free(prefx);
-        }
         if (0 > ret) {
             return PMIX_ERR_OUT_OF_RESOURCE;
         } else {
@@ -1345,9 +1069,6 @@ int pmix_bfrops_base_print_bo(char **output, char *prefix,
     }
 
     ret = asprintf(output, "%sData type: PMIX_BYTE_OBJECT\tSize: %ld", prefx, (long)src->size);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -1363,18 +1084,9 @@ int pmix_bfrops_base_print_ptr(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     ret = asprintf(output, "%sData type: PMIX_POINTER\tAddress: %p", prefx, src);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -1391,19 +1103,10 @@ pmix_status_t pmix_bfrops_base_print_pstate(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     ret = asprintf(output, "%sData type: PMIX_PROC_STATE\tValue: %s",
                    prefx, PMIx_Proc_state_string(*src));
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -1421,13 +1124,7 @@ pmix_status_t pmix_bfrops_base_print_pinfo(char **output, char *prefix,
     char *p2, *tmp;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     if (0 > asprintf(&p2, "%s\t", prefx)) {
         rc = PMIX_ERR_NOMEM;
@@ -1448,9 +1145,6 @@ pmix_status_t pmix_bfrops_base_print_pinfo(char **output, char *prefix,
     }
 
   done:
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     return rc;
 }
@@ -1463,19 +1157,10 @@ pmix_status_t pmix_bfrops_base_print_darray(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     ret = asprintf(output, "%sData type: PMIX_DATA_ARRAY\tSize: %lu",
                    prefx, (unsigned long)src->size);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -1494,13 +1179,7 @@ pmix_status_t pmix_bfrops_base_print_query(char **output, char *prefix,
     size_t n;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     if (0 > asprintf(&p2, "%s\t", prefx)) {
         rc = PMIX_ERR_NOMEM;
@@ -1550,9 +1229,6 @@ pmix_status_t pmix_bfrops_base_print_query(char **output, char *prefix,
     *output = tmp;
 
   done:
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     return rc;
 }
@@ -1565,13 +1241,7 @@ pmix_status_t pmix_bfrops_base_print_rank(char **output, char *prefix,
     int rc;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     switch(*src) {
         case PMIX_RANK_UNDEF:
@@ -1593,9 +1263,6 @@ pmix_status_t pmix_bfrops_base_print_rank(char **output, char *prefix,
             rc = asprintf(output, "%sData type: PMIX_PROC_RANK\tValue: %lu",
                           prefx, (unsigned long)(*src));
     }
-    if (prefx != prefix) {
-        free(prefx);
-    }
     if (0 > rc) {
         return PMIX_ERR_NOMEM;
     }
@@ -1610,19 +1277,10 @@ pmix_status_t pmix_bfrops_base_print_alloc_directive(char **output, char *prefix
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     ret = asprintf(output, "%sData type: PMIX_ALLOC_DIRECTIVE\tValue: %s",
                    prefx, PMIx_Alloc_directive_string(*src));
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -1639,19 +1297,10 @@ pmix_status_t pmix_bfrops_base_print_iof_channel(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     ret = asprintf(output, "%sData type: PMIX_IOF_CHANNEL\tValue: %s",
                    prefx, PMIx_IOF_channel_string(*src));
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
@@ -1668,21 +1317,12 @@ pmix_status_t pmix_bfrops_base_print_envar(char **output, char *prefix,
     int ret;
 
     /* deal with NULL prefix */
-    if (NULL == prefix) {
-        if (0 > asprintf(&prefx, " ")) {
-            return PMIX_ERR_NOMEM;
-        }
-    } else {
-        prefx = prefix;
-    }
+    prefx = (NULL == prefix) ? " " : prefix;
 
     ret = asprintf(output, "%sData type: PMIX_ENVAR\tName: %s\tValue: %s\tSeparator: %c",
                    prefx, (NULL == src->envar) ? "NULL" : src->envar,
                    (NULL == src->value) ? "NULL" : src->value,
                    ('\0' == src->separator) ? ' ' : src->separator);
-    if (prefx != prefix) {
-        free(prefx);
-    }
 
     if (0 > ret) {
         return PMIX_ERR_OUT_OF_RESOURCE;
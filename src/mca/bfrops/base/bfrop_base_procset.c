@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2018      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <stdio.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#include "src/util/error.h"
+#include "src/include/pmix_globals.h"
+
+#include "src/mca/bfrops/base/base.h"
+
+/* A proc set is sent as a sequence of segments, one for each run of
+ * consecutive entries that share an nspace. Each segment carries its
+ * nspace once, followed by its ranks as either a list of [first,last]
+ * ranges or - when the ranks ascend and are dense enough - a bitmap
+ * offset from the first rank. Expanding the segments in order yields
+ * exactly the array that was packed, so trackers built from it match
+ * those built from the plain encoding. Special ranks such as
+ * PMIX_RANK_WILDCARD never join a run and always go as ranges */
+
+#define PMIX_PROCSET_FORM_RANGES    0
+#define PMIX_PROCSET_FORM_BITMAP    1
+
+/* true if rank b extends a run ending at rank a */
+#define PMIX_PROCSET_NEXT(a, b) \
+    ((b) < PMIX_RANK_LOCAL_PEERS && (a) + 1 == (b))
+
+static pmix_status_t pack_segment(pmix_peer_t *peer, pmix_buffer_t *buf,
+                                  const pmix_proc_t *procs, size_t nprocs)
+{
+    pmix_status_t rc;
+    char *nspace = (char*)procs[0].nspace;
+    uint8_t form = PMIX_PROCSET_FORM_RANGES;
+    uint32_t nranges = 1, nbits;
+    pmix_rank_t *ranges, base;
+    uint8_t *bits;
+    bool ascending = (procs[0].rank < PMIX_RANK_LOCAL_PEERS);
+    size_t n, m;
+
+    for (n=1; n < nprocs; n++) {
+        if (!PMIX_PROCSET_NEXT(procs[n-1].rank, procs[n].rank)) {
+            ++nranges;
+        }
+        if (procs[n].rank >= PMIX_RANK_LOCAL_PEERS ||
+            procs[n].rank <= procs[n-1].rank) {
+            ascending = false;
+        }
+    }
+    /* a bitmap costs a bit per rank it spans, the ranges
+     * two ranks apiece - send whichever is smaller */
+    nbits = 0;
+    if (ascending && 1 < nranges &&
+        (uint64_t)(procs[nprocs-1].rank - procs[0].rank) / 8 + 1 <
+        (uint64_t)nranges * 2 * sizeof(pmix_rank_t)) {
+        form = PMIX_PROCSET_FORM_BITMAP;
+        nbits = procs[nprocs-1].rank - procs[0].rank + 1;
+    }
+
+    PMIX_BFROPS_PACK(rc, peer, buf, &nspace, 1, PMIX_STRING);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    PMIX_BFROPS_PACK(rc, peer, buf, &form, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    if (PMIX_PROCSET_FORM_BITMAP == form) {
+        base = procs[0].rank;
+        bits = (uint8_t*)calloc((nbits + 7) / 8, sizeof(uint8_t));
+        if (NULL == bits) {
+            return PMIX_ERR_NOMEM;
+        }
+        for (n=0; n < nprocs; n++) {
+            m = procs[n].rank - base;
+            bits[m / 8] |= (uint8_t)(1 << (m % 8));
+        }
+        PMIX_BFROPS_PACK(rc, peer, buf, &base, 1, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, peer, buf, &nbits, 1, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, peer, buf, bits, (nbits + 7) / 8, PMIX_BYTE);
+        }
+        free(bits);
+        return rc;
+    }
+
+    ranges = (pmix_rank_t*)malloc(2 * nranges * sizeof(pmix_rank_t));
+    if (NULL == ranges) {
+        return PMIX_ERR_NOMEM;
+    }
+    ranges[0] = procs[0].rank;
+    m = 0;
+    for (n=1; n < nprocs; n++) {
+        if (!PMIX_PROCSET_NEXT(procs[n-1].rank, procs[n].rank)) {
+            ranges[m+1] = procs[n-1].rank;
+            m += 2;
+            ranges[m] = procs[n].rank;
+        }
+    }
+    ranges[m+1] = procs[nprocs-1].rank;
+    PMIX_BFROPS_PACK(rc, peer, buf, &nranges, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, peer, buf, ranges, 2 * nranges, PMIX_PROC_RANK);
+    }
+    free(ranges);
+    return rc;
+}
+
+pmix_status_t pmix_bfrops_base_pack_procset(struct pmix_peer_t *pr,
+                                            pmix_buffer_t *buf,
+                                            const pmix_proc_t *procs,
+                                            size_t nprocs, bool ranges)
+{
+    pmix_peer_t *peer = (pmix_peer_t*)pr;
+    pmix_status_t rc;
+    size_t marker = PMIX_BFROPS_PROCSET_RANGES;
+    size_t n, start;
+    uint32_t nsegs;
+
+    if (!ranges || 0 == nprocs) {
+        /* the plain encoding every server understands */
+        PMIX_BFROPS_PACK(rc, peer, buf, &nprocs, 1, PMIX_SIZE);
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        if (0 < nprocs) {
+            PMIX_BFROPS_PACK(rc, peer, buf, procs, nprocs, PMIX_PROC);
+        }
+        return rc;
+    }
+
+    nsegs = 1;
+    for (n=1; n < nprocs; n++) {
+        if (0 != strncmp(procs[n].nspace, procs[n-1].nspace, PMIX_MAX_NSLEN)) {
+            ++nsegs;
+        }
+    }
+    PMIX_BFROPS_PACK(rc, peer, buf, &marker, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    PMIX_BFROPS_PACK(rc, peer, buf, &nprocs, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    PMIX_BFROPS_PACK(rc, peer, buf, &nsegs, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    start = 0;
+    for (n=1; n <= nprocs; n++) {
+        if (n == nprocs ||
+            0 != strncmp(procs[n].nspace, procs[n-1].nspace, PMIX_MAX_NSLEN)) {
+            if (PMIX_SUCCESS != (rc = pack_segment(peer, buf, &procs[start], n - start))) {
+                return rc;
+            }
+            start = n;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t unpack_segment(pmix_peer_t *peer, pmix_buffer_t *buf,
+                                    pmix_proc_t *procs, size_t nprocs,
+                                    size_t *nused)
+{
+    pmix_status_t rc;
+    char *nspace = NULL;
+    uint8_t form;
+    uint32_t nranges, nbits, n;
+    pmix_rank_t *ranges = NULL, base, r;
+    uint8_t *bits = NULL;
+    size_t m = 0;
+    int32_t cnt;
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &nspace, &cnt, PMIX_STRING);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (NULL == nspace) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &form, &cnt, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        goto cleanup;
+    }
+
+    if (PMIX_PROCSET_FORM_BITMAP == form) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, peer, buf, &base, &cnt, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS != rc) {
+            goto cleanup;
+        }
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, peer, buf, &nbits, &cnt, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            goto cleanup;
+        }
+        if (0 == nbits || INT32_MAX - 7 < nbits ||
+            (uint64_t)base + nbits > PMIX_RANK_LOCAL_PEERS) {
+            rc = PMIX_ERR_UNPACK_FAILURE;
+            goto cleanup;
+        }
+        if (NULL == (bits = (uint8_t*)malloc((nbits + 7) / 8))) {
+            rc = PMIX_ERR_NOMEM;
+            goto cleanup;
+        }
+        cnt = (nbits + 7) / 8;
+        PMIX_BFROPS_UNPACK(rc, peer, buf, bits, &cnt, PMIX_BYTE);
+        if (PMIX_SUCCESS != rc) {
+            goto cleanup;
+        }
+        for (n=0; n < nbits; n++) {
+            if (!(bits[n / 8] & (1 << (n % 8)))) {
+                continue;
+            }
+            if (m == nprocs) {
+                rc = PMIX_ERR_UNPACK_FAILURE;
+                goto cleanup;
+            }
+            pmix_strncpy(procs[m].nspace, nspace, PMIX_MAX_NSLEN);
+            procs[m].rank = base + n;
+            ++m;
+        }
+    } else if (PMIX_PROCSET_FORM_RANGES == form) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, peer, buf, &nranges, &cnt, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            goto cleanup;
+        }
+        if (0 == nranges || nprocs < nranges || INT32_MAX / 2 < nranges) {
+            rc = PMIX_ERR_UNPACK_FAILURE;
+            goto cleanup;
+        }
+        if (NULL == (ranges = (pmix_rank_t*)malloc(2 * nranges * sizeof(pmix_rank_t)))) {
+            rc = PMIX_ERR_NOMEM;
+            goto cleanup;
+        }
+        cnt = 2 * nranges;
+        PMIX_BFROPS_UNPACK(rc, peer, buf, ranges, &cnt, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS != rc) {
+            goto cleanup;
+        }
+        for (n=0; n < nranges; n++) {
+            /* a special rank is only ever sent on its own */
+            if (ranges[2*n] > ranges[2*n+1] ||
+                (ranges[2*n+1] >= PMIX_RANK_LOCAL_PEERS && ranges[2*n] != ranges[2*n+1]) ||
+                (uint64_t)(ranges[2*n+1] - ranges[2*n]) >= nprocs - m) {
+                rc = PMIX_ERR_UNPACK_FAILURE;
+                goto cleanup;
+            }
+            r = ranges[2*n];
+            do {
+                pmix_strncpy(procs[m].nspace, nspace, PMIX_MAX_NSLEN);
+                procs[m].rank = r;
+                ++m;
+            } while (r++ != ranges[2*n+1]);
+        }
+    } else {
+        rc = PMIX_ERR_UNPACK_FAILURE;
+        goto cleanup;
+    }
+    *nused = m;
+
+  cleanup:
+    free(nspace);
+    if (NULL != ranges) {
+        free(ranges);
+    }
+    if (NULL != bits) {
+        free(bits);
+    }
+    return rc;
+}
+
+pmix_status_t pmix_bfrops_base_unpack_procset(struct pmix_peer_t *pr,
+                                              pmix_buffer_t *buf,
+                                              pmix_proc_t **procs,
+                                              size_t *nprocs)
+{
+    pmix_peer_t *peer = (pmix_peer_t*)pr;
+    pmix_status_t rc;
+    pmix_proc_t *p;
+    size_t np, m, nused;
+    uint32_t nsegs, n;
+    int32_t cnt;
+
+    *procs = NULL;
+    *nprocs = 0;
+
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &np, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (0 == np) {
+        return PMIX_SUCCESS;
+    }
+
+    if (PMIX_BFROPS_PROCSET_RANGES != np) {
+        PMIX_PROC_CREATE(p, np);
+        if (NULL == p) {
+            return PMIX_ERR_NOMEM;
+        }
+        cnt = np;
+        PMIX_BFROPS_UNPACK(rc, peer, buf, p, &cnt, PMIX_PROC);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_PROC_FREE(p, np);
+            return rc;
+        }
+        *procs = p;
+        *nprocs = np;
+        return PMIX_SUCCESS;
+    }
+
+    /* range-encoded - the total count lets us size the array once
+     * and catch a sender that disagrees with itself */
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &np, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &nsegs, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (0 == np || 0 == nsegs || np < nsegs) {
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    PMIX_PROC_CREATE(p, np);
+    if (NULL == p) {
+        return PMIX_ERR_NOMEM;
+    }
+    m = 0;
+    for (n=0; n < nsegs; n++) {
+        rc = unpack_segment(peer, buf, &p[m], np - m, &nused);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_PROC_FREE(p, np);
+            return rc;
+        }
+        m += nused;
+    }
+    if (m != np) {
+        PMIX_PROC_FREE(p, np);
+        return PMIX_ERR_UNPACK_FAILURE;
+    }
+    *procs = p;
+    *nprocs = np;
+    return PMIX_SUCCESS;
+}
@@ -338,12 +338,19 @@ pmix_status_t pmix_bfrops_base_unpack_int16(pmix_buffer_t *buffer, void *dest,
     }
 
     /* unpack the data */
+#if defined(WORDS_BIGENDIAN)
+    memcpy(desttmp, buffer->unpack_ptr, (*num_vals) * sizeof(tmp));
+#else
+    /* advance the buffer once at the end so the loop
+     * doesn't store through the buffer object and the
+     * compiler is free to vectorize the conversion */
     for (i = 0; i < (*num_vals); ++i) {
-        memcpy( &(tmp), buffer->unpack_ptr, sizeof(tmp) );
+        memcpy(&tmp, buffer->unpack_ptr + i * sizeof(tmp), sizeof(tmp));
         tmp = pmix_ntohs(tmp);
         memcpy(&desttmp[i], &tmp, sizeof(tmp));
-        buffer->unpack_ptr += sizeof(tmp);
     }
+#endif
+    buffer->unpack_ptr += (*num_vals) * sizeof(tmp);
 
     return PMIX_SUCCESS;
 }
@@ -363,12 +370,16 @@ pmix_status_t pmix_bfrops_base_unpack_int32(pmix_buffer_t *buffer, void *dest,
     }
 
     /* unpack the data */
+#if defined(WORDS_BIGENDIAN)
+    memcpy(desttmp, buffer->unpack_ptr, (*num_vals) * sizeof(tmp));
+#else
     for (i = 0; i < (*num_vals); ++i) {
-        memcpy( &(tmp), buffer->unpack_ptr, sizeof(tmp) );
+        memcpy(&tmp, buffer->unpack_ptr + i * sizeof(tmp), sizeof(tmp));
         tmp = ntohl(tmp);
         memcpy(&desttmp[i], &tmp, sizeof(tmp));
-        buffer->unpack_ptr += sizeof(tmp);
     }
+#endif
+    buffer->unpack_ptr += (*num_vals) * sizeof(tmp);
 
     return PMIX_SUCCESS;
 }
@@ -394,12 +405,16 @@ pmix_status_t pmix_bfrops_base_unpack_int64(pmix_buffer_t *buffer, void *dest,
     }
 
     /* unpack the data */
+#if defined(WORDS_BIGENDIAN)
+    memcpy(desttmp, buffer->unpack_ptr, (*num_vals) * sizeof(tmp));
+#else
     for (i = 0; i < (*num_vals); ++i) {
-        memcpy( &(tmp), buffer->unpack_ptr, sizeof(tmp) );
+        memcpy(&tmp, buffer->unpack_ptr + i * sizeof(tmp), sizeof(tmp));
         tmp = pmix_ntoh64(tmp);
         memcpy(&desttmp[i], &tmp, sizeof(tmp));
-        buffer->unpack_ptr += sizeof(tmp);
     }
+#endif
+    buffer->unpack_ptr += (*num_vals) * sizeof(tmp);
 
     return PMIX_SUCCESS;
 }
@@ -1136,6 +1151,64 @@ pmix_status_t pmix_bfrops_base_unpack_bo(pmix_buffer_t *buffer, void *dest,
     return PMIX_SUCCESS;
 }
 
+/*
+ * Unpack a single byte object without copying its payload - the
+ * returned object points into the buffer and is only valid for
+ * as long as the buffer's payload is left untouched. The caller
+ * must NOT free it
+ */
+pmix_status_t pmix_bfrops_base_unpack_borrow(pmix_buffer_t *buffer,
+                                             pmix_byte_object_t *bo)
+{
+    pmix_status_t ret;
+    pmix_data_type_t local_type;
+    int32_t local_num, m=1;
+
+    memset(bo, 0, sizeof(pmix_byte_object_t));
+
+    /* the header is the same as for a regular unpack of one value */
+    if (PMIX_BFROP_BUFFER_FULLY_DESC == buffer->type) {
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_get_data_type(buffer, &local_type))) {
+            return ret;
+        }
+        if (PMIX_INT32 != local_type) {
+            PMIX_ERROR_LOG(PMIX_ERR_UNPACK_FAILURE);
+            return PMIX_ERR_UNPACK_FAILURE;
+        }
+    }
+    if (PMIX_SUCCESS != (ret = pmix_bfrops_base_unpack_int32(buffer, &local_num, &m, PMIX_INT32))) {
+        return ret;
+    }
+    if (1 != local_num) {
+        PMIX_ERROR_LOG(PMIX_ERR_UNPACK_INADEQUATE_SPACE);
+        return PMIX_ERR_UNPACK_INADEQUATE_SPACE;
+    }
+    if (PMIX_BFROP_BUFFER_FULLY_DESC == buffer->type) {
+        if (PMIX_SUCCESS != (ret = pmix_bfrop_get_data_type(buffer, &local_type))) {
+            return ret;
+        }
+        if (PMIX_BYTE_OBJECT != local_type) {
+            pmix_output(0, "PMIX bfrop:unpack: got type %d when expecting type %d",
+                        local_type, PMIX_BYTE_OBJECT);
+            return PMIX_ERR_PACK_MISMATCH;
+        }
+    }
+
+    m=1;
+    if (PMIX_SUCCESS != (ret = pmix_bfrops_base_unpack_sizet(buffer, &bo->size, &m, PMIX_SIZE))) {
+        return ret;
+    }
+    if (0 < bo->size) {
+        if (pmix_bfrop_too_small(buffer, bo->size)) {
+            bo->size = 0;
+            return PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER;
+        }
+        bo->bytes = buffer->unpack_ptr;
+        buffer->unpack_ptr += bo->size;
+    }
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_bfrops_base_unpack_ptr(pmix_buffer_t *buffer, void *dest,
                                           int32_t *num_vals, pmix_data_type_t type)
 {
@@ -273,6 +273,16 @@ typedef pmix_status_t (*pmix_bfrop_unpack_fn_t)(pmix_buffer_t *buffer, void *des
 typedef pmix_status_t (*pmix_bfrop_copy_payload_fn_t)(pmix_buffer_t *dest,
                                                       pmix_buffer_t *src);
 
+/**
+ * Unpack a byte object by reference
+ * The returned byte object points directly into the buffer's
+ * payload and must not be freed or used beyond the life of
+ * that payload. Modules that cannot return a reference leave
+ * this NULL - see PMIX_BFROPS_UNPACK_BORROW.
+ */
+typedef pmix_status_t (*pmix_bfrop_unpack_borrow_fn_t)(pmix_buffer_t *buffer,
+                                                       pmix_byte_object_t *bo);
+
 /**
  * Copy a data value from one location to another.
  *
@@ -372,6 +382,7 @@ typedef struct {
     pmix_bfrop_copy_fn_t              copy;
     pmix_bfrop_print_fn_t             print;
     pmix_bfrop_copy_payload_fn_t      copy_payload;
+    pmix_bfrop_unpack_borrow_fn_t     unpack_borrow;
     pmix_bfrop_value_xfer_fn_t        value_xfer;
     pmix_bfrop_value_load_fn_t        value_load;
     pmix_bfrop_value_unload_fn_t      value_unload;
@@ -388,6 +399,23 @@ PMIX_EXPORT char* pmix_bfrops_base_get_available_modules(void);
 /* Select a bfrops module for a given version */
 PMIX_EXPORT pmix_bfrops_module_t* pmix_bfrops_base_assign_module(const char *version);
 
+/* make room for the given number of bytes in a buffer so that
+ * subsequent packs of that much data don't have to regrow it */
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_reserve(pmix_buffer_t *buffer, size_t bytes);
+
+/* estimate the packed size of the provided values - the result
+ * is suitable for passing to pmix_bfrops_base_reserve */
+PMIX_EXPORT size_t pmix_bfrops_base_sizeof(const void *src, size_t num_vals,
+                                           pmix_data_type_t type);
+
+/* return a kval that shares the value of the given one rather
+ * than copying it - the result must be treated as read-only */
+PMIX_EXPORT pmix_kval_t* pmix_bfrops_base_kval_share(pmix_kval_t *kv);
+
+/* give a shared kval its own copy of the value so it can be
+ * modified - a no-op if the value isn't shared */
+PMIX_EXPORT pmix_status_t pmix_bfrops_base_kval_own(pmix_kval_t *kv);
+
 /* provide a backdoor to access the framework debug output */
 PMIX_EXPORT extern int pmix_bfrops_base_output;
 
@@ -424,6 +452,24 @@ PMIX_EXPORT extern int pmix_bfrops_base_output;
         }                                                           \
     } while(0)
 
+/* unpack a byte object, referencing the buffer's payload where
+ * the module supports it. The bool c is set to true if the data
+ * had to be copied instead, in which case the caller owns it */
+#define PMIX_BFROPS_UNPACK_BORROW(r, p, b, bo, c)                   \
+    do {                                                            \
+        int32_t _n = 1;                                             \
+        if ((b)->type != (p)->nptr->compat.type) {                  \
+            (r) = PMIX_ERR_UNPACK_FAILURE;                          \
+        } else if (NULL != (p)->nptr->compat.bfrops->unpack_borrow) { \
+            (c) = false;                                            \
+            (r) = (p)->nptr->compat.bfrops->unpack_borrow(b, bo);   \
+        } else {                                                    \
+            (c) = true;                                             \
+            (r) = (p)->nptr->compat.bfrops->unpack(b, bo, &_n,      \
+                                                   PMIX_BYTE_OBJECT); \
+        }                                                           \
+    } while(0)
+
 #define PMIX_BFROPS_COPY(r, p, d, s, t)             \
     (r) = (p)->nptr->compat.bfrops->copy(d, s, t)
 
@@ -58,11 +58,14 @@ typedef uint8_t pmix_bfrop_buffer_type_t;
 
 /* internally used object for transferring data
  * to/from the server and for storing in the
- * hash tables */
-typedef struct {
+ * hash tables. If shared is set, the value belongs
+ * to that kval (on which we hold a reference) and
+ * must be treated as read-only */
+typedef struct pmix_kval_t {
     pmix_list_item_t super;
     char *key;
     pmix_value_t *value;
+    struct pmix_kval_t *shared;
 } pmix_kval_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_kval_t);
 
@@ -55,6 +55,7 @@ pmix_bfrops_module_t pmix_bfrops_pmix21_module = {
     .copy = pmix21_copy,
     .print = pmix21_print,
     .copy_payload = pmix_bfrops_base_copy_payload,
+    .unpack_borrow = pmix_bfrops_base_unpack_borrow,
     .value_xfer = pmix_bfrops_base_value_xfer,
     .value_load = pmix_bfrops_base_value_load,
     .value_unload = pmix_bfrops_base_value_unload,
@@ -55,6 +55,7 @@ pmix_bfrops_module_t pmix_bfrops_pmix3_module = {
     .copy = pmix3_copy,
     .print = pmix3_print,
     .copy_payload = pmix_bfrops_base_copy_payload,
+    .unpack_borrow = pmix_bfrops_base_unpack_borrow,
     .value_xfer = pmix_bfrops_base_value_xfer,
     .value_load = pmix_bfrops_base_value_load,
     .value_unload = pmix_bfrops_base_value_unload,
@@ -445,13 +446,59 @@ static void finalize(void)
     }
 }
 
+/* the types that dominate our traffic are bound directly to their
+ * base pack functions so we can skip the registry lookup for them.
+ * These must match the functions registered in init */
+static inline pmix_bfrop_pack_fn_t pmix3_fast_pack_fn(pmix_data_type_t type)
+{
+    switch (type) {
+        case PMIX_INT32:
+        case PMIX_UINT32:
+            return pmix_bfrops_base_pack_int32;
+        case PMIX_STRING:
+            return pmix_bfrops_base_pack_string;
+        case PMIX_PROC:
+            return pmix_bfrops_base_pack_proc;
+        case PMIX_VALUE:
+            return pmix_bfrops_base_pack_value;
+        case PMIX_KVAL:
+            return pmix_bfrops_base_pack_kval;
+        case PMIX_BYTE_OBJECT:
+            return pmix_bfrops_base_pack_bo;
+        default:
+            return NULL;
+    }
+}
+
 static pmix_status_t pmix3_pack(pmix_buffer_t *buffer,
                                 const void *src, int num_vals,
                                 pmix_data_type_t type)
 {
-    /* kick the process off by passing this in to the base */
-    return pmix_bfrops_base_pack(&mca_bfrops_v3_component.types,
-                                 buffer, src, num_vals, type);
+    pmix_bfrop_pack_fn_t packfn;
+    pmix_status_t rc;
+
+    if (NULL == buffer || NULL == src ||
+        NULL == (packfn = pmix3_fast_pack_fn(type))) {
+        /* kick the process off by passing this in to the base */
+        return pmix_bfrops_base_pack(&mca_bfrops_v3_component.types,
+                                     buffer, src, num_vals, type);
+    }
+
+    /* same layout as pmix_bfrops_base_pack */
+    if (PMIX_BFROP_BUFFER_FULLY_DESC == buffer->type) {
+        if (PMIX_SUCCESS != (rc = pmix_bfrop_store_data_type(buffer, PMIX_INT32))) {
+            return rc;
+        }
+    }
+    if (PMIX_SUCCESS != (rc = pmix_bfrops_base_pack_int32(buffer, &num_vals, 1, PMIX_INT32))) {
+        return rc;
+    }
+    if (PMIX_BFROP_BUFFER_FULLY_DESC == buffer->type) {
+        if (PMIX_SUCCESS != (rc = pmix_bfrop_store_data_type(buffer, type))) {
+            return rc;
+        }
+    }
+    return packfn(buffer, src, num_vals, type);
 }
 
 static pmix_status_t pmix3_unpack(pmix_buffer_t *buffer, void *dest,
@@ -43,10 +43,13 @@
 #include "src/server/pmix_server_ops.h"
 #include "src/util/argv.h"
 #include "src/util/compress.h"
+#include "src/util/crc.h"
 #include "src/util/error.h"
 #include "src/util/output.h"
 #include "src/util/pmix_environ.h"
 #include "src/util/hash.h"
+#include "src/runtime/pmix_progress_threads.h"
+#include "src/threads/mutex.h"
 #include "src/mca/preg/preg.h"
 
 #include "src/mca/gds/base/base.h"
@@ -63,6 +66,9 @@
 #define ESH_ENV_LINEAR              "SM_USE_LINEAR_SEARCH"
 
 #define ESH_INIT_SESSION_TBL_SIZE 2
+/* default share of a rank's region that may be invalidated
+ * entries before the live ones are rewritten */
+#define ESH_COMPACT_PCT           50
 #define ESH_INIT_NS_MAP_TBL_SIZE  2
 
 static int _store_data_for_rank(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
@@ -78,7 +84,7 @@ static ns_track_elem_t *_get_track_elem_for_namespace(pmix_common_dstore_ctx_t *
 static rank_meta_info *_get_rank_meta_info(pmix_common_dstore_ctx_t *ds_ctx, pmix_rank_t rank,
                                            pmix_dstore_seg_desc_t *segdesc);
 static uint8_t *_get_data_region_by_offset(pmix_common_dstore_ctx_t *ds_ctx,
-                                           pmix_dstore_seg_desc_t *segdesc, size_t offset);
+                                           ns_track_elem_t *elem, size_t offset);
 static void _update_initial_segment_info(pmix_common_dstore_ctx_t *ds_ctx,
                                          const ns_map_data_t *ns_map);
 static void _set_constants_from_env(pmix_common_dstore_ctx_t *ds_ctx);
@@ -107,7 +113,21 @@ static inline pmix_peer_t * _client_peer(pmix_common_dstore_ctx_t *ds_ctx);
 
 static inline int _my_client(const char *nspace, pmix_rank_t rank);
 
-static pmix_status_t _dstor_store_modex_cb(pmix_common_dstore_ctx_t *ds_ctx,
+/* the kvals of one remote rank from a modex delivery, staged
+ * until they can all be written under a single lock */
+typedef struct {
+    pmix_list_item_t super;
+    ns_map_data_t *ns_map;
+    pmix_rank_t rank;
+    pmix_buffer_t buf;
+} dstor_modex_stage_t;
+
+typedef struct {
+    pmix_common_dstore_ctx_t *ds_ctx;
+    pmix_list_t staged;
+} dstor_modex_batch_t;
+
+static pmix_status_t _dstor_store_modex_cb(dstor_modex_batch_t *batch,
                                                 struct pmix_namespace_t *nspace,
                                                 pmix_list_t *cbs,
                                                 pmix_byte_object_t *bo);
@@ -117,9 +137,15 @@ static pmix_status_t _dstore_store_nolock(pmix_common_dstore_ctx_t *ds_ctx,
                                    pmix_rank_t rank,
                                    pmix_kval_t *kv);
 
+static pmix_status_t _dstore_store_buf_nolock(pmix_common_dstore_ctx_t *ds_ctx,
+                                              ns_map_data_t *ns_map,
+                                              pmix_rank_t rank,
+                                              pmix_buffer_t *buf);
+
 static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
                                    const char *nspace, pmix_rank_t rank,
-                                   const char *key, pmix_value_t **kvs);
+                                   const char *key, char **keys,
+                                   pmix_value_t **kvs);
 
 ns_map_data_t * (*_esh_session_map_search)(const char *nspace) = NULL;
 
@@ -165,18 +191,75 @@ __pmix_attribute_extension__ ({                                                \
     rc;                                                                        \
 })
 
+/* Releasing a session means unmapping all of its segments and
+ * removing its directory, which takes a while for a big job. The
+ * server renames the directory out of the way - so the path can be
+ * reused at once - and leaves the rest to a thread of its own */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_event_t ev;
+    pmix_dstore_seg_desc_t *segs[3];
+    char *path;
+} dstor_reclaim_t;
+static void rcon(dstor_reclaim_t *p)
+{
+    memset(p->segs, 0, sizeof(p->segs));
+    p->path = NULL;
+}
+static void rdes(dstor_reclaim_t *p)
+{
+    if (NULL != p->path) {
+        free(p->path);
+    }
+}
+static PMIX_CLASS_INSTANCE(dstor_reclaim_t,
+                           pmix_list_item_t,
+                           rcon, rdes);
+
+static void stcon(dstor_modex_stage_t *p)
+{
+    p->ns_map = NULL;
+    p->rank = PMIX_RANK_UNDEF;
+    PMIX_CONSTRUCT(&p->buf, pmix_buffer_t);
+}
+static void stdes(dstor_modex_stage_t *p)
+{
+    PMIX_DESTRUCT(&p->buf);
+}
+static PMIX_CLASS_INSTANCE(dstor_modex_stage_t,
+                           pmix_list_item_t,
+                           stcon, stdes);
+
+#define DSTOR_RECLAIM_THREAD "DSTORE-RECLAIM"
+static pmix_event_base_t *reclaim_evbase = NULL;
+static pmix_list_t reclaim_pending;
+static pmix_mutex_t reclaim_lock = PMIX_MUTEX_STATIC_INIT;
+static unsigned long reclaim_count = 0;
+
 static void ncon(ns_track_elem_t *p) {
     memset(&p->ns_map, 0, sizeof(p->ns_map));
     p->meta_seg = NULL;
     p->data_seg = NULL;
     p->num_meta_seg = 0;
     p->num_data_seg = 0;
+    p->data_segs_idx = NULL;
+    p->ndata_segs_idx = 0;
+    p->verified = NULL;
     p->in_use = true;
 }
 
 static void ndes(ns_track_elem_t *p) {
     pmix_common_dstor_delete_sm_desc(p->meta_seg);
     pmix_common_dstor_delete_sm_desc(p->data_seg);
+    if (NULL != p->data_segs_idx) {
+        free(p->data_segs_idx);
+        p->data_segs_idx = NULL;
+    }
+    p->ndata_segs_idx = 0;
+    if (NULL != p->verified) {
+        PMIX_RELEASE(p->verified);
+        p->verified = NULL;
+    }
     memset(&p->ns_map, 0, sizeof(p->ns_map));
     p->in_use = false;
 }
@@ -254,6 +337,8 @@ static inline int _esh_tbls_init(pmix_common_dstore_ctx_t *ds_ctx)
     ds_ctx->ns_track_array = NULL;
     ds_ctx->session_array = NULL;
     ds_ctx->ns_map_array = NULL;
+    ds_ctx->ns_map_idx = NULL;
+    ds_ctx->ns_map_last = -1;
 
     /* Setup namespace tracking array */
     if (NULL == (ds_ctx->ns_track_array = PMIX_NEW(pmix_value_array_t))) {
@@ -301,6 +386,13 @@ static inline int _esh_tbls_init(pmix_common_dstore_ctx_t *ds_ctx)
     for (idx = 0; idx < ESH_INIT_NS_MAP_TBL_SIZE; idx++) {
         _esh_session_map_clean(ds_ctx, pmix_value_array_get_item(ds_ctx->ns_map_array, idx));
     }
+    /* index the map by nspace so lookups don't scan it */
+    if (NULL == (ds_ctx->ns_map_idx = PMIX_NEW(pmix_hash_table_t))) {
+        rc = PMIX_ERR_OUT_OF_RESOURCE;
+        PMIX_ERROR_LOG(rc);
+        goto err_exit;
+    }
+    pmix_hash_table_init(ds_ctx->ns_map_idx, ESH_INIT_NS_MAP_TBL_SIZE);
 
     return PMIX_SUCCESS;
 err_exit:
@@ -313,6 +405,9 @@ err_exit:
     if (NULL != ds_ctx->ns_map_array) {
         PMIX_RELEASE(ds_ctx->ns_map_array);
     }
+    if (NULL != ds_ctx->ns_map_idx) {
+        PMIX_RELEASE(ds_ctx->ns_map_idx);
+    }
     return rc;
 }
 
@@ -337,6 +432,11 @@ static inline void _esh_ns_map_cleanup(pmix_common_dstore_ctx_t *ds_ctx)
 
     PMIX_RELEASE(ds_ctx->ns_map_array);
     ds_ctx->ns_map_array = NULL;
+    if (NULL != ds_ctx->ns_map_idx) {
+        PMIX_RELEASE(ds_ctx->ns_map_idx);
+        ds_ctx->ns_map_idx = NULL;
+    }
+    ds_ctx->ns_map_last = -1;
 }
 
 static inline void _esh_sessions_cleanup(pmix_common_dstore_ctx_t *ds_ctx)
@@ -384,6 +484,48 @@ static inline void _esh_ns_track_cleanup(pmix_common_dstore_ctx_t *ds_ctx)
     ds_ctx->ns_track_array = NULL;
 }
 
+/* the map is a value array that moves when it grows, so the index
+ * holds slot numbers rather than pointers */
+static inline void _esh_session_map_index(pmix_common_dstore_ctx_t *ds_ctx,
+                                          const char *nspace, size_t map_idx)
+{
+    pmix_hash_table_set_value_ptr(ds_ctx->ns_map_idx, nspace, strlen(nspace),
+                                  (void*)(uintptr_t)map_idx);
+}
+
+static inline void _esh_session_map_unindex(pmix_common_dstore_ctx_t *ds_ctx,
+                                            const char *nspace)
+{
+    pmix_hash_table_remove_value_ptr(ds_ctx->ns_map_idx, nspace, strlen(nspace));
+    ds_ctx->ns_map_last = -1;
+}
+
+static inline ns_map_data_t * _esh_session_map_lookup(pmix_common_dstore_ctx_t *ds_ctx,
+                                                      const char *nspace)
+{
+    size_t size = pmix_value_array_get_size(ds_ctx->ns_map_array);
+    ns_map_t *ns_map = PMIX_VALUE_ARRAY_GET_BASE(ds_ctx->ns_map_array, ns_map_t);
+    int last = ds_ctx->ns_map_last;
+    void *ptr;
+    size_t idx;
+
+    /* most lookups are for the same nspace as the one before */
+    if (0 <= last && (size_t)last < size && ns_map[last].in_use &&
+        0 == strcmp(ns_map[last].data.name, nspace)) {
+        return &ns_map[last].data;
+    }
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(ds_ctx->ns_map_idx, nspace,
+                                                      strlen(nspace), &ptr)) {
+        return NULL;
+    }
+    idx = (size_t)(uintptr_t)ptr;
+    if (idx >= size || !ns_map[idx].in_use) {
+        return NULL;
+    }
+    ds_ctx->ns_map_last = (int)idx;
+    return &ns_map[idx].data;
+}
+
 static inline ns_map_data_t * _esh_session_map(pmix_common_dstore_ctx_t *ds_ctx,
                                                const char *nspace, uint32_t local_size,
                                                size_t tbl_idx)
@@ -403,6 +545,7 @@ static inline ns_map_data_t * _esh_session_map(pmix_common_dstore_ctx_t *ds_ctx,
             ns_map[map_idx].in_use = true;
             pmix_strncpy(ns_map[map_idx].data.name, nspace, sizeof(ns_map[map_idx].data.name)-1);
             ns_map[map_idx].data.tbl_idx = tbl_idx;
+            _esh_session_map_index(ds_ctx, ns_map[map_idx].data.name, map_idx);
             return  &ns_map[map_idx].data;
         }
     }
@@ -416,6 +559,7 @@ static inline ns_map_data_t * _esh_session_map(pmix_common_dstore_ctx_t *ds_ctx,
     new_map->in_use = true;
     new_map->data.tbl_idx = tbl_idx;
     pmix_strncpy(new_map->data.name, nspace, sizeof(new_map->data.name)-1);
+    _esh_session_map_index(ds_ctx, new_map->data.name, map_idx);
 
     return  &new_map->data;
 }
@@ -469,36 +613,22 @@ done:
 static inline ns_map_data_t * _esh_session_map_search_server(pmix_common_dstore_ctx_t *ds_ctx,
                                                              const char *nspace)
 {
-    size_t idx, size = pmix_value_array_get_size(ds_ctx->ns_map_array);
-    ns_map_t *ns_map = PMIX_VALUE_ARRAY_GET_BASE(ds_ctx->ns_map_array, ns_map_t);
     if (NULL == nspace) {
         return NULL;
     }
-
-    for (idx = 0; idx < size; idx++) {
-        if (ns_map[idx].in_use &&
-            (0 == strcmp(ns_map[idx].data.name, nspace))) {
-                return &ns_map[idx].data;
-        }
-    }
-    return NULL;
+    return _esh_session_map_lookup(ds_ctx, nspace);
 }
 
 static inline ns_map_data_t * _esh_session_map_search_client(pmix_common_dstore_ctx_t *ds_ctx,
                                                              const char *nspace)
 {
-    size_t idx, size = pmix_value_array_get_size(ds_ctx->ns_map_array);
-    ns_map_t *ns_map = PMIX_VALUE_ARRAY_GET_BASE(ds_ctx->ns_map_array, ns_map_t);
+    ns_map_data_t *m;
 
     if (NULL == nspace) {
         return NULL;
     }
-
-    for (idx = 0; idx < size; idx++) {
-        if (ns_map[idx].in_use &&
-            (0 == strcmp(ns_map[idx].data.name, nspace))) {
-                return &ns_map[idx].data;
-        }
+    if (NULL != (m = _esh_session_map_lookup(ds_ctx, nspace))) {
+        return m;
     }
     return _esh_session_map(ds_ctx, nspace, 0, 0);
 }
@@ -561,6 +691,9 @@ static void _esh_session_release(pmix_common_dstore_ctx_t *ds_ctx, size_t idx)
         return;
     }
 
+    if (NULL != s->nspace_path) {
+        pmix_common_dstor_flush_segment_pool(s->nspace_path);
+    }
     pmix_common_dstor_delete_sm_desc(s->sm_seg_first);
 
     ds_ctx->lock_cbs->finalize(&_ESH_SESSION_lock(ds_ctx->session_array, idx));
@@ -574,6 +707,117 @@ static void _esh_session_release(pmix_common_dstore_ctx_t *ds_ctx, size_t idx)
     memset ((char *) s, 0, sizeof(*s));
 }
 
+static void _esh_reclaim_run(dstor_reclaim_t *r)
+{
+    pmix_dstore_seg_desc_t *desc, *tmp;
+    size_t n;
+
+    /* the files are all in the directory, which goes as a whole */
+    for (n=0; n < sizeof(r->segs) / sizeof(r->segs[0]); n++) {
+        desc = r->segs[n];
+        while (NULL != desc) {
+            tmp = desc->next;
+            pmix_pshmem.segment_detach(&desc->seg_info);
+            free(desc);
+            desc = tmp;
+        }
+        r->segs[n] = NULL;
+    }
+    (void)_esh_dir_del(r->path);
+}
+
+static void _esh_reclaim(int sd, short args, void *cbdata)
+{
+    dstor_reclaim_t *r = (dstor_reclaim_t*)cbdata;
+
+    PMIX_ACQUIRE_OBJECT(r);
+    _esh_reclaim_run(r);
+
+    pmix_mutex_lock(&reclaim_lock);
+    pmix_list_remove_item(&reclaim_pending, &r->super);
+    pmix_mutex_unlock(&reclaim_lock);
+    PMIX_RELEASE(r);
+}
+
+static void _esh_reclaim_finalize(void)
+{
+    dstor_reclaim_t *r;
+
+    if (NULL == reclaim_evbase) {
+        return;
+    }
+    (void)pmix_progress_thread_stop(DSTOR_RECLAIM_THREAD);
+    reclaim_evbase = NULL;
+
+    /* whatever the thread didn't get to is done here */
+    while (NULL != (r = (dstor_reclaim_t*)pmix_list_remove_first(&reclaim_pending))) {
+        _esh_reclaim_run(r);
+        PMIX_RELEASE(r);
+    }
+    PMIX_DESTRUCT(&reclaim_pending);
+}
+
+/* release a session whose last nspace is gone, along with the
+ * segments of that nspace */
+static void _esh_session_reclaim(pmix_common_dstore_ctx_t *ds_ctx, size_t idx,
+                                 pmix_dstore_seg_desc_t *meta_seg,
+                                 pmix_dstore_seg_desc_t *data_seg)
+{
+    session_t *s = &(PMIX_VALUE_ARRAY_GET_ITEM(ds_ctx->session_array, session_t, idx));
+    dstor_reclaim_t *r;
+    char *dead = NULL;
+
+    if (!s->in_use) {
+        pmix_common_dstor_delete_sm_desc(meta_seg);
+        pmix_common_dstor_delete_sm_desc(data_seg);
+        return;
+    }
+
+    if (!PMIX_PROC_IS_SERVER(pmix_globals.mypeer) || NULL == s->nspace_path) {
+        pmix_common_dstor_delete_sm_desc(meta_seg);
+        pmix_common_dstor_delete_sm_desc(data_seg);
+        _esh_session_release(ds_ctx, idx);
+        return;
+    }
+
+    ds_ctx->lock_cbs->finalize(&_ESH_SESSION_lock(ds_ctx->session_array, idx));
+    pmix_common_dstor_flush_segment_pool(s->nspace_path);
+
+    if (NULL == reclaim_evbase) {
+        PMIX_CONSTRUCT(&reclaim_pending, pmix_list_t);
+        reclaim_evbase = pmix_progress_thread_init(DSTOR_RECLAIM_THREAD);
+        if (NULL == reclaim_evbase) {
+            PMIX_DESTRUCT(&reclaim_pending);
+        }
+    }
+    if (NULL != reclaim_evbase &&
+        0 <= asprintf(&dead, "%s.dead.%lu", s->nspace_path, reclaim_count++) &&
+        0 == rename(s->nspace_path, dead)) {
+        r = PMIX_NEW(dstor_reclaim_t);
+        r->segs[0] = s->sm_seg_first;
+        r->segs[1] = meta_seg;
+        r->segs[2] = data_seg;
+        r->path = dead;
+        pmix_mutex_lock(&reclaim_lock);
+        pmix_list_append(&reclaim_pending, &r->super);
+        pmix_mutex_unlock(&reclaim_lock);
+        pmix_event_assign(&r->ev, reclaim_evbase, -1, EV_WRITE, _esh_reclaim, r);
+        PMIX_POST_OBJECT(r);
+        pmix_event_active(&r->ev, EV_WRITE, 1);
+    } else {
+        /* do it all here */
+        if (NULL != dead) {
+            free(dead);
+        }
+        pmix_common_dstor_delete_sm_desc(meta_seg);
+        pmix_common_dstor_delete_sm_desc(data_seg);
+        pmix_common_dstor_delete_sm_desc(s->sm_seg_first);
+        _esh_dir_del(s->nspace_path);
+    }
+    free(s->nspace_path);
+    memset ((char *) s, 0, sizeof(*s));
+}
+
 static void _set_constants_from_env(pmix_common_dstore_ctx_t *ds_ctx)
 {
     char *str;
@@ -611,6 +855,20 @@ static void _set_constants_from_env(pmix_common_dstore_ctx_t *ds_ctx)
             ds_ctx->direct_mode = 1;
         }
     }
+    if (NULL != (str = getenv(ESH_ENV_PERSIST))) {
+        if (1 == strtoul(str, NULL, 10)) {
+            ds_ctx->persist = 1;
+        }
+    }
+    if (NULL != (str = getenv(ESH_ENV_INTEGRITY))) {
+        if (1 == strtoul(str, NULL, 10)) {
+            ds_ctx->integrity = 1;
+        }
+    }
+    ds_ctx->compact_pct = ESH_COMPACT_PCT;
+    if (NULL != (str = getenv(ESH_ENV_COMPACT_PCT))) {
+        ds_ctx->compact_pct = strtoul(str, NULL, 10);
+    }
 
     ds_ctx->lock_segment_size = page_size;
     ds_ctx->max_ns_num = (ds_ctx->initial_segment_size - sizeof(size_t) * 2) / sizeof(ns_seg_info_t);
@@ -619,8 +877,19 @@ static void _set_constants_from_env(pmix_common_dstore_ctx_t *ds_ctx)
     pmix_common_dstor_init_segment_info(ds_ctx->initial_segment_size, ds_ctx->meta_segment_size,
                                         ds_ctx->data_segment_size);
 
+    /* pooling is off unless asked for - a client that looked at a
+     * departed nspace could still have its segments mapped */
+    if (NULL != (str = getenv(ESH_ENV_NS_SEG_POOL_SIZE))) {
+        pmix_common_dstor_init_segment_pool(strtoul(str, NULL, 10));
+    }
+
 }
 
+/* clients attach data segments lazily from whichever thread is
+ * fetching, so the segment count, the index and the chain of a
+ * namespace are only touched under this lock on that side */
+static pmix_mutex_t seg_attach_lock = PMIX_MUTEX_STATIC_INIT;
+
 /* This function synchronizes the content of initial shared segment and the local track list. */
 static int _update_ns_elem(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_elem,
                            ns_seg_info_t *info)
@@ -676,6 +945,17 @@ static int _update_ns_elem(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns
         ns_elem->num_meta_seg++;
     }
 
+    /* clients attach data segments on demand when an offset inside
+     * them is requested - just record how many of them exist */
+    if (!PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        pmix_mutex_lock(&seg_attach_lock);
+        if (ns_elem->num_data_seg < info->num_data_seg) {
+            ns_elem->num_data_seg = info->num_data_seg;
+        }
+        pmix_mutex_unlock(&seg_attach_lock);
+        return PMIX_SUCCESS;
+    }
+
     tmp = ns_elem->data_seg;
     if (NULL != tmp) {
         while(NULL != tmp->next) {
@@ -684,25 +964,16 @@ static int _update_ns_elem(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns
     }
     /* synchronize number of data segments for the target namespace. */
     for (i = ns_elem->num_data_seg; i < info->num_data_seg; i++) {
-        if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
-            seg = pmix_common_dstor_create_new_segment(PMIX_DSTORE_NS_DATA_SEGMENT, ds_ctx->base_path,
-                                                       info->ns_map.name, i, ds_ctx->jobuid,
-                                                       ds_ctx->setjobuid);
-            if (NULL == seg) {
-                rc = PMIX_ERR_OUT_OF_RESOURCE;
-                PMIX_ERROR_LOG(rc);
-                return rc;
-            }
-            offs = sizeof(size_t);//shift on offset field itself
-            memcpy(seg->seg_info.seg_base_addr, &offs, sizeof(size_t));
-        } else {
-            seg = pmix_common_dstor_attach_new_segment(PMIX_DSTORE_NS_DATA_SEGMENT, ds_ctx->base_path, info->ns_map.name, i);
-            if (NULL == seg) {
-                rc = PMIX_ERR_NOT_AVAILABLE;
-                PMIX_ERROR_LOG(rc);
-                return rc;
-            }
+        seg = pmix_common_dstor_create_new_segment(PMIX_DSTORE_NS_DATA_SEGMENT, ds_ctx->base_path,
+                                                   info->ns_map.name, i, ds_ctx->jobuid,
+                                                   ds_ctx->setjobuid);
+        if (NULL == seg) {
+            rc = PMIX_ERR_OUT_OF_RESOURCE;
+            PMIX_ERROR_LOG(rc);
+            return rc;
         }
+        offs = sizeof(size_t);//shift on offset field itself
+        memcpy(seg->seg_info.seg_base_addr, &offs, sizeof(size_t));
 
         if (NULL == tmp) {
             ns_elem->data_seg = seg;
@@ -1000,39 +1271,109 @@ static int set_rank_meta_info(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t
     return PMIX_SUCCESS;
 }
 
-static uint8_t *_get_data_region_by_offset(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_desc_t *segdesc, size_t offset)
+/* data segments of a namespace are chained in creation order and each
+ * one holds exactly data_segment_size bytes, so the segment holding a
+ * global offset is known up front. Keep a local array of the segments
+ * so that lookups don't have to walk the chain - large jobs can grow
+ * hundreds of data segments per namespace.
+ *
+ * The server creates every segment itself and simply indexes its chain.
+ * Clients only learn how many segments exist (see _update_ns_elem) and
+ * attach each of them the first time an offset inside it is requested,
+ * so ranks that never read peer data don't map it at all. */
+static pmix_dstore_seg_desc_t *_index_data_seg(pmix_common_dstore_ctx_t *ds_ctx,
+                                               ns_track_elem_t *elem, size_t id)
 {
-    pmix_dstore_seg_desc_t *tmp = segdesc;
-    size_t rel_offset = offset;
-    uint8_t *dataaddr = NULL;
+    pmix_dstore_seg_desc_t *tmp, **idx;
+    size_t n;
+
+    if (id >= elem->num_data_seg) {
+        return NULL;
+    }
+    if (id >= elem->ndata_segs_idx) {
+        idx = (pmix_dstore_seg_desc_t**)realloc(elem->data_segs_idx,
+                                                elem->num_data_seg * sizeof(pmix_dstore_seg_desc_t*));
+        if (NULL == idx) {
+            PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+            return NULL;
+        }
+        memset(idx + elem->ndata_segs_idx, 0,
+               (elem->num_data_seg - elem->ndata_segs_idx) * sizeof(pmix_dstore_seg_desc_t*));
+        elem->data_segs_idx = idx;
+        elem->ndata_segs_idx = elem->num_data_seg;
+    }
+    idx = elem->data_segs_idx;
+    if (NULL != idx[id]) {
+        return idx[id];
+    }
+
+    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        /* index the part of the chain that was appended since the last lookup */
+        for (n = id; 0 < n && NULL == idx[n-1]; n--);
+        tmp = (0 == n) ? elem->data_seg : idx[n-1]->next;
+        for (; n <= id && NULL != tmp; n++) {
+            idx[n] = tmp;
+            tmp = tmp->next;
+        }
+        return idx[id];
+    }
+
+    tmp = pmix_common_dstor_attach_new_segment(PMIX_DSTORE_NS_DATA_SEGMENT, ds_ctx->base_path,
+                                               elem->ns_map.name, id);
+    if (NULL == tmp) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOT_AVAILABLE);
+        return NULL;
+    }
+    /* clients never walk the chain - it is only kept to release the
+     * attached segments, so the order doesn't matter */
+    tmp->next = elem->data_seg;
+    elem->data_seg = tmp;
+    idx[id] = tmp;
+
+    return tmp;
+}
+
+static pmix_dstore_seg_desc_t *_get_data_seg_by_id(pmix_common_dstore_ctx_t *ds_ctx,
+                                                   ns_track_elem_t *elem, size_t id)
+{
+    pmix_dstore_seg_desc_t *seg;
+
+    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        return _index_data_seg(ds_ctx, elem, id);
+    }
+    pmix_mutex_lock(&seg_attach_lock);
+    seg = _index_data_seg(ds_ctx, elem, id);
+    pmix_mutex_unlock(&seg_attach_lock);
+    return seg;
+}
+
+static uint8_t *_get_data_region_by_offset(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *elem, size_t offset)
+{
+    pmix_dstore_seg_desc_t *tmp;
 
     PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
                          "%s:%d:%s",
                          __FILE__, __LINE__, __func__));
 
-    /* go through all existing data segments for this namespace */
-    do {
-        if (rel_offset >= ds_ctx->data_segment_size) {
-            rel_offset -= ds_ctx->data_segment_size;
-        } else {
-            dataaddr = tmp->seg_info.seg_base_addr + rel_offset;
-        }
-        tmp = tmp->next;
-    } while (NULL != tmp && NULL == dataaddr);
-
-    return dataaddr;
+    tmp = _get_data_seg_by_id(ds_ctx, elem, offset / ds_ctx->data_segment_size);
+    if (NULL == tmp) {
+        return NULL;
+    }
+    return tmp->seg_info.seg_base_addr + (offset % ds_ctx->data_segment_size);
 }
 
-static size_t get_free_offset(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_desc_t *data_seg)
+static size_t get_free_offset(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *elem)
 {
     size_t offset;
     pmix_dstore_seg_desc_t *tmp;
-    int id = 0;
-    tmp = data_seg;
-    /* first find the last data segment */
-    while (NULL != tmp->next) {
-        tmp = tmp->next;
-        id++;
+    size_t id;
+
+    /* free space is always at the end of the last data segment */
+    id = elem->num_data_seg - 1;
+    tmp = _get_data_seg_by_id(ds_ctx, elem, id);
+    if (NULL == tmp) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
+        return 0;
     }
     offset = *((size_t*)(tmp->seg_info.seg_base_addr));
     if (0 == offset) {
@@ -1042,19 +1383,23 @@ static size_t get_free_offset(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_
     return (id * ds_ctx->data_segment_size + offset);
 }
 
-static int put_empty_ext_slot(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_desc_t *dataseg)
+static int put_empty_ext_slot(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info)
 {
     size_t global_offset, rel_offset, data_ended, val = 0;
     uint8_t *addr;
     pmix_status_t rc;
 
-    global_offset = get_free_offset(ds_ctx, dataseg);
+    global_offset = get_free_offset(ds_ctx, ns_info);
     rel_offset = global_offset % ds_ctx->data_segment_size;
     if (rel_offset + PMIX_DS_SLOT_SIZE(ds_ctx) > ds_ctx->data_segment_size) {
         PMIX_ERROR_LOG(PMIX_ERROR);
         return PMIX_ERROR;
     }
-    addr = _get_data_region_by_offset(ds_ctx, dataseg, global_offset);
+    addr = _get_data_region_by_offset(ds_ctx, ns_info, global_offset);
+    if (NULL == addr) {
+        PMIX_ERROR_LOG(PMIX_ERROR);
+        return PMIX_ERROR;
+    }
     PMIX_DS_PUT_KEY(rc, ds_ctx, addr, ESH_REGION_EXTENSION, (void*)&val, sizeof(size_t));
     if (rc != PMIX_SUCCESS) {
         PMIX_ERROR_LOG(rc);
@@ -1068,9 +1413,9 @@ static int put_empty_ext_slot(pmix_common_dstore_ctx_t *ds_ctx, pmix_dstore_seg_
 }
 
 static size_t put_data_to_the_end(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
-                                  pmix_dstore_seg_desc_t *dataseg, char *key, void *buffer, size_t size)
+                                  char *key, void *buffer, size_t size)
 {
-    size_t offset, id = 0;
+    size_t offset, id;
     pmix_dstore_seg_desc_t *tmp;
     size_t global_offset, data_ended;
     uint8_t *addr;
@@ -1080,12 +1425,13 @@ static size_t put_data_to_the_end(pmix_common_dstore_ctx_t *ds_ctx, ns_track_ele
                          "%s:%d:%s: key %s",
                          __FILE__, __LINE__, __func__, key));
 
-    tmp = dataseg;
-    while (NULL != tmp->next) {
-        tmp = tmp->next;
-        id++;
+    id = ns_info->num_data_seg - 1;
+    tmp = _get_data_seg_by_id(ds_ctx, ns_info, id);
+    if (NULL == tmp) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
+        return 0;
     }
-    global_offset = get_free_offset(ds_ctx, dataseg);
+    global_offset = get_free_offset(ds_ctx, ns_info);
     offset = global_offset % ds_ctx->data_segment_size;
 
     /* We should provide additional space at the end of segment to
@@ -1156,16 +1502,15 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
                          pmix_rank_t rank, pmix_kval_t *kval, rank_meta_info **rinfo, int data_exist)
 {
     size_t offset, size, kval_cnt;
+    size_t keyhash;
     pmix_buffer_t buffer;
     pmix_status_t rc;
-    pmix_dstore_seg_desc_t *datadesc;
     uint8_t *addr;
 
     PMIX_OUTPUT_VERBOSE((2, pmix_gds_base_framework.framework_output,
                          "%s:%d:%s: for rank %u, replace flag %d",
                          __FILE__, __LINE__, __func__, rank, data_exist));
 
-    datadesc = ns_info->data_seg;
     /* pack value to the buffer */
     PMIX_CONSTRUCT(&buffer, pmix_buffer_t);
     PMIX_BFROPS_PACK(rc, _client_peer(ds_ctx), &buffer, kval->value, 1, PMIX_VALUE);
@@ -1178,8 +1523,8 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
     if (0 == data_exist) {
         /* there is no data blob for this rank yet, so add it. */
         size_t free_offset;
-        free_offset = get_free_offset(ds_ctx, datadesc);
-        offset = put_data_to_the_end(ds_ctx, ns_info, datadesc, kval->key, buffer.base_ptr, size);
+        free_offset = get_free_offset(ds_ctx, ns_info);
+        offset = put_data_to_the_end(ds_ctx, ns_info, kval->key, buffer.base_ptr, size);
         if (0 == offset) {
             /* this is an error */
             rc = PMIX_ERROR;
@@ -1196,7 +1541,7 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
              * It should be equal in the normal case. If it's not true, then it means that
              * segment was extended, and we put data to the next segment, so we now need to
              * put extension slot at the end of previous segment with a "reference" to a new_offset */
-            addr = _get_data_region_by_offset(ds_ctx, datadesc, free_offset);
+            addr = _get_data_region_by_offset(ds_ctx, ns_info, free_offset);
             PMIX_DS_PUT_KEY(rc, ds_ctx, addr, ESH_REGION_EXTENSION, (void*)&offset, sizeof(size_t));
             if (rc != PMIX_SUCCESS) {
                 PMIX_ERROR_LOG(rc);
@@ -1212,7 +1557,7 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
         (*rinfo)->count++;
     } else if (NULL != *rinfo) {
         /* there is data blob for this rank */
-        addr = _get_data_region_by_offset(ds_ctx, datadesc, (*rinfo)->offset);
+        addr = _get_data_region_by_offset(ds_ctx, ns_info, (*rinfo)->offset);
         if (NULL == addr) {
             rc = PMIX_ERROR;
             PMIX_ERROR_LOG(rc);
@@ -1224,6 +1569,9 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
          * and add new kval by this offset.
          * no need to update meta info, it's still the same. */
         kval_cnt = (*rinfo)->count;
+        /* compute the hash once so the formats that store it
+         * can reject most of the other keys without a string compare */
+        keyhash = PMIX_DS_KEY_HASH(ds_ctx, kval->key);
         int add_to_the_end = 1;
         while (0 < kval_cnt) {
             /* data is stored in the following format:
@@ -1243,7 +1591,7 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
                                 (unsigned long)rank, data_exist,
                                 ESH_REGION_EXTENSION, (unsigned long)offset));
                     /* go to next item, updating address */
-                    addr = _get_data_region_by_offset(ds_ctx, datadesc, offset);
+                    addr = _get_data_region_by_offset(ds_ctx, ns_info, offset);
                     if (NULL == addr) {
                         rc = PMIX_ERROR;
                         PMIX_ERROR_LOG(rc);
@@ -1252,8 +1600,10 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
                 } else {
                     /* should not be, we should be out of cycle when this happens */
                 }
-            } else if (0 == strncmp(PMIX_DS_KNAME_PTR(ds_ctx, addr), kval->key,
-                                    PMIX_DS_KNAME_LEN(ds_ctx, kval->key))) {
+            } else if (!PMIX_DS_KEY_IS_INVALID(ds_ctx, addr) &&
+                       PMIX_DS_KEY_MATCH(ds_ctx, addr, kval->key, keyhash)) {
+                /* note that invalidated regions may keep their key
+                 * name, so they have to be excluded explicitly */
                 PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
                             "%s:%d:%s: for rank %u, replace flag %d found target key %s",
                             __FILE__, __LINE__, __func__, rank, data_exist, kval->key));
@@ -1302,7 +1652,7 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
              * for the same key. */
             size_t free_offset;
             (*rinfo)->count++;
-            free_offset = get_free_offset(ds_ctx, datadesc);
+            free_offset = get_free_offset(ds_ctx, ns_info);
 
             /*
              * Remove trailing extention slot if we are continuing
@@ -1330,12 +1680,15 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
              */
             if (PMIX_DS_KEY_IS_EXTSLOT(ds_ctx, addr)){
                 /* Find the last data segment */
-                pmix_dstore_seg_desc_t *ldesc = datadesc;
+                pmix_dstore_seg_desc_t *ldesc;
                 uint8_t *segstart;
                 size_t offs_past_extslot = 0;
                 size_t offs_cur_segment = 0;
-                while (NULL != ldesc->next) {
-                    ldesc = ldesc->next;
+                ldesc = _get_data_seg_by_id(ds_ctx, ns_info, ns_info->num_data_seg - 1);
+                if (NULL == ldesc) {
+                    rc = PMIX_ERR_NOT_FOUND;
+                    PMIX_ERROR_LOG(rc);
+                    goto exit;
                 }
 
                 /* Calculate the offset of the end of the extension slot */
@@ -1358,12 +1711,12 @@ static int pmix_sm_store(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_i
                      * extension slot */
                     memcpy(segstart, &new_offset, sizeof(size_t));
                     /* Recalculate free_offset */
-                    free_offset = get_free_offset(ds_ctx, datadesc);
+                    free_offset = get_free_offset(ds_ctx, ns_info);
                 }
             }
 
             /* add to the end */
-            offset = put_data_to_the_end(ds_ctx, ns_info, datadesc, kval->key, buffer.base_ptr, size);
+            offset = put_data_to_the_end(ds_ctx, ns_info, kval->key, buffer.base_ptr, size);
             if (0 == offset) {
                 rc = PMIX_ERROR;
                 PMIX_ERROR_LOG(rc);
@@ -1405,6 +1758,268 @@ exit:
     return rc;
 }
 
+/* With integrity on, every rank's data carries one more key holding
+ * a CRC32C of the names and values of all its other live keys. The
+ * writer refreshes it at the end of each store; a reader checks it
+ * the first time it sees a given checksum value, so data that has
+ * not changed since is not summed again. */
+static pmix_mutex_t csum_lock = PMIX_MUTEX_STATIC_INIT;
+
+static pmix_status_t _rank_csum_walk(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *elem,
+                                     rank_meta_info *rinfo, bool compute,
+                                     uint32_t *crc, uint8_t **csum_addr)
+{
+    uint8_t *addr;
+    size_t kval_cnt, offset, csum_hash;
+
+    *crc = PMIX_CRC32C_INITIAL;
+    *csum_addr = NULL;
+    csum_hash = PMIX_DS_KEY_HASH(ds_ctx, ESH_REGION_CHECKSUM);
+
+    if (NULL == (addr = _get_data_region_by_offset(ds_ctx, elem, rinfo->offset))) {
+        return PMIX_ERR_FATAL;
+    }
+    kval_cnt = rinfo->count;
+    while (0 < kval_cnt) {
+        if (PMIX_DS_KEY_IS_INVALID(ds_ctx, addr)) {
+            addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+        } else if (PMIX_DS_KEY_IS_EXTSLOT(ds_ctx, addr)) {
+            memcpy(&offset, PMIX_DS_DATA_PTR(ds_ctx, addr), sizeof(size_t));
+            if (0 == offset) {
+                break;
+            }
+            if (NULL == (addr = _get_data_region_by_offset(ds_ctx, elem, offset))) {
+                return PMIX_ERR_FATAL;
+            }
+        } else {
+            if (PMIX_DS_KEY_MATCH(ds_ctx, addr, ESH_REGION_CHECKSUM, csum_hash)) {
+                *csum_addr = addr;
+            } else if (compute) {
+                uint8_t *data_ptr = PMIX_DS_DATA_PTR(ds_ctx, addr);
+                *crc = pmix_crc32c_partial(PMIX_DS_KNAME_PTR(ds_ctx, addr),
+                                           PMIX_DS_KNAME_LEN(ds_ctx, addr), *crc);
+                *crc = pmix_crc32c_partial(data_ptr,
+                                           PMIX_DS_DATA_SIZE(ds_ctx, addr, data_ptr), *crc);
+            }
+            kval_cnt--;
+            addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t _rank_csum_stored(pmix_common_dstore_ctx_t *ds_ctx,
+                                       uint8_t *addr, uint32_t *crc)
+{
+    pmix_buffer_t buffer;
+    pmix_value_t val;
+    pmix_status_t rc;
+    uint8_t *data_ptr = PMIX_DS_DATA_PTR(ds_ctx, addr);
+    size_t data_size = PMIX_DS_DATA_SIZE(ds_ctx, addr, data_ptr);
+    int cnt = 1;
+
+    PMIX_CONSTRUCT(&buffer, pmix_buffer_t);
+    PMIX_LOAD_BUFFER(_client_peer(ds_ctx), &buffer, data_ptr, data_size);
+    PMIX_VALUE_CONSTRUCT(&val);
+    PMIX_BFROPS_UNPACK(rc, _client_peer(ds_ctx), &buffer, &val, &cnt, PMIX_VALUE);
+    buffer.base_ptr = NULL;
+    buffer.bytes_used = 0;
+    PMIX_DESTRUCT(&buffer);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (PMIX_UINT32 != val.type) {
+        PMIX_VALUE_DESTRUCT(&val);
+        return PMIX_ERR_TYPE_MISMATCH;
+    }
+    *crc = val.data.uint32;
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t _rank_csum_update(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
+                                       pmix_rank_t rank, rank_meta_info **rinfo, int data_exist)
+{
+    pmix_kval_t kv;
+    pmix_value_t val;
+    uint32_t crc;
+    uint8_t *csum_addr;
+    pmix_status_t rc;
+
+    rc = _rank_csum_walk(ds_ctx, ns_info, *rinfo, true, &crc, &csum_addr);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    PMIX_CONSTRUCT(&kv, pmix_kval_t);
+    kv.key = ESH_REGION_CHECKSUM;
+    kv.value = &val;
+    PMIX_VALUE_LOAD(&val, &crc, PMIX_UINT32);
+    /* once stored, the checksum is replaced in place */
+    rc = pmix_sm_store(ds_ctx, ns_info, rank, &kv, rinfo,
+                       (NULL != csum_addr) ? 1 : data_exist);
+    kv.key = NULL;
+    kv.value = NULL;
+    PMIX_DESTRUCT(&kv);
+    return rc;
+}
+
+static pmix_status_t _rank_csum_verify(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *elem,
+                                       rank_meta_info *rinfo, const char *nspace, pmix_rank_t rank)
+{
+    uint32_t crc, stored;
+    uint8_t *csum_addr;
+    void *ptr;
+    pmix_status_t rc;
+
+    /* first find the checksum the writer left */
+    rc = _rank_csum_walk(ds_ctx, elem, rinfo, false, &crc, &csum_addr);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (NULL == csum_addr) {
+        /* stored before integrity was on - nothing to check */
+        return PMIX_SUCCESS;
+    }
+    if (PMIX_SUCCESS != (rc = _rank_csum_stored(ds_ctx, csum_addr, &stored))) {
+        return PMIX_ERR_INVALID_VAL;
+    }
+
+    pmix_mutex_lock(&csum_lock);
+    if (NULL != elem->verified &&
+        PMIX_SUCCESS == pmix_hash_table_get_value_uint32(elem->verified, rank, &ptr) &&
+        (uint32_t)(uintptr_t)ptr == stored) {
+        /* already checked this version of the data */
+        pmix_mutex_unlock(&csum_lock);
+        return PMIX_SUCCESS;
+    }
+    pmix_mutex_unlock(&csum_lock);
+
+    rc = _rank_csum_walk(ds_ctx, elem, rinfo, true, &crc, &csum_addr);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+    if (crc != stored) {
+        pmix_output(0, "gds: dstore data for %s:%u is corrupt (checksum %08x, expected %08x)",
+                    nspace, rank, crc, stored);
+        return PMIX_ERR_INVALID_VAL;
+    }
+
+    pmix_mutex_lock(&csum_lock);
+    if (NULL == elem->verified) {
+        elem->verified = PMIX_NEW(pmix_hash_table_t);
+        pmix_hash_table_init(elem->verified, 256);
+    }
+    pmix_hash_table_set_value_uint32(elem->verified, rank, (void*)(uintptr_t)stored);
+    pmix_mutex_unlock(&csum_lock);
+    return PMIX_SUCCESS;
+}
+
+/* Values that change size are invalidated where they are and stored
+ * again at the end of the data segments, so a rank that keeps updating
+ * its data ends up with a region that is mostly dead entries scattered
+ * over several segments, and every reader has to walk all of them.
+ * Once the dead entries reach the configured share of the region we
+ * copy the live ones, in order, to the end of the data segments and
+ * point the rank's meta info at the copy. The caller holds the write
+ * lock, so no reader can be part way through the old region when the
+ * offset is swapped. The old region is not reused - the space comes
+ * back when the nspace is released */
+static pmix_status_t _compact_rank(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
+                                   rank_meta_info *rinfo)
+{
+    uint8_t *addr, *data_ptr;
+    size_t kval_cnt, offset, free_offset, start = 0;
+    size_t live = 0, dead = 0, count = 0;
+    pmix_status_t rc;
+
+    if (0 == ds_ctx->compact_pct) {
+        return PMIX_SUCCESS;
+    }
+
+    /* measure the region first */
+    if (NULL == (addr = _get_data_region_by_offset(ds_ctx, ns_info, rinfo->offset))) {
+        return PMIX_ERR_FATAL;
+    }
+    kval_cnt = rinfo->count;
+    while (0 < kval_cnt) {
+        if (PMIX_DS_KEY_IS_INVALID(ds_ctx, addr)) {
+            dead += PMIX_DS_KV_SIZE(ds_ctx, addr);
+            addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+        } else if (PMIX_DS_KEY_IS_EXTSLOT(ds_ctx, addr)) {
+            memcpy(&offset, PMIX_DS_DATA_PTR(ds_ctx, addr), sizeof(size_t));
+            if (0 == offset) {
+                break;
+            }
+            if (NULL == (addr = _get_data_region_by_offset(ds_ctx, ns_info, offset))) {
+                return PMIX_ERR_FATAL;
+            }
+        } else {
+            live += PMIX_DS_KV_SIZE(ds_ctx, addr);
+            kval_cnt--;
+            addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+        }
+    }
+    if (0 == dead || dead * 100 < ds_ctx->compact_pct * (live + dead)) {
+        return PMIX_SUCCESS;
+    }
+
+    PMIX_OUTPUT_VERBOSE((2, pmix_gds_base_framework.framework_output,
+                         "%s:%d:%s: nspace %s, compact rank %lu - %lu live bytes, %lu invalidated",
+                         __FILE__, __LINE__, __func__, ns_info->ns_map.name,
+                         (unsigned long)rinfo->rank, (unsigned long)live, (unsigned long)dead));
+
+    /* now copy the live entries */
+    if (NULL == (addr = _get_data_region_by_offset(ds_ctx, ns_info, rinfo->offset))) {
+        return PMIX_ERR_FATAL;
+    }
+    kval_cnt = rinfo->count;
+    while (0 < kval_cnt) {
+        if (PMIX_DS_KEY_IS_INVALID(ds_ctx, addr)) {
+            addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+        } else if (PMIX_DS_KEY_IS_EXTSLOT(ds_ctx, addr)) {
+            memcpy(&offset, PMIX_DS_DATA_PTR(ds_ctx, addr), sizeof(size_t));
+            if (0 == offset) {
+                break;
+            }
+            if (NULL == (addr = _get_data_region_by_offset(ds_ctx, ns_info, offset))) {
+                return PMIX_ERR_FATAL;
+            }
+        } else {
+            free_offset = get_free_offset(ds_ctx, ns_info);
+            data_ptr = PMIX_DS_DATA_PTR(ds_ctx, addr);
+            offset = put_data_to_the_end(ds_ctx, ns_info, PMIX_DS_KNAME_PTR(ds_ctx, addr),
+                                         data_ptr, PMIX_DS_DATA_SIZE(ds_ctx, addr, data_ptr));
+            if (0 == offset) {
+                return PMIX_ERROR;
+            }
+            if (0 == start) {
+                start = offset;
+            } else if (free_offset != offset) {
+                /* the copy went on in a new segment - link it from
+                 * the end of the previous one */
+                uint8_t *slot = _get_data_region_by_offset(ds_ctx, ns_info, free_offset);
+                PMIX_DS_PUT_KEY(rc, ds_ctx, slot, ESH_REGION_EXTENSION,
+                                (void*)&offset, sizeof(size_t));
+                if (PMIX_SUCCESS != rc) {
+                    return rc;
+                }
+            }
+            count++;
+            kval_cnt--;
+            addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+        }
+    }
+    if (0 == start) {
+        return PMIX_SUCCESS;
+    }
+    /* terminate the copy so the rank can grow from here */
+    if (PMIX_SUCCESS != (rc = put_empty_ext_slot(ds_ctx, ns_info))) {
+        return rc;
+    }
+    rinfo->offset = start;
+    rinfo->count = count;
+    return PMIX_SUCCESS;
+}
+
 static int _store_data_for_rank(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_t *ns_info,
                                 pmix_rank_t rank, pmix_buffer_t *buf)
 {
@@ -1445,7 +2060,7 @@ static int _store_data_for_rank(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_
      * so unpack these buffers, and then unpack kvals from each modex buffer,
      * storing them in the shared memory dstore.
      */
-    free_offset = get_free_offset(ds_ctx, datadesc);
+    free_offset = get_free_offset(ds_ctx, ns_info);
     cnt = 1;
     kp = PMIX_NEW(pmix_kval_t);
     PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, buf, kp, &cnt, PMIX_KVAL);
@@ -1474,12 +2089,22 @@ static int _store_data_for_rank(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_
         rc = PMIX_SUCCESS;
     }
 
+    if (ds_ctx->integrity && NULL != rinfo) {
+        if (PMIX_SUCCESS != (rc = _rank_csum_update(ds_ctx, ns_info, rank, &rinfo, data_exist))) {
+            PMIX_ERROR_LOG(rc);
+            if (0 == data_exist) {
+                free(rinfo);
+            }
+            return rc;
+        }
+    }
+
     /* Check if new data was put at the end of data segment.
      * It's possible that old data just was replaced with new one,
      * in that case we don't reserve space for EXTENSION_SLOT, it's
      * already reserved.
      * */
-    new_free_offset = get_free_offset(ds_ctx, datadesc);
+    new_free_offset = get_free_offset(ds_ctx, ns_info);
     if (new_free_offset != free_offset) {
         /* Reserve space for EXTENSION_SLOT at the end of data blob.
          * We need it to split data for one rank from data for different
@@ -1487,7 +2112,7 @@ static int _store_data_for_rank(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_
          * We also put EXTENSION_SLOT at the end of each data segment, and
          * its value points to the beginning of next data segment.
          * */
-        rc = put_empty_ext_slot(ds_ctx, ns_info->data_seg);
+        rc = put_empty_ext_slot(ds_ctx, ns_info);
         if (PMIX_SUCCESS != rc) {
             if ((0 == data_exist) && NULL != rinfo) {
                 free(rinfo);
@@ -1497,6 +2122,14 @@ static int _store_data_for_rank(pmix_common_dstore_ctx_t *ds_ctx, ns_track_elem_
         }
     }
 
+    /* updates may have left the region mostly invalidated */
+    if (1 == data_exist) {
+        if (PMIX_SUCCESS != (rc = _compact_rank(ds_ctx, ns_info, rinfo))) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
+        }
+    }
+
     /* if this is the first data posted for this rank, then
      * update meta info for it */
     if (0 == data_exist) {
@@ -1515,7 +2148,7 @@ static inline ssize_t _get_univ_size(pmix_common_dstore_ctx_t *ds_ctx, const cha
     pmix_value_t *val;
     int rc;
 
-    rc = _dstore_fetch(ds_ctx, nspace, PMIX_RANK_WILDCARD, PMIX_UNIV_SIZE, &val);
+    rc = _dstore_fetch(ds_ctx, nspace, PMIX_RANK_WILDCARD, PMIX_UNIV_SIZE, NULL, &val);
     if( PMIX_SUCCESS != rc ) {
         PMIX_ERROR_LOG(rc);
         return rc;
@@ -1530,6 +2163,228 @@ static inline ssize_t _get_univ_size(pmix_common_dstore_ctx_t *ds_ctx, const cha
     return nprocs;
 }
 
+/* With persistence on, the server keeps a snapshot record next to
+ * the segments of each nspace it has stored: how many segments there
+ * are, how much of the data is in use and a checksum over all of it.
+ * A server restarted on the same directory takes over the segments
+ * of a re-registered nspace whose record still matches instead of
+ * storing its job info all over again. The record is refreshed after
+ * job info and modex data are stored - anything stored later just
+ * makes it stale, and a stale record is ignored */
+#define ESH_SNAPSHOT_MAGIC      0x504d5853
+#define ESH_SNAPSHOT_VERSION    2
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t generation;
+    size_t meta_segment_size;
+    size_t data_segment_size;
+    size_t num_meta_seg;
+    size_t num_data_seg;
+    size_t data_used;
+    uint32_t crc;
+} ns_snapshot_t;
+
+static uint64_t snapshot_generation = 0;
+
+static uint32_t _esh_snapshot_crc(pmix_common_dstore_ctx_t *ds_ctx,
+                                  pmix_dstore_seg_desc_t *meta_seg,
+                                  pmix_dstore_seg_desc_t *data_seg,
+                                  size_t data_used)
+{
+    uint32_t crc = PMIX_CRC32C_INITIAL;
+    size_t len;
+
+    /* meta info is placed by rank, so there is no used length */
+    for (; NULL != meta_seg; meta_seg = meta_seg->next) {
+        crc = pmix_crc32c_partial(meta_seg->seg_info.seg_base_addr,
+                                  ds_ctx->meta_segment_size, crc);
+    }
+    for (; NULL != data_seg && 0 < data_used; data_seg = data_seg->next) {
+        len = (data_used < ds_ctx->data_segment_size) ? data_used : ds_ctx->data_segment_size;
+        crc = pmix_crc32c_partial(data_seg->seg_info.seg_base_addr, len, crc);
+        data_used -= len;
+    }
+    return crc;
+}
+
+static void _esh_snapshot_update(pmix_common_dstore_ctx_t *ds_ctx, ns_map_data_t *ns_map)
+{
+    ns_track_elem_t *elem;
+    ns_snapshot_t snap;
+    char *path = NULL, *tmp = NULL;
+    int fd;
+
+    if (!ds_ctx->persist || 0 > ns_map->track_idx ||
+        (size_t)ns_map->track_idx >= pmix_value_array_get_size(ds_ctx->ns_track_array)) {
+        return;
+    }
+    elem = pmix_value_array_get_item(ds_ctx->ns_track_array, ns_map->track_idx);
+    if (NULL == elem->meta_seg || NULL == elem->data_seg) {
+        return;
+    }
+
+    memset(&snap, 0, sizeof(snap));
+    snap.magic = ESH_SNAPSHOT_MAGIC;
+    snap.version = ESH_SNAPSHOT_VERSION;
+    snap.generation = ++snapshot_generation;
+    snap.meta_segment_size = ds_ctx->meta_segment_size;
+    snap.data_segment_size = ds_ctx->data_segment_size;
+    snap.num_meta_seg = elem->num_meta_seg;
+    snap.num_data_seg = elem->num_data_seg;
+    snap.data_used = get_free_offset(ds_ctx, elem);
+    snap.crc = _esh_snapshot_crc(ds_ctx, elem->meta_seg, elem->data_seg, snap.data_used);
+
+    if (0 > asprintf(&path, "%s/snapshot-%s", ds_ctx->base_path, ns_map->name)) {
+        return;
+    }
+    if (0 > asprintf(&tmp, "%s.tmp", path)) {
+        free(path);
+        return;
+    }
+    /* write it aside and move it in place so a restart never sees
+     * half of it */
+    if (0 <= (fd = open(tmp, O_CREAT | O_WRONLY | O_TRUNC, 0600))) {
+        if (sizeof(snap) == write(fd, &snap, sizeof(snap)) &&
+            0 == close(fd)) {
+            if (0 != rename(tmp, path)) {
+                (void)unlink(tmp);
+            }
+        } else {
+            (void)close(fd);
+            (void)unlink(tmp);
+        }
+    }
+    PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
+                         "%s:%d:%s: nspace %s generation %lu",
+                         __FILE__, __LINE__, __func__, ns_map->name,
+                         (unsigned long)snap.generation));
+    free(tmp);
+    free(path);
+}
+
+static void _esh_snapshot_remove(pmix_common_dstore_ctx_t *ds_ctx, const char *nspace)
+{
+    char *path = NULL;
+
+    if (!ds_ctx->persist) {
+        return;
+    }
+    if (0 <= asprintf(&path, "%s/snapshot-%s", ds_ctx->base_path, nspace)) {
+        (void)unlink(path);
+        free(path);
+    }
+}
+
+/* take over the segments of the given nspace from an earlier
+ * instance of this server if its snapshot record checks out */
+static pmix_status_t _esh_snapshot_recover(pmix_common_dstore_ctx_t *ds_ctx,
+                                           ns_map_data_t *ns_map)
+{
+    ns_snapshot_t snap;
+    ns_track_elem_t *elem;
+    ns_seg_info_t *info;
+    pmix_dstore_seg_desc_t *meta_seg = NULL, *data_seg = NULL;
+    pmix_dstore_seg_desc_t *seg, *last = NULL;
+    char *path = NULL;
+    size_t n;
+    int fd;
+    pmix_status_t rc;
+
+    if (!ds_ctx->persist || 0 <= ns_map->track_idx) {
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+    if (0 > asprintf(&path, "%s/snapshot-%s", ds_ctx->base_path, ns_map->name)) {
+        return PMIX_ERR_NOMEM;
+    }
+    fd = open(path, O_RDONLY);
+    free(path);
+    if (0 > fd) {
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+    if (sizeof(snap) != read(fd, &snap, sizeof(snap))) {
+        close(fd);
+        return PMIX_ERR_NOT_AVAILABLE;
+    }
+    close(fd);
+
+    if (ESH_SNAPSHOT_MAGIC != snap.magic ||
+        ESH_SNAPSHOT_VERSION != snap.version ||
+        ds_ctx->meta_segment_size != snap.meta_segment_size ||
+        ds_ctx->data_segment_size != snap.data_segment_size ||
+        0 == snap.num_meta_seg || 0 == snap.num_data_seg ||
+        snap.data_used > snap.num_data_seg * snap.data_segment_size) {
+        rc = PMIX_ERR_NOT_AVAILABLE;
+        goto fail;
+    }
+
+    for (n=0; n < snap.num_meta_seg; n++) {
+        if (NULL == (seg = pmix_common_dstor_reopen_segment(PMIX_DSTORE_NS_META_SEGMENT,
+                                                            ds_ctx->base_path, ns_map->name, n))) {
+            rc = PMIX_ERR_NOT_AVAILABLE;
+            goto fail;
+        }
+        if (NULL == last) {
+            meta_seg = seg;
+        } else {
+            last->next = seg;
+        }
+        last = seg;
+    }
+    last = NULL;
+    for (n=0; n < snap.num_data_seg; n++) {
+        if (NULL == (seg = pmix_common_dstor_reopen_segment(PMIX_DSTORE_NS_DATA_SEGMENT,
+                                                            ds_ctx->base_path, ns_map->name, n))) {
+            rc = PMIX_ERR_NOT_AVAILABLE;
+            goto fail;
+        }
+        if (NULL == last) {
+            data_seg = seg;
+        } else {
+            last->next = seg;
+        }
+        last = seg;
+    }
+    if (snap.crc != _esh_snapshot_crc(ds_ctx, meta_seg, data_seg, snap.data_used)) {
+        rc = PMIX_ERR_NOT_AVAILABLE;
+        goto fail;
+    }
+
+    if (NULL == (elem = _get_track_elem_for_namespace(ds_ctx, ns_map))) {
+        rc = PMIX_ERR_OUT_OF_RESOURCE;
+        goto fail;
+    }
+    elem->meta_seg = meta_seg;
+    elem->data_seg = data_seg;
+    elem->num_meta_seg = snap.num_meta_seg;
+    elem->num_data_seg = snap.num_data_seg;
+
+    rc = _put_ns_info_to_initial_segment(ds_ctx, ns_map, &meta_seg->seg_info, &data_seg->seg_info);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (NULL != (info = _get_ns_info_from_initial_segment(ds_ctx, ns_map))) {
+        info->num_meta_seg = snap.num_meta_seg;
+        info->num_data_seg = snap.num_data_seg;
+    }
+    if (snapshot_generation < snap.generation) {
+        snapshot_generation = snap.generation;
+    }
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "gds: dstore recovered nspace %s from snapshot generation %lu",
+                        ns_map->name, (unsigned long)snap.generation);
+    return PMIX_SUCCESS;
+
+fail:
+    /* whatever is there will be overwritten from scratch */
+    pmix_common_dstor_delete_sm_desc(meta_seg);
+    pmix_common_dstor_delete_sm_desc(data_seg);
+    _esh_snapshot_remove(ds_ctx, ns_map->name);
+    return rc;
+}
+
 PMIX_EXPORT pmix_status_t pmix_common_dstor_cache_job_info(pmix_common_dstore_ctx_t *ds_ctx,
                                 struct pmix_namespace_t *ns,
                                 pmix_info_t info[], size_t ninfo)
@@ -1545,6 +2400,7 @@ pmix_common_dstore_ctx_t *pmix_common_dstor_init(const char *ds_name, pmix_info_
     pmix_status_t rc;
     size_t n;
     char *dstor_tmpdir = NULL;
+    char *server_nspace = NULL;
     size_t tbl_idx = 0;
     ns_map_data_t *ns_map = NULL;
     pmix_common_dstore_ctx_t *ds_ctx = NULL;
@@ -1621,6 +2477,11 @@ pmix_common_dstore_ctx_t *pmix_common_dstor_init(const char *ds_name, pmix_info_
                     dstor_tmpdir = (char*)info[n].value.data.string;
                     continue;
                 }
+                if (0 == strcmp(PMIX_SERVER_NSPACE, info[n].key) &&
+                    PMIX_STRING == info[n].value.type) {
+                    server_nspace = info[n].value.data.string;
+                    continue;
+                }
                 if (0 == strcmp(PMIX_SERVER_TMPDIR, info[n].key)) {
                     if( PMIX_STRING != info[n].value.type ){
                         rc = PMIX_ERR_BAD_PARAM;
@@ -1645,8 +2506,14 @@ pmix_common_dstore_ctx_t *pmix_common_dstor_init(const char *ds_name, pmix_info_
             }
         }
 
-        rc = asprintf(&ds_ctx->base_path, "%s/pmix_dstor_%s_%d", dstor_tmpdir,
-                      ds_ctx->ds_name, getpid());
+        if (ds_ctx->persist) {
+            /* a restarted server has to find the same directory */
+            rc = asprintf(&ds_ctx->base_path, "%s/pmix_dstor_%s_%s", dstor_tmpdir,
+                          ds_ctx->ds_name, (NULL == server_nspace) ? "pmix-server" : server_nspace);
+        } else {
+            rc = asprintf(&ds_ctx->base_path, "%s/pmix_dstor_%s_%d", dstor_tmpdir,
+                          ds_ctx->ds_name, getpid());
+        }
         if ((0 > rc) || (NULL == ds_ctx->base_path)) {
             rc = PMIX_ERR_OUT_OF_RESOURCE;
             PMIX_ERROR_LOG(rc);
@@ -1755,9 +2622,14 @@ PMIX_EXPORT void pmix_common_dstor_finalize(pmix_common_dstore_ctx_t *ds_ctx)
     PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
                          "%s:%d:%s", __FILE__, __LINE__, __func__));
 
+    _esh_reclaim_finalize();
     _esh_sessions_cleanup(ds_ctx);
     _esh_ns_map_cleanup(ds_ctx);
     _esh_ns_track_cleanup(ds_ctx);
+    /* the trackers may just have returned segments to the pool */
+    if (NULL != ds_ctx->base_path) {
+        pmix_common_dstor_flush_segment_pool(ds_ctx->base_path);
+    }
 
     pmix_pshmem.finalize();
 
@@ -1789,15 +2661,34 @@ static pmix_status_t _dstore_store_nolock(pmix_common_dstore_ctx_t *ds_ctx,
                                    pmix_rank_t rank,
                                    pmix_kval_t *kv)
 {
-    pmix_status_t rc = PMIX_SUCCESS;
-    ns_track_elem_t *elem;
+    pmix_status_t rc;
     pmix_buffer_t xfer;
-    ns_seg_info_t ns_info;
 
     if (NULL == kv) {
         return PMIX_ERROR;
     }
 
+    PMIX_CONSTRUCT(&xfer, pmix_buffer_t);
+    PMIX_LOAD_BUFFER(pmix_globals.mypeer, &xfer, kv->value->data.bo.bytes, kv->value->data.bo.size);
+
+    rc = _dstore_store_buf_nolock(ds_ctx, ns_map, rank, &xfer);
+
+    PMIX_DESTRUCT(&xfer);
+
+    return rc;
+}
+
+/* store the kvals packed in the given buffer for the given rank. The
+ * buffer must have been packed using our own peer object */
+static pmix_status_t _dstore_store_buf_nolock(pmix_common_dstore_ctx_t *ds_ctx,
+                                              ns_map_data_t *ns_map,
+                                              pmix_rank_t rank,
+                                              pmix_buffer_t *buf)
+{
+    pmix_status_t rc = PMIX_SUCCESS;
+    ns_track_elem_t *elem;
+    ns_seg_info_t ns_info;
+
     PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
                          "%s:%d:%s: for %s:%u",
                          __FILE__, __LINE__, __func__, ns_map->name, rank));
@@ -1847,13 +2738,7 @@ static pmix_status_t _dstore_store_nolock(pmix_common_dstore_ctx_t *ds_ctx,
 
     /* Now we know info about meta segment for this namespace. If meta segment
      * is not empty, then we look for data for the target rank. If they present, replace it. */
-    PMIX_CONSTRUCT(&xfer, pmix_buffer_t);
-    PMIX_LOAD_BUFFER(pmix_globals.mypeer, &xfer, kv->value->data.bo.bytes, kv->value->data.bo.size);
-
-    rc = _store_data_for_rank(ds_ctx, elem, rank, &xfer);
-
-    PMIX_DESTRUCT(&xfer);
-
+    rc = _store_data_for_rank(ds_ctx, elem, rank, buf);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         goto exit;
@@ -1925,19 +2810,74 @@ exit:
     return rc;
 }
 
+/* store all the kvals in the buffer for a proc under a single write
+ * lock - the values land as one blob for the rank rather than one
+ * blob and extension slot per key */
+PMIX_EXPORT pmix_status_t pmix_common_dstor_store_buf(pmix_common_dstore_ctx_t *ds_ctx,
+                                const pmix_proc_t *proc,
+                                pmix_scope_t scope,
+                                pmix_buffer_t *buf)
+{
+    pmix_status_t rc;
+    ns_map_data_t *ns_map;
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "[%s:%d] gds: dstore store buffer of %lu bytes scope %d",
+                        proc->nspace, proc->rank,
+                        (unsigned long)buf->bytes_used, scope);
+
+    if (PMIX_PROC_IS_CLIENT(pmix_globals.mypeer)) {
+        rc = PMIX_ERR_NOT_SUPPORTED;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    if (NULL == (ns_map = ds_ctx->session_map_search(ds_ctx, proc->nspace))) {
+        rc = PMIX_ERROR;
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* set exclusive lock */
+    rc = _ESH_LOCK(ds_ctx, ns_map->tbl_idx, wr_lock);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    rc = _dstore_store_buf_nolock(ds_ctx, ns_map, proc->rank, buf);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        (void)_ESH_LOCK(ds_ctx, ns_map->tbl_idx, wr_unlock);
+        return rc;
+    }
+
+    /* unset lock */
+    rc = _ESH_LOCK(ds_ctx, ns_map->tbl_idx, wr_unlock);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    return rc;
+}
+
+/* if key is NULL, all keys of the rank are returned as an array of
+ * pmix_info_t. The keys argv can then be used to restrict the result
+ * to a set of keys, resolving all of them in a single walk of the
+ * rank data under a single read lock */
 static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
                                    const char *nspace, pmix_rank_t rank,
-                                   const char *key, pmix_value_t **kvs)
+                                   const char *key, char **keys,
+                                   pmix_value_t **kvs)
 {
     ns_seg_info_t *ns_info = NULL;
     pmix_status_t rc = PMIX_ERROR, lock_rc;
     ns_track_elem_t *elem;
     rank_meta_info *rinfo = NULL;
     size_t kval_cnt = 0;
-    pmix_dstore_seg_desc_t *meta_seg, *data_seg;
+    pmix_dstore_seg_desc_t *meta_seg;
     uint8_t *addr;
     pmix_buffer_t buffer;
-    pmix_value_t val, *kval = NULL;
+    pmix_value_t *kval = NULL;
     uint32_t nprocs;
     pmix_rank_t cur_rank;
     ns_map_data_t *ns_map = NULL;
@@ -1945,7 +2885,9 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
     bool key_found = false;
     pmix_info_t *info = NULL;
     size_t ninfo;
-    size_t keyhash = 0;
+    size_t keyhash = 0, csumhash = 0;
+    size_t *keyhashes = NULL;
+    size_t nkeys = 0, nfound = 0, k;
     bool lock_is_set = false;
 
     PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
@@ -2049,10 +2991,23 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
 
     /* Now we have the data from meta segment for this namespace. */
     meta_seg = elem->meta_seg;
-    data_seg = elem->data_seg;
 
     if( NULL != key ) {
         keyhash = PMIX_DS_KEY_HASH(ds_ctx, key);
+    } else {
+        /* the checksum is ours, not the caller's */
+        csumhash = PMIX_DS_KEY_HASH(ds_ctx, ESH_REGION_CHECKSUM);
+    }
+    if (NULL == key && NULL != keys) {
+        nkeys = pmix_argv_count(keys);
+        keyhashes = (size_t*)malloc(nkeys * sizeof(size_t));
+        if (NULL == keyhashes) {
+            rc = PMIX_ERR_NOMEM;
+            goto done;
+        }
+        for (k = 0; k < nkeys; k++) {
+            keyhashes[k] = PMIX_DS_KEY_HASH(ds_ctx, keys[k]);
+        }
     }
 
     /* all segment data updated, ctx lock may released */
@@ -2073,13 +3028,20 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
             all_ranks_found = false;
             continue;
         }
-        addr = _get_data_region_by_offset(ds_ctx, data_seg, rinfo->offset);
+        addr = _get_data_region_by_offset(ds_ctx, elem, rinfo->offset);
         if (NULL == addr) {
             /* This means that meta-info is broken - error is fatal */
             rc = PMIX_ERR_FATAL;
             PMIX_ERROR_LOG(rc);
             goto done;
         }
+        if (ds_ctx->integrity) {
+            rc = _rank_csum_verify(ds_ctx, elem, rinfo, nspace, cur_rank);
+            if (PMIX_SUCCESS != rc) {
+                kval_cnt = 0;
+                goto done;
+            }
+        }
         kval_cnt = rinfo->count;
 
         /*  Initialize array for all keys of rank */
@@ -2105,7 +3067,7 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
                 goto done;
             }
             kval->data.darray->type = PMIX_INFO;
-            kval->data.darray->size = ninfo;
+            kval->data.darray->size = 0;
             kval->data.darray->array = info;
             *kvs = kval;
         }
@@ -2140,7 +3102,7 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
                             __FILE__, __LINE__, __func__, nspace, cur_rank, ESH_REGION_EXTENSION, offset));
                 if (0 < offset) {
                     /* go to next item, updating address */
-                    addr = _get_data_region_by_offset(ds_ctx, data_seg, offset);
+                    addr = _get_data_region_by_offset(ds_ctx, elem, offset);
                     if (NULL == addr) {
                         /* This shouldn't happen - error is fatal */
                         rc = PMIX_ERR_FATAL;
@@ -2155,6 +3117,24 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
                     break;
                 }
             } else if (NULL == key) {
+                if (PMIX_DS_KEY_MATCH(ds_ctx, addr, ESH_REGION_CHECKSUM, csumhash)) {
+                    addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+                    kval_cnt--;
+                    continue;
+                }
+                if (NULL != keyhashes) {
+                    for (k = 0; k < nkeys; k++) {
+                        if (PMIX_DS_KEY_MATCH(ds_ctx, addr, keys[k], keyhashes[k])) {
+                            break;
+                        }
+                    }
+                    if (k == nkeys) {
+                        /* not one of the requested keys - go to next item */
+                        addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
+                        kval_cnt--;
+                        continue;
+                    }
+                }
                 PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
                             "%s:%d:%s: for rank %s:%u, found target key %s",
                             __FILE__, __LINE__, __func__, nspace, cur_rank, PMIX_DS_KNAME_PTR(ds_ctx, addr)));
@@ -2164,21 +3144,20 @@ static pmix_status_t _dstore_fetch(pmix_common_dstore_ctx_t *ds_ctx,
                 PMIX_CONSTRUCT(&buffer, pmix_buffer_t);
                 PMIX_LOAD_BUFFER(_client_peer(ds_ctx), &buffer, data_ptr, data_size);
                 int cnt = 1;
-                /* unpack value for this key from the buffer. */
-                PMIX_VALUE_CONSTRUCT(&val);
-                PMIX_BFROPS_UNPACK(rc, _client_peer(ds_ctx), &buffer, &val, &cnt, PMIX_VALUE);
+                /* unpack value for this key straight into its slot of the array */
+                PMIX_BFROPS_UNPACK(rc, _client_peer(ds_ctx), &buffer, &info[nfound].value, &cnt, PMIX_VALUE);
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
                     goto done;
                 }
-                pmix_strncpy(info[kval_cnt - 1].key, PMIX_DS_KNAME_PTR(ds_ctx, addr),
+                pmix_strncpy(info[nfound].key, PMIX_DS_KNAME_PTR(ds_ctx, addr),
                         PMIX_DS_KNAME_LEN(ds_ctx, addr));
-                pmix_value_xfer(&info[kval_cnt - 1].value, &val);
-                PMIX_VALUE_DESTRUCT(&val);
                 buffer.base_ptr = NULL;
                 buffer.bytes_used = 0;
                 PMIX_DESTRUCT(&buffer);
                 key_found = true;
+                nfound++;
+                kval->data.darray->size = nfound;
 
                 kval_cnt--;
                 addr += PMIX_DS_KV_SIZE(ds_ctx, addr);
@@ -2232,6 +3211,10 @@ done:
         pthread_mutex_unlock(&ds_ctx->lock);
     }
 
+    if (NULL != keyhashes) {
+        free(keyhashes);
+    }
+
     if( rc != PMIX_SUCCESS ){
         if ((NULL == key) && (kval_cnt > 0)) {
             if( NULL != info ) {
@@ -2249,6 +3232,12 @@ done:
         return PMIX_SUCCESS;
     }
 
+    if (NULL != kval) {
+        /* none of the requested keys was found */
+        PMIX_VALUE_RELEASE(kval);
+        *kvs = NULL;
+    }
+
     if( !all_ranks_found ){
         /* Not all ranks was found - need to request
          * all of them and search again
@@ -2277,11 +3266,28 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_fetch(pmix_common_dstore_ctx_t *ds_c
     pmix_kval_t *kv;
     pmix_value_t *val;
     pmix_status_t rc = PMIX_SUCCESS;
+    char **keys = NULL;
+    size_t i;
 
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                         "gds: dstore fetch `%s`", key == NULL ? "NULL" : key);
 
-    rc = _dstore_fetch(ds_ctx, proc->nspace, proc->rank, key, &val);
+    /* see if only a subset of the proc's keys was requested */
+    if (NULL == key) {
+        for (i = 0; i < ninfo; i++) {
+            if (PMIX_CHECK_KEY(&info[i], PMIX_GET_KEYS) &&
+                PMIX_STRING == info[i].value.type &&
+                NULL != info[i].value.data.string) {
+                keys = pmix_argv_split(info[i].value.data.string, ',');
+                break;
+            }
+        }
+    }
+
+    rc = _dstore_fetch(ds_ctx, proc->nspace, proc->rank, key, keys, &val);
+    if (NULL != keys) {
+        pmix_argv_free(keys);
+    }
     if (PMIX_SUCCESS == rc) {
         if( NULL == key ) {
             pmix_info_t *info;
@@ -2304,15 +3310,20 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_fetch(pmix_common_dstore_ctx_t *ds_c
                     return rc;
                 }
                 kv->key = strdup(info[n].key);
-                PMIX_VALUE_XFER(rc, kv->value, &info[n].value);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
+                /* the array is ours - move the value instead of copying
+                 * it, large byte objects are common here */
+                kv->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
+                if (NULL == kv->value) {
+                    rc = PMIX_ERR_NOMEM;
                     PMIX_RELEASE(kv);
                     PMIX_VALUE_RELEASE(val);
                     return rc;
                 }
+                memcpy(kv->value, &info[n].value, sizeof(pmix_value_t));
+                PMIX_VALUE_CONSTRUCT(&info[n].value);
                 pmix_list_append(kvs, &kv->super);
             }
+            PMIX_VALUE_RELEASE(val);
 
             return PMIX_SUCCESS;
         }
@@ -2360,6 +3371,20 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_setup_fork(pmix_common_dstore_ctx_t
                                         _ESH_SESSION_path(ds_ctx->session_array, ns_map->tbl_idx),
                                          true, env))){
         PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* readers have to find the segments the same way we created them */
+    if (PMIX_SUCCESS != (rc = pmix_setenv("PMIX_MCA_pshmem", pmix_pshmem.name, true, env))) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* readers have to know to check what we checksum */
+    if (ds_ctx->integrity) {
+        if (PMIX_SUCCESS != (rc = pmix_setenv(ESH_ENV_INTEGRITY, "1", true, env))) {
+            PMIX_ERROR_LOG(rc);
+        }
     }
 
     return rc;
@@ -2446,6 +3471,7 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_del_nspace(pmix_common_dstore_ctx_t
     ns_track_elem_t *trk = NULL;
     int dstor_track_idx;
     size_t session_tbl_idx;
+    pmix_dstore_seg_desc_t *meta_seg = NULL, *data_seg = NULL;
 
     PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
         "%s:%d:%s delete nspace `%s`", __FILE__, __LINE__, __func__, nspace));
@@ -2454,6 +3480,7 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_del_nspace(pmix_common_dstore_ctx_t
         rc = PMIX_ERR_NOT_AVAILABLE;
         return rc;
     }
+    _esh_snapshot_remove(ds_ctx, nspace);
     dstor_track_idx = ns_map_data->track_idx;
     session_tbl_idx = ns_map_data->tbl_idx;
     size = pmix_value_array_get_size(ds_ctx->ns_map_array);
@@ -2463,6 +3490,7 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_del_nspace(pmix_common_dstore_ctx_t
         if (ns_map[map_idx].in_use &&
                         (ns_map[map_idx].data.tbl_idx == ns_map_data->tbl_idx)) {
             if (0 == strcmp(ns_map[map_idx].data.name, nspace)) {
+                _esh_session_map_unindex(ds_ctx, nspace);
                 _esh_session_map_clean(ds_ctx, &ns_map[map_idx]);
                 continue;
             }
@@ -2486,11 +3514,16 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_del_nspace(pmix_common_dstore_ctx_t
             }
             trk = pmix_value_array_get_item(ds_ctx->ns_track_array, dstor_track_idx);
             if (true == trk->in_use) {
+                /* the segments go with the session */
+                meta_seg = trk->meta_seg;
+                data_seg = trk->data_seg;
+                trk->meta_seg = NULL;
+                trk->data_seg = NULL;
                 PMIX_DESTRUCT(trk);
                 pmix_value_array_remove_item(ds_ctx->ns_track_array, dstor_track_idx);
             }
         }
-        _esh_session_release(ds_ctx, session_tbl_idx);
+        _esh_session_reclaim(ds_ctx, session_tbl_idx, meta_seg, data_seg);
      }
 exit:
     return rc;
@@ -2527,6 +3560,8 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_store_modex(pmix_common_dstore_ctx_t
     pmix_status_t rc1 = PMIX_SUCCESS;
     pmix_namespace_t *ns = (pmix_namespace_t*)nspace;
     ns_map_data_t *ns_map;
+    dstor_modex_batch_t batch;
+    dstor_modex_stage_t *st;
 
     if (NULL == (ns_map = ds_ctx->session_map_search(ds_ctx, ns->nspace))) {
         rc = PMIX_ERROR;
@@ -2534,16 +3569,39 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_store_modex(pmix_common_dstore_ctx_t
         return rc;
     }
 
-    /* set exclusive lock */
-    rc = _ESH_LOCK(ds_ctx, ns_map->tbl_idx, wr_lock);
+    /* unpacking the delivery can take a good while for a large
+     * job, so stage each rank's data first and only hold the
+     * readers off while it is copied into the segments */
+    batch.ds_ctx = ds_ctx;
+    PMIX_CONSTRUCT(&batch.staged, pmix_list_t);
+    rc = pmix_gds_base_store_modex(nspace, cbs, buf, (pmix_gds_base_store_modex_cb_fn_t)_dstor_store_modex_cb, &batch);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
+        PMIX_LIST_DESTRUCT(&batch.staged);
         return rc;
     }
+    if (0 == pmix_list_get_size(&batch.staged)) {
+        PMIX_LIST_DESTRUCT(&batch.staged);
+        return PMIX_SUCCESS;
+    }
 
-    rc = pmix_gds_base_store_modex(nspace, cbs, buf, (pmix_gds_base_store_modex_cb_fn_t)_dstor_store_modex_cb, ds_ctx);
+    /* set exclusive lock */
+    rc = _ESH_LOCK(ds_ctx, ns_map->tbl_idx, wr_lock);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
+        PMIX_LIST_DESTRUCT(&batch.staged);
+        return rc;
+    }
+
+    PMIX_LIST_FOREACH(st, &batch.staged, dstor_modex_stage_t) {
+        rc = _dstore_store_buf_nolock(ds_ctx, st->ns_map, st->rank, &st->buf);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            break;
+        }
+    }
+    if (PMIX_SUCCESS == rc) {
+        _esh_snapshot_update(ds_ctx, ns_map);
     }
 
     /* unset lock */
@@ -2554,15 +3612,17 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_store_modex(pmix_common_dstore_ctx_t
             rc = rc1;
         }
     }
+    PMIX_LIST_DESTRUCT(&batch.staged);
 
     return rc;
 }
 
-static pmix_status_t _dstor_store_modex_cb(pmix_common_dstore_ctx_t *ds_ctx,
+static pmix_status_t _dstor_store_modex_cb(dstor_modex_batch_t *batch,
                                                 struct pmix_namespace_t *nspace,
                                                 pmix_list_t *cbs,
                                                 pmix_byte_object_t *bo)
 {
+    pmix_common_dstore_ctx_t *ds_ctx = batch->ds_ctx;
     pmix_namespace_t *ns = (pmix_namespace_t*)nspace;
     pmix_status_t rc = PMIX_SUCCESS;
     int32_t cnt;
@@ -2570,7 +3630,9 @@ static pmix_status_t _dstor_store_modex_cb(pmix_common_dstore_ctx_t *ds_ctx,
     pmix_proc_t proc;
     pmix_kval_t *kv;
     ns_map_data_t *ns_map;
-    pmix_buffer_t tmp;
+    dstor_modex_stage_t *st;
+    char *kvstart, *data;
+    size_t len;
 
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                         "[%s:%d] gds:dstore:store_modex for nspace %s",
@@ -2612,8 +3674,12 @@ static pmix_status_t _dstor_store_modex_cb(pmix_common_dstore_ctx_t *ds_ctx,
         return PMIX_SUCCESS;
     }
 
-    /* Prepare a buffer to be provided to the dstor store primitive */
-    PMIX_CONSTRUCT(&tmp, pmix_buffer_t);
+    /* the remainder of the byte object consists of the kvals
+     * packed with our own peer object, which is exactly the form
+     * required by the dstor store primitive - so remember where
+     * they start and pass them along in place once we are done
+     * instead of repacking them into a separate buffer */
+    kvstart = pbkt.unpack_ptr;
 
     /* unpack the remaining values until we hit the end of the buffer */
     cnt = 1;
@@ -2624,6 +3690,7 @@ static pmix_status_t _dstor_store_modex_cb(pmix_common_dstore_ctx_t *ds_ctx,
         PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &proc, PMIX_REMOTE, kv);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(kv);
             bo->bytes = pbkt.base_ptr;
             bo->size = pbkt.bytes_used; // restore the incoming data
             pbkt.base_ptr = NULL;
@@ -2631,9 +3698,6 @@ static pmix_status_t _dstor_store_modex_cb(pmix_common_dstore_ctx_t *ds_ctx,
             return rc;
         }
 
-        /* place the key to the to be provided to _dstore_store_nolock */
-        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &tmp, kv, 1, PMIX_KVAL);
-
         /* Release the kv to maintain accounting
          * as the hash increments the ref count */
         PMIX_RELEASE(kv);
@@ -2653,13 +3717,6 @@ static pmix_status_t _dstor_store_modex_cb(pmix_common_dstore_ctx_t *ds_ctx,
         rc = PMIX_SUCCESS;
     }
 
-    /* Create a key-value pair with the buffer
-     * to be passed to _dstore_store_nolock */
-    kv = PMIX_NEW(pmix_kval_t);
-    PMIX_VALUE_CREATE(kv->value, 1);
-    kv->value->type = PMIX_BYTE_OBJECT;
-    PMIX_UNLOAD_BUFFER(&tmp, kv->value->data.bo.bytes, kv->value->data.bo.size);
-
     /* Get the namespace map element for the process "proc" */
     if (NULL == (ns_map = ds_ctx->session_map_search(ds_ctx, proc.nspace))) {
         rc = PMIX_ERROR;
@@ -2671,16 +3728,31 @@ static pmix_status_t _dstor_store_modex_cb(pmix_common_dstore_ctx_t *ds_ctx,
         return rc;
     }
 
-    /* Store all keys at once */
-    rc = _dstore_store_nolock(ds_ctx, ns_map, proc.rank, kv);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
+    /* the incoming data is only ours until we return, so keep a
+     * copy of the kvals for storing them all at once later */
+    len = pbkt.bytes_used - (size_t)(kvstart - pbkt.base_ptr);
+    if (0 < len) {
+        st = PMIX_NEW(dstor_modex_stage_t);
+        data = (char*)malloc(len);
+        if (NULL == st || NULL == data) {
+            rc = PMIX_ERR_NOMEM;
+            PMIX_ERROR_LOG(rc);
+            if (NULL != st) {
+                PMIX_RELEASE(st);
+            }
+            if (NULL != data) {
+                free(data);
+            }
+        } else {
+            memcpy(data, kvstart, len);
+            st->ns_map = ns_map;
+            st->rank = proc.rank;
+            PMIX_LOAD_BUFFER(pmix_globals.mypeer, &st->buf, data, len);
+            pmix_list_append(&batch->staged, &st->super);
+            rc = PMIX_SUCCESS;
+        }
     }
 
-    /* Release all resources */
-    PMIX_RELEASE(kv);
-    PMIX_DESTRUCT(&tmp);
-
     /* Reset the input buffer */
     bo->bytes = pbkt.base_ptr;
     bo->size = pbkt.bytes_used;
@@ -2696,14 +3768,11 @@ static pmix_status_t _store_job_info(pmix_common_dstore_ctx_t *ds_ctx, ns_map_da
     pmix_cb_t cb;
     pmix_kval_t *kv;
     pmix_buffer_t buf;
-    pmix_kval_t *kv2 = NULL, *kvp;
+    pmix_kval_t *kv2 = NULL;
     pmix_status_t rc = PMIX_SUCCESS;
 
     PMIX_CONSTRUCT(&cb, pmix_cb_t);
     PMIX_CONSTRUCT(&buf, pmix_buffer_t);
-    kvp = PMIX_NEW(pmix_kval_t);
-    PMIX_VALUE_CREATE(kvp->value, 1);
-    kvp->value->type = PMIX_BYTE_OBJECT;
 
     cb.proc = proc;
     cb.scope = PMIX_INTERNAL;
@@ -2755,14 +3824,15 @@ static pmix_status_t _store_job_info(pmix_common_dstore_ctx_t *ds_ctx, ns_map_da
         }
     }
 
-    PMIX_UNLOAD_BUFFER(&buf, kvp->value->data.bo.bytes, kvp->value->data.bo.size);
-    if (PMIX_SUCCESS != (rc = _dstore_store_nolock(ds_ctx, ns_map, proc->rank, kvp))) {
+    /* this runs once per rank when a nspace is registered, so store
+     * straight from the packed buffer rather than unloading it into
+     * a byte object only to have it loaded back */
+    if (PMIX_SUCCESS != (rc = _dstore_store_buf_nolock(ds_ctx, ns_map, proc->rank, &buf))) {
         PMIX_ERROR_LOG(rc);
         goto exit;
     }
 
 exit:
-    PMIX_RELEASE(kvp);
     PMIX_DESTRUCT(&cb);
     PMIX_DESTRUCT(&buf);
     return rc;
@@ -2803,19 +3873,22 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_register_job_info(pmix_common_dstore
             return rc;
         }
 
-        rc = _store_job_info(ds_ctx, ns_map, &proc);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            return rc;
-        }
-
-        for (rank=0; rank < ns->nprocs; rank++) {
-            proc.rank = rank;
+        if (PMIX_SUCCESS != _esh_snapshot_recover(ds_ctx, ns_map)) {
             rc = _store_job_info(ds_ctx, ns_map, &proc);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
                 return rc;
             }
+
+            for (rank=0; rank < ns->nprocs; rank++) {
+                proc.rank = rank;
+                rc = _store_job_info(ds_ctx, ns_map, &proc);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    return rc;
+                }
+            }
+            _esh_snapshot_update(ds_ctx, ns_map);
         }
         /* unset lock */
         rc = _ESH_LOCK(ds_ctx, ns_map->tbl_idx, wr_unlock);
@@ -2855,6 +3928,51 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_store_job_info(pmix_common_dstore_ct
     return rc;
 }
 
+/* shared memory mapped for each nspace - the segments are
+ * counted at their full size whether or not they are filled */
+PMIX_EXPORT void pmix_common_dstor_mem_usage(pmix_common_dstore_ctx_t *ds_ctx,
+                                             pmix_list_t *usage)
+{
+    ns_track_elem_t *trk;
+    pmix_dstore_seg_desc_t *seg;
+    pmix_kval_t *kv;
+    size_t n, size, sz;
+
+    if (NULL == ds_ctx->ns_track_array) {
+        return;
+    }
+    size = pmix_value_array_get_size(ds_ctx->ns_track_array);
+    trk = PMIX_VALUE_ARRAY_GET_BASE(ds_ctx->ns_track_array, ns_track_elem_t);
+    for (n=0; n < size; n++) {
+        if (!trk[n].in_use) {
+            continue;
+        }
+        sz = 0;
+        for (seg = trk[n].meta_seg; NULL != seg; seg = seg->next) {
+            sz += seg->seg_info.seg_size;
+        }
+        for (seg = trk[n].data_seg; NULL != seg; seg = seg->next) {
+            sz += seg->seg_info.seg_size;
+        }
+        kv = PMIX_NEW(pmix_kval_t);
+        if (NULL == kv) {
+            return;
+        }
+        if (0 > asprintf(&kv->key, "gds.%s:%s", ds_ctx->ds_name, trk[n].ns_map.name)) {
+            PMIX_RELEASE(kv);
+            return;
+        }
+        PMIX_VALUE_CREATE(kv->value, 1);
+        if (NULL == kv->value) {
+            PMIX_RELEASE(kv);
+            return;
+        }
+        kv->value->type = PMIX_SIZE;
+        kv->value->data.size = sz;
+        pmix_list_append(usage, &kv->super);
+    }
+}
+
 static void _client_compat_save(pmix_common_dstore_ctx_t *ds_ctx, pmix_peer_t *peer)
 {
     pmix_namespace_t *nptr = NULL;
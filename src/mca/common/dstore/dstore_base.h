@@ -22,6 +22,7 @@ BEGIN_C_DECLS
 
 #include <src/include/pmix_config.h>
 #include "src/class/pmix_value_array.h"
+#include "src/class/pmix_hash_table.h"
 #include "dstore_common.h"
 #include "dstore_segment.h"
 #include "dstore_file.h"
@@ -48,6 +49,8 @@ struct pmix_common_dstore_ctx_s {
 
     pmix_value_array_t *session_array;
     pmix_value_array_t *ns_map_array;
+    pmix_hash_table_t *ns_map_idx;      // nspace -> slot in ns_map_array
+    int ns_map_last;                    // slot of the last nspace looked up
     pmix_value_array_t *ns_track_array;
 
     pmix_common_lock_callbacks_t *lock_cbs;
@@ -71,6 +74,15 @@ struct pmix_common_dstore_ctx_s {
      * sparse communication patterns when direct modex is usually used.
      */
     int direct_mode;
+    /* keep a snapshot record of every stored nspace in a directory
+     * that survives a restart of the server (server only) */
+    int persist;
+    /* keep a checksum of every rank's data next to it, and check
+     * it the first time a reader looks at that version of the data */
+    int integrity;
+    /* rewrite a rank's live data once this percentage of its
+     * region is taken by invalidated entries (0 - never) */
+    size_t compact_pct;
     /* dstore ctx protect lock, uses for clients only */
     pthread_mutex_t lock;
 };
@@ -126,6 +138,9 @@ typedef struct {
     size_t num_data_seg;
     pmix_dstore_seg_desc_t *meta_seg;
     pmix_dstore_seg_desc_t *data_seg;
+    pmix_dstore_seg_desc_t **data_segs_idx; // data segments indexed by id
+    size_t ndata_segs_idx;                  // number of indexed data segments
+    pmix_hash_table_t *verified;            // rank -> checksum already verified
     bool in_use;
 } ns_track_elem_t;
 
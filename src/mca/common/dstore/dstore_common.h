@@ -67,6 +67,10 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_store(pmix_common_dstore_ctx_t *ds_c
                                 const pmix_proc_t *proc,
                                 pmix_scope_t scope,
                                 pmix_kval_t *kv);
+PMIX_EXPORT pmix_status_t pmix_common_dstor_store_buf(pmix_common_dstore_ctx_t *ds_ctx,
+                                const pmix_proc_t *proc,
+                                pmix_scope_t scope,
+                                pmix_buffer_t *buf);
 PMIX_EXPORT pmix_status_t pmix_common_dstor_fetch(pmix_common_dstore_ctx_t *ds_ctx,
                                 const pmix_proc_t *proc,
                                 pmix_scope_t scope, bool copy,
@@ -77,4 +81,6 @@ PMIX_EXPORT pmix_status_t pmix_common_dstor_store_modex(pmix_common_dstore_ctx_t
                                 struct pmix_namespace_t *nspace,
                                 pmix_list_t *cbs,
                                 pmix_buffer_t *buff);
+PMIX_EXPORT void pmix_common_dstor_mem_usage(pmix_common_dstore_ctx_t *ds_ctx,
+                                pmix_list_t *usage);
 #endif
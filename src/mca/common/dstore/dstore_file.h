@@ -36,10 +36,15 @@ typedef struct {
 
 #define ESH_REGION_EXTENSION        "EXTENSION_SLOT"
 #define ESH_REGION_INVALIDATED      "INVALIDATED"
+#define ESH_REGION_CHECKSUM         "pmix.ds.csum"
 #define ESH_ENV_INITIAL_SEG_SIZE    "INITIAL_SEG_SIZE"
 #define ESH_ENV_NS_META_SEG_SIZE    "NS_META_SEG_SIZE"
 #define ESH_ENV_NS_DATA_SEG_SIZE    "NS_DATA_SEG_SIZE"
 #define ESH_ENV_LINEAR              "SM_USE_LINEAR_SEARCH"
+#define ESH_ENV_NS_SEG_POOL_SIZE    "NS_SEG_POOL_SIZE"
+#define ESH_ENV_PERSIST             "SM_PERSIST"
+#define ESH_ENV_INTEGRITY           "SM_INTEGRITY"
+#define ESH_ENV_COMPACT_PCT         "SM_COMPACT_PCT"
 
 #define ESH_MIN_KEY_LEN             (sizeof(ESH_REGION_INVALIDATED))
 
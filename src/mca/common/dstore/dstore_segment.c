@@ -27,6 +27,7 @@
 #ifdef HAVE_FCNTL_H
 #include <fcntl.h>
 #endif
+#include <sys/mman.h>
 
 #ifdef HAVE_SYS_AUXV_H
 #include <sys/auxv.h>
@@ -47,6 +48,86 @@ static size_t _initial_segment_size;
 static size_t _meta_segment_size;
 static size_t _data_segment_size;
 
+/* Released nspace segments the server keeps mapped for the next
+ * nspace instead of unlinking them - a new segment would otherwise
+ * have to be faulted in page by page all over again. A pooled file
+ * is renamed out of the way and stays in the directory it was
+ * created in, so it can only be handed out again under that path */
+static pmix_dstore_seg_desc_t *_seg_pool = NULL;
+static size_t _seg_pool_size = 0;
+static size_t _seg_pool_max = 0;
+static unsigned long _seg_pool_count = 0;
+
+static size_t _segment_size(pmix_dstore_segment_type type)
+{
+    switch (type) {
+        case PMIX_DSTORE_NS_META_SEGMENT:
+            return _meta_segment_size;
+        case PMIX_DSTORE_NS_DATA_SEGMENT:
+            return _data_segment_size;
+        default:
+            return 0;
+    }
+}
+
+static bool _segment_in_dir(pmix_dstore_seg_desc_t *desc, const char *base_path)
+{
+    size_t len = strlen(base_path);
+
+    return (0 == strncmp(desc->seg_info.seg_name, base_path, len) &&
+            '/' == desc->seg_info.seg_name[len]);
+}
+
+static pmix_dstore_seg_desc_t *_seg_pool_get(pmix_dstore_segment_type type,
+                                             const char *base_path,
+                                             const char *file_name)
+{
+    pmix_dstore_seg_desc_t *desc, *prev = NULL;
+
+    for (desc = _seg_pool; NULL != desc; prev = desc, desc = desc->next) {
+        if (desc->type != type || desc->seg_info.seg_size != _segment_size(type) ||
+            !_segment_in_dir(desc, base_path)) {
+            continue;
+        }
+        if (PMIX_SUCCESS != pmix_pshmem.segment_rename(&desc->seg_info, file_name)) {
+            continue;
+        }
+        if (NULL == prev) {
+            _seg_pool = desc->next;
+        } else {
+            prev->next = desc->next;
+        }
+        _seg_pool_size--;
+        desc->next = NULL;
+        return desc;
+    }
+    return NULL;
+}
+
+static bool _seg_pool_put(pmix_dstore_seg_desc_t *desc)
+{
+    char *dir, file_name[PMIX_PATH_MAX];
+
+    if (_seg_pool_size >= _seg_pool_max ||
+        desc->seg_info.seg_cpid != getpid() ||
+        0 == _segment_size(desc->type) ||
+        desc->seg_info.seg_size != _segment_size(desc->type) ||
+        NULL == (dir = strrchr(desc->seg_info.seg_name, '/'))) {
+        return false;
+    }
+    snprintf(file_name, PMIX_PATH_MAX, "%.*s/pool-segment-%lu",
+             (int)(dir - desc->seg_info.seg_name), desc->seg_info.seg_name,
+             _seg_pool_count++);
+    /* modules that cannot rename a segment cannot pool them */
+    if (PMIX_SUCCESS != pmix_pshmem.segment_rename(&desc->seg_info, file_name)) {
+        return false;
+    }
+    desc->next = _seg_pool;
+    _seg_pool = desc;
+    _seg_pool_size++;
+    return true;
+}
+
 PMIX_EXPORT int pmix_common_dstor_getpagesize(void)
 {
 #if defined(_SC_PAGESIZE )
@@ -82,6 +163,33 @@ PMIX_EXPORT void pmix_common_dstor_init_segment_info(size_t initial_segment_size
     _data_segment_size = data_segment_size;
 }
 
+PMIX_EXPORT void pmix_common_dstor_init_segment_pool(size_t max_segments)
+{
+    _seg_pool_max = max_segments;
+}
+
+PMIX_EXPORT void pmix_common_dstor_flush_segment_pool(const char *base_path)
+{
+    pmix_dstore_seg_desc_t *desc, *prev = NULL, *next;
+
+    for (desc = _seg_pool; NULL != desc; desc = next) {
+        next = desc->next;
+        if (NULL != base_path && !_segment_in_dir(desc, base_path)) {
+            prev = desc;
+            continue;
+        }
+        if (NULL == prev) {
+            _seg_pool = next;
+        } else {
+            prev->next = next;
+        }
+        _seg_pool_size--;
+        pmix_pshmem.segment_unlink(&desc->seg_info);
+        pmix_pshmem.segment_detach(&desc->seg_info);
+        free(desc);
+    }
+}
+
 PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_create_new_lock_seg(const char *base_path, size_t size,
                                                  const char *name, uint32_t id, uid_t uid, bool setuid)
 {
@@ -108,13 +216,10 @@ PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_create_new_lock_seg(const
             memset(new_seg->seg_info.seg_base_addr, 0, size);
 
             if (setuid > 0){
-                rc = PMIX_ERR_PERM;
-                if (0 > chown(file_name, (uid_t) uid, (gid_t) -1)){
-                    PMIX_ERROR_LOG(rc);
-                    goto err_exit;
-                }
-                /* set the mode as required */
-                if (0 > chmod(file_name, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP )) {
+                /* set the owner and mode as required */
+                rc = pmix_pshmem.segment_chown(&new_seg->seg_info, (uid_t) uid,
+                                               S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP);
+                if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
                     goto err_exit;
                 }
@@ -186,8 +291,11 @@ PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_create_new_segment(pmix_ds
             PMIX_ERROR_LOG(PMIX_ERROR);
             return NULL;
     }
-    new_seg = (pmix_dstore_seg_desc_t*)malloc(sizeof(pmix_dstore_seg_desc_t));
-    if (new_seg) {
+    if (NULL != (new_seg = _seg_pool_get(type, base_path, file_name))) {
+        /* already mapped and faulted in - only the contents go */
+        new_seg->id = id;
+        memset(new_seg->seg_info.seg_base_addr, 0, size);
+    } else if (NULL != (new_seg = (pmix_dstore_seg_desc_t*)malloc(sizeof(pmix_dstore_seg_desc_t)))) {
         new_seg->id = id;
         new_seg->next = NULL;
         new_seg->type = type;
@@ -197,15 +305,14 @@ PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_create_new_segment(pmix_ds
             goto err_exit;
         }
         memset(new_seg->seg_info.seg_base_addr, 0, size);
+    }
+    if (NULL != new_seg) {
 
         if (setuid > 0){
-            rc = PMIX_ERR_PERM;
-            if (0 > chown(file_name, (uid_t) uid, (gid_t) -1)){
-                PMIX_ERROR_LOG(rc);
-                goto err_exit;
-            }
-            /* set the mode as required */
-            if (0 > chmod(file_name, S_IRUSR | S_IRGRP | S_IWGRP )) {
+            /* set the owner and mode as required */
+            rc = pmix_pshmem.segment_chown(&new_seg->seg_info, (uid_t) uid,
+                                           S_IRUSR | S_IRGRP | S_IWGRP);
+            if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
                 goto err_exit;
             }
@@ -260,7 +367,69 @@ PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_attach_new_segment(pmix_ds
         free(new_seg);
         new_seg = NULL;
         PMIX_ERROR_LOG(rc);
+        return NULL;
+    }
+#ifdef MADV_WILLNEED
+    /* the initial segment is scanned right away to locate the
+     * namespace, so ask for it to be read in ahead of the faults */
+    if (PMIX_DSTORE_INITIAL_SEGMENT == type) {
+        (void)madvise(new_seg->seg_info.seg_base_addr, new_seg->seg_info.seg_size, MADV_WILLNEED);
+    }
+#endif
+    return new_seg;
+}
+
+/* take over a segment left behind by an earlier instance of this
+ * server - it is mapped writable and belongs to us from now on, so
+ * it gets unlinked like any segment we created ourselves */
+PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_reopen_segment(pmix_dstore_segment_type type,
+                                                 const char *base_path,
+                                                 const char *name, uint32_t id)
+{
+    pmix_status_t rc;
+    size_t size;
+    pmix_dstore_seg_desc_t *new_seg = NULL;
+
+    PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
+                         "%s:%d:%s: segment type %d, nspace %s, id %u",
+                         __FILE__, __LINE__, __func__, type, name, id));
+
+    new_seg = (pmix_dstore_seg_desc_t*)malloc(sizeof(pmix_dstore_seg_desc_t));
+    if (NULL == new_seg) {
+        return NULL;
+    }
+    new_seg->id = id;
+    new_seg->next = NULL;
+    new_seg->type = type;
+
+    switch (type) {
+        case PMIX_DSTORE_NS_META_SEGMENT:
+            new_seg->seg_info.seg_size = _meta_segment_size;
+            snprintf(new_seg->seg_info.seg_name, PMIX_PATH_MAX, "%s/smseg-%s-%u",
+                     base_path, name, id);
+            break;
+        case PMIX_DSTORE_NS_DATA_SEGMENT:
+            new_seg->seg_info.seg_size = _data_segment_size;
+            snprintf(new_seg->seg_info.seg_name, PMIX_PATH_MAX, "%s/smdataseg-%s-%d",
+                     base_path, name, id);
+            break;
+        default:
+            free(new_seg);
+            PMIX_ERROR_LOG(PMIX_ERROR);
+            return NULL;
+    }
+    /* a short segment can be mapped, but touching it would fault */
+    if (PMIX_SUCCESS != pmix_pshmem.segment_size(&new_seg->seg_info, &size) ||
+        size < new_seg->seg_info.seg_size) {
+        free(new_seg);
+        return NULL;
     }
+    rc = pmix_pshmem.segment_attach(&new_seg->seg_info, PMIX_PSHMEM_RW);
+    if (PMIX_SUCCESS != rc) {
+        free(new_seg);
+        return NULL;
+    }
+    new_seg->seg_info.seg_cpid = getpid();
     return new_seg;
 }
 
@@ -291,6 +460,10 @@ PMIX_EXPORT void pmix_common_dstor_delete_sm_desc(pmix_dstore_seg_desc_t *desc)
     /* free all global segments */
     while (NULL != desc) {
         tmp = desc->next;
+        if (_seg_pool_put(desc)) {
+            desc = tmp;
+            continue;
+        }
         /* detach & unlink from current desc */
         if (desc->seg_info.seg_cpid == getpid()) {
             pmix_pshmem.segment_unlink(&desc->seg_info);
@@ -52,12 +52,17 @@ PMIX_EXPORT size_t pmix_common_dstor_getcacheblocksize(void);
 PMIX_EXPORT void pmix_common_dstor_init_segment_info(size_t initial_segment_size,
                         size_t meta_segment_size,
                         size_t data_segment_size);
+PMIX_EXPORT void pmix_common_dstor_init_segment_pool(size_t max_segments);
+PMIX_EXPORT void pmix_common_dstor_flush_segment_pool(const char *base_path);
 PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_create_new_segment(pmix_dstore_segment_type type,
                         const char *base_path, const char *name, uint32_t id,
                         uid_t uid, bool setuid);
 PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_attach_new_segment(pmix_dstore_segment_type type,
                         const char *base_path,
                         const char *name, uint32_t id);
+PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_reopen_segment(pmix_dstore_segment_type type,
+                        const char *base_path,
+                        const char *name, uint32_t id);
 PMIX_EXPORT pmix_dstore_seg_desc_t *pmix_common_dstor_extend_segment(pmix_dstore_seg_desc_t *segdesc,
                         const char *base_path,
                         const char *name, uid_t uid, bool setuid);
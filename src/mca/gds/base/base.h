@@ -91,6 +91,10 @@ PMIX_EXPORT extern pmix_gds_globals_t pmix_gds_globals;
 PMIX_EXPORT char* pmix_gds_base_get_available_modules(void);
 
 
+/* check if the named module is in the comma-delimited list
+ * of modules - a NULL list includes every module */
+PMIX_EXPORT bool pmix_gds_base_module_listed(const char *modules, const char *name);
+
 /* Select a gds module based on the provided directives */
 PMIX_EXPORT pmix_gds_base_module_t* pmix_gds_base_assign_module(pmix_info_t *info,
                                                                 size_t ninfo);
@@ -19,6 +19,7 @@
 
 #include "src/class/pmix_list.h"
 #include "src/util/argv.h"
+#include "src/util/compress.h"
 #include "src/util/error.h"
 
 #include "src/mca/gds/base/base.h"
@@ -33,6 +34,26 @@ char* pmix_gds_base_get_available_modules(void)
     return strdup(pmix_gds_globals.all_mods);
 }
 
+bool pmix_gds_base_module_listed(const char *modules, const char *name)
+{
+    char **mods;
+    bool found = false;
+    int n;
+
+    if (NULL == modules) {
+        return true;
+    }
+    mods = pmix_argv_split(modules, ',');
+    for (n=0; NULL != mods && NULL != mods[n]; n++) {
+        if (0 == strcmp(mods[n], name)) {
+            found = true;
+            break;
+        }
+    }
+    pmix_argv_free(mods);
+    return found;
+}
+
 /* Select a gds module per the given directives */
 pmix_gds_base_module_t* pmix_gds_base_assign_module(pmix_info_t *info, size_t ninfo)
 {
@@ -93,18 +114,24 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace,
 {
     pmix_status_t rc = PMIX_SUCCESS;
     pmix_namespace_t * ns = (pmix_namespace_t *)nspace;
-    pmix_buffer_t bkt;
+    pmix_buffer_t bkt, zbkt, *src;
     pmix_byte_object_t bo, bo2;
     int32_t cnt = 1;
     char byte;
     pmix_collect_t ctype;
     bool have_ctype = false;
+    bool copied = false;
+    uint8_t *zbytes;
+    size_t zsize;
 
     /* Loop over the enclosed byte object envelopes and
-     * store them in our GDS module */
-    cnt = 1;
-    PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer,
-            buff, &bo, &cnt, PMIX_BYTE_OBJECT);
+     * store them in our GDS module. The envelopes are only
+     * parsed here, so reference them in place rather than
+     * copying what can be a very large payload */
+    PMIX_CONSTRUCT(&bkt, pmix_buffer_t);
+    PMIX_CONSTRUCT(&zbkt, pmix_buffer_t);
+    PMIX_BFROPS_UNPACK_BORROW(rc, pmix_globals.mypeer,
+            buff, &bo, copied);
     while (PMIX_SUCCESS == rc) {
         PMIX_LOAD_BUFFER(pmix_globals.mypeer, &bkt, bo.bytes, bo.size);
         /* unpack the data collection flag */
@@ -120,6 +147,29 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace,
             goto error;
         }
 
+        /* the sending server may have compressed the contributions
+         * into a single block - if so, expand them into their own
+         * buffer and process them from there */
+        src = &bkt;
+        if ((char)(PMIX_COLLECT_YES | PMIX_COLLECT_COMPRESSED) == byte) {
+            byte = PMIX_COLLECT_YES;
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer,
+                    &bkt, &bo2, &cnt, PMIX_BYTE_OBJECT);
+            if (PMIX_SUCCESS != rc) {
+                goto error;
+            }
+            if (!pmix_util_uncompress_block(&zbytes, &zsize,
+                                            (uint8_t*)bo2.bytes, bo2.size)) {
+                PMIX_BYTE_OBJECT_DESTRUCT(&bo2);
+                rc = PMIX_ERR_UNPACK_FAILURE;
+                goto error;
+            }
+            PMIX_BYTE_OBJECT_DESTRUCT(&bo2);
+            PMIX_LOAD_BUFFER(pmix_globals.mypeer, &zbkt, zbytes, zsize);
+            src = &zbkt;
+        }
+
         // Check that this blob was accumulated with the same data collection setting
         if (have_ctype) {
             if (ctype != (pmix_collect_t)byte) {
@@ -135,7 +185,7 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace,
         /* unpack the enclosed blobs from the various peers */
         cnt = 1;
         PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer,
-                &bkt, &bo2, &cnt, PMIX_BYTE_OBJECT);
+                src, &bo2, &cnt, PMIX_BYTE_OBJECT);
         while (PMIX_SUCCESS == rc) {
             /* unpack all the kval's from this peer and store them in
              * our GDS. Note that PMIx by design holds all data at
@@ -151,23 +201,36 @@ pmix_status_t pmix_gds_base_store_modex(struct pmix_namespace_t *nspace,
             /* get the next blob */
             cnt = 1;
             PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer,
-                    &bkt, &bo2, &cnt, PMIX_BYTE_OBJECT);
+                    src, &bo2, &cnt, PMIX_BYTE_OBJECT);
         }
         if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER == rc) {
             rc = PMIX_SUCCESS;
         } else if (PMIX_SUCCESS != rc) {
             goto error;
         }
+        /* detach a borrowed envelope so that destructing
+         * the buffer only releases data we own */
+        if (!copied) {
+            PMIX_UNLOAD_BUFFER(&bkt, bo.bytes, bo.size);
+        }
+        PMIX_DESTRUCT(&bkt);
+        PMIX_CONSTRUCT(&bkt, pmix_buffer_t);
+        PMIX_DESTRUCT(&zbkt);
+        PMIX_CONSTRUCT(&zbkt, pmix_buffer_t);
         /* unpack and process the next blob */
-        cnt = 1;
-        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer,
-                buff, &bo, &cnt, PMIX_BYTE_OBJECT);
+        PMIX_BFROPS_UNPACK_BORROW(rc, pmix_globals.mypeer,
+                buff, &bo, copied);
     }
     if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER == rc) {
         rc = PMIX_SUCCESS;
     }
 
 error:
+    if (!copied) {
+        PMIX_UNLOAD_BUFFER(&bkt, bo.bytes, bo.size);
+    }
+    PMIX_DESTRUCT(&bkt);
+    PMIX_DESTRUCT(&zbkt);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
     }
@@ -151,6 +151,18 @@ static pmix_status_t ds12_del_nspace(const char* nspace)
     return pmix_common_dstor_del_nspace(ds12_ctx, nspace);
 }
 
+static pmix_status_t ds12_store_buf(const pmix_proc_t *proc,
+                                   pmix_scope_t scope,
+                                   pmix_buffer_t *buf)
+{
+    return pmix_common_dstor_store_buf(ds12_ctx, proc, scope, buf);
+}
+
+static void ds12_mem_usage(pmix_list_t *usage)
+{
+    pmix_common_dstor_mem_usage(ds12_ctx, usage);
+}
+
 pmix_gds_base_module_t pmix_ds12_module = {
     .name = "ds12",
     .is_tsafe = false,
@@ -166,5 +178,7 @@ pmix_gds_base_module_t pmix_ds12_module = {
     .setup_fork = ds12_setup_fork,
     .add_nspace = ds12_add_nspace,
     .del_nspace = ds12_del_nspace,
+    .mem_usage = ds12_mem_usage,
+    .store_buf = ds12_store_buf
 };
 
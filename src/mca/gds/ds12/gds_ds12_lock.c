@@ -19,7 +19,7 @@ pmix_common_lock_callbacks_t pmix_ds12_lock_module = {
     .init = pmix_gds_ds12_lock_init,
     .finalize = pmix_ds12_lock_finalize,
     .rd_lock = pmix_ds12_lock_rd_get,
-    .rd_unlock = pmix_ds12_lock_rw_rel,
+    .rd_unlock = pmix_ds12_lock_rd_rel,
     .wr_lock = pmix_ds12_lock_wr_get,
-    .wr_unlock = pmix_ds12_lock_rw_rel
+    .wr_unlock = pmix_ds12_lock_wr_rel
 };
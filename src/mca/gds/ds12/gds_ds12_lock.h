@@ -22,7 +22,8 @@ pmix_status_t pmix_gds_ds12_lock_init(pmix_common_dstor_lock_ctx_t *lock_ctx,
 void pmix_ds12_lock_finalize(pmix_common_dstor_lock_ctx_t *lock_ctx);
 pmix_status_t pmix_ds12_lock_rd_get(pmix_common_dstor_lock_ctx_t lock_ctx);
 pmix_status_t pmix_ds12_lock_wr_get(pmix_common_dstor_lock_ctx_t lock_ctx);
-pmix_status_t pmix_ds12_lock_rw_rel(pmix_common_dstor_lock_ctx_t lock_ctx);
+pmix_status_t pmix_ds12_lock_rd_rel(pmix_common_dstor_lock_ctx_t lock_ctx);
+pmix_status_t pmix_ds12_lock_wr_rel(pmix_common_dstor_lock_ctx_t lock_ctx);
 
 extern pmix_common_lock_callbacks_t pmix_ds12_lock_module;
 
@@ -27,16 +27,22 @@
 #ifdef HAVE_FCNTL_H
 #include <fcntl.h>
 #endif
+#ifdef HAVE_PTHREAD_SHARED
+#include <pthread.h>
+#endif
 
 #include <pmix_common.h>
 
 #include "src/mca/common/dstore/dstore_common.h"
 #include "src/mca/gds/base/base.h"
+#include "src/mca/pshmem/pshmem.h"
+#include "src/server/pmix_server_ops.h"
 
 #include "src/util/error.h"
 #include "src/util/output.h"
 
 #include "gds_ds12_lock.h"
+#include "src/mca/common/dstore/dstore_segment.h"
 
 #define _ESH_12_FCNTL_LOCK(lockfd, operation)               \
 __pmix_attribute_extension__ ({                             \
@@ -79,8 +85,124 @@ __pmix_attribute_extension__ ({                             \
 typedef struct {
     char *lockfile;
     int lockfd;
+#ifdef HAVE_PTHREAD_SHARED
+    pmix_pshmem_seg_t *segment;
+    pthread_rwlock_t *rwlock;
+#endif
 } ds12_lock_fcntl_ctx_t;
 
+#ifdef HAVE_PTHREAD_SHARED
+/* The lock file stays exactly as it is so that clients which only
+ * know about it keep working. If asked to, the server also puts a
+ * process-shared rwlock into a small segment next to it and takes
+ * both for write. Clients that find the segment read under the
+ * rwlock alone, which costs no syscall unless there is contention */
+static void _shm_lock_release(ds12_lock_fcntl_ctx_t *lock_ctx)
+{
+    if (NULL == lock_ctx->segment) {
+        return;
+    }
+    if (NULL != lock_ctx->rwlock &&
+        PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        pthread_rwlock_destroy(lock_ctx->rwlock);
+    }
+    if (NULL != lock_ctx->segment->seg_base_addr) {
+        /* detach & unlink from current desc */
+        if (lock_ctx->segment->seg_cpid == getpid()) {
+            pmix_pshmem.segment_unlink(lock_ctx->segment);
+        }
+        pmix_pshmem.segment_detach(lock_ctx->segment);
+    }
+    free(lock_ctx->segment);
+    lock_ctx->segment = NULL;
+    lock_ctx->rwlock = NULL;
+}
+
+static void _shm_lock_init(ds12_lock_fcntl_ctx_t *lock_ctx, const char *base_path,
+                           uid_t uid, bool setuid)
+{
+    size_t size = pmix_common_dstor_getpagesize();
+    pthread_rwlockattr_t attr;
+    char *name = NULL;
+    int rc;
+
+    if (0 > asprintf(&name, "%s/dstore_sm.rwlock", base_path)) {
+        return;
+    }
+    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer) &&
+        !pmix_server_globals.ds12_shm_lock) {
+        /* make sure clients don't find one left behind by
+         * an earlier server that we won't be taking */
+        unlink(name);
+        free(name);
+        return;
+    }
+    /* a client only uses the segment if its server made one */
+    if (!PMIX_PROC_IS_SERVER(pmix_globals.mypeer) &&
+        0 != access(name, F_OK)) {
+        free(name);
+        return;
+    }
+    lock_ctx->segment = (pmix_pshmem_seg_t *)calloc(1, sizeof(pmix_pshmem_seg_t));
+    if (NULL == lock_ctx->segment) {
+        free(name);
+        return;
+    }
+
+    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
+        if (PMIX_SUCCESS != pmix_pshmem.segment_create(lock_ctx->segment, name, size)) {
+            goto fallback;
+        }
+        memset(lock_ctx->segment->seg_base_addr, 0, size);
+        if (0 != setuid) {
+            if (0 > chown(name, (uid_t) uid, (gid_t) -1) ||
+                0 > chmod(name, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP)) {
+                goto fallback;
+            }
+        }
+        if (0 != pthread_rwlockattr_init(&attr)) {
+            goto fallback;
+        }
+        rc = pthread_rwlockattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+#ifdef HAVE_PTHREAD_SETKIND
+        if (0 == rc) {
+            rc = pthread_rwlockattr_setkind_np(&attr,
+                                PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+        }
+#endif
+        if (0 == rc) {
+            rc = pthread_rwlock_init((pthread_rwlock_t *)lock_ctx->segment->seg_base_addr,
+                                     &attr);
+        }
+        pthread_rwlockattr_destroy(&attr);
+        if (0 != rc) {
+            goto fallback;
+        }
+    } else {
+        lock_ctx->segment->seg_size = size;
+        snprintf(lock_ctx->segment->seg_name, PMIX_PATH_MAX, "%s", name);
+        if (PMIX_SUCCESS != pmix_pshmem.segment_attach(lock_ctx->segment,
+                                                       PMIX_PSHMEM_RW)) {
+            goto fallback;
+        }
+    }
+    lock_ctx->rwlock = (pthread_rwlock_t *)lock_ctx->segment->seg_base_addr;
+    PMIX_OUTPUT_VERBOSE((10, pmix_gds_base_framework.framework_output,
+        "%s:%d:%s _rwlock_name: %s", __FILE__, __LINE__, __func__, name));
+    free(name);
+    return;
+
+  fallback:
+    /* the lock file alone is always enough - the server holds
+     * it for every write whether or not the rwlock exists */
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "%s: shared rwlock %s unavailable, using the lock file only",
+                        __func__, name);
+    _shm_lock_release(lock_ctx);
+    free(name);
+}
+#endif
+
 pmix_status_t pmix_gds_ds12_lock_init(pmix_common_dstor_lock_ctx_t *ctx, const char *base_path,
                                       const char *name, uint32_t local_size, uid_t uid, bool setuid)
 {
@@ -147,6 +269,9 @@ pmix_status_t pmix_gds_ds12_lock_init(pmix_common_dstor_lock_ctx_t *ctx, const c
             goto error;
         }
     }
+#ifdef HAVE_PTHREAD_SHARED
+    _shm_lock_init(lock_ctx, base_path, uid, setuid);
+#endif
 
     return rc;
 
@@ -179,6 +304,9 @@ void pmix_ds12_lock_finalize(pmix_common_dstor_lock_ctx_t *lock_ctx)
     }
 
     close(fcntl_lock->lockfd);
+#ifdef HAVE_PTHREAD_SHARED
+    _shm_lock_release(fcntl_lock);
+#endif
 
     if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer)) {
         unlink(fcntl_lock->lockfile);
@@ -196,6 +324,15 @@ pmix_status_t pmix_ds12_lock_rd_get(pmix_common_dstor_lock_ctx_t lock_ctx)
          PMIX_ERROR_LOG(rc);
          return rc;
      }
+#ifdef HAVE_PTHREAD_SHARED
+     if (NULL != fcntl_lock->rwlock) {
+         if (0 != pthread_rwlock_rdlock(fcntl_lock->rwlock)) {
+             rc = PMIX_ERR_RESOURCE_BUSY;
+             PMIX_ERROR_LOG(rc);
+         }
+         return rc;
+     }
+#endif
      rc = _ESH_12_FCNTL_LOCK(fcntl_lock->lockfd, F_RDLCK);
 
      return rc;
@@ -211,13 +348,28 @@ pmix_status_t pmix_ds12_lock_wr_get(pmix_common_dstor_lock_ctx_t lock_ctx)
          PMIX_ERROR_LOG(rc);
          return rc;
      }
+#ifdef HAVE_PTHREAD_SHARED
+     if (NULL != fcntl_lock->rwlock) {
+         if (0 != pthread_rwlock_wrlock(fcntl_lock->rwlock)) {
+             rc = PMIX_ERR_RESOURCE_BUSY;
+             PMIX_ERROR_LOG(rc);
+             return rc;
+         }
+     }
+#endif
+     /* always taken so that readers using the lock file are kept out */
      rc = _ESH_12_FCNTL_LOCK(fcntl_lock->lockfd, F_WRLCK);
+#ifdef HAVE_PTHREAD_SHARED
+     if (PMIX_SUCCESS != rc && NULL != fcntl_lock->rwlock) {
+         pthread_rwlock_unlock(fcntl_lock->rwlock);
+     }
+#endif
 
      return rc;
 
 }
 
-pmix_status_t pmix_ds12_lock_rw_rel(pmix_common_dstor_lock_ctx_t lock_ctx)
+pmix_status_t pmix_ds12_lock_rd_rel(pmix_common_dstor_lock_ctx_t lock_ctx)
 {    ds12_lock_fcntl_ctx_t *fcntl_lock = (ds12_lock_fcntl_ctx_t*)lock_ctx;
      pmix_status_t rc;
 
@@ -226,8 +378,40 @@ pmix_status_t pmix_ds12_lock_rw_rel(pmix_common_dstor_lock_ctx_t lock_ctx)
          PMIX_ERROR_LOG(rc);
          return rc;
      }
+#ifdef HAVE_PTHREAD_SHARED
+     if (NULL != fcntl_lock->rwlock) {
+         rc = PMIX_SUCCESS;
+         if (0 != pthread_rwlock_unlock(fcntl_lock->rwlock)) {
+             rc = PMIX_ERROR;
+             PMIX_ERROR_LOG(rc);
+         }
+         return rc;
+     }
+#endif
      rc = _ESH_12_FCNTL_LOCK(fcntl_lock->lockfd, F_UNLCK);
 
      return rc;
 
 }
+
+pmix_status_t pmix_ds12_lock_wr_rel(pmix_common_dstor_lock_ctx_t lock_ctx)
+{    ds12_lock_fcntl_ctx_t *fcntl_lock = (ds12_lock_fcntl_ctx_t*)lock_ctx;
+     pmix_status_t rc;
+
+     if (NULL == fcntl_lock) {
+         rc = PMIX_ERR_NOT_FOUND;
+         PMIX_ERROR_LOG(rc);
+         return rc;
+     }
+     rc = _ESH_12_FCNTL_LOCK(fcntl_lock->lockfd, F_UNLCK);
+#ifdef HAVE_PTHREAD_SHARED
+     if (NULL != fcntl_lock->rwlock &&
+         0 != pthread_rwlock_unlock(fcntl_lock->rwlock)) {
+         rc = PMIX_ERROR;
+         PMIX_ERROR_LOG(rc);
+     }
+#endif
+
+     return rc;
+
+}
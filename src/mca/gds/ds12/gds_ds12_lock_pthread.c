@@ -113,13 +113,9 @@ pmix_status_t pmix_gds_ds12_lock_init(pmix_common_dstor_lock_ctx_t *ctx, const c
         }
         memset(lock_ctx->segment->seg_base_addr, 0, size);
         if (0 != setuid) {
-            if (0 > chown(lock_ctx->lockfile, (uid_t) uid, (gid_t) -1)){
-                rc = PMIX_ERROR;
-                PMIX_ERROR_LOG(rc);
-                goto error;
-            }
-            /* set the mode as required */
-            if (0 > chmod(lock_ctx->lockfile, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP )) {
+            /* set the owner and mode as required */
+            if (PMIX_SUCCESS != pmix_pshmem.segment_chown(lock_ctx->segment, (uid_t) uid,
+                                                          S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP)) {
                 rc = PMIX_ERROR;
                 PMIX_ERROR_LOG(rc);
                 goto error;
@@ -258,7 +254,7 @@ pmix_status_t pmix_ds12_lock_wr_get(pmix_common_dstor_lock_ctx_t lock_ctx)
     return rc;
 }
 
-pmix_status_t pmix_ds12_lock_rw_rel(pmix_common_dstor_lock_ctx_t lock_ctx)
+static pmix_status_t _lock_rel(pmix_common_dstor_lock_ctx_t lock_ctx)
 {
     ds12_lock_pthread_ctx_t *pthread_lock = (ds12_lock_pthread_ctx_t*)lock_ctx;
     pmix_status_t rc;
@@ -272,3 +268,13 @@ pmix_status_t pmix_ds12_lock_rw_rel(pmix_common_dstor_lock_ctx_t lock_ctx)
 
     return rc;
 }
+
+pmix_status_t pmix_ds12_lock_rd_rel(pmix_common_dstor_lock_ctx_t lock_ctx)
+{
+    return _lock_rel(lock_ctx);
+}
+
+pmix_status_t pmix_ds12_lock_wr_rel(pmix_common_dstor_lock_ctx_t lock_ctx)
+{
+    return _lock_rel(lock_ctx);
+}
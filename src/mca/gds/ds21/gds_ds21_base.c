@@ -157,6 +157,18 @@ static pmix_status_t ds21_del_nspace(const char* nspace)
     return pmix_common_dstor_del_nspace(ds21_ctx, nspace);
 }
 
+static pmix_status_t ds21_store_buf(const pmix_proc_t *proc,
+                                   pmix_scope_t scope,
+                                   pmix_buffer_t *buf)
+{
+    return pmix_common_dstor_store_buf(ds21_ctx, proc, scope, buf);
+}
+
+static void ds21_mem_usage(pmix_list_t *usage)
+{
+    pmix_common_dstor_mem_usage(ds21_ctx, usage);
+}
+
 pmix_gds_base_module_t pmix_ds21_module = {
     .name = "ds21",
     .is_tsafe = true,
@@ -172,5 +184,7 @@ pmix_gds_base_module_t pmix_ds21_module = {
     .setup_fork = ds21_setup_fork,
     .add_nspace = ds21_add_nspace,
     .del_nspace = ds21_del_nspace,
+    .mem_usage = ds21_mem_usage,
+    .store_buf = ds21_store_buf
 };
 
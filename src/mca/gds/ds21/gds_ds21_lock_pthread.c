@@ -41,6 +41,7 @@ typedef struct {
     char *lockfile;
     pmix_dstore_seg_desc_t *seg_desc;
     pthread_mutex_t *mutex;
+    pmix_atomic_int32_t *wr_pending;
     uint32_t num_locks;
     uint32_t lock_idx;
 } lock_item_t;
@@ -58,7 +59,15 @@ typedef pmix_list_t ds21_lock_pthread_ctx_t;
  * 3. Align size               sizeof(size_t)
  * 4. Offset of mutexes        sizeof(size_t)
  * 5. Array of in use indexes: sizeof(int32_t)*local_size
- * 6. Double array of locks:   sizeof(pthread_mutex_t)*local_size*2
+ * 6. Format version:          sizeof(uint32_t), the last word before the locks
+ * 7. Double array of locks:   sizeof(pthread_mutex_t)*local_size*2
+ * 8. Writer pending counter:  sizeof(int32_t)
+ *
+ * The version and the writer pending counter sit in space the
+ * earlier format left unused, so the layout of the other fields is
+ * unchanged. The segment is zeroed when it is created, so a segment
+ * from a server that predates them has version 0 - clients that
+ * attach to one simply always take the signalling lock
  */
 typedef struct {
    size_t   seg_size;
@@ -76,11 +85,24 @@ typedef struct {
 #define _GET_MUTEX_PTR(seg_hdr, idx) \
     ((pthread_mutex_t*)((char*)seg_hdr + seg_hdr->mutex_offs + seg_hdr->align_size * (idx)))
 
+#define _GET_VERSION_PTR(seg_hdr) \
+    ((uint32_t*)((char*)seg_hdr + seg_hdr->mutex_offs - sizeof(uint32_t)))
+
+/* the format that has the writer pending counter */
+#define _LOCK_SEG_VERSION  1
+
+#define _GET_WR_PENDING_OFFS(seg_hdr) \
+    (seg_hdr->mutex_offs + seg_hdr->align_size * 2 * seg_hdr->num_locks)
+
+#define _GET_WR_PENDING_PTR(seg_hdr) \
+    ((pmix_atomic_int32_t*)((char*)seg_hdr + _GET_WR_PENDING_OFFS(seg_hdr)))
+
 
 static void ncon(lock_item_t *p) {
     p->lockfile = NULL;
     p->lock_idx = 0;
     p->mutex = NULL;
+    p->wr_pending = NULL;
     p->num_locks = 0;
     p->seg_desc = NULL;
 }
@@ -162,11 +184,13 @@ pmix_status_t pmix_gds_ds21_lock_init(pmix_common_dstor_lock_ctx_t *ctx, const c
         }
 
         seg_hdr_size = ((sizeof(segment_hdr_t)
-                        + sizeof(int32_t) * local_size)
+                        + sizeof(int32_t) * local_size
+                        + sizeof(uint32_t))               /* format version */
                         / seg_align_size + 1) * seg_align_size;
 
         size = ((seg_hdr_size
-                + 2 * local_size * seg_align_size) /* array of mutexes */
+                + 2 * local_size * seg_align_size /* array of mutexes */
+                + sizeof(int32_t))                /* writer pending counter */
                 / page_size + 1) * page_size;
 
         lock_item->seg_desc = pmix_common_dstor_create_new_lock_seg(base_path,
@@ -194,10 +218,13 @@ pmix_status_t pmix_gds_ds21_lock_init(pmix_common_dstor_lock_ctx_t *ctx, const c
         seg_hdr->seg_size = size;
         seg_hdr->align_size = seg_align_size;
         seg_hdr->mutex_offs = seg_hdr_size;
+        *_GET_VERSION_PTR(seg_hdr) = _LOCK_SEG_VERSION;
 
         lock_item->lockfile = strdup(lock_item->seg_desc->seg_info.seg_name);
         lock_item->num_locks = local_size;
         lock_item->mutex = _GET_MUTEX_ARR_PTR(seg_hdr);
+        lock_item->wr_pending = _GET_WR_PENDING_PTR(seg_hdr);
+        *lock_item->wr_pending = 0;
 
         for(i = 0; i < local_size * 2; i++) {
             pthread_mutex_t *mutex = _GET_MUTEX_PTR(seg_hdr, i);
@@ -239,6 +266,9 @@ pmix_status_t pmix_gds_ds21_lock_init(pmix_common_dstor_lock_ctx_t *ctx, const c
         lock_item->num_locks = seg_hdr->num_locks;
         lock_idx_ptr = _GET_IDX_ARR_PTR(seg_hdr);
         lock_item->mutex = _GET_MUTEX_ARR_PTR(seg_hdr);
+        if (_LOCK_SEG_VERSION <= *_GET_VERSION_PTR(seg_hdr)) {
+            lock_item->wr_pending = _GET_WR_PENDING_PTR(seg_hdr);
+        }
 
         for (i = 0; i < lock_item->num_locks; i++) {
             int32_t expected = 0;
@@ -309,6 +339,10 @@ pmix_status_t pmix_ds21_lock_wr_get(pmix_common_dstor_lock_ctx_t lock_ctx)
         num_locks = lock_item->num_locks;
         seg_hdr = (segment_hdr_t *)lock_item->seg_desc->seg_info.seg_base_addr;
 
+        /* announce ourselves so that readers stop bypassing
+         * the "signalling" locks */
+        (void)pmix_atomic_add_fetch_32(lock_item->wr_pending, 1);
+
          /* Lock the "signalling" lock first to let clients know that
          * server is going to get a write lock.
          * Clients do not hold this lock for a long time,
@@ -366,6 +400,7 @@ pmix_status_t pmix_ds21_lock_wr_rel(pmix_common_dstor_lock_ctx_t lock_ctx)
                 return PMIX_ERROR;
             }
         }
+        (void)pmix_atomic_sub_fetch_32(lock_item->wr_pending, 1);
     }
 
     return PMIX_SUCCESS;
@@ -389,6 +424,17 @@ pmix_status_t pmix_ds21_lock_rd_get(pmix_common_dstor_lock_ctx_t lock_ctx)
     idx = lock_item->lock_idx;
     seg_hdr = (segment_hdr_t *)lock_item->seg_desc->seg_info.seg_base_addr;
 
+    /* If no writer is waiting, then nobody can hold the
+     * "signalling" lock and we can go straight for the main
+     * one - the main lock alone still excludes the writer
+     * should it arrive in the meantime */
+    if (NULL != lock_item->wr_pending && 0 == *lock_item->wr_pending) {
+        if (0 != pthread_mutex_lock(_GET_MUTEX_PTR(seg_hdr, 2*idx + 1))) {
+            return PMIX_ERROR;
+        }
+        return PMIX_SUCCESS;
+    }
+
     /* This mutex is only used to acquire the next one,
      * this is a barrier that server is using to let clients
      * know that it is going to grab the write lock
@@ -22,6 +22,7 @@
 #include "src/mca/base/pmix_mca_base_var.h"
 #include "src/mca/base/pmix_mca_base_framework.h"
 #include "src/mca/bfrops/bfrops_types.h"
+#include "src/util/timings.h"
 
 
 /* The client dictates the GDS module that will be used to interact
@@ -221,7 +222,42 @@ typedef pmix_status_t (*pmix_gds_base_module_store_fn_t)(const pmix_proc_t *proc
         pmix_output_verbose(1, pmix_gds_base_output,        \
                             "[%s:%d] GDS STORE KV WITH %s", \
                             __FILE__, __LINE__, _g->name);  \
+        PMIX_TRACE_START(_ts);                              \
         (s) = _g->store(pc, sc, k);                         \
+        PMIX_TRACE_SPAN("gds.store", _ts);                  \
+    } while(0)
+
+
+/**
+* Store a buffer of key-value pairs for a given proc in one operation.
+* Modules that lock shared storage for each store can then do so once
+* for the whole set. Optional - modules that leave this NULL must be
+* given the kvals one at a time.
+*
+* @param proc   the proc that the data describes
+*
+* @param scope  scope of the data
+*
+* @param buf    buffer of PMIX_KVAL packed with our own BFROPS module
+*
+* @return PMIX_SUCCESS on success.
+*/
+typedef pmix_status_t (*pmix_gds_base_module_store_buf_fn_t)(const pmix_proc_t *proc,
+                                                             pmix_scope_t scope,
+                                                             pmix_buffer_t *buf);
+
+/* define a convenience macro for storing a buffer of key-val pairs based on peer */
+#define PMIX_GDS_STORE_BUF(s, p, pc, sc, b)                 \
+    do {                                                    \
+        pmix_gds_base_module_t *_g = (p)->nptr->compat.gds; \
+        pmix_output_verbose(1, pmix_gds_base_output,        \
+                            "[%s:%d] GDS STORE BUF WITH %s", \
+                            __FILE__, __LINE__, _g->name);  \
+        if (NULL == _g->store_buf) {                        \
+            (s) = PMIX_ERR_NOT_SUPPORTED;                   \
+        } else {                                            \
+            (s) = _g->store_buf(pc, sc, b);                 \
+        }                                                   \
     } while(0)
 
 
@@ -322,9 +358,11 @@ typedef pmix_status_t (*pmix_gds_base_module_fetch_fn_t)(const pmix_proc_t *proc
         pmix_output_verbose(1, pmix_gds_base_output,        \
                             "[%s:%d] GDS FETCH KV WITH %s", \
                             __FILE__, __LINE__, _g->name);  \
+        PMIX_TRACE_START(_ts);                              \
         (s) = _g->fetch((c)->proc, (c)->scope, (c)->copy,   \
                         (c)->key, (c)->info, (c)->ninfo,    \
                         &(c)->kvs);                         \
+        PMIX_TRACE_SPAN("gds.fetch", _ts);                  \
     } while(0)
 
 
@@ -349,8 +387,10 @@ typedef pmix_status_t (*pmix_gds_base_module_add_nspace_fn_t)(const char *nspace
                                                               pmix_info_t info[],
                                                               size_t ninfo);
 
-/* define a convenience macro for add_nspace based on peer */
-#define PMIX_GDS_ADD_NSPACE(s, n, i, ni)                    \
+/* define a convenience macro for add_nspace based on peer - only
+ * the modules named in the comma-delimited list m are given the
+ * nspace, or all of them if m is NULL */
+#define PMIX_GDS_ADD_NSPACE(s, n, m, i, ni)                 \
     do {                                                    \
         pmix_gds_base_active_module_t *_g;                  \
         pmix_status_t _s = PMIX_SUCCESS;                    \
@@ -360,7 +400,10 @@ typedef pmix_status_t (*pmix_gds_base_module_add_nspace_fn_t)(const char *nspace
                             __FILE__, __LINE__, (n));       \
         PMIX_LIST_FOREACH(_g, &pmix_gds_globals.actives,    \
                           pmix_gds_base_active_module_t) {  \
-            if (NULL != _g->module->add_nspace) {           \
+            _s = PMIX_SUCCESS;                              \
+            if (NULL != _g->module->add_nspace &&           \
+                pmix_gds_base_module_listed((m),            \
+                                            _g->module->name)) { \
                 _s = _g->module->add_nspace(n, i, ni);      \
             }                                               \
             if (PMIX_SUCCESS != _s) {                       \
@@ -413,6 +456,14 @@ typedef pmix_status_t (*pmix_gds_base_module_del_nspace_fn_t)(const char* nspace
         }                                                   \
 } while(0)
 
+/**
+* Report the memory the module holds on behalf of each nspace by
+* appending one pmix_kval_t per nspace to the usage list, keyed
+* "gds.<module>:<nspace>" and holding a PMIX_SIZE estimate in bytes.
+* Optional - modules that cannot tell may leave this NULL.
+*/
+typedef void (*pmix_gds_base_module_mem_usage_fn_t)(pmix_list_t *usage);
+
 /**
 * structure for gds modules
 */
@@ -433,6 +484,8 @@ typedef struct {
     pmix_gds_base_module_del_nspace_fn_t            del_nspace;
     pmix_gds_base_module_assemb_kvs_req_fn_t        assemb_kvs_req;
     pmix_gds_base_module_accept_kvs_resp_fn_t       accept_kvs_resp;
+    pmix_gds_base_module_mem_usage_fn_t             mem_usage;
+    pmix_gds_base_module_store_buf_fn_t             store_buf;
 
 } pmix_gds_base_module_t;
 
@@ -29,6 +29,7 @@
 #include <fcntl.h>
 #endif
 #include <time.h>
+#include <pthread.h>
 
 #include <pmix_common.h>
 
@@ -95,10 +96,11 @@ static pmix_status_t assemb_kvs_req(const pmix_proc_t *proc,
                               void *cbdata);
 
 static pmix_status_t accept_kvs_resp(pmix_buffer_t *buf);
+static void mem_usage(pmix_list_t *usage);
 
 pmix_gds_base_module_t pmix_hash_module = {
     .name = "hash",
-    .is_tsafe = false,
+    .is_tsafe = true,
     .init = hash_init,
     .finalize = hash_finalize,
     .assign_module = hash_assign_module,
@@ -112,7 +114,8 @@ pmix_gds_base_module_t pmix_hash_module = {
     .add_nspace = nspace_add,
     .del_nspace = nspace_del,
     .assemb_kvs_req = assemb_kvs_req,
-    .accept_kvs_resp = accept_kvs_resp
+    .accept_kvs_resp = accept_kvs_resp,
+    .mem_usage = mem_usage
 };
 
 typedef struct {
@@ -123,8 +126,18 @@ typedef struct {
     pmix_hash_table_t remote;
     pmix_hash_table_t local;
     bool gdata_added;
+    char **hostnames;       // nodes hosting procs of this nspace
+    size_t nhosts;          // number of entries in hostnames
+    size_t hostsz;          // allocated size of hostnames
+    pmix_hash_table_t hostnameidx;  // hostname -> index into hostnames
+    uint32_t *hostidx;      // per-rank index into hostnames
+    size_t nhostidx;        // number of ranks covered by hostidx
+    pthread_rwlock_t lock;  // held for write while the data changes
 } pmix_hash_trkr_t;
 
+/* marks a rank whose host isn't known */
+#define PMIX_HASH_NO_HOST   UINT32_MAX
+
 static void htcon(pmix_hash_trkr_t *p)
 {
     p->ns = NULL;
@@ -136,6 +149,14 @@ static void htcon(pmix_hash_trkr_t *p)
     PMIX_CONSTRUCT(&p->local, pmix_hash_table_t);
     pmix_hash_table_init(&p->local, 256);
     p->gdata_added = false;
+    p->hostnames = NULL;
+    p->nhosts = 0;
+    p->hostsz = 0;
+    PMIX_CONSTRUCT(&p->hostnameidx, pmix_hash_table_t);
+    pmix_hash_table_init(&p->hostnameidx, 64);
+    p->hostidx = NULL;
+    p->nhostidx = 0;
+    pthread_rwlock_init(&p->lock, NULL);
 }
 static void htdes(pmix_hash_trkr_t *p)
 {
@@ -151,6 +172,14 @@ static void htdes(pmix_hash_trkr_t *p)
     PMIX_DESTRUCT(&p->remote);
     pmix_hash_remove_data(&p->local, PMIX_RANK_WILDCARD, NULL);
     PMIX_DESTRUCT(&p->local);
+    if (NULL != p->hostnames) {
+        pmix_argv_free(p->hostnames);
+    }
+    PMIX_DESTRUCT(&p->hostnameidx);
+    if (NULL != p->hostidx) {
+        free(p->hostidx);
+    }
+    pthread_rwlock_destroy(&p->lock);
 }
 static PMIX_CLASS_INSTANCE(pmix_hash_trkr_t,
                            pmix_list_item_t,
@@ -158,12 +187,64 @@ static PMIX_CLASS_INSTANCE(pmix_hash_trkr_t,
 
 static pmix_list_t myhashes;
 
+/* fetch is called directly from whatever thread wants the data,
+ * while everything that changes it runs in the progress thread.
+ * Adding or removing a tracker takes this lock for write, and
+ * changing the data of a tracker takes its own lock for write -
+ * a fetch holds both for read, so it only ever waits on an
+ * update of the nspace it is reading */
+static pthread_rwlock_t myhashes_lock;
+
+/* only called from the progress thread, which is the only one
+ * that modifies the list - so no need to lock it for the search */
+static pmix_hash_trkr_t* get_tracker(const char *nspace, bool create)
+{
+    pmix_hash_trkr_t *t;
+
+    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
+        if (NULL != t->ns && 0 == strcmp(nspace, t->ns)) {
+            return t;
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+    t = PMIX_NEW(pmix_hash_trkr_t);
+    if (NULL == t) {
+        return NULL;
+    }
+    t->ns = strdup(nspace);
+    pthread_rwlock_wrlock(&myhashes_lock);
+    pmix_list_append(&myhashes, &t->super);
+    pthread_rwlock_unlock(&myhashes_lock);
+    return t;
+}
+
+/* find the tracker for a fetch and hold it for read - the
+ * caller must unlock it when done */
+static pmix_hash_trkr_t* read_tracker(const char *nspace)
+{
+    pmix_hash_trkr_t *t, *trk = NULL;
+
+    pthread_rwlock_rdlock(&myhashes_lock);
+    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
+        if (NULL != t->ns && 0 == strcmp(nspace, t->ns)) {
+            trk = t;
+            pthread_rwlock_rdlock(&trk->lock);
+            break;
+        }
+    }
+    pthread_rwlock_unlock(&myhashes_lock);
+    return trk;
+}
+
 static pmix_status_t hash_init(pmix_info_t info[], size_t ninfo)
 {
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                         "gds: hash init");
 
     PMIX_CONSTRUCT(&myhashes, pmix_list_t);
+    pthread_rwlock_init(&myhashes_lock, NULL);
     return PMIX_SUCCESS;
 }
 
@@ -173,6 +254,7 @@ static void hash_finalize(void)
                         "gds: hash finalize");
 
     PMIX_LIST_DESTRUCT(&myhashes);
+    pthread_rwlock_destroy(&myhashes_lock);
 }
 
 static pmix_status_t hash_assign_module(pmix_info_t *info, size_t ninfo,
@@ -201,17 +283,140 @@ static pmix_status_t hash_assign_module(pmix_info_t *info, size_t ninfo,
     return PMIX_SUCCESS;
 }
 
-static pmix_status_t store_map(pmix_hash_table_t *ht,
+/* the hostname of every proc in the job is known from the maps.
+ * Rather than storing a kval with its own copy of the name for each
+ * rank, keep a per-rank index into a table holding each node name
+ * once - the PMIX_HOSTNAME kval is synthesized when fetched. The
+ * index only covers ranks below maxranks (the size of the job), so
+ * a stray rank in the map can't make us allocate for it - any such
+ * rank gets its own kval instead */
+static pmix_status_t store_hosts(pmix_hash_trkr_t *trk, const char *node,
+                                 const char *ppn, size_t maxranks)
+{
+    uint32_t idx, *tmp;
+    size_t m, n, size;
+    char **procs, **names;
+    pmix_rank_t rank;
+    pmix_kval_t *kv;
+    pmix_status_t rc;
+    void *ptr;
+
+    /* this is done once per node, not per rank */
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&trk->hostnameidx, node,
+                                                      strlen(node), &ptr)) {
+        idx = (uint32_t)(uintptr_t)ptr;
+    } else {
+        /* keep the table NULL-terminated so it can be freed as an argv */
+        if (trk->nhosts + 1 >= trk->hostsz) {
+            size = (0 == trk->hostsz) ? 16 : 2 * trk->hostsz;
+            names = (char**)realloc(trk->hostnames, size * sizeof(char*));
+            if (NULL == names) {
+                return PMIX_ERR_NOMEM;
+            }
+            trk->hostnames = names;
+            trk->hostsz = size;
+        }
+        idx = trk->nhosts;
+        trk->hostnames[trk->nhosts++] = strdup(node);
+        trk->hostnames[trk->nhosts] = NULL;
+        pmix_hash_table_set_value_ptr(&trk->hostnameidx, trk->hostnames[idx],
+                                      strlen(node), (void*)(uintptr_t)idx);
+    }
+
+    procs = pmix_argv_split(ppn, ',');
+    if (NULL == procs) {
+        return PMIX_SUCCESS;
+    }
+    for (m=0; NULL != procs[m]; m++) {
+        rank = strtoul(procs[m], NULL, 10);
+        if (rank >= maxranks) {
+            kv = PMIX_NEW(pmix_kval_t);
+            if (NULL == kv) {
+                pmix_argv_free(procs);
+                return PMIX_ERR_NOMEM;
+            }
+            kv->key = strdup(PMIX_HOSTNAME);
+            PMIX_VALUE_CREATE(kv->value, 1);
+            if (NULL == kv->value) {
+                PMIX_RELEASE(kv);
+                pmix_argv_free(procs);
+                return PMIX_ERR_NOMEM;
+            }
+            kv->value->type = PMIX_STRING;
+            kv->value->data.string = strdup(node);
+            rc = pmix_hash_store(&trk->internal, rank, kv);
+            PMIX_RELEASE(kv);  // maintain acctg
+            if (PMIX_SUCCESS != rc) {
+                pmix_argv_free(procs);
+                return rc;
+            }
+            continue;
+        }
+        if (rank >= trk->nhostidx) {
+            size = 2 * trk->nhostidx;
+            if (size <= rank) {
+                size = rank + 1;
+            }
+            if (size > maxranks) {
+                size = maxranks;
+            }
+            tmp = (uint32_t*)realloc(trk->hostidx, size * sizeof(uint32_t));
+            if (NULL == tmp) {
+                pmix_argv_free(procs);
+                return PMIX_ERR_NOMEM;
+            }
+            for (n=trk->nhostidx; n < size; n++) {
+                tmp[n] = PMIX_HASH_NO_HOST;
+            }
+            trk->hostidx = tmp;
+            trk->nhostidx = size;
+        }
+        trk->hostidx[rank] = idx;
+    }
+    pmix_argv_free(procs);
+    return PMIX_SUCCESS;
+}
+
+static const char* lookup_host(pmix_hash_trkr_t *trk, pmix_rank_t rank)
+{
+    if (rank >= trk->nhostidx ||
+        PMIX_HASH_NO_HOST == trk->hostidx[rank]) {
+        return NULL;
+    }
+    return trk->hostnames[trk->hostidx[rank]];
+}
+
+static pmix_status_t add_host_kv(pmix_list_t *kvs, const char *host)
+{
+    pmix_kval_t *kv;
+
+    kv = PMIX_NEW(pmix_kval_t);
+    if (NULL == kv) {
+        return PMIX_ERR_NOMEM;
+    }
+    kv->key = strdup(PMIX_HOSTNAME);
+    PMIX_VALUE_CREATE(kv->value, 1);
+    if (NULL == kv->value) {
+        PMIX_RELEASE(kv);
+        return PMIX_ERR_NOMEM;
+    }
+    kv->value->type = PMIX_STRING;
+    kv->value->data.string = strdup(host);
+    pmix_list_append(kvs, &kv->super);
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t store_map(pmix_hash_trkr_t *trk,
                                char **nodes, char **ppn)
 {
+    pmix_hash_table_t *ht = &trk->internal;
     pmix_status_t rc;
     pmix_value_t *val;
-    size_t m, n;
+    size_t m, n, maxranks;
     pmix_info_t *iptr, *info;
-    pmix_rank_t rank;
     bool updated;
     pmix_kval_t *kp2;
-    char **procs;
+    char *p;
 
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
                         "[%s:%d] gds:hash:store_map",
@@ -223,6 +428,22 @@ static pmix_status_t store_map(pmix_hash_table_t *ht,
         return PMIX_ERR_BAD_PARAM;
     }
 
+    /* the ranks of the job run from zero to its size - if we
+     * haven't been given the size yet, the map itself tells us */
+    if (NULL != trk->nptr && 0 < trk->nptr->nprocs) {
+        maxranks = trk->nptr->nprocs;
+    } else {
+        maxranks = 0;
+        for (n=0; NULL != ppn[n]; n++) {
+            ++maxranks;
+            for (p=ppn[n]; '\0' != *p; p++) {
+                if (',' == *p) {
+                    ++maxranks;
+                }
+            }
+        }
+    }
+
     for (n=0; NULL != nodes[n]; n++) {
         /* check and see if we already have data for this node */
         val = NULL;
@@ -323,26 +544,11 @@ static pmix_status_t store_map(pmix_hash_table_t *ht,
             }
             PMIX_RELEASE(kp2);
         }
-        /* split the list of procs so we can store their
-         * individual location data */
-        procs = pmix_argv_split(ppn[n], ',');
-        for (m=0; NULL != procs[m]; m++) {
-            /* store the hostname for each proc */
-            kp2 = PMIX_NEW(pmix_kval_t);
-            kp2->key = strdup(PMIX_HOSTNAME);
-            kp2->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
-            kp2->value->type = PMIX_STRING;
-            kp2->value->data.string = strdup(nodes[n]);
-            rank = strtol(procs[m], NULL, 10);
-            if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, rank, kp2))) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_RELEASE(kp2);
-                pmix_argv_free(procs);
-                return rc;
-            }
-            PMIX_RELEASE(kp2);  // maintain acctg
+        /* record the location of each proc on this node */
+        if (PMIX_SUCCESS != (rc = store_hosts(trk, nodes[n], ppn[n], maxranks))) {
+            PMIX_ERROR_LOG(rc);
+            return rc;
         }
-        pmix_argv_free(procs);
     }
 
     /* store the comma-delimited list of nodes hosting
@@ -367,7 +573,7 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
                                   pmix_info_t info[], size_t ninfo)
 {
     pmix_namespace_t *nptr = (pmix_namespace_t*)ns;
-    pmix_hash_trkr_t *trk, *t;
+    pmix_hash_trkr_t *trk;
     pmix_hash_table_t *ht;
     pmix_kval_t *kp2, *kvptr;
     pmix_info_t *iptr;
@@ -382,24 +588,14 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
                         pmix_globals.myid.nspace, pmix_globals.myid.rank,
                         nptr->nspace);
 
-    /* find the hash table for this nspace */
-    trk = NULL;
-    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
-        if (0 == strcmp(nptr->nspace, t->ns)) {
-            trk = t;
-            break;
-        }
+    /* find the hash table for this nspace - create a
+     * tracker as we will likely need it */
+    if (NULL == (trk = get_tracker(nptr->nspace, true))) {
+        return PMIX_ERR_NOMEM;
     }
-    if (NULL == trk) {
-        /* create a tracker as we will likely need it */
-        trk = PMIX_NEW(pmix_hash_trkr_t);
-        if (NULL == trk) {
-            return PMIX_ERR_NOMEM;
-        }
+    if (NULL == trk->nptr) {
         PMIX_RETAIN(nptr);
         trk->nptr = nptr;
-        trk->ns = strdup(nptr->nspace);
-        pmix_list_append(&myhashes, &trk->super);
     }
 
     /* if there isn't any data, then be content with just
@@ -409,6 +605,7 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
     }
 
     /* cache the job info on the internal hash table for this nspace */
+    pthread_rwlock_wrlock(&trk->lock);
     ht = &trk->internal;
     for (n=0; n < ninfo; n++) {
         if (0 == strcmp(info[n].key, PMIX_NODE_MAP)) {
@@ -422,7 +619,7 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
             if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, PMIX_RANK_WILDCARD, kp2))) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_RELEASE(kp2);
-                return rc;
+                goto release;
             }
             PMIX_RELEASE(kp2);  // maintain acctg
 
@@ -434,7 +631,7 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
             /* if we have already found the proc map, then parse
              * and store the detailed map */
             if (NULL != procs) {
-                if (PMIX_SUCCESS != (rc = store_map(ht, nodes, procs))) {
+                if (PMIX_SUCCESS != (rc = store_map(trk, nodes, procs))) {
                     PMIX_ERROR_LOG(rc);
                     goto release;
                 }
@@ -448,7 +645,7 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
             /* if we have already recv'd the node map, then parse
              * and store the detailed map */
             if (NULL != nodes) {
-                if (PMIX_SUCCESS != (rc = store_map(ht, nodes, procs))) {
+                if (PMIX_SUCCESS != (rc = store_map(trk, nodes, procs))) {
                     PMIX_ERROR_LOG(rc);
                     goto release;
                 }
@@ -578,6 +775,7 @@ pmix_status_t hash_cache_job_info(struct pmix_namespace_t *ns,
     }
 
   release:
+    pthread_rwlock_unlock(&trk->lock);
     if (NULL != nodes) {
         pmix_argv_free(nodes);
     }
@@ -600,6 +798,9 @@ static pmix_status_t register_info(pmix_peer_t *peer,
     pmix_kval_t kv;
     pmix_buffer_t buf;
     pmix_rank_t rank;
+    pmix_value_t hval;
+    const char *host;
+    bool addhost;
 
     trk = NULL;
     PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
@@ -632,6 +833,8 @@ static pmix_status_t register_info(pmix_peer_t *peer,
     }
     info = (pmix_info_t*)val->data.darray->array;
     ninfo = val->data.darray->size;
+    /* size the reply for the whole job-level block up front */
+    pmix_bfrops_base_reserve(reply, pmix_bfrops_base_sizeof(info, ninfo, PMIX_INFO));
     for (n=0; n < ninfo; n++) {
         kv.key = info[n].key;
         kv.value = &info[n].value;
@@ -642,26 +845,44 @@ static pmix_status_t register_info(pmix_peer_t *peer,
     }
 
     for (rank=0; rank < ns->nprocs; rank++) {
+        /* the proc's hostname is held in the host index rather
+         * than as a kval, so it may be all we have for it */
+        host = lookup_host(trk, rank);
         val = NULL;
         rc = pmix_hash_fetch(ht, rank, NULL, &val);
-        if (PMIX_SUCCESS != rc) {
+        if (PMIX_ERR_PROC_ENTRY_NOT_FOUND == rc && NULL != host) {
+            rc = PMIX_SUCCESS;
+        } else if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             if (NULL != val) {
                 PMIX_VALUE_RELEASE(val);
             }
             return rc;
-        }
-        if (NULL == val) {
+        } else if (NULL == val) {
             return PMIX_ERR_NOT_FOUND;
         }
         PMIX_CONSTRUCT(&buf, pmix_buffer_t);
         PMIX_BFROPS_PACK(rc, peer, &buf, &rank, 1, PMIX_PROC_RANK);
 
-        info = (pmix_info_t*)val->data.darray->array;
-        ninfo = val->data.darray->size;
-        for (n=0; n < ninfo; n++) {
-            kv.key = info[n].key;
-            kv.value = &info[n].value;
+        addhost = (NULL != host);
+        if (NULL != val) {
+            info = (pmix_info_t*)val->data.darray->array;
+            ninfo = val->data.darray->size;
+            pmix_bfrops_base_reserve(&buf, pmix_bfrops_base_sizeof(info, ninfo, PMIX_INFO));
+            for (n=0; n < ninfo; n++) {
+                if (addhost && 0 == strcmp(info[n].key, PMIX_HOSTNAME)) {
+                    addhost = false;
+                }
+                kv.key = info[n].key;
+                kv.value = &info[n].value;
+                PMIX_BFROPS_PACK(rc, peer, &buf, &kv, 1, PMIX_KVAL);
+            }
+        }
+        if (addhost) {
+            hval.type = PMIX_STRING;
+            hval.data.string = (char*)host;
+            kv.key = PMIX_HOSTNAME;
+            kv.value = &hval;
             PMIX_BFROPS_PACK(rc, peer, &buf, &kv, 1, PMIX_KVAL);
         }
         kv.key = PMIX_PROC_BLOB;
@@ -736,11 +957,12 @@ static pmix_status_t hash_register_job_info(struct pmix_peer_t *pr,
         }
     }
     if (NULL == trk) {
-        trk = PMIX_NEW(pmix_hash_trkr_t);
-        trk->ns = strdup(ns->nspace);
+        trk = get_tracker(ns->nspace, true);
+        if (NULL == trk) {
+            return PMIX_ERR_NOMEM;
+        }
         PMIX_RETAIN(ns);
         trk->nptr = ns;
-        pmix_list_append(&myhashes, &trk->super);
     }
 
     /* the job info for the specified nspace has
@@ -769,58 +991,24 @@ static pmix_status_t hash_register_job_info(struct pmix_peer_t *pr,
     return rc;
 }
 
-static pmix_status_t hash_store_job_info(const char *nspace,
-                                         pmix_buffer_t *buf)
+static pmix_status_t _hash_store_job_info(pmix_hash_trkr_t *htptr,
+                                          pmix_buffer_t *buf)
 {
     pmix_status_t rc = PMIX_SUCCESS;
     pmix_kval_t *kptr, *kp2, kv;
     pmix_value_t *val;
     int32_t cnt;
     size_t nnodes, len, n;
-    uint32_t i, j;
-    char **procs = NULL;
+    uint32_t i;
     uint8_t *tmp;
     pmix_byte_object_t *bo;
     pmix_buffer_t buf2;
     int rank;
-    pmix_hash_trkr_t *htptr;
     pmix_hash_table_t *ht;
     char **nodelist = NULL;
     pmix_info_t *info, *iptr;
 
-    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                        "[%s:%u] pmix:gds:hash store job info for nspace %s",
-                        pmix_globals.myid.nspace, pmix_globals.myid.rank, nspace);
-
-    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer) &&
-        !PMIX_PROC_IS_LAUNCHER(pmix_globals.mypeer)) {
-        /* this function is NOT available on servers */
-        PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
-        return PMIX_ERR_NOT_SUPPORTED;
-    }
-
-    /* check buf data */
-    if ((NULL == buf) || (0 == buf->bytes_used)) {
-        rc = PMIX_ERR_BAD_PARAM;
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-
-    /* see if we already have a hash table for this nspace */
-    ht = NULL;
-    PMIX_LIST_FOREACH(htptr, &myhashes, pmix_hash_trkr_t) {
-        if (0 == strcmp(htptr->ns, nspace)) {
-            ht = &htptr->internal;
-            break;
-        }
-    }
-    if (NULL == ht) {
-        /* nope - create one */
-        htptr = PMIX_NEW(pmix_hash_trkr_t);
-        htptr->ns = strdup(nspace);
-        pmix_list_append(&myhashes, &htptr->super);
-        ht = &htptr->internal;
-    }
+    ht = &htptr->internal;
 
     cnt = 1;
     kptr = PMIX_NEW(pmix_kval_t);
@@ -982,30 +1170,16 @@ static pmix_status_t hash_store_job_info(const char *nspace,
                     }
                     PMIX_RELEASE(kp2);  // maintain acctg
                 }
-                /* split the list of procs so we can store their
-                 * individual location data */
-                procs = pmix_argv_split(kv.value->data.string, ',');
-                for (j=0; NULL != procs[j]; j++) {
-                    /* store the hostname for each proc - again, this is
-                     * data obtained via a job-level exchange, so store it
-                     * in the job-level data hash_table */
-                    kp2 = PMIX_NEW(pmix_kval_t);
-                    kp2->key = strdup(PMIX_HOSTNAME);
-                    kp2->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
-                    kp2->value->type = PMIX_STRING;
-                    kp2->value->data.string = strdup(kv.key);
-                    rank = strtol(procs[j], NULL, 10);
-                    if (PMIX_SUCCESS != (rc = pmix_hash_store(ht, rank, kp2))) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_RELEASE(kp2);
-                        PMIX_DESTRUCT(&kv);
-                        PMIX_DESTRUCT(&buf2);
-                        pmix_argv_free(procs);
-                        return rc;
-                    }
-                    PMIX_RELEASE(kp2);  // maintain acctg
+                /* record the location of each proc on this node - again,
+                 * this is data obtained via a job-level exchange, so it
+                 * is served as part of the job-level data */
+                if (PMIX_SUCCESS != (rc = store_hosts(htptr, kv.key, kv.value->data.string,
+                                                      (NULL == htptr->nptr) ? 0 : htptr->nptr->nprocs))) {
+                    PMIX_ERROR_LOG(rc);
+                    PMIX_DESTRUCT(&kv);
+                    PMIX_DESTRUCT(&buf2);
+                    return rc;
                 }
-                pmix_argv_free(procs);
                 PMIX_DESTRUCT(&kv);
             }
             if (NULL != nodelist) {
@@ -1070,38 +1244,48 @@ static pmix_status_t hash_store_job_info(const char *nspace,
     return rc;
 }
 
-static pmix_status_t hash_store(const pmix_proc_t *proc,
-                                pmix_scope_t scope,
-                                pmix_kval_t *kv)
+static pmix_status_t hash_store_job_info(const char *nspace,
+                                         pmix_buffer_t *buf)
 {
-    pmix_hash_trkr_t *trk, *t;
+    pmix_hash_trkr_t *htptr;
     pmix_status_t rc;
-    pmix_kval_t *kp;
 
     pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                        "[%s:%d] gds:hash:hash_store for proc [%s:%d] key %s type %s scope %s",
-                        pmix_globals.myid.nspace, pmix_globals.myid.rank,
-                        proc->nspace, proc->rank, kv->key,
-                        PMIx_Data_type_string(kv->value->type), PMIx_Scope_string(scope));
+                        "[%s:%u] pmix:gds:hash store job info for nspace %s",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank, nspace);
 
-    if (NULL == kv->key) {
-        return PMIX_ERR_BAD_PARAM;
+    if (PMIX_PROC_IS_SERVER(pmix_globals.mypeer) &&
+        !PMIX_PROC_IS_LAUNCHER(pmix_globals.mypeer)) {
+        /* this function is NOT available on servers */
+        PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
+        return PMIX_ERR_NOT_SUPPORTED;
     }
 
-    /* find the hash table for this nspace */
-    trk = NULL;
-    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
-        if (0 == strcmp(proc->nspace, t->ns)) {
-            trk = t;
-            break;
-        }
+    /* check buf data */
+    if ((NULL == buf) || (0 == buf->bytes_used)) {
+        rc = PMIX_ERR_BAD_PARAM;
+        PMIX_ERROR_LOG(rc);
+        return rc;
     }
-    if (NULL == trk) {
-        /* create one */
-        trk = PMIX_NEW(pmix_hash_trkr_t);
-        trk->ns = strdup(proc->nspace);
-        pmix_list_append(&myhashes, &trk->super);
+
+    /* see if we already have a hash table for this nspace - if
+     * not, create one */
+    if (NULL == (htptr = get_tracker(nspace, true))) {
+        return PMIX_ERR_NOMEM;
     }
+    pthread_rwlock_wrlock(&htptr->lock);
+    rc = _hash_store_job_info(htptr, buf);
+    pthread_rwlock_unlock(&htptr->lock);
+    return rc;
+}
+
+static pmix_status_t _hash_store(pmix_hash_trkr_t *trk,
+                                 const pmix_proc_t *proc,
+                                 pmix_scope_t scope,
+                                 pmix_kval_t *kv)
+{
+    pmix_status_t rc;
+    pmix_kval_t *kp;
 
     /* see if the proc is me */
     if (proc->rank == pmix_globals.myid.rank &&
@@ -1185,6 +1369,33 @@ static pmix_status_t hash_store(const pmix_proc_t *proc,
     return PMIX_SUCCESS;
 }
 
+static pmix_status_t hash_store(const pmix_proc_t *proc,
+                                pmix_scope_t scope,
+                                pmix_kval_t *kv)
+{
+    pmix_hash_trkr_t *trk;
+    pmix_status_t rc;
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "[%s:%d] gds:hash:hash_store for proc [%s:%d] key %s type %s scope %s",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                        proc->nspace, proc->rank, kv->key,
+                        PMIx_Data_type_string(kv->value->type), PMIx_Scope_string(scope));
+
+    if (NULL == kv->key) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    /* find the hash table for this nspace - create one if needed */
+    if (NULL == (trk = get_tracker(proc->nspace, true))) {
+        return PMIX_ERR_NOMEM;
+    }
+    pthread_rwlock_wrlock(&trk->lock);
+    rc = _hash_store(trk, proc, scope, kv);
+    pthread_rwlock_unlock(&trk->lock);
+    return rc;
+}
+
 /* this function is only called by the PMIx server when its
  * host has received data from some other peer. It therefore
  * always contains data solely from remote procs, and we
@@ -1201,7 +1412,7 @@ static pmix_status_t _hash_store_modex(void * cbdata,
                                        pmix_byte_object_t *bo)
 {
     pmix_namespace_t *ns = (pmix_namespace_t*)nspace;
-    pmix_hash_trkr_t *trk, *t;
+    pmix_hash_trkr_t *trk;
     pmix_status_t rc = PMIX_SUCCESS;
     int32_t cnt;
     pmix_buffer_t pbkt;
@@ -1213,19 +1424,9 @@ static pmix_status_t _hash_store_modex(void * cbdata,
                         pmix_globals.myid.nspace, pmix_globals.myid.rank,
                         ns->nspace);
 
-    /* find the hash table for this nspace */
-    trk = NULL;
-    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
-        if (0 == strcmp(ns->nspace, t->ns)) {
-            trk = t;
-            break;
-        }
-    }
-    if (NULL == trk) {
-        /* create one */
-        trk = PMIX_NEW(pmix_hash_trkr_t);
-        trk->ns = strdup(ns->nspace);
-        pmix_list_append(&myhashes, &trk->super);
+    /* find the hash table for this nspace - create one if needed */
+    if (NULL == (trk = get_tracker(ns->nspace, true))) {
+        return PMIX_ERR_NOMEM;
     }
 
     /* this is data returned via the PMIx_Fence call when
@@ -1239,6 +1440,7 @@ static pmix_status_t _hash_store_modex(void * cbdata,
     /* the next step unfortunately NULLs the byte object's
      * entries, so we need to ensure we restore them! */
     PMIX_LOAD_BUFFER(pmix_globals.mypeer, &pbkt, bo->bytes, bo->size);
+    pthread_rwlock_wrlock(&trk->lock);
     /* unload the proc that provided this data */
     cnt = 1;
     PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &pbkt, &proc, &cnt, PMIX_PROC);
@@ -1248,6 +1450,7 @@ static pmix_status_t _hash_store_modex(void * cbdata,
         bo->size = pbkt.bytes_used; // restore the incoming data
         pbkt.base_ptr = NULL;
         PMIX_DESTRUCT(&pbkt);
+        pthread_rwlock_unlock(&trk->lock);
         return rc;
     }
     /* unpack the remaining values until we hit the end of the buffer */
@@ -1262,6 +1465,7 @@ static pmix_status_t _hash_store_modex(void * cbdata,
             bo->size = pbkt.bytes_used; // restore the incoming data
             pbkt.base_ptr = NULL;
             PMIX_DESTRUCT(&pbkt);
+            pthread_rwlock_unlock(&trk->lock);
             return rc;
         }
         PMIX_RELEASE(kv);  // maintain accounting as the hash increments the ref count
@@ -1271,6 +1475,7 @@ static pmix_status_t _hash_store_modex(void * cbdata,
         PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &pbkt, kv, &cnt, PMIX_KVAL);
     }
     PMIX_RELEASE(kv);  // maintain accounting
+    pthread_rwlock_unlock(&trk->lock);
     if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
         PMIX_ERROR_LOG(rc);
     } else {
@@ -1284,45 +1489,34 @@ static pmix_status_t _hash_store_modex(void * cbdata,
 }
 
 
-static pmix_status_t hash_fetch(const pmix_proc_t *proc,
-                                pmix_scope_t scope, bool copy,
-                                const char *key,
-                                pmix_info_t qualifiers[], size_t nqual,
-                                pmix_list_t *kvs)
+static pmix_status_t _hash_fetch(pmix_hash_trkr_t *trk,
+                                 const pmix_proc_t *proc,
+                                 pmix_scope_t scope, bool copy,
+                                 const char *key,
+                                 pmix_list_t *kvs)
 {
-    pmix_hash_trkr_t *trk, *t;
     pmix_status_t rc;
     pmix_value_t *val;
     pmix_kval_t *kv;
     pmix_info_t *info;
-    size_t n, ninfo;
+    size_t n, ninfo, nkvs;
     pmix_hash_table_t *ht;
-
-    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
-                        "[%s:%u] pmix:gds:hash fetch %s for proc %s:%u on scope %s",
-                        pmix_globals.myid.nspace, pmix_globals.myid.rank,
-                        (NULL == key) ? "NULL" : key,
-                        proc->nspace, proc->rank, PMIx_Scope_string(scope));
+    const char *host;
+    bool addhost = false;
 
     /* if the rank is wildcard and the key is NULL, then
      * they are asking for a complete copy of the job-level
      * info for this nspace - retrieve it */
     if (NULL == key && PMIX_RANK_WILDCARD == proc->rank) {
-        /* see if we have a tracker for this nspace - we will
-         * if we already cached the job info for it */
-        trk = NULL;
-        PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
-            if (0 == strcmp(proc->nspace, t->ns)) {
-                trk = t;
-                break;
-            }
-        }
-        if (NULL == trk) {
-            /* let the caller know */
-            return PMIX_ERR_INVALID_NAMESPACE;
-        }
         /* the job data is stored on the internal hash table */
         ht = &trk->internal;
+        if (!copy) {
+            rc = pmix_hash_fetch_shared(ht, PMIX_RANK_WILDCARD, NULL, kvs);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+            }
+            return rc;
+        }
         /* fetch all values from the hash table tied to rank=wildcard */
         val = NULL;
         rc = pmix_hash_fetch(ht, PMIX_RANK_WILDCARD, NULL, &val);
@@ -1368,21 +1562,8 @@ static pmix_status_t hash_fetch(const pmix_proc_t *proc,
         return PMIX_SUCCESS;
     }
 
-    /* find the hash table for this nspace */
-    trk = NULL;
-    PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
-        if (0 == strcmp(proc->nspace, t->ns)) {
-            trk = t;
-            break;
-        }
-    }
-    if (NULL == trk) {
-        return PMIX_ERR_INVALID_NAMESPACE;
-    }
-
-    /* fetch from the corresponding hash table - note that
-     * we always provide a copy as we don't support
-     * shared memory */
+    /* fetch from the corresponding hash table - values are
+     * copied unless the caller said it doesn't need a copy */
     if (PMIX_INTERNAL == scope ||
         PMIX_SCOPE_UNDEF == scope ||
         PMIX_GLOBAL == scope ||
@@ -1399,74 +1580,158 @@ static pmix_status_t hash_fetch(const pmix_proc_t *proc,
     }
 
   doover:
-    rc = pmix_hash_fetch(ht, proc->rank, key, &val);
-    if (PMIX_SUCCESS == rc) {
-        /* if the key was NULL, then all found keys will be
-         * returned as a pmix_data_array_t in the value */
-        if (NULL == key) {
-            if (NULL == val->data.darray ||
-                PMIX_INFO != val->data.darray->type ||
-                0 == val->data.darray->size) {
+    if (!copy && PMIX_RANK_UNDEF != proc->rank) {
+        /* the caller won't modify what we return, so share the
+         * stored values rather than copying them */
+        nkvs = pmix_list_get_size(kvs);
+        rc = pmix_hash_fetch_shared(ht, proc->rank, key, kvs);
+        if (PMIX_SUCCESS == rc) {
+            if (NULL != key) {
+                goto done;
+            }
+            if (nkvs == pmix_list_get_size(kvs)) {
                 PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
                 return PMIX_ERR_NOT_FOUND;
             }
-            info = (pmix_info_t*)val->data.darray->array;
-            ninfo = val->data.darray->size;
-            for (n=0; n < ninfo; n++) {
-                kv = PMIX_NEW(pmix_kval_t);
-                if (NULL == kv) {
-                    PMIX_VALUE_RELEASE(val);
-                    return PMIX_ERR_NOMEM;
-                }
-                kv->key = strdup(info[n].key);
-                kv->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
-                if (NULL == kv->value) {
-                    PMIX_VALUE_RELEASE(val);
-                    PMIX_RELEASE(kv);
-                    return PMIX_ERR_NOMEM;
-                }
-                PMIX_BFROPS_VALUE_XFER(rc, pmix_globals.mypeer,
-                                       kv->value, &info[n].value);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_VALUE_RELEASE(val);
-                    PMIX_RELEASE(kv);
-                    return rc;
-                }
-                pmix_list_append(kvs, &kv->super);
+            /* the hostname from the job maps isn't stored as a kval,
+             * so it has to be added to the job-level data */
+            if (ht == &trk->internal) {
+                addhost = true;
             }
-            PMIX_VALUE_RELEASE(val);
             if (PMIX_GLOBAL == scope && ht == &trk->local) {
                 /* need to do this again for the remote data */
                 ht = &trk->remote;
                 goto doover;
             }
-            return PMIX_SUCCESS;
+            goto done;
         }
-        /* just return the value */
-        kv = PMIX_NEW(pmix_kval_t);
-        if (NULL == kv) {
-            PMIX_VALUE_RELEASE(val);
-            return PMIX_ERR_NOMEM;
-        }
-        kv->key = strdup(key);
-        kv->value = val;
-        pmix_list_append(kvs, &kv->super);
     } else {
-        if (PMIX_GLOBAL == scope ||
-            PMIX_SCOPE_UNDEF == scope) {
-            if (ht == &trk->internal) {
-                /* need to also try the local data */
-                ht = &trk->local;
-                goto doover;
-            } else if (ht == &trk->local) {
-                /* need to also try the remote data */
-                ht = &trk->remote;
-                goto doover;
+        rc = pmix_hash_fetch(ht, proc->rank, key, &val);
+        if (PMIX_SUCCESS == rc) {
+            /* if the key was NULL, then all found keys will be
+             * returned as a pmix_data_array_t in the value */
+            if (NULL == key) {
+                if (NULL == val->data.darray ||
+                    PMIX_INFO != val->data.darray->type ||
+                    0 == val->data.darray->size) {
+                    PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
+                    return PMIX_ERR_NOT_FOUND;
+                }
+                info = (pmix_info_t*)val->data.darray->array;
+                ninfo = val->data.darray->size;
+                /* the hostname from the job maps isn't stored as a kval,
+                 * so it has to be added to the job-level data */
+                if (ht == &trk->internal) {
+                    addhost = true;
+                }
+                for (n=0; n < ninfo; n++) {
+                    kv = PMIX_NEW(pmix_kval_t);
+                    if (NULL == kv) {
+                        PMIX_VALUE_RELEASE(val);
+                        return PMIX_ERR_NOMEM;
+                    }
+                    kv->key = strdup(info[n].key);
+                    kv->value = (pmix_value_t*)malloc(sizeof(pmix_value_t));
+                    if (NULL == kv->value) {
+                        PMIX_VALUE_RELEASE(val);
+                        PMIX_RELEASE(kv);
+                        return PMIX_ERR_NOMEM;
+                    }
+                    PMIX_BFROPS_VALUE_XFER(rc, pmix_globals.mypeer,
+                                           kv->value, &info[n].value);
+                    if (PMIX_SUCCESS != rc) {
+                        PMIX_ERROR_LOG(rc);
+                        PMIX_VALUE_RELEASE(val);
+                        PMIX_RELEASE(kv);
+                        return rc;
+                    }
+                    pmix_list_append(kvs, &kv->super);
+                }
+                PMIX_VALUE_RELEASE(val);
+                if (PMIX_GLOBAL == scope && ht == &trk->local) {
+                    /* need to do this again for the remote data */
+                    ht = &trk->remote;
+                    goto doover;
+                }
+                rc = PMIX_SUCCESS;
+                goto done;
+            }
+            /* just return the value */
+            kv = PMIX_NEW(pmix_kval_t);
+            if (NULL == kv) {
+                PMIX_VALUE_RELEASE(val);
+                return PMIX_ERR_NOMEM;
             }
+            kv->key = strdup(key);
+            kv->value = val;
+            pmix_list_append(kvs, &kv->super);
+            goto done;
         }
     }
 
+    /* not found in this table */
+    if (ht == &trk->internal) {
+        if (NULL == key) {
+            addhost = true;
+        } else if (0 == strcmp(key, PMIX_HOSTNAME) &&
+                   NULL != (host = lookup_host(trk, proc->rank))) {
+            return add_host_kv(kvs, host);
+        }
+    }
+    if (PMIX_GLOBAL == scope ||
+        PMIX_SCOPE_UNDEF == scope) {
+        if (ht == &trk->internal) {
+            /* need to also try the local data */
+            ht = &trk->local;
+            goto doover;
+        } else if (ht == &trk->local) {
+            /* need to also try the remote data */
+            ht = &trk->remote;
+            goto doover;
+        }
+    }
+
+  done:
+    if (addhost) {
+        /* unless one of the passes already returned it */
+        PMIX_LIST_FOREACH(kv, kvs, pmix_kval_t) {
+            if (0 == strcmp(kv->key, PMIX_HOSTNAME)) {
+                addhost = false;
+                break;
+            }
+        }
+    }
+    if (addhost && NULL != (host = lookup_host(trk, proc->rank))) {
+        if (PMIX_SUCCESS == add_host_kv(kvs, host)) {
+            rc = PMIX_SUCCESS;
+        }
+    }
+    return rc;
+}
+
+static pmix_status_t hash_fetch(const pmix_proc_t *proc,
+                                pmix_scope_t scope, bool copy,
+                                const char *key,
+                                pmix_info_t qualifiers[], size_t nqual,
+                                pmix_list_t *kvs)
+{
+    pmix_hash_trkr_t *trk;
+    pmix_status_t rc;
+
+    pmix_output_verbose(2, pmix_gds_base_framework.framework_output,
+                        "[%s:%u] pmix:gds:hash fetch %s for proc %s:%u on scope %s",
+                        pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                        (NULL == key) ? "NULL" : key,
+                        proc->nspace, proc->rank, PMIx_Scope_string(scope));
+
+    /* see if we have a tracker for this nspace - we will
+     * if we already cached any data for it */
+    if (NULL == (trk = read_tracker(proc->nspace))) {
+        /* let the caller know */
+        return PMIX_ERR_INVALID_NAMESPACE;
+    }
+    rc = _hash_fetch(trk, proc, scope, copy, key, kvs);
+    pthread_rwlock_unlock(&trk->lock);
     return rc;
 }
 
@@ -1489,15 +1754,53 @@ static pmix_status_t nspace_del(const char *nspace)
     pmix_hash_trkr_t *t;
 
     /* find the hash table for this nspace */
+    if (NULL == (t = get_tracker(nspace, false))) {
+        return PMIX_SUCCESS;
+    }
+    /* once off the list no new fetch can find it, so just
+     * wait out any that are still reading before releasing it */
+    pthread_rwlock_wrlock(&myhashes_lock);
+    pmix_list_remove_item(&myhashes, &t->super);
+    pthread_rwlock_unlock(&myhashes_lock);
+    pthread_rwlock_wrlock(&t->lock);
+    pthread_rwlock_unlock(&t->lock);
+    PMIX_RELEASE(t);
+    return PMIX_SUCCESS;
+}
+
+static void mem_usage(pmix_list_t *usage)
+{
+    pmix_hash_trkr_t *t;
+    pmix_kval_t *kv;
+    size_t sz;
+    int n;
+
     PMIX_LIST_FOREACH(t, &myhashes, pmix_hash_trkr_t) {
-        if (0 == strcmp(nspace, t->ns)) {
-            /* release it */
-            pmix_list_remove_item(&myhashes, &t->super);
-            PMIX_RELEASE(t);
-            break;
+        sz = sizeof(pmix_hash_trkr_t) +
+             pmix_hash_mem_usage(&t->internal) +
+             pmix_hash_mem_usage(&t->remote) +
+             pmix_hash_mem_usage(&t->local) +
+             t->nhostidx * sizeof(uint32_t);
+        for (n=0; NULL != t->hostnames && NULL != t->hostnames[n]; n++) {
+            sz += sizeof(char*) + strlen(t->hostnames[n]) + 1;
         }
+        kv = PMIX_NEW(pmix_kval_t);
+        if (NULL == kv) {
+            return;
+        }
+        if (0 > asprintf(&kv->key, "gds.hash:%s", (NULL == t->ns) ? "" : t->ns)) {
+            PMIX_RELEASE(kv);
+            return;
+        }
+        PMIX_VALUE_CREATE(kv->value, 1);
+        if (NULL == kv->value) {
+            PMIX_RELEASE(kv);
+            return;
+        }
+        kv->value->type = PMIX_SIZE;
+        kv->value->data.size = sz;
+        pmix_list_append(usage, &kv->super);
     }
-    return PMIX_SUCCESS;
 }
 
 static pmix_status_t assemb_kvs_req(const pmix_proc_t *proc,
@@ -1532,6 +1835,7 @@ static pmix_status_t accept_kvs_resp(pmix_buffer_t *buf)
     pmix_buffer_t pbkt;
     pmix_kval_t *kv;
     pmix_proc_t proct;
+    bool copied = false;
 
     /* the incoming payload is provided as a set of packed
      * byte objects, one for each rank. A pmix_proc_t is the first
@@ -1539,10 +1843,10 @@ static pmix_status_t accept_kvs_resp(pmix_buffer_t *buf)
      * then that byte object contains job level info
      * for the provided nspace. Otherwise, the byte
      * object contains the pmix_kval_t's that were "put" by the
-     * referenced process */
-    cnt = 1;
-    PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver,
-                       buf, &bo, &cnt, PMIX_BYTE_OBJECT);
+     * referenced process. The byte objects are only parsed, so
+     * reference them in the incoming buffer instead of copying */
+    PMIX_BFROPS_UNPACK_BORROW(rc, pmix_client_globals.myserver,
+                              buf, &bo, copied);
     while (PMIX_SUCCESS == rc) {
         /* setup the byte object for unpacking */
         PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
@@ -1554,6 +1858,10 @@ static pmix_status_t accept_kvs_resp(pmix_buffer_t *buf)
                            &pbkt, &proct, &cnt, PMIX_PROC);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
+            if (!copied) {
+                PMIX_UNLOAD_BUFFER(&pbkt, bo.bytes, bo.size);
+            }
+            PMIX_DESTRUCT(&pbkt);
             return rc;
         }
         cnt = 1;
@@ -1570,6 +1878,9 @@ static pmix_status_t accept_kvs_resp(pmix_buffer_t *buf)
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
                 PMIX_RELEASE(kv);
+                if (!copied) {
+                    PMIX_UNLOAD_BUFFER(&pbkt, bo.bytes, bo.size);
+                }
                 PMIX_DESTRUCT(&pbkt);
                 return rc;
             }
@@ -1581,16 +1892,17 @@ static pmix_status_t accept_kvs_resp(pmix_buffer_t *buf)
                                &pbkt, kv, &cnt, PMIX_KVAL);
         }
         PMIX_RELEASE(kv);  // maintain accounting
+        if (!copied) {
+            PMIX_UNLOAD_BUFFER(&pbkt, bo.bytes, bo.size);
+        }
+        PMIX_DESTRUCT(&pbkt);
         if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
             PMIX_ERROR_LOG(rc);
-            PMIX_DESTRUCT(&pbkt);
             return rc;
         }
-        PMIX_DESTRUCT(&pbkt);
         /* get the next one */
-        cnt = 1;
-        PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver,
-                           buf, &bo, &cnt, PMIX_BYTE_OBJECT);
+        PMIX_BFROPS_UNPACK_BORROW(rc, pmix_client_globals.myserver,
+                                  buf, &bo, copied);
     }
     if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
         PMIX_ERROR_LOG(rc);
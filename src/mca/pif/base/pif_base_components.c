@@ -15,6 +15,7 @@
 
 #include "pmix_common.h"
 #include "src/util/output.h"
+#include "src/util/pif.h"
 #include "src/mca/mca.h"
 #include "src/mca/pif/pif.h"
 #include "src/mca/pif/base/base.h"
@@ -60,6 +61,8 @@ static int pmix_pif_base_register (pmix_mca_base_register_flag_t flags)
 
 static int pmix_pif_base_open (pmix_mca_base_open_flag_t flags)
 {
+    int rc;
+
     if (frameopen) {
         return PMIX_SUCCESS;
     }
@@ -68,7 +71,12 @@ static int pmix_pif_base_open (pmix_mca_base_open_flag_t flags)
     /* setup the global list */
     PMIX_CONSTRUCT(&pmix_if_list, pmix_list_t);
 
-    return pmix_mca_base_framework_components_open(&pmix_pif_base_framework, flags);
+    rc = pmix_mca_base_framework_components_open(&pmix_pif_base_framework, flags);
+    if (PMIX_SUCCESS == rc) {
+        /* the components have found the interfaces - index them */
+        pmix_ifindex_build();
+    }
+    return rc;
 }
 
 
@@ -81,6 +89,7 @@ static int pmix_pif_base_close(void)
     }
     frameopen = false;
 
+    pmix_ifindex_clear();
     while (NULL != (item = pmix_list_remove_first(&pmix_if_list))) {
         PMIX_RELEASE(item);
     }
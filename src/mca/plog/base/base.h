@@ -72,12 +72,46 @@ typedef struct pmix_plog_base_active_module_t pmix_plog_base_active_module_t;
 PMIX_CLASS_DECLARATION(pmix_plog_base_active_module_t);
 
 
+/* a log entry queued for the background writer */
+typedef struct {
+    pmix_list_item_t super;
+    int pri;
+    char *msg;
+} pmix_plog_base_entry_t;
+PMIX_CLASS_DECLARATION(pmix_plog_base_entry_t);
+
+/* called on the writer thread with a batch of entries queued on a
+ * channel, oldest first, plus the number that were dropped by the
+ * rate limit since the previous batch */
+typedef void (*pmix_plog_base_flush_fn_t)(pmix_list_t *entries, size_t dropped);
+
+/* a queue of entries for one blocking plog module */
+typedef struct {
+    pmix_list_item_t super;
+    char *name;
+    pmix_plog_base_flush_fn_t flush;
+    pmix_mutex_t lock;          // entries are queued from any thread
+    pmix_list_t pending;
+    size_t npending;
+    size_t dropped;
+    double tokens;              // rate limit budget
+    struct timeval last;        // when the budget was last topped up
+    pmix_event_t ev;            // flushes the queue on the writer thread
+    bool scheduled;
+} pmix_plog_base_channel_t;
+PMIX_CLASS_DECLARATION(pmix_plog_base_channel_t);
+
 /* framework globals */
 struct pmix_plog_globals_t {
     pmix_lock_t lock;
     pmix_pointer_array_t actives;
     bool initialized;
     char **channels;
+    pmix_event_base_t *evbase;  // background writer, started with the first channel
+    pmix_list_t writers;        // pmix_plog_base_channel_t
+    int batch_size;
+    int batch_msec;
+    int rate;                   // max entries/sec on each channel, 0 = no limit
 };
 typedef struct pmix_plog_globals_t pmix_plog_globals_t;
 
@@ -88,6 +122,24 @@ PMIX_EXPORT pmix_status_t pmix_plog_base_log(const pmix_proc_t *source,
                                              const pmix_info_t directives[], size_t ndirs,
                                              pmix_op_cbfunc_t cbfunc, void *cbdata);
 
+/* create a writer queue for a module whose output may block the
+ * caller - the queue is flushed and released when the framework
+ * closes */
+PMIX_EXPORT pmix_plog_base_channel_t* pmix_plog_base_channel_create(const char *name,
+                                                                    pmix_plog_base_flush_fn_t flush);
+
+/* queue an entry for the background writer, taking ownership of
+ * msg. The entry may be dropped if the channel is over its rate */
+PMIX_EXPORT pmix_status_t pmix_plog_base_defer(pmix_plog_base_channel_t *chan,
+                                               int pri, char *msg);
+
+/* flush all queues and stop the writer */
+PMIX_EXPORT void pmix_plog_base_writers_finalize(void);
+
+/* true if the directives require the entries to be written
+ * before the request completes */
+PMIX_EXPORT bool pmix_plog_base_sync_requested(const pmix_info_t directives[], size_t ndirs);
+
 END_C_DECLS
 
 #endif
@@ -47,6 +47,40 @@ static int pmix_plog_register(pmix_mca_base_register_flag_t flags)
     if (NULL != order) {
         pmix_plog_globals.channels = pmix_argv_split(order, ',');
     }
+
+    pmix_plog_globals.batch_size = 64;
+    pmix_mca_base_var_register("pmix", "plog", "base", "batch_size",
+                               "Number of queued entries that causes a blocking channel "
+                               "to be written without waiting for the batch interval",
+                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                               PMIX_INFO_LVL_5,
+                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                               &pmix_plog_globals.batch_size);
+    if (0 >= pmix_plog_globals.batch_size) {
+        pmix_plog_globals.batch_size = 1;
+    }
+    pmix_plog_globals.batch_msec = 100;
+    pmix_mca_base_var_register("pmix", "plog", "base", "batch_interval",
+                               "Milliseconds entries for a blocking channel are held "
+                               "so they can be written together",
+                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                               PMIX_INFO_LVL_5,
+                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                               &pmix_plog_globals.batch_msec);
+    if (0 > pmix_plog_globals.batch_msec) {
+        pmix_plog_globals.batch_msec = 0;
+    }
+    pmix_plog_globals.rate = 0;
+    pmix_mca_base_var_register("pmix", "plog", "base", "rate_limit",
+                               "Maximum entries per second queued on each blocking "
+                               "channel - any beyond it are dropped and counted (0 = no limit)",
+                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                               PMIX_INFO_LVL_5,
+                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                               &pmix_plog_globals.rate);
+    if (0 > pmix_plog_globals.rate) {
+        pmix_plog_globals.rate = 0;
+    }
     return PMIX_SUCCESS;
 }
 
@@ -60,6 +94,10 @@ static pmix_status_t pmix_plog_close(void)
     }
     pmix_plog_globals.initialized = false;
 
+    /* anything still queued goes out before the modules close */
+    pmix_plog_base_writers_finalize();
+    PMIX_DESTRUCT(&pmix_plog_globals.writers);
+
     for (n=0; n < pmix_plog_globals.actives.size; n++) {
         if (NULL == (active = (pmix_plog_base_active_module_t*)pmix_pointer_array_get_item(&pmix_plog_globals.actives, n))) {
             continue;
@@ -82,6 +120,8 @@ static pmix_status_t pmix_plog_open(pmix_mca_base_open_flag_t flags)
     /* initialize globals */
     pmix_plog_globals.initialized = true;
     pmix_plog_globals.channels = NULL;
+    pmix_plog_globals.evbase = NULL;
+    PMIX_CONSTRUCT(&pmix_plog_globals.writers, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_plog_globals.actives, pmix_pointer_array_t);
     pmix_pointer_array_init(&pmix_plog_globals.actives, 1, INT_MAX, 1);
     PMIX_CONSTRUCT_LOCK(&pmix_plog_globals.lock);
@@ -0,0 +1,211 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ *
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <pmix_common.h>
+#include PMIX_EVENT_HEADER
+#include "event2/thread.h"
+#include "src/include/pmix_globals.h"
+
+#include "src/class/pmix_list.h"
+#include "src/runtime/pmix_progress_threads.h"
+#include "src/util/error.h"
+#include "src/util/output.h"
+
+#include "src/mca/plog/base/base.h"
+
+static void flush_channel(int sd, short args, void *cbdata)
+{
+    pmix_plog_base_channel_t *chan = (pmix_plog_base_channel_t*)cbdata;
+    pmix_list_t batch;
+    size_t dropped;
+
+    PMIX_ACQUIRE_OBJECT(chan);
+
+    /* take everything queued so far - new entries can be
+     * queued while we write these */
+    PMIX_CONSTRUCT(&batch, pmix_list_t);
+    pmix_mutex_lock(&chan->lock);
+    pmix_list_join(&batch, pmix_list_get_end(&batch), &chan->pending);
+    dropped = chan->dropped;
+    chan->dropped = 0;
+    chan->npending = 0;
+    chan->scheduled = false;
+    pmix_mutex_unlock(&chan->lock);
+
+    if (0 < pmix_list_get_size(&batch) || 0 < dropped) {
+        pmix_output_verbose(5, pmix_plog_base_framework.framework_output,
+                            "plog:writer flushing %lu entries (%lu dropped) on %s",
+                            (unsigned long)pmix_list_get_size(&batch),
+                            (unsigned long)dropped, chan->name);
+        chan->flush(&batch, dropped);
+    }
+    PMIX_LIST_DESTRUCT(&batch);
+}
+
+pmix_plog_base_channel_t* pmix_plog_base_channel_create(const char *name,
+                                                        pmix_plog_base_flush_fn_t flush)
+{
+    pmix_plog_base_channel_t *chan;
+
+    if (NULL == pmix_plog_globals.evbase) {
+        /* the modules are selected before the runtime turns on
+         * libevent thread support, and the writer is always driven
+         * from another thread - so make sure it is on */
+        pmix_event_use_threads();
+        if (NULL == (pmix_plog_globals.evbase = pmix_progress_thread_init("PLOG"))) {
+            return NULL;
+        }
+    }
+    chan = PMIX_NEW(pmix_plog_base_channel_t);
+    if (NULL == chan) {
+        return NULL;
+    }
+    chan->name = strdup(name);
+    chan->flush = flush;
+    chan->tokens = pmix_plog_globals.rate;
+    gettimeofday(&chan->last, NULL);
+    pmix_event_evtimer_set(pmix_plog_globals.evbase, &chan->ev, flush_channel, chan);
+    pmix_list_append(&pmix_plog_globals.writers, &chan->super);
+    return chan;
+}
+
+pmix_status_t pmix_plog_base_defer(pmix_plog_base_channel_t *chan,
+                                   int pri, char *msg)
+{
+    pmix_plog_base_entry_t *entry;
+    struct timeval now, tv;
+    double elapsed;
+
+    pmix_mutex_lock(&chan->lock);
+
+    /* refill the budget for the time since we last looked - it
+     * never holds more than a second's worth */
+    if (0 < pmix_plog_globals.rate) {
+        gettimeofday(&now, NULL);
+        elapsed = (double)(now.tv_sec - chan->last.tv_sec) +
+                  (double)(now.tv_usec - chan->last.tv_usec) / 1000000.0;
+        chan->last = now;
+        chan->tokens += elapsed * pmix_plog_globals.rate;
+        if (chan->tokens > pmix_plog_globals.rate) {
+            chan->tokens = pmix_plog_globals.rate;
+        }
+        if (chan->tokens < 1.0) {
+            chan->dropped++;
+            pmix_mutex_unlock(&chan->lock);
+            free(msg);
+            return PMIX_SUCCESS;
+        }
+        chan->tokens -= 1.0;
+    }
+
+    entry = PMIX_NEW(pmix_plog_base_entry_t);
+    if (NULL == entry) {
+        pmix_mutex_unlock(&chan->lock);
+        free(msg);
+        return PMIX_ERR_NOMEM;
+    }
+    entry->pri = pri;
+    entry->msg = msg;
+    pmix_list_append(&chan->pending, &entry->super);
+    chan->npending++;
+
+    if (!chan->scheduled) {
+        /* give the batch a chance to fill */
+        chan->scheduled = true;
+        tv.tv_sec = pmix_plog_globals.batch_msec / 1000;
+        tv.tv_usec = (pmix_plog_globals.batch_msec % 1000) * 1000;
+        PMIX_POST_OBJECT(chan);
+        pmix_event_evtimer_add(&chan->ev, &tv);
+    } else if (chan->npending == (size_t)pmix_plog_globals.batch_size) {
+        /* full - no point waiting any longer */
+        PMIX_POST_OBJECT(chan);
+        pmix_event_active(&chan->ev, EV_TIMEOUT, 1);
+    }
+    pmix_mutex_unlock(&chan->lock);
+
+    return PMIX_SUCCESS;
+}
+
+void pmix_plog_base_writers_finalize(void)
+{
+    pmix_plog_base_channel_t *chan;
+
+    if (NULL == pmix_plog_globals.evbase) {
+        return;
+    }
+    /* stop the writer first so nothing else touches the
+     * queues, then write whatever is left from here */
+    PMIX_LIST_FOREACH(chan, &pmix_plog_globals.writers, pmix_plog_base_channel_t) {
+        pmix_event_evtimer_del(&chan->ev);
+    }
+    (void)pmix_progress_thread_stop("PLOG");
+    pmix_plog_globals.evbase = NULL;
+
+    while (NULL != (chan = (pmix_plog_base_channel_t*)pmix_list_remove_first(&pmix_plog_globals.writers))) {
+        flush_channel(0, 0, chan);
+        PMIX_RELEASE(chan);
+    }
+}
+
+bool pmix_plog_base_sync_requested(const pmix_info_t directives[], size_t ndirs)
+{
+    size_t n;
+
+    if (NULL == directives) {
+        return false;
+    }
+    for (n=0; n < ndirs; n++) {
+        if (0 == strncmp(directives[n].key, PMIX_LOG_SYNC, PMIX_MAX_KEYLEN)) {
+            return PMIX_INFO_TRUE(&directives[n]);
+        }
+    }
+    return false;
+}
+
+static void entcon(pmix_plog_base_entry_t *p)
+{
+    p->pri = 0;
+    p->msg = NULL;
+}
+static void entdes(pmix_plog_base_entry_t *p)
+{
+    if (NULL != p->msg) {
+        free(p->msg);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_plog_base_entry_t,
+                    pmix_list_item_t,
+                    entcon, entdes);
+
+static void chcon(pmix_plog_base_channel_t *p)
+{
+    p->name = NULL;
+    p->flush = NULL;
+    PMIX_CONSTRUCT(&p->lock, pmix_mutex_t);
+    PMIX_CONSTRUCT(&p->pending, pmix_list_t);
+    p->npending = 0;
+    p->dropped = 0;
+    p->tokens = 0;
+    p->scheduled = false;
+}
+static void chdes(pmix_plog_base_channel_t *p)
+{
+    if (NULL != p->name) {
+        free(p->name);
+    }
+    PMIX_DESTRUCT(&p->lock);
+    PMIX_LIST_DESTRUCT(&p->pending);
+}
+PMIX_CLASS_INSTANCE(pmix_plog_base_channel_t,
+                    pmix_list_item_t,
+                    chcon, chdes);
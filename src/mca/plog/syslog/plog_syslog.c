@@ -52,6 +52,9 @@ static pmix_status_t mylog(const pmix_proc_t *source,
                            const pmix_info_t directives[], size_t ndirs,
                            pmix_op_cbfunc_t cbfunc, void *cbdata);
 
+/* queue for entries that needn't be written before we return */
+static pmix_plog_base_channel_t *writer = NULL;
+
 /* Module def */
 pmix_plog_module_t pmix_plog_syslog_module = {
     .name = "syslog",
@@ -61,6 +64,20 @@ pmix_plog_module_t pmix_plog_syslog_module = {
 };
 
 
+static void flush_entries(pmix_list_t *entries, size_t dropped)
+{
+    pmix_plog_base_entry_t *entry;
+
+    PMIX_LIST_FOREACH(entry, entries, pmix_plog_base_entry_t) {
+        syslog(entry->pri, "%s", entry->msg);
+    }
+    if (0 < dropped) {
+        syslog(LOG_WARNING, "[%s:%d] %lu LOG ENTRIES DROPPED BY RATE LIMIT",
+               pmix_globals.myid.nspace, pmix_globals.myid.rank,
+               (unsigned long)dropped);
+    }
+}
+
 static pmix_status_t init(void)
 {
     int opts;
@@ -71,11 +88,17 @@ static pmix_status_t init(void)
     opts = LOG_CONS | LOG_PID;
     openlog("PMIx Log Report:", opts, LOG_USER);
 
+    /* syslog can block, so write from the background writer
+     * unless the caller needs to know it has been done */
+    writer = pmix_plog_base_channel_create("syslog", flush_entries);
+
     return PMIX_SUCCESS;
 }
 
 static void finalize(void)
 {
+    /* the base has already flushed and released our queue */
+    writer = NULL;
     closelog();
     pmix_argv_free(pmix_plog_syslog_module.channels);
 }
@@ -83,7 +106,8 @@ static void finalize(void)
 static pmix_status_t write_local(const pmix_proc_t *source,
                                  time_t timestamp,
                                  int severity, char *msg,
-                                 const pmix_info_t *data, size_t ndata);
+                                 const pmix_info_t *data, size_t ndata,
+                                 bool sync);
 
 /* we only get called if we are a SERVER */
 static pmix_status_t mylog(const pmix_proc_t *source,
@@ -95,11 +119,13 @@ static pmix_status_t mylog(const pmix_proc_t *source,
     int pri = mca_plog_syslog_component.level;
     pmix_status_t rc;
     time_t timestamp = 0;
+    bool sync;
 
     /* if there is no data, then we don't handle it */
     if (NULL == data || 0 == ndata) {
         return PMIX_ERR_NOT_AVAILABLE;
     }
+    sync = (NULL == writer || pmix_plog_base_sync_requested(directives, ndirs));
 
     /* check directives */
     if (NULL != directives) {
@@ -116,13 +142,13 @@ static pmix_status_t mylog(const pmix_proc_t *source,
     for (n=0; n < ndata; n++) {
         if (0 == strncmp(data[n].key, PMIX_LOG_SYSLOG, PMIX_MAX_KEYLEN)) {
             /* we default to using the local syslog */
-            rc = write_local(source, timestamp, pri, data[n].value.data.string, data, ndata);
+            rc = write_local(source, timestamp, pri, data[n].value.data.string, data, ndata, sync);
             if (PMIX_SUCCESS == rc) {
                 /* flag that we did this one */
                 PMIX_INFO_OP_COMPLETED(&data[n]);
             }
         } else if (0 == strncmp(data[n].key, PMIX_LOG_LOCAL_SYSLOG, PMIX_MAX_KEYLEN)) {
-            rc = write_local(source, timestamp, pri, data[n].value.data.string, data, ndata);
+            rc = write_local(source, timestamp, pri, data[n].value.data.string, data, ndata, sync);
             if (PMIX_SUCCESS == rc) {
                 /* flag that we did this one */
                 PMIX_INFO_OP_COMPLETED(&data[n]);
@@ -130,7 +156,7 @@ static pmix_status_t mylog(const pmix_proc_t *source,
         } else if (0 == strncmp(data[n].key, PMIX_LOG_GLOBAL_SYSLOG, PMIX_MAX_KEYLEN)) {
             /* only do this if we are a gateway server */
             if (PMIX_PROC_IS_GATEWAY(pmix_globals.mypeer)) {
-                rc = write_local(source, timestamp, pri, data[n].value.data.string, data, ndata);
+                rc = write_local(source, timestamp, pri, data[n].value.data.string, data, ndata, sync);
                 if (PMIX_SUCCESS == rc) {
                     /* flag that we did this one */
                     PMIX_INFO_OP_COMPLETED(&data[n]);
@@ -169,28 +195,34 @@ static char* sev2str(int severity)
 static pmix_status_t write_local(const pmix_proc_t *source,
                                  time_t timestamp,
                                  int severity, char *msg,
-                                 const pmix_info_t *data, size_t ndata)
+                                 const pmix_info_t *data, size_t ndata,
+                                 bool sync)
 {
-    char tod[48], *datastr, *tmp, *tmp2;
+    char tod[48], *datastr, *tmp, *tmp2, *line;
     pmix_status_t rc;
     size_t n;
 
     pmix_output_verbose(5, pmix_plog_base_framework.framework_output,
                            "plog:syslog:mylog function called with severity %d", severity);
 
+    tod[0] = '\0';
     if (0 < timestamp) {
         /* If there was a message, output it */
         (void)ctime_r(&timestamp, tod);
         /* trim the newline */
-        tod[strlen(tod)] = '\0';
+        if (0 < strlen(tod)) {
+            tod[strlen(tod)-1] = '\0';
+        }
     }
 
     if (NULL == data) {
-        syslog(severity, "%s [%s:%d]%s PROC %s:%d REPORTS: %s",
-               tod, pmix_globals.myid.nspace, pmix_globals.myid.rank,
-               sev2str(severity),
-               source->nspace, source->rank,
-               (NULL == msg) ? "<N/A>" : msg);
+        if (0 > asprintf(&line, "%s [%s:%d]%s PROC %s:%d REPORTS: %s",
+                         tod, pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                         sev2str(severity),
+                         source->nspace, source->rank,
+                         (NULL == msg) ? "<N/A>" : msg)) {
+            return PMIX_ERR_NOMEM;
+        }
     } else {
         /* need to print the info from the data, starting
          * with any provided msg */
@@ -216,12 +248,20 @@ static pmix_status_t write_local(const pmix_proc_t *source,
             free(tmp);
             datastr = tmp2;
         }
-        /* print out the consolidated msg */
-        syslog(severity, "%s [%s:%d]%s PROC %s:%d REPORTS: %s",
-               tod, pmix_globals.myid.nspace, pmix_globals.myid.rank,
-               sev2str(severity), source->nspace, source->rank, datastr);
+        /* consolidate the msg */
+        if (0 > asprintf(&line, "%s [%s:%d]%s PROC %s:%d REPORTS: %s",
+                         tod, pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                         sev2str(severity), source->nspace, source->rank, datastr)) {
+            free(datastr);
+            return PMIX_ERR_NOMEM;
+        }
         free(datastr);
     }
 
+    if (!sync) {
+        return pmix_plog_base_defer(writer, severity, line);
+    }
+    syslog(severity, "%s", line);
+    free(line);
     return PMIX_SUCCESS;
 }
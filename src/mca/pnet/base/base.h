@@ -64,6 +64,9 @@ struct pmix_pnet_base_active_module_t {
     int pri;
     pmix_pnet_module_t *module;
     pmix_pnet_base_component_t *component;
+    /* inventory collection runs on a thread of its own - keep
+     * two collections from running the module at once */
+    pmix_mutex_t invlock;
 };
 typedef struct pmix_pnet_base_active_module_t pmix_pnet_base_active_module_t;
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_pnet_base_active_module_t);
@@ -106,6 +109,8 @@ struct pmix_pnet_globals_t {
     bool initialized;
     pmix_list_t jobs;
     pmix_list_t nodes;
+    int inventory_timeout;      // secs to wait for inventory, 0 = no limit
+    pmix_list_t inv_workers;    // inventory collections still running
 };
 typedef struct pmix_pnet_globals_t pmix_pnet_globals_t;
 
@@ -121,9 +126,13 @@ PMIX_EXPORT pmix_status_t pmix_pnet_base_setup_fork(const pmix_proc_t *peer, cha
 PMIX_EXPORT void pmix_pnet_base_child_finalized(pmix_proc_t *peer);
 PMIX_EXPORT void pmix_pnet_base_local_app_finalized(pmix_namespace_t *nptr);
 PMIX_EXPORT void pmix_pnet_base_deregister_nspace(char *nspace);
+PMIX_EXPORT pmix_status_t pmix_pnet_base_register_endpoints(char *nspace,
+                                                            pmix_info_t info[],
+                                                            size_t ninfo);
 PMIX_EXPORT void pmix_pnet_base_collect_inventory(pmix_info_t directives[], size_t ndirs,
                                                   pmix_inventory_cbfunc_t cbfunc,
                                                   void *cbdata);
+PMIX_EXPORT void pmix_pnet_base_inventory_drain(void);
 PMIX_EXPORT void pmix_pnet_base_deliver_inventory(pmix_info_t info[], size_t ninfo,
                                                   pmix_info_t directives[], size_t ndirs,
                                                   pmix_op_cbfunc_t cbfunc, void *cbdata);
@@ -40,7 +40,7 @@ pmix_status_t pmix_pnet_base_allocate(char *nspace,
 {
     pmix_pnet_base_active_module_t *active;
     pmix_status_t rc;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
     size_t n;
     char *nregex, *pregex;
 
@@ -59,12 +59,7 @@ pmix_status_t pmix_pnet_base_allocate(char *nspace,
         nptr = NULL;
         /* find this nspace - note that it may not have
          * been registered yet */
-        PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-            if (0 == strcmp(ns->nspace, nspace)) {
-                nptr = ns;
-                break;
-            }
-        }
+        nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, nspace);
         if (NULL == nptr) {
             /* add it */
             nptr = PMIX_NEW(pmix_namespace_t);
@@ -72,7 +67,7 @@ pmix_status_t pmix_pnet_base_allocate(char *nspace,
                 return PMIX_ERR_NOMEM;
             }
             nptr->nspace = strdup(nspace);
-            pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+            pmix_nspace_add(&pmix_server_globals.nspaces, nptr);
         }
 
         /* if the info param is NULL, then we make one pass thru the actives
@@ -141,7 +136,7 @@ pmix_status_t pmix_pnet_base_setup_local_network(char *nspace,
 {
     pmix_pnet_base_active_module_t *active;
     pmix_status_t rc;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
 
     if (!pmix_pnet_globals.initialized) {
         return PMIX_ERR_INIT;
@@ -157,12 +152,7 @@ pmix_status_t pmix_pnet_base_setup_local_network(char *nspace,
 
     /* find this proc's nspace object */
     nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, nspace);
     if (NULL == nptr) {
         /* add it */
         nptr = PMIX_NEW(pmix_namespace_t);
@@ -170,7 +160,7 @@ pmix_status_t pmix_pnet_base_setup_local_network(char *nspace,
             return PMIX_ERR_NOMEM;
         }
         nptr->nspace = strdup(nspace);
-        pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+        pmix_nspace_add(&pmix_server_globals.nspaces, nptr);
     }
 
     PMIX_LIST_FOREACH(active, &pmix_pnet_globals.actives, pmix_pnet_base_active_module_t) {
@@ -189,7 +179,7 @@ pmix_status_t pmix_pnet_base_setup_fork(const pmix_proc_t *proc, char ***env)
 {
     pmix_pnet_base_active_module_t *active;
     pmix_status_t rc;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
 
     if (!pmix_pnet_globals.initialized) {
         return PMIX_ERR_INIT;
@@ -202,12 +192,7 @@ pmix_status_t pmix_pnet_base_setup_fork(const pmix_proc_t *proc, char ***env)
 
     /* find this proc's nspace object */
     nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, proc->nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, proc->nspace);
     if (NULL == nptr) {
         /* add it */
         nptr = PMIX_NEW(pmix_namespace_t);
@@ -215,7 +200,7 @@ pmix_status_t pmix_pnet_base_setup_fork(const pmix_proc_t *proc, char ***env)
             return PMIX_ERR_NOMEM;
         }
         nptr->nspace = strdup(proc->nspace);
-        pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+        pmix_nspace_add(&pmix_server_globals.nspaces, nptr);
     }
 
     PMIX_LIST_FOREACH(active, &pmix_pnet_globals.actives, pmix_pnet_base_active_module_t) {
@@ -274,10 +259,50 @@ void pmix_pnet_base_local_app_finalized(pmix_namespace_t *nptr)
     return;
 }
 
+/* can only be called by a server */
+pmix_status_t pmix_pnet_base_register_endpoints(char *nspace,
+                                                pmix_info_t info[],
+                                                size_t ninfo)
+{
+    pmix_pnet_base_active_module_t *active;
+    pmix_status_t rc;
+    pmix_namespace_t *nptr;
+
+    if (!pmix_pnet_globals.initialized) {
+        return PMIX_ERR_INIT;
+    }
+
+    pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
+                        "pnet: register_endpoints called");
+
+    /* protect against bozo inputs */
+    if (NULL == nspace) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    /* find this nspace object */
+    nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, nspace);
+    if (NULL == nptr) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+
+    /* several fabrics may have assigned endpoints to the job */
+    PMIX_LIST_FOREACH(active, &pmix_pnet_globals.actives, pmix_pnet_base_active_module_t) {
+        if (NULL != active->module->register_endpoints) {
+            rc = active->module->register_endpoints(nptr, info, ninfo);
+            if (PMIX_SUCCESS != rc && PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+                return rc;
+            }
+        }
+    }
+
+    return PMIX_SUCCESS;
+}
+
 void pmix_pnet_base_deregister_nspace(char *nspace)
 {
     pmix_pnet_base_active_module_t *active;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
     pmix_pnet_job_t *job;
     pmix_pnet_node_t *node;
 
@@ -292,12 +317,7 @@ void pmix_pnet_base_deregister_nspace(char *nspace)
 
     /* find this nspace object */
     nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, nspace);
     if (NULL == nptr) {
         /* nothing we can do */
         return;
@@ -329,55 +349,200 @@ void pmix_pnet_base_deregister_nspace(char *nspace)
     }
 }
 
-static void cicbfunc(pmix_status_t status,
-                     pmix_list_t *inventory,
-                     void *cbdata)
+/* Components probing hardware for their inventory can each take a
+ * while, so every component that collects inventory is run on a
+ * thread of its own and the replies are rolled up as they arrive.
+ * All of the rollup happens in the progress thread - a worker only
+ * fills its own payload and then threadshifts back - so the fan-out
+ * itself needs no lock. If a deadline is set, whatever has arrived
+ * when it expires is reported and later replies are dropped */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_timer_t timer;
+    pmix_status_t status;
+    int requests;
+    int replies;
+    bool done;
+    pmix_list_t payload;    // list of pmix_kval_t
+    pmix_info_t *directives;
+    size_t ndirs;
+    pmix_inventory_cbfunc_t cbfunc;
+    void *cbdata;
+} pnet_inv_fanout_t;
+static void fancon(pnet_inv_fanout_t *p)
 {
-    pmix_inventory_rollup_t *rollup = (pmix_inventory_rollup_t*)cbdata;
+    memset(&p->timer, 0, sizeof(p->timer));
+    p->status = PMIX_SUCCESS;
+    p->requests = 0;
+    p->replies = 0;
+    p->done = false;
+    PMIX_CONSTRUCT(&p->payload, pmix_list_t);
+    p->directives = NULL;
+    p->ndirs = 0;
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void fandes(pnet_inv_fanout_t *p)
+{
+    PMIX_LIST_DESTRUCT(&p->payload);
+    if (NULL != p->directives) {
+        PMIX_INFO_FREE(p->directives, p->ndirs);
+    }
+}
+static PMIX_CLASS_INSTANCE(pnet_inv_fanout_t,
+                           pmix_object_t,
+                           fancon, fandes);
+
+typedef struct {
+    pmix_list_item_t super;
+    pmix_event_t ev;
+    pmix_thread_t thread;
+    pnet_inv_fanout_t *fan;
+    pmix_pnet_base_active_module_t *active;
+    pmix_inventory_rollup_t *rollup;    // what the component is given
+    pmix_status_t status;
+} pnet_inv_worker_t;
+static void wkcon(pnet_inv_worker_t *p)
+{
+    /* drain may delete an event that was never shifted */
+    memset(&p->ev, 0, sizeof(p->ev));
+    PMIX_CONSTRUCT(&p->thread, pmix_thread_t);
+    p->fan = NULL;
+    p->active = NULL;
+    p->rollup = NULL;
+    p->status = PMIX_SUCCESS;
+}
+static void wkdes(pnet_inv_worker_t *p)
+{
+    PMIX_DESTRUCT(&p->thread);
+    if (NULL != p->fan) {
+        PMIX_RELEASE(p->fan);
+    }
+    if (NULL != p->active) {
+        PMIX_RELEASE(p->active);
+    }
+    if (NULL != p->rollup) {
+        PMIX_RELEASE(p->rollup);
+    }
+}
+static PMIX_CLASS_INSTANCE(pnet_inv_worker_t,
+                           pmix_list_item_t,
+                           wkcon, wkdes);
+
+/* answer the caller and drop the reference held for doing so */
+static void fan_complete(pnet_inv_fanout_t *fan)
+{
+    fan->done = true;
+    if (NULL != fan->timer.prev) {
+        pmix_timer_del(&fan->timer);
+        PMIX_RELEASE(fan);
+    }
+    if (NULL != fan->cbfunc) {
+        fan->cbfunc(fan->status, &fan->payload, fan->cbdata);
+    }
+    PMIX_RELEASE(fan);
+}
+
+static void fan_timeout(int sd, short args, void *cbdata)
+{
+    pnet_inv_fanout_t *fan = (pnet_inv_fanout_t*)cbdata;
+
+    pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
+                        "pnet:collect_inventory deadline reached with %d of %d components reporting",
+                        fan->replies, fan->requests);
+    fan_complete(fan);
+    /* the timer's own reference */
+    PMIX_RELEASE(fan);
+}
+
+/* back in the progress thread with a component's inventory */
+static void wkr_done(int sd, short args, void *cbdata)
+{
+    pnet_inv_worker_t *wkr = (pnet_inv_worker_t*)cbdata;
+    pnet_inv_fanout_t *fan = wkr->fan;
     pmix_kval_t *kv;
 
-    PMIX_ACQUIRE_THREAD(&rollup->lock);
-    /* check if they had an error */
-    if (PMIX_SUCCESS != status && PMIX_SUCCESS == rollup->status) {
-        rollup->status = status;
+    PMIX_ACQUIRE_OBJECT(wkr);
+    pmix_thread_join(&wkr->thread, NULL);
+    pmix_list_remove_item(&pmix_pnet_globals.inv_workers, &wkr->super);
+
+    if (fan->done) {
+        /* too late - the caller has already been answered */
+        pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
+                            "pnet:collect_inventory %s reported after the deadline",
+                            wkr->active->module->name);
+        PMIX_RELEASE(wkr);
+        return;
+    }
+    while (NULL != (kv = (pmix_kval_t*)pmix_list_remove_first(&wkr->rollup->payload))) {
+        pmix_list_append(&fan->payload, &kv->super);
     }
-    /* transfer the inventory */
+    if (PMIX_SUCCESS != wkr->status && PMIX_SUCCESS == fan->status) {
+        fan->status = wkr->status;
+    }
+    fan->replies++;
+    PMIX_RELEASE(wkr);
+    if (fan->replies == fan->requests) {
+        fan_complete(fan);
+    }
+}
+
+/* a component that answered "in progress" reports here, from
+ * whatever thread it finished on */
+static void wkr_cbfunc(pmix_status_t status,
+                       pmix_list_t *inventory,
+                       void *cbdata)
+{
+    pmix_inventory_rollup_t *rollup = (pmix_inventory_rollup_t*)cbdata;
+    pnet_inv_worker_t *wkr = (pnet_inv_worker_t*)rollup->cbdata;
+    pmix_kval_t *kv;
+
     if (NULL != inventory) {
         while (NULL != (kv = (pmix_kval_t*)pmix_list_remove_first(inventory))) {
             pmix_list_append(&rollup->payload, &kv->super);
         }
     }
-    /* record that we got a reply */
-    rollup->replies++;
-    /* see if all have replied */
-    if (rollup->replies < rollup->requests) {
-        /* nope - need to wait */
-        PMIX_RELEASE_THREAD(&rollup->lock);
-        return;
-    }
+    wkr->status = status;
+    PMIX_THREADSHIFT(wkr, wkr_done);
+}
 
-    /* if we get here, then collection is complete */
-    PMIX_RELEASE_THREAD(&rollup->lock);
-    if (NULL != rollup->cbfunc) {
-        rollup->cbfunc(rollup->status, &rollup->payload, rollup->cbdata);
-    }
-    PMIX_RELEASE(rollup);
-    return;
+static void* wkr_run(pmix_object_t *obj)
+{
+    pmix_thread_t *t = (pmix_thread_t*)obj;
+    pnet_inv_worker_t *wkr = (pnet_inv_worker_t*)t->t_arg;
+    pnet_inv_fanout_t *fan = wkr->fan;
+    pmix_status_t rc;
+
+    pmix_output_verbose(5, pmix_pnet_base_framework.framework_output,
+                        "COLLECTING %s", wkr->active->module->name);
+    pmix_mutex_lock(&wkr->active->invlock);
+    rc = wkr->active->module->collect_inventory(fan->directives, fan->ndirs,
+                                                wkr_cbfunc, (void*)wkr->rollup);
+    pmix_mutex_unlock(&wkr->active->invlock);
+    if (PMIX_OPERATION_IN_PROGRESS == rc) {
+        /* the component will report through wkr_cbfunc */
+        return NULL;
+    }
+    /* if they return success, then the values were
+     * placed directly on the payload */
+    if (PMIX_SUCCESS != rc &&
+        PMIX_ERR_TAKE_NEXT_OPTION != rc &&
+        PMIX_ERR_NOT_SUPPORTED != rc) {
+        wkr->status = rc;
+    }
+    PMIX_THREADSHIFT(wkr, wkr_done);
+    return NULL;
 }
 
 void pmix_pnet_base_collect_inventory(pmix_info_t directives[], size_t ndirs,
                                       pmix_inventory_cbfunc_t cbfunc, void *cbdata)
 {
     pmix_pnet_base_active_module_t *active;
-    pmix_inventory_rollup_t *myrollup;
-    pmix_status_t rc;
-
-    /* we cannot block here as each plugin could take some time to
-     * complete the request. So instead, we call each active plugin
-     * and get their immediate response - if "in progress", then
-     * we record that we have to wait for their answer before providing
-     * the caller with a response. If "error", then we know we
-     * won't be getting a response from them */
+    pnet_inv_fanout_t *fan;
+    pnet_inv_worker_t *wkr;
+    struct timeval tv = {0, 0};
+    size_t n;
 
     if (!pmix_pnet_globals.initialized) {
         /* need to call them back so they know */
@@ -386,57 +551,85 @@ void pmix_pnet_base_collect_inventory(pmix_info_t directives[], size_t ndirs,
         }
         return;
     }
-    /* create the rollup object */
-    myrollup = PMIX_NEW(pmix_inventory_rollup_t);
-    if (NULL == myrollup) {
+    /* create the fan-out tracker */
+    fan = PMIX_NEW(pnet_inv_fanout_t);
+    if (NULL == fan) {
         /* need to call them back so they know */
         if (NULL != cbfunc) {
             cbfunc(PMIX_ERR_NOMEM, NULL, cbdata);
         }
         return;
     }
-    myrollup->cbfunc = cbfunc;
-    myrollup->cbdata = cbdata;
-
-    /* hold the lock until all active modules have been called
-     * to avoid race condition where replies come in before
-     * the requests counter has been fully updated */
-    PMIX_ACQUIRE_THREAD(&myrollup->lock);
+    fan->cbfunc = cbfunc;
+    fan->cbdata = cbdata;
+    tv.tv_sec = pmix_pnet_globals.inventory_timeout;
+    /* the workers may outlive the caller's directives */
+    if (0 < ndirs) {
+        fan->ndirs = ndirs;
+        PMIX_INFO_CREATE(fan->directives, fan->ndirs);
+        for (n=0; n < ndirs; n++) {
+            PMIX_INFO_XFER(&fan->directives[n], &directives[n]);
+            if (PMIX_CHECK_KEY(&directives[n], PMIX_TIMEOUT)) {
+                tv.tv_sec = directives[n].value.data.integer;
+            }
+        }
+    }
 
     PMIX_LIST_FOREACH(active, &pmix_pnet_globals.actives, pmix_pnet_base_active_module_t) {
-        if (NULL != active->module->collect_inventory) {
-            pmix_output_verbose(5, pmix_pnet_base_framework.framework_output,
-                                "COLLECTING %s", active->module->name);
-            rc = active->module->collect_inventory(directives, ndirs, cicbfunc, (void*)myrollup);
-            /* if they return success, then the values were
-             * placed directly on the payload - nothing
-             * to wait for here */
-            if (PMIX_OPERATION_IN_PROGRESS == rc) {
-                myrollup->requests++;
-            } else if (PMIX_SUCCESS != rc &&
-                       PMIX_ERR_TAKE_NEXT_OPTION != rc &&
-                       PMIX_ERR_NOT_SUPPORTED != rc) {
-                /* a true error - we need to wait for
-                 * all pending requests to complete
-                 * and then notify the caller of the error */
-                if (PMIX_SUCCESS == myrollup->status) {
-                    myrollup->status = rc;
-                }
+        if (NULL == active->module->collect_inventory) {
+            continue;
+        }
+        wkr = PMIX_NEW(pnet_inv_worker_t);
+        wkr->rollup = PMIX_NEW(pmix_inventory_rollup_t);
+        wkr->rollup->cbdata = wkr;
+        PMIX_RETAIN(active);
+        wkr->active = active;
+        PMIX_RETAIN(fan);
+        wkr->fan = fan;
+        wkr->thread.t_run = wkr_run;
+        wkr->thread.t_arg = wkr;
+        fan->requests++;
+        PMIX_POST_OBJECT(wkr);
+        if (PMIX_SUCCESS != pmix_thread_start(&wkr->thread)) {
+            /* nothing to join - treat it as a component error */
+            fan->requests--;
+            if (PMIX_SUCCESS == fan->status) {
+                fan->status = PMIX_ERR_OUT_OF_RESOURCE;
             }
+            PMIX_RELEASE(wkr);
+            continue;
         }
+        /* tracked until wkr_done joins it */
+        pmix_list_append(&pmix_pnet_globals.inv_workers, &wkr->super);
     }
-    if (0 == myrollup->requests) {
+    if (0 == fan->requests) {
         /* report back */
-        PMIX_RELEASE_THREAD(&myrollup->lock);
-        if (NULL != cbfunc) {
-            cbfunc(myrollup->status, &myrollup->payload, cbdata);
-        }
-        PMIX_RELEASE(myrollup);
+        fan_complete(fan);
         return;
     }
+    if (0 < tv.tv_sec) {
+        /* the timer holds its own reference */
+        PMIX_RETAIN(fan);
+        pmix_timer_add(&fan->timer, fan_timeout, fan, &tv);
+    }
+}
 
-    PMIX_RELEASE_THREAD(&myrollup->lock);
-    return;
+/* called at close with the progress thread stopped, so no wkr_done
+ * can run concurrently. Workers that missed their deadline may still
+ * be inside a component - wait for each one to leave it, then drop
+ * any completion it already shifted to the progress thread */
+void pmix_pnet_base_inventory_drain(void)
+{
+    pnet_inv_worker_t *wkr;
+
+    while (NULL != (wkr = (pnet_inv_worker_t*)pmix_list_remove_first(&pmix_pnet_globals.inv_workers))) {
+        pmix_thread_join(&wkr->thread, NULL);
+        PMIX_ACQUIRE_OBJECT(wkr);
+        if (NULL != wkr->ev.ev_base) {
+            pmix_event_del(&wkr->ev);
+        }
+        PMIX_RELEASE(wkr);
+    }
 }
 
 static void dlcbfunc(pmix_status_t status,
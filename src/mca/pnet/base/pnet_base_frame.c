@@ -52,10 +52,27 @@ pmix_pnet_API_module_t pmix_pnet = {
     .child_finalized = pmix_pnet_base_child_finalized,
     .local_app_finalized = pmix_pnet_base_local_app_finalized,
     .deregister_nspace = pmix_pnet_base_deregister_nspace,
+    .register_endpoints = pmix_pnet_base_register_endpoints,
     .collect_inventory = pmix_pnet_base_collect_inventory,
     .deliver_inventory = pmix_pnet_base_deliver_inventory
 };
 
+static int pmix_pnet_register(pmix_mca_base_register_flag_t flags)
+{
+    pmix_pnet_globals.inventory_timeout = 0;
+    pmix_mca_base_var_register("pmix", "pnet", "base", "inventory_timeout",
+                               "Seconds to wait for the components to collect inventory - "
+                               "whatever has arrived by then is reported (0 = no limit)",
+                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                               PMIX_INFO_LVL_5,
+                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                               &pmix_pnet_globals.inventory_timeout);
+    if (0 > pmix_pnet_globals.inventory_timeout) {
+        pmix_pnet_globals.inventory_timeout = 0;
+    }
+    return PMIX_SUCCESS;
+}
+
 static pmix_status_t pmix_pnet_close(void)
 {
   pmix_pnet_base_active_module_t *active, *prev;
@@ -65,6 +82,11 @@ static pmix_status_t pmix_pnet_close(void)
     }
     pmix_pnet_globals.initialized = false;
 
+    /* no component may be finalized while a worker is still
+     * collecting inventory from it */
+    pmix_pnet_base_inventory_drain();
+    PMIX_DESTRUCT(&pmix_pnet_globals.inv_workers);
+
     PMIX_LIST_FOREACH_SAFE(active, prev, &pmix_pnet_globals.actives, pmix_pnet_base_active_module_t) {
       pmix_list_remove_item(&pmix_pnet_globals.actives, &active->super);
       if (NULL != active->module->finalize) {
@@ -90,18 +112,27 @@ static pmix_status_t pmix_pnet_open(pmix_mca_base_open_flag_t flags)
     PMIX_CONSTRUCT(&pmix_pnet_globals.actives, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_pnet_globals.jobs, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_pnet_globals.nodes, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_pnet_globals.inv_workers, pmix_list_t);
 
     /* Open up all available components */
     return pmix_mca_base_framework_components_open(&pmix_pnet_base_framework, flags);
 }
 
 PMIX_MCA_BASE_FRAMEWORK_DECLARE(pmix, pnet, "PMIx Network Operations",
-                                NULL, pmix_pnet_open, pmix_pnet_close,
+                                pmix_pnet_register, pmix_pnet_open, pmix_pnet_close,
                                 mca_pnet_base_static_components, 0);
 
+static void amcon(pmix_pnet_base_active_module_t *p)
+{
+    PMIX_CONSTRUCT(&p->invlock, pmix_mutex_t);
+}
+static void amdes(pmix_pnet_base_active_module_t *p)
+{
+    PMIX_DESTRUCT(&p->invlock);
+}
 PMIX_CLASS_INSTANCE(pmix_pnet_base_active_module_t,
                     pmix_list_item_t,
-                    NULL, NULL);
+                    amcon, amdes);
 
 static void lpcon(pmix_pnet_local_procs_t *p)
 {
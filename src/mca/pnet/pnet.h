@@ -98,6 +98,19 @@ typedef void (*pmix_pnet_base_module_local_app_finalized_fn_t)(pmix_namespace_t
  */
 typedef void (*pmix_pnet_base_module_dregister_nspace_fn_t)(pmix_namespace_t *nptr);
 
+/**
+ * Give the fabric components an opportunity to publish the endpoint
+ * each proc of a job will use, as worked out from the resources they
+ * assigned to it, when the nspace is registered. The endpoints are
+ * cached as job-level data for the individual procs, so the procs can
+ * find their peers with a local Get rather than exchanging endpoints
+ * in a fence. The info array is the one given to register_nspace.
+ * Return PMIX_ERR_TAKE_NEXT_OPTION if there is nothing to publish
+ */
+typedef pmix_status_t (*pmix_pnet_base_module_register_endpts_fn_t)(pmix_namespace_t *nptr,
+                                                                    pmix_info_t info[],
+                                                                    size_t ninfo);
+
 
 /**
  * Request that the module report local inventory for its network type.
@@ -160,6 +173,7 @@ typedef struct {
     pmix_pnet_base_module_child_finalized_fn_t      child_finalized;
     pmix_pnet_base_module_local_app_finalized_fn_t  local_app_finalized;
     pmix_pnet_base_module_dregister_nspace_fn_t     deregister_nspace;
+    pmix_pnet_base_module_register_endpts_fn_t      register_endpoints;
     pmix_pnet_base_module_collect_inventory_fn_t    collect_inventory;
     pmix_pnet_base_module_deliver_inventory_fn_t    deliver_inventory;
 } pmix_pnet_module_t;
@@ -178,6 +192,9 @@ typedef pmix_status_t (*pmix_pnet_base_API_setup_local_net_fn_t)(char *nspace,
 typedef pmix_status_t (*pmix_pnet_base_API_setup_fork_fn_t)(const pmix_proc_t *peer, char ***env);
 
 typedef void (*pmix_pnet_base_API_deregister_nspace_fn_t)(char *nspace);
+typedef pmix_status_t (*pmix_pnet_base_API_register_endpts_fn_t)(char *nspace,
+                                                                 pmix_info_t info[],
+                                                                 size_t ninfo);
 typedef void (*pmix_pnet_base_API_collect_inventory_fn_t)(pmix_info_t directives[], size_t ndirs,
                                                           pmix_inventory_cbfunc_t cbfunc,
                                                           void *cbdata);
@@ -199,6 +216,7 @@ typedef struct {
     pmix_pnet_base_module_child_finalized_fn_t      child_finalized;
     pmix_pnet_base_module_local_app_finalized_fn_t  local_app_finalized;
     pmix_pnet_base_API_deregister_nspace_fn_t       deregister_nspace;
+    pmix_pnet_base_API_register_endpts_fn_t         register_endpoints;
     pmix_pnet_base_API_collect_inventory_fn_t       collect_inventory;
     pmix_pnet_base_API_deliver_inventory_fn_t       deliver_inventory;
 } pmix_pnet_API_module_t;
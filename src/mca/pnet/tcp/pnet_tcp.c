@@ -31,9 +31,12 @@
 
 #include "src/include/pmix_socket_errno.h"
 #include "src/include/pmix_globals.h"
+#include "src/class/pmix_bitmap.h"
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/util/alfg.h"
 #include "src/util/argv.h"
+#include "src/util/crc.h"
 #include "src/util/error.h"
 #include "src/util/output.h"
 #include "src/util/parse_options.h"
@@ -60,6 +63,8 @@ static pmix_status_t setup_fork(pmix_namespace_t *nptr,
 static void child_finalized(pmix_proc_t *peer);
 static void local_app_finalized(pmix_namespace_t *nptr);
 static void deregister_nspace(pmix_namespace_t *nptr);
+static pmix_status_t register_endpoints(pmix_namespace_t *nptr,
+                                        pmix_info_t info[], size_t ninfo);
 static pmix_status_t collect_inventory(pmix_info_t directives[], size_t ndirs,
                                        pmix_inventory_cbfunc_t cbfunc, void *cbdata);
 static pmix_status_t deliver_inventory(pmix_info_t info[], size_t ninfo,
@@ -76,6 +81,7 @@ pmix_pnet_module_t pmix_tcp_module = {
     .child_finalized = child_finalized,
     .local_app_finalized = local_app_finalized,
     .deregister_nspace = deregister_nspace,
+    .register_endpoints = register_endpoints,
     .collect_inventory = collect_inventory,
     .deliver_inventory = deliver_inventory
 };
@@ -94,16 +100,73 @@ typedef struct {
     char *plane;
     char **ports;
     size_t nports;
+    pmix_bitmap_t inuse;        // ports handed out, by index into ports
+    size_t nfree;
+    uint32_t generation;        // of the inventory it was delivered in
 } tcp_available_ports_t;
 
 typedef struct {
     pmix_list_item_t super;
-    char *nspace;
-    char **ports;
+    int *ports;                 // indices into src->ports
+    int nports;
     tcp_available_ports_t *src;  // source of the allocated ports
 } tcp_port_tracker_t;
 
-static pmix_list_t allocations, available;
+/* what is needed to work out the endpoints of a job's procs - the
+ * ports come from setup_local_network and the maps from the nspace
+ * registration, in whichever order the host calls them */
+typedef struct {
+    pmix_list_item_t super;
+    char *nspace;
+    char **ports;               // the ports each node hands out, by local rank
+    char *nodes;                // node map regex
+    char *procs;                // proc map regex
+} tcp_job_endpts_t;
+static void jecon(tcp_job_endpts_t *p)
+{
+    p->nspace = NULL;
+    p->ports = NULL;
+    p->nodes = NULL;
+    p->procs = NULL;
+}
+static void jedes(tcp_job_endpts_t *p)
+{
+    if (NULL != p->nspace) {
+        free(p->nspace);
+    }
+    if (NULL != p->ports) {
+        pmix_argv_free(p->ports);
+    }
+    if (NULL != p->nodes) {
+        free(p->nodes);
+    }
+    if (NULL != p->procs) {
+        free(p->procs);
+    }
+}
+static PMIX_CLASS_INSTANCE(tcp_job_endpts_t,
+                           pmix_list_item_t,
+                           jecon, jedes);
+
+/* endpoints waiting on the other half of their description */
+static pmix_list_t pending_endpts;
+
+/* allocations holds a pmix_list_t of port trackers per nspace */
+static pmix_hash_table_t allocations;
+static pmix_list_t available;
+
+/* the packed device units of our own inventory. The interface
+ * list is read once, when the pif framework opens, so they are
+ * packed on the first collection and reused after that. Their crc
+ * is the generation that lets the receiver skip an inventory it
+ * already holds */
+static pmix_buffer_t inventory;
+static uint32_t inventory_gen = 0;
+static bool inventory_sent = false;
+static pmix_status_t assign_ports(pmix_namespace_t *nptr,
+                                  tcp_available_ports_t *avail,
+                                  char *idkey, int ports_per_node,
+                                  pmix_list_t *ilist);
 static pmix_status_t process_request(pmix_namespace_t *nptr,
                                      char *idkey, int ports_per_node,
                                      tcp_port_tracker_t *trk,
@@ -134,6 +197,9 @@ static void tacon(tcp_available_ports_t *p)
     p->plane = NULL;
     p->ports = NULL;
     p->nports = 0;
+    PMIX_CONSTRUCT(&p->inuse, pmix_bitmap_t);
+    p->nfree = 0;
+    p->generation = 0;
 }
 static void tades(tcp_available_ports_t *p)
 {
@@ -147,6 +213,7 @@ static void tades(tcp_available_ports_t *p)
     if (NULL != p->ports) {
         pmix_argv_free(p->ports);
     }
+    PMIX_DESTRUCT(&p->inuse);
 }
 static PMIX_CLASS_INSTANCE(tcp_available_ports_t,
                            pmix_list_item_t,
@@ -154,35 +221,24 @@ static PMIX_CLASS_INSTANCE(tcp_available_ports_t,
 
 static void ttcon(tcp_port_tracker_t *p)
 {
-    p->nspace = NULL;
     p->ports = NULL;
+    p->nports = 0;
     p->src = NULL;
 }
 static void ttdes(tcp_port_tracker_t *p)
 {
-    size_t n, m, mstart;
+    int n;
 
-    if (NULL != p->nspace) {
-        free(p->nspace);
-    }
     if (NULL != p->src) {
-        if (NULL != p->ports) {
-            mstart = 0;
-            for (n=0; NULL != p->ports[n]; n++) {
-                /* find an empty position */
-                for (m=mstart; m < p->src->nports; m++) {
-                    if (NULL == p->src->ports[m]) {
-                        p->src->ports[m] = strdup(p->ports[n]);
-                        mstart = m + 1;
-                        break;
-                    }
-                }
-            }
-            pmix_argv_free(p->ports);
+        /* return the ports to the pool */
+        for (n=0; n < p->nports; n++) {
+            pmix_bitmap_clear_bit(&p->src->inuse, p->ports[n]);
         }
+        p->src->nfree += p->nports;
         PMIX_RELEASE(p->src);  // maintain accounting
-    } else if (NULL != p->ports) {
-        pmix_argv_free(p->ports);
+    }
+    if (NULL != p->ports) {
+        free(p->ports);
     }
 }
 static PMIX_CLASS_INSTANCE(tcp_port_tracker_t,
@@ -198,13 +254,17 @@ static pmix_status_t tcp_init(void)
     pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
                         "pnet: tcp init");
 
+    PMIX_CONSTRUCT(&inventory, pmix_buffer_t);
+    PMIX_CONSTRUCT(&pending_endpts, pmix_list_t);
+
     /* if we are not the "gateway", then there is nothing
      * for us to do */
     if (!PMIX_PROC_IS_GATEWAY(pmix_globals.mypeer)) {
         return PMIX_SUCCESS;
     }
 
-    PMIX_CONSTRUCT(&allocations, pmix_list_t);
+    PMIX_CONSTRUCT(&allocations, pmix_hash_table_t);
+    pmix_hash_table_init(&allocations, 256);
     PMIX_CONSTRUCT(&available, pmix_list_t);
 
     /* if we have no static ports, then we don't have
@@ -235,6 +295,8 @@ static pmix_status_t tcp_init(void)
         ++p;
         pmix_util_parse_range_options(p, &trk->ports);
         trk->nports = pmix_argv_count(trk->ports);
+        pmix_bitmap_init(&trk->inuse, trk->nports);
+        trk->nfree = trk->nports;
         /* see if they provided a plane */
         if (NULL != (p = strchr(grps[n], ':'))) {
             /* yep - save the plane */
@@ -256,10 +318,26 @@ static pmix_status_t tcp_init(void)
 
 static void tcp_finalize(void)
 {
+    pmix_list_t *jobs;
+    void *key, *node;
+    size_t keysize;
+    int rc;
+
     pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
                         "pnet: tcp finalize");
+    PMIX_DESTRUCT(&inventory);
+    inventory_gen = 0;
+    inventory_sent = false;
+    PMIX_LIST_DESTRUCT(&pending_endpts);
     if (PMIX_PROC_IS_GATEWAY(pmix_globals.mypeer)) {
-        PMIX_LIST_DESTRUCT(&allocations);
+        rc = pmix_hash_table_get_first_key_ptr(&allocations, &key, &keysize,
+                                               (void**)&jobs, &node);
+        while (PMIX_SUCCESS == rc) {
+            PMIX_LIST_RELEASE(jobs);
+            rc = pmix_hash_table_get_next_key_ptr(&allocations, &key, &keysize,
+                                                  (void**)&jobs, node, &node);
+        }
+        PMIX_DESTRUCT(&allocations);
         PMIX_LIST_DESTRUCT(&available);
     }
 }
@@ -309,7 +387,6 @@ static pmix_status_t allocate(pmix_namespace_t *nptr,
     pmix_info_t *requests = NULL;
     char **reqs, *cptr;
     bool allocated = false, seckey = false;
-    tcp_port_tracker_t *trk;
     tcp_available_ports_t *avail, *aptr;
     pmix_list_t mylist;
     pmix_buffer_t buf;
@@ -452,21 +529,8 @@ static pmix_status_t allocate(pmix_namespace_t *nptr,
                 PMIX_LIST_DESTRUCT(&mylist);
                 return PMIX_ERR_NOT_AVAILABLE;
             }
-            /* setup to track the assignment */
-            trk = PMIX_NEW(tcp_port_tracker_t);
-            if (NULL == trk) {
-                PMIX_LIST_DESTRUCT(&mylist);
-                return PMIX_ERR_NOMEM;
-            }
-            trk->nspace = strdup(nptr->nspace);
-            PMIX_RETAIN(avail);
-            trk->src = avail;
-            pmix_list_append(&allocations, &trk->super);
-            rc = process_request(nptr, idkey, ports_per_node, trk, &mylist);
+            rc = assign_ports(nptr, avail, idkey, ports_per_node, &mylist);
             if (PMIX_SUCCESS != rc) {
-                /* return the allocated ports */
-                pmix_list_remove_item(&allocations, &trk->super);
-                PMIX_RELEASE(trk);
                 PMIX_LIST_DESTRUCT(&mylist);
                 return rc;
             }
@@ -493,21 +557,8 @@ static pmix_status_t allocate(pmix_namespace_t *nptr,
                 PMIX_LIST_DESTRUCT(&mylist);
                 return PMIX_ERR_NOT_AVAILABLE;
             }
-            /* setup to track the assignment */
-            trk = PMIX_NEW(tcp_port_tracker_t);
-            if (NULL == trk) {
-                PMIX_LIST_DESTRUCT(&mylist);
-                return PMIX_ERR_NOMEM;
-            }
-            trk->nspace = strdup(nptr->nspace);
-            PMIX_RETAIN(avail);
-            trk->src = avail;
-            pmix_list_append(&allocations, &trk->super);
-            rc = process_request(nptr, idkey, ports_per_node, trk, &mylist);
+            rc = assign_ports(nptr, avail, idkey, ports_per_node, &mylist);
             if (PMIX_SUCCESS != rc) {
-                /* return the allocated ports */
-                pmix_list_remove_item(&allocations, &trk->super);
-                PMIX_RELEASE(trk);
                 PMIX_LIST_DESTRUCT(&mylist);
                 return rc;
             }
@@ -529,21 +580,8 @@ static pmix_status_t allocate(pmix_namespace_t *nptr,
                 if (0 != strcmp(aptr->plane, plane)) {
                     continue;
                 }
-                /* setup to track the assignment */
-                trk = PMIX_NEW(tcp_port_tracker_t);
-                if (NULL == trk) {
-                    PMIX_LIST_DESTRUCT(&mylist);
-                    return PMIX_ERR_NOMEM;
-                }
-                trk->nspace = strdup(nptr->nspace);
-                PMIX_RETAIN(aptr);
-                trk->src = aptr;
-                pmix_list_append(&allocations, &trk->super);
-                rc = process_request(nptr, idkey, ports_per_node, trk, &mylist);
+                rc = assign_ports(nptr, aptr, idkey, ports_per_node, &mylist);
                 if (PMIX_SUCCESS != rc) {
-                    /* return the allocated ports */
-                    pmix_list_remove_item(&allocations, &trk->super);
-                    PMIX_RELEASE(trk);
                     PMIX_LIST_DESTRUCT(&mylist);
                     return rc;
                 }
@@ -594,27 +632,15 @@ static pmix_status_t allocate(pmix_namespace_t *nptr,
                             continue;
                         }
                     }
-                    /* setup to track the assignment */
-                    trk = PMIX_NEW(tcp_port_tracker_t);
-                    if (NULL == trk) {
-                        pmix_argv_free(reqs);
-                        PMIX_LIST_DESTRUCT(&mylist);
-                        return PMIX_ERR_NOMEM;
-                    }
-                    trk->nspace = strdup(nptr->nspace);
-                    PMIX_RETAIN(avail);
-                    trk->src = avail;
-                    pmix_list_append(&allocations, &trk->super);
-                    rc = process_request(nptr, idkey, ports_per_node, trk, &mylist);
+                    rc = assign_ports(nptr, avail, idkey, ports_per_node, &mylist);
                     if (PMIX_SUCCESS != rc) {
-                        /* return the allocated ports */
-                        pmix_list_remove_item(&allocations, &trk->super);
-                        PMIX_RELEASE(trk);
+                        pmix_argv_free(reqs);
                         PMIX_LIST_DESTRUCT(&mylist);
                         return rc;
                     }
                     allocated = true;
                 }
+                pmix_argv_free(reqs);
             } else {
                 pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
                                     "pnet:tcp:allocate allocating %d ports/node for nspace %s",
@@ -626,22 +652,8 @@ static pmix_status_t allocate(pmix_namespace_t *nptr,
                 }
                 avail = (tcp_available_ports_t*)pmix_list_get_first(&available);
                 if (NULL != avail) {
-                    /* setup to track the assignment */
-                    trk = PMIX_NEW(tcp_port_tracker_t);
-                    if (NULL == trk) {
-                        PMIX_LIST_DESTRUCT(&mylist);
-                        return PMIX_ERR_NOMEM;
-                    }
-                    trk->nspace = strdup(nptr->nspace);
-                    PMIX_RETAIN(avail);
-                    trk->src = avail;
-                    pmix_list_append(&allocations, &trk->super);
-                    rc = process_request(nptr, idkey, ports_per_node, trk, &mylist);
-                    if (PMIX_SUCCESS != rc) {
-                        /* return the allocated ports */
-                        pmix_list_remove_item(&allocations, &trk->super);
-                        PMIX_RELEASE(trk);
-                    } else {
+                    rc = assign_ports(nptr, avail, idkey, ports_per_node, &mylist);
+                    if (PMIX_SUCCESS == rc) {
                         allocated = true;
                     }
                 }
@@ -718,6 +730,157 @@ static pmix_status_t allocate(pmix_namespace_t *nptr,
     return PMIX_SUCCESS;
 }
 
+static tcp_job_endpts_t* get_endpts(char *nspace)
+{
+    tcp_job_endpts_t *je;
+
+    PMIX_LIST_FOREACH(je, &pending_endpts, tcp_job_endpts_t) {
+        if (0 == strcmp(je->nspace, nspace)) {
+            return je;
+        }
+    }
+    je = PMIX_NEW(tcp_job_endpts_t);
+    je->nspace = strdup(nspace);
+    pmix_list_append(&pending_endpts, &je->super);
+    return je;
+}
+
+/* each proc gets the port at its local rank on its node - procs
+ * beyond the number of ports get no endpoint and have to exchange
+ * theirs as usual */
+static pmix_status_t publish_endpts(pmix_namespace_t *nptr, tcp_job_endpts_t *je)
+{
+    char **nodes = NULL, **procs = NULL, **ranks, *endpt;
+    pmix_info_t *pinfo, *iptr;
+    size_t n, l, nports, npinfo = 0, cnt = 0;
+    pmix_rank_t rank;
+    pmix_status_t rc;
+
+    if (PMIX_SUCCESS != (rc = pmix_preg.parse_nodes(je->nodes, &nodes))) {
+        return rc;
+    }
+    if (PMIX_SUCCESS != (rc = pmix_preg.parse_procs(je->procs, &procs))) {
+        pmix_argv_free(nodes);
+        return rc;
+    }
+    if (pmix_argv_count(nodes) != pmix_argv_count(procs)) {
+        pmix_argv_free(nodes);
+        pmix_argv_free(procs);
+        return PMIX_ERR_BAD_PARAM;
+    }
+    nports = pmix_argv_count(je->ports);
+    for (n=0; NULL != procs[n]; n++) {
+        ranks = pmix_argv_split(procs[n], ',');
+        l = pmix_argv_count(ranks);
+        cnt += (l < nports) ? l : nports;
+        pmix_argv_free(ranks);
+    }
+    if (0 == cnt) {
+        pmix_argv_free(nodes);
+        pmix_argv_free(procs);
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    PMIX_INFO_CREATE(pinfo, cnt);
+    for (n=0; NULL != procs[n]; n++) {
+        ranks = pmix_argv_split(procs[n], ',');
+        for (l=0; NULL != ranks[l] && l < nports; l++) {
+            if (0 > asprintf(&endpt, "%s:%s", nodes[n], je->ports[l])) {
+                pmix_argv_free(ranks);
+                rc = PMIX_ERR_NOMEM;
+                goto done;
+            }
+            rank = strtoul(ranks[l], NULL, 10);
+            PMIX_INFO_CREATE(iptr, 2);
+            PMIX_INFO_LOAD(&iptr[0], PMIX_RANK, &rank, PMIX_PROC_RANK);
+            PMIX_INFO_LOAD(&iptr[1], PMIX_NETWORK_ENDPT, endpt, PMIX_STRING);
+            free(endpt);
+            pmix_strncpy(pinfo[npinfo].key, PMIX_PROC_DATA, PMIX_MAX_KEYLEN);
+            pinfo[npinfo].value.type = PMIX_DATA_ARRAY;
+            PMIX_DATA_ARRAY_CREATE(pinfo[npinfo].value.data.darray, 2, PMIX_INFO);
+            pinfo[npinfo].value.data.darray->array = iptr;
+            ++npinfo;
+        }
+        pmix_argv_free(ranks);
+    }
+
+    pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
+                        "pnet:tcp publishing %lu endpoints for nspace %s",
+                        (unsigned long)npinfo, nptr->nspace);
+    PMIX_GDS_CACHE_JOB_INFO(rc, pmix_globals.mypeer, nptr, pinfo, npinfo);
+
+  done:
+    PMIX_INFO_FREE(pinfo, cnt);
+    pmix_argv_free(nodes);
+    pmix_argv_free(procs);
+    return rc;
+}
+
+static pmix_status_t endpts_from_ports(pmix_namespace_t *nptr, char *ports)
+{
+    tcp_job_endpts_t *je;
+    pmix_status_t rc;
+
+    je = get_endpts(nptr->nspace);
+    if (NULL != je->ports) {
+        pmix_argv_free(je->ports);
+    }
+    je->ports = pmix_argv_split(ports, ',');
+    if (NULL == je->nodes || NULL == je->procs) {
+        /* wait for the nspace to be registered */
+        return PMIX_SUCCESS;
+    }
+    rc = publish_endpts(nptr, je);
+    pmix_list_remove_item(&pending_endpts, &je->super);
+    PMIX_RELEASE(je);
+    if (PMIX_ERR_TAKE_NEXT_OPTION == rc) {
+        rc = PMIX_SUCCESS;
+    }
+    return rc;
+}
+
+static pmix_status_t register_endpoints(pmix_namespace_t *nptr,
+                                        pmix_info_t info[], size_t ninfo)
+{
+    tcp_job_endpts_t *je;
+    char *nodes = NULL, *procs = NULL;
+    pmix_status_t rc;
+    size_t n;
+
+    pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
+                        "pnet:tcp:register_endpoints for nspace %s", nptr->nspace);
+
+    for (n=0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_NODE_MAP)) {
+            nodes = info[n].value.data.string;
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_PROC_MAP)) {
+            procs = info[n].value.data.string;
+        }
+    }
+    if (NULL == nodes || NULL == procs) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    je = get_endpts(nptr->nspace);
+    if (NULL != je->nodes) {
+        free(je->nodes);
+    }
+    je->nodes = strdup(nodes);
+    if (NULL != je->procs) {
+        free(je->procs);
+    }
+    je->procs = strdup(procs);
+    if (NULL == je->ports) {
+        /* no ports for this job yet - if setup_local_network brings
+         * some, the endpoints are published then */
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    rc = publish_endpts(nptr, je);
+    pmix_list_remove_item(&pending_endpts, &je->super);
+    PMIX_RELEASE(je);
+    return rc;
+}
+
 /* upon receipt of the launch message, each daemon adds the
  * static address assignments to the job-level info cache
  * for that job */
@@ -787,6 +950,18 @@ static pmix_status_t setup_local_network(pmix_namespace_t *nptr,
                     PMIX_INFO_FREE(jinfo, nkvals);
                     return PMIX_ERR_BAD_PARAM;
                 }
+                /* the first entry on the ID key is the list of ports -
+                 * keep it so we can publish the procs' endpoints */
+                for (m=0; m < nkvals; m++) {
+                    if (PMIX_CHECK_KEY(&jinfo[m], idkey) &&
+                        PMIX_STRING == jinfo[m].value.type) {
+                        rc = endpts_from_ports(nptr, jinfo[m].value.data.string);
+                        if (PMIX_SUCCESS != rc) {
+                            PMIX_ERROR_LOG(rc);
+                        }
+                        break;
+                    }
+                }
                 /* the data gets stored as a pmix_data_array_t on the provided key */
                 PMIX_INFO_CONSTRUCT(&stinfo);
                 pmix_strncpy(stinfo.key, idkey, PMIX_MAX_KEYLEN);
@@ -840,59 +1015,49 @@ static void local_app_finalized(pmix_namespace_t *nptr)
  * for reuse on the next job. */
 static void deregister_nspace(pmix_namespace_t *nptr)
 {
-    tcp_port_tracker_t *trk;
+    pmix_list_t *jobs;
+    tcp_job_endpts_t *je;
 
     pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
                         "pnet:tcp deregister nspace %s", nptr->nspace);
 
+    /* drop any half of an endpoint description that never
+     * got its other half */
+    PMIX_LIST_FOREACH(je, &pending_endpts, tcp_job_endpts_t) {
+        if (0 == strcmp(je->nspace, nptr->nspace)) {
+            pmix_list_remove_item(&pending_endpts, &je->super);
+            PMIX_RELEASE(je);
+            break;
+        }
+    }
+
     /* if we are not the "gateway", then there is nothing
      * for us to do */
     if (!PMIX_PROC_IS_GATEWAY(pmix_globals.mypeer)) {
         return;
     }
 
-    /* find this tracker */
-    PMIX_LIST_FOREACH(trk, &allocations, tcp_port_tracker_t) {
-        if (0 == strcmp(nptr->nspace, trk->nspace)) {
-            pmix_list_remove_item(&allocations, &trk->super);
-            PMIX_RELEASE(trk);
-            pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
-                                "pnet:tcp released tracker for nspace %s", nptr->nspace);
-            return;
-        }
+    /* releasing the trackers returns their ports to the pools */
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&allocations, nptr->nspace,
+                                                      strlen(nptr->nspace), (void**)&jobs)) {
+        pmix_hash_table_remove_value_ptr(&allocations, nptr->nspace, strlen(nptr->nspace));
+        PMIX_LIST_RELEASE(jobs);
+        pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
+                            "pnet:tcp released trackers for nspace %s", nptr->nspace);
     }
 }
 
-static pmix_status_t collect_inventory(pmix_info_t directives[], size_t ndirs,
-                                       pmix_inventory_cbfunc_t cbfunc, void *cbdata)
+static pmix_status_t pack_devices(pmix_buffer_t *bucket)
 {
-    pmix_inventory_rollup_t *cd = (pmix_inventory_rollup_t*)cbdata;
-    char *prefix, myhost[PMIX_MAXHOSTNAMELEN];
+    char *prefix;
     char myconnhost[PMIX_MAXHOSTNAMELEN];
     char name[32], uri[2048];
     struct sockaddr_storage my_ss;
     char *foo;
-    pmix_buffer_t bucket, pbkt;
+    pmix_buffer_t pbkt;
     int i;
     pmix_status_t rc;
-    bool found = false;
     pmix_byte_object_t pbo;
-    pmix_kval_t *kv;
-
-    pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
-                        "pnet:tcp:collect_inventory");
-
-    /* setup the bucket - we will pass the results as a blob */
-    PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
-    /* add our hostname */
-    gethostname(myhost, sizeof(myhost));
-    foo = &myhost[0];
-    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, &foo, 1, PMIX_STRING);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        PMIX_DESTRUCT(&bucket);
-        return rc;
-    }
 
     /* look at all available interfaces */
     for (i = pmix_ifbegin(); i >= 0; i = pmix_ifnext(i)) {
@@ -931,7 +1096,6 @@ static pmix_status_t collect_inventory(pmix_info_t directives[], size_t ndirs,
         (void)snprintf(uri, 2048, "%s%s", prefix, myconnhost);
         pmix_output_verbose(2, pmix_pnet_base_framework. framework_output,
                             "TCP INVENTORY ADDING: %s %s", name, uri);
-        found = true;
         /* pack the name of the device */
         PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
         foo = &name[0];
@@ -939,7 +1103,6 @@ static pmix_status_t collect_inventory(pmix_info_t directives[], size_t ndirs,
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_DESTRUCT(&pbkt);
-            PMIX_DESTRUCT(&bucket);
             return rc;
         }
         /* pack the address */
@@ -948,25 +1111,81 @@ static pmix_status_t collect_inventory(pmix_info_t directives[], size_t ndirs,
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_DESTRUCT(&pbkt);
-            PMIX_DESTRUCT(&bucket);
             return rc;
         }
         /* extract the resulting blob - this is a device unit */
         PMIX_UNLOAD_BUFFER(&pbkt, pbo.bytes, pbo.size);
         /* now load that into the blob */
-        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, &pbo, 1, PMIX_BYTE_OBJECT);
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, bucket, &pbo, 1, PMIX_BYTE_OBJECT);
+        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            PMIX_DESTRUCT(&bucket);
             return rc;
         }
     }
-    /* if we have anything to report, then package it up for transfer */
-    if (!found) {
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t collect_inventory(pmix_info_t directives[], size_t ndirs,
+                                       pmix_inventory_cbfunc_t cbfunc, void *cbdata)
+{
+    pmix_inventory_rollup_t *cd = (pmix_inventory_rollup_t*)cbdata;
+    char myhost[PMIX_MAXHOSTNAMELEN];
+    char *foo;
+    pmix_buffer_t bucket;
+    pmix_status_t rc;
+    pmix_byte_object_t pbo;
+    pmix_kval_t *kv;
+
+    pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
+                        "pnet:tcp:collect_inventory");
+
+    if (0 == inventory_gen) {
+        if (PMIX_SUCCESS != (rc = pack_devices(&inventory))) {
+            PMIX_DESTRUCT(&inventory);
+            PMIX_CONSTRUCT(&inventory, pmix_buffer_t);
+            return rc;
+        }
+        /* if we have nothing to report, then we are done */
+        if (0 == inventory.bytes_used) {
+            return PMIX_ERR_TAKE_NEXT_OPTION;
+        }
+        inventory_gen = pmix_uicrc(inventory.base_ptr, inventory.bytes_used);
+        if (0 == inventory_gen) {
+            /* zero is never delivered */
+            inventory_gen = 1;
+        }
+    }
+
+    /* setup the bucket - we will pass the results as a blob */
+    PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
+    /* add our hostname */
+    gethostname(myhost, sizeof(myhost));
+    foo = &myhost[0];
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, &foo, 1, PMIX_STRING);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&bucket);
+        return rc;
+    }
+    /* and the generation of what we have */
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket, &inventory_gen, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
         PMIX_DESTRUCT(&bucket);
-        return PMIX_ERR_TAKE_NEXT_OPTION;
+        return rc;
+    }
+    /* the devices themselves only go where they may not be known */
+    if (!mca_pnet_tcp_component.inventory_delta || !inventory_sent) {
+        PMIX_BFROPS_COPY_PAYLOAD(rc, pmix_globals.mypeer, &bucket, &inventory);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&bucket);
+            return rc;
+        }
     }
+    inventory_sent = true;
+
     /* extract the resulting blob */
     PMIX_UNLOAD_BUFFER(&bucket, pbo.bytes, pbo.size);
     kv = PMIX_NEW(pmix_kval_t);
@@ -979,6 +1198,40 @@ static pmix_status_t collect_inventory(pmix_info_t directives[], size_t ndirs,
     return PMIX_SUCCESS;
 }
 
+static pmix_status_t assign_ports(pmix_namespace_t *nptr,
+                                  tcp_available_ports_t *avail,
+                                  char *idkey, int ports_per_node,
+                                  pmix_list_t *ilist)
+{
+    tcp_port_tracker_t *trk;
+    pmix_list_t *jobs;
+    pmix_status_t rc;
+
+    /* setup to track the assignment */
+    trk = PMIX_NEW(tcp_port_tracker_t);
+    if (NULL == trk) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_RETAIN(avail);
+    trk->src = avail;
+    rc = process_request(nptr, idkey, ports_per_node, trk, ilist);
+    if (PMIX_SUCCESS != rc) {
+        /* return the allocated ports */
+        PMIX_RELEASE(trk);
+        return rc;
+    }
+    /* file it under the nspace so deregister_nspace can
+     * release all of them at once */
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&allocations, nptr->nspace,
+                                                      strlen(nptr->nspace), (void**)&jobs)) {
+        jobs = PMIX_NEW(pmix_list_t);
+        pmix_hash_table_set_value_ptr(&allocations, nptr->nspace,
+                                      strlen(nptr->nspace), jobs);
+    }
+    pmix_list_append(jobs, &trk->super);
+    return PMIX_SUCCESS;
+}
+
 static pmix_status_t process_request(pmix_namespace_t *nptr,
                                      char *idkey, int ports_per_node,
                                      tcp_port_tracker_t *trk,
@@ -986,7 +1239,6 @@ static pmix_status_t process_request(pmix_namespace_t *nptr,
 {
     char **plist;
     pmix_kval_t *kv;
-    size_t m;
     int p, ppn;
     tcp_available_ports_t *avail = trk->src;
 
@@ -1005,30 +1257,32 @@ static pmix_status_t process_request(pmix_namespace_t *nptr,
     if (0 == ports_per_node) {
         /* find the maxprocs on the nodes in this nspace and
          * allocate that number of resources */
+        PMIX_RELEASE(kv);
         return PMIX_ERR_NOT_SUPPORTED;
     } else {
         ppn = ports_per_node;
     }
 
-    /* assemble the list of ports */
-    p = 0;
-    plist = NULL;
-    for (m=0; p < ppn && m < avail->nports; m++) {
-        if (NULL != avail->ports[m]) {
-            pmix_argv_append_nosize(&trk->ports, avail->ports[m]);
-            pmix_argv_append_nosize(&plist, avail->ports[m]);
-            free(avail->ports[m]);
-            avail->ports[m] = NULL;
-            ++p;
-        }
-    }
-    /* if we couldn't find enough, then that's an error */
-    if (p < ppn) {
+    /* if we don't have enough, then that's an error */
+    if ((size_t)ppn > avail->nfree) {
         PMIX_RELEASE(kv);
-        /* the caller will release trk, and that will return
-         * any allocated ports back to the available list */
         return PMIX_ERR_OUT_OF_RESOURCE;
     }
+    trk->ports = (int*)malloc(ppn * sizeof(int));
+    if (NULL == trk->ports) {
+        PMIX_RELEASE(kv);
+        return PMIX_ERR_NOMEM;
+    }
+
+    /* assemble the list of ports - there are enough free
+     * bits below nports, so the search never grows the map */
+    plist = NULL;
+    for (p=0; p < ppn; p++) {
+        pmix_bitmap_find_and_set_first_unset_bit(&avail->inuse, &trk->ports[p]);
+        pmix_argv_append_nosize(&plist, avail->ports[trk->ports[p]]);
+    }
+    trk->nports = ppn;
+    avail->nfree -= ppn;
     /* pass the value */
     kv->value->data.string = pmix_argv_join(plist, ',');
     pmix_argv_free(plist);
@@ -1080,6 +1334,8 @@ static pmix_status_t deliver_inventory(pmix_info_t info[], size_t ninfo,
     tcp_available_ports_t *prts;
     tcp_device_t *res;
     pmix_status_t rc;
+    bool copied = false, held;
+    uint32_t gen;
 
     pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
                         "pnet:tcp deliver inventory");
@@ -1096,8 +1352,17 @@ static pmix_status_t deliver_inventory(pmix_info_t info[], size_t ninfo,
                                &bkt, &hostname, &cnt, PMIX_STRING);
             if (PMIX_SUCCESS != rc) {
                 PMIX_ERROR_LOG(rc);
-                /* must _not_ destruct bkt as we don't
-                 * own the bytes! */
+                PMIX_DATA_BUFFER_DESTRUCT(&bkt);
+                return rc;
+            }
+            /* then the generation of its inventory */
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer,
+                               &bkt, &gen, &cnt, PMIX_UINT32);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                free(hostname);
+                PMIX_DATA_BUFFER_DESTRUCT(&bkt);
                 return rc;
             }
             /* do we already have this node? */
@@ -1108,31 +1373,60 @@ static pmix_status_t deliver_inventory(pmix_info_t info[], size_t ninfo,
                     break;
                 }
             }
+            /* does this node already have a TCP entry? */
+            lst = NULL;
+            if (NULL != nd) {
+                PMIX_LIST_FOREACH(lt, &nd->resources, pmix_pnet_resource_t) {
+                    if (0 == strcmp(lt->name, "tcp")) {
+                        lst = lt;
+                        break;
+                    }
+                }
+            }
+            /* nothing to do if we already hold this generation,
+             * or if the node only told us its generation */
+            held = false;
+            if (NULL != lst) {
+                PMIX_LIST_FOREACH(prts, &lst->resources, tcp_available_ports_t) {
+                    if (gen == prts->generation) {
+                        held = true;
+                        break;
+                    }
+                }
+            }
+            if (held || bkt.unpack_ptr == bkt.base_ptr + bkt.bytes_used) {
+                pmix_output_verbose(2, pmix_pnet_base_framework.framework_output,
+                                    "pnet:tcp inventory of node %s %s", hostname,
+                                    held ? "unchanged" : "not held - ignored");
+                free(hostname);
+                PMIX_DATA_BUFFER_DESTRUCT(&bkt);
+                continue;
+            }
             if (NULL == nd) {
                 nd = PMIX_NEW(pmix_pnet_node_t);
                 nd->name = strdup(hostname);
                 pmix_list_append(&pmix_pnet_globals.nodes, &nd->super);
             }
-            /* does this node already have a TCP entry? */
-            lst = NULL;
-            PMIX_LIST_FOREACH(lt, &nd->resources, pmix_pnet_resource_t) {
-                if (0 == strcmp(lt->name, "tcp")) {
-                    lst = lt;
-                    break;
-                }
-            }
+            free(hostname);
             if (NULL == lst) {
                 lst = PMIX_NEW(pmix_pnet_resource_t);
                 lst->name = strdup("tcp");
                 pmix_list_append(&nd->resources, &lst->super);
+            } else {
+                /* the new inventory replaces the old one */
+                PMIX_LIST_DESTRUCT(&lst->resources);
+                PMIX_CONSTRUCT(&lst->resources, pmix_list_t);
             }
             /* this is a list of ports and devices */
             prts = PMIX_NEW(tcp_available_ports_t);
+            prts->generation = gen;
             pmix_list_append(&lst->resources, &prts->super);
-            /* cycle across any provided interfaces */
-            cnt = 1;
-            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer,
-                               &bkt, &pbo, &cnt, PMIX_BYTE_OBJECT);
+            /* cycle across any provided interfaces, consuming each
+             * one in place so the inventory is walked in a single
+             * pass without copying the per-device envelopes */
+            PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
+            PMIX_BFROPS_UNPACK_BORROW(rc, pmix_globals.mypeer,
+                                      &bkt, &pbo, copied);
             while (PMIX_SUCCESS == rc) {
                 /* load the byte object for unpacking */
                 PMIX_LOAD_BUFFER(pmix_globals.mypeer, &pbkt, pbo.bytes, pbo.size);
@@ -1142,7 +1436,10 @@ static pmix_status_t deliver_inventory(pmix_info_t info[], size_t ninfo,
                                    &pbkt, &device, &cnt, PMIX_STRING);
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
-                    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+                    if (!copied) {
+                        PMIX_UNLOAD_BUFFER(&pbkt, pbo.bytes, pbo.size);
+                    }
+                    PMIX_DESTRUCT(&pbkt);
                     /* must _not_ destruct bkt as we don't
                      * own the bytes! */
                     return rc;
@@ -1153,7 +1450,10 @@ static pmix_status_t deliver_inventory(pmix_info_t info[], size_t ninfo,
                                    &pbkt, &address, &cnt, PMIX_STRING);
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
-                    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+                    if (!copied) {
+                        PMIX_UNLOAD_BUFFER(&pbkt, pbo.bytes, pbo.size);
+                    }
+                    PMIX_DESTRUCT(&pbkt);
                     /* must _not_ destruct bkt as we don't
                      * own the bytes! */
                     return rc;
@@ -1163,11 +1463,15 @@ static pmix_status_t deliver_inventory(pmix_info_t info[], size_t ninfo,
                 res->device = device;
                 res->address = address;
                 pmix_list_append(&prts->devices, &res->super);
-                PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                cnt = 1;
-                PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer,
-                                   &bkt, &pbo, &cnt, PMIX_BYTE_OBJECT);
+                if (!copied) {
+                    PMIX_UNLOAD_BUFFER(&pbkt, pbo.bytes, pbo.size);
+                }
+                PMIX_DESTRUCT(&pbkt);
+                PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
+                PMIX_BFROPS_UNPACK_BORROW(rc, pmix_globals.mypeer,
+                                          &bkt, &pbo, copied);
             }
+            PMIX_DESTRUCT(&pbkt);
             PMIX_DATA_BUFFER_DESTRUCT(&bkt);
             if (5 < pmix_output_get_verbosity(pmix_pnet_base_framework.framework_output)) {
                 /* dump the resulting node resources */
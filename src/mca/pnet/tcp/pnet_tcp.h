@@ -26,6 +26,7 @@ typedef struct {
     char *excparms;
     char **include;
     char **exclude;
+    bool inventory_delta;
 } pmix_pnet_tcp_component_t;
 
 /* the component must be visible data for the linker to find it */
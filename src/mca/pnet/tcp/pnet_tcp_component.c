@@ -57,7 +57,8 @@ pmix_pnet_tcp_component_t mca_pnet_tcp_component = {
     .static_ports = NULL,
     .default_request = NULL,
     .include = NULL,
-    .exclude = NULL
+    .exclude = NULL,
+    .inventory_delta = false
 };
 
 static pmix_status_t component_register(void)
@@ -105,6 +106,17 @@ static pmix_status_t component_register(void)
         mca_pnet_tcp_component.exclude = pmix_argv_split(mca_pnet_tcp_component.excparms, ',');
     }
 
+    mca_pnet_tcp_component.inventory_delta = false;
+    (void)pmix_mca_base_component_var_register(component, "inventory_delta",
+                                               "Once the full inventory of this node has been collected, only "
+                                               "report its generation in later collections while the interfaces "
+                                               "are unchanged. Only for hosts that deliver every collected "
+                                               "inventory to the same server",
+                                               PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                               PMIX_INFO_LVL_4,
+                                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                               &mca_pnet_tcp_component.inventory_delta);
+
     return PMIX_SUCCESS;
 }
 
@@ -35,6 +35,7 @@
 #endif
 
 #include "src/class/pmix_pointer_array.h"
+#include "src/threads/threads.h"
 #include "src/mca/mca.h"
 #include "src/mca/base/pmix_mca_base_framework.h"
 
@@ -67,10 +68,27 @@ struct pmix_preg_base_active_module_t {
 typedef struct pmix_preg_base_active_module_t pmix_preg_base_active_module_t;
 PMIX_CLASS_DECLARATION(pmix_preg_base_active_module_t);
 
+/**
+ * A recently parsed regex and its expansion
+ */
+typedef struct {
+    pmix_list_item_t super;
+    bool procs;         // result of parse_procs rather than parse_nodes
+    char *regex;
+    char **argv;
+    int argc;
+} pmix_preg_base_parsed_t;
+PMIX_CLASS_DECLARATION(pmix_preg_base_parsed_t);
+
+/* number of parsed regexes to retain */
+#define PMIX_PREG_BASE_PARSED_MAX   8
+
 
 /* framework globals */
 struct pmix_preg_globals_t {
   pmix_list_t actives;
+  pmix_list_t parsed;   // most recently used first
+  pmix_mutex_t parsedlock;  // parsing is also done off the progress thread
   bool initialized;
 };
 typedef struct pmix_preg_globals_t pmix_preg_globals_t;
@@ -32,6 +32,7 @@
 #endif
 
 #include "src/class/pmix_list.h"
+#include "src/util/argv.h"
 #include "src/mca/base/base.h"
 #include "src/mca/preg/base/base.h"
 
@@ -62,6 +63,8 @@ static pmix_status_t pmix_preg_close(void)
     pmix_preg_globals.initialized = false;
 
     PMIX_LIST_DESTRUCT(&pmix_preg_globals.actives);
+    PMIX_LIST_DESTRUCT(&pmix_preg_globals.parsed);
+    PMIX_DESTRUCT(&pmix_preg_globals.parsedlock);
 
     return pmix_mca_base_framework_components_close(&pmix_preg_base_framework, NULL);
 }
@@ -71,6 +74,8 @@ static pmix_status_t pmix_preg_open(pmix_mca_base_open_flag_t flags)
     /* initialize globals */
     pmix_preg_globals.initialized = true;
     PMIX_CONSTRUCT(&pmix_preg_globals.actives, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_preg_globals.parsed, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_preg_globals.parsedlock, pmix_mutex_t);
 
     /* Open up all available components */
     return pmix_mca_base_framework_components_open(&pmix_preg_base_framework, flags);
@@ -84,6 +89,26 @@ PMIX_CLASS_INSTANCE(pmix_preg_base_active_module_t,
                     pmix_list_item_t,
                     NULL, NULL);
 
+static void pcon(pmix_preg_base_parsed_t *p)
+{
+    p->procs = false;
+    p->regex = NULL;
+    p->argv = NULL;
+    p->argc = 0;
+}
+static void pdes(pmix_preg_base_parsed_t *p)
+{
+    if (NULL != p->regex) {
+        free(p->regex);
+    }
+    if (NULL != p->argv) {
+        pmix_argv_free(p->argv);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_preg_base_parsed_t,
+                    pmix_list_item_t,
+                    pcon, pdes);
+
 static void rcon(pmix_regex_range_t *p)
 {
     p->start = 0;
@@ -20,6 +20,9 @@
 #include <src/include/pmix_config.h>
 
 #include <stdio.h>
+#ifdef HAVE_STRING_H
+#include <string.h>
+#endif
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
@@ -62,14 +65,102 @@ pmix_status_t pmix_preg_base_generate_ppn(const char *input,
     return PMIX_ERR_NOT_SUPPORTED;
 }
 
+/* a job that spawns children onto its own allocation registers
+ * each new nspace with the same node and proc maps, so keep the
+ * expansion of the last few regexes and hand back copies rather
+ * than parsing them again. Nodes are also resolved from application
+ * threads and pnet inventory workers, so the cache is guarded by
+ * parsedlock. */
+static pmix_status_t copy_parsed(pmix_preg_base_parsed_t *p, char ***argv)
+{
+    char **tmp;
+    int n;
+
+    if (NULL == p->argv) {
+        *argv = NULL;
+        return PMIX_SUCCESS;
+    }
+    if (NULL == (tmp = (char**)malloc((p->argc + 1) * sizeof(char*)))) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (n=0; n < p->argc; n++) {
+        if (NULL == (tmp[n] = strdup(p->argv[n]))) {
+            tmp[n] = NULL;
+            pmix_argv_free(tmp);
+            return PMIX_ERR_NOMEM;
+        }
+    }
+    tmp[p->argc] = NULL;
+    *argv = tmp;
+    return PMIX_SUCCESS;
+}
+
+static bool lookup_parsed(const char *regexp, bool procs, char ***argv)
+{
+    pmix_preg_base_parsed_t *p;
+    bool found = false;
+
+    pmix_mutex_lock(&pmix_preg_globals.parsedlock);
+    PMIX_LIST_FOREACH(p, &pmix_preg_globals.parsed, pmix_preg_base_parsed_t) {
+        if (p->procs == procs && 0 == strcmp(p->regex, regexp)) {
+            if (PMIX_SUCCESS == copy_parsed(p, argv)) {
+                /* keep the list in most-recently-used order */
+                pmix_list_remove_item(&pmix_preg_globals.parsed, &p->super);
+                pmix_list_prepend(&pmix_preg_globals.parsed, &p->super);
+                found = true;
+            }
+            break;
+        }
+    }
+    pmix_mutex_unlock(&pmix_preg_globals.parsedlock);
+    return found;
+}
+
+static void save_parsed(const char *regexp, bool procs, char **argv)
+{
+    pmix_preg_base_parsed_t *p, tmp;
+
+    tmp.argv = argv;
+    tmp.argc = pmix_argv_count(argv);
+    p = PMIX_NEW(pmix_preg_base_parsed_t);
+    if (NULL == p) {
+        return;
+    }
+    p->procs = procs;
+    p->argc = tmp.argc;
+    if (NULL == (p->regex = strdup(regexp)) ||
+        PMIX_SUCCESS != copy_parsed(&tmp, &p->argv)) {
+        PMIX_RELEASE(p);
+        return;
+    }
+    pmix_mutex_lock(&pmix_preg_globals.parsedlock);
+    pmix_list_prepend(&pmix_preg_globals.parsed, &p->super);
+    if (PMIX_PREG_BASE_PARSED_MAX < pmix_list_get_size(&pmix_preg_globals.parsed)) {
+        p = (pmix_preg_base_parsed_t*)pmix_list_remove_last(&pmix_preg_globals.parsed);
+    } else {
+        p = NULL;
+    }
+    pmix_mutex_unlock(&pmix_preg_globals.parsedlock);
+    if (NULL != p) {
+        PMIX_RELEASE(p);
+    }
+}
+
 pmix_status_t pmix_preg_base_parse_nodes(const char *regexp,
                                          char ***names)
 {
     pmix_preg_base_active_module_t *active;
 
+    if (NULL != regexp && lookup_parsed(regexp, false, names)) {
+        return PMIX_SUCCESS;
+    }
+
     PMIX_LIST_FOREACH(active, &pmix_preg_globals.actives, pmix_preg_base_active_module_t) {
         if (NULL != active->module->parse_nodes) {
             if (PMIX_SUCCESS == active->module->parse_nodes(regexp, names)) {
+                if (NULL != regexp) {
+                    save_parsed(regexp, false, *names);
+                }
                 return PMIX_SUCCESS;
             }
         }
@@ -83,9 +174,16 @@ pmix_status_t pmix_preg_base_parse_procs(const char *regexp,
 {
     pmix_preg_base_active_module_t *active;
 
+    if (NULL != regexp && lookup_parsed(regexp, true, procs)) {
+        return PMIX_SUCCESS;
+    }
+
     PMIX_LIST_FOREACH(active, &pmix_preg_globals.actives, pmix_preg_base_active_module_t) {
         if (NULL != active->module->parse_procs) {
             if (PMIX_SUCCESS == active->module->parse_procs(regexp, procs)) {
+                if (NULL != regexp) {
+                    save_parsed(regexp, true, *procs);
+                }
                 return PMIX_SUCCESS;
             }
         }
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2018      Intel, Inc.  All rights reserved.
+ *
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#ifdef HAVE_STRING_H
+#include <string.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+
+
+#include <pmix_common.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/util/argv.h"
+#include "src/util/error.h"
+#include "src/util/output.h"
+
+#include "src/mca/preg/base/base.h"
+#include "preg_compact.h"
+
+/*
+ * The native proc map lists the ranks of every node, so its size
+ * grows with the node count even when the mapping is regular. Here
+ * each node's ranks must form an arithmetic progression, and runs of
+ * consecutive nodes whose progressions differ only by a fixed offset
+ * of their first rank collapse into a single entry:
+ *
+ *     compact[nnodes:start:delta:count:stride;...]
+ *
+ * Node k of a run (k = 0..nnodes-1) holds the count ranks starting at
+ * start + k*delta, stride apart. A by-slot mapping of 16 ranks/node
+ * across any number of nodes is therefore "compact[N:0:16:16:1]", and
+ * a by-node mapping is "compact[N:0:1:16:N]".
+ *
+ * Maps that do not fit this form or would not come out smaller than
+ * the input are left for the next module to encode.
+ */
+
+static pmix_status_t generate_ppn(const char *input,
+                                  char **ppn);
+static pmix_status_t parse_procs(const char *regexp,
+                                 char ***procs);
+
+pmix_preg_module_t pmix_preg_compact_module = {
+    .name = "compact",
+    .generate_ppn = generate_ppn,
+    .parse_procs = parse_procs
+};
+
+typedef struct {
+    int nnodes;
+    int start;
+    int delta;
+    int count;
+    int stride;
+} compact_run_t;
+
+static pmix_status_t compact_append(char **buf, size_t *used,
+                                    size_t *size, const char *str)
+{
+    size_t n = strlen(str);
+    char *tmp;
+
+    if (*size < *used + n + 1) {
+        *size = 2 * (*used + n + 1);
+        if (NULL == (tmp = (char*)realloc(*buf, *size))) {
+            return PMIX_ERR_NOMEM;
+        }
+        *buf = tmp;
+    }
+    memcpy(*buf + *used, str, n + 1);
+    *used += n;
+    return PMIX_SUCCESS;
+}
+
+/* reduce one node's "r,r-r,..." list to (start, count, stride) */
+static bool node_progression(char *node, compact_run_t *run)
+{
+    char *item, *next, *cptr;
+    int first, last, k;
+
+    run->count = 0;
+    run->stride = 1;
+    last = 0;
+    for (item = node; NULL != item; item = next) {
+        if (NULL != (next = strchr(item, ','))) {
+            *next = '\0';
+            ++next;
+        }
+        if ('\0' == *item) {
+            continue;
+        }
+        first = strtol(item, &cptr, 10);
+        if ('-' == *cptr) {
+            k = strtol(cptr + 1, NULL, 10);
+        } else {
+            k = first;
+        }
+        for (; first <= k; first++) {
+            if (0 == run->count) {
+                run->start = first;
+            } else if (1 == run->count) {
+                if (first <= last) {
+                    return false;
+                }
+                run->stride = first - last;
+            } else if (first != last + run->stride) {
+                return false;
+            }
+            last = first;
+            ++run->count;
+        }
+    }
+    return (0 < run->count);
+}
+
+static pmix_status_t generate_ppn(const char *input,
+                                  char **regexp)
+{
+    char *nodes, *nd, *next, *result = NULL, tmp[96];
+    compact_run_t run, node;
+    size_t used = 0, size = 0;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    *regexp = NULL;
+
+    if (NULL == input) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    if (NULL == (nodes = strdup(input))) {
+        return PMIX_ERR_NOMEM;
+    }
+    if (PMIX_SUCCESS != (rc = compact_append(&result, &used, &size, "compact["))) {
+        free(nodes);
+        return rc;
+    }
+
+    memset(&run, 0, sizeof(run));
+    for (nd = nodes; NULL != nd; nd = next) {
+        if (NULL != (next = strchr(nd, ';'))) {
+            *next = '\0';
+            ++next;
+        }
+        if ('\0' == *nd) {
+            continue;
+        }
+        if (!node_progression(nd, &node)) {
+            rc = PMIX_ERR_TAKE_NEXT_OPTION;
+            break;
+        }
+        if (0 < run.nnodes && node.count == run.count && node.stride == run.stride) {
+            if (1 == run.nnodes) {
+                run.delta = node.start - run.start;
+                run.nnodes = 2;
+                continue;
+            }
+            if (node.start == run.start + run.nnodes * run.delta) {
+                ++run.nnodes;
+                continue;
+            }
+        }
+        /* flush the current run and start a new one with this node */
+        if (0 < run.nnodes) {
+            snprintf(tmp, sizeof(tmp), "%d:%d:%d:%d:%d;", run.nnodes,
+                     run.start, run.delta, run.count, run.stride);
+            if (PMIX_SUCCESS != (rc = compact_append(&result, &used, &size, tmp))) {
+                break;
+            }
+        }
+        run = node;
+        run.nnodes = 1;
+        run.delta = 0;
+    }
+    free(nodes);
+
+    if (PMIX_SUCCESS == rc) {
+        if (0 == run.nnodes) {
+            rc = PMIX_ERR_TAKE_NEXT_OPTION;
+        } else {
+            snprintf(tmp, sizeof(tmp), "%d:%d:%d:%d:%d]", run.nnodes,
+                     run.start, run.delta, run.count, run.stride);
+            rc = compact_append(&result, &used, &size, tmp);
+        }
+    }
+    /* leave irregular maps to a module that lists them in full */
+    if (PMIX_SUCCESS == rc && strlen(input) <= used) {
+        rc = PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    if (PMIX_SUCCESS != rc) {
+        free(result);
+        return rc;
+    }
+
+    pmix_output_verbose(2, pmix_preg_base_framework.framework_output,
+                        "preg:compact: proc map of %lu bytes encoded as %s",
+                        (unsigned long)strlen(input), result);
+    *regexp = result;
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t parse_procs(const char *regexp,
+                                 char ***procs)
+{
+    const char *ptr;
+    char *end, *list = NULL, **ps = NULL, **tmp, rank[16];
+    compact_run_t run;
+    size_t used, size = 0;
+    int n, k, nps = 0;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    *procs = NULL;
+
+    if (NULL == regexp) {
+        return PMIX_SUCCESS;
+    }
+    if (0 != strncmp(regexp, "compact[", strlen("compact["))) {
+        /* this isn't an error - let someone else try */
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    ptr = regexp + strlen("compact[");
+    while (']' != *ptr) {
+        run.nnodes = strtol(ptr, &end, 10);
+        if (':' != *end) {
+            goto badregex;
+        }
+        run.start = strtol(end + 1, &end, 10);
+        if (':' != *end) {
+            goto badregex;
+        }
+        run.delta = strtol(end + 1, &end, 10);
+        if (':' != *end) {
+            goto badregex;
+        }
+        run.count = strtol(end + 1, &end, 10);
+        if (':' != *end) {
+            goto badregex;
+        }
+        run.stride = strtol(end + 1, &end, 10);
+        if ((';' != *end && ']' != *end) || 0 >= run.nnodes || 0 >= run.count) {
+            goto badregex;
+        }
+        ptr = (';' == *end) ? end + 1 : end;
+
+        for (n=0; n < run.nnodes; n++) {
+            used = 0;
+            for (k=0; k < run.count; k++) {
+                snprintf(rank, sizeof(rank), (0 == k) ? "%d" : ",%d",
+                         run.start + n * run.delta + k * run.stride);
+                if (PMIX_SUCCESS != (rc = compact_append(&list, &used, &size, rank))) {
+                    goto cleanup;
+                }
+            }
+            /* grow the result geometrically - there is one entry per node */
+            if (0 == nps || 0 == ((nps + 1) & nps)) {
+                if (NULL == (tmp = (char**)realloc(ps, 2 * (nps + 1) * sizeof(char*)))) {
+                    rc = PMIX_ERR_NOMEM;
+                    goto cleanup;
+                }
+                ps = tmp;
+            }
+            if (NULL == (ps[nps] = strdup(list))) {
+                rc = PMIX_ERR_NOMEM;
+                goto cleanup;
+            }
+            ps[++nps] = NULL;
+        }
+    }
+    free(list);
+    *procs = ps;
+    return PMIX_SUCCESS;
+
+  badregex:
+    rc = PMIX_ERR_BAD_PARAM;
+    PMIX_ERROR_LOG(rc);
+  cleanup:
+    free(list);
+    pmix_argv_free(ps);
+    return rc;
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ *
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef PMIX_PREG_COMPACT_H
+#define PMIX_PREG_COMPACT_H
+
+#include <src/include/pmix_config.h>
+
+
+#include "src/mca/preg/preg.h"
+
+BEGIN_C_DECLS
+
+typedef struct {
+    pmix_mca_base_component_t super;
+    int priority;       // selection priority relative to native
+} pmix_preg_compact_component_t;
+
+/* the component must be visible data for the linker to find it */
+PMIX_EXPORT extern pmix_preg_compact_component_t mca_preg_compact_component;
+extern pmix_preg_module_t pmix_preg_compact_module;
+
+END_C_DECLS
+
+#endif
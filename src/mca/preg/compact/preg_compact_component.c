@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * These symbols are in a file by themselves to provide nice linker
+ * semantics.  Since linkers generally pull in symbols by object
+ * files, keeping these symbols as the only symbols in this file
+ * prevents utility programs such as "ompi_info" from having to import
+ * entire components just to query their version and parameters.
+ */
+
+#include <src/include/pmix_config.h>
+#include "pmix_common.h"
+
+#include "src/mca/base/pmix_mca_base_var.h"
+#include "src/mca/preg/preg.h"
+#include "preg_compact.h"
+
+static pmix_status_t component_register(void);
+static pmix_status_t component_query(pmix_mca_base_module_t **module, int *priority);
+
+/*
+ * Instantiate the public struct with all of our public information
+ * and pointers to our public functions in it
+ */
+pmix_preg_compact_component_t mca_preg_compact_component = {
+    .super = {
+        PMIX_PREG_BASE_VERSION_1_0_0,
+
+        /* Component name and version */
+        .pmix_mca_component_name = "compact",
+        PMIX_MCA_BASE_MAKE_VERSION(component,
+                                   PMIX_MAJOR_VERSION,
+                                   PMIX_MINOR_VERSION,
+                                   PMIX_RELEASE_VERSION),
+
+        .pmix_mca_query_component = component_query,
+        .pmix_mca_register_component_params = component_register,
+    },
+    .priority = 50
+};
+
+
+static pmix_status_t component_register(void)
+{
+    /* the compact proc map cannot be read by clients that lack this
+     * component, so by default we sit below native and only get
+     * used when the priority is raised above it */
+    (void) pmix_mca_base_component_var_register(&mca_preg_compact_component.super, "priority",
+                                                "Priority of the compact preg component - set above 100 to "
+                                                "encode proc maps with it instead of the native regex",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                                PMIX_INFO_LVL_9,
+                                                PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                                &mca_preg_compact_component.priority);
+    return PMIX_SUCCESS;
+}
+
+static int component_query(pmix_mca_base_module_t **module, int *priority)
+{
+    *priority = mca_preg_compact_component.priority;
+    *module = (pmix_mca_base_module_t *)&pmix_preg_compact_module;
+    return PMIX_SUCCESS;
+}
@@ -34,6 +34,7 @@
 #include "src/util/argv.h"
 #include "src/util/error.h"
 #include "src/util/output.h"
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/mca/gds/gds.h"
 #include "src/client/pmix_client_ops.h"
@@ -67,33 +68,62 @@ pmix_preg_module_t pmix_preg_native_module = {
 
 static pmix_status_t regex_parse_value_ranges(char *base, char *ranges,
                                               int num_digits, char *suffix,
-                                              char ***names);
+                                              char ***names, int *nnames);
 static pmix_status_t regex_parse_value_range(char *base, char *range,
                                              int num_digits, char *suffix,
-                                             char ***names);
+                                             char ***names, int *nnames);
 static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names);
 static pmix_status_t pmix_regex_extract_ppn(char *regexp, char ***procs);
 
 
+/* append a string to a growing buffer - the regex for a large
+ * allocation can run to many kbytes, so don't rebuild it with
+ * asprintf for every range */
+static pmix_status_t regex_append(char **buf, size_t *used,
+                                  size_t *size, const char *str)
+{
+    size_t n = strlen(str);
+    char *tmp;
+
+    if (*size < *used + n + 1) {
+        *size = 2 * (*used + n + 1);
+        if (NULL == (tmp = (char*)realloc(*buf, *size))) {
+            return PMIX_ERR_NOMEM;
+        }
+        *buf = tmp;
+    }
+    memcpy(*buf + *used, str, n + 1);
+    *used += n;
+    return PMIX_SUCCESS;
+}
+
 static pmix_status_t generate_node_regex(const char *input,
                                          char **regexp)
 {
     char *vptr, *vsave;
     char prefix[PMIX_MAX_NODE_PREFIX];
     int i, j, len, startnum, vnum, numdigits;
-    bool found, fullval;
-    char *suffix, *sfx;
-    pmix_regex_value_t *vreg;
+    bool fullval;
+    char *suffix;
+    pmix_regex_value_t *vreg, *last = NULL;
     pmix_regex_range_t *range;
     pmix_list_t vids;
-    char **regexargs = NULL, *tmp, *tmp2;
+    pmix_hash_table_t vidx;
+    char *key = NULL, *result = NULL, tmp[64];
+    size_t keylen, keysize = 0, used = 0, size = 0;
     char *cptr;
+    bool first = true;
+    pmix_status_t rc = PMIX_SUCCESS;
 
     /* define the default */
     *regexp = NULL;
 
-    /* setup the list of results */
+    /* setup the list of results - the hash indexes the list
+     * by prefix/suffix/width so that each name is matched
+     * to its value in constant time */
     PMIX_CONSTRUCT(&vids, pmix_list_t);
+    PMIX_CONSTRUCT(&vidx, pmix_hash_table_t);
+    pmix_hash_table_init(&vidx, 64);
 
     /* cycle thru the array of input values - first copy
      * it so we don't overwrite what we were given*/
@@ -143,89 +173,57 @@ static pmix_status_t generate_node_regex(const char *input,
             vptr = cptr + 1;
             continue;
         }
-        /* convert the digits and get any suffix */
-        vnum = strtol(&vptr[startnum], &sfx, 10);
-        if (NULL != sfx) {
-            suffix = strdup(sfx);
-            numdigits = (int)(sfx - &vptr[startnum]);
+        /* convert the digits and get any suffix - the suffix
+         * points into our copy of the input */
+        vnum = strtol(&vptr[startnum], &suffix, 10);
+        numdigits = (int)(suffix - &vptr[startnum]);
+        /* is this value already on our list? Consecutive names
+         * nearly always share a value, so check the last one
+         * before going to the index */
+        if (NULL != last &&
+            numdigits == last->num_digits &&
+            0 == strcmp(prefix, (NULL == last->prefix) ? "" : last->prefix) &&
+            0 == strcmp(suffix, last->suffix)) {
+            vreg = last;
         } else {
-            suffix = NULL;
-            numdigits = (int)strlen(&vptr[startnum]);
-        }
-        /* is this value already on our list? */
-        found = false;
-        PMIX_LIST_FOREACH(vreg, &vids, pmix_regex_value_t) {
-            if (0 < strlen(prefix) && NULL == vreg->prefix) {
-                continue;
-            }
-            if (0 == strlen(prefix) && NULL != vreg->prefix) {
-                continue;
-            }
-            if (0 < strlen(prefix) && NULL != vreg->prefix
-                && 0 != strcmp(prefix, vreg->prefix)) {
-                continue;
-            }
-            if (NULL == suffix && NULL != vreg->suffix) {
-                continue;
-            }
-            if (NULL != suffix && NULL == vreg->suffix) {
-                continue;
-            }
-            if (NULL != suffix && NULL != vreg->suffix &&
-                0 != strcmp(suffix, vreg->suffix)) {
-                continue;
-            }
-            if (numdigits != vreg->num_digits) {
-                continue;
-            }
-            /* found a match - flag it */
-            found = true;
-            /* get the last range on this nodeid - we do this
-             * to preserve order
-             */
-            range = (pmix_regex_range_t*)pmix_list_get_last(&vreg->ranges);
-            if (NULL == range) {
-                /* first range for this value */
-                range = PMIX_NEW(pmix_regex_range_t);
-                range->start = vnum;
-                range->cnt = 1;
-                pmix_list_append(&vreg->ranges, &range->super);
-                break;
-            }
-            /* see if the value is out of sequence */
-            if (vnum != (range->start + range->cnt)) {
-                /* start a new range */
-                range = PMIX_NEW(pmix_regex_range_t);
-                range->start = vnum;
-                range->cnt = 1;
-                pmix_list_append(&vreg->ranges, &range->super);
-                break;
-            }
-            /* everything matches - just increment the cnt */
-            range->cnt++;
-            break;
-        }
-        if (!found) {
-            /* need to add it */
-            vreg = PMIX_NEW(pmix_regex_value_t);
-            if (0 < strlen(prefix)) {
-                vreg->prefix = strdup(prefix);
+            keylen = strlen(prefix) + strlen(suffix) + 16;
+            if (keysize < keylen) {
+                free(key);
+                keysize = 2 * keylen;
+                if (NULL == (key = (char*)malloc(keysize))) {
+                    rc = PMIX_ERR_NOMEM;
+                    goto cleanup;
+                }
             }
-            if (NULL != suffix) {
+            keylen = snprintf(key, keysize, "%s\n%s\n%d", prefix, suffix, numdigits);
+            if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&vidx, key, keylen, (void**)&vreg)) {
+                /* need to add it */
+                vreg = PMIX_NEW(pmix_regex_value_t);
+                if (0 < strlen(prefix)) {
+                    vreg->prefix = strdup(prefix);
+                }
                 vreg->suffix = strdup(suffix);
+                vreg->num_digits = numdigits;
+                pmix_list_append(&vids, &vreg->super);
+                pmix_hash_table_set_value_ptr(&vidx, key, keylen, vreg);
             }
-            vreg->num_digits = numdigits;
-            pmix_list_append(&vids, &vreg->super);
-            /* record the first range for this value - we took
-             * care of values we can't compress above
-             */
+        }
+        last = vreg;
+        /* get the last range on this nodeid - we do this
+         * to preserve order
+         */
+        range = (pmix_regex_range_t*)pmix_list_get_last(&vreg->ranges);
+        if (pmix_list_is_empty(&vreg->ranges) ||
+            vnum != (range->start + range->cnt)) {
+            /* first range for this value, or the value is
+             * out of sequence - start a new range */
             range = PMIX_NEW(pmix_regex_range_t);
             range->start = vnum;
             range->cnt = 1;
             pmix_list_append(&vreg->ranges, &range->super);
-        }
-        if (NULL != suffix) {
-            free(suffix);
+        } else {
+            /* everything matches - just increment the cnt */
+            range->cnt++;
         }
         /* move to the next posn */
         if (NULL == cptr) {
@@ -233,70 +231,77 @@ static pmix_status_t generate_node_regex(const char *input,
         }
         vptr = cptr + 1;
     }
-    free(vsave);
 
     /* begin constructing the regular expression */
-    while (NULL != (vreg = (pmix_regex_value_t*)pmix_list_remove_first(&vids))) {
+    if (PMIX_SUCCESS != (rc = regex_append(&result, &used, &size, "pmix["))) {
+        goto cleanup;
+    }
+    PMIX_LIST_FOREACH(vreg, &vids, pmix_regex_value_t) {
         /* if no ranges, then just add the name */
         if (0 == pmix_list_get_size(&vreg->ranges)) {
             if (NULL != vreg->prefix) {
-                pmix_argv_append_nosize(&regexargs, vreg->prefix);
+                if (!first) {
+                    rc = regex_append(&result, &used, &size, ",");
+                }
+                if (PMIX_SUCCESS != rc ||
+                    PMIX_SUCCESS != (rc = regex_append(&result, &used, &size, vreg->prefix))) {
+                    goto cleanup;
+                }
+                first = false;
             }
-            PMIX_RELEASE(vreg);
             continue;
         }
         /* start the regex for this value with the prefix */
-        if (NULL != vreg->prefix) {
-            if (0 > asprintf(&tmp, "%s[%d:", vreg->prefix, vreg->num_digits)) {
-                return PMIX_ERR_NOMEM;
-            }
-        } else {
-            if (0 > asprintf(&tmp, "[%d:", vreg->num_digits)) {
-                return PMIX_ERR_NOMEM;
-            }
+        if (!first) {
+            rc = regex_append(&result, &used, &size, ",");
+        }
+        if (PMIX_SUCCESS != rc ||
+            (NULL != vreg->prefix &&
+             PMIX_SUCCESS != (rc = regex_append(&result, &used, &size, vreg->prefix)))) {
+            goto cleanup;
+        }
+        first = false;
+        snprintf(tmp, sizeof(tmp), "[%d:", vreg->num_digits);
+        if (PMIX_SUCCESS != (rc = regex_append(&result, &used, &size, tmp))) {
+            goto cleanup;
         }
         /* add the ranges */
-        while (NULL != (range = (pmix_regex_range_t*)pmix_list_remove_first(&vreg->ranges))) {
+        PMIX_LIST_FOREACH(range, &vreg->ranges, pmix_regex_range_t) {
             if (1 == range->cnt) {
-                if (0 > asprintf(&tmp2, "%s%d,", tmp, range->start)) {
-                    return PMIX_ERR_NOMEM;
-                }
+                snprintf(tmp, sizeof(tmp), "%d,", range->start);
             } else {
-                if (0 > asprintf(&tmp2, "%s%d-%d,", tmp, range->start, range->start + range->cnt - 1)) {
-                    return PMIX_ERR_NOMEM;
-                }
+                snprintf(tmp, sizeof(tmp), "%d-%d,", range->start, range->start + range->cnt - 1);
+            }
+            if (PMIX_SUCCESS != (rc = regex_append(&result, &used, &size, tmp))) {
+                goto cleanup;
             }
-            free(tmp);
-            tmp = tmp2;
-            PMIX_RELEASE(range);
         }
         /* replace the final comma */
-        tmp[strlen(tmp)-1] = ']';
-        if (NULL != vreg->suffix) {
-            /* add in the suffix, if provided */
-            if (0 > asprintf(&tmp2, "%s%s", tmp, vreg->suffix)) {
-                return PMIX_ERR_NOMEM;
-            }
-            free(tmp);
-            tmp = tmp2;
+        result[used-1] = ']';
+        /* add in the suffix, if provided */
+        if (NULL != vreg->suffix &&
+            PMIX_SUCCESS != (rc = regex_append(&result, &used, &size, vreg->suffix))) {
+            goto cleanup;
         }
-        pmix_argv_append_nosize(&regexargs, tmp);
-        free(tmp);
-        PMIX_RELEASE(vreg);
     }
-
     /* assemble final result */
-    tmp = pmix_argv_join(regexargs, ',');
-    if (0 > asprintf(regexp, "pmix[%s]", tmp)) {
-        return PMIX_ERR_NOMEM;
+    if (PMIX_SUCCESS != (rc = regex_append(&result, &used, &size, "]"))) {
+        goto cleanup;
     }
-    free(tmp);
+    *regexp = result;
+    result = NULL;
 
-    /* cleanup */
-    pmix_argv_free(regexargs);
-
-    PMIX_DESTRUCT(&vids);
-    return PMIX_SUCCESS;
+  cleanup:
+    free(vsave);
+    if (NULL != key) {
+        free(key);
+    }
+    if (NULL != result) {
+        free(result);
+    }
+    PMIX_DESTRUCT(&vidx);
+    PMIX_LIST_DESTRUCT(&vids);
+    return rc;
 }
 
 static pmix_status_t generate_ppn(const char *input,
@@ -347,7 +352,7 @@ static pmix_status_t generate_ppn(const char *input,
                     /* is this a continuation of the current range? */
                     if (start == (rng->start + rng->cnt)) {
                         /* just add it to the end of this range */
-                        rng->cnt++;
+                        rng->cnt += end - start + 1;
                     } else {
                         /* nope, there is a break - create new range */
                         rng = PMIX_NEW(pmix_regex_range_t);
@@ -656,6 +661,31 @@ static pmix_status_t resolve_nodes(const char *nspace,
     return rc;
 }
 
+/* Append a copy of arg to an argv array that only we grow. Unlike
+ * pmix_argv_append_nosize, the caller tracks the count, and storage
+ * doubles whenever the count reaches a power of two - expanding a
+ * large regex would otherwise recount and realloc the whole array for
+ * every entry */
+static pmix_status_t regex_argv_append(char ***argv, int *argc, const char *arg)
+{
+    char **tmp;
+    int n = *argc;
+
+    if (0 == n || 0 == ((n + 1) & n)) {
+        tmp = (char**)realloc(*argv, 2 * (n + 1) * sizeof(char*));
+        if (NULL == tmp) {
+            return PMIX_ERR_OUT_OF_RESOURCE;
+        }
+        *argv = tmp;
+    }
+    if (NULL == ((*argv)[n] = strdup(arg))) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    (*argv)[n + 1] = NULL;
+    *argc = n + 1;
+    return PMIX_SUCCESS;
+}
+
 static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names)
 {
     int i, j, k, len;
@@ -664,7 +694,7 @@ static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names)
     char *orig, *suffix;
     bool found_range = false;
     bool more_to_come = false;
-    int num_digits;
+    int num_digits, nnames = 0;
 
     /* set the default */
     *names = NULL;
@@ -759,7 +789,7 @@ static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names)
                                  "regex:extract:nodes: parsing range %s %s %s",
                                  base, base + i, suffix));
 
-            ret = regex_parse_value_ranges(base, base + i, num_digits, suffix, names);
+            ret = regex_parse_value_ranges(base, base + i, num_digits, suffix, names, &nnames);
             if (NULL != suffix) {
                 free(suffix);
             }
@@ -775,7 +805,7 @@ static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names)
             }
         } else {
             /* If we didn't find a range, just add the value */
-            if(PMIX_SUCCESS != (ret = pmix_argv_append_nosize(names, base))) {
+            if(PMIX_SUCCESS != (ret = regex_argv_append(names, &nnames, base))) {
                 PMIX_ERROR_LOG(ret);
                 free(orig);
                 return ret;
@@ -804,7 +834,7 @@ static pmix_status_t pmix_regex_extract_nodes(char *regexp, char ***names)
  */
 static pmix_status_t regex_parse_value_ranges(char *base, char *ranges,
                                               int num_digits, char *suffix,
-                                              char ***names)
+                                              char ***names, int *nnames)
 {
     int i, len;
     pmix_status_t ret;
@@ -816,7 +846,7 @@ static pmix_status_t regex_parse_value_ranges(char *base, char *ranges,
     for (orig = start = ranges, i = 0; i < len; ++i) {
         if (',' == ranges[i]) {
             ranges[i] = '\0';
-            ret = regex_parse_value_range(base, start, num_digits, suffix, names);
+            ret = regex_parse_value_range(base, start, num_digits, suffix, names, nnames);
             if (PMIX_SUCCESS != ret) {
                 PMIX_ERROR_LOG(ret);
                 return ret;
@@ -832,7 +862,7 @@ static pmix_status_t regex_parse_value_ranges(char *base, char *ranges,
         PMIX_OUTPUT_VERBOSE((1, pmix_globals.debug_output,
                              "regex:parse:ranges: parse range %s (2)", start));
 
-        ret = regex_parse_value_range(base, start, num_digits, suffix, names);
+        ret = regex_parse_value_range(base, start, num_digits, suffix, names, nnames);
         if (PMIX_SUCCESS != ret) {
             PMIX_ERROR_LOG(ret);
             return ret;
@@ -854,7 +884,7 @@ static pmix_status_t regex_parse_value_ranges(char *base, char *ranges,
  */
 static pmix_status_t regex_parse_value_range(char *base, char *range,
                                              int num_digits, char *suffix,
-                                             char ***names)
+                                             char ***names, int *nnames)
 {
     char *str, tmp[132];
     size_t i, k, start, end;
@@ -945,7 +975,7 @@ static pmix_status_t regex_parse_value_range(char *base, char *range,
         if (NULL != suffix) {
             strcat(str, suffix);
         }
-        ret = pmix_argv_append_nosize(names, str);
+        ret = regex_argv_append(names, nnames, str);
         if(PMIX_SUCCESS != ret) {
             PMIX_ERROR_LOG(ret);
             free(str);
@@ -960,46 +990,63 @@ static pmix_status_t regex_parse_value_range(char *base, char *range,
 
 static pmix_status_t pmix_regex_extract_ppn(char *regexp, char ***procs)
 {
-    char **rngs, **nds, *t, **ps=NULL;
-    int i, j, k, start, end;
+    char **rngs, *nds, *nd, *next, *t, **ps=NULL, tmp[32];
+    int i, k, start, end, nps, nprocs = 0;
+    pmix_status_t rc = PMIX_SUCCESS;
 
-    /* split on semi-colons for nodes */
-    nds = pmix_argv_split(regexp, ';');
-    for (j=0; NULL != nds[j]; j++) {
+    /* walk the semi-colon separated nodes in place - splitting
+     * them into an argv first costs more than the parsing */
+    if (NULL == (nds = strdup(regexp))) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (nd = nds; NULL != nd; nd = next) {
+        if (NULL != (next = strchr(nd, ';'))) {
+            *next = '\0';
+            ++next;
+        }
+        if ('\0' == *nd) {
+            /* pmix_argv_split skips empty fields */
+            continue;
+        }
         /* for each node, split it by comma */
-        rngs = pmix_argv_split(nds[j], ',');
+        rngs = pmix_argv_split(nd, ',');
+        nps = 0;
         /* parse each element */
-        for (i=0; NULL != rngs[i]; i++) {
+        for (i=0; NULL != rngs[i] && PMIX_SUCCESS == rc; i++) {
             /* look for a range */
             if (NULL == (t = strchr(rngs[i], '-'))) {
                 /* just one value */
-                pmix_argv_append_nosize(&ps, rngs[i]);
+                rc = regex_argv_append(&ps, &nps, rngs[i]);
             } else {
                 /* handle the range */
                 *t = '\0';
                 start = strtol(rngs[i], NULL, 10);
                 ++t;
                 end = strtol(t, NULL, 10);
-                for (k=start; k <= end; k++) {
-                    if (0 > asprintf(&t, "%d", k)) {
-                        pmix_argv_free(nds);
-                        pmix_argv_free(rngs);
-                        return PMIX_ERR_NOMEM;
-                    }
-                    pmix_argv_append_nosize(&ps, t);
-                    free(t);
+                for (k=start; k <= end && PMIX_SUCCESS == rc; k++) {
+                    snprintf(tmp, sizeof(tmp), "%d", k);
+                    rc = regex_argv_append(&ps, &nps, tmp);
                 }
             }
         }
         pmix_argv_free(rngs);
+        if (PMIX_SUCCESS != rc) {
+            pmix_argv_free(ps);
+            free(nds);
+            return PMIX_ERR_NOMEM;
+        }
         /* create the node entry */
         t = pmix_argv_join(ps, ',');
-        pmix_argv_append_nosize(procs, t);
+        rc = regex_argv_append(procs, &nprocs, t);
         free(t);
         pmix_argv_free(ps);
         ps = NULL;
+        if (PMIX_SUCCESS != rc) {
+            free(nds);
+            return PMIX_ERR_NOMEM;
+        }
     }
 
-    pmix_argv_free(nds);
+    free(nds);
     return PMIX_SUCCESS;
 }
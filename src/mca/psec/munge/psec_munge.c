@@ -23,8 +23,11 @@
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>
 #endif
+#include <time.h>
 #include <munge.h>
 
+#include "src/class/pmix_hash_table.h"
+#include "src/class/pmix_list.h"
 #include "src/threads/threads.h"
 #include "src/mca/psec/psec.h"
 #include "psec_munge.h"
@@ -48,10 +51,36 @@ pmix_psec_module_t pmix_munge_module = {
     .validate_cred = validate_cred
 };
 
+/* a credential munged has already vouched for */
+typedef struct {
+    pmix_list_item_t super;
+    char *cred;
+    size_t len;
+    uid_t uid;
+    gid_t gid;
+    time_t expires;         // encode time + TTL, after which munged would reject it
+} munge_cached_t;
+static void mccon(munge_cached_t *p)
+{
+    p->cred = NULL;
+}
+static void mcdes(munge_cached_t *p)
+{
+    if (NULL != p->cred) {
+        free(p->cred);
+    }
+}
+static PMIX_CLASS_INSTANCE(munge_cached_t,
+                           pmix_list_item_t,
+                           mccon, mcdes);
+
 static pmix_lock_t lock;
 static char *mycred = NULL;
+static time_t mycred_time = 0;
 static bool initialized = false;
 static bool refresh = false;
+static pmix_list_t cache;           // munge_cached_t, oldest first
+static pmix_hash_table_t cacheidx;  // cache entries by credential string
 
 static pmix_status_t munge_init(void)
 {
@@ -62,6 +91,9 @@ static pmix_status_t munge_init(void)
 
     PMIX_CONSTRUCT_LOCK(&lock);
     lock.active = false;
+    PMIX_CONSTRUCT(&cache, pmix_list_t);
+    PMIX_CONSTRUCT(&cacheidx, pmix_hash_table_t);
+    pmix_hash_table_init(&cacheidx, 64);
 
     /* attempt to get a credential as a way of checking that
      * the munge server is available - cache the credential
@@ -73,6 +105,7 @@ static pmix_status_t munge_init(void)
                             munge_strerror(rc));
         return PMIX_ERR_SERVER_NOT_AVAIL;
     }
+    mycred_time = time(NULL);
 
     initialized = true;
 
@@ -91,6 +124,8 @@ static void munge_finalize(void)
             mycred = NULL;
         }
     }
+    PMIX_DESTRUCT(&cacheidx);
+    PMIX_LIST_DESTRUCT(&cache);
     PMIX_RELEASE_THREAD(&lock);
     PMIX_DESTRUCT_LOCK(&lock);
 }
@@ -138,7 +173,8 @@ static pmix_status_t create_cred(struct pmix_peer_t *peer,
     }
 
     if (initialized) {
-        if (!refresh) {
+        if (!refresh ||
+            (0 < pmix_psec_munge_reuse && time(NULL) < mycred_time + pmix_psec_munge_reuse)) {
             refresh = true;
             cred->bytes = strdup(mycred);
             cred->size = strlen(mycred) + 1;
@@ -155,6 +191,7 @@ static pmix_status_t create_cred(struct pmix_peer_t *peer,
                 PMIX_RELEASE_THREAD(&lock);
                 return PMIX_ERR_NOT_SUPPORTED;
             }
+            mycred_time = time(NULL);
             cred->bytes = strdup(mycred);
             cred->size = strlen(mycred) + 1;
         }
@@ -173,6 +210,69 @@ static pmix_status_t create_cred(struct pmix_peer_t *peer,
     return PMIX_SUCCESS;
 }
 
+static bool cache_lookup(const pmix_byte_object_t *cred, uid_t *uid, gid_t *gid)
+{
+    munge_cached_t *mc;
+    bool found = false;
+
+    PMIX_ACQUIRE_THREAD(&lock);
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&cacheidx, cred->bytes,
+                                                      cred->size, (void**)&mc)) {
+        if (time(NULL) < mc->expires) {
+            *uid = mc->uid;
+            *gid = mc->gid;
+            found = true;
+        } else {
+            pmix_hash_table_remove_value_ptr(&cacheidx, mc->cred, mc->len);
+            pmix_list_remove_item(&cache, &mc->super);
+            PMIX_RELEASE(mc);
+        }
+    }
+    PMIX_RELEASE_THREAD(&lock);
+    return found;
+}
+
+static void cache_add(const pmix_byte_object_t *cred, munge_ctx_t ctx,
+                      uid_t uid, gid_t gid)
+{
+    munge_cached_t *mc, *old;
+    time_t encoded;
+    int ttl;
+
+    if (EMUNGE_SUCCESS != munge_ctx_get(ctx, MUNGE_OPT_ENCODE_TIME, &encoded) ||
+        EMUNGE_SUCCESS != munge_ctx_get(ctx, MUNGE_OPT_TTL, &ttl)) {
+        return;
+    }
+    mc = PMIX_NEW(munge_cached_t);
+    if (NULL == mc || NULL == (mc->cred = (char*)malloc(cred->size))) {
+        if (NULL != mc) {
+            PMIX_RELEASE(mc);
+        }
+        return;
+    }
+    memcpy(mc->cred, cred->bytes, cred->size);
+    mc->len = cred->size;
+    mc->uid = uid;
+    mc->gid = gid;
+    mc->expires = encoded + ttl;
+
+    PMIX_ACQUIRE_THREAD(&lock);
+    if (PMIX_SUCCESS == pmix_hash_table_set_value_ptr(&cacheidx, mc->cred, mc->len, mc)) {
+        pmix_list_append(&cache, &mc->super);
+        mc = NULL;
+    }
+    /* evict the oldest beyond the bound */
+    while ((int)pmix_list_get_size(&cache) > pmix_psec_munge_cache_size) {
+        old = (munge_cached_t*)pmix_list_remove_first(&cache);
+        pmix_hash_table_remove_value_ptr(&cacheidx, old->cred, old->len);
+        PMIX_RELEASE(old);
+    }
+    PMIX_RELEASE_THREAD(&lock);
+    if (NULL != mc) {
+        PMIX_RELEASE(mc);
+    }
+}
+
 static pmix_status_t validate_cred(struct pmix_peer_t *peer,
                                    const pmix_info_t directives[], size_t ndirs,
                                    pmix_info_t **info, size_t *ninfo,
@@ -182,6 +282,7 @@ static pmix_status_t validate_cred(struct pmix_peer_t *peer,
     uid_t euid;
     gid_t egid;
     munge_err_t rc;
+    munge_ctx_t ctx = NULL;
     bool takeus;
     char **types;
     size_t n, m;
@@ -214,12 +315,28 @@ static pmix_status_t validate_cred(struct pmix_peer_t *peer,
         }
     }
 
-    /* parse the inbound string */
-    if (EMUNGE_SUCCESS != (rc = munge_decode(cred->bytes, NULL, NULL, NULL, &euid, &egid))) {
+    if (0 < pmix_psec_munge_cache_size && cache_lookup(cred, &euid, &egid)) {
         pmix_output_verbose(2, pmix_globals.debug_output,
-                            "psec: munge failed to decode credential: %s",
-                            munge_strerror(rc));
-        return PMIX_ERR_INVALID_CRED;
+                            "psec: munge credential found in cache");
+    } else {
+        /* the context tells us when the credential expires */
+        if (0 < pmix_psec_munge_cache_size) {
+            ctx = munge_ctx_create();
+        }
+        /* parse the inbound string */
+        if (EMUNGE_SUCCESS != (rc = munge_decode(cred->bytes, ctx, NULL, NULL, &euid, &egid))) {
+            pmix_output_verbose(2, pmix_globals.debug_output,
+                                "psec: munge failed to decode credential: %s",
+                                munge_strerror(rc));
+            if (NULL != ctx) {
+                munge_ctx_destroy(ctx);
+            }
+            return PMIX_ERR_INVALID_CRED;
+        }
+        if (NULL != ctx) {
+            cache_add(cred, ctx, euid, egid);
+            munge_ctx_destroy(ctx);
+        }
     }
 
     /* check uid */
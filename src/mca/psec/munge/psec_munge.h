@@ -20,6 +20,11 @@ BEGIN_C_DECLS
 PMIX_EXPORT extern pmix_psec_base_component_t mca_psec_munge_component;
 extern pmix_psec_module_t pmix_munge_module;
 
+/* #validated credentials a server remembers (0 => decode every one) */
+extern int pmix_psec_munge_cache_size;
+/* seconds a client reuses one credential (0 => a new one per use) */
+extern int pmix_psec_munge_reuse;
+
 END_C_DECLS
 
 #endif
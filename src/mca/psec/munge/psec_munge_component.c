@@ -33,6 +33,7 @@
 #include "src/mca/psec/psec.h"
 #include "psec_munge.h"
 
+static pmix_status_t component_register(void);
 static pmix_status_t component_open(void);
 static pmix_status_t component_close(void);
 static pmix_status_t component_query(pmix_mca_base_module_t **module, int *priority);
@@ -54,6 +55,7 @@ pmix_psec_base_component_t mca_psec_munge_component = {
                                    PMIX_RELEASE_VERSION),
 
         /* Component open and close functions */
+        .pmix_mca_register_component_params = component_register,
         .pmix_mca_open_component = component_open,
         .pmix_mca_close_component = component_close,
         .pmix_mca_query_component = component_query,
@@ -66,6 +68,35 @@ pmix_psec_base_component_t mca_psec_munge_component = {
 };
 
 
+int pmix_psec_munge_cache_size = 0;
+int pmix_psec_munge_reuse = 0;
+
+static int component_register(void)
+{
+    pmix_mca_base_component_t *component = &mca_psec_munge_component.base;
+
+    (void)pmix_mca_base_component_var_register(component, "cache_size",
+                                               "Number of validated credentials a server remembers so that "
+                                               "presenting one again within its TTL skips munged (default: 0 - "
+                                               "every credential is decoded). A remembered credential is not "
+                                               "checked for replay",
+                                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                               PMIX_INFO_LVL_4,
+                                               PMIX_MCA_BASE_VAR_SCOPE_LOCAL,
+                                               &pmix_psec_munge_cache_size);
+
+    (void)pmix_mca_base_component_var_register(component, "reuse",
+                                               "Seconds a client presents the same credential on all its "
+                                               "connections before encoding a new one (default: 0 - a new one "
+                                               "per connection). Must be less than the munge TTL, and the "
+                                               "servers must set psec_munge_cache_size",
+                                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                               PMIX_INFO_LVL_4,
+                                               PMIX_MCA_BASE_VAR_SCOPE_LOCAL,
+                                               &pmix_psec_munge_reuse);
+    return PMIX_SUCCESS;
+}
+
 static int component_open(void)
 {
     return PMIX_SUCCESS;
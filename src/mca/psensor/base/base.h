@@ -55,5 +55,9 @@ PMIX_EXPORT pmix_status_t pmix_psensor_base_start(pmix_peer_t *requestor, pmix_s
 PMIX_EXPORT pmix_status_t pmix_psensor_base_stop(pmix_peer_t *requestor,
                                                  char *id);
 
+PMIX_EXPORT pmix_status_t pmix_psensor_base_query(const char *key,
+                                                  const pmix_query_t *query,
+                                                  pmix_value_t *val);
+
 END_C_DECLS
 #endif
@@ -40,7 +40,8 @@
  */
 pmix_psensor_base_module_t pmix_psensor = {
     pmix_psensor_base_start,
-    pmix_psensor_base_stop
+    pmix_psensor_base_stop,
+    pmix_psensor_base_query
 };
 pmix_psensor_base_t pmix_psensor_base = {{{0}}};
 
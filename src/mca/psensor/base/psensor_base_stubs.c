@@ -77,3 +77,23 @@ pmix_status_t pmix_psensor_base_stop(pmix_peer_t *requestor,
 
     return ret;
 }
+
+pmix_status_t pmix_psensor_base_query(const char *key,
+                                      const pmix_query_t *query,
+                                      pmix_value_t *val)
+{
+    pmix_psensor_active_module_t *mod;
+    pmix_status_t rc;
+
+    /* the first module that can answer it does */
+    PMIX_LIST_FOREACH(mod, &pmix_psensor_base.actives, pmix_psensor_active_module_t) {
+        if (NULL != mod->module->query) {
+            rc = mod->module->query(key, query, val);
+            if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+                return rc;
+            }
+        }
+    }
+
+    return PMIX_ERR_TAKE_NEXT_OPTION;
+}
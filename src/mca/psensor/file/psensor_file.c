@@ -38,6 +38,9 @@
 #endif
 #include <sys/stat.h>
 #include <sys/types.h>
+#ifdef HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#endif
 
 #include "src/class/pmix_list.h"
 #include "src/include/pmix_globals.h"
@@ -77,6 +80,9 @@ typedef struct {
     size_t last_size;
     time_t last_access;
     time_t last_mod;
+    int wd;             // inotify watch, -1 when not armed
+    uint32_t mask;      // inotify events that count as activity
+    bool changed;       // activity seen since the last sample
     uint32_t ndrops;
     uint32_t nmisses;
     pmix_status_t error;
@@ -98,6 +104,9 @@ static void ft_constructor(file_tracker_t *ft)
     ft->last_size = 0;
     ft->last_access = 0;
     ft->last_mod = 0;
+    ft->wd = -1;
+    ft->mask = 0;
+    ft->changed = false;
     ft->ndrops = 0;
     ft->nmisses = 0;
     ft->error = PMIX_SUCCESS;
@@ -154,14 +163,108 @@ PMIX_CLASS_INSTANCE(file_caddy_t,
 
 static void file_sample(int sd, short args, void *cbdata);
 
+#ifdef HAVE_SYS_INOTIFY_H
+/* rather than stat'ing each file every window - a steady load on
+ * the metadata servers of a parallel filesystem - we ask the kernel
+ * to tell us when the file is touched. The watch is one-shot: the
+ * first event of a window is all we need, and the watch is re-armed
+ * when the window closes, so a busy writer doesn't flood us. Files
+ * that can't be watched (not there yet, out of watches, filesystem
+ * without support) are polled as before */
+static void file_notified(int fd, short args, void *cbdata)
+{
+    char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    const struct inotify_event *ev;
+    file_tracker_t *ft;
+    ssize_t len;
+    char *ptr;
+
+    while (0 < (len = read(fd, buf, sizeof(buf)))) {
+        for (ptr = buf; ptr < buf + len; ptr += sizeof(struct inotify_event) + ev->len) {
+            ev = (const struct inotify_event*)ptr;
+            PMIX_LIST_FOREACH(ft, &mca_psensor_file_component.trackers, file_tracker_t) {
+                if (ft->wd != ev->wd) {
+                    continue;
+                }
+                /* any event means the one-shot watch is gone */
+                ft->wd = -1;
+                if (ev->mask & ft->mask) {
+                    ft->changed = true;
+                } else if (!(ev->mask & IN_IGNORED)) {
+                    /* someone else's event on a shared watch - we
+                     * still need to hear about ours */
+                    ft->wd = inotify_add_watch(fd, ft->file, ft->mask | IN_ONESHOT | IN_MASK_ADD);
+                }
+            }
+        }
+    }
+}
+
+static bool watch(file_tracker_t *ft)
+{
+    if (0 > mca_psensor_file_component.notify_fd) {
+        return false;
+    }
+    ft->wd = inotify_add_watch(mca_psensor_file_component.notify_fd, ft->file,
+                               ft->mask | IN_ONESHOT | IN_MASK_ADD);
+    return (0 <= ft->wd);
+}
+
+static void unwatch(file_tracker_t *ft)
+{
+    file_tracker_t *other;
+
+    if (0 > ft->wd) {
+        return;
+    }
+    /* the kernel shares one watch among all trackers of a file */
+    PMIX_LIST_FOREACH(other, &mca_psensor_file_component.trackers, file_tracker_t) {
+        if (other != ft && other->wd == ft->wd) {
+            ft->wd = -1;
+            return;
+        }
+    }
+    inotify_rm_watch(mca_psensor_file_component.notify_fd, ft->wd);
+    ft->wd = -1;
+}
+#else
+static bool watch(file_tracker_t *ft)
+{
+    return false;
+}
+
+static void unwatch(file_tracker_t *ft)
+{
+}
+#endif
+
 static void add_tracker(int sd, short flags, void *cbdata)
 {
     file_tracker_t *ft = (file_tracker_t*)cbdata;
 
     PMIX_ACQUIRE_OBJECT(fd);
 
+#ifdef HAVE_SYS_INOTIFY_H
+    if (!mca_psensor_file_component.notify_active) {
+        mca_psensor_file_component.notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (0 <= mca_psensor_file_component.notify_fd) {
+            pmix_event_assign(&mca_psensor_file_component.notify_ev, pmix_psensor_base.evbase,
+                              mca_psensor_file_component.notify_fd, EV_READ|EV_PERSIST,
+                              file_notified, NULL);
+            pmix_event_add(&mca_psensor_file_component.notify_ev, NULL);
+            mca_psensor_file_component.notify_active = true;
+        }
+    }
+    if (ft->file_size || ft->file_mod) {
+        ft->mask = IN_MODIFY;
+    } else {
+        ft->mask = IN_ACCESS;
+    }
+#endif
+
     /* add the tracker to our list */
     pmix_list_append(&mca_psensor_file_component.trackers, &ft->super);
+    (void)watch(ft);
 
     /* setup the timer event */
     pmix_event_evtimer_set(pmix_psensor_base.evbase, &ft->ev,
@@ -244,6 +347,7 @@ static void del_tracker(int sd, short flags, void *cbdata)
         }
         if (NULL == cd->id ||
             (NULL != ft->id && 0 == strcmp(ft->id, cd->id))) {
+            unwatch(ft);
             pmix_list_remove_item(&mca_psensor_file_component.trackers, &ft->super);
             PMIX_RELEASE(ft);
         }
@@ -292,6 +396,20 @@ static void file_sample(int sd, short args, void *cbdata)
                          pmix_globals.myid.nspace, pmix_globals.myid.rank,
                          ft->file));
 
+    /* if the file is being watched, we already know */
+    if (0 <= ft->wd || ft->changed) {
+        if (ft->changed) {
+            ft->nmisses = 0;
+            ft->changed = false;
+        } else {
+            ft->nmisses++;
+        }
+        if (0 > ft->wd) {
+            (void)watch(ft);
+        }
+        goto check;
+    }
+
     /* stat the file and get its info */
     if (0 > stat(ft->file, &buf)) {
         /* cannot stat file */
@@ -331,7 +449,10 @@ static void file_sample(int sd, short args, void *cbdata)
             ft->last_mod = buf.st_mtime;
         }
     }
+    /* watch it from here on if we can */
+    (void)watch(ft);
 
+  check:
     PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
                          "[%s:%d] sampled file %s misses %d",
                          pmix_globals.myid.nspace, pmix_globals.myid.rank,
@@ -343,6 +464,7 @@ static void file_sample(int sd, short args, void *cbdata)
                            ft->file, ft->last_size, ctime(&ft->last_access), ctime(&ft->last_mod));
         }
         /* stop monitoring this client */
+        unwatch(ft);
         pmix_list_remove_item(&mca_psensor_file_component.trackers, &ft->super);
         /* generate an event */
         pmix_strncpy(source.nspace, ft->requestor->info->pname.nspace, PMIX_MAX_NSLEN);
@@ -27,6 +27,9 @@ BEGIN_C_DECLS
 typedef struct {
     pmix_psensor_base_component_t super;
     pmix_list_t trackers;
+    int notify_fd;              // inotify instance shared by all trackers, -1 => poll
+    pmix_event_t notify_ev;
+    bool notify_active;
 } pmix_psensor_file_component_t;
 
 PMIX_EXPORT extern pmix_psensor_file_component_t mca_psensor_file_component;
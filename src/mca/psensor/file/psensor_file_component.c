@@ -11,6 +11,10 @@
 #include <src/include/pmix_config.h>
 #include <pmix_common.h>
 
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
 #include "src/class/pmix_list.h"
 
 #include "src/mca/psensor/base/base.h"
@@ -47,6 +51,8 @@ pmix_psensor_file_component_t mca_psensor_file_component = {
 static int psensor_file_open(void)
 {
     PMIX_CONSTRUCT(&mca_psensor_file_component.trackers, pmix_list_t);
+    mca_psensor_file_component.notify_fd = -1;
+    mca_psensor_file_component.notify_active = false;
     return PMIX_SUCCESS;
 }
 
@@ -65,5 +71,13 @@ static int psensor_file_query(pmix_mca_base_module_t **module, int *priority)
 static int psensor_file_close(void)
 {
     PMIX_LIST_DESTRUCT(&mca_psensor_file_component.trackers);
+    if (mca_psensor_file_component.notify_active) {
+        pmix_event_del(&mca_psensor_file_component.notify_ev);
+        mca_psensor_file_component.notify_active = false;
+    }
+    if (0 <= mca_psensor_file_component.notify_fd) {
+        close(mca_psensor_file_component.notify_fd);
+        mca_psensor_file_component.notify_fd = -1;
+    }
     return PMIX_SUCCESS;
 }
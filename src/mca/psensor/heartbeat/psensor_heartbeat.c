@@ -47,16 +47,26 @@ pmix_psensor_base_module_t pmix_psensor_heartbeat_module = {
     .stop = heartbeat_stop
 };
 
+/* a proc watched by an nspace-wide tracker */
+typedef struct {
+    pmix_rank_t rank;
+    int bit;                // index of its bit in the beats bitmap
+    bool stopped;
+} pmix_heartbeat_member_t;
+
 /* tracker object */
 typedef struct {
     pmix_list_item_t super;
     pmix_peer_t *requestor;
     char *id;
-    bool event_active;
-    pmix_event_t ev;
     pmix_event_t cdev;
     struct timeval tv;
-    uint32_t nbeats;
+    uint64_t expire;        // wheel tick at which the window closes
+    int bit;                // index of our bit in the beats bitmap
+    uint64_t nrecvd;        // requestor's message count at the last check
+    pmix_namespace_t *nptr; // non-NULL if watching all local procs of the nspace
+    pmix_heartbeat_member_t *members;   // sorted by rank
+    size_t nmembers;
     uint32_t ndrops;
     uint32_t nmissed;
     pmix_status_t error;
@@ -70,10 +80,14 @@ static void ft_constructor(pmix_heartbeat_trkr_t *ft)
 {
     ft->requestor = NULL;
     ft->id = NULL;
-    ft->event_active = false;
     ft->tv.tv_sec = 0;
     ft->tv.tv_usec = 0;
-    ft->nbeats = 0;
+    ft->expire = 0;
+    ft->bit = -1;
+    ft->nrecvd = 0;
+    ft->nptr = NULL;
+    ft->members = NULL;
+    ft->nmembers = 0;
     ft->ndrops = 0;
     ft->nmissed = 0;
     ft->error = PMIX_SUCCESS;
@@ -90,8 +104,11 @@ static void ft_destructor(pmix_heartbeat_trkr_t *ft)
     if (NULL != ft->id) {
         free(ft->id);
     }
-    if (ft->event_active) {
-        pmix_event_del(&ft->ev);
+    if (NULL != ft->nptr) {
+        PMIX_RELEASE(ft->nptr);
+    }
+    if (NULL != ft->members) {
+        free(ft->members);
     }
     if (NULL != ft->info) {
         PMIX_INFO_FREE(ft->info, ft->ninfo);
@@ -146,22 +163,131 @@ PMIX_CLASS_INSTANCE(pmix_psensor_beat_t,
                     pmix_object_t,
                     bcon, bdes);
 
-static void check_heartbeat(int fd, short dummy, void *arg);
+/* holds the info given with an aggregated alert until
+ * the event has been sent */
+typedef struct {
+    pmix_object_t super;
+    pmix_heartbeat_trkr_t *ft;
+    pmix_info_t *info;
+    size_t ninfo;
+} pmix_heartbeat_alert_t;
+
+static void acon(pmix_heartbeat_alert_t *p)
+{
+    p->ft = NULL;
+    p->info = NULL;
+    p->ninfo = 0;
+}
+static void ades(pmix_heartbeat_alert_t *p)
+{
+    if (NULL != p->ft) {
+        PMIX_RELEASE(p->ft);
+    }
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_heartbeat_alert_t,
+                    pmix_object_t,
+                    acon, ades);
+
+static int member_cmp(const void *a, const void *b)
+{
+    const pmix_heartbeat_member_t *ma = (const pmix_heartbeat_member_t*)a;
+    const pmix_heartbeat_member_t *mb = (const pmix_heartbeat_member_t*)b;
+
+    if (ma->rank < mb->rank) {
+        return -1;
+    }
+    return (ma->rank > mb->rank) ? 1 : 0;
+}
+
+static void tick(int fd, short dummy, void *arg);
+
+/* file the tracker in the wheel slot covering its expiry */
+static void schedule(pmix_heartbeat_trkr_t *ft)
+{
+    uint64_t now = mca_psensor_heartbeat_component.tick;
+    uint64_t delta = ft->expire - now;
+    pmix_list_t *slot;
+
+    if (delta < PMIX_HEARTBEAT_WHEEL_SLOTS) {
+        slot = &mca_psensor_heartbeat_component.wheel[0][ft->expire & (PMIX_HEARTBEAT_WHEEL_SLOTS-1)];
+    } else if (delta < (PMIX_HEARTBEAT_WHEEL_SLOTS-1) * PMIX_HEARTBEAT_WHEEL_SLOTS) {
+        slot = &mca_psensor_heartbeat_component.wheel[1][(ft->expire >> PMIX_HEARTBEAT_WHEEL_BITS) & (PMIX_HEARTBEAT_WHEEL_SLOTS-1)];
+    } else {
+        /* park it in the furthest outer bucket - it is refiled
+         * each time that bucket cascades until it comes in range */
+        slot = &mca_psensor_heartbeat_component.wheel[1][((now >> PMIX_HEARTBEAT_WHEEL_BITS) - 1) & (PMIX_HEARTBEAT_WHEEL_SLOTS-1)];
+    }
+    pmix_list_append(slot, &ft->super);
+}
+
+/* the number of messages the requestor has sent us. Any message
+ * counts as a beat, so a busy proc need not send explicit ones.
+ * The count is only advanced by the progress thread as messages
+ * are delivered - a stale read just means the activity is seen
+ * at the next window */
+static inline uint64_t requestor_msgs(pmix_heartbeat_trkr_t *ft)
+{
+    return *(volatile uint64_t*)&ft->requestor->msgs_recvd;
+}
 
 static void add_tracker(int sd, short flags, void *cbdata)
 {
     pmix_heartbeat_trkr_t *ft = (pmix_heartbeat_trkr_t*)cbdata;
+    void *old;
+    struct timeval tv = {1, 0};
+
+    size_t n;
 
     PMIX_ACQUIRE_OBJECT(ft);
 
-    /* add the tracker to our list */
-    pmix_list_append(&mca_psensor_heartbeat_component.trackers, &ft->super);
+    if (NULL != ft->nptr) {
+        /* one bit per member, all checked on the same tick */
+        for (n=0; n < ft->nmembers; n++) {
+            if (PMIX_SUCCESS != pmix_bitmap_find_and_set_first_unset_bit(&mca_psensor_heartbeat_component.inuse,
+                                                                          &ft->members[n].bit)) {
+                PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+                while (0 < n) {
+                    --n;
+                    pmix_bitmap_clear_bit(&mca_psensor_heartbeat_component.inuse, ft->members[n].bit);
+                }
+                PMIX_RELEASE(ft);
+                return;
+            }
+            pmix_bitmap_clear_bit(&mca_psensor_heartbeat_component.beats, ft->members[n].bit);
+        }
+        pmix_pointer_array_add(&mca_psensor_heartbeat_component.groups, ft);
+    } else {
+        if (PMIX_SUCCESS != pmix_bitmap_find_and_set_first_unset_bit(&mca_psensor_heartbeat_component.inuse,
+                                                                      &ft->bit)) {
+            PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+            PMIX_RELEASE(ft);
+            return;
+        }
+        pmix_bitmap_clear_bit(&mca_psensor_heartbeat_component.beats, ft->bit);
+        ft->nrecvd = requestor_msgs(ft);
+        /* beats from a requestor go to its first tracker */
+        if (PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&mca_psensor_heartbeat_component.peers,
+                                                             ft->requestor->index, &old)) {
+            pmix_hash_table_set_value_uint32(&mca_psensor_heartbeat_component.peers,
+                                             ft->requestor->index, ft);
+        }
+    }
 
-    /* setup the timer event */
-    pmix_event_evtimer_set(pmix_psensor_base.evbase, &ft->ev,
-                           check_heartbeat, ft);
-    pmix_event_evtimer_add(&ft->ev, &ft->tv);
-    ft->event_active = true;
+    /* add the tracker to the wheel */
+    ft->expire = mca_psensor_heartbeat_component.tick + ft->tv.tv_sec;
+    schedule(ft);
+    ++mca_psensor_heartbeat_component.ntrackers;
+
+    /* start the wheel turning */
+    if (!mca_psensor_heartbeat_component.timer_active) {
+        pmix_event_assign(&mca_psensor_heartbeat_component.timer, pmix_psensor_base.evbase,
+                          -1, EV_PERSIST, tick, NULL);
+        pmix_event_add(&mca_psensor_heartbeat_component.timer, &tv);
+        mca_psensor_heartbeat_component.timer_active = true;
+    }
 }
 
 static pmix_status_t heartbeat_start(pmix_peer_t *requestor, pmix_status_t error,
@@ -171,6 +297,8 @@ static pmix_status_t heartbeat_start(pmix_peer_t *requestor, pmix_status_t error
     pmix_heartbeat_trkr_t *ft;
     size_t n;
     pmix_ptl_posted_recv_t *rcv;
+    pmix_rank_info_t *info;
+    bool nspace = false;
 
     PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
                          "[%s:%d] checking heartbeat monitoring for requestor %s:%d",
@@ -196,6 +324,8 @@ static pmix_status_t heartbeat_start(pmix_peer_t *requestor, pmix_status_t error
             ft->ndrops = directives[n].value.data.uint32;
         } else if (0 == strcmp(directives[n].key, PMIX_RANGE)) {
             ft->range = directives[n].value.data.range;
+        } else if (0 == strcmp(directives[n].key, PMIX_MONITOR_HEARTBEAT_NSPACE)) {
+            nspace = PMIX_INFO_TRUE(&directives[n]);
         }
     }
 
@@ -205,6 +335,29 @@ static pmix_status_t heartbeat_start(pmix_peer_t *requestor, pmix_status_t error
         return PMIX_ERR_BAD_PARAM;
     }
 
+    if (nspace) {
+        /* take the local ranks now - we are in the server's
+         * thread, which owns the nspace */
+        if (NULL == requestor->nptr || 0 == pmix_list_get_size(&requestor->nptr->ranks)) {
+            PMIX_RELEASE(ft);
+            return PMIX_ERR_BAD_PARAM;
+        }
+        ft->members = (pmix_heartbeat_member_t*)calloc(pmix_list_get_size(&requestor->nptr->ranks),
+                                                       sizeof(pmix_heartbeat_member_t));
+        if (NULL == ft->members) {
+            PMIX_RELEASE(ft);
+            return PMIX_ERR_NOMEM;
+        }
+        PMIX_LIST_FOREACH(info, &requestor->nptr->ranks, pmix_rank_info_t) {
+            ft->members[ft->nmembers].rank = info->pname.rank;
+            ft->members[ft->nmembers].bit = -1;
+            ++ft->nmembers;
+        }
+        qsort(ft->members, ft->nmembers, sizeof(pmix_heartbeat_member_t), member_cmp);
+        PMIX_RETAIN(requestor->nptr);
+        ft->nptr = requestor->nptr;
+    }
+
     /* if the recv hasn't been posted, so so now */
     if (!mca_psensor_heartbeat_component.recv_active) {
         /* setup to receive heartbeats */
@@ -225,22 +378,82 @@ static pmix_status_t heartbeat_start(pmix_peer_t *requestor, pmix_status_t error
     return PMIX_SUCCESS;
 }
 
+static void remove_tracker(pmix_list_t *slot, pmix_heartbeat_trkr_t *ft)
+{
+    pmix_heartbeat_trkr_t *other;
+    void *cur;
+    int i, j;
+    size_t n;
+
+    pmix_list_remove_item(slot, &ft->super);
+    --mca_psensor_heartbeat_component.ntrackers;
+
+    if (NULL != ft->nptr) {
+        for (n=0; n < ft->nmembers; n++) {
+            pmix_bitmap_clear_bit(&mca_psensor_heartbeat_component.inuse, ft->members[n].bit);
+            pmix_bitmap_clear_bit(&mca_psensor_heartbeat_component.beats, ft->members[n].bit);
+        }
+        for (i=0; i < mca_psensor_heartbeat_component.groups.size; i++) {
+            if (ft == pmix_pointer_array_get_item(&mca_psensor_heartbeat_component.groups, i)) {
+                pmix_pointer_array_set_item(&mca_psensor_heartbeat_component.groups, i, NULL);
+                break;
+            }
+        }
+        goto done;
+    }
+
+    pmix_bitmap_clear_bit(&mca_psensor_heartbeat_component.inuse, ft->bit);
+    pmix_bitmap_clear_bit(&mca_psensor_heartbeat_component.beats, ft->bit);
+
+    /* if we were receiving this requestor's beats, hand
+     * them to any other tracker it still has */
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&mca_psensor_heartbeat_component.peers,
+                                                         ft->requestor->index, &cur) &&
+        cur == (void*)ft) {
+        pmix_hash_table_remove_value_uint32(&mca_psensor_heartbeat_component.peers,
+                                            ft->requestor->index);
+        for (i=0; i < 2; i++) {
+            for (j=0; j < PMIX_HEARTBEAT_WHEEL_SLOTS; j++) {
+                PMIX_LIST_FOREACH(other, &mca_psensor_heartbeat_component.wheel[i][j], pmix_heartbeat_trkr_t) {
+                    if (other->requestor == ft->requestor) {
+                        pmix_hash_table_set_value_uint32(&mca_psensor_heartbeat_component.peers,
+                                                         ft->requestor->index, other);
+                        goto done;
+                    }
+                }
+            }
+        }
+    }
+
+  done:
+    if (0 == mca_psensor_heartbeat_component.ntrackers &&
+        mca_psensor_heartbeat_component.timer_active) {
+        pmix_event_del(&mca_psensor_heartbeat_component.timer);
+        mca_psensor_heartbeat_component.timer_active = false;
+    }
+    PMIX_RELEASE(ft);
+}
+
 static void del_tracker(int sd, short flags, void *cbdata)
 {
     heartbeat_caddy_t *cd = (heartbeat_caddy_t*)cbdata;
     pmix_heartbeat_trkr_t *ft, *ftnext;
+    int i, j;
 
     PMIX_ACQUIRE_OBJECT(cd);
 
-    /* remove the tracker from our list */
-    PMIX_LIST_FOREACH_SAFE(ft, ftnext, &mca_psensor_heartbeat_component.trackers, pmix_heartbeat_trkr_t) {
-        if (ft->requestor != cd->requestor) {
-            continue;
-        }
-        if (NULL == cd->id ||
-            (NULL != ft->id && 0 == strcmp(ft->id, cd->id))) {
-            pmix_list_remove_item(&mca_psensor_heartbeat_component.trackers, &ft->super);
-            PMIX_RELEASE(ft);
+    /* remove the tracker from the wheel */
+    for (i=0; i < 2; i++) {
+        for (j=0; j < PMIX_HEARTBEAT_WHEEL_SLOTS; j++) {
+            PMIX_LIST_FOREACH_SAFE(ft, ftnext, &mca_psensor_heartbeat_component.wheel[i][j], pmix_heartbeat_trkr_t) {
+                if (ft->requestor != cd->requestor) {
+                    continue;
+                }
+                if (NULL == cd->id ||
+                    (NULL != ft->id && 0 == strcmp(ft->id, cd->id))) {
+                    remove_tracker(&mca_psensor_heartbeat_component.wheel[i][j], ft);
+                }
+            }
         }
     }
     PMIX_RELEASE(cd);
@@ -273,24 +486,103 @@ static void opcbfunc(pmix_status_t status, void *cbdata)
     PMIX_RELEASE(ft);  // maintain accounting
 }
 
-/* this function automatically gets periodically called
- * by the event library so we can check on the state
- * of the various procs we are monitoring
- */
-static void check_heartbeat(int fd, short dummy, void *cbdata)
+static void alertcbfunc(pmix_status_t status, void *cbdata)
+{
+    pmix_heartbeat_alert_t *alert = (pmix_heartbeat_alert_t*)cbdata;
+
+    PMIX_RELEASE(alert);
+}
+
+/* check every member of an nspace-wide tracker, and report
+ * all those that newly missed the window in one event */
+static void check_group(pmix_heartbeat_trkr_t *ft)
+{
+    pmix_heartbeat_alert_t *alert;
+    pmix_data_array_t darray;
+    pmix_proc_t source, *procs;
+    pmix_status_t rc;
+    size_t n, nfailed;
+
+    procs = NULL;
+    nfailed = 0;
+    for (n=0; n < ft->nmembers; n++) {
+        if (pmix_bitmap_is_set_bit(&mca_psensor_heartbeat_component.beats, ft->members[n].bit)) {
+            ft->members[n].stopped = false;
+            pmix_bitmap_clear_bit(&mca_psensor_heartbeat_component.beats, ft->members[n].bit);
+        } else if (!ft->members[n].stopped) {
+            if (NULL == procs) {
+                PMIX_PROC_CREATE(procs, ft->nmembers - n);
+                if (NULL == procs) {
+                    PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+                    return;
+                }
+            }
+            PMIX_LOAD_PROCID(&procs[nfailed], ft->nptr->nspace, ft->members[n].rank);
+            ++nfailed;
+            ft->members[n].stopped = true;
+        }
+    }
+    if (0 == nfailed) {
+        return;
+    }
+
+    PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
+                         "[%s:%d] sensor:check_heartbeat %lu procs of nspace %s missed their window",
+                         pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                         (unsigned long)nfailed, ft->nptr->nspace));
+
+    alert = PMIX_NEW(pmix_heartbeat_alert_t);
+    PMIX_RETAIN(ft);
+    alert->ft = ft;
+    alert->ninfo = 1;
+    PMIX_INFO_CREATE(alert->info, alert->ninfo);
+    darray.type = PMIX_PROC;
+    darray.size = nfailed;
+    darray.array = procs;
+    PMIX_INFO_LOAD(&alert->info[0], PMIX_EVENT_AFFECTED_PROCS, &darray, PMIX_DATA_ARRAY);
+    PMIX_PROC_FREE(procs, nfailed);
+
+    /* the event comes from the job as a whole */
+    PMIX_LOAD_PROCID(&source, ft->nptr->nspace, PMIX_RANK_WILDCARD);
+    rc = PMIx_Notify_event(PMIX_MONITOR_HEARTBEAT_ALERT, &source,
+                           ft->range, alert->info, alert->ninfo, alertcbfunc, alert);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(alert);
+    }
+}
+
+/* check whether the proc behind a tracker beat during
+ * the window that just closed */
+static void check_heartbeat(pmix_heartbeat_trkr_t *ft)
 {
-    pmix_heartbeat_trkr_t *ft = (pmix_heartbeat_trkr_t*)cbdata;
     pmix_status_t rc;
     pmix_proc_t source;
+    uint64_t nrecvd;
 
-    PMIX_ACQUIRE_OBJECT(ft);
+    if (NULL != ft->nptr) {
+        check_group(ft);
+        return;
+    }
 
     PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
                          "[%s:%d] sensor:check_heartbeat for proc %s:%d",
                          pmix_globals.myid.nspace, pmix_globals.myid.rank,
                         ft->requestor->info->pname.nspace, ft->requestor->info->pname.rank));
 
-    if (0 == ft->nbeats && !ft->stopped) {
+    nrecvd = requestor_msgs(ft);
+    if (pmix_bitmap_is_set_bit(&mca_psensor_heartbeat_component.beats, ft->bit) ||
+        nrecvd != ft->nrecvd) {
+        ft->nrecvd = nrecvd;
+        PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
+                             "[%s:%d] sensor:check_heartbeat detected beats for proc %s:%d",
+                             pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                             ft->requestor->info->pname.nspace, ft->requestor->info->pname.rank));
+        /* ensure we know that the proc is alive */
+        ft->stopped = false;
+        /* reset for next period */
+        pmix_bitmap_clear_bit(&mca_psensor_heartbeat_component.beats, ft->bit);
+    } else if (!ft->stopped) {
         /* no heartbeat recvd in last window */
         PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
                              "[%s:%d] sensor:check_heartbeat failed for proc %s:%d",
@@ -309,34 +601,72 @@ static void check_heartbeat(int fd, short dummy, void *cbdata)
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
         }
-    } else {
-        PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
-                             "[%s:%d] sensor:check_heartbeat detected %d beats for proc %s:%d",
-                             pmix_globals.myid.nspace, pmix_globals.myid.rank, ft->nbeats,
-                             ft->requestor->info->pname.nspace, ft->requestor->info->pname.rank));
     }
-    /* reset for next period */
-    ft->nbeats = 0;
+}
+
+/* this function automatically gets called once a second by
+ * the event library, and checks every tracker whose window
+ * closes on this tick in one pass */
+static void tick(int fd, short dummy, void *cbdata)
+{
+    pmix_list_t due, *slot;
+    pmix_heartbeat_trkr_t *ft;
+    uint64_t now;
+
+    now = ++mca_psensor_heartbeat_component.tick;
+
+    /* when the inner level wraps, spread the next outer
+     * bucket back across the wheel */
+    if (0 == (now & (PMIX_HEARTBEAT_WHEEL_SLOTS-1))) {
+        PMIX_CONSTRUCT(&due, pmix_list_t);
+        slot = &mca_psensor_heartbeat_component.wheel[1][(now >> PMIX_HEARTBEAT_WHEEL_BITS) & (PMIX_HEARTBEAT_WHEEL_SLOTS-1)];
+        pmix_list_join(&due, pmix_list_get_end(&due), slot);
+        while (NULL != (ft = (pmix_heartbeat_trkr_t*)pmix_list_remove_first(&due))) {
+            schedule(ft);
+        }
+        PMIX_DESTRUCT(&due);
+    }
 
-    /* reset the timer */
-    pmix_event_evtimer_add(&ft->ev, &ft->tv);
+    /* everything in this slot expires now - take them all
+     * off first so the rescheduled ones aren't seen again */
+    PMIX_CONSTRUCT(&due, pmix_list_t);
+    slot = &mca_psensor_heartbeat_component.wheel[0][now & (PMIX_HEARTBEAT_WHEEL_SLOTS-1)];
+    pmix_list_join(&due, pmix_list_get_end(&due), slot);
+    while (NULL != (ft = (pmix_heartbeat_trkr_t*)pmix_list_remove_first(&due))) {
+        check_heartbeat(ft);
+        ft->expire = now + ft->tv.tv_sec;
+        schedule(ft);
+    }
+    PMIX_DESTRUCT(&due);
 }
 
 static void add_beat(int sd, short args, void *cbdata)
 {
     pmix_psensor_beat_t *b = (pmix_psensor_beat_t*)cbdata;
     pmix_heartbeat_trkr_t *ft;
+    pmix_heartbeat_member_t key, *m;
+    int i;
 
     PMIX_ACQUIRE_OBJECT(b);
 
-    /* find this peer in our trackers */
-    PMIX_LIST_FOREACH(ft, &mca_psensor_heartbeat_component.trackers, pmix_heartbeat_trkr_t) {
-        if (ft->requestor == b->peer) {
-            /* increment the beat count */
-            ++ft->nbeats;
-            /* ensure we know that the proc is alive */
-            ft->stopped = false;
-            break;
+    /* flag the beat for this peer's tracker */
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&mca_psensor_heartbeat_component.peers,
+                                                         b->peer->index, (void**)&ft) &&
+        ft->requestor == b->peer) {
+        pmix_bitmap_set_bit(&mca_psensor_heartbeat_component.beats, ft->bit);
+    }
+
+    /* and for any nspace-wide tracker watching it */
+    key.rank = b->peer->info->pname.rank;
+    for (i=0; i < mca_psensor_heartbeat_component.groups.size; i++) {
+        ft = (pmix_heartbeat_trkr_t*)pmix_pointer_array_get_item(&mca_psensor_heartbeat_component.groups, i);
+        if (NULL == ft || ft->nptr != b->peer->nptr) {
+            continue;
+        }
+        m = (pmix_heartbeat_member_t*)bsearch(&key, ft->members, ft->nmembers,
+                                              sizeof(pmix_heartbeat_member_t), member_cmp);
+        if (NULL != m) {
+            pmix_bitmap_set_bit(&mca_psensor_heartbeat_component.beats, m->bit);
         }
     }
 
@@ -20,16 +20,34 @@
 #include <src/include/pmix_config.h>
 #include <src/include/types.h>
 
+#include "src/class/pmix_bitmap.h"
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
+#include "src/class/pmix_pointer_array.h"
 #include "src/include/pmix_globals.h"
 #include "src/mca/psensor/psensor.h"
 
 BEGIN_C_DECLS
 
+/* trackers are kept on a two-level timer wheel of one-second
+ * ticks: the inner level covers the next WHEEL_SLOTS seconds,
+ * the outer one about WHEEL_SLOTS^2 seconds in WHEEL_SLOTS-second
+ * buckets that are cascaded down as the inner level wraps */
+#define PMIX_HEARTBEAT_WHEEL_BITS   6
+#define PMIX_HEARTBEAT_WHEEL_SLOTS  (1 << PMIX_HEARTBEAT_WHEEL_BITS)
+
 typedef struct {
     pmix_psensor_base_component_t super;
     bool recv_active;
-    pmix_list_t trackers;
+    pmix_list_t wheel[2][PMIX_HEARTBEAT_WHEEL_SLOTS];  // pmix_heartbeat_trkr_t by expiry
+    uint64_t tick;                // seconds the wheel has turned
+    size_t ntrackers;
+    pmix_event_t timer;           // single one-second tick for all trackers
+    bool timer_active;
+    pmix_bitmap_t inuse;          // beat bits assigned to trackers
+    pmix_bitmap_t beats;          // beat bits set since each tracker's last check
+    pmix_hash_table_t peers;      // tracker receiving each requestor's beats, by peer index
+    pmix_pointer_array_t groups;  // nspace-wide trackers, searched for each beat
 } pmix_psensor_heartbeat_component_t;
 
 PMIX_EXPORT extern pmix_psensor_heartbeat_component_t mca_psensor_heartbeat_component;
@@ -50,7 +50,22 @@ pmix_psensor_heartbeat_component_t mca_psensor_heartbeat_component = {
   */
 static int heartbeat_open(void)
 {
-    PMIX_CONSTRUCT(&mca_psensor_heartbeat_component.trackers, pmix_list_t);
+    int i, j;
+
+    for (i=0; i < 2; i++) {
+        for (j=0; j < PMIX_HEARTBEAT_WHEEL_SLOTS; j++) {
+            PMIX_CONSTRUCT(&mca_psensor_heartbeat_component.wheel[i][j], pmix_list_t);
+        }
+    }
+    mca_psensor_heartbeat_component.tick = 0;
+    mca_psensor_heartbeat_component.ntrackers = 0;
+    mca_psensor_heartbeat_component.timer_active = false;
+    PMIX_CONSTRUCT(&mca_psensor_heartbeat_component.inuse, pmix_bitmap_t);
+    PMIX_CONSTRUCT(&mca_psensor_heartbeat_component.beats, pmix_bitmap_t);
+    PMIX_CONSTRUCT(&mca_psensor_heartbeat_component.peers, pmix_hash_table_t);
+    pmix_hash_table_init(&mca_psensor_heartbeat_component.peers, 256);
+    PMIX_CONSTRUCT(&mca_psensor_heartbeat_component.groups, pmix_pointer_array_t);
+    pmix_pointer_array_init(&mca_psensor_heartbeat_component.groups, 4, INT_MAX, 4);
 
     return PMIX_SUCCESS;
 }
@@ -69,7 +84,21 @@ static int heartbeat_query(pmix_mca_base_module_t **module, int *priority)
 
 static int heartbeat_close(void)
 {
-    PMIX_LIST_DESTRUCT(&mca_psensor_heartbeat_component.trackers);
+    int i, j;
+
+    if (mca_psensor_heartbeat_component.timer_active) {
+        pmix_event_del(&mca_psensor_heartbeat_component.timer);
+        mca_psensor_heartbeat_component.timer_active = false;
+    }
+    for (i=0; i < 2; i++) {
+        for (j=0; j < PMIX_HEARTBEAT_WHEEL_SLOTS; j++) {
+            PMIX_LIST_DESTRUCT(&mca_psensor_heartbeat_component.wheel[i][j]);
+        }
+    }
+    PMIX_DESTRUCT(&mca_psensor_heartbeat_component.groups);
+    PMIX_DESTRUCT(&mca_psensor_heartbeat_component.peers);
+    PMIX_DESTRUCT(&mca_psensor_heartbeat_component.beats);
+    PMIX_DESTRUCT(&mca_psensor_heartbeat_component.inuse);
 
     return PMIX_SUCCESS;
 }
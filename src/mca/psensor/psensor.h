@@ -52,6 +52,20 @@ typedef pmix_status_t (*pmix_psensor_base_module_start_fn_t)(pmix_peer_t *reques
 typedef pmix_status_t (*pmix_psensor_base_module_stop_fn_t)(pmix_peer_t *requestor,
                                                             char *id);
 
+/* answer a query from what the sensors have collected:
+ *
+ * key - the query key being answered
+ *
+ * query - the query holding the key, whose qualifiers
+ *         select what is to be reported
+ *
+ * val - where to load the answer. A NULL indicates the caller
+ *       only wants to know if the query can be answered. Return
+ *       PMIX_ERR_TAKE_NEXT_OPTION if it cannot */
+typedef pmix_status_t (*pmix_psensor_base_module_query_fn_t)(const char *key,
+                                                             const pmix_query_t *query,
+                                                             pmix_value_t *val);
+
 /* API module */
 /*
  * Ver 1.0
@@ -59,6 +73,7 @@ typedef pmix_status_t (*pmix_psensor_base_module_stop_fn_t)(pmix_peer_t *request
 typedef struct pmix_psensor_base_module_1_0_0_t {
     pmix_psensor_base_module_start_fn_t      start;
     pmix_psensor_base_module_stop_fn_t       stop;
+    pmix_psensor_base_module_query_fn_t      query;
 } pmix_psensor_base_module_t;
 
 /*
@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2010      Cisco Systems, Inc.  All rights reserved.
+ * Copyright (c) 2011-2012 Los Alamos National Security, LLC.
+ *                         All rights reserved.
+ *
+ * Copyright (c) 2017-2018 Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+#include <src/include/types.h>
+#include <pmix_common.h>
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/types.h>
+
+#include "src/class/pmix_list.h"
+#include "src/include/pmix_globals.h"
+#include "src/threads/mutex.h"
+#include "src/util/error.h"
+#include "src/util/output.h"
+
+#include "src/mca/psensor/base/base.h"
+#include "psensor_usage.h"
+
+/* declare the API functions */
+static pmix_status_t start(pmix_peer_t *requestor, pmix_status_t error,
+                           const pmix_info_t *monitor,
+                           const pmix_info_t directives[], size_t ndirs);
+static pmix_status_t stop(pmix_peer_t *requestor, char *id);
+static pmix_status_t query(const char *key, const pmix_query_t *qry,
+                           pmix_value_t *val);
+
+/* instantiate the module */
+pmix_psensor_base_module_t pmix_psensor_usage_module = {
+    .start = start,
+    .stop = stop,
+    .query = query
+};
+
+/* running aggregate of one sampled quantity */
+typedef struct {
+    uint64_t nsamples;
+    uint64_t last;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+} usage_stat_t;
+
+/* define a tracking object */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_peer_t *requestor;
+    char *id;
+    pmix_proc_t proc;
+    pid_t pid;
+    uint32_t rate;          // seconds between samples
+    uint32_t countdown;     // ticks until the next sample
+    pmix_event_t cdev;
+    uint64_t cpu_ticks;     // utime+stime at the last sample
+    uint64_t io_bytes;      // bytes read+written at the last sample
+    usage_stat_t mem;       // resident bytes
+    usage_stat_t cpu;       // percent of one cpu over the interval
+    usage_stat_t io;        // bytes/sec over the interval
+} usage_tracker_t;
+static void ut_constructor(usage_tracker_t *ut)
+{
+    ut->requestor = NULL;
+    ut->id = NULL;
+    PMIX_LOAD_PROCID(&ut->proc, NULL, PMIX_RANK_UNDEF);
+    ut->pid = 0;
+    ut->rate = 0;
+    ut->countdown = 0;
+    ut->cpu_ticks = 0;
+    ut->io_bytes = 0;
+    memset(&ut->mem, 0, sizeof(usage_stat_t));
+    memset(&ut->cpu, 0, sizeof(usage_stat_t));
+    memset(&ut->io, 0, sizeof(usage_stat_t));
+}
+static void ut_destructor(usage_tracker_t *ut)
+{
+    if (NULL != ut->requestor) {
+        PMIX_RELEASE(ut->requestor);
+    }
+    if (NULL != ut->id) {
+        free(ut->id);
+    }
+}
+PMIX_CLASS_INSTANCE(usage_tracker_t,
+                    pmix_list_item_t,
+                    ut_constructor, ut_destructor);
+
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_peer_t *requestor;
+    char *id;
+} usage_caddy_t;
+static void cd_con(usage_caddy_t *p)
+{
+    p->requestor = NULL;
+    p->id = NULL;
+}
+static void cd_des(usage_caddy_t *p)
+{
+    if (NULL != p->requestor) {
+        PMIX_RELEASE(p->requestor);
+    }
+    if (NULL != p->id) {
+        free(p->id);
+    }
+}
+PMIX_CLASS_INSTANCE(usage_caddy_t,
+                    pmix_object_t,
+                    cd_con, cd_des);
+
+static void usage_tick(int sd, short args, void *cbdata);
+
+static void record(usage_stat_t *st, uint64_t value)
+{
+    if (0 == st->nsamples || value < st->min) {
+        st->min = value;
+    }
+    if (value > st->max) {
+        st->max = value;
+    }
+    st->last = value;
+    st->sum += value;
+    ++st->nsamples;
+}
+
+static ssize_t read_proc(pid_t pid, const char *what, char *buf, size_t len)
+{
+    char path[64];
+    ssize_t n;
+    int fd;
+
+    snprintf(path, sizeof(path), "/proc/%lu/%s", (unsigned long)pid, what);
+    if (0 > (fd = open(path, O_RDONLY))) {
+        return -1;
+    }
+    n = read(fd, buf, len - 1);
+    close(fd);
+    if (0 <= n) {
+        buf[n] = '\0';
+    }
+    return n;
+}
+
+static void sample(usage_tracker_t *ut, char *buf, size_t len)
+{
+    unsigned long utime, stime;
+    long rss;
+    uint64_t ticks, bytes, rd, wr;
+    char *ptr;
+
+    /* cpu and memory both come from the one stat read - skip
+     * past the command name, which may hold spaces, and pick
+     * out utime, stime and rss (fields 14, 15 and 24) */
+    if (0 >= read_proc(ut->pid, "stat", buf, len) ||
+        NULL == (ptr = strrchr(buf, ')')) ||
+        3 != sscanf(ptr + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu "
+                    "%*d %*d %*d %*d %*d %*d %*u %*u %ld", &utime, &stime, &rss)) {
+        PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
+                             "[%s:%d] could not sample pid %lu",
+                             pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                             (unsigned long)ut->pid));
+        return;
+    }
+    ticks = utime + stime;
+    record(&ut->mem, (uint64_t)rss * mca_psensor_usage_component.page_size);
+    if (1 < ut->mem.nsamples) {
+        record(&ut->cpu, (100 * (ticks - ut->cpu_ticks)) /
+                         (ut->rate * mca_psensor_usage_component.clk_tck));
+    }
+    ut->cpu_ticks = ticks;
+
+    /* IO accounting may be closed to us - that costs nothing else */
+    if (0 < read_proc(ut->pid, "io", buf, len) &&
+        NULL != (ptr = strstr(buf, "read_bytes:")) &&
+        1 == sscanf(ptr, "read_bytes: %" SCNu64, &rd) &&
+        NULL != (ptr = strstr(ptr, "write_bytes:")) &&
+        1 == sscanf(ptr, "write_bytes: %" SCNu64, &wr)) {
+        bytes = rd + wr;
+        if (1 < ut->mem.nsamples) {
+            record(&ut->io, (bytes - ut->io_bytes) / ut->rate);
+        }
+        ut->io_bytes = bytes;
+    }
+
+    PMIX_OUTPUT_VERBOSE((5, pmix_psensor_base_framework.framework_output,
+                         "[%s:%d] sampled %s:%u rss %" PRIu64 " cpu %" PRIu64 "%% io %" PRIu64 " B/s",
+                         pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                         ut->proc.nspace, ut->proc.rank,
+                         ut->mem.last, ut->cpu.last, ut->io.last));
+}
+
+/* a single one-second timer serves every tracker, and all
+ * those due in a tick are sampled in one pass */
+static void usage_tick(int sd, short args, void *cbdata)
+{
+    usage_tracker_t *ut;
+    char buf[1024];
+
+    pmix_mutex_lock(&mca_psensor_usage_component.lock);
+    PMIX_LIST_FOREACH(ut, &mca_psensor_usage_component.trackers, usage_tracker_t) {
+        if (0 < --ut->countdown) {
+            continue;
+        }
+        ut->countdown = ut->rate;
+        sample(ut, buf, sizeof(buf));
+    }
+    pmix_mutex_unlock(&mca_psensor_usage_component.lock);
+}
+
+static void add_tracker(int sd, short flags, void *cbdata)
+{
+    usage_tracker_t *ut = (usage_tracker_t*)cbdata;
+    usage_tracker_t *old;
+    struct timeval tv = {1, 0};
+
+    PMIX_ACQUIRE_OBJECT(ut);
+
+    pmix_mutex_lock(&mca_psensor_usage_component.lock);
+    /* a process has only one usage - a new request replaces the old */
+    PMIX_LIST_FOREACH(old, &mca_psensor_usage_component.trackers, usage_tracker_t) {
+        if (old->requestor == ut->requestor && old->pid == ut->pid) {
+            pmix_list_remove_item(&mca_psensor_usage_component.trackers, &old->super);
+            PMIX_RELEASE(old);
+            break;
+        }
+    }
+    /* take the first sample on the next tick */
+    ut->countdown = 1;
+    pmix_list_append(&mca_psensor_usage_component.trackers, &ut->super);
+    pmix_mutex_unlock(&mca_psensor_usage_component.lock);
+
+    if (!mca_psensor_usage_component.timer_active) {
+        pmix_event_assign(&mca_psensor_usage_component.timer, pmix_psensor_base.evbase,
+                          -1, EV_PERSIST, usage_tick, NULL);
+        pmix_event_add(&mca_psensor_usage_component.timer, &tv);
+        mca_psensor_usage_component.timer_active = true;
+    }
+}
+
+/*
+ * Start monitoring of local processes
+ */
+static pmix_status_t start(pmix_peer_t *requestor, pmix_status_t error,
+                           const pmix_info_t *monitor,
+                           const pmix_info_t directives[], size_t ndirs)
+{
+    usage_tracker_t *ut;
+    size_t n;
+
+    PMIX_OUTPUT_VERBOSE((1, pmix_psensor_base_framework.framework_output,
+                         "[%s:%d] checking usage monitoring for requestor %s:%d",
+                         pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                         requestor->info->pname.nspace, requestor->info->pname.rank));
+
+    /* if they didn't ask to monitor usage, then nothing for us to do */
+    if (0 != strcmp(monitor->key, PMIX_MONITOR_USAGE)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    /* setup to track this monitoring operation */
+    ut = PMIX_NEW(usage_tracker_t);
+    PMIX_RETAIN(requestor);
+    ut->requestor = requestor;
+    PMIX_LOAD_PROCID(&ut->proc, requestor->info->pname.nspace, requestor->info->pname.rank);
+    if (PMIX_UINT32 == monitor->value.type) {
+        ut->rate = monitor->value.data.uint32;
+    }
+    if (0 == ut->rate) {
+        ut->rate = mca_psensor_usage_component.rate;
+    }
+
+    for (n=0; n < ndirs; n++) {
+        if (0 == strcmp(directives[n].key, PMIX_PROC_PID)) {
+            ut->pid = directives[n].value.data.pid;
+        } else if (0 == strcmp(directives[n].key, PMIX_MONITOR_ID)) {
+            ut->id = strdup(directives[n].value.data.string);
+        }
+    }
+
+    if (0 == ut->pid) {
+        /* nothing we can look at */
+        PMIX_RELEASE(ut);
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    /* need to push into our event base to add this to our trackers */
+    pmix_event_assign(&ut->cdev, pmix_psensor_base.evbase, -1,
+                      EV_WRITE, add_tracker, ut);
+    PMIX_POST_OBJECT(ut);
+    pmix_event_active(&ut->cdev, EV_WRITE, 1);
+
+    return PMIX_SUCCESS;
+}
+
+static void del_tracker(int sd, short flags, void *cbdata)
+{
+    usage_caddy_t *cd = (usage_caddy_t*)cbdata;
+    usage_tracker_t *ut, *utnext;
+
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    pmix_mutex_lock(&mca_psensor_usage_component.lock);
+    PMIX_LIST_FOREACH_SAFE(ut, utnext, &mca_psensor_usage_component.trackers, usage_tracker_t) {
+        if (ut->requestor != cd->requestor) {
+            continue;
+        }
+        if (NULL == cd->id ||
+            (NULL != ut->id && 0 == strcmp(ut->id, cd->id))) {
+            pmix_list_remove_item(&mca_psensor_usage_component.trackers, &ut->super);
+            PMIX_RELEASE(ut);
+        }
+    }
+    pmix_mutex_unlock(&mca_psensor_usage_component.lock);
+
+    /* no need to keep ticking */
+    if (0 == pmix_list_get_size(&mca_psensor_usage_component.trackers) &&
+        mca_psensor_usage_component.timer_active) {
+        pmix_event_del(&mca_psensor_usage_component.timer);
+        mca_psensor_usage_component.timer_active = false;
+    }
+    PMIX_RELEASE(cd);
+}
+
+static pmix_status_t stop(pmix_peer_t *requestor, char *id)
+{
+    usage_caddy_t *cd;
+
+    cd = PMIX_NEW(usage_caddy_t);
+    PMIX_RETAIN(requestor);
+    cd->requestor = requestor;
+    if (NULL != id) {
+        cd->id = strdup(id);
+    }
+
+    /* need to push into our event base to remove this from our trackers */
+    pmix_event_assign(&cd->ev, pmix_psensor_base.evbase, -1,
+                      EV_WRITE, del_tracker, cd);
+    PMIX_POST_OBJECT(cd);
+    pmix_event_active(&cd->ev, EV_WRITE, 1);
+
+    return PMIX_SUCCESS;
+}
+
+static bool selected(usage_tracker_t *ut, const pmix_proc_t *target)
+{
+    if (0 == ut->mem.nsamples) {
+        return false;
+    }
+    return (NULL == target || PMIX_CHECK_PROCID(target, &ut->proc));
+}
+
+/* answer PMIX_QUERY_MEMORY_USAGE for the procs we sample. A query
+ * naming a proc we don't sample, or a whole nspace that may have
+ * procs elsewhere, is left to the host */
+static pmix_status_t query(const char *key, const pmix_query_t *qry,
+                           pmix_value_t *val)
+{
+    const pmix_proc_t *target = NULL;
+    pmix_proc_t nsproc;
+    bool avg = false, minmax = false, local = false;
+    usage_tracker_t *ut;
+    pmix_data_array_t *darray, *stats;
+    pmix_info_t *info;
+    uint64_t *u64;
+    size_t n, nprocs = 0, nvals;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    if (0 != strcmp(key, PMIX_QUERY_MEMORY_USAGE)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    PMIX_LOAD_PROCID(&nsproc, NULL, PMIX_RANK_WILDCARD);
+    for (n=0; n < qry->nqual; n++) {
+        if (PMIX_CHECK_KEY(&qry->qualifiers[n], PMIX_PROCID)) {
+            target = qry->qualifiers[n].value.data.proc;
+        } else if (PMIX_CHECK_KEY(&qry->qualifiers[n], PMIX_NSPACE)) {
+            PMIX_LOAD_NSPACE(nsproc.nspace, qry->qualifiers[n].value.data.string);
+        } else if (PMIX_CHECK_KEY(&qry->qualifiers[n], PMIX_RANK)) {
+            nsproc.rank = qry->qualifiers[n].value.data.rank;
+        } else if (PMIX_CHECK_KEY(&qry->qualifiers[n], PMIX_QUERY_REPORT_AVG)) {
+            avg = PMIX_INFO_TRUE(&qry->qualifiers[n]);
+        } else if (PMIX_CHECK_KEY(&qry->qualifiers[n], PMIX_QUERY_REPORT_MINMAX)) {
+            minmax = PMIX_INFO_TRUE(&qry->qualifiers[n]);
+        } else if (PMIX_CHECK_KEY(&qry->qualifiers[n], PMIX_QUERY_LOCAL_ONLY)) {
+            local = PMIX_INFO_TRUE(&qry->qualifiers[n]);
+        }
+    }
+    if (NULL == target && 0 < strlen(nsproc.nspace)) {
+        target = &nsproc;
+    }
+    if (NULL != target && PMIX_RANK_WILDCARD == target->rank && !local) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    pmix_mutex_lock(&mca_psensor_usage_component.lock);
+    PMIX_LIST_FOREACH(ut, &mca_psensor_usage_component.trackers, usage_tracker_t) {
+        if (selected(ut, target)) {
+            ++nprocs;
+        }
+    }
+    if (0 == nprocs) {
+        rc = PMIX_ERR_TAKE_NEXT_OPTION;
+        goto done;
+    }
+    if (NULL == val) {
+        goto done;
+    }
+
+    PMIX_DATA_ARRAY_CREATE(darray, nprocs, PMIX_INFO);
+    if (NULL == darray) {
+        rc = PMIX_ERR_NOMEM;
+        goto done;
+    }
+    val->type = PMIX_DATA_ARRAY;
+    val->data.darray = darray;
+    PMIX_INFO_CREATE(info, nprocs);
+    if (NULL == info) {
+        rc = PMIX_ERR_NOMEM;
+        goto done;
+    }
+    darray->array = info;
+
+    nvals = 1 + (avg ? 1 : 0) + (minmax ? 2 : 0);
+    n = 0;
+    PMIX_LIST_FOREACH(ut, &mca_psensor_usage_component.trackers, usage_tracker_t) {
+        if (!selected(ut, target)) {
+            continue;
+        }
+        PMIX_DATA_ARRAY_CREATE(stats, nvals, PMIX_UINT64);
+        if (NULL == stats) {
+            rc = PMIX_ERR_NOMEM;
+            goto done;
+        }
+        if (NULL == (u64 = (uint64_t*)malloc(nvals * sizeof(uint64_t)))) {
+            free(stats);
+            rc = PMIX_ERR_NOMEM;
+            goto done;
+        }
+        nvals = 0;
+        u64[nvals++] = ut->mem.last;
+        if (avg) {
+            u64[nvals++] = ut->mem.sum / ut->mem.nsamples;
+        }
+        if (minmax) {
+            u64[nvals++] = ut->mem.min;
+            u64[nvals++] = ut->mem.max;
+        }
+        stats->array = u64;
+        snprintf(info[n].key, PMIX_MAX_KEYLEN, "%s.%u",
+                 ut->proc.nspace, ut->proc.rank);
+        info[n].value.type = PMIX_DATA_ARRAY;
+        info[n].value.data.darray = stats;
+        ++n;
+    }
+
+  done:
+    pmix_mutex_unlock(&mca_psensor_usage_component.lock);
+    return rc;
+}
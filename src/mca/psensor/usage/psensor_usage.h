@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2010      Cisco Systems, Inc.  All rights reserved.
+ *
+ * Copyright (c) 2017      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Resource usage sensor
+ */
+#ifndef PMIX_PSENSOR_USAGE_H
+#define PMIX_PSENSOR_USAGE_H
+
+#include <src/include/pmix_config.h>
+
+#include "src/class/pmix_list.h"
+#include "src/threads/mutex.h"
+
+#include "src/mca/psensor/psensor.h"
+
+BEGIN_C_DECLS
+
+typedef struct {
+    pmix_psensor_base_component_t super;
+    int rate;                   // default seconds between samples
+    pmix_list_t trackers;
+    pmix_mutex_t lock;          // trackers are read by queries on the server thread
+    pmix_event_t timer;         // single one-second tick for all trackers
+    bool timer_active;
+    long page_size;
+    long clk_tck;
+} pmix_psensor_usage_component_t;
+
+PMIX_EXPORT extern pmix_psensor_usage_component_t mca_psensor_usage_component;
+extern pmix_psensor_base_module_t pmix_psensor_usage_module;
+
+
+END_C_DECLS
+
+#endif
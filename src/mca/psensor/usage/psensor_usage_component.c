@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2010      Cisco Systems, Inc.  All rights reserved.
+ * Copyright (c) 2012      Los Alamos National Security, Inc. All rights reserved.
+ * Copyright (c) 2017      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_common.h>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#include "src/class/pmix_list.h"
+
+#include "src/mca/psensor/base/base.h"
+#include "psensor_usage.h"
+
+/*
+ * Local functions
+ */
+
+static int psensor_usage_register(void);
+static int psensor_usage_open(void);
+static int psensor_usage_close(void);
+static int psensor_usage_query(pmix_mca_base_module_t **module, int *priority);
+
+pmix_psensor_usage_component_t mca_psensor_usage_component = {
+    .super = {
+        .base = {
+            PMIX_PSENSOR_BASE_VERSION_1_0_0,
+
+            /* Component name and version */
+            .pmix_mca_component_name = "usage",
+            PMIX_MCA_BASE_MAKE_VERSION(component,
+                                       PMIX_MAJOR_VERSION,
+                                       PMIX_MINOR_VERSION,
+                                       PMIX_RELEASE_VERSION),
+
+            /* Component open and close functions */
+            .pmix_mca_open_component = psensor_usage_open,
+            .pmix_mca_close_component = psensor_usage_close,
+            .pmix_mca_query_component = psensor_usage_query,
+            .pmix_mca_register_component_params = psensor_usage_register
+        }
+    },
+    .rate = 5
+};
+
+
+static int psensor_usage_register(void)
+{
+    pmix_mca_base_component_t *component = &mca_psensor_usage_component.super.base;
+
+    (void)pmix_mca_base_component_var_register(component, "rate",
+                                               "Seconds between samples of a monitored process when "
+                                               "its request does not give a rate (default: 5)",
+                                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                               PMIX_INFO_LVL_4,
+                                               PMIX_MCA_BASE_VAR_SCOPE_LOCAL,
+                                               &mca_psensor_usage_component.rate);
+    if (0 >= mca_psensor_usage_component.rate) {
+        mca_psensor_usage_component.rate = 5;
+    }
+    return PMIX_SUCCESS;
+}
+
+static int psensor_usage_open(void)
+{
+    PMIX_CONSTRUCT(&mca_psensor_usage_component.trackers, pmix_list_t);
+    PMIX_CONSTRUCT(&mca_psensor_usage_component.lock, pmix_mutex_t);
+    mca_psensor_usage_component.timer_active = false;
+    mca_psensor_usage_component.page_size = sysconf(_SC_PAGESIZE);
+    mca_psensor_usage_component.clk_tck = sysconf(_SC_CLK_TCK);
+    return PMIX_SUCCESS;
+}
+
+
+static int psensor_usage_query(pmix_mca_base_module_t **module, int *priority)
+{
+    /* the samples come from /proc */
+    if (0 != access("/proc/self/stat", R_OK)) {
+        *module = NULL;
+        return PMIX_ERROR;
+    }
+    *priority = 20;  // irrelevant
+    *module = (pmix_mca_base_module_t *)&pmix_psensor_usage_module;
+    return PMIX_SUCCESS;
+}
+
+/**
+ *  Close all subsystems.
+ */
+
+static int psensor_usage_close(void)
+{
+    if (mca_psensor_usage_component.timer_active) {
+        pmix_event_del(&mca_psensor_usage_component.timer);
+        mca_psensor_usage_component.timer_active = false;
+    }
+    PMIX_LIST_DESTRUCT(&mca_psensor_usage_component.trackers);
+    PMIX_DESTRUCT(&mca_psensor_usage_component.lock);
+    return PMIX_SUCCESS;
+}
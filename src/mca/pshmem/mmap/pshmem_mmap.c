@@ -12,6 +12,7 @@
  */
 
 
+#include <stdio.h>
 #include <unistd.h>
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>
@@ -24,6 +25,8 @@
 #include <src/include/pmix_config.h>
 #include <pmix_common.h>
 #include "src/include/pmix_globals.h"
+#include "src/util/error.h"
+#include "src/hwloc/hwloc-internal.h"
 
 //#include "pmix_sm.h"
 #include <src/mca/pshmem/pshmem.h>
@@ -39,6 +42,9 @@ static int _mmap_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name
 static int _mmap_segment_attach(pmix_pshmem_seg_t *sm_seg, pmix_pshmem_access_mode_t sm_mode);
 static int _mmap_segment_detach(pmix_pshmem_seg_t *sm_seg);
 static int _mmap_segment_unlink(pmix_pshmem_seg_t *sm_seg);
+static int _mmap_segment_size(pmix_pshmem_seg_t *sm_seg, size_t *size);
+static int _mmap_segment_rename(pmix_pshmem_seg_t *sm_seg, const char *new_name);
+static int _mmap_segment_chown(pmix_pshmem_seg_t *sm_seg, uid_t uid, mode_t mode);
 
 pmix_pshmem_base_module_t pmix_mmap_module = {
     "mmap",
@@ -47,9 +53,56 @@ pmix_pshmem_base_module_t pmix_mmap_module = {
     _mmap_segment_create,
     _mmap_segment_attach,
     _mmap_segment_detach,
-    _mmap_segment_unlink
+    _mmap_segment_unlink,
+    _mmap_segment_size,
+    _mmap_segment_rename,
+    _mmap_segment_chown
 };
 
+/* apply the requested page size and placement policies to a newly
+ * mapped segment. These are only hints - failure to apply them is
+ * not an error as the segment remains perfectly usable */
+static void _mmap_segment_advise(pmix_pshmem_seg_t *sm_seg, bool creator)
+{
+    if (mca_pshmem_mmap_component.hugepages) {
+#ifdef MADV_HUGEPAGE
+        if (0 != madvise(sm_seg->seg_base_addr, sm_seg->seg_size, MADV_HUGEPAGE)) {
+            pmix_output_verbose(2, pmix_globals.debug_output,
+                    "sys call madvise(2) fail\n");
+        }
+#endif
+    }
+
+    /* placement is decided when the pages are first touched, which
+     * is done by the creator */
+    if (creator && mca_pshmem_mmap_component.interleave) {
+#if PMIX_HAVE_HWLOC
+        hwloc_const_nodeset_t nodeset;
+        int rc;
+
+        if (NULL == pmix_hwloc_topology &&
+            PMIX_SUCCESS != pmix_hwloc_get_topology(NULL, 0)) {
+            return;
+        }
+        nodeset = hwloc_topology_get_topology_nodeset(pmix_hwloc_topology);
+#if HWLOC_API_VERSION >= 0x00020000
+        rc = hwloc_set_area_membind(pmix_hwloc_topology,
+                                    sm_seg->seg_base_addr, sm_seg->seg_size,
+                                    nodeset, HWLOC_MEMBIND_INTERLEAVE,
+                                    HWLOC_MEMBIND_BYNODESET);
+#else
+        rc = hwloc_set_area_membind_nodeset(pmix_hwloc_topology,
+                                            sm_seg->seg_base_addr, sm_seg->seg_size,
+                                            nodeset, HWLOC_MEMBIND_INTERLEAVE, 0);
+#endif
+        if (0 != rc) {
+            pmix_output_verbose(2, pmix_globals.debug_output,
+                    "hwloc_set_area_membind fail\n");
+        }
+#endif
+    }
+}
+
 static int _mmap_init(void)
 {
     return PMIX_SUCCESS;
@@ -122,6 +175,7 @@ static int _mmap_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name
     sm_seg->seg_size = size;
     sm_seg->seg_base_addr = (unsigned char *)seg_addr;
     pmix_strncpy(sm_seg->seg_name, file_name, PMIX_PATH_MAX);
+    _mmap_segment_advise(sm_seg, true);
 
 out:
     if (-1 != sm_seg->seg_id) {
@@ -174,6 +228,7 @@ static int _mmap_segment_attach(pmix_pshmem_seg_t *sm_seg, pmix_pshmem_access_mo
         pmix_output_verbose(2, pmix_globals.debug_output,
                 "sys call close(2) fail\n");
     }
+    _mmap_segment_advise(sm_seg, false);
     sm_seg->seg_cpid = 0;/* FIXME */
     return PMIX_SUCCESS;
 }
@@ -205,3 +260,32 @@ static int _mmap_segment_unlink(pmix_pshmem_seg_t *sm_seg)
     sm_seg->seg_id = PMIX_SHMEM_DS_ID_INVALID;
     return PMIX_SUCCESS;
 }
+
+static int _mmap_segment_size(pmix_pshmem_seg_t *sm_seg, size_t *size)
+{
+    struct stat st;
+
+    if (0 != stat(sm_seg->seg_name, &st)) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    *size = (size_t)st.st_size;
+    return PMIX_SUCCESS;
+}
+
+static int _mmap_segment_rename(pmix_pshmem_seg_t *sm_seg, const char *new_name)
+{
+    if (0 != rename(sm_seg->seg_name, new_name)) {
+        return PMIX_ERROR;
+    }
+    pmix_strncpy(sm_seg->seg_name, new_name, PMIX_PATH_MAX-1);
+    return PMIX_SUCCESS;
+}
+
+static int _mmap_segment_chown(pmix_pshmem_seg_t *sm_seg, uid_t uid, mode_t mode)
+{
+    if (0 > chown(sm_seg->seg_name, uid, (gid_t) -1) ||
+        0 > chmod(sm_seg->seg_name, mode)) {
+        return PMIX_ERR_PERM;
+    }
+    return PMIX_SUCCESS;
+}
@@ -17,7 +17,13 @@
 
 BEGIN_C_DECLS
 
-PMIX_EXPORT extern pmix_pshmem_base_component_t mca_pshmem_mmap_component;
+typedef struct {
+    pmix_pshmem_base_component_t super;
+    bool hugepages;         // advise the kernel to back segments with huge pages
+    bool interleave;        // interleave segment memory across NUMA domains
+} pmix_pshmem_mmap_component_t;
+
+PMIX_EXPORT extern pmix_pshmem_mmap_component_t mca_pshmem_mmap_component;
 extern pmix_pshmem_base_module_t pmix_mmap_module;
 
 END_C_DECLS
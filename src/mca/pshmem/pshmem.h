@@ -109,6 +109,37 @@ typedef int (*pmix_pshmem_base_module_segment_detach_fn_t)(pmix_pshmem_seg_t *sm
 */
 typedef int (*pmix_pshmem_base_module_unlink_fn_t)(pmix_pshmem_seg_t *sm_seg);
 
+/**
+* return the current size of the named segment without attaching to it.
+*
+* @param sm_seg  pointer to pmix_pshmem_seg_t structure whose seg_name
+*                is set (IN).
+*
+* @param size    size of the segment (OUT).
+*
+* @return PMIX_SUCCESS on success, PMIX_ERR_NOT_FOUND if there is no
+*         such segment.
+*/
+typedef int (*pmix_pshmem_base_module_segment_size_fn_t)(pmix_pshmem_seg_t *sm_seg,
+                                                         size_t *size);
+
+/**
+* give an existing segment a new name, updating seg_name to match.
+*
+* @return PMIX_SUCCESS on success, PMIX_ERR_NOT_SUPPORTED if the
+*         module cannot rename segments.
+*/
+typedef int (*pmix_pshmem_base_module_segment_rename_fn_t)(pmix_pshmem_seg_t *sm_seg,
+                                                           const char *new_name);
+
+/**
+* change the owner and access mode of an existing segment.
+*
+* @return PMIX_SUCCESS on success.
+*/
+typedef int (*pmix_pshmem_base_module_segment_chown_fn_t)(pmix_pshmem_seg_t *sm_seg,
+                                                          uid_t uid, mode_t mode);
+
 
 /**
 * structure for sm modules
@@ -121,6 +152,9 @@ typedef struct {
     pmix_pshmem_base_module_segment_attach_fn_t  segment_attach;
     pmix_pshmem_base_module_segment_detach_fn_t  segment_detach;
     pmix_pshmem_base_module_unlink_fn_t          segment_unlink;
+    pmix_pshmem_base_module_segment_size_fn_t    segment_size;
+    pmix_pshmem_base_module_segment_rename_fn_t  segment_rename;
+    pmix_pshmem_base_module_segment_chown_fn_t   segment_chown;
 } pmix_pshmem_base_module_t;
 
 /* define the component structure */
@@ -0,0 +1,35 @@
+# -*- shell-script -*-
+#
+# Copyright (c) 2018      Intel, Inc. All rights reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# MCA_pshmem_shm_CONFIG([action-if-found], [action-if-not-found])
+# -----------------------------------------------------------
+AC_DEFUN([MCA_pmix_pshmem_shm_CONFIG], [
+    AC_CONFIG_FILES([src/mca/pshmem/shm/Makefile])
+
+    PMIX_VAR_SCOPE_PUSH([pmix_pshmem_shm_happy pmix_pshmem_shm_save_LIBS])
+
+    # shm_open lives in librt on older glibc
+    pmix_pshmem_shm_happy=0
+    pmix_pshmem_shm_LIBS=
+    pmix_pshmem_shm_save_LIBS=$LIBS
+    AC_CHECK_HEADER([sys/mman.h],
+        [AC_SEARCH_LIBS([shm_open], [rt],
+            [pmix_pshmem_shm_happy=1
+             AS_IF([test "$ac_cv_search_shm_open" != "none required"],
+                   [pmix_pshmem_shm_LIBS=$ac_cv_search_shm_open])])])
+    LIBS=$pmix_pshmem_shm_save_LIBS
+
+    AS_IF([test $pmix_pshmem_shm_happy -eq 1],
+          [$1],
+          [$2])
+
+    AC_SUBST(pmix_pshmem_shm_LIBS)
+    PMIX_VAR_SCOPE_POP
+])dnl
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2018      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <stdio.h>
+#include <unistd.h>
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#include <pmix_common.h>
+#include "src/include/pmix_globals.h"
+#include "src/util/error.h"
+#include "src/util/output.h"
+
+#include <src/mca/pshmem/pshmem.h>
+#include "pshmem_shm.h"
+
+/* Segments are POSIX shared memory objects rather than files, so
+ * they never touch a filesystem no matter where the session directory
+ * lives. Callers still name segments by path - the path is mapped to
+ * an object name that every process derives the same way, so readers
+ * find a segment exactly as they would with the mmap component */
+
+/* longest object name we generate - well under NAME_MAX */
+#define PMIX_SHM_NAME_MAX   224
+
+static int _shm_init(void);
+static void _shm_finalize(void);
+static int _shm_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name, size_t size);
+static int _shm_segment_attach(pmix_pshmem_seg_t *sm_seg, pmix_pshmem_access_mode_t sm_mode);
+static int _shm_segment_detach(pmix_pshmem_seg_t *sm_seg);
+static int _shm_segment_unlink(pmix_pshmem_seg_t *sm_seg);
+static int _shm_segment_size(pmix_pshmem_seg_t *sm_seg, size_t *size);
+static int _shm_segment_rename(pmix_pshmem_seg_t *sm_seg, const char *new_name);
+static int _shm_segment_chown(pmix_pshmem_seg_t *sm_seg, uid_t uid, mode_t mode);
+
+pmix_pshmem_base_module_t pmix_shm_module = {
+    "shm",
+    _shm_init,
+    _shm_finalize,
+    _shm_segment_create,
+    _shm_segment_attach,
+    _shm_segment_detach,
+    _shm_segment_unlink,
+    _shm_segment_size,
+    _shm_segment_rename,
+    _shm_segment_chown
+};
+
+/* the object name is "/pmix-<hash of the path>-<last path element>",
+ * the hash keeping segments of different session directories apart
+ * and the last element keeping the name readable */
+static void _shm_name(const char *path, char *name)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    const char *p, *base = path;
+
+    for (p=path; '\0' != *p; p++) {
+        hash = (hash ^ (unsigned char)*p) * 1099511628211ULL;
+        if ('/' == *p) {
+            base = p + 1;
+        }
+    }
+    snprintf(name, PMIX_SHM_NAME_MAX, "/pmix-%016llx-%.200s",
+             (unsigned long long)hash, base);
+}
+
+static int _shm_init(void)
+{
+    return PMIX_SUCCESS;
+}
+
+static void _shm_finalize(void)
+{
+    ;
+}
+
+static int _shm_segment_create(pmix_pshmem_seg_t *sm_seg, const char *file_name, size_t size)
+{
+    int rc = PMIX_SUCCESS;
+    void *seg_addr = MAP_FAILED;
+    char name[PMIX_SHM_NAME_MAX];
+
+    _segment_ds_reset(sm_seg);
+    _shm_name(file_name, name);
+    if (-1 == (sm_seg->seg_id = shm_open(name, O_CREAT | O_RDWR, 0600))) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call shm_open(3) fail\n");
+        rc = PMIX_ERROR;
+        goto out;
+    }
+    /* reserve the pages now so running out of memory shows up
+     * here rather than as a SIGBUS in whoever touches them first */
+#ifdef HAVE_POSIX_FALLOCATE
+    if (0 != (rc = posix_fallocate(sm_seg->seg_id, 0, size))) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call posix_fallocate(2) fail\n");
+        if (ENOSPC == rc) {
+            rc = PMIX_ERR_OUT_OF_RESOURCE;
+            goto out;
+        } else if ((ENOTSUP != rc)
+#ifdef EOPNOTSUPP
+                            && (EOPNOTSUPP != rc)
+#endif
+        ){
+            rc = PMIX_ERROR;
+            goto out;
+        }
+        rc = PMIX_SUCCESS;
+    }
+#endif
+    /* an object left behind by an earlier user of the name may be
+     * larger, so always set the size */
+    if (0 != ftruncate(sm_seg->seg_id, size)) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call ftruncate(2) fail\n");
+        rc = PMIX_ERROR;
+        goto out;
+    }
+    if (MAP_FAILED == (seg_addr = mmap(NULL, size,
+                                       PROT_READ | PROT_WRITE, MAP_SHARED,
+                                       sm_seg->seg_id, 0))) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call mmap(2) fail\n");
+        rc = PMIX_ERROR;
+        goto out;
+    }
+    sm_seg->seg_cpid = getpid();
+    sm_seg->seg_size = size;
+    sm_seg->seg_base_addr = (unsigned char *)seg_addr;
+    pmix_strncpy(sm_seg->seg_name, file_name, PMIX_PATH_MAX);
+
+out:
+    if (-1 != sm_seg->seg_id) {
+        close(sm_seg->seg_id);
+    }
+    if (PMIX_SUCCESS != rc) {
+        if (MAP_FAILED != seg_addr) {
+            munmap((void *)seg_addr, size);
+        }
+        if (-1 != sm_seg->seg_id) {
+            shm_unlink(name);
+        }
+        _segment_ds_reset(sm_seg);
+    }
+    return rc;
+}
+
+static int _shm_segment_attach(pmix_pshmem_seg_t *sm_seg, pmix_pshmem_access_mode_t sm_mode)
+{
+    int mode = O_RDWR;
+    int mmap_prot = PROT_READ | PROT_WRITE;
+    char name[PMIX_SHM_NAME_MAX];
+
+    if (sm_mode == PMIX_PSHMEM_RONLY) {
+        mode = O_RDONLY;
+        mmap_prot = PROT_READ;
+    }
+
+    _shm_name(sm_seg->seg_name, name);
+    if (-1 == (sm_seg->seg_id = shm_open(name, mode, 0))) {
+        return PMIX_ERROR;
+    }
+    if (MAP_FAILED == (sm_seg->seg_base_addr = (unsigned char *)
+                mmap(NULL, sm_seg->seg_size,
+                    mmap_prot, MAP_SHARED,
+                    sm_seg->seg_id, 0))) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call mmap(2) fail\n");
+        close(sm_seg->seg_id);
+        return PMIX_ERROR;
+    }
+    /* the mapping holds its own reference to the object */
+    close(sm_seg->seg_id);
+    sm_seg->seg_cpid = 0;
+    return PMIX_SUCCESS;
+}
+
+static int _shm_segment_detach(pmix_pshmem_seg_t *sm_seg)
+{
+    int rc = PMIX_SUCCESS;
+
+    if (0 != munmap((void *)sm_seg->seg_base_addr, sm_seg->seg_size)) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call munmap(2) fail\n");
+        rc = PMIX_ERROR;
+    }
+    _segment_ds_reset(sm_seg);
+    return rc;
+}
+
+static int _shm_segment_unlink(pmix_pshmem_seg_t *sm_seg)
+{
+    char name[PMIX_SHM_NAME_MAX];
+
+    _shm_name(sm_seg->seg_name, name);
+    if (-1 == shm_unlink(name)) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                "sys call shm_unlink(3) fail\n");
+        return PMIX_ERROR;
+    }
+
+    sm_seg->seg_id = PMIX_SHMEM_DS_ID_INVALID;
+    return PMIX_SUCCESS;
+}
+
+static int _shm_segment_size(pmix_pshmem_seg_t *sm_seg, size_t *size)
+{
+    char name[PMIX_SHM_NAME_MAX];
+    struct stat st;
+    int fd, rc;
+
+    _shm_name(sm_seg->seg_name, name);
+    if (-1 == (fd = shm_open(name, O_RDONLY, 0))) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    rc = fstat(fd, &st);
+    close(fd);
+    if (0 != rc) {
+        return PMIX_ERROR;
+    }
+    *size = (size_t)st.st_size;
+    return PMIX_SUCCESS;
+}
+
+static int _shm_segment_rename(pmix_pshmem_seg_t *sm_seg, const char *new_name)
+{
+    /* there is no portable way to rename a shared memory object */
+    return PMIX_ERR_NOT_SUPPORTED;
+}
+
+static int _shm_segment_chown(pmix_pshmem_seg_t *sm_seg, uid_t uid, mode_t mode)
+{
+    char name[PMIX_SHM_NAME_MAX];
+    int fd, rc = PMIX_SUCCESS;
+
+    _shm_name(sm_seg->seg_name, name);
+    if (-1 == (fd = shm_open(name, O_RDWR, 0))) {
+        return PMIX_ERR_NOT_FOUND;
+    }
+    if (0 > fchown(fd, uid, (gid_t) -1) ||
+        0 > fchmod(fd, mode)) {
+        rc = PMIX_ERR_PERM;
+    }
+    close(fd);
+    return rc;
+}
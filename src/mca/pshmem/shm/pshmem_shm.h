@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef PMIX_PSHMEM_SHM_H
+#define PMIX_PSHMEM_SHM_H
+
+#include <src/include/pmix_config.h>
+#include <src/mca/pshmem/pshmem.h>
+
+BEGIN_C_DECLS
+
+typedef struct {
+    pmix_pshmem_base_component_t super;
+    int priority;
+} pmix_pshmem_shm_component_t;
+
+PMIX_EXPORT extern pmix_pshmem_shm_component_t mca_pshmem_shm_component;
+extern pmix_pshmem_base_module_t pmix_shm_module;
+
+END_C_DECLS
+
+#endif /* PMIX_PSHMEM_SHM_H */
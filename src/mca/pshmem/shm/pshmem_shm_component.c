@@ -0,0 +1,93 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * These symbols are in a file by themselves to provide nice linker
+ * semantics.  Since linkers generally pull in symbols by object
+ * files, keeping these symbols as the only symbols in this file
+ * prevents utility programs such as "ompi_info" from having to import
+ * entire components just to query their version and parameters.
+ */
+
+#include <src/include/pmix_config.h>
+#include "pmix_common.h"
+
+
+#include <src/mca/pshmem/pshmem.h>
+#include "pshmem_shm.h"
+
+static pmix_status_t component_register(void);
+static pmix_status_t component_open(void);
+static pmix_status_t component_close(void);
+static pmix_status_t component_query(pmix_mca_base_module_t **module, int *priority);
+
+/*
+ * Instantiate the public struct with all of our public information
+ * and pointers to our public functions in it
+ */
+pmix_pshmem_shm_component_t mca_pshmem_shm_component = {
+    .super = {
+        .base = {
+            PMIX_PSHMEM_BASE_VERSION_1_0_0,
+
+            /* Component name and version */
+            .pmix_mca_component_name = "shm",
+            PMIX_MCA_BASE_MAKE_VERSION(component,
+                                       PMIX_MAJOR_VERSION,
+                                       PMIX_MINOR_VERSION,
+                                       PMIX_RELEASE_VERSION),
+
+            /* Component open and close functions */
+            .pmix_mca_open_component = component_open,
+            .pmix_mca_close_component = component_close,
+            .pmix_mca_query_component = component_query,
+            .pmix_mca_register_component_params = component_register,
+        },
+        .data = {
+            /* The component is checkpoint ready */
+            PMIX_MCA_BASE_METADATA_PARAM_CHECKPOINT
+        }
+    },
+    /* below mmap unless asked for, as segments that are not files
+     * do not show up in the session directory */
+    .priority = 5
+};
+
+static pmix_status_t component_register(void)
+{
+    pmix_mca_base_component_t *component = &mca_pshmem_shm_component.super.base;
+
+    (void)pmix_mca_base_component_var_register(component, "priority",
+                                               "Priority of the POSIX shared memory component - raise above 10 to keep segments off the filesystem",
+                                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                               PMIX_INFO_LVL_4,
+                                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                               &mca_pshmem_shm_component.priority);
+
+    return PMIX_SUCCESS;
+}
+
+
+static int component_open(void)
+{
+    return PMIX_SUCCESS;
+}
+
+
+static int component_query(pmix_mca_base_module_t **module, int *priority)
+{
+    *priority = mca_pshmem_shm_component.priority;
+    *module = (pmix_mca_base_module_t *)&pmix_shm_module;
+    return PMIX_SUCCESS;
+}
+
+
+static int component_close(void)
+{
+    return PMIX_SUCCESS;
+}
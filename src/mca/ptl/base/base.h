@@ -34,6 +34,7 @@
 #include <string.h>
 #endif
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_pointer_array.h"
 #include "src/mca/mca.h"
 #include "src/mca/base/pmix_mca_base_framework.h"
@@ -74,12 +75,17 @@ struct pmix_ptl_globals_t {
     pmix_list_t actives;
     bool initialized;
     pmix_list_t posted_recvs;     // list of pmix_ptl_posted_recv_t
+    pmix_hash_table_t dynrecvs;   // index of the dynamic-tag entries in posted_recvs
     pmix_list_t unexpected_msgs;
     int stop_thread[2];
     bool listen_thread_active;
     pmix_list_t listeners;
     uint32_t current_tag;
     size_t max_msg_size;
+    int recv_threads;             // number of progress threads servicing peer recv events
+    int connect_timeout;          // seconds to wait on each connect attempt, 0 => no bound
+    int validate_threads;         // number of threads validating client credentials
+    size_t peer_queue_limit;      // bytes queued to a peer beyond which droppable msgs are dropped, 0 => no limit
 };
 typedef struct pmix_ptl_globals_t pmix_ptl_globals_t;
 
@@ -89,12 +95,23 @@ PMIX_EXPORT extern pmix_ptl_globals_t pmix_ptl_globals;
 PMIX_EXPORT pmix_status_t pmix_ptl_base_set_notification_cbfunc(pmix_ptl_cbfunc_t cbfunc);
 PMIX_EXPORT char* pmix_ptl_base_get_available_modules(void);
 PMIX_EXPORT pmix_ptl_module_t* pmix_ptl_base_assign_module(void);
+PMIX_EXPORT pmix_event_base_t* pmix_ptl_base_recv_evbase(void);
+
+/* callback with the result of validating a peer's credential,
+ * always executed on the main progress thread */
+typedef void (*pmix_ptl_validate_cbfunc_t)(pmix_status_t status,
+                                           pmix_peer_t *peer, void *cbdata);
+PMIX_EXPORT void pmix_ptl_base_validate_connection(pmix_peer_t *peer,
+                                                   pmix_byte_object_t *cred,
+                                                   pmix_ptl_validate_cbfunc_t cbfunc,
+                                                   void *cbdata);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_connect_to_peer(struct pmix_peer_t *peer,
                                                         pmix_info_t info[], size_t ninfo);
 
 PMIX_EXPORT pmix_status_t pmix_ptl_base_register_recv(struct pmix_peer_t *peer,
                                                       pmix_ptl_cbfunc_t cbfunc,
                                                       pmix_ptl_tag_t tag);
+PMIX_EXPORT void pmix_ptl_base_post_dynamic_recv(pmix_ptl_posted_recv_t *req);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_cancel_recv(struct pmix_peer_t *peer,
                                                     pmix_ptl_tag_t tag);
 
@@ -118,6 +135,7 @@ PMIX_EXPORT void pmix_ptl_base_connection_handler(int sd, short args, void *cbda
 PMIX_EXPORT pmix_status_t pmix_ptl_base_send_connect_ack(int sd);
 PMIX_EXPORT pmix_status_t pmix_ptl_base_recv_connect_ack(int sd);
 PMIX_EXPORT void pmix_ptl_base_lost_connection(pmix_peer_t *peer, pmix_status_t err);
+PMIX_EXPORT bool pmix_ptl_base_queue_full(pmix_peer_t *peer, uint32_t tag, size_t nbytes);
 
 
 END_C_DECLS
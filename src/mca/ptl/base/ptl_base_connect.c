@@ -30,6 +30,9 @@
 #ifdef HAVE_SYS_SOCKET_H
 #include <sys/socket.h>
 #endif
+#ifdef HAVE_POLL_H
+#include <poll.h>
+#endif
 
 #include "include/pmix_socket_errno.h"
 #include "src/util/argv.h"
@@ -181,6 +184,57 @@ pmix_status_t pmix_ptl_base_recv_blocking(int sd, char *data, size_t size)
 
 #define PMIX_MAX_RETRIES 10
 
+/* connect, but give up on this attempt after connect_timeout seconds
+ * so that an unreachable host doesn't hold us for the full kernel
+ * SYN timeout. Returns 0 on success, -1 with errno set otherwise */
+static int timed_connect(int sd, struct sockaddr *addr, pmix_socklen_t addrlen)
+{
+#ifdef HAVE_POLL_H
+    struct pollfd pfd;
+    int rc, err = 0;
+    socklen_t errlen = sizeof(err);
+
+    /* a local socket either answers or refuses right away - and a
+     * non-blocking connect to one with a full backlog fails with
+     * EAGAIN rather than waiting, so leave those alone */
+    if (0 >= pmix_ptl_globals.connect_timeout ||
+        (AF_INET != addr->sa_family && AF_INET6 != addr->sa_family)) {
+        return connect(sd, addr, addrlen);
+    }
+    pmix_ptl_base_set_nonblocking(sd);
+    if (0 == connect(sd, addr, addrlen)) {
+        pmix_ptl_base_set_blocking(sd);
+        return 0;
+    }
+    if (EINPROGRESS != pmix_socket_errno) {
+        return -1;
+    }
+    pfd.fd = sd;
+    pfd.events = POLLOUT;
+    do {
+        rc = poll(&pfd, 1, pmix_ptl_globals.connect_timeout * 1000);
+    } while (rc < 0 && EINTR == pmix_socket_errno);
+    if (0 == rc) {
+        errno = ETIMEDOUT;
+        return -1;
+    } else if (rc < 0) {
+        return -1;
+    }
+    if (0 > getsockopt(sd, SOL_SOCKET, SO_ERROR, &err, &errlen)) {
+        return -1;
+    }
+    if (0 != err) {
+        errno = err;
+        return -1;
+    }
+    /* callers expect a blocking socket for the handshake */
+    pmix_ptl_base_set_blocking(sd);
+    return 0;
+#else
+    return connect(sd, addr, addrlen);
+#endif
+}
+
 pmix_status_t pmix_ptl_base_connect(struct sockaddr_storage *addr,
                                     pmix_socklen_t addrlen, int *fd)
 {
@@ -203,7 +257,7 @@ pmix_status_t pmix_ptl_base_connect(struct sockaddr_storage *addr,
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                             "pmix_ptl_base_connect: attempting to connect to server on socket %d", sd);
         /* try to connect */
-        if (connect(sd, (struct sockaddr*)addr, addrlen) < 0) {
+        if (timed_connect(sd, (struct sockaddr*)addr, addrlen) < 0) {
             if (pmix_socket_errno == ETIMEDOUT) {
                 /* The server may be too busy to accept new connections */
                 pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
@@ -222,6 +276,13 @@ pmix_status_t pmix_ptl_base_connect(struct sockaddr_storage *addr,
                                     "connection to server aborted by OS - retrying");
                 CLOSE_THE_SOCKET(sd);
                 continue;
+            } else if (ECONNREFUSED == pmix_socket_errno) {
+                /* nobody is listening there - most likely a stale
+                 * rendezvous point, so retrying won't help */
+                pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                                    "connection to server refused");
+                CLOSE_THE_SOCKET(sd);
+                return PMIX_ERR_UNREACH;
             } else {
                 pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                     "Connect failed: %s (%d)", strerror(pmix_socket_errno),
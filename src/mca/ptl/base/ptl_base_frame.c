@@ -43,6 +43,9 @@
 #include "src/mca/base/pmix_mca_base_framework.h"
 #include "src/class/pmix_list.h"
 #include "src/client/pmix_client_ops.h"
+#include "src/runtime/pmix_progress_threads.h"
+#include "src/util/error.h"
+#include "src/mca/psec/psec.h"
 #include "src/mca/ptl/base/base.h"
 
 /*
@@ -60,6 +63,10 @@ pmix_ptl_globals_t pmix_ptl_globals = {{{0}}};
 int pmix_ptl_base_output = -1;
 
 static size_t max_msg_size = PMIX_MAX_MSG_SIZE;
+static pmix_event_base_t **recv_bases = NULL;
+static int next_recv_base = 0;
+static pmix_event_base_t **validate_bases = NULL;
+static int next_validate_base = 0;
 
 static int pmix_ptl_register(pmix_mca_base_register_flag_t flags)
 {
@@ -70,11 +77,189 @@ static int pmix_ptl_register(pmix_mca_base_register_flag_t flags)
                                PMIX_MCA_BASE_VAR_SCOPE_READONLY,
                                &max_msg_size);
     pmix_ptl_globals.max_msg_size = max_msg_size * 1024 * 1024;
+
+    pmix_ptl_globals.recv_threads = 0;
+    pmix_mca_base_var_register("pmix", "ptl", "base", "recv_threads",
+                               "Number of progress threads over which the recv events of clients and tools connected over tcp are spread (0 = service them on the main progress thread)",
+                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                               PMIX_INFO_LVL_5,
+                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                               &pmix_ptl_globals.recv_threads);
+
+    pmix_ptl_globals.connect_timeout = 2;
+    pmix_mca_base_var_register("pmix", "ptl", "base", "connect_timeout",
+                               "Number of seconds to wait for each attempt to connect to a server (0 = wait as long as the OS allows)",
+                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                               PMIX_INFO_LVL_4,
+                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                               &pmix_ptl_globals.connect_timeout);
+
+    pmix_ptl_globals.validate_threads = 0;
+    pmix_mca_base_var_register("pmix", "ptl", "base", "validate_threads",
+                               "Number of threads on which the credentials of connecting clients are validated (0 = validate them on the main progress thread)",
+                               PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                               PMIX_INFO_LVL_5,
+                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                               &pmix_ptl_globals.validate_threads);
+
+    pmix_ptl_globals.peer_queue_limit = 0;
+    pmix_mca_base_var_register("pmix", "ptl", "base", "peer_queue_limit",
+                               "Bytes that may be queued for sending to a single peer before event notifications and forwarded IO to it are dropped (0 = no limit)",
+                               PMIX_MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                               PMIX_INFO_LVL_5,
+                               PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                               &pmix_ptl_globals.peer_queue_limit);
     return PMIX_SUCCESS;
 }
 
+/* return the event base on which the recv event of a newly
+ * connected peer is to be registered. The recv threads are
+ * started on first use so that processes that never accept
+ * a connection don't pay for them */
+pmix_event_base_t* pmix_ptl_base_recv_evbase(void)
+{
+    pmix_event_base_t *evb;
+    char *name;
+
+    if (0 >= pmix_ptl_globals.recv_threads) {
+        return pmix_globals.evbase;
+    }
+    if (NULL == recv_bases) {
+        recv_bases = (pmix_event_base_t**)calloc(pmix_ptl_globals.recv_threads,
+                                                 sizeof(pmix_event_base_t*));
+        if (NULL == recv_bases) {
+            return pmix_globals.evbase;
+        }
+    }
+    if (NULL == (evb = recv_bases[next_recv_base])) {
+        if (0 > asprintf(&name, "PMIX-RECV-%d", next_recv_base)) {
+            return pmix_globals.evbase;
+        }
+        evb = pmix_progress_thread_init(name);
+        free(name);
+        if (NULL == evb) {
+            return pmix_globals.evbase;
+        }
+        recv_bases[next_recv_base] = evb;
+    }
+    next_recv_base = (next_recv_base + 1) % pmix_ptl_globals.recv_threads;
+    return evb;
+}
+
+/* a credential check can block for as long as the security
+ * service takes to answer (e.g., a munge decode), which stalls
+ * every other client while a burst of them connect. When asked
+ * to, we run the check on one of a pool of threads and come back
+ * to the main progress thread with the result */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_peer_t *peer;
+    pmix_byte_object_t cred;    // not owned - must outlive the check
+    pmix_status_t status;
+    pmix_ptl_validate_cbfunc_t cbfunc;
+    void *cbdata;
+} validate_caddy_t;
+static void vcon(validate_caddy_t *p)
+{
+    p->peer = NULL;
+    p->cred.bytes = NULL;
+    p->cred.size = 0;
+    p->status = PMIX_SUCCESS;
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void vdes(validate_caddy_t *p)
+{
+    if (NULL != p->peer) {
+        PMIX_RELEASE(p->peer);
+    }
+}
+static PMIX_CLASS_INSTANCE(validate_caddy_t,
+                           pmix_object_t,
+                           vcon, vdes);
+
+static pmix_event_base_t* validate_evbase(void)
+{
+    pmix_event_base_t *evb;
+    char *name;
+
+    if (NULL == validate_bases) {
+        validate_bases = (pmix_event_base_t**)calloc(pmix_ptl_globals.validate_threads,
+                                                     sizeof(pmix_event_base_t*));
+        if (NULL == validate_bases) {
+            return NULL;
+        }
+    }
+    if (NULL == (evb = validate_bases[next_validate_base])) {
+        if (0 > asprintf(&name, "PMIX-PSEC-%d", next_validate_base)) {
+            return NULL;
+        }
+        evb = pmix_progress_thread_init(name);
+        free(name);
+        if (NULL == evb) {
+            return NULL;
+        }
+        validate_bases[next_validate_base] = evb;
+    }
+    next_validate_base = (next_validate_base + 1) % pmix_ptl_globals.validate_threads;
+    return evb;
+}
+
+static void validated(int sd, short args, void *cbdata)
+{
+    validate_caddy_t *vd = (validate_caddy_t*)cbdata;
+
+    PMIX_ACQUIRE_OBJECT(vd);
+    vd->cbfunc(vd->status, vd->peer, vd->cbdata);
+    PMIX_RELEASE(vd);
+}
+
+static void validate(int sd, short args, void *cbdata)
+{
+    validate_caddy_t *vd = (validate_caddy_t*)cbdata;
+
+    PMIX_ACQUIRE_OBJECT(vd);
+    /* the socket is still blocking, so the result (or
+     * handshake) goes back to the peer from here */
+    PMIX_PSEC_VALIDATE_CONNECTION(vd->status, vd->peer, NULL, 0, NULL, NULL, &vd->cred);
+    PMIX_THREADSHIFT(vd, validated);
+}
+
+/* validate the credential presented by a connecting peer whose
+ * socket is still in blocking mode */
+void pmix_ptl_base_validate_connection(pmix_peer_t *peer,
+                                       pmix_byte_object_t *cred,
+                                       pmix_ptl_validate_cbfunc_t cbfunc,
+                                       void *cbdata)
+{
+    validate_caddy_t *vd;
+    pmix_event_base_t *evb;
+    pmix_status_t rc;
+
+    if (0 < pmix_ptl_globals.validate_threads &&
+        NULL != (evb = validate_evbase()) &&
+        NULL != (vd = PMIX_NEW(validate_caddy_t))) {
+        PMIX_RETAIN(peer);
+        vd->peer = peer;
+        vd->cred = *cred;
+        vd->cbfunc = cbfunc;
+        vd->cbdata = cbdata;
+        pmix_event_assign(&vd->ev, evb, -1, EV_WRITE, validate, vd);
+        PMIX_POST_OBJECT(vd);
+        pmix_event_active(&vd->ev, EV_WRITE, 1);
+        return;
+    }
+
+    PMIX_PSEC_VALIDATE_CONNECTION(rc, peer, NULL, 0, NULL, NULL, cred);
+    cbfunc(rc, peer, cbdata);
+}
+
 static pmix_status_t pmix_ptl_close(void)
 {
+    int n;
+    char *name;
+
     if (!pmix_ptl_globals.initialized) {
         return PMIX_SUCCESS;
     }
@@ -90,8 +275,34 @@ static pmix_status_t pmix_ptl_close(void)
         }
     }
 
+    if (NULL != recv_bases) {
+        for (n=0; n < pmix_ptl_globals.recv_threads; n++) {
+            if (NULL != recv_bases[n] &&
+                0 <= asprintf(&name, "PMIX-RECV-%d", n)) {
+                (void)pmix_progress_thread_stop(name);
+                free(name);
+            }
+        }
+        free(recv_bases);
+        recv_bases = NULL;
+        next_recv_base = 0;
+    }
+    if (NULL != validate_bases) {
+        for (n=0; n < pmix_ptl_globals.validate_threads; n++) {
+            if (NULL != validate_bases[n] &&
+                0 <= asprintf(&name, "PMIX-PSEC-%d", n)) {
+                (void)pmix_progress_thread_stop(name);
+                free(name);
+            }
+        }
+        free(validate_bases);
+        validate_bases = NULL;
+        next_validate_base = 0;
+    }
+
     /* the components will cleanup when closed */
     PMIX_LIST_DESTRUCT(&pmix_ptl_globals.actives);
+    PMIX_DESTRUCT(&pmix_ptl_globals.dynrecvs);
     PMIX_LIST_DESTRUCT(&pmix_ptl_globals.posted_recvs);
     PMIX_LIST_DESTRUCT(&pmix_ptl_globals.unexpected_msgs);
     PMIX_LIST_DESTRUCT(&pmix_ptl_globals.listeners);
@@ -107,6 +318,8 @@ static pmix_status_t pmix_ptl_open(pmix_mca_base_open_flag_t flags)
     pmix_ptl_globals.initialized = true;
     PMIX_CONSTRUCT(&pmix_ptl_globals.actives, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_ptl_globals.posted_recvs, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_ptl_globals.dynrecvs, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_ptl_globals.dynrecvs, 256);
     PMIX_CONSTRUCT(&pmix_ptl_globals.unexpected_msgs, pmix_list_t);
     pmix_ptl_globals.listen_thread_active = false;
     PMIX_CONSTRUCT(&pmix_ptl_globals.listeners, pmix_list_t);
@@ -136,6 +349,7 @@ static void scon(pmix_ptl_send_t *p)
     p->hdr_sent = false;
     p->sdptr = NULL;
     p->sdbytes = 0;
+    p->qbytes = 0;
 }
 static void sdes(pmix_ptl_send_t *p)
 {
@@ -143,7 +357,7 @@ static void sdes(pmix_ptl_send_t *p)
         PMIX_RELEASE(p->data);
     }
 }
-PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_ptl_send_t,
+PMIX_EXPORT PMIX_CLASS_INSTANCE_CACHED(pmix_ptl_send_t,
                                 pmix_list_item_t,
                                 scon, sdes);
 
@@ -164,7 +378,7 @@ static void rdes(pmix_ptl_recv_t *p)
         PMIX_RELEASE(p->peer);
     }
 }
-PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_ptl_recv_t,
+PMIX_EXPORT PMIX_CLASS_INSTANCE_CACHED(pmix_ptl_recv_t,
                                 pmix_list_item_t,
                                 rcon, rdes);
 
@@ -173,8 +387,9 @@ static void prcon(pmix_ptl_posted_recv_t *p)
     p->tag = UINT32_MAX;
     p->cbfunc = NULL;
     p->cbdata = NULL;
+    p->peer = NULL;
 }
-PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_ptl_posted_recv_t,
+PMIX_EXPORT PMIX_CLASS_INSTANCE_CACHED(pmix_ptl_posted_recv_t,
                                 pmix_list_item_t,
                                 prcon, NULL);
 
@@ -192,7 +407,7 @@ static void srdes(pmix_ptl_sr_t *p)
         PMIX_RELEASE(p->peer);
     }
 }
-PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_ptl_sr_t,
+PMIX_EXPORT PMIX_CLASS_INSTANCE_CACHED(pmix_ptl_sr_t,
                                 pmix_object_t,
                                 srcon, srdes);
 
@@ -269,6 +484,6 @@ static void qdes(pmix_ptl_queue_t *p)
         PMIX_RELEASE(p->peer);
     }
 }
-PMIX_EXPORT PMIX_CLASS_INSTANCE(pmix_ptl_queue_t,
+PMIX_EXPORT PMIX_CLASS_INSTANCE_CACHED(pmix_ptl_queue_t,
                                 pmix_object_t,
                                 qcon, qdes);
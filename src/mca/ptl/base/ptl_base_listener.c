@@ -43,6 +43,9 @@
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>
 #endif
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#endif
 #include <ctype.h>
 #include <sys/stat.h>
 #include PMIX_EVENT_HEADER
@@ -180,11 +183,130 @@ void pmix_ptl_base_stop_listening(void)
     }
 }
 
-static void* listen_thread(void *obj)
+/* Harvest every connection currently pending on this listener and push
+ * each onto the event library for processing - we don't want to actually
+ * process the connection here as it takes too long, and so the OS might
+ * start rejecting connections due to timeout. The listening sockets are
+ * non-blocking, so we simply drain until accept tells us there is nothing
+ * more. Returns false if the listener thread should exit */
+static bool accept_connections(pmix_listener_t *lt)
 {
-    int rc, max, accepted_connections;
-    socklen_t addrlen = sizeof(struct sockaddr_storage);
     pmix_pending_connection_t *pending_connection;
+    socklen_t addrlen;
+
+    while (pmix_ptl_globals.listen_thread_active) {
+        pending_connection = PMIX_NEW(pmix_pending_connection_t);
+        pending_connection->protocol = lt->protocol;
+        pending_connection->ptl = lt->ptl;
+        pmix_event_assign(&pending_connection->ev, pmix_globals.evbase, -1,
+                          EV_WRITE, lt->cbfunc, pending_connection);
+        addrlen = sizeof(struct sockaddr_storage);
+#if defined(HAVE_ACCEPT4) && defined(SOCK_CLOEXEC)
+        /* the connection handlers set the blocking mode they need, so
+         * all we ask for here is to not leak the fd into children */
+        pending_connection->sd = accept4(lt->socket,
+                                         (struct sockaddr*)&(pending_connection->addr),
+                                         &addrlen, SOCK_CLOEXEC);
+#else
+        pending_connection->sd = accept(lt->socket,
+                                        (struct sockaddr*)&(pending_connection->addr),
+                                        &addrlen);
+#endif
+        if (pending_connection->sd < 0) {
+            PMIX_RELEASE(pending_connection);
+            if (EAGAIN == pmix_socket_errno ||
+                EWOULDBLOCK == pmix_socket_errno) {
+                /* nothing more waiting */
+                return true;
+            }
+            if (EMFILE == pmix_socket_errno ||
+                ENOBUFS == pmix_socket_errno ||
+                ENOMEM == pmix_socket_errno) {
+                PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
+            } else if (EINVAL == pmix_socket_errno ||
+                       EINTR == pmix_socket_errno) {
+                /* race condition at finalize */
+            } else if (ECONNABORTED == pmix_socket_errno) {
+                /* they aborted the attempt */
+                continue;
+            } else {
+                pmix_output(0, "listen_thread: accept() failed: %s (%d).",
+                            strerror(pmix_socket_errno), pmix_socket_errno);
+            }
+            return false;
+        }
+
+        pmix_output_verbose(8, pmix_ptl_base_framework.framework_output,
+                            "listen_thread: new connection: (%d, %d)",
+                            pending_connection->sd, pmix_socket_errno);
+        /* post the object */
+        PMIX_POST_OBJECT(pending_connection);
+        /* activate the event */
+        pmix_event_active(&pending_connection->ev, EV_WRITE, 1);
+    }
+    return true;
+}
+
+#ifdef HAVE_SYS_EPOLL_H
+#define PMIX_LISTEN_MAX_EVENTS 16
+
+/* epoll avoids rebuilding and rescanning the fd set on every wakeup
+ * when a connect storm hits. Returns false if epoll could not be
+ * setup, in which case the caller falls back to select */
+static bool epoll_listen(void)
+{
+    struct epoll_event ev, events[PMIX_LISTEN_MAX_EVENTS];
+    pmix_listener_t *lt;
+    int efd, n, rc;
+
+    if (0 > (efd = epoll_create1(EPOLL_CLOEXEC))) {
+        return false;
+    }
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    PMIX_LIST_FOREACH(lt, &pmix_ptl_globals.listeners, pmix_listener_t) {
+        ev.data.ptr = lt;
+        if (0 > epoll_ctl(efd, EPOLL_CTL_ADD, lt->socket, &ev)) {
+            close(efd);
+            return false;
+        }
+    }
+    /* the stop_thread fd is marked by a NULL pointer */
+    ev.data.ptr = NULL;
+    if (0 > epoll_ctl(efd, EPOLL_CTL_ADD, pmix_ptl_globals.stop_thread[0], &ev)) {
+        close(efd);
+        return false;
+    }
+
+    while (pmix_ptl_globals.listen_thread_active) {
+        /* block with the same 2 sec timeout as the select loop */
+        rc = epoll_wait(efd, events, PMIX_LISTEN_MAX_EVENTS, 2000);
+        if (!pmix_ptl_globals.listen_thread_active) {
+            /* we've been asked to terminate */
+            close(efd);
+            close(pmix_ptl_globals.stop_thread[0]);
+            close(pmix_ptl_globals.stop_thread[1]);
+            return true;
+        }
+        for (n=0; n < rc; n++) {
+            if (NULL == events[n].data.ptr) {
+                continue;
+            }
+            if (!accept_connections((pmix_listener_t*)events[n].data.ptr)) {
+                close(efd);
+                pmix_ptl_globals.listen_thread_active = false;
+                return true;
+            }
+        }
+    }
+    close(efd);
+    return true;
+}
+#endif
+
+static void* listen_thread(void *obj)
+{
+    int rc, max;
     struct timeval timeout;
     fd_set readfds;
     pmix_listener_t *lt;
@@ -192,6 +314,13 @@ static void* listen_thread(void *obj)
     pmix_output_verbose(8, pmix_ptl_base_framework.framework_output,
                         "listen_thread: active");
 
+#ifdef HAVE_SYS_EPOLL_H
+    if (epoll_listen()) {
+        return NULL;
+    }
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "listen_thread: epoll unavailable - using select");
+#endif
 
     while (pmix_ptl_globals.listen_thread_active) {
         FD_ZERO(&readfds);
@@ -222,74 +351,21 @@ static void* listen_thread(void *obj)
             continue;
         }
 
-        /* Spin accepting connections until all active listen sockets
-         * do not have any incoming connections, pushing each connection
-         * onto the event queue for processing
-         */
-        do {
-            accepted_connections = 0;
-            PMIX_LIST_FOREACH(lt, &pmix_ptl_globals.listeners, pmix_listener_t) {
-
-                /* according to the man pages, select replaces the given descriptor
-                 * set with a subset consisting of those descriptors that are ready
-                 * for the specified operation - in this case, a read. So we need to
-                 * first check to see if this file descriptor is included in the
-                 * returned subset
-                 */
-                if (0 == FD_ISSET(lt->socket, &readfds)) {
-                    /* this descriptor is not included */
-                    continue;
-                }
-
-                /* this descriptor is ready to be read, which means a connection
-                 * request has been received - so harvest it. All we want to do
-                 * here is accept the connection and push the info onto the event
-                 * library for subsequent processing - we don't want to actually
-                 * process the connection here as it takes too long, and so the
-                 * OS might start rejecting connections due to timeout.
-                 */
-                pending_connection = PMIX_NEW(pmix_pending_connection_t);
-                pending_connection->protocol = lt->protocol;
-                pending_connection->ptl = lt->ptl;
-                pmix_event_assign(&pending_connection->ev, pmix_globals.evbase, -1,
-                                  EV_WRITE, lt->cbfunc, pending_connection);
-                pending_connection->sd = accept(lt->socket,
-                                                (struct sockaddr*)&(pending_connection->addr),
-                                                &addrlen);
-                if (pending_connection->sd < 0) {
-                    PMIX_RELEASE(pending_connection);
-                    if (pmix_socket_errno != EAGAIN ||
-                        pmix_socket_errno != EWOULDBLOCK) {
-                        if (EMFILE == pmix_socket_errno ||
-                            ENOBUFS == pmix_socket_errno ||
-                            ENOMEM == pmix_socket_errno) {
-                            PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
-                        } else if (EINVAL == pmix_socket_errno ||
-                                   EINTR == pmix_socket_errno) {
-                            /* race condition at finalize */
-                            goto done;
-                        } else if (ECONNABORTED == pmix_socket_errno) {
-                            /* they aborted the attempt */
-                            continue;
-                        } else {
-                            pmix_output(0, "listen_thread: accept() failed: %s (%d).",
-                                        strerror(pmix_socket_errno), pmix_socket_errno);
-                        }
-                        goto done;
-                    }
-                    continue;
-                }
-
-                pmix_output_verbose(8, pmix_ptl_base_framework.framework_output,
-                                    "listen_thread: new connection: (%d, %d)",
-                                    pending_connection->sd, pmix_socket_errno);
-                /* post the object */
-                PMIX_POST_OBJECT(pending_connection);
-                /* activate the event */
-                pmix_event_active(&pending_connection->ev, EV_WRITE, 1);
-                accepted_connections++;
+        PMIX_LIST_FOREACH(lt, &pmix_ptl_globals.listeners, pmix_listener_t) {
+            /* according to the man pages, select replaces the given descriptor
+             * set with a subset consisting of those descriptors that are ready
+             * for the specified operation - in this case, a read. So we need to
+             * first check to see if this file descriptor is included in the
+             * returned subset
+             */
+            if (0 == FD_ISSET(lt->socket, &readfds)) {
+                /* this descriptor is not included */
+                continue;
             }
-        } while (accepted_connections > 0);
+            if (!accept_connections(lt)) {
+                goto done;
+            }
+        }
     }
 
  done:
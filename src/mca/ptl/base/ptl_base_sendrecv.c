@@ -43,12 +43,22 @@
 #include "src/include/pmix_globals.h"
 #include "src/client/pmix_client_ops.h"
 #include "src/server/pmix_server_ops.h"
+#include "src/util/counters.h"
 #include "src/util/error.h"
 #include "src/util/show_help.h"
+#include "src/util/timings.h"
 #include "src/mca/psensor/psensor.h"
 
 #include "src/mca/ptl/base/base.h"
 
+/* max number of queued messages handed to the kernel in one writev -
+ * two iovecs apiece keeps us within the POSIX minimum IOV_MAX */
+#define PMIX_PTL_SEND_BATCH 8
+
+/* size of the on-stack area the recv handler reads into when it is
+ * not in the middle of a message */
+#define PMIX_PTL_RECV_STAGE 16384
+
 static void _notify_complete(pmix_status_t status, void *cbdata)
 {
     pmix_event_chain_t *chain = (pmix_event_chain_t*)cbdata;
@@ -64,13 +74,15 @@ static void _timeout(int sd, short args, void *cbdata)
 
 void pmix_ptl_base_lost_connection(pmix_peer_t *peer, pmix_status_t err)
 {
-    pmix_server_trkr_t *trk, *tnxt;
-    pmix_server_caddy_t *rinfo, *rnext;
+    pmix_server_trkr_t *trk;
+    pmix_server_caddy_t *rinfo;
+    pmix_peer_ref_t *ref;
     pmix_rank_info_t *info, *pinfo;
-    pmix_ptl_posted_recv_t *rcv;
+    pmix_ptl_posted_recv_t *rcv, *rnxt;
     pmix_buffer_t buf;
     pmix_ptl_hdr_t hdr;
     struct timeval tv = {1200, 0};
+    int n;
 
     /* stop all events */
     if (peer->recv_ev_active) {
@@ -94,23 +106,51 @@ void pmix_ptl_base_lost_connection(pmix_peer_t *peer, pmix_status_t err)
          * from any local collectives in which it was
          * participating - note that the proc would not
          * have been added to any collective tracker until
-         * after it successfully connected */
-        PMIX_LIST_FOREACH_SAFE(trk, tnxt, &pmix_server_globals.collectives, pmix_server_trkr_t) {
-            /* see if this proc is participating in this tracker */
-            PMIX_LIST_FOREACH_SAFE(rinfo, rnext, &trk->local_cbs, pmix_server_caddy_t) {
-                if (!PMIX_CHECK_PROCID(&rinfo->peer->info->pname, &peer->info->pname)) {
-                    continue;
+         * after it successfully connected. The peer keeps
+         * a reference to each of its entries until the tracker
+         * completes, so we only visit the active trackers it
+         * is actually part of */
+        while (NULL != (ref = (pmix_peer_ref_t*)pmix_list_get_first(&peer->collectives)) &&
+               pmix_list_get_end(&peer->collectives) != &ref->super) {
+            rinfo = (pmix_server_caddy_t*)ref->member;
+            trk = rinfo->member;
+            /* adjust the count */
+            --trk->nlocal;
+            /* remove it from the list */
+            pmix_server_trk_del_local(rinfo);
+            PMIX_RELEASE(rinfo);
+            trk->lost_connection = true;  // mark that a peer's connection was lost
+            if (0 == pmix_list_get_size(&trk->local_cbs)) {
+                /* this tracker is complete, so release it - there
+                 * is nobody waiting for a response */
+                pmix_server_trk_remove(trk);
+                /* do NOT release the tracker here as the host may
+                 * have a copy they will return later. However, they
+                 * might never call back, so set a LONG timeout to
+                 * we avoid a memory leak if they don't */
+                pmix_event_evtimer_set(pmix_globals.evbase, &trk->ev,
+                                       _timeout, trk);
+                pmix_event_evtimer_add(&trk->ev, &tv);
+                trk->event_active = true;
+                continue;
+            }
+            /* if there are other participants waiting for a response,
+             * we need to let them know that this proc has disappeared
+             * as otherwise the collective will never complete */
+            if (PMIX_FENCENB_CMD == trk->type) {
+                if (NULL != trk->modexcbfunc) {
+                    /* do NOT release the tracker here as the host may
+                     * have a copy they will return later. However, they
+                     * might never call back, so set a LONG timeout to
+                     * we avoid a memory leak if they don't */
+                    pmix_event_evtimer_set(pmix_globals.evbase, &trk->ev,
+                                           _timeout, trk);
+                    pmix_event_evtimer_add(&trk->ev, &tv);
+                    trk->event_active = true;
+                    trk->modexcbfunc(PMIX_ERR_LOST_CONNECTION_TO_CLIENT, NULL, 0, trk, NULL, NULL);
                 }
-                /* it is - adjust the count */
-                --trk->nlocal;
-                /* remove it from the list */
-                pmix_list_remove_item(&trk->local_cbs, &rinfo->super);
-                PMIX_RELEASE(rinfo);
-                trk->lost_connection = true;  // mark that a peer's connection was lost
-                if (0 == pmix_list_get_size(&trk->local_cbs)) {
-                    /* this tracker is complete, so release it - there
-                     * is nobody waiting for a response */
-                    pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+            } else if (PMIX_CONNECTNB_CMD == trk->type) {
+                if (NULL != trk->op_cbfunc) {
                     /* do NOT release the tracker here as the host may
                      * have a copy they will return later. However, they
                      * might never call back, so set a LONG timeout to
@@ -119,47 +159,19 @@ void pmix_ptl_base_lost_connection(pmix_peer_t *peer, pmix_status_t err)
                                            _timeout, trk);
                     pmix_event_evtimer_add(&trk->ev, &tv);
                     trk->event_active = true;
-                    break;
+                    trk->op_cbfunc(PMIX_ERR_LOST_CONNECTION_TO_CLIENT, trk);
                 }
-                /* if there are other participants waiting for a response,
-                 * we need to let them know that this proc has disappeared
-                 * as otherwise the collective will never complete */
-                if (PMIX_FENCENB_CMD == trk->type) {
-                    if (NULL != trk->modexcbfunc) {
-                        /* do NOT release the tracker here as the host may
-                         * have a copy they will return later. However, they
-                         * might never call back, so set a LONG timeout to
-                         * we avoid a memory leak if they don't */
-                        pmix_event_evtimer_set(pmix_globals.evbase, &trk->ev,
-                                               _timeout, trk);
-                        pmix_event_evtimer_add(&trk->ev, &tv);
-                        trk->event_active = true;
-                        trk->modexcbfunc(PMIX_ERR_LOST_CONNECTION_TO_CLIENT, NULL, 0, trk, NULL, NULL);
-                    }
-                } else if (PMIX_CONNECTNB_CMD == trk->type) {
-                    if (NULL != trk->op_cbfunc) {
-                        /* do NOT release the tracker here as the host may
-                         * have a copy they will return later. However, they
-                         * might never call back, so set a LONG timeout to
-                         * we avoid a memory leak if they don't */
-                        pmix_event_evtimer_set(pmix_globals.evbase, &trk->ev,
-                                               _timeout, trk);
-                        pmix_event_evtimer_add(&trk->ev, &tv);
-                        trk->event_active = true;
-                        trk->op_cbfunc(PMIX_ERR_LOST_CONNECTION_TO_CLIENT, trk);
-                    }
-                } else if (PMIX_DISCONNECTNB_CMD == trk->type) {
-                    if (NULL != trk->op_cbfunc) {
-                        /* do NOT release the tracker here as the host may
-                         * have a copy they will return later. However, they
-                         * might never call back, so set a LONG timeout to
-                         * we avoid a memory leak if they don't */
-                        pmix_event_evtimer_set(pmix_globals.evbase, &trk->ev,
-                                               _timeout, trk);
-                        pmix_event_evtimer_add(&trk->ev, &tv);
-                        trk->event_active = true;
-                        trk->op_cbfunc(PMIX_ERR_LOST_CONNECTION_TO_CLIENT, trk);
-                    }
+            } else if (PMIX_DISCONNECTNB_CMD == trk->type) {
+                if (NULL != trk->op_cbfunc) {
+                    /* do NOT release the tracker here as the host may
+                     * have a copy they will return later. However, they
+                     * might never call back, so set a LONG timeout to
+                     * we avoid a memory leak if they don't */
+                    pmix_event_evtimer_set(pmix_globals.evbase, &trk->ev,
+                                           _timeout, trk);
+                    pmix_event_evtimer_add(&trk->ev, &tv);
+                    trk->event_active = true;
+                    trk->op_cbfunc(PMIX_ERR_LOST_CONNECTION_TO_CLIENT, trk);
                 }
             }
         }
@@ -169,9 +181,10 @@ void pmix_ptl_base_lost_connection(pmix_peer_t *peer, pmix_status_t err)
          * one for each "clone" of this peer */
         PMIX_LIST_FOREACH_SAFE(info, pinfo, &(peer->nptr->ranks), pmix_rank_info_t) {
             if (info == peer->info) {
-                pmix_list_remove_item(&(peer->nptr->ranks), &(peer->info->super));
+                pmix_nspace_remove_rank(peer->nptr, peer->info);
             }
         }
+        pmix_server_ptable_remove(peer->nptr, peer->info->pname.rank);
         /* reduce the number of local procs */
         if (0 < peer->nptr->nlocalprocs) {
             --peer->nptr->nlocalprocs;
@@ -207,7 +220,36 @@ void pmix_ptl_base_lost_connection(pmix_peer_t *peer, pmix_status_t err)
 
         /* Release peer info */
         PMIX_RELEASE(peer);
-     } else {
+    } else if (PMIX_PROC_IS_TOOL(pmix_globals.mypeer) &&
+               peer != pmix_client_globals.myserver) {
+        /* one of the additional servers this tool attached to - our
+         * other connections are unaffected, so just complete anything
+         * still waiting on a reply from this one and forget it */
+        for (n=0; n < pmix_client_globals.servers.size; n++) {
+            if (peer == (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_client_globals.servers, n)) {
+                pmix_pointer_array_set_item(&pmix_client_globals.servers, n, NULL);
+                break;
+            }
+        }
+        peer->finalized = true;
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        /* must set the buffer type so it doesn't fail in unpack */
+        buf.type = peer->nptr->compat.type;
+        hdr.nbytes = 0; // initialize the hdr to something safe
+        PMIX_LIST_FOREACH_SAFE(rcv, rnxt, &pmix_ptl_globals.posted_recvs, pmix_ptl_posted_recv_t) {
+            if ((struct pmix_peer_t*)peer == rcv->peer && NULL != rcv->cbfunc) {
+                pmix_list_remove_item(&pmix_ptl_globals.posted_recvs, &rcv->super);
+                hdr.tag = rcv->tag;
+                rcv->cbfunc((struct pmix_peer_t*)peer, &hdr, &buf, rcv->cbdata);
+                PMIX_RELEASE(rcv);
+            }
+        }
+        PMIX_DESTRUCT(&buf);
+        if (n < pmix_client_globals.servers.size) {
+            /* drop the reference the array held */
+            PMIX_RELEASE(peer);
+        }
+    } else {
         /* if I am a client, there is only
          * one connection we can have */
         pmix_globals.connected = false;
@@ -239,6 +281,30 @@ void pmix_ptl_base_lost_connection(pmix_peer_t *peer, pmix_status_t err)
     }
 }
 
+/* account for a short write of rc bytes against this message */
+static void advance_msg(pmix_ptl_send_t *msg, size_t rc)
+{
+    if (rc < msg->sdbytes) {
+        /* partial write of the header or the msg data */
+        msg->sdptr = (char *)msg->sdptr + rc;
+        msg->sdbytes -= rc;
+    } else {
+        /* header was fully written, but only a part of the msg data was written */
+        msg->hdr_sent = true;
+        rc -= msg->sdbytes;
+        if (NULL != msg->data) {
+            /* technically, this should never happen as iov_count
+             * would be 1 for a zero-byte message, and so we cannot
+             * have a case where we write the header and part of the
+             * msg. However, code checkers don't know that and are
+             * fooled by our earlier check for NULL, and so
+             * we silence their warnings by using this check */
+            msg->sdptr = (char *)msg->data->base_ptr + rc;
+        }
+        msg->sdbytes = ntohl(msg->hdr.nbytes) - rc;
+    }
+}
+
 static pmix_status_t send_msg(int sd, pmix_ptl_send_t *msg)
 {
     struct iovec iov[2];
@@ -289,27 +355,96 @@ static pmix_status_t send_msg(int sd, pmix_ptl_send_t *msg)
         /* short writev. This usually means the kernel buffer is full,
          * so there is no point for retrying at that time.
          * simply update the msg and return with PMIX_ERR_RESOURCE_BUSY */
-        if ((size_t)rc < msg->sdbytes) {
-            /* partial write of the header or the msg data */
-            msg->sdptr = (char *)msg->sdptr + rc;
-            msg->sdbytes -= rc;
+        advance_msg(msg, rc);
+        return PMIX_ERR_RESOURCE_BUSY;
+    }
+}
+
+/* number of bytes of this message still waiting to go out */
+static inline size_t remaining_bytes(pmix_ptl_send_t *msg)
+{
+    size_t n = msg->sdbytes;
+
+    if (!msg->hdr_sent && NULL != msg->data) {
+        n += ntohl(msg->hdr.nbytes);
+    }
+    return n;
+}
+
+/* Gather the on-deck message plus as many of the queued messages as
+ * will fit into a single writev. Messages that go out completely are
+ * released and removed from the queue - the first one that is only
+ * partially written becomes the new on-deck message. On error, the
+ * on-deck message is left in place for the caller to dispose of */
+static pmix_status_t send_batch(int sd, pmix_peer_t *peer)
+{
+    struct iovec iov[2 * PMIX_PTL_SEND_BATCH];
+    pmix_ptl_send_t *msgs[PMIX_PTL_SEND_BATCH], *msg;
+    int iov_count = 0, nmsgs = 0, n;
+    size_t len;
+    ssize_t rc;
+
+    msg = peer->send_msg;
+    while (NULL != msg && nmsgs < PMIX_PTL_SEND_BATCH) {
+        iov[iov_count].iov_base = msg->sdptr;
+        iov[iov_count].iov_len = msg->sdbytes;
+        ++iov_count;
+        if (!msg->hdr_sent && NULL != msg->data) {
+            iov[iov_count].iov_base = msg->data->base_ptr;
+            iov[iov_count].iov_len = ntohl(msg->hdr.nbytes);
+            ++iov_count;
+        }
+        msgs[nmsgs++] = msg;
+        if (1 == nmsgs) {
+            msg = (pmix_ptl_send_t*)pmix_list_get_first(&peer->send_queue);
         } else {
-            /* header was fully written, but only a part of the msg data was written */
-            msg->hdr_sent = true;
-            rc -= msg->sdbytes;
-            if (NULL != msg->data) {
-                /* technically, this should never happen as iov_count
-                 * would be 1 for a zero-byte message, and so we cannot
-                 * have a case where we write the header and part of the
-                 * msg. However, code checkers don't know that and are
-                 * fooled by our earlier check for NULL, and so
-                 * we silence their warnings by using this check */
-                msg->sdptr = (char *)msg->data->base_ptr + rc;
-            }
-            msg->sdbytes = ntohl(msg->hdr.nbytes) - rc;
+            msg = (pmix_ptl_send_t*)pmix_list_get_next(&msg->super);
         }
-        return PMIX_ERR_RESOURCE_BUSY;
+        if ((pmix_list_item_t*)msg == pmix_list_get_end(&peer->send_queue)) {
+            msg = NULL;
+        }
+    }
+
+  retry:
+    rc = writev(sd, iov, iov_count);
+    if (rc < 0) {
+        if (pmix_socket_errno == EINTR) {
+            goto retry;
+        } else if (pmix_socket_errno == EAGAIN) {
+            return PMIX_ERR_RESOURCE_BUSY;
+        } else if (pmix_socket_errno == EWOULDBLOCK) {
+            return PMIX_ERR_WOULD_BLOCK;
+        }
+        pmix_output(0, "pmix_ptl_base: send_batch: write failed: %s (%d) [sd = %d]",
+                    strerror(pmix_socket_errno),
+                    pmix_socket_errno, sd);
+        return PMIX_ERR_UNREACH;
+    }
+
+    /* retire everything that went out in full */
+    for (n=0; n < nmsgs; n++) {
+        len = remaining_bytes(msgs[n]);
+        if ((size_t)rc < len) {
+            break;
+        }
+        rc -= len;
+        if (0 < n) {
+            pmix_list_remove_item(&peer->send_queue, &msgs[n]->super);
+        }
+        PMIX_PTL_DEQUEUED(peer, msgs[n]);
+        PMIX_RELEASE(msgs[n]);
     }
+    if (n == nmsgs) {
+        peer->send_msg = NULL;
+        return PMIX_SUCCESS;
+    }
+    /* the kernel buffer filled up part way through this one */
+    advance_msg(msgs[n], rc);
+    if (0 < n) {
+        pmix_list_remove_item(&peer->send_queue, &msgs[n]->super);
+        peer->send_msg = msgs[n];
+    }
+    return PMIX_ERR_RESOURCE_BUSY;
 }
 
 static pmix_status_t read_bytes(int sd, char **buf, size_t *remain)
@@ -389,12 +524,23 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
                             "ptl:base:send_handler SENDING MSG TO %s:%d TAG %u",
                             peer->info->pname.nspace, peer->info->pname.rank,
                             ntohl(msg->hdr.tag));
-        if (PMIX_SUCCESS == (rc = send_msg(peer->sd, msg))) {
+        PMIX_TRACE_START(start);
+        if (pmix_list_is_empty(&peer->send_queue)) {
+            rc = send_msg(peer->sd, msg);
+            if (PMIX_SUCCESS == rc) {
+                PMIX_PTL_DEQUEUED(peer, msg);
+                PMIX_RELEASE(msg);
+                peer->send_msg = NULL;
+            }
+        } else {
+            /* coalesce the backlog into as few syscalls as we can */
+            rc = send_batch(peer->sd, peer);
+        }
+        PMIX_TRACE_SPAN("ptl.send", start);
+        if (PMIX_SUCCESS == rc) {
             // message is complete
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "ptl:base:send_handler MSG SENT");
-            PMIX_RELEASE(msg);
-            peer->send_msg = NULL;
         } else if (PMIX_ERR_RESOURCE_BUSY == rc ||
                    PMIX_ERR_WOULD_BLOCK == rc) {
             /* exit this event and let the event lib progress */
@@ -412,6 +558,7 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
             // report the error
             pmix_event_del(&peer->send_event);
             peer->send_ev_active = false;
+            PMIX_PTL_DEQUEUED(peer, msg);
             PMIX_RELEASE(msg);
             peer->send_msg = NULL;
             pmix_ptl_base_lost_connection(peer, rc);
@@ -441,19 +588,170 @@ void pmix_ptl_base_send_handler(int sd, short flags, void *cbdata)
     PMIX_POST_OBJECT(peer);
 }
 
+static pmix_ptl_recv_t* recv_start(pmix_peer_t *peer, int sd)
+{
+    pmix_ptl_recv_t *msg;
+
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base:recv:handler allocate new recv msg");
+    msg = PMIX_NEW(pmix_ptl_recv_t);
+    if (NULL == msg) {
+        pmix_output(0, "sptl:base:recv_handler: unable to allocate recv message\n");
+        return NULL;
+    }
+    PMIX_RETAIN(peer);
+    msg->peer = peer;  // provide a handle back to the peer object
+    msg->sd = sd;
+    /* start by reading the header */
+    msg->rdptr = (char*)&msg->hdr;
+    msg->rdbytes = sizeof(pmix_ptl_hdr_t);
+    return msg;
+}
+
+/* the full header is in msg->hdr - convert it and setup to read the
+ * data region, if any */
+static pmix_status_t recv_hdr_complete(pmix_peer_t *peer, pmix_ptl_recv_t *msg)
+{
+    msg->hdr_recvd = true;
+    /* convert the hdr to host format */
+    msg->hdr.pindex = ntohl(msg->hdr.pindex);
+    msg->hdr.tag = ntohl(msg->hdr.tag);
+    msg->hdr.nbytes = ntohl(msg->hdr.nbytes);
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "RECVD MSG FOR TAG %d SIZE %d",
+                        (int)msg->hdr.tag, (int)msg->hdr.nbytes);
+    /* if this is a zero-byte message, then we are done */
+    if (0 == msg->hdr.nbytes) {
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "RECVD ZERO-BYTE MESSAGE FROM %s:%u for tag %d",
+                            peer->info->pname.nspace, peer->info->pname.rank,
+                            msg->hdr.tag);
+        msg->data = NULL;  // make sure
+        msg->rdptr = NULL;
+        msg->rdbytes = 0;
+        return PMIX_SUCCESS;
+    }
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "ptl:base:recv:handler allocate data region of size %lu",
+                        (unsigned long)msg->hdr.nbytes);
+    /* allocate the data region */
+    if (pmix_ptl_globals.max_msg_size < msg->hdr.nbytes) {
+        pmix_show_help("help-pmix-runtime.txt", "ptl:msg_size", true,
+                       (unsigned long)msg->hdr.nbytes,
+                       (unsigned long)pmix_ptl_globals.max_msg_size);
+        return PMIX_ERR_BAD_PARAM;
+    }
+    /* every byte will be overwritten by the read */
+    msg->data = (char*)malloc(msg->hdr.nbytes);
+    if (NULL == msg->data) {
+        return PMIX_ERR_NOMEM;
+    }
+    /* point to it */
+    msg->rdptr = msg->data;
+    msg->rdbytes = msg->hdr.nbytes;
+    return PMIX_SUCCESS;
+}
+
+/* Read as much as the socket will give us in a single call and carve
+ * it into messages. Anything that arrived complete is posted for
+ * delivery right away. A trailing partial header or body is left in
+ * peer->recv_msg so the regular path can finish it - large bodies thus
+ * continue to be read straight into their own data region */
+static pmix_status_t recv_staged(pmix_peer_t *peer, int sd)
+{
+    char stage[PMIX_PTL_RECV_STAGE];
+    pmix_ptl_recv_t *msg;
+    size_t off = 0, avail, n;
+    ssize_t got;
+    pmix_status_t rc;
+
+  retry:
+    got = read(peer->sd, stage, sizeof(stage));
+    if (got < 0) {
+        if (pmix_socket_errno == EINTR) {
+            goto retry;
+        } else if (pmix_socket_errno == EAGAIN) {
+            return PMIX_ERR_RESOURCE_BUSY;
+        } else if (pmix_socket_errno == EWOULDBLOCK) {
+            return PMIX_ERR_WOULD_BLOCK;
+        }
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "pmix_ptl_base_msg_recv: read failed: %s (%d)",
+                            strerror(pmix_socket_errno),
+                            pmix_socket_errno);
+        return PMIX_ERR_UNREACH;
+    } else if (0 == got) {
+        /* the remote peer closed the connection */
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "%s:%d ptl:base:msg_recv: peer %s:%d closed connection",
+                            pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                            peer->nptr->nspace, peer->info->pname.rank);
+        return PMIX_ERR_UNREACH;
+    }
+
+    while (off < (size_t)got) {
+        if (NULL == (msg = recv_start(peer, sd))) {
+            return PMIX_ERR_NOMEM;
+        }
+        /* let the caller's cleanup find it if we fail */
+        peer->recv_msg = msg;
+        avail = (size_t)got - off;
+        if (avail < sizeof(pmix_ptl_hdr_t)) {
+            memcpy(msg->rdptr, stage + off, avail);
+            msg->rdptr += avail;
+            msg->rdbytes -= avail;
+            return PMIX_SUCCESS;
+        }
+        memcpy(&msg->hdr, stage + off, sizeof(pmix_ptl_hdr_t));
+        off += sizeof(pmix_ptl_hdr_t);
+        if (PMIX_SUCCESS != (rc = recv_hdr_complete(peer, msg))) {
+            return rc;
+        }
+        if (0 < msg->rdbytes) {
+            n = (size_t)got - off;
+            if (msg->rdbytes < n) {
+                n = msg->rdbytes;
+            }
+            memcpy(msg->rdptr, stage + off, n);
+            msg->rdptr += n;
+            msg->rdbytes -= n;
+            off += n;
+            if (0 < msg->rdbytes) {
+                /* body continues on the wire */
+                return PMIX_SUCCESS;
+            }
+        }
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "%s:%d RECVD COMPLETE STAGED MESSAGE OF %d BYTES FOR TAG %d ON PEER SOCKET %d",
+                            pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                            (int)msg->hdr.nbytes, msg->hdr.tag, peer->sd);
+        PMIX_ACTIVATE_POST_MSG(msg);
+        peer->recv_msg = NULL;
+    }
+    return PMIX_SUCCESS;
+}
+
 /*
  * Dispatch to the appropriate action routine based on the state
  * of the connection with the peer.
  */
 
+static void recv_lost(int sd, short args, void *cbdata)
+{
+    pmix_ptl_queue_t *q = (pmix_ptl_queue_t*)cbdata;
+
+    /* acquire the object */
+    PMIX_ACQUIRE_OBJECT(q);
+    pmix_ptl_base_lost_connection(q->peer, PMIX_ERR_UNREACH);
+    PMIX_RELEASE(q);
+}
+
 void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
 {
     pmix_status_t rc;
     pmix_peer_t *peer = (pmix_peer_t*)cbdata;
     pmix_ptl_recv_t *msg = NULL;
-    pmix_ptl_hdr_t hdr;
-    size_t nbytes;
-    char *ptr;
+    pmix_ptl_queue_t *q;
 
     /* acquire the object */
     PMIX_ACQUIRE_OBJECT(peer);
@@ -467,20 +765,22 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
     if (NULL == peer) {
         return;
     }
-    /* allocate a new message and setup for recv */
     if (NULL == peer->recv_msg) {
-        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                            "ptl:base:recv:handler allocate new recv msg");
-        peer->recv_msg = PMIX_NEW(pmix_ptl_recv_t);
-        if (NULL == peer->recv_msg) {
-            pmix_output(0, "sptl:base:recv_handler: unable to allocate recv message\n");
+        /* not in the middle of anything, so grab whatever the socket
+         * has for us in one read and deliver every message that arrived
+         * complete - only a trailing fragment is left to the code below */
+        if (PMIX_SUCCESS != (rc = recv_staged(peer, sd))) {
+            if (PMIX_ERR_RESOURCE_BUSY == rc ||
+                PMIX_ERR_WOULD_BLOCK == rc) {
+                PMIX_POST_OBJECT(peer);
+                return;
+            }
             goto err_close;
         }
-        PMIX_RETAIN(peer);
-        peer->recv_msg->peer = peer;  // provide a handle back to the peer object
-        /* start by reading the header */
-        peer->recv_msg->rdptr = (char*)&peer->recv_msg->hdr;
-        peer->recv_msg->rdbytes = sizeof(pmix_ptl_hdr_t);
+        if (NULL == peer->recv_msg) {
+            PMIX_POST_OBJECT(peer);
+            return;
+        }
     }
     msg = peer->recv_msg;
     msg->sd = sd;
@@ -488,54 +788,23 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
     if (!msg->hdr_recvd) {
          pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                             "ptl:base:recv:handler read hdr on socket %d", peer->sd);
-        nbytes = sizeof(pmix_ptl_hdr_t);
-        ptr = (char*)&hdr;
-        if (PMIX_SUCCESS == (rc = read_bytes(peer->sd, &ptr, &nbytes))) {
+        if (PMIX_SUCCESS == (rc = read_bytes(peer->sd, &msg->rdptr, &msg->rdbytes))) {
             /* completed reading the header */
-            peer->recv_msg->hdr_recvd = true;
-            /* convert the hdr to host format */
-            peer->recv_msg->hdr.pindex = ntohl(hdr.pindex);
-            peer->recv_msg->hdr.tag = ntohl(hdr.tag);
-            peer->recv_msg->hdr.nbytes = ntohl(hdr.nbytes);
-            pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                                "RECVD MSG FOR TAG %d SIZE %d",
-                                (int)peer->recv_msg->hdr.tag,
-                                (int)peer->recv_msg->hdr.nbytes);
-            /* if this is a zero-byte message, then we are done */
-            if (0 == peer->recv_msg->hdr.nbytes) {
-                pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                                    "RECVD ZERO-BYTE MESSAGE FROM %s:%u for tag %d",
-                                    peer->info->pname.nspace, peer->info->pname.rank,
-                                    peer->recv_msg->hdr.tag);
-                peer->recv_msg->data = NULL;  // make sure
-                peer->recv_msg->rdptr = NULL;
-                peer->recv_msg->rdbytes = 0;
+            if (PMIX_SUCCESS != recv_hdr_complete(peer, msg)) {
+                goto err_close;
+            }
+            if (0 == msg->rdbytes) {
                 /* post it for delivery */
-                PMIX_ACTIVATE_POST_MSG(peer->recv_msg);
+                PMIX_ACTIVATE_POST_MSG(msg);
                 peer->recv_msg = NULL;
                 PMIX_POST_OBJECT(peer);
                 return;
-            } else {
-                pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                                    "ptl:base:recv:handler allocate data region of size %lu",
-                                    (unsigned long)peer->recv_msg->hdr.nbytes);
-                /* allocate the data region */
-                if (pmix_ptl_globals.max_msg_size < peer->recv_msg->hdr.nbytes) {
-                    pmix_show_help("help-pmix-runtime.txt", "ptl:msg_size", true,
-                                   (unsigned long)peer->recv_msg->hdr.nbytes,
-                                   (unsigned long)pmix_ptl_globals.max_msg_size);
-                    goto err_close;
-                }
-                peer->recv_msg->data = (char*)malloc(peer->recv_msg->hdr.nbytes);
-                memset(peer->recv_msg->data, 0, peer->recv_msg->hdr.nbytes);
-                /* point to it */
-                peer->recv_msg->rdptr = peer->recv_msg->data;
-                peer->recv_msg->rdbytes = peer->recv_msg->hdr.nbytes;
             }
             /* fall thru and attempt to read the data */
         } else if (PMIX_ERR_RESOURCE_BUSY == rc ||
                    PMIX_ERR_WOULD_BLOCK == rc) {
             /* exit this event and let the event lib progress */
+            PMIX_POST_OBJECT(peer);
             return;
         } else {
             /* the remote peer closed the connection - report that condition
@@ -589,29 +858,68 @@ void pmix_ptl_base_recv_handler(int sd, short flags, void *cbdata)
     return;
 
   err_close:
-    /* stop all events */
+    /* stop the recv side here - the recv event and any partial
+     * message belong to whichever thread this handler runs on */
     if (peer->recv_ev_active) {
         pmix_event_del(&peer->recv_event);
         peer->recv_ev_active = false;
     }
-    if (peer->send_ev_active) {
-        pmix_event_del(&peer->send_event);
-        peer->send_ev_active = false;
-    }
     if (NULL != peer->recv_msg) {
         PMIX_RELEASE(peer->recv_msg);
         peer->recv_msg = NULL;
     }
+    if (0 < pmix_ptl_globals.recv_threads) {
+        /* we may be running on one of the recv threads, and the send
+         * event and the rest of the cleanup are owned by the main
+         * progress thread - leave them to recv_lost */
+        q = PMIX_NEW(pmix_ptl_queue_t);
+        PMIX_RETAIN(peer);
+        q->peer = peer;
+        pmix_event_assign(&q->ev, pmix_globals.evbase, -1,
+                          EV_WRITE, recv_lost, q);
+        PMIX_POST_OBJECT(q);
+        pmix_event_active(&q->ev, EV_WRITE, 1);
+        return;
+    }
     pmix_ptl_base_lost_connection(peer, PMIX_ERR_UNREACH);
     /* ensure we post the modified peer object before another thread
      * picks it back up */
     PMIX_POST_OBJECT(peer);
 }
 
+/* Check whether a message can be added to the peer's send queue.
+ * Replies and other requested data are always queued - a peer that
+ * isn't reading only loses what it never asked for, i.e., event
+ * notifications and forwarded IO. Returns true if the message is to
+ * be dropped */
+bool pmix_ptl_base_queue_full(pmix_peer_t *peer, uint32_t tag, size_t nbytes)
+{
+    if (0 == pmix_ptl_globals.peer_queue_limit ||
+        peer->queued_bytes + nbytes <= pmix_ptl_globals.peer_queue_limit) {
+        return false;
+    }
+    if (PMIX_PTL_TAG_NOTIFY != tag &&
+        PMIX_PTL_TAG_IOF != tag &&
+        PMIX_PTL_TAG_IOF_BATCH != tag) {
+        return false;
+    }
+    if (0 == peer->msgs_dropped) {
+        pmix_output_verbose(1, pmix_ptl_base_framework.framework_output,
+                            "%s:%d send queue to %s:%u over its limit of %lu bytes - dropping notifications and IO",
+                            pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                            peer->info->pname.nspace, peer->info->pname.rank,
+                            (unsigned long)pmix_ptl_globals.peer_queue_limit);
+    }
+    peer->msgs_dropped++;
+    pmix_counter_add(PMIX_CTR_MSGS_DROPPED, nbytes);
+    return true;
+}
+
 void pmix_ptl_base_send(int sd, short args, void *cbdata)
 {
     pmix_ptl_queue_t *queue = (pmix_ptl_queue_t*)cbdata;
     pmix_ptl_send_t *snd;
+    uint32_t nbytes;
 
     /* acquire the object */
     PMIX_ACQUIRE_OBJECT(queue);
@@ -638,14 +946,31 @@ void pmix_ptl_base_send(int sd, short args, void *cbdata)
         return;
     }
 
+    if (pmix_ptl_base_queue_full(queue->peer, queue->tag, (queue->buf)->bytes_used)) {
+        PMIX_RELEASE(queue->buf);
+        PMIX_RELEASE(queue);
+        return;
+    }
+
     snd = PMIX_NEW(pmix_ptl_send_t);
     snd->hdr.pindex = htonl(pmix_globals.pindex);
     snd->hdr.tag = htonl(queue->tag);
-    snd->hdr.nbytes = htonl((queue->buf)->bytes_used);
-    snd->data = (queue->buf);
+    nbytes = (queue->buf)->bytes_used;
+    snd->hdr.nbytes = htonl(nbytes);
+    pmix_counter_add(PMIX_CTR_MSGS_SENT, nbytes);
+    (queue->peer)->msgs_sent++;
+    (queue->peer)->bytes_sent += nbytes;
+    if (0 == nbytes) {
+        /* e.g., a heartbeat - only the header goes on the wire, so
+         * don't hold the empty buffer until the send completes */
+        PMIX_RELEASE(queue->buf);
+    } else {
+        snd->data = (queue->buf);
+    }
     /* always start with the header */
     snd->sdptr = (char*)&snd->hdr;
     snd->sdbytes = sizeof(pmix_ptl_hdr_t);
+    PMIX_PTL_QUEUED(queue->peer, snd, nbytes);
 
     /* if there is no message on-deck, put this one there */
     if (NULL == (queue->peer)->send_msg) {
@@ -703,13 +1028,14 @@ void pmix_ptl_base_send_recv(int fd, short args, void *cbdata)
         req->tag = tag;
         req->cbfunc = ms->cbfunc;
         req->cbdata = ms->cbdata;
+        req->peer = (struct pmix_peer_t*)ms->peer;
 
         pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
                             "posting recv on tag %d", req->tag);
         /* add it to the list of recvs - we cannot have unexpected messages
          * in this subsystem as the server never sends us something that
          * we didn't previously request */
-        pmix_list_prepend(&pmix_ptl_globals.posted_recvs, &req->super);
+        pmix_ptl_base_post_dynamic_recv(req);
     }
 
     pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
@@ -719,10 +1045,14 @@ void pmix_ptl_base_send_recv(int fd, short args, void *cbdata)
     snd->hdr.pindex = htonl(pmix_globals.pindex);
     snd->hdr.tag = htonl(tag);
     snd->hdr.nbytes = htonl(ms->bfr->bytes_used);
+    pmix_counter_add(PMIX_CTR_MSGS_SENT, ms->bfr->bytes_used);
+    ms->peer->msgs_sent++;
+    ms->peer->bytes_sent += ms->bfr->bytes_used;
     snd->data = ms->bfr;
     /* always start with the header */
     snd->sdptr = (char*)&snd->hdr;
     snd->sdbytes = sizeof(pmix_ptl_hdr_t);
+    PMIX_PTL_QUEUED(ms->peer, snd, ms->bfr->bytes_used);
 
     /* if there is no message on-deck, put this one there */
     if (NULL == ms->peer->send_msg) {
@@ -742,11 +1072,58 @@ void pmix_ptl_base_send_recv(int fd, short args, void *cbdata)
     PMIX_POST_OBJECT(snd);
 }
 
+/* the reply to a send_recv is matched on its tag by a hash lookup
+ * rather than a scan of every posted recv */
+void pmix_ptl_base_post_dynamic_recv(pmix_ptl_posted_recv_t *req)
+{
+    pmix_list_prepend(&pmix_ptl_globals.posted_recvs, &req->super);
+    pmix_hash_table_set_value_uint32(&pmix_ptl_globals.dynrecvs, req->tag, req);
+}
+
+static void deliver_msg(pmix_ptl_recv_t *msg, pmix_ptl_posted_recv_t *rcv)
+{
+    pmix_buffer_t buf;
+
+    pmix_counter_add(PMIX_CTR_MSGS_RECVD, msg->hdr.nbytes);
+    msg->peer->msgs_recvd++;
+    msg->peer->bytes_recvd += msg->hdr.nbytes;
+
+    if (NULL != rcv->cbfunc) {
+        /* construct and load the buffer */
+        PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+        if (NULL != msg->data) {
+            PMIX_LOAD_BUFFER(msg->peer, &buf, msg->data, msg->hdr.nbytes);
+        } else {
+            /* we need to at least set the buffer type so
+             * unpack of a zero-byte message doesn't error */
+            buf.type = msg->peer->nptr->compat.type;
+        }
+        msg->data = NULL;  // protect the data region
+        pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
+                             "%s:%d EXECUTE CALLBACK for tag %u",
+                             pmix_globals.myid.nspace, pmix_globals.myid.rank,
+                             msg->hdr.tag);
+        PMIX_TRACE_START(start);
+        rcv->cbfunc(msg->peer, &msg->hdr, &buf, rcv->cbdata);
+        PMIX_TRACE_SPAN("ptl.recv", start);
+        pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
+                            "%s:%d CALLBACK COMPLETE",
+                            pmix_globals.myid.nspace, pmix_globals.myid.rank);
+        PMIX_DESTRUCT(&buf);  // free's the msg data
+    }
+    /* done with the recv if it is a dynamic tag */
+    if (PMIX_PTL_TAG_DYNAMIC <= rcv->tag && UINT_MAX != rcv->tag) {
+        pmix_hash_table_remove_value_uint32(&pmix_ptl_globals.dynrecvs, rcv->tag);
+        pmix_list_remove_item(&pmix_ptl_globals.posted_recvs, &rcv->super);
+        PMIX_RELEASE(rcv);
+    }
+    PMIX_RELEASE(msg);
+}
+
 void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
 {
     pmix_ptl_recv_t *msg = (pmix_ptl_recv_t*)cbdata;
     pmix_ptl_posted_recv_t *rcv;
-    pmix_buffer_t buf;
 
     /* acquire the object */
     PMIX_ACQUIRE_OBJECT(msg);
@@ -756,6 +1133,13 @@ void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
                         pmix_globals.myid.nspace, pmix_globals.myid.rank,
                         (int)msg->hdr.nbytes, msg->hdr.tag, msg->sd);
 
+    if (PMIX_PTL_TAG_DYNAMIC <= msg->hdr.tag &&
+        PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&pmix_ptl_globals.dynrecvs,
+                                                          msg->hdr.tag, (void**)&rcv)) {
+        deliver_msg(msg, rcv);
+        return;
+    }
+
     /* see if we have a waiting recv for this message */
     PMIX_LIST_FOREACH(rcv, &pmix_ptl_globals.posted_recvs, pmix_ptl_posted_recv_t) {
         pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
@@ -763,33 +1147,7 @@ void pmix_ptl_base_process_msg(int fd, short flags, void *cbdata)
                             msg->hdr.tag, rcv->tag);
 
         if (msg->hdr.tag == rcv->tag || UINT_MAX == rcv->tag) {
-            if (NULL != rcv->cbfunc) {
-                /* construct and load the buffer */
-                PMIX_CONSTRUCT(&buf, pmix_buffer_t);
-                if (NULL != msg->data) {
-                    PMIX_LOAD_BUFFER(msg->peer, &buf, msg->data, msg->hdr.nbytes);
-                } else {
-                    /* we need to at least set the buffer type so
-                     * unpack of a zero-byte message doesn't error */
-                    buf.type = msg->peer->nptr->compat.type;
-                }
-                msg->data = NULL;  // protect the data region
-                pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
-                                     "%s:%d EXECUTE CALLBACK for tag %u",
-                                     pmix_globals.myid.nspace, pmix_globals.myid.rank,
-                                     msg->hdr.tag);
-                rcv->cbfunc(msg->peer, &msg->hdr, &buf, rcv->cbdata);
-                pmix_output_verbose(5, pmix_ptl_base_framework.framework_output,
-                                    "%s:%d CALLBACK COMPLETE",
-                                    pmix_globals.myid.nspace, pmix_globals.myid.rank);
-                PMIX_DESTRUCT(&buf);  // free's the msg data
-            }
-            /* done with the recv if it is a dynamic tag */
-            if (PMIX_PTL_TAG_DYNAMIC <= rcv->tag && UINT_MAX != rcv->tag) {
-                pmix_list_remove_item(&pmix_ptl_globals.posted_recvs, &rcv->super);
-                PMIX_RELEASE(rcv);
-            }
-            PMIX_RELEASE(msg);
+            deliver_msg(msg, rcv);
             return;
         }
     }
@@ -184,6 +184,9 @@ static void cancel_recv(int fd, short args, void *cbdata)
 
     PMIX_LIST_FOREACH(rcv, &pmix_ptl_globals.posted_recvs, pmix_ptl_posted_recv_t) {
         if (rcv->tag == req->tag) {
+            if (PMIX_PTL_TAG_DYNAMIC <= rcv->tag && UINT_MAX != rcv->tag) {
+                pmix_hash_table_remove_value_uint32(&pmix_ptl_globals.dynrecvs, rcv->tag);
+            }
             pmix_list_remove_item(&pmix_ptl_globals.posted_recvs, &rcv->super);
             PMIX_RELEASE(rcv);
             PMIX_RELEASE(req);
@@ -100,6 +100,7 @@ typedef uint32_t pmix_ptl_tag_t;
 #define PMIX_PTL_TAG_NOTIFY           0
 #define PMIX_PTL_TAG_HEARTBEAT        1
 #define PMIX_PTL_TAG_IOF              2
+#define PMIX_PTL_TAG_IOF_BATCH        3
 
 /* define the start of dynamic tags that are
  * assigned for send/recv operations */
@@ -135,6 +136,7 @@ typedef struct {
     bool hdr_sent;
     char *sdptr;
     size_t sdbytes;
+    size_t qbytes;          // bytes counted in the peer's queued_bytes
 } pmix_ptl_send_t;
 PMIX_CLASS_DECLARATION(pmix_ptl_send_t);
 
@@ -159,6 +161,7 @@ typedef struct {
     uint32_t tag;
     pmix_ptl_cbfunc_t cbfunc;
     void *cbdata;
+    struct pmix_peer_t *peer;   // peer the reply is expected from, if known
 } pmix_ptl_posted_recv_t;
 PMIX_CLASS_DECLARATION(pmix_ptl_posted_recv_t);
 
@@ -254,6 +257,23 @@ PMIX_EXPORT extern int pmix_ptl_base_output;
         (c)->snd = (s);                                                 \
     } while (0)
 
+/* track the bytes sitting in a peer's send queue - a message is
+ * counted when it is queued and uncounted when it is released */
+#define PMIX_PTL_QUEUED(p, s, n)                                        \
+    do {                                                                \
+        (s)->qbytes = (n);                                              \
+        (p)->queued_bytes += (s)->qbytes;                               \
+        if ((p)->queued_hwm < (p)->queued_bytes) {                      \
+            (p)->queued_hwm = (p)->queued_bytes;                        \
+        }                                                               \
+    } while (0)
+
+#define PMIX_PTL_DEQUEUED(p, s)                                         \
+    do {                                                                \
+        (p)->queued_bytes -= (s)->qbytes;                               \
+        (s)->qbytes = 0;                                                \
+    } while (0)
+
 /* queue a message to be sent to one of our procs - must
  * provide the following params:
  * p - pmix_peer_t of target recipient
@@ -281,6 +301,7 @@ PMIX_EXPORT extern int pmix_ptl_base_output;
             /* always start with the header */                                              \
             snd->sdptr = (char*)&snd->hdr;                                                  \
             snd->sdbytes = sizeof(pmix_ptl_hdr_t);                                          \
+            PMIX_PTL_QUEUED((p), snd, nbytes);                                              \
             /* if there is no message on-deck, put this one there */                        \
             if (NULL == (p)->send_msg) {                                                    \
                 (p)->send_msg = snd;                                                        \
@@ -79,8 +79,9 @@ pmix_ptl_module_t pmix_ptl_tcp_module = {
     .connect_to_peer = connect_to_peer
 };
 
-static pmix_status_t recv_connect_ack(int sd, uint8_t myflag);
-static pmix_status_t send_connect_ack(int sd, uint8_t *myflag, pmix_info_t info[], size_t ninfo);
+static pmix_status_t recv_connect_ack(pmix_peer_t *server, int sd, uint8_t myflag);
+static pmix_status_t send_connect_ack(pmix_peer_t *server, int sd, uint8_t *myflag,
+                                      pmix_info_t info[], size_t ninfo);
 
 
 static pmix_status_t init(void)
@@ -107,12 +108,14 @@ static char *pmix_getline(FILE *fp)
     return NULL;
 }
 
-static pmix_status_t parse_uri_file(char *filename,
+static pmix_status_t parse_uri_file(pmix_peer_t *server,
+                                    char *filename,
                                     char **uri,
                                     char **nspace,
                                     pmix_rank_t *rank);
-static pmix_status_t try_connect(char *uri, int *sd, pmix_info_t info[], size_t ninfo);
-static pmix_status_t df_search(char *dirname, char *prefix,
+static pmix_status_t try_connect(pmix_peer_t *server, char *uri, int *sd,
+                                 pmix_info_t info[], size_t ninfo);
+static pmix_status_t df_search(pmix_peer_t *server, char *dirname, char *prefix,
                                pmix_info_t info[], size_t ninfo,
                                int *sd, char **nspace,
                                pmix_rank_t *rank, char **uri);
@@ -120,6 +123,7 @@ static pmix_status_t df_search(char *dirname, char *prefix,
 static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
                                      pmix_info_t *info, size_t ninfo)
 {
+    pmix_peer_t *server = (pmix_peer_t*)peer;
     char *evar, **uri, *suri = NULL, *suri2 = NULL;
     char *filename, *nspace=NULL;
     pmix_rank_t rank = PMIX_RANK_WILDCARD;
@@ -149,7 +153,7 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
     if (PMIX_PROC_IS_CLIENT(pmix_globals.mypeer)) {
         if (NULL != (evar = getenv("PMIX_SERVER_URI3"))) {
             /* we are talking to a v3 server */
-            pmix_client_globals.myserver->proc_type = PMIX_PROC_SERVER | PMIX_PROC_V3;
+            server->proc_type = PMIX_PROC_SERVER | PMIX_PROC_V3;
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "V3 SERVER DETECTED");
             /* must use the v3 bfrops module */
@@ -159,7 +163,7 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
             }
         } else if (NULL != (evar = getenv("PMIX_SERVER_URI21"))) {
             /* we are talking to a v2.1 server */
-            pmix_client_globals.myserver->proc_type = PMIX_PROC_SERVER | PMIX_PROC_V21;
+            server->proc_type = PMIX_PROC_SERVER | PMIX_PROC_V21;
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "V21 SERVER DETECTED");
             /* must use the v21 bfrops module */
@@ -169,7 +173,7 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
             }
         } else if (NULL != (evar = getenv("PMIX_SERVER_URI2"))) {
             /* we are talking to a v2.0 server */
-            pmix_client_globals.myserver->proc_type = PMIX_PROC_SERVER | PMIX_PROC_V20;
+            server->proc_type = PMIX_PROC_SERVER | PMIX_PROC_V20;
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "V20 SERVER DETECTED");
             /* must use the v20 bfrops module */
@@ -182,7 +186,7 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
             return PMIX_ERR_NOT_SUPPORTED;
         }
         /* the server will be using the same bfrops as us */
-        pmix_client_globals.myserver->nptr->compat.bfrops = pmix_globals.mypeer->nptr->compat.bfrops;
+        server->nptr->compat.bfrops = pmix_globals.mypeer->nptr->compat.bfrops;
         /* mark that we are using the V2 (i.e., tcp) protocol */
         pmix_globals.mypeer->protocol = PMIX_PROTOCOL_V2;
         /* save the URI for storage */
@@ -218,7 +222,7 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
                             "ptl:tcp:client attempt connect to %s", uri[1]);
 
         /* go ahead and try to connect */
-        if (PMIX_SUCCESS != (rc = try_connect(uri[1], &sd, info, ninfo))) {
+        if (PMIX_SUCCESS != (rc = try_connect(server, uri[1], &sd, info, ninfo))) {
             free(nspace);
             pmix_argv_free(uri);
             return rc;
@@ -334,7 +338,7 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "ptl:tcp:tool getting connection info from %s", suri);
             nspace = NULL;
-            rc = parse_uri_file(&suri[5], &suri2, &nspace, &rank);
+            rc = parse_uri_file(server, &suri[5], &suri2, &nspace, &rank);
             if (PMIX_SUCCESS != rc) {
                 free(suri);
                 if (NULL != rendfile) {
@@ -388,7 +392,7 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                             "ptl:tcp:tool attempt connect using given URI %s", suri);
         /* go ahead and try to connect */
-        if (PMIX_SUCCESS != (rc = try_connect(suri, &sd, iptr, niptr))) {
+        if (PMIX_SUCCESS != (rc = try_connect(server, suri, &sd, iptr, niptr))) {
             if (NULL != nspace) {
                 free(nspace);
             }
@@ -421,14 +425,14 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
     /* if they gave us a rendezvous file, use it */
     if (NULL != rendfile) {
         /* try to read the file */
-        rc = parse_uri_file(rendfile, &suri, &nspace, &rank);
+        rc = parse_uri_file(server, rendfile, &suri, &nspace, &rank);
         free(rendfile);
         rendfile = NULL;
         if (PMIX_SUCCESS == rc) {
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "ptl:tcp:tool attempt connect to system server at %s", suri);
             /* go ahead and try to connect */
-            if (PMIX_SUCCESS == try_connect(suri, &sd, iptr, niptr)) {
+            if (PMIX_SUCCESS == try_connect(server, suri, &sd, iptr, niptr)) {
                 /* don't free nspace - we will use it below */
                 if (NULL != rendfile) {
                     free(rendfile);
@@ -476,7 +480,7 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
                             "ptl:tcp:tool searching for given session server %s",
                             filename);
         nspace = NULL;
-        rc = df_search(mca_ptl_tcp_component.system_tmpdir,
+        rc = df_search(server, mca_ptl_tcp_component.system_tmpdir,
                        filename, iptr, niptr, &sd, &nspace, &rank, &suri);
         free(filename);
         if (PMIX_SUCCESS == rc) {
@@ -516,7 +520,7 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
                             "ptl:tcp:tool searching for given session server %s",
                             filename);
         nspace = NULL;
-        rc = df_search(mca_ptl_tcp_component.system_tmpdir,
+        rc = df_search(server, mca_ptl_tcp_component.system_tmpdir,
                        filename, iptr, niptr, &sd, &nspace, &rank, &suri);
         free(filename);
         if (PMIX_SUCCESS == rc) {
@@ -553,13 +557,13 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
                             "ptl:tcp:tool looking for system server at %s",
                             filename);
         /* try to read the file */
-        rc = parse_uri_file(filename, &suri, &nspace, &rank);
+        rc = parse_uri_file(server, filename, &suri, &nspace, &rank);
         free(filename);
         if (PMIX_SUCCESS == rc) {
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "ptl:tcp:tool attempt connect to system server at %s", suri);
             /* go ahead and try to connect */
-            if (PMIX_SUCCESS == try_connect(suri, &sd, iptr, niptr)) {
+            if (PMIX_SUCCESS == try_connect(server, suri, &sd, iptr, niptr)) {
                 /* don't free nspace - we will use it below */
                 if (NULL != iptr) {
                     PMIX_INFO_FREE(iptr, niptr);
@@ -608,7 +612,7 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
                         "ptl:tcp:tool searching for session server %s",
                         filename);
     nspace = NULL;
-    rc = df_search(mca_ptl_tcp_component.system_tmpdir,
+    rc = df_search(server, mca_ptl_tcp_component.system_tmpdir,
                    filename, iptr, niptr, &sd, &nspace, &rank, &suri);
     free(filename);
     if (PMIX_SUCCESS != rc) {
@@ -647,56 +651,61 @@ static pmix_status_t connect_to_peer(struct pmix_peer_t *peer,
         CLOSE_THE_SOCKET(sd);
         return PMIX_ERR_UNREACH;
     }
-    /* mark the connection as made */
-    pmix_globals.connected = true;
-    pmix_client_globals.myserver->sd = sd;
+    /* mark the connection as made - a tool's additional
+     * servers don't change the state of its primary one */
+    if (server == pmix_client_globals.myserver) {
+        pmix_globals.connected = true;
+    }
+    server->sd = sd;
 
     /* tools setup their server info in try_connect because they
      * utilize a broader handshake */
     if (PMIX_PROC_IS_CLIENT(pmix_globals.mypeer)) {
         /* setup the server info */
-        if (NULL == pmix_client_globals.myserver->info) {
-            pmix_client_globals.myserver->info = PMIX_NEW(pmix_rank_info_t);
+        if (NULL == server->info) {
+            server->info = PMIX_NEW(pmix_rank_info_t);
         }
-        if (NULL == pmix_client_globals.myserver->nptr) {
-            pmix_client_globals.myserver->nptr = PMIX_NEW(pmix_namespace_t);
+        if (NULL == server->nptr) {
+            server->nptr = PMIX_NEW(pmix_namespace_t);
         }
-        if (NULL != pmix_client_globals.myserver->nptr->nspace) {
-            free(pmix_client_globals.myserver->nptr->nspace);
+        if (NULL != server->nptr->nspace) {
+            free(server->nptr->nspace);
         }
-        pmix_client_globals.myserver->nptr->nspace = strdup(nspace);
+        server->nptr->nspace = strdup(nspace);
 
-        if (NULL != pmix_client_globals.myserver->info->pname.nspace) {
-            free(pmix_client_globals.myserver->info->pname.nspace);
+        if (NULL != server->info->pname.nspace) {
+            free(server->info->pname.nspace);
         }
-        pmix_client_globals.myserver->info->pname.nspace = strdup(pmix_client_globals.myserver->nptr->nspace);
-        pmix_client_globals.myserver->info->pname.rank = rank;
+        server->info->pname.nspace = strdup(server->nptr->nspace);
+        server->info->pname.rank = rank;
+    }
+    /* store the URI of our primary server for subsequent lookups */
+    if (server == pmix_client_globals.myserver) {
+        PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer,
+                          &pmix_globals.myid, PMIX_INTERNAL,
+                          urikv);
     }
-    /* store the URI for subsequent lookups */
-    PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer,
-                      &pmix_globals.myid, PMIX_INTERNAL,
-                      urikv);
     PMIX_RELEASE(urikv);  // maintain accounting
 
     pmix_ptl_base_set_nonblocking(sd);
 
     /* setup recv event */
-    pmix_event_assign(&pmix_client_globals.myserver->recv_event,
+    pmix_event_assign(&server->recv_event,
                       pmix_globals.evbase,
-                      pmix_client_globals.myserver->sd,
+                      server->sd,
                       EV_READ | EV_PERSIST,
-                      pmix_ptl_base_recv_handler, pmix_client_globals.myserver);
-    pmix_client_globals.myserver->recv_ev_active = true;
-    PMIX_POST_OBJECT(pmix_client_globals.myserver);
-    pmix_event_add(&pmix_client_globals.myserver->recv_event, 0);
+                      pmix_ptl_base_recv_handler, server);
+    server->recv_ev_active = true;
+    PMIX_POST_OBJECT(server);
+    pmix_event_add(&server->recv_event, 0);
 
     /* setup send event */
-    pmix_event_assign(&pmix_client_globals.myserver->send_event,
+    pmix_event_assign(&server->send_event,
                       pmix_globals.evbase,
-                      pmix_client_globals.myserver->sd,
+                      server->sd,
                       EV_WRITE|EV_PERSIST,
-                      pmix_ptl_base_send_handler, pmix_client_globals.myserver);
-    pmix_client_globals.myserver->send_ev_active = false;
+                      pmix_ptl_base_send_handler, server);
+    server->send_ev_active = false;
 
     free(nspace);
     if (NULL != suri) {
@@ -753,7 +762,8 @@ static void timeout(int sd, short args, void *cbdata)
 }
 
 /****    SUPPORTING FUNCTIONS    ****/
-static pmix_status_t parse_uri_file(char *filename,
+static pmix_status_t parse_uri_file(pmix_peer_t *server,
+                                    char *filename,
                                     char **uri,
                                     char **nspace,
                                     pmix_rank_t *rank)
@@ -813,8 +823,8 @@ static pmix_status_t parse_uri_file(char *filename,
     /* see if this file contains the server's version */
     p2 = pmix_getline(fp);
     if (NULL == p2) {
-        pmix_client_globals.myserver->proc_type = PMIX_PROC_SERVER | PMIX_PROC_V20;
-        pmix_client_globals.myserver->protocol = PMIX_PROTOCOL_V2;
+        server->proc_type = PMIX_PROC_SERVER | PMIX_PROC_V20;
+        server->protocol = PMIX_PROTOCOL_V2;
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                             "V20 SERVER DETECTED");
     } else {
@@ -825,13 +835,13 @@ static pmix_status_t parse_uri_file(char *filename,
             major = strtoul(p2, NULL, 10);
         }
         if (2 == major) {
-            pmix_client_globals.myserver->proc_type = PMIX_PROC_SERVER | PMIX_PROC_V21;
-            pmix_client_globals.myserver->protocol = PMIX_PROTOCOL_V2;
+            server->proc_type = PMIX_PROC_SERVER | PMIX_PROC_V21;
+            server->protocol = PMIX_PROTOCOL_V2;
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "V21 SERVER DETECTED");
         } else if (3 <= major) {
-            pmix_client_globals.myserver->proc_type = PMIX_PROC_SERVER | PMIX_PROC_V3;
-            pmix_client_globals.myserver->protocol = PMIX_PROTOCOL_V2;
+            server->proc_type = PMIX_PROC_SERVER | PMIX_PROC_V3;
+            server->protocol = PMIX_PROTOCOL_V2;
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "V3 SERVER DETECTED");
         }
@@ -868,7 +878,8 @@ static pmix_status_t parse_uri_file(char *filename,
     return PMIX_SUCCESS;
 }
 
-static pmix_status_t try_connect(char *uri, int *sd, pmix_info_t iptr[], size_t niptr)
+static pmix_status_t try_connect(pmix_peer_t *server, char *uri, int *sd,
+                                 pmix_info_t iptr[], size_t niptr)
 {
     char *p, *p2, *host;
     struct sockaddr_in *in;
@@ -882,7 +893,7 @@ static pmix_status_t try_connect(char *uri, int *sd, pmix_info_t iptr[], size_t
                         "pmix:tcp try connect to %s", uri);
 
     /* mark that we are the active module for this server */
-    pmix_client_globals.myserver->nptr->compat.ptl = &pmix_ptl_tcp_module;
+    server->nptr->compat.ptl = &pmix_ptl_tcp_module;
 
     /* setup the path to the daemon rendezvous point */
     memset(&mca_ptl_tcp_component.connection, 0, sizeof(struct sockaddr_storage));
@@ -960,14 +971,14 @@ static pmix_status_t try_connect(char *uri, int *sd, pmix_info_t iptr[], size_t
     }
 
     /* send our identity and any authentication credentials to the server */
-    if (PMIX_SUCCESS != (rc = send_connect_ack(*sd, &myflag, iptr, niptr))) {
+    if (PMIX_SUCCESS != (rc = send_connect_ack(server, *sd, &myflag, iptr, niptr))) {
         PMIX_ERROR_LOG(rc);
         CLOSE_THE_SOCKET(*sd);
         return rc;
     }
 
     /* do whatever handshake is required */
-    if (PMIX_SUCCESS != (rc = recv_connect_ack(*sd, myflag))) {
+    if (PMIX_SUCCESS != (rc = recv_connect_ack(server, *sd, myflag))) {
         CLOSE_THE_SOCKET(*sd);
         if (PMIX_ERR_TEMP_UNAVAILABLE == rc) {
             ++retries;
@@ -980,7 +991,7 @@ static pmix_status_t try_connect(char *uri, int *sd, pmix_info_t iptr[], size_t
 
     return PMIX_SUCCESS;
 }
-static pmix_status_t send_connect_ack(int sd, uint8_t *myflag,
+static pmix_status_t send_connect_ack(pmix_peer_t *server, int sd, uint8_t *myflag,
                                       pmix_info_t iptr[], size_t niptr)
 {
     char *msg;
@@ -1099,7 +1110,7 @@ static pmix_status_t send_connect_ack(int sd, uint8_t *myflag,
     bftype = pmix_globals.mypeer->nptr->compat.type;
 
     /* add our active gds module for working with the server */
-    gds = (char*)pmix_client_globals.myserver->nptr->compat.gds->name;
+    gds = (char*)server->nptr->compat.gds->name;
 
     /* if we were given info structs to pass to the server, pack them */
     PMIX_CONSTRUCT(&buf, pmix_buffer_t);
@@ -1227,7 +1238,7 @@ static pmix_status_t send_connect_ack(int sd, uint8_t *myflag,
 /* we receive a connection acknowledgement from the server,
  * consisting of nothing more than a status report. If success,
  * then we initiate authentication method */
-static pmix_status_t recv_connect_ack(int sd, uint8_t myflag)
+static pmix_status_t recv_connect_ack(pmix_peer_t *server, int sd, uint8_t myflag)
 {
     pmix_status_t reply;
     pmix_status_t rc;
@@ -1275,13 +1286,25 @@ static pmix_status_t recv_connect_ack(int sd, uint8_t myflag)
     if (0 == myflag) {
         /* see if they want us to do the handshake */
         if (PMIX_ERR_READY_FOR_HANDSHAKE == reply) {
-            PMIX_PSEC_CLIENT_HANDSHAKE(rc, pmix_client_globals.myserver, sd);
+            PMIX_PSEC_CLIENT_HANDSHAKE(rc, server, sd);
             if (PMIX_SUCCESS != rc) {
                 return rc;
             }
         } else if (PMIX_SUCCESS != reply) {
             return reply;
         }
+        /* once the credential has been accepted the server confirms
+         * the connection before sending our index - every server
+         * sends this word, so we must take it off the socket or it
+         * will be read as the start of the first message */
+        rc = pmix_ptl_base_recv_blocking(sd, (char*)&u32, sizeof(uint32_t));
+        if (PMIX_SUCCESS != rc) {
+            return rc;
+        }
+        reply = ntohl(u32);
+        if (PMIX_SUCCESS != reply) {
+            return reply;
+        }
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                             "pmix: RECV CONNECT CONFIRMATION");
 
@@ -1314,36 +1337,36 @@ static pmix_status_t recv_connect_ack(int sd, uint8_t myflag)
         }
 
         /* get the server's nspace and rank so we can send to it */
-        if (NULL == pmix_client_globals.myserver->info) {
-            pmix_client_globals.myserver->info = PMIX_NEW(pmix_rank_info_t);
+        if (NULL == server->info) {
+            server->info = PMIX_NEW(pmix_rank_info_t);
         }
-        if (NULL == pmix_client_globals.myserver->nptr) {
-            pmix_client_globals.myserver->nptr = PMIX_NEW(pmix_namespace_t);
+        if (NULL == server->nptr) {
+            server->nptr = PMIX_NEW(pmix_namespace_t);
         }
         pmix_ptl_base_recv_blocking(sd, (char*)nspace, PMIX_MAX_NSLEN+1);
-        if (NULL != pmix_client_globals.myserver->nptr->nspace) {
-            free(pmix_client_globals.myserver->nptr->nspace);
+        if (NULL != server->nptr->nspace) {
+            free(server->nptr->nspace);
         }
-        pmix_client_globals.myserver->nptr->nspace = strdup(nspace);
-        if (NULL != pmix_client_globals.myserver->info->pname.nspace) {
-            free(pmix_client_globals.myserver->info->pname.nspace);
+        server->nptr->nspace = strdup(nspace);
+        if (NULL != server->info->pname.nspace) {
+            free(server->info->pname.nspace);
         }
-        pmix_client_globals.myserver->info->pname.nspace = strdup(nspace);
+        server->info->pname.nspace = strdup(nspace);
         pmix_ptl_base_recv_blocking(sd, (char*)&u32, sizeof(uint32_t));
-        pmix_client_globals.myserver->info->pname.rank = htonl(u32);
+        server->info->pname.rank = htonl(u32);
 
         pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                             "pmix: RECV CONNECT CONFIRMATION FOR TOOL %s:%d FROM SERVER %s:%d",
                             pmix_globals.myid.nspace, pmix_globals.myid.rank,
-                            pmix_client_globals.myserver->info->pname.nspace,
-                            pmix_client_globals.myserver->info->pname.rank);
+                            server->info->pname.nspace,
+                            server->info->pname.rank);
 
         /* get the returned status from the security handshake */
         pmix_ptl_base_recv_blocking(sd, (char*)&reply, sizeof(pmix_status_t));
         if (PMIX_SUCCESS != reply) {
             /* see if they want us to do the handshake */
             if (PMIX_ERR_READY_FOR_HANDSHAKE == reply) {
-                PMIX_PSEC_CLIENT_HANDSHAKE(reply, pmix_client_globals.myserver, sd);
+                PMIX_PSEC_CLIENT_HANDSHAKE(reply, server, sd);
                 if (PMIX_SUCCESS != reply) {
                     return reply;
                 }
@@ -1363,7 +1386,7 @@ static pmix_status_t recv_connect_ack(int sd, uint8_t myflag)
     return PMIX_SUCCESS;
 }
 
-static pmix_status_t df_search(char *dirname, char *prefix,
+static pmix_status_t df_search(pmix_peer_t *server, char *dirname, char *prefix,
                                pmix_info_t info[], size_t ninfo,
                                int *sd, char **nspace,
                                pmix_rank_t *rank, char **uri)
@@ -1396,7 +1419,7 @@ static pmix_status_t df_search(char *dirname, char *prefix,
         }
         /* if it is a directory, down search */
         if (S_ISDIR(buf.st_mode)) {
-            rc = df_search(newdir, prefix, info, ninfo, sd, nspace, rank, uri);
+            rc = df_search(server, newdir, prefix, info, ninfo, sd, nspace, rank, uri);
             free(newdir);
             if (PMIX_SUCCESS == rc) {
                 closedir(cur_dirp);
@@ -1411,12 +1434,12 @@ static pmix_status_t df_search(char *dirname, char *prefix,
             /* try to read this file */
             pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                 "pmix:tcp: reading file %s", newdir);
-            rc = parse_uri_file(newdir, &suri, &nsp, &rk);
+            rc = parse_uri_file(server, newdir, &suri, &nsp, &rk);
             if (PMIX_SUCCESS == rc) {
                 /* go ahead and try to connect */
                 pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                     "pmix:tcp: attempting to connect to %s", suri);
-                if (PMIX_SUCCESS == try_connect(suri, sd, info, ninfo)) {
+                if (PMIX_SUCCESS == try_connect(server, suri, sd, info, ninfo)) {
                     (*nspace) = nsp;
                     *rank = rk;
                     closedir(cur_dirp);
@@ -55,8 +55,10 @@
 
 #include "src/include/pmix_socket_errno.h"
 #include "src/util/argv.h"
+#include "src/util/counters.h"
 #include "src/util/error.h"
 #include "src/util/fd.h"
+#include "src/util/getid.h"
 #include "src/util/net.h"
 #include "src/util/os_path.h"
 #include "src/util/parse_options.h"
@@ -940,6 +942,92 @@ static char **split_and_resolve(char **orig_str, char *name)
     return argv;
 }
 
+/* finish accepting a client once its credential has been checked */
+static void client_validated(pmix_status_t rc, pmix_peer_t *peer, void *cbdata)
+{
+    pmix_pending_connection_t *pnd = (pmix_pending_connection_t*)cbdata;
+    pmix_rank_info_t *info = peer->info;
+    pmix_proc_t proc;
+    uint32_t u32;
+
+    peer->finalized = false;
+    if (PMIX_SUCCESS != rc) {
+        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                            "validation of client connection failed");
+        info->proc_cnt--;
+        pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
+        PMIX_RELEASE(peer);
+        /* send an error reply to the client */
+        goto error;
+    }
+
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "client connection validated");
+
+    /* tell the client all is good */
+    u32 = htonl(PMIX_SUCCESS);
+    if (PMIX_SUCCESS != (rc = pmix_ptl_base_send_blocking(pnd->sd, (char*)&u32, sizeof(uint32_t)))) {
+        PMIX_ERROR_LOG(rc);
+        info->proc_cnt--;
+        pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
+        PMIX_RELEASE(peer);
+        CLOSE_THE_SOCKET(pnd->sd);
+        PMIX_RELEASE(pnd);
+        return;
+    }
+    /* send the client's array index */
+    u32 = htonl(peer->index);
+    if (PMIX_SUCCESS != (rc = pmix_ptl_base_send_blocking(pnd->sd, (char*)&u32, sizeof(uint32_t)))) {
+        PMIX_ERROR_LOG(rc);
+        info->proc_cnt--;
+        pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
+        PMIX_RELEASE(peer);
+        goto error;
+    }
+
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "connect-ack from client completed");
+
+    /* let the host server know that this client has connected */
+    if (NULL != pmix_host_server.client_connected) {
+        pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
+        proc.rank = peer->info->pname.rank;
+        rc = pmix_host_server.client_connected(&proc, peer->info->server_object,
+                                               NULL, NULL);
+        if (PMIX_SUCCESS != rc && PMIX_OPERATION_SUCCEEDED != rc) {
+            PMIX_ERROR_LOG(rc);
+            info->proc_cnt--;
+            pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
+            PMIX_RELEASE(peer);
+            goto error;
+        }
+    }
+
+    pmix_ptl_base_set_nonblocking(pnd->sd);
+
+    /* start the events for this client */
+    pmix_event_assign(&peer->recv_event, pmix_ptl_base_recv_evbase(), pnd->sd,
+                      EV_READ|EV_PERSIST, pmix_ptl_base_recv_handler, peer);
+    pmix_event_add(&peer->recv_event, NULL);
+    peer->recv_ev_active = true;
+    pmix_event_assign(&peer->send_event, pmix_globals.evbase, pnd->sd,
+                      EV_WRITE|EV_PERSIST, pmix_ptl_base_send_handler, peer);
+    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
+                        "pmix:server client %s:%u has connected on socket %d",
+                        peer->info->pname.nspace, peer->info->pname.rank, peer->sd);
+    PMIX_RELEASE(pnd);
+    return;
+
+  error:
+    /* send an error reply to the client */
+    u32 = htonl(rc);
+    if (PMIX_SUCCESS != (rc = pmix_ptl_base_send_blocking(pnd->sd, (char*)&u32, sizeof(int)))) {
+        PMIX_ERROR_LOG(rc);
+        CLOSE_THE_SOCKET(pnd->sd);
+    }
+    PMIX_RELEASE(pnd);
+}
+
 static void connection_handler(int sd, short args, void *cbdata)
 {
     pmix_pending_connection_t *pnd = (pmix_pending_connection_t*)cbdata;
@@ -950,10 +1038,10 @@ static void connection_handler(int sd, short args, void *cbdata)
     char *msg, *mg, *version;
     char *sec, *bfrops, *gds;
     pmix_bfrop_buffer_type_t bftype;
-    char *nspace;
+    char *nspace = NULL;
     uint32_t len, u32;
     size_t cnt, msglen, n;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     bool found;
     pmix_rank_info_t *info;
     pmix_proc_t proc;
@@ -1333,12 +1421,7 @@ static void connection_handler(int sd, short args, void *cbdata)
              * of local clients. So let's start by searching for
              * the nspace object */
             nptr = NULL;
-            PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
-                if (0 == strcmp(tmp->nspace, nspace)) {
-                    nptr = tmp;
-                    break;
-                }
-            }
+            nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, nspace);
             if (NULL == nptr) {
                 /* we don't know this namespace, reject it */
                 free(msg);
@@ -1347,14 +1430,8 @@ static void connection_handler(int sd, short args, void *cbdata)
                 goto error;
             }
             /* now look for the rank */
-            info = NULL;
-            found = false;
-            PMIX_LIST_FOREACH(info, &nptr->ranks, pmix_rank_info_t) {
-                if (info->pname.rank == rank) {
-                    found = true;
-                    break;
-                }
-            }
+            info = pmix_nspace_find_rank(nptr, rank);
+            found = (NULL != info);
             if (!found) {
                 /* rank unknown, reject it */
                 free(msg);
@@ -1471,12 +1548,7 @@ static void connection_handler(int sd, short args, void *cbdata)
 
     /* see if we know this nspace */
     nptr = NULL;
-    PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(tmp->nspace, nspace)) {
-            nptr = tmp;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, nspace);
     if (NULL == nptr) {
         /* we don't know this namespace, reject it */
         free(msg);
@@ -1486,14 +1558,8 @@ static void connection_handler(int sd, short args, void *cbdata)
     }
 
     /* see if we have this peer in our list */
-    info = NULL;
-    found = false;
-    PMIX_LIST_FOREACH(info, &nptr->ranks, pmix_rank_info_t) {
-        if (info->pname.rank == rank) {
-            found = true;
-            break;
-        }
-    }
+    info = pmix_nspace_find_rank(nptr, rank);
+    found = (NULL != info);
     if (!found) {
         /* rank unknown, reject it */
         free(msg);
@@ -1539,7 +1605,11 @@ static void connection_handler(int sd, short args, void *cbdata)
         PMIX_RELEASE(pnd);
         return;
     }
+    pmix_counter_add(PMIX_CTR_CONNECTIONS, 1);
     info->peerid = peer->index;
+    /* only visible if they came in over the loopback */
+    (void)pmix_util_getpid(pnd->sd, &info->pid);
+    pmix_server_ptable_update(nptr, info);
 
     /* set the sec module to match this peer */
     peer->nptr->compat.psec = pmix_psec_base_assign_module(sec);
@@ -1596,75 +1666,12 @@ static void connection_handler(int sd, short args, void *cbdata)
     /* the choice of PTL module is obviously us */
     peer->nptr->compat.ptl = &pmix_ptl_tcp_module;
 
-    /* validate the connection */
+    /* validate the connection - the peer can't be sent to
+     * until we know who it is */
     cred.bytes = pnd->cred;
     cred.size = pnd->len;
-    PMIX_PSEC_VALIDATE_CONNECTION(rc, peer, NULL, 0, NULL, NULL, &cred);
-    if (PMIX_SUCCESS != rc) {
-        pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                            "validation of client connection failed");
-        info->proc_cnt--;
-        pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
-        PMIX_RELEASE(peer);
-        /* send an error reply to the client */
-        goto error;
-    }
-
-    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                        "client connection validated");
-
-    /* tell the client all is good */
-    u32 = htonl(PMIX_SUCCESS);
-    if (PMIX_SUCCESS != (rc = pmix_ptl_base_send_blocking(pnd->sd, (char*)&u32, sizeof(uint32_t)))) {
-        PMIX_ERROR_LOG(rc);
-        info->proc_cnt--;
-        pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
-        PMIX_RELEASE(peer);
-        CLOSE_THE_SOCKET(pnd->sd);
-        PMIX_RELEASE(pnd);
-        return;
-    }
-      /* send the client's array index */
-    u32 = htonl(peer->index);
-      if (PMIX_SUCCESS != (rc = pmix_ptl_base_send_blocking(pnd->sd, (char*)&u32, sizeof(uint32_t)))) {
-          PMIX_ERROR_LOG(rc);
-          info->proc_cnt--;
-          pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
-          PMIX_RELEASE(peer);
-          goto error;
-      }
-
-      pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                          "connect-ack from client completed");
-
-      /* let the host server know that this client has connected */
-      if (NULL != pmix_host_server.client_connected) {
-          pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
-          proc.rank = peer->info->pname.rank;
-          rc = pmix_host_server.client_connected(&proc, peer->info->server_object,
-                                                 NULL, NULL);
-          if (PMIX_SUCCESS != rc && PMIX_OPERATION_SUCCEEDED != rc) {
-              PMIX_ERROR_LOG(rc);
-              info->proc_cnt--;
-              pmix_pointer_array_set_item(&pmix_server_globals.clients, peer->index, NULL);
-              PMIX_RELEASE(peer);
-              goto error;
-          }
-      }
-
-    pmix_ptl_base_set_nonblocking(pnd->sd);
-
-    /* start the events for this client */
-    pmix_event_assign(&peer->recv_event, pmix_globals.evbase, pnd->sd,
-                      EV_READ|EV_PERSIST, pmix_ptl_base_recv_handler, peer);
-    pmix_event_add(&peer->recv_event, NULL);
-    peer->recv_ev_active = true;
-    pmix_event_assign(&peer->send_event, pmix_globals.evbase, pnd->sd,
-                      EV_WRITE|EV_PERSIST, pmix_ptl_base_send_handler, peer);
-    pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
-                        "pmix:server client %s:%u has connected on socket %d",
-                        peer->info->pname.nspace, peer->info->pname.rank, peer->sd);
-    PMIX_RELEASE(pnd);
+    peer->finalized = true;
+    pmix_ptl_base_validate_connection(peer, &cred, client_validated, pnd);
     return;
 
   error:
@@ -1768,13 +1775,13 @@ static void process_cbfunc(int sd, short args, void *cbdata)
     if (5 != pnd->flag && 8 != pnd->flag) {
         PMIX_RETAIN(nptr);
         nptr->nspace = strdup(cd->proc.nspace);
-        pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+        pmix_nspace_add(&pmix_server_globals.nspaces, nptr);
         info = PMIX_NEW(pmix_rank_info_t);
         info->pname.nspace = strdup(nptr->nspace);
         info->pname.rank = cd->proc.rank;
         info->uid = pnd->uid;
         info->gid = pnd->gid;
-        pmix_list_append(&nptr->ranks, &info->super);
+        pmix_nspace_add_rank(nptr, info);
         PMIX_RETAIN(info);
         peer->info = info;
     }
@@ -1869,10 +1876,11 @@ static void process_cbfunc(int sd, short args, void *cbdata)
         /* probably cannot send an error reply if we are out of memory */
         return;
     }
+    pmix_counter_add(PMIX_CTR_CONNECTIONS, 1);
     info->peerid = peer->index;
 
     /* start the events for this tool */
-    pmix_event_assign(&peer->recv_event, pmix_globals.evbase, peer->sd,
+    pmix_event_assign(&peer->recv_event, pmix_ptl_base_recv_evbase(), peer->sd,
                       EV_READ|EV_PERSIST, pmix_ptl_base_recv_handler, peer);
     pmix_event_add(&peer->recv_event, NULL);
     peer->recv_ev_active = true;
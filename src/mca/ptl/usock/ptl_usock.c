@@ -584,6 +584,7 @@ void pmix_usock_send_handler(int sd, short flags, void *cbdata)
                 /* setup to send the data */
                 if (NULL == msg->data) {
                     /* this was a zero-byte msg - nothing more to do */
+                    PMIX_PTL_DEQUEUED(peer, msg);
                     PMIX_RELEASE(msg);
                     peer->send_msg = NULL;
                     goto next;
@@ -613,6 +614,7 @@ void pmix_usock_send_handler(int sd, short flags, void *cbdata)
                 // report the error
                 event_del(&peer->send_event);
                 peer->send_ev_active = false;
+                PMIX_PTL_DEQUEUED(peer, msg);
                 PMIX_RELEASE(msg);
                 peer->send_msg = NULL;
                 pmix_ptl_base_lost_connection(peer, rc);
@@ -630,6 +632,7 @@ void pmix_usock_send_handler(int sd, short flags, void *cbdata)
                 // message is complete
                 pmix_output_verbose(2, pmix_ptl_base_framework.framework_output,
                                     "usock:send_handler BODY SENT");
+                PMIX_PTL_DEQUEUED(peer, msg);
                 PMIX_RELEASE(msg);
                 peer->send_msg = NULL;
             } else if (PMIX_ERR_RESOURCE_BUSY == rc ||
@@ -647,6 +650,7 @@ void pmix_usock_send_handler(int sd, short flags, void *cbdata)
                             peer->sd);
                 pmix_event_del(&peer->send_event);
                 peer->send_ev_active = false;
+                PMIX_PTL_DEQUEUED(peer, msg);
                 PMIX_RELEASE(msg);
                 peer->send_msg = NULL;
                 pmix_ptl_base_lost_connection(peer, rc);
@@ -863,7 +867,7 @@ void pmix_usock_send_recv(int fd, short args, void *cbdata)
         /* add it to the list of recvs - we cannot have unexpected messages
          * in this subsystem as the server never sends us something that
          * we didn't previously request */
-        pmix_list_prepend(&pmix_ptl_globals.posted_recvs, &req->super);
+        pmix_ptl_base_post_dynamic_recv(req);
     }
 
     snd = PMIX_NEW(pmix_ptl_send_t);
@@ -874,6 +878,7 @@ void pmix_usock_send_recv(int fd, short args, void *cbdata)
     /* always start with the header */
     snd->sdptr = (char*)&snd->hdr;
     snd->sdbytes = sizeof(pmix_usock_hdr_t);
+    PMIX_PTL_QUEUED(ms->peer, snd, ms->bfr->bytes_used);
 
     /* if there is no message on-deck, put this one there */
     if (NULL == ms->peer->send_msg) {
@@ -917,6 +922,12 @@ static void pmix_usock_send(int sd, short args, void *cbdata)
                         (queue->peer)->info->pname.nspace,
                         (queue->peer)->info->pname.rank, (queue->tag));
 
+    if (pmix_ptl_base_queue_full(queue->peer, queue->tag, (queue->buf)->bytes_used)) {
+        PMIX_RELEASE(queue->buf);
+        PMIX_RELEASE(queue);
+        return;
+    }
+
     snd = PMIX_NEW(pmix_ptl_send_t);
     snd->hdr.pindex = htonl(pmix_globals.pindex);
     snd->hdr.tag = htonl(queue->tag);
@@ -925,6 +936,7 @@ static void pmix_usock_send(int sd, short args, void *cbdata)
     /* always start with the header */
     snd->sdptr = (char*)&snd->hdr;
     snd->sdbytes = sizeof(pmix_ptl_hdr_t);
+    PMIX_PTL_QUEUED(queue->peer, snd, (queue->buf)->bytes_used);
 
     /* if there is no message on-deck, put this one there */
     if (NULL == (queue->peer)->send_msg) {
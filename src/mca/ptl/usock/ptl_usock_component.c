@@ -56,8 +56,10 @@
 #include <errno.h>
 
 #include "src/util/argv.h"
+#include "src/util/counters.h"
 #include "src/util/error.h"
 #include "src/util/fd.h"
+#include "src/util/getid.h"
 #include "src/util/show_help.h"
 #include "src/util/strnlen.h"
 #include "src/mca/bfrops/base/base.h"
@@ -342,7 +344,7 @@ static void connection_handler(int sd, short args, void *cbdata)
     pmix_status_t rc;
     unsigned int rank;
     pmix_usock_hdr_t hdr;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     pmix_rank_info_t *info;
     pmix_peer_t *psave = NULL;
     bool found;
@@ -546,12 +548,7 @@ static void connection_handler(int sd, short args, void *cbdata)
 
     /* see if we know this nspace */
     nptr = NULL;
-    PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(tmp->nspace, nspace)) {
-            nptr = tmp;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, nspace);
     if (NULL == nptr) {
         /* we don't know this namespace, reject it */
         free(msg);
@@ -561,14 +558,8 @@ static void connection_handler(int sd, short args, void *cbdata)
     }
 
     /* see if we have this peer in our list */
-    info = NULL;
-    found = false;
-    PMIX_LIST_FOREACH(info, &nptr->ranks, pmix_rank_info_t) {
-        if (info->pname.rank == rank) {
-            found = true;
-            break;
-        }
-    }
+    info = pmix_nspace_find_rank(nptr, rank);
+    found = (NULL != info);
     if (!found) {
         /* rank unknown, reject it */
         free(msg);
@@ -628,7 +619,10 @@ static void connection_handler(int sd, short args, void *cbdata)
         PMIX_RELEASE(pnd);
         return;
     }
+    pmix_counter_add(PMIX_CTR_CONNECTIONS, 1);
     info->peerid = psave->index;
+    (void)pmix_util_getpid(pnd->sd, &info->pid);
+    pmix_server_ptable_update(nptr, info);
 
     /* get the appropriate compatibility modules */
     nptr->compat.psec = pmix_psec_base_assign_module(sec);
@@ -736,7 +730,10 @@ static void connection_handler(int sd, short args, void *cbdata)
         }
     }
 
-    /* start the events for this client */
+    /* start the events for this client - unlike tcp, the recv event
+     * stays on the main progress thread: pmix_usock_recv_handler tears
+     * the whole connection down in place when the peer goes away, and
+     * only the legacy v1 clients that use this transport reach it */
     pmix_event_assign(&psave->recv_event, pmix_globals.evbase, pnd->sd,
                       EV_READ|EV_PERSIST, pmix_usock_recv_handler, psave);
     pmix_event_add(&psave->recv_event, NULL);
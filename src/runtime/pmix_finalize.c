@@ -28,9 +28,12 @@
 
 #include "src/class/pmix_object.h"
 #include "src/client/pmix_client_ops.h"
+#include "src/util/compress.h"
 #include "src/util/output.h"
 #include "src/util/keyval_parse.h"
+#include "src/util/nsid.h"
 #include "src/util/show_help.h"
+#include "src/util/timings.h"
 #include "src/mca/base/base.h"
 #include "src/mca/base/pmix_mca_base_var.h"
 #include "src/mca/bfrops/base/base.h"
@@ -115,11 +118,21 @@ void pmix_rte_finalize(void)
         }
     }
     PMIX_DESTRUCT(&pmix_globals.notifications);
+    pmix_notify_cache_clear();
+    pmix_util_uncompress_cache_finalize();
+    PMIX_DESTRUCT(&pmix_globals.notify_index);
     PMIX_LIST_DESTRUCT(&pmix_globals.iof_requests);
 
     /* now safe to release the event base */
+    pmix_threadshift_finalize();
+    pmix_timer_finalize();
     if (!pmix_globals.external_evbase) {
         (void)pmix_progress_thread_stop(NULL);
     }
+    /* nothing can be holding an nspace ID now */
+    pmix_nsid_finalize();
 
+#if PMIX_ENABLE_TIMING
+    pmix_trace_flush();
+#endif
 }
@@ -56,9 +56,11 @@
 #include "src/include/types.h"
 #include "src/util/error.h"
 #include "src/util/keyval_parse.h"
+#include "src/util/timings.h"
 
 #include "src/runtime/pmix_rte.h"
 #include "src/runtime/pmix_progress_threads.h"
+#include "src/threads/mutex.h"
 
 const char pmix_version_string[] = PMIX_IDENT_STRING;
 
@@ -80,11 +82,36 @@ PMIX_EXPORT pmix_globals_t pmix_globals = {
 };
 
 
+/* protects the deferred opening of frameworks */
+static pmix_mutex_t deferred_lock = PMIX_MUTEX_STATIC_INIT;
+
+pmix_status_t pmix_rte_open_framework(pmix_mca_base_framework_t *framework,
+                                      pmix_status_t (*selectfn)(void))
+{
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    /* the framework is marked open before its plugins have been
+     * selected, so the check has to be made under the lock */
+    pmix_mutex_lock(&deferred_lock);
+    if (!pmix_mca_base_framework_is_open(framework)) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                            "pmix:rte opening deferred framework %s",
+                            framework->framework_name);
+        rc = pmix_mca_base_framework_open(framework, 0);
+        if (PMIX_SUCCESS == rc && NULL != selectfn) {
+            rc = selectfn();
+        }
+    }
+    pmix_mutex_unlock(&deferred_lock);
+    return rc;
+}
+
 static void _notification_eviction_cbfunc(struct pmix_hotel_t *hotel,
                                           int room_num,
                                           void *occupant)
 {
     pmix_notify_caddy_t *cache = (pmix_notify_caddy_t*)occupant;
+    pmix_notify_cache_unindex(cache);
     PMIX_RELEASE(cache);
 }
 
@@ -148,6 +175,9 @@ int pmix_rte_init(pmix_proc_type_t type,
         error = "pmix_register_params";
         goto return_error;
     }
+#if PMIX_ENABLE_TIMING
+    pmix_trace_init(pmix_trace_output);
+#endif
 
     /* initialize the mca */
     if (PMIX_SUCCESS != (ret = pmix_mca_base_open())) {
@@ -164,13 +194,19 @@ int pmix_rte_init(pmix_proc_type_t type,
     PMIX_CONSTRUCT(&pmix_globals.cached_events, pmix_list_t);
     /* construct the global notification ring buffer */
     PMIX_CONSTRUCT(&pmix_globals.notifications, pmix_hotel_t);
-    ret = pmix_hotel_init(&pmix_globals.notifications, pmix_globals.max_events,
-                          pmix_globals.evbase, pmix_globals.event_eviction_time,
-                          _notification_eviction_cbfunc);
+    /* the cache times are in seconds, the hotel's in microseconds */
+    ret = pmix_hotel_init_bucketed(&pmix_globals.notifications, pmix_globals.max_events,
+                                   pmix_globals.evbase,
+                                   (uint32_t)pmix_globals.event_eviction_time * 1000000,
+                                   (0 < pmix_globals.event_eviction_granularity) ?
+                                       (uint32_t)pmix_globals.event_eviction_granularity * 1000000 : 0,
+                                   _notification_eviction_cbfunc);
     if (PMIX_SUCCESS != ret) {
         error = "notification hotel init";
         goto return_error;
     }
+    PMIX_CONSTRUCT(&pmix_globals.notify_index, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_globals.notify_index, 64);
 
     /* and setup the iof request tracking list */
     PMIX_CONSTRUCT(&pmix_globals.iof_requests, pmix_list_t);
@@ -305,10 +341,15 @@ int pmix_rte_init(pmix_proc_type_t type,
         goto return_error;
     }
 
-    /* initialize pif framework */
-    if (PMIX_SUCCESS != (ret = pmix_mca_base_framework_open(&pmix_pif_base_framework, 0))) {
-        error = "pmix_pif_base_open";
-        return ret;
+    /* a simple client neither listens for connections nor writes
+     * log output itself, so it leaves pif and plog closed until
+     * something actually asks for them - see pmix_rte_open_framework */
+    if (PMIX_PROC_CLIENT != type) {
+        /* initialize pif framework */
+        if (PMIX_SUCCESS != (ret = pmix_mca_base_framework_open(&pmix_pif_base_framework, 0))) {
+            error = "pmix_pif_base_open";
+            return ret;
+        }
     }
 
     /* open the preg and select the active plugins */
@@ -322,13 +363,15 @@ int pmix_rte_init(pmix_proc_type_t type,
     }
 
     /* open the plog and select the active plugins */
-    if (PMIX_SUCCESS != (ret = pmix_mca_base_framework_open(&pmix_plog_base_framework, 0)) ) {
-        error = "pmix_plog_base_open";
-        goto return_error;
-    }
-    if (PMIX_SUCCESS != (ret = pmix_plog_base_select()) ) {
-        error = "pmix_plog_base_select";
-        goto return_error;
+    if (PMIX_PROC_CLIENT != type) {
+        if (PMIX_SUCCESS != (ret = pmix_mca_base_framework_open(&pmix_plog_base_framework, 0)) ) {
+            error = "pmix_plog_base_open";
+            goto return_error;
+        }
+        if (PMIX_SUCCESS != (ret = pmix_plog_base_select()) ) {
+            error = "pmix_plog_base_select";
+            goto return_error;
+        }
     }
 
     /* if an external event base wasn't provide, create one */
@@ -343,6 +386,7 @@ int pmix_rte_init(pmix_proc_type_t type,
             goto return_error;
         }
     }
+    pmix_threadshift_init();
 
     return PMIX_SUCCESS;
 
@@ -41,12 +41,15 @@
 #if PMIX_ENABLE_TIMING
 char *pmix_timing_output = NULL;
 bool pmix_timing_overhead = true;
+char *pmix_trace_output = NULL;
 #endif
 
 static bool pmix_register_done = false;
 char *pmix_net_private_ipv4 = NULL;
 int pmix_event_caching_window = 1;
 bool pmix_suppress_missing_data_warning = false;
+bool pmix_progress_busy_poll = false;
+char *pmix_progress_bind = NULL;
 
 pmix_status_t pmix_register_params(void)
 {
@@ -74,6 +77,14 @@ pmix_status_t pmix_register_params(void)
                                   PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
                                   PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
                                   &pmix_timing_overhead);
+
+    pmix_trace_output = NULL;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", NULL, "trace_output",
+                                  "Record a trace of library activity and write it at finalize as Chrome trace "
+                                  "JSON to <value>.<pid>.json (default: no tracing)",
+                                  PMIX_MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                  PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                  &pmix_trace_output);
 #endif
 
     /* RFC1918 defines
@@ -108,6 +119,31 @@ pmix_status_t pmix_register_params(void)
                                        PMIX_INFO_LVL_1, PMIX_MCA_BASE_VAR_SCOPE_ALL,
                                        &pmix_suppress_missing_data_warning);
 
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "progress", "busy_poll",
+                                       "Have progress threads poll their event base without ever "
+                                       "sleeping - lowers the latency of every response at the cost "
+                                       "of dedicating a core to each progress thread",
+                                       PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                       PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_progress_busy_poll);
+
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "progress", "bind",
+                                       "Bind progress threads so they stay off the cores of busy "
+                                       "application processes: \"service\" (the last core of the "
+                                       "node), \"numa:N\" (the cores of NUMA domain N - e.g., the "
+                                       "one holding the local clients), or a list of cpus such as "
+                                       "\"0,2-3\" (requires hwloc support - default: no binding)",
+                                       PMIX_MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                       PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_progress_bind);
+
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "thread", "spin_limit",
+                                       "Number of times a thread waiting on a blocking operation polls "
+                                       "for completion before sleeping (0 = sleep immediately)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_9, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_thread_spin_limit);
+
     /****   CLIENT: VERBOSE OUTPUT PARAMS   ****/
     (void) pmix_mca_base_var_register ("pmix", "pmix", "client", "get_verbose",
                                        "Verbosity for client get operations",
@@ -164,6 +200,76 @@ pmix_status_t pmix_register_params(void)
                                        PMIX_INFO_LVL_1, PMIX_MCA_BASE_VAR_SCOPE_ALL,
                                        &pmix_server_globals.get_verbose);
 
+    pmix_server_globals.get_prefetch = 0;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "get_prefetch",
+                                       "Number of neighbouring ranks on either side whose data is also requested when a direct modex request is sent to the host (default: 0 - disabled)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.get_prefetch);
+
+    pmix_server_globals.get_prefetch_timeout = 30;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "get_prefetch_timeout",
+                                       "Time (in sec) a prefetched direct modex request is tracked when the get that triggered it gave no timeout - the host is given the same timeout (default: 30)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.get_prefetch_timeout);
+
+    pmix_server_globals.event_aggregation = 0;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "event_aggregation",
+                                       "Time (in msec) during which events of the same code from the host are coalesced into a single notification carrying all affected procs (default: 0 - disabled)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.event_aggregation);
+
+    pmix_server_globals.event_ring_slots = 0;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "event_ring_slots",
+                                       "Number of slots in a node-local shared-memory ring into which events for local clients are written once instead of being sent to each of them - clients that fall this far behind lose events (default: 0 - disabled)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.event_ring_slots);
+
+    pmix_server_globals.event_ring_slot_size = 4096;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "event_ring_slot_size",
+                                       "Bytes of packed event a slot of the event ring holds - larger events are sent over the socket (default: 4096)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.event_ring_slot_size);
+
+    pmix_server_globals.event_ring_readers = 1024;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "event_ring_readers",
+                                       "Number of local clients that can read the event ring at one time - any beyond that are sent events over the socket (default: 1024)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.event_ring_readers);
+
+    pmix_server_globals.query_cache_ttl = 0;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "query_cache_ttl",
+                                       "Time (in msec) the host's answer to a query about nspaces, proc tables, queues, allocations, psets or spawn/debug support is reused for identical queries - PMIX_QUERY_REFRESH_CACHE bypasses it (default: 0 - disabled)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.query_cache_ttl);
+
+    pmix_server_globals.watchdog = 0;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "watchdog",
+                                       "Time (in msec) a get, fence, connect, or query may be outstanding at the server before it is recorded as slow (default: 0 - disabled)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.watchdog);
+
+    pmix_server_globals.watchdog_records = 64;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "watchdog_records",
+                                       "Number of slow-request records the server keeps - the oldest are dropped beyond this (default: 64)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.watchdog_records);
+
+    pmix_server_globals.watchdog_signal = 0;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "watchdog_signal",
+                                       "Signal on which the server prints its slow-request records (default: 0 - none)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.watchdog_signal);
+
     (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "connect_verbose",
                                        "Verbosity for server connect operations",
                                        PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
@@ -176,6 +282,34 @@ pmix_status_t pmix_register_params(void)
                                        PMIX_INFO_LVL_1, PMIX_MCA_BASE_VAR_SCOPE_ALL,
                                        &pmix_server_globals.fence_verbose);
 
+    pmix_server_globals.fence_compress = 0;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "fence_compress",
+                                       "Compress the data collected by a fence when it exceeds this many bytes before passing it to the host (default: 0 - disabled). All servers participating in the job must run a PMIx version that understands compressed buckets",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.fence_compress);
+
+    pmix_server_globals.pubsub = false;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "pubsub",
+                                       "Hold data published with PMIX_RANGE_LOCAL or PMIX_RANGE_NAMESPACE in the server so lookups from local procs are answered without the host (default: false)",
+                                       PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.pubsub);
+
+    pmix_server_globals.job_ctrl_local = false;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "job_ctrl_local",
+                                       "Deliver job-control signals and kills aimed at this server's own clients directly, passing only the remaining targets to the host (default: false)",
+                                       PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.job_ctrl_local);
+
+    pmix_server_globals.lookup_recheck = 1000;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "lookup_recheck",
+                                       "Time (in msec) between asking the host again for lookups waiting on keys that have not been published through this server (default: 1000, 0 - only retry on a local publish)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.lookup_recheck);
+
     (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "pub_verbose",
                                        "Verbosity for server publish, lookup, and unpublish operations",
                                        PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
@@ -188,6 +322,55 @@ pmix_status_t pmix_register_params(void)
                                        PMIX_INFO_LVL_1, PMIX_MCA_BASE_VAR_SCOPE_ALL,
                                        &pmix_server_globals.spawn_verbose);
 
+    pmix_server_globals.spawn_batch_msec = 0;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "spawn_batch_msec",
+                                       "Time (in msec) to hold a spawn request so that others from the same requestor with identical directives can be passed to the host as a single multi-app spawn (default: 0 - disabled)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.spawn_batch_msec);
+
+    pmix_server_globals.spawn_batch_apps = 64;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "spawn_batch_apps",
+                                       "Number of apps that fill a spawn batch and cause it to be passed to the host at once (default: 64)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.spawn_batch_apps);
+
+    pmix_server_globals.ds12_shm_lock = false;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "ds12_shm_lock",
+                                       "When ds12 is built with fcntl locking, also guard its data with a process-shared rwlock in shared memory so clients that find it can read without a syscall - clients that only know the lock file keep using it (default: false)",
+                                       PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.ds12_shm_lock);
+
+    pmix_server_globals.gds_small_job = 0;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "gds_small_job",
+                                       "Nspaces with at most this many procs (PMIX_JOB_SIZE, else the number of local procs) only offer the hash gds to their clients, so no shared memory is set up for them (default: 0 - disabled)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.gds_small_job);
+
+    pmix_server_globals.gds_large_job = 0;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "gds_large_job",
+                                       "Nspaces with at least this many procs offer the gds modules in pmix_server_gds_large_modules to their clients (default: 0 - disabled)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.gds_large_job);
+
+    pmix_server_globals.gds_large_modules = NULL;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "gds_large_modules",
+                                       "Comma-delimited list, in order of preference, of gds modules for nspaces of at least pmix_server_gds_large_job procs - those not available are ignored (default: none)",
+                                       PMIX_MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.gds_large_modules);
+
+    pmix_server_globals.collective_algo = NULL;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "collective_algo",
+                                       "Comma-delimited list of algorithms (e.g., a tree among the servers) passed to the host as PMIX_COLLECTIVE_ALGO with fence, connect and disconnect requests that do not specify one (default: none)",
+                                       PMIX_MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                       PMIX_INFO_LVL_4, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_server_globals.collective_algo);
+
     (void) pmix_mca_base_var_register ("pmix", "pmix", "server", "event_verbose",
                                        "Verbosity for server event operations",
                                        PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
@@ -215,6 +398,68 @@ pmix_status_t pmix_register_params(void)
                                       PMIX_MCA_BASE_VAR_SCOPE_READONLY,
                                       &pmix_globals.output_limit);
 
+    /* check for maximum amount of output to hold for requestors */
+    pmix_server_globals.iof_cache_size = 1024 * 1024;
+    (void) pmix_mca_base_var_register("pmix", "iof", NULL, "cache_size",
+                                      "Maximum bytes of output a server holds until someone registers to receive it - the oldest output is dropped beyond this [default: 1MB]",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                      PMIX_INFO_LVL_9,
+                                      PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                      &pmix_server_globals.iof_cache_size);
+
+    /* check for batching of output sent to requestors */
+    pmix_server_globals.iof_batch_msec = 0;
+    (void) pmix_mca_base_var_register("pmix", "iof", NULL, "batch_msec",
+                                      "Msec to hold output for requestors that accept it in batches, merging runs from the same source - requestors may also ask for this with PMIX_IOF_BUFFERING_SIZE/TIME [default: 0 - only when asked]",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                      PMIX_INFO_LVL_9,
+                                      PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                      &pmix_server_globals.iof_batch_msec);
+
+    pmix_server_globals.iof_batch_size = 64 * 1024;
+    (void) pmix_mca_base_var_register("pmix", "iof", NULL, "batch_size",
+                                      "Bytes of output that fill a batch and cause it to be sent at once [default: 64KB]",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                      PMIX_INFO_LVL_9,
+                                      PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                      &pmix_server_globals.iof_batch_size);
+
+    pmix_server_globals.iof_compress = 0;
+    (void) pmix_mca_base_var_register("pmix", "iof", NULL, "batch_compress",
+                                      "Compress batches of output larger than this many bytes [default: 0 - disabled]",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                      PMIX_INFO_LVL_9,
+                                      PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                      &pmix_server_globals.iof_compress);
+
+    /* check for how a tool forwards its stdin */
+    pmix_client_globals.iof_stdin_chunk = 64 * 1024;
+    (void) pmix_mca_base_var_register("pmix", "iof", NULL, "stdin_chunk",
+                                      "Maximum bytes of stdin a tool reads and forwards in a single push [default: 64KB]",
+                                      PMIX_MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                      PMIX_INFO_LVL_9,
+                                      PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                      &pmix_client_globals.iof_stdin_chunk);
+    if (0 == pmix_client_globals.iof_stdin_chunk) {
+        pmix_client_globals.iof_stdin_chunk = PMIX_IOF_BASE_MSG_MAX;
+    }
+
+    pmix_client_globals.iof_stdin_window = 8;
+    (void) pmix_mca_base_var_register("pmix", "iof", NULL, "stdin_window",
+                                      "Number of stdin pushes a tool may have awaiting acknowledgement from its server before it stops reading stdin [default: 8, 0 - unlimited]",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                      PMIX_INFO_LVL_9,
+                                      PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                      &pmix_client_globals.iof_stdin_window);
+
+    pmix_client_globals.iof_stdin_bcast = false;
+    (void) pmix_mca_base_var_register("pmix", "iof", NULL, "stdin_bcast",
+                                      "Ask the host to deliver a tool's stdin once to each node hosting a target rather than once to each target (default: false)",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                      PMIX_INFO_LVL_9,
+                                      PMIX_MCA_BASE_VAR_SCOPE_READONLY,
+                                      &pmix_client_globals.iof_stdin_bcast);
+
     pmix_globals.xml_output = false;
     (void) pmix_mca_base_var_register ("pmix", "iof", NULL, "xml_output",
                                        "Display all output in XML format (default: false)",
@@ -258,6 +503,16 @@ pmix_status_t pmix_register_params(void)
                                        PMIX_INFO_LVL_1, PMIX_MCA_BASE_VAR_SCOPE_ALL,
                                        &pmix_globals.event_eviction_time);
 
+    /* how finely to time that */
+    pmix_globals.event_eviction_granularity = 1;
+    (void) pmix_mca_base_var_register ("pmix", "pmix", "event", "eviction_granularity",
+                                       "Seconds between sweeps for expired cached events - an event "
+                                       "may be kept this much longer than the eviction time. Zero "
+                                       "times each event separately (default: 1)",
+                                       PMIX_MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                       PMIX_INFO_LVL_5, PMIX_MCA_BASE_VAR_SCOPE_ALL,
+                                       &pmix_globals.event_eviction_granularity);
+
     return PMIX_SUCCESS;
 }
 
@@ -16,15 +16,20 @@
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
+#include <errno.h>
+#include <stdlib.h>
 #include <string.h>
 #include <pthread.h>
 #include PMIX_EVENT_HEADER
 
 #include "src/class/pmix_list.h"
+#include "src/hwloc/hwloc-internal.h"
 #include "src/threads/threads.h"
 #include "src/util/error.h"
 #include "src/util/fd.h"
+#include "src/util/output.h"
 
+#include "src/runtime/pmix_rte.h"
 #include "src/runtime/pmix_progress_threads.h"
 
 
@@ -41,6 +46,13 @@ typedef struct {
        thread to exit */
     volatile bool ev_active;
 
+    /* poll the ev_base without blocking instead of sleeping
+       in it between events */
+    bool busy_poll;
+
+    /* where to bind the thread (pmix_progress_bind), or NULL */
+    const char *bind;
+
     /* This event will always be set on the ev_base (so that the
        ev_base is not empty!) */
     pmix_event_t block;
@@ -55,6 +67,8 @@ static void tracker_constructor(pmix_progress_tracker_t *p)
     p->name = NULL;
     p->ev_base = NULL;
     p->ev_active = false;
+    p->busy_poll = false;
+    p->bind = NULL;
     p->engine_constructed = false;
 }
 
@@ -97,6 +111,65 @@ static void dummy_timeout_cb(int fd, short args, void *cbdata)
     pmix_event_add(&trk->block, &long_timeout);
 }
 
+/*
+ * Bind the calling progress thread as given by its spec. We load
+ * our own topology for this rather than use the global one - the
+ * progress thread starts before a server has loaded (or been given)
+ * that, and this only costs anything when binding was requested
+ */
+static void bind_progress_thread(pmix_progress_tracker_t *trk)
+{
+#if PMIX_HAVE_HWLOC
+    hwloc_topology_t topo;
+    hwloc_bitmap_t set = NULL;
+    hwloc_obj_t obj;
+    int n;
+
+    if (0 != hwloc_topology_init(&topo)) {
+        return;
+    }
+    if (0 != hwloc_topology_load(topo)) {
+        hwloc_topology_destroy(topo);
+        return;
+    }
+
+    if (0 == strcmp(trk->bind, "service")) {
+        /* the last core is the one an RM filling cores in order
+         * reaches last, and the usual choice for system services */
+        n = hwloc_get_nbobjs_by_type(topo, HWLOC_OBJ_CORE);
+        if (0 < n && NULL != (obj = hwloc_get_obj_by_type(topo, HWLOC_OBJ_CORE, n-1))) {
+            set = hwloc_bitmap_dup(obj->cpuset);
+        }
+    } else if (0 == strncmp(trk->bind, "numa:", 5)) {
+        n = strtol(&trk->bind[5], NULL, 10);
+        if (NULL != (obj = hwloc_get_obj_by_type(topo, HWLOC_OBJ_NUMANODE, n))) {
+            set = hwloc_bitmap_dup(obj->cpuset);
+        }
+    } else {
+        set = hwloc_bitmap_alloc();
+        if (NULL != set && 0 != hwloc_bitmap_list_sscanf(set, trk->bind)) {
+            hwloc_bitmap_free(set);
+            set = NULL;
+        }
+    }
+
+    if (NULL == set || hwloc_bitmap_iszero(set)) {
+        pmix_output(0, "PMIX: progress thread \"%s\" cannot be bound to \"%s\" - "
+                    "no such cpus on this node", trk->name, trk->bind);
+    } else if (0 != hwloc_set_cpubind(topo, set, HWLOC_CPUBIND_THREAD)) {
+        pmix_output(0, "PMIX: binding progress thread \"%s\" to \"%s\" failed: %s",
+                    trk->name, trk->bind, strerror(errno));
+    }
+    if (NULL != set) {
+        hwloc_bitmap_free(set);
+    }
+    hwloc_topology_destroy(topo);
+#else
+    pmix_output(0, "PMIX: progress thread \"%s\" left unbound - binding "
+                "requires hwloc support", trk->name);
+#endif
+}
+
 /*
  * Main for the progress thread
  */
@@ -105,6 +178,18 @@ static void* progress_engine(pmix_object_t *obj)
     pmix_thread_t *t = (pmix_thread_t*)obj;
     pmix_progress_tracker_t *trk = (pmix_progress_tracker_t*)t->t_arg;
 
+    if (NULL != trk->bind) {
+        bind_progress_thread(trk);
+    }
+
+    if (trk->busy_poll) {
+        while (trk->ev_active) {
+            pmix_event_loop(trk->ev_base, PMIX_EVLOOP_NONBLOCK);
+            PMIX_THREAD_PAUSE();
+        }
+        return PMIX_THREAD_CANCELLED;
+    }
+
     while (trk->ev_active) {
         pmix_event_loop(trk->ev_base, PMIX_EVLOOP_ONCE);
     }
@@ -184,6 +269,11 @@ pmix_event_base_t *pmix_progress_thread_init(const char *name)
         return NULL;
     }
 
+    trk->busy_poll = pmix_progress_busy_poll;
+    if (NULL != pmix_progress_bind && '\0' != pmix_progress_bind[0]) {
+        trk->bind = pmix_progress_bind;
+    }
+
     /* add an event to the new event base (if there are no events,
        pmix_event_loop() will return immediately) */
     pmix_event_assign(&trk->block, trk->ev_base, -1, PMIX_EV_PERSIST,
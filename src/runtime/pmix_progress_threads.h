@@ -32,7 +32,7 @@
  * already-running progress thread will be returned (i.e., no new
  * progress thread will be started).
  */
-pmix_event_base_t *pmix_progress_thread_init(const char *name);
+PMIX_EXPORT pmix_event_base_t *pmix_progress_thread_init(const char *name);
 
 /**
  * Stop a progress thread name (reference counted).
@@ -45,7 +45,7 @@ pmix_event_base_t *pmix_progress_thread_init(const char *name);
  * Will return PMIX_ERR_NOT_FOUND if the progress thread name does not
  * exist; PMIX_SUCCESS otherwise.
  */
-int pmix_progress_thread_stop(const char *name);
+PMIX_EXPORT int pmix_progress_thread_stop(const char *name);
 
 /**
  * Finalize a progress thread name (reference counted).
@@ -34,6 +34,7 @@
 #include PMIX_EVENT_HEADER
 
 #include "src/include/pmix_globals.h"
+#include "src/mca/base/pmix_mca_base_framework.h"
 #include "src/mca/ptl/ptl_types.h"
 
 BEGIN_C_DECLS
@@ -42,12 +43,15 @@ BEGIN_C_DECLS
 extern char *pmix_timing_sync_file;
 extern char *pmix_timing_output;
 extern bool pmix_timing_overhead;
+extern char *pmix_trace_output;
 #endif
 
 extern int pmix_initialized;
 extern char *pmix_net_private_ipv4;
 extern int pmix_event_caching_window;
 extern bool pmix_suppress_missing_data_warning;
+extern bool pmix_progress_busy_poll;
+extern char *pmix_progress_bind;
 
 /** version string of pmix */
 extern const char pmix_version_string[];
@@ -69,6 +73,15 @@ PMIX_EXPORT pmix_status_t pmix_rte_init(pmix_proc_type_t type,
  */
 PMIX_EXPORT void pmix_rte_finalize(void);
 
+/**
+ * Open a framework that pmix_rte_init left closed, selecting its
+ * plugins with the given function (if not NULL). Safe to call from
+ * any thread and any number of times - only the first call does
+ * any work.
+ */
+PMIX_EXPORT pmix_status_t pmix_rte_open_framework(pmix_mca_base_framework_t *framework,
+                                                  pmix_status_t (*selectfn)(void));
+
 /**
  * Internal function.  Do not call.
  */
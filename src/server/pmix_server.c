@@ -53,6 +53,8 @@
 #include PMIX_EVENT2_THREAD_HEADER
 
 #include "src/util/argv.h"
+#include "src/util/compress.h"
+#include "src/util/counters.h"
 #include "src/util/error.h"
 #include "src/util/name_fns.h"
 #include "src/util/output.h"
@@ -70,6 +72,7 @@
 #include "src/mca/psensor/base/base.h"
 #include "src/mca/ptl/base/base.h"
 #include "src/hwloc/hwloc-internal.h"
+#include "src/event/pmix_event_ring.h"
 
 /* the server also needs access to client operations
  * as it can, and often does, behave as a client */
@@ -86,38 +89,35 @@ static char *bfrops_mode = NULL;
 static char *gds_mode = NULL;
 static pid_t mypid;
 
-// local functions for connection support
-static void iof_eviction_cbfunc(struct pmix_hotel_t *hotel,
-                                int room_num,
-                                void *occupant)
-{
-    pmix_setup_caddy_t *cache = (pmix_setup_caddy_t*)occupant;
-    PMIX_RELEASE(cache);
-}
 
 pmix_status_t pmix_server_initialize(void)
 {
-    pmix_status_t rc;
-
     /* setup the server-specific globals */
     PMIX_CONSTRUCT(&pmix_server_globals.clients, pmix_pointer_array_t);
     pmix_pointer_array_init(&pmix_server_globals.clients, 1, INT_MAX, 1);
     PMIX_CONSTRUCT(&pmix_server_globals.collectives, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.trkidx, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.trkidx, 256);
+    pmix_server_globals.nunindexed = 0;
     PMIX_CONSTRUCT(&pmix_server_globals.remote_pnd, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.gdata, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.events, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.evidx, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.evidx, 64);
     PMIX_CONSTRUCT(&pmix_server_globals.local_reqs, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.dmdxidx, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.dmdxidx, 256);
+    PMIX_CONSTRUCT(&pmix_server_globals.dmdxns, pmix_hash_table_t);
+    pmix_hash_table_init(&pmix_server_globals.dmdxns, 32);
     PMIX_CONSTRUCT(&pmix_server_globals.nspaces, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_server_globals.groups, pmix_list_t);
-    PMIX_CONSTRUCT(&pmix_server_globals.iof, pmix_hotel_t);
-    rc = pmix_hotel_init(&pmix_server_globals.iof, PMIX_IOF_HOTEL_SIZE,
-                         pmix_globals.evbase, PMIX_IOF_MAX_STAY,
-                         iof_eviction_cbfunc);
-    if (PMIX_SUCCESS != rc) {
-       PMIX_ERROR_LOG(rc);
-       PMIX_RELEASE_THREAD(&pmix_global_lock);
-       return rc;
-    }
+    PMIX_CONSTRUCT(&pmix_server_globals.grp_cache, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.aggregates, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.iof, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.iof_batches, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.spawn_batches, pmix_list_t);
+    pmix_server_globals.iof_size = 0;
+    pmix_server_globals.iof_seq = 0;
 
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "pmix:server init called");
@@ -173,6 +173,9 @@ pmix_status_t pmix_server_initialize(void)
                                   pmix_server_globals.base_verbose);
     }
 
+    pmix_server_watchdog_start();
+    pmix_server_pubsub_init();
+
     return PMIX_SUCCESS;
 }
 
@@ -377,6 +380,7 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module,
         pmix_list_prepend(&pmix_server_globals.nspaces, &pmix_globals.mypeer->nptr->super);
     }
     pmix_globals.mypeer->nptr->nspace = strdup(pmix_globals.myid.nspace);
+    (void)pmix_nspace_id(pmix_globals.mypeer->nptr);
     rinfo->pname.nspace = strdup(pmix_globals.mypeer->nptr->nspace);
     rinfo->pname.rank = pmix_globals.myid.rank;
     rinfo->uid = pmix_globals.uid;
@@ -410,6 +414,12 @@ PMIX_EXPORT pmix_status_t PMIx_server_init(pmix_server_module_t *module,
         return rc;
     }
 
+    /* setup the event ring, if requested - clients that cannot
+     * use it are still sent their events, so this isn't fatal */
+    if (PMIX_SUCCESS != (rc = pmix_event_ring_create())) {
+        PMIX_ERROR_LOG(rc);
+    }
+
     /* setup the wildcard recv for inbound messages from clients */
     req = PMIX_NEW(pmix_ptl_posted_recv_t);
     req->tag = UINT32_MAX;
@@ -445,7 +455,6 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
     int i;
     pmix_peer_t *peer;
     pmix_namespace_t *ns;
-    pmix_setup_caddy_t *cd;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
     if (pmix_globals.init_cntr <= 0) {
@@ -472,15 +481,13 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
     }
 
     pmix_ptl_base_stop_listening();
+    pmix_server_watchdog_stop();
+    pmix_server_pubsub_finalize();
+    pmix_server_query_cache_flush();
+    pmix_event_ring_destroy();
 
     /* cleanout any IOF */
-    for (i=0; i < PMIX_IOF_HOTEL_SIZE; i++) {
-        pmix_hotel_checkout_and_return_occupant(&pmix_server_globals.iof, i, (void**)&cd);
-        if (NULL != cd) {
-            PMIX_RELEASE(cd);
-        }
-    }
-    PMIX_DESTRUCT(&pmix_server_globals.iof);
+    pmix_server_iof_purge();
     for (i=0; i < pmix_server_globals.clients.size; i++) {
         if (NULL != (peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, i))) {
             /* ensure that we do the specified cleanup - if this is an
@@ -492,10 +499,14 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
     }
     PMIX_DESTRUCT(&pmix_server_globals.clients);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.collectives);
+    PMIX_DESTRUCT(&pmix_server_globals.trkidx);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.remote_pnd);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.local_reqs);
+    PMIX_DESTRUCT(&pmix_server_globals.dmdxidx);
+    PMIX_DESTRUCT(&pmix_server_globals.dmdxns);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.gdata);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.events);
+    PMIX_DESTRUCT(&pmix_server_globals.evidx);
     PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
         /* ensure that we do the specified cleanup - if this is an
          * abnormal termination, then the nspace object may not be
@@ -504,6 +515,9 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
     }
     PMIX_LIST_DESTRUCT(&pmix_server_globals.nspaces);
     PMIX_LIST_DESTRUCT(&pmix_server_globals.groups);
+    PMIX_LIST_DESTRUCT(&pmix_server_globals.grp_cache);
+    PMIX_LIST_DESTRUCT(&pmix_server_globals.aggregates);
+    PMIX_LIST_DESTRUCT(&pmix_server_globals.spawn_batches);
 
     pmix_hwloc_cleanup();
 
@@ -548,12 +562,184 @@ PMIX_EXPORT pmix_status_t PMIx_server_finalize(void)
     return PMIX_SUCCESS;
 }
 
+/* build the ANL-format process mapping legacy PMI clients ask for
+ * from the proc map - runs of ranks on consecutive nodes collapse
+ * into (start node, #nodes, ranks/node) blocks, and a vector that
+ * repeats is only given once as the clients cycle through it */
+static char* _anl_map(pmix_info_t info[], size_t ninfo)
+{
+    char **procs = NULL, **ranks, *map = NULL, *tmp;
+    int *node = NULL, *blk = NULL;
+    int nranks = 0, nblk = 0, nnodes, n, m, r, run, p;
+    size_t i;
+
+    for (i=0; i < ninfo; i++) {
+        if (PMIX_CHECK_KEY(&info[i], PMIX_ANL_MAP)) {
+            /* the host already gave us one */
+            return NULL;
+        }
+        if (PMIX_CHECK_KEY(&info[i], PMIX_PROC_MAP) &&
+            PMIX_STRING == info[i].value.type && NULL == procs) {
+            if (PMIX_SUCCESS != pmix_preg.parse_procs(info[i].value.data.string, &procs)) {
+                return NULL;
+            }
+        }
+    }
+    if (NULL == procs || 0 == (nnodes = pmix_argv_count(procs))) {
+        goto cleanup;
+    }
+    for (n=0; n < nnodes; n++) {
+        ranks = pmix_argv_split(procs[n], ',');
+        nranks += pmix_argv_count(ranks);
+        pmix_argv_free(ranks);
+    }
+    if (0 == nranks ||
+        NULL == (node = (int*)malloc(nranks * sizeof(int))) ||
+        NULL == (blk = (int*)malloc(3 * nranks * sizeof(int)))) {
+        goto cleanup;
+    }
+    for (r=0; r < nranks; r++) {
+        node[r] = -1;
+    }
+    for (n=0; n < nnodes; n++) {
+        ranks = pmix_argv_split(procs[n], ',');
+        for (m=0; NULL != ranks && NULL != ranks[m]; m++) {
+            r = strtol(ranks[m], NULL, 10);
+            if (0 <= r && r < nranks) {
+                node[r] = n;
+            }
+        }
+        pmix_argv_free(ranks);
+    }
+
+    for (r=0; r < nranks; r += run) {
+        if (0 > node[r]) {
+            /* the ranks aren't 0..N-1 */
+            goto cleanup;
+        }
+        for (run=1; r+run < nranks && node[r+run] == node[r]; run++);
+        if (0 < nblk && blk[3*(nblk-1)+2] == run &&
+            blk[3*(nblk-1)] + blk[3*(nblk-1)+1] == node[r]) {
+            ++blk[3*(nblk-1)+1];
+        } else {
+            blk[3*nblk] = node[r];
+            blk[3*nblk+1] = 1;
+            blk[3*nblk+2] = run;
+            ++nblk;
+        }
+    }
+    for (p=1; p < nblk; p++) {
+        if (0 != nblk % p) {
+            continue;
+        }
+        for (n=p; n < nblk; n++) {
+            if (0 != memcmp(&blk[3*n], &blk[3*(n % p)], 3 * sizeof(int))) {
+                break;
+            }
+        }
+        if (n == nblk) {
+            break;
+        }
+    }
+
+    map = strdup("(vector");
+    for (n=0; NULL != map && n < p; n++) {
+        tmp = map;
+        if (0 > asprintf(&map, "%s,(%d,%d,%d)", tmp, blk[3*n], blk[3*n+1], blk[3*n+2])) {
+            map = NULL;
+        }
+        free(tmp);
+    }
+    if (NULL != map) {
+        tmp = map;
+        if (0 > asprintf(&map, "%s)", tmp)) {
+            map = NULL;
+        }
+        free(tmp);
+    }
+
+  cleanup:
+    if (NULL != procs) {
+        pmix_argv_free(procs);
+    }
+    if (NULL != node) {
+        free(node);
+    }
+    if (NULL != blk) {
+        free(blk);
+    }
+    return map;
+}
+
+/* identify the job-level info we hold for an nspace - the server
+ * instance is included as the generation restarts with us */
+static char* _jobinfo_tag(pmix_namespace_t *nptr)
+{
+    char *tag;
+
+    if (0 > asprintf(&tag, "%s.%u:%lu:%u", pmix_globals.myid.nspace,
+                     pmix_globals.myid.rank, (unsigned long)getpid(),
+                     nptr->jobgen)) {
+        return NULL;
+    }
+    return tag;
+}
+
+/* pick the gds modules offered to the clients of an nspace by its
+ * size - small jobs aren't worth setting up shared memory for, and
+ * very large ones may be better served by a more compact store.
+ * Returns NULL when all available modules are to be offered */
+static char* _gds_for_job(pmix_setup_caddy_t *cd)
+{
+    size_t n, size;
+    char **mods, **pick = NULL, *result = NULL;
+
+    size = cd->nlocalprocs;
+    for (n=0; n < cd->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&cd->info[n], PMIX_JOB_SIZE)) {
+            size = cd->info[n].value.data.uint32;
+            break;
+        }
+    }
+
+    if (0 < pmix_server_globals.gds_small_job &&
+        size <= (size_t)pmix_server_globals.gds_small_job) {
+        if (pmix_gds_base_module_listed(gds_mode, "hash")) {
+            result = strdup("hash");
+        }
+    } else if (0 < pmix_server_globals.gds_large_job &&
+               NULL != pmix_server_globals.gds_large_modules &&
+               size >= (size_t)pmix_server_globals.gds_large_job) {
+        mods = pmix_argv_split(pmix_server_globals.gds_large_modules, ',');
+        for (n=0; NULL != mods && NULL != mods[n]; n++) {
+            if (pmix_gds_base_module_listed(gds_mode, mods[n])) {
+                pmix_argv_append_nosize(&pick, mods[n]);
+            }
+        }
+        pmix_argv_free(mods);
+        if (NULL != pick) {
+            result = pmix_argv_join(pick, ',');
+            pmix_argv_free(pick);
+        }
+    }
+
+    if (NULL != result) {
+        pmix_output_verbose(2, pmix_server_globals.base_output,
+                            "pmix:server nspace %s of size %lu uses gds %s",
+                            cd->proc.nspace, (unsigned long)size, result);
+    }
+    return result;
+}
+
 static void _register_nspace(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     pmix_status_t rc;
     size_t i;
+    pmix_byte_object_t bo;
+    pmix_info_t locinfo;
+    char *map;
 
     PMIX_ACQUIRE_OBJECT(caddy);
 
@@ -562,12 +748,7 @@ static void _register_nspace(int sd, short args, void *cbdata)
 
     /* see if we already have this nspace */
     nptr = NULL;
-    PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(tmp->nspace, cd->proc.nspace)) {
-            nptr = tmp;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, cd->proc.nspace);
     if (NULL == nptr) {
         nptr = PMIX_NEW(pmix_namespace_t);
         if (NULL == nptr) {
@@ -575,10 +756,16 @@ static void _register_nspace(int sd, short args, void *cbdata)
             goto release;
         }
         nptr->nspace = strdup(cd->proc.nspace);
-        pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+        pmix_nspace_add(&pmix_server_globals.nspaces, nptr);
     }
     nptr->nlocalprocs = cd->nlocalprocs;
 
+    /* decide which stores the clients of this nspace get */
+    if (NULL != nptr->gds_modes) {
+        free(nptr->gds_modes);
+    }
+    nptr->gds_modes = _gds_for_job(cd);
+
     /* see if we have everyone */
     if (nptr->nlocalprocs == pmix_list_get_size(&nptr->ranks)) {
         nptr->all_registered = true;
@@ -594,7 +781,7 @@ static void _register_nspace(int sd, short args, void *cbdata)
     }
 
     /* register nspace for each activate components */
-    PMIX_GDS_ADD_NSPACE(rc, nptr->nspace, cd->info, cd->ninfo);
+    PMIX_GDS_ADD_NSPACE(rc, nptr->nspace, nptr->gds_modes, cd->info, cd->ninfo);
     if (PMIX_SUCCESS != rc) {
         goto release;
     }
@@ -605,6 +792,55 @@ static void _register_nspace(int sd, short args, void *cbdata)
      * are using */
     PMIX_GDS_CACHE_JOB_INFO(rc, pmix_globals.mypeer, nptr,
                             cd->info, cd->ninfo);
+    if (PMIX_SUCCESS != rc) {
+        goto release;
+    }
+    /* any copy handed to a peer during a connect is now stale */
+    ++nptr->jobgen;
+    if (NULL != (map = _jobinfo_tag(nptr))) {
+        PMIX_INFO_LOAD(&locinfo, PMIX_JOB_INFO_TAG_KEY, map, PMIX_STRING);
+        free(map);
+        PMIX_GDS_CACHE_JOB_INFO(rc, pmix_globals.mypeer, nptr, &locinfo, 1);
+        PMIX_INFO_DESTRUCT(&locinfo);
+    }
+
+    /* work out the relative locality of the local peers once
+     * here so none of them has to do it for itself */
+    if (PMIX_SUCCESS == pmix_hwloc_compute_locality(cd->info, cd->ninfo, &bo)) {
+        PMIX_INFO_LOAD(&locinfo, PMIX_LOCALITY_MATRIX, &bo, PMIX_BYTE_OBJECT);
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        PMIX_GDS_CACHE_JOB_INFO(rc, pmix_globals.mypeer, nptr, &locinfo, 1);
+        PMIX_INFO_DESTRUCT(&locinfo);
+    }
+
+    /* let the clients know they only need to send what changed
+     * when they commit again */
+    PMIX_INFO_LOAD(&locinfo, PMIX_COMMIT_DELTA_KEY, NULL, PMIX_BOOL);
+    PMIX_GDS_CACHE_JOB_INFO(rc, pmix_globals.mypeer, nptr, &locinfo, 1);
+    PMIX_INFO_DESTRUCT(&locinfo);
+
+    /* and that they can send the procs in a fence or [dis]connect
+     * as rank ranges rather than one full proc at a time */
+    PMIX_INFO_LOAD(&locinfo, PMIX_PROCSET_RANGES_KEY, NULL, PMIX_BOOL);
+    PMIX_GDS_CACHE_JOB_INFO(rc, pmix_globals.mypeer, nptr, &locinfo, 1);
+    PMIX_INFO_DESTRUCT(&locinfo);
+
+    /* likewise the process mapping PMI clients keep asking for */
+    if (NULL != (map = _anl_map(cd->info, cd->ninfo))) {
+        PMIX_INFO_LOAD(&locinfo, PMIX_ANL_MAP, map, PMIX_STRING);
+        free(map);
+        PMIX_GDS_CACHE_JOB_INFO(rc, pmix_globals.mypeer, nptr, &locinfo, 1);
+        PMIX_INFO_DESTRUCT(&locinfo);
+    }
+
+    /* let the fabric components publish any endpoints they assigned
+     * so the procs can find their peers without a modex - if they
+     * can't, the procs just exchange endpoints as before */
+    if (PMIX_SUCCESS != pmix_pnet.register_endpoints(nptr->nspace, cd->info, cd->ninfo)) {
+        pmix_output_verbose(2, pmix_server_globals.base_output,
+                            "pmix:server no endpoints published for nspace %s",
+                            nptr->nspace);
+    }
 
   release:
     if (NULL != cd->opcbfunc) {
@@ -655,19 +891,33 @@ void pmix_server_purge_events(pmix_peer_t *peer,
     size_t n, m, p, ntgs;
     pmix_proc_t *tgs, *tgt;
     pmix_dmdx_local_t *dlcd, *dnxt;
+    pmix_peer_ref_t *ref;
 
     /* since the client is finalizing, remove them from any event
-     * registrations they may still have on our list */
-    PMIX_LIST_FOREACH_SAFE(reginfo, regnext, &pmix_server_globals.events, pmix_regevents_info_t) {
-        PMIX_LIST_FOREACH_SAFE(prev, pnext, &reginfo->peers, pmix_peer_events_info_t) {
-            if ((NULL != peer && prev->peer == peer) ||
-                (NULL != proc && PMIX_CHECK_PROCID(proc, &prev->peer->info->pname))) {
-                pmix_list_remove_item(&reginfo->peers, &prev->super);
-                PMIX_RELEASE(prev);
-                if (0 == pmix_list_get_size(&reginfo->peers)) {
-                    pmix_list_remove_item(&pmix_server_globals.events, &reginfo->super);
-                    PMIX_RELEASE(reginfo);
-                    break;
+     * registrations they may still have on our list - a peer
+     * knows which those are */
+    if (NULL != peer) {
+        while (NULL != (ref = (pmix_peer_ref_t*)pmix_list_get_first(&peer->evregs)) &&
+               pmix_list_get_end(&peer->evregs) != &ref->super) {
+            prev = (pmix_peer_events_info_t*)ref->member;
+            reginfo = prev->reg;
+            pmix_server_reg_del_peer(prev);
+            PMIX_RELEASE(prev);
+            if (0 == pmix_list_get_size(&reginfo->peers)) {
+                pmix_server_reg_remove(reginfo);
+            }
+        }
+    }
+    if (NULL != proc) {
+        PMIX_LIST_FOREACH_SAFE(reginfo, regnext, &pmix_server_globals.events, pmix_regevents_info_t) {
+            PMIX_LIST_FOREACH_SAFE(prev, pnext, &reginfo->peers, pmix_peer_events_info_t) {
+                if (PMIX_CHECK_PROCID(proc, &prev->peer->info->pname)) {
+                    pmix_server_reg_del_peer(prev);
+                    PMIX_RELEASE(prev);
+                    if (0 == pmix_list_get_size(&reginfo->peers)) {
+                        pmix_server_reg_remove(reginfo);
+                        break;
+                    }
                 }
             }
         }
@@ -682,13 +932,15 @@ void pmix_server_purge_events(pmix_peer_t *peer,
             PMIX_RELEASE(req);
         }
     }
+    /* and send along any of their output we were holding */
+    pmix_server_iof_unbatch(peer, proc);
 
     /* see if this proc is involved in any direct modex requests */
     PMIX_LIST_FOREACH_SAFE(dlcd, dnxt, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
         if ((NULL != peer && PMIX_CHECK_PROCID(&peer->info->pname, &dlcd->proc)) ||
             (NULL != proc && PMIX_CHECK_PROCID(proc, &dlcd->proc))) {
                 /* cleanup this request */
-            pmix_list_remove_item(&pmix_server_globals.local_reqs, &dlcd->super);
+            pmix_pending_remove(dlcd);
                 /* we can release the dlcd item here because we are not
                  * releasing the tracker held by the host - we are only
                  * releasing one item on that tracker */
@@ -713,6 +965,7 @@ void pmix_server_purge_events(pmix_peer_t *peer,
                  * evict the notification */
                 if (1 == ncd->ntargets) {
                     pmix_hotel_checkout(&pmix_globals.notifications, i);
+                    pmix_notify_cache_unindex(ncd);
                     PMIX_RELEASE(ncd);
                 } else if (PMIX_RANK_WILDCARD == tgt->rank &&
                            NULL != proc && PMIX_RANK_WILDCARD == proc->rank) {
@@ -757,14 +1010,21 @@ static void _deregister_nspace(int sd, short args, void *cbdata)
      * cached notifications targeting procs from this nspace */
     pmix_server_purge_events(NULL, &cd->proc);
 
+    /* and anything they published to the node-local store */
+    pmix_server_pubsub_purge(cd->proc.nspace);
+
+    /* give back any event ring readers its procs still held */
+    pmix_event_ring_release_reader(&cd->proc);
+
     /* release this nspace */
-    PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(tmp->nspace, cd->proc.nspace)) {
-            pmix_list_remove_item(&pmix_server_globals.nspaces, &tmp->super);
-            PMIX_RELEASE(tmp);
-            break;
-        }
+    tmp = pmix_nspace_lookup(&pmix_server_globals.nspaces, cd->proc.nspace);
+    if (NULL != tmp) {
+        pmix_list_remove_item(&pmix_server_globals.nspaces, &tmp->super);
+        PMIX_RELEASE(tmp);
     }
+    /* a long-running server can churn through many jobs, so
+     * give back any client slots this one left unused */
+    pmix_pointer_array_shrink(&pmix_server_globals.clients);
 
     /* release the caller */
     if (NULL != cd->opcbfunc) {
@@ -821,12 +1081,16 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
     pmix_namelist_t *pn;
     bool found;
     pmix_cb_t cb;
+    size_t hdr;
+    uint8_t *zbytes;
+    size_t zsize;
 
     PMIX_ACQUIRE_OBJECT(tcd);
 
     /* we don't need to check for non-NULL APIs here as
      * that was already done when the tracker was created */
     if (PMIX_FENCENB_CMD == trk->type) {
+        trk->t_local = pmix_counter_now();
         /* if the user asked us to collect data, then we have
          * to provide any locally collected data to the host
          * server so they can circulate it - only take data
@@ -845,6 +1109,7 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
              * be empty - if that happens, we just need to call the fence
              * function to prevent others from hanging */
             if (0 == pmix_list_get_size(&trk->local_cbs)) {
+                trk->t_upcall = trk->t_local;
                 pmix_host_server.fence_nb(trk->pcs, trk->npcs,
                                           trk->info, trk->ninfo,
                                           data, sz, trk->modexcbfunc, trk);
@@ -859,8 +1124,23 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
 
         unsigned char tmp = (unsigned char)trk->collect_type;
         PMIX_BFROPS_PACK(rc, peer, &bucket, &tmp, 1, PMIX_BYTE);
-
-        if (PMIX_COLLECT_YES == trk->collect_type) {
+        hdr = bucket.bytes_used;
+
+        if (PMIX_COLLECT_YES == trk->collect_type &&
+            peer->nptr->compat.bfrops == pmix_globals.mypeer->nptr->compat.bfrops &&
+            peer->nptr->compat.type == pmix_globals.mypeer->nptr->compat.type) {
+            /* the local contributions were accumulated in a
+             * compatible form as the participants arrived */
+            if (0 < trk->bucket.bytes_used) {
+                PMIX_BFROPS_COPY_PAYLOAD(rc, peer, &bucket, &trk->bucket);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    PMIX_DESTRUCT(&bucket);
+                    PMIX_RELEASE(tcd);
+                    return;
+                }
+            }
+        } else if (PMIX_COLLECT_YES == trk->collect_type) {
             pmix_output_verbose(2, pmix_server_globals.base_output,
                                 "fence - assembling data");
             first = true;
@@ -881,6 +1161,22 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
                 } else {
                     pn = PMIX_NEW(pmix_namelist_t);
                     pn->pname = &cd->peer->info->pname;
+                    pmix_list_append(&pnames, &pn->super);
+                }
+                /* if the contribution was pre-assembled at commit
+                 * in a compatible form, then just pass it along */
+                if (NULL != cd->peer->info->modex.bytes && NULL == trk->collect_keys &&
+                    peer->nptr->compat.bfrops == pmix_globals.mypeer->nptr->compat.bfrops &&
+                    peer->nptr->compat.type == pmix_globals.mypeer->nptr->compat.type) {
+                    PMIX_BFROPS_PACK(rc, peer, &bucket, &cd->peer->info->modex, 1, PMIX_BYTE_OBJECT);
+                    if (PMIX_SUCCESS != rc) {
+                        PMIX_ERROR_LOG(rc);
+                        PMIX_LIST_DESTRUCT(&pnames);
+                        PMIX_DESTRUCT(&bucket);
+                        PMIX_RELEASE(tcd);
+                        return;
+                    }
+                    continue;
                 }
                 if (trk->hybrid || first) {
                     /* setup the nspace */
@@ -908,6 +1204,9 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
                         return;
                     }
                     PMIX_LIST_FOREACH(kv, &cb.kvs, pmix_kval_t) {
+                        if (!pmix_server_collect_key(trk, kv->key)) {
+                            continue;
+                        }
                         PMIX_BFROPS_PACK(rc, peer, &pbkt, kv, 1, PMIX_KVAL);
                         if (PMIX_SUCCESS != rc) {
                             PMIX_ERROR_LOG(rc);
@@ -935,8 +1234,39 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
             }
             PMIX_LIST_DESTRUCT(&pnames);
         }
+        /* if the contributions are large, replace them with a
+         * single compressed block as _collect_data does */
+        if (0 < pmix_server_globals.fence_compress &&
+            PMIX_COLLECT_YES == trk->collect_type &&
+            (size_t)pmix_server_globals.fence_compress < bucket.bytes_used - hdr &&
+            pmix_util_compress_block((uint8_t*)bucket.base_ptr + hdr,
+                                     bucket.bytes_used - hdr,
+                                     &zbytes, &zsize)) {
+            pmix_output_verbose(2, pmix_server_globals.fence_output,
+                                "fence - compressed %lu bytes of data to %lu",
+                                (unsigned long)(bucket.bytes_used - hdr),
+                                (unsigned long)zsize);
+            PMIX_DESTRUCT(&bucket);
+            PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
+            tmp |= PMIX_COLLECT_COMPRESSED;
+            PMIX_BFROPS_PACK(rc, peer, &bucket, &tmp, 1, PMIX_BYTE);
+            if (PMIX_SUCCESS == rc) {
+                bo.bytes = (char*)zbytes;
+                bo.size = zsize;
+                PMIX_BFROPS_PACK(rc, peer, &bucket, &bo, 1, PMIX_BYTE_OBJECT);
+            }
+            free(zbytes);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_DESTRUCT(&bucket);
+                PMIX_RELEASE(tcd);
+                return;
+            }
+        }
         PMIX_UNLOAD_BUFFER(&bucket, data, sz);
         PMIX_DESTRUCT(&bucket);
+        trk->upcall_bytes = sz;
+        trk->t_upcall = pmix_counter_now();
         pmix_host_server.fence_nb(trk->pcs, trk->npcs,
                                   trk->info, trk->ninfo,
                                   data, sz, trk->modexcbfunc, trk);
@@ -951,128 +1281,168 @@ void pmix_server_execute_collective(int sd, short args, void *cbdata)
     } else {
         /* unknown type */
         PMIX_ERROR_LOG(PMIX_ERR_NOT_FOUND);
-        pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+        pmix_server_trk_remove(trk);
         PMIX_RELEASE(trk);
     }
     PMIX_RELEASE(tcd);
 }
 
-static void _register_client(int sd, short args, void *cbdata)
+/* add a local client to its nspace, creating the nspace if
+ * we haven't seen it yet */
+static pmix_status_t add_client(const pmix_proc_t *proc, uid_t uid, gid_t gid,
+                                void *server_object, pmix_namespace_t **nsout)
 {
-    pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
-    pmix_rank_info_t *info, *iptr;
-    pmix_namespace_t *nptr, *ns;
-    pmix_server_trkr_t *trk;
-    pmix_trkr_caddy_t *tcd;
-    bool all_def;
-    size_t i;
-    pmix_status_t rc;
-
-    PMIX_ACQUIRE_OBJECT(cd);
+    pmix_rank_info_t *info;
+    pmix_namespace_t *nptr;
 
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "pmix:server _register_client for nspace %s rank %d %s object",
-                        cd->proc.nspace, cd->proc.rank,
-                        (NULL == cd->server_object) ? "NULL" : "NON-NULL");
+                        proc->nspace, proc->rank,
+                        (NULL == server_object) ? "NULL" : "NON-NULL");
 
     /* see if we already have this nspace */
     nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, cd->proc.nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, proc->nspace);
     if (NULL == nptr) {
         nptr = PMIX_NEW(pmix_namespace_t);
         if (NULL == nptr) {
-            rc = PMIX_ERR_NOMEM;
-            goto cleanup;
+            return PMIX_ERR_NOMEM;
         }
-        nptr->nspace = strdup(cd->proc.nspace);
-        pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+        nptr->nspace = strdup(proc->nspace);
+        pmix_nspace_add(&pmix_server_globals.nspaces, nptr);
     }
     /* setup a peer object for this client - since the host server
      * only deals with the original processes and not any clones,
      * we know this function will be called only once per rank */
     info = PMIX_NEW(pmix_rank_info_t);
     if (NULL == info) {
-        rc = PMIX_ERR_NOMEM;
-        goto cleanup;
+        return PMIX_ERR_NOMEM;
     }
     info->pname.nspace = strdup(nptr->nspace);
-    info->pname.rank = cd->proc.rank;
-    info->uid = cd->uid;
-    info->gid = cd->gid;
-    info->server_object = cd->server_object;
-    pmix_list_append(&nptr->ranks, &info->super);
+    info->pname.rank = proc->rank;
+    info->uid = uid;
+    info->gid = gid;
+    info->server_object = server_object;
+    pmix_nspace_add_rank(nptr, info);
+    pmix_server_ptable_update(nptr, info);
+
+    *nsout = nptr;
+    return PMIX_SUCCESS;
+}
+
+/* once all the local clients of an nspace are known, release
+ * anything that was waiting to find out which procs are local */
+static void clients_complete(pmix_namespace_t *nptr)
+{
+    pmix_namespace_t *ns;
+    pmix_server_trkr_t *trk;
+    pmix_trkr_caddy_t *tcd;
+    bool all_def;
+    size_t i;
+
     /* see if we have everyone */
-    if (nptr->nlocalprocs == pmix_list_get_size(&nptr->ranks)) {
-        nptr->all_registered = true;
-        /* check any pending trackers to see if they are
-         * waiting for us. There is a slight race condition whereby
-         * the host server could have spawned the local client and
-         * it called back into the collective -before- our local event
-         * would fire the register_client callback. Deal with that here. */
-        all_def = true;
-        PMIX_LIST_FOREACH(trk, &pmix_server_globals.collectives, pmix_server_trkr_t) {
-            /* if this tracker is already complete, then we
-             * don't need to update it */
-            if (trk->def_complete) {
+    if (nptr->nlocalprocs != pmix_list_get_size(&nptr->ranks)) {
+        return;
+    }
+    nptr->all_registered = true;
+    /* check any pending trackers to see if they are
+     * waiting for us. There is a slight race condition whereby
+     * the host server could have spawned the local client and
+     * it called back into the collective -before- our local event
+     * would fire the register_client callback. Deal with that here. */
+    all_def = true;
+    PMIX_LIST_FOREACH(trk, &pmix_server_globals.collectives, pmix_server_trkr_t) {
+        /* if this tracker is already complete, then we
+         * don't need to update it */
+        if (trk->def_complete) {
+            continue;
+        }
+        /* see if any of our procs from this nspace are involved - the tracker will
+         * have been created because a callback was received, but
+         * we may or may not have received _all_ callbacks by this
+         * time. So check and see if any procs from this nspace are
+         * involved, and add them to the count of local participants */
+        for (i=0; i < trk->npcs; i++) {
+            /* since we have to do this search, let's see
+             * if the nspaces are all defined */
+            if (all_def) {
+                /* so far, they have all been defined - check this one */
+                ns = pmix_nspace_lookup(&pmix_server_globals.nspaces, trk->pcs[i].nspace);
+                if (NULL != ns && 0 < ns->nlocalprocs) {
+                    all_def = ns->all_registered;
+                }
+            }
+            /* now see if this proc is local to us */
+            if (0 != strncmp(trk->pcs[i].nspace, nptr->nspace, PMIX_MAX_NSLEN)) {
                 continue;
             }
-            /* see if any of our procs from this nspace are involved - the tracker will
-             * have been created because a callback was received, but
-             * we may or may not have received _all_ callbacks by this
-             * time. So check and see if any procs from this nspace are
-             * involved, and add them to the count of local participants */
-            for (i=0; i < trk->npcs; i++) {
-                /* since we have to do this search, let's see
-                 * if the nspaces are all defined */
-                if (all_def) {
-                    /* so far, they have all been defined - check this one */
-                    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-                        if (0 < ns->nlocalprocs &&
-                            0 == strcmp(trk->pcs[i].nspace, ns->nspace)) {
-                            all_def = ns->all_registered;
-                            break;
-                        }
-                    }
-                }
-                /* now see if this proc is local to us */
-                if (0 != strncmp(trk->pcs[i].nspace, nptr->nspace, PMIX_MAX_NSLEN)) {
-                    continue;
-                }
-                /* need to check if this rank is one of mine */
-                PMIX_LIST_FOREACH(iptr, &nptr->ranks, pmix_rank_info_t) {
-                    if (PMIX_RANK_WILDCARD == trk->pcs[i].rank ||
-                        iptr->pname.rank == trk->pcs[i].rank) {
-                        /* this is one of mine - track the count */
-                        ++trk->nlocal;
-                        break;
-                    }
-                }
+            /* need to check if this rank is one of mine */
+            if ((PMIX_RANK_WILDCARD == trk->pcs[i].rank && 0 < pmix_list_get_size(&nptr->ranks)) ||
+                NULL != pmix_nspace_find_rank(nptr, trk->pcs[i].rank)) {
+                /* this is one of mine - track the count */
+                ++trk->nlocal;
             }
-            /* update this tracker's status */
-            trk->def_complete = all_def;
-            /* is this now locally completed? */
-            if (trk->def_complete && pmix_list_get_size(&trk->local_cbs) == trk->nlocal) {
-                /* it did, so now we need to process it
-                 * we don't want to block someone
-                 * here, so kick any completed trackers into a
-                 * new event for processing */
-                PMIX_EXECUTE_COLLECTIVE(tcd, trk, pmix_server_execute_collective);
+        }
+        /* update this tracker's status */
+        trk->def_complete = all_def;
+        /* is this now locally completed? */
+        if (trk->def_complete && pmix_list_get_size(&trk->local_cbs) == trk->nlocal) {
+            /* it did, so now we need to process it
+             * we don't want to block someone
+             * here, so kick any completed trackers into a
+             * new event for processing */
+            PMIX_EXECUTE_COLLECTIVE(tcd, trk, pmix_server_execute_collective);
+        }
+    }
+    /* also check any pending local modex requests to see if
+     * someone has been waiting for a request on a remote proc
+     * in one of our nspaces, but we didn't know all the local procs
+     * and so couldn't determine the proc was remote */
+    pmix_pending_nspace_requests(nptr);
+}
+
+static void _register_clients(int sd, short args, void *cbdata)
+{
+    pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
+    pmix_namespace_t *nptr;
+    pmix_nspace_caddy_t *nc;
+    pmix_list_t touched;
+    pmix_status_t rc = PMIX_SUCCESS;
+    size_t n;
+    bool found;
+
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    /* add them all first so that each nspace is only checked
+     * for completion once */
+    PMIX_CONSTRUCT(&touched, pmix_list_t);
+    for (n=0; n < cd->nprocs; n++) {
+        rc = add_client(&cd->procs[n], cd->uids[n], cd->gids[n],
+                        (NULL == cd->server_objects) ? NULL : cd->server_objects[n],
+                        &nptr);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        found = false;
+        PMIX_LIST_FOREACH(nc, &touched, pmix_nspace_caddy_t) {
+            if (nc->ns == nptr) {
+                found = true;
+                break;
             }
         }
-        /* also check any pending local modex requests to see if
-         * someone has been waiting for a request on a remote proc
-         * in one of our nspaces, but we didn't know all the local procs
-         * and so couldn't determine the proc was remote */
-        pmix_pending_nspace_requests(nptr);
+        if (!found) {
+            nc = PMIX_NEW(pmix_nspace_caddy_t);
+            PMIX_RETAIN(nptr);
+            nc->ns = nptr;
+            pmix_list_append(&touched, &nc->super);
+        }
+    }
+    /* even if one of them failed, the ones we added are registered */
+    PMIX_LIST_FOREACH(nc, &touched, pmix_nspace_caddy_t) {
+        clients_complete(nc->ns);
     }
-    rc = PMIX_SUCCESS;
+    PMIX_LIST_DESTRUCT(&touched);
 
-  cleanup:
     /* let the caller know we are done */
     if (NULL != cd->opcbfunc) {
         cd->opcbfunc(rc, cd->cbdata);
@@ -1080,9 +1450,10 @@ static void _register_client(int sd, short args, void *cbdata)
     PMIX_RELEASE(cd);
 }
 
-PMIX_EXPORT pmix_status_t PMIx_server_register_client(const pmix_proc_t *proc,
-                                                      uid_t uid, gid_t gid, void *server_object,
-                                                      pmix_op_cbfunc_t cbfunc, void *cbdata)
+PMIX_EXPORT pmix_status_t PMIx_server_register_clients(const pmix_proc_t procs[], size_t nprocs,
+                                                       const uid_t uids[], const gid_t gids[],
+                                                       void *server_objects[],
+                                                       pmix_op_cbfunc_t cbfunc, void *cbdata)
 {
     pmix_setup_caddy_t *cd;
 
@@ -1093,33 +1464,61 @@ PMIX_EXPORT pmix_status_t PMIx_server_register_client(const pmix_proc_t *proc,
     }
     PMIX_RELEASE_THREAD(&pmix_global_lock);
 
+    if (NULL == procs || 0 == nprocs || NULL == uids || NULL == gids) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
     pmix_output_verbose(2, pmix_server_globals.base_output,
-                        "pmix:server register client %s:%d",
-                        proc->nspace, proc->rank);
+                        "pmix:server register %lu clients", (unsigned long)nprocs);
 
     cd = PMIX_NEW(pmix_setup_caddy_t);
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
     }
-    pmix_strncpy(cd->proc.nspace, proc->nspace, PMIX_MAX_NSLEN);
-    cd->proc.rank = proc->rank;
-    cd->uid = uid;
-    cd->gid = gid;
-    cd->server_object = server_object;
+    PMIX_PROC_CREATE(cd->procs, nprocs);
+    cd->uids = (uid_t*)malloc(nprocs * sizeof(uid_t));
+    cd->gids = (gid_t*)malloc(nprocs * sizeof(gid_t));
+    if (NULL != server_objects) {
+        cd->server_objects = (void**)malloc(nprocs * sizeof(void*));
+    }
+    if (NULL == cd->procs || NULL == cd->uids || NULL == cd->gids ||
+        (NULL != server_objects && NULL == cd->server_objects)) {
+        PMIX_RELEASE(cd);
+        return PMIX_ERR_NOMEM;
+    }
+    cd->nprocs = nprocs;
+    memcpy(cd->procs, procs, nprocs * sizeof(pmix_proc_t));
+    memcpy(cd->uids, uids, nprocs * sizeof(uid_t));
+    memcpy(cd->gids, gids, nprocs * sizeof(gid_t));
+    if (NULL != server_objects) {
+        memcpy(cd->server_objects, server_objects, nprocs * sizeof(void*));
+    }
     cd->opcbfunc = cbfunc;
     cd->cbdata = cbdata;
 
-    /* we have to push this into our event library to avoid
-     * potential threading issues */
-    PMIX_THREADSHIFT(cd, _register_client);
+    /* one trip into our event library for all of them */
+    PMIX_THREADSHIFT(cd, _register_clients);
     return PMIX_SUCCESS;
 }
 
+PMIX_EXPORT pmix_status_t PMIx_server_register_client(const pmix_proc_t *proc,
+                                                      uid_t uid, gid_t gid, void *server_object,
+                                                      pmix_op_cbfunc_t cbfunc, void *cbdata)
+{
+    if (NULL == proc) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    /* a batch of one */
+    return PMIx_server_register_clients(proc, 1, &uid, &gid,
+                                        (NULL == server_object) ? NULL : &server_object,
+                                        cbfunc, cbdata);
+}
+
 static void _deregister_client(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
     pmix_rank_info_t *info;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     pmix_peer_t *peer;
 
     PMIX_ACQUIRE_OBJECT(cd);
@@ -1130,60 +1529,54 @@ static void _deregister_client(int sd, short args, void *cbdata)
 
     /* see if we already have this nspace */
     nptr = NULL;
-    PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(tmp->nspace, cd->proc.nspace)) {
-            nptr = tmp;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, cd->proc.nspace);
     if (NULL == nptr) {
         /* nothing to do */
         goto cleanup;
     }
     /* find and remove this client */
-    PMIX_LIST_FOREACH(info, &nptr->ranks, pmix_rank_info_t) {
-        if (info->pname.rank == cd->proc.rank) {
-            /* if this client failed to call finalize, we still need
-             * to restore any allocations that were given to it */
-            if (NULL == (peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, info->peerid))) {
-                /* this peer never connected, and hence it won't finalize,
-                 * so account for it here */
+    if (NULL != (info = pmix_nspace_find_rank(nptr, cd->proc.rank))) {
+        /* if this client failed to call finalize, we still need
+         * to restore any allocations that were given to it */
+        if (NULL == (peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, info->peerid))) {
+            /* this peer never connected, and hence it won't finalize,
+             * so account for it here */
+            nptr->nfinalized++;
+            /* even if they never connected, resources were allocated
+             * to them, so we need to ensure they are properly released */
+            pmix_pnet.child_finalized(&cd->proc);
+        } else {
+            if (!peer->finalized) {
+                /* this peer connected to us, but is being deregistered
+                 * without having finalized. This usually means an
+                 * abnormal termination that was picked up by
+                 * our host prior to our seeing the connection drop.
+                 * It is also possible that we missed the dropped
+                 * connection, so mark the peer as finalized so
+                 * we don't duplicate account for it and take care
+                 * of it here */
+                peer->finalized = true;
                 nptr->nfinalized++;
-                /* even if they never connected, resources were allocated
-                 * to them, so we need to ensure they are properly released */
-                pmix_pnet.child_finalized(&cd->proc);
-            } else {
-                if (!peer->finalized) {
-                    /* this peer connected to us, but is being deregistered
-                     * without having finalized. This usually means an
-                     * abnormal termination that was picked up by
-                     * our host prior to our seeing the connection drop.
-                     * It is also possible that we missed the dropped
-                     * connection, so mark the peer as finalized so
-                     * we don't duplicate account for it and take care
-                     * of it here */
-                    peer->finalized = true;
-                    nptr->nfinalized++;
-                }
-                /* resources may have been allocated to them, so
-                 * ensure they get cleaned up - this isn't true
-                 * for tools, so don't clean them up */
-                if (!PMIX_PROC_IS_TOOL(peer)) {
-                    pmix_pnet.child_finalized(&cd->proc);
-                    pmix_psensor.stop(peer, NULL);
-                }
-                /* ensure we close the socket to this peer so we don't
-                 * generate "connection lost" events should it be
-                 * subsequently "killed" by the host */
-                CLOSE_THE_SOCKET(peer->sd);
             }
-            if (nptr->nlocalprocs == nptr->nfinalized) {
-                pmix_pnet.local_app_finalized(nptr);
+            /* resources may have been allocated to them, so
+             * ensure they get cleaned up - this isn't true
+             * for tools, so don't clean them up */
+            if (!PMIX_PROC_IS_TOOL(peer)) {
+                pmix_pnet.child_finalized(&cd->proc);
+                pmix_psensor.stop(peer, NULL);
             }
-            pmix_list_remove_item(&nptr->ranks, &info->super);
-            PMIX_RELEASE(info);
-            break;
+            /* ensure we close the socket to this peer so we don't
+             * generate "connection lost" events should it be
+             * subsequently "killed" by the host */
+            CLOSE_THE_SOCKET(peer->sd);
+        }
+        if (nptr->nlocalprocs == nptr->nfinalized) {
+            pmix_pnet.local_app_finalized(nptr);
         }
+        pmix_nspace_remove_rank(nptr, info);
+        pmix_server_ptable_remove(nptr, info->pname.rank);
+        pmix_event_ring_release_reader(&cd->proc);
+        PMIX_RELEASE(info);
     }
 
   cleanup:
@@ -1230,30 +1623,18 @@ PMIX_EXPORT void PMIx_server_deregister_client(const pmix_proc_t *proc,
 }
 
 /* setup the envars for a child process */
-PMIX_EXPORT pmix_status_t PMIx_server_setup_fork(const pmix_proc_t *proc, char ***env)
+/* the part of a child's environment that is the same for every
+ * rank in its nspace */
+static pmix_status_t build_fork_env(const pmix_proc_t *proc, const char *gds,
+                                     char ***env)
 {
-    char rankstr[128];
     pmix_listener_t *lt;
     pmix_status_t rc;
     char **varnames;
     int n;
 
-    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
-    if (pmix_globals.init_cntr <= 0) {
-        PMIX_RELEASE_THREAD(&pmix_global_lock);
-        return PMIX_ERR_INIT;
-    }
-    PMIX_RELEASE_THREAD(&pmix_global_lock);
-
-    pmix_output_verbose(2, pmix_server_globals.base_output,
-                        "pmix:server setup_fork for nspace %s rank %d",
-                        proc->nspace, proc->rank);
-
     /* pass the nspace */
     pmix_setenv("PMIX_NAMESPACE", proc->nspace, true, env);
-    /* pass the rank */
-    (void)snprintf(rankstr, 127, "%d", proc->rank);
-    pmix_setenv("PMIX_RANK", rankstr, true, env);
     /* pass our rendezvous info */
     PMIX_LIST_FOREACH(lt, &pmix_ptl_globals.listeners, pmix_listener_t) {
         if (NULL != lt->uri && NULL != lt->varname) {
@@ -1274,8 +1655,8 @@ PMIX_EXPORT pmix_status_t PMIx_server_setup_fork(const pmix_proc_t *proc, char *
     } else {
         pmix_setenv("PMIX_BFROP_BUFFER_TYPE", "PMIX_BFROP_BUFFER_NON_DESC", true, env);
     }
-    /* pass our available gds modules */
-    pmix_setenv("PMIX_GDS_MODULE", gds_mode, true, env);
+    /* pass the gds modules available to this nspace */
+    pmix_setenv("PMIX_GDS_MODULE", gds, true, env);
 
     /* get any PTL contribution such as tmpdir settings for session files */
     if (PMIX_SUCCESS != (rc = pmix_ptl_base_setup_fork(proc, env))) {
@@ -1298,6 +1679,81 @@ PMIX_EXPORT pmix_status_t PMIx_server_setup_fork(const pmix_proc_t *proc, char *
     return PMIX_SUCCESS;
 }
 
+/* protects the cached fork environments - the host may be
+ * starting children from several threads */
+static pmix_mutex_t fork_env_lock = PMIX_MUTEX_STATIC_INIT;
+
+PMIX_EXPORT pmix_status_t PMIx_server_setup_fork(const pmix_proc_t *proc, char ***env)
+{
+    char rankstr[128];
+    pmix_namespace_t *nptr;
+    pmix_status_t rc;
+    pmix_env_builder_t bld;
+    int n;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    pmix_output_verbose(2, pmix_server_globals.base_output,
+                        "pmix:server setup_fork for nspace %s rank %d",
+                        proc->nspace, proc->rank);
+
+    /* once the host has registered the nspace, what we add for
+     * one of its children is the same for all of them - so build
+     * it once and copy it into each child's environment */
+    nptr = NULL;
+    nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, proc->nspace);
+    if (NULL == nptr || 0 == nptr->nlocalprocs) {
+        if (PMIX_SUCCESS != (rc = build_fork_env(proc, gds_mode, env))) {
+            return rc;
+        }
+    } else {
+        pmix_mutex_lock(&fork_env_lock);
+        if (NULL == nptr->fork_env) {
+            if (PMIX_SUCCESS != (rc = build_fork_env(proc,
+                                                     (NULL == nptr->gds_modes) ? gds_mode : nptr->gds_modes,
+                                                     &nptr->fork_env))) {
+                pmix_argv_free(nptr->fork_env);
+                nptr->fork_env = NULL;
+                pmix_mutex_unlock(&fork_env_lock);
+                return rc;
+            }
+        }
+        /* index the child's environment once rather than
+         * scanning it for every variable we add */
+        pmix_env_builder_init(&bld, *env);
+        for (n=0; NULL != nptr->fork_env && NULL != nptr->fork_env[n]; n++) {
+            pmix_env_builder_set_entry(&bld, nptr->fork_env[n], true);
+        }
+        pmix_mutex_unlock(&fork_env_lock);
+        *env = pmix_env_builder_finish(&bld);
+    }
+
+    /* pass the rank */
+    (void)snprintf(rankstr, 127, "%d", proc->rank);
+    pmix_setenv("PMIX_RANK", rankstr, true, env);
+
+    /* and where it can read its events */
+    if (PMIX_SUCCESS != (rc = pmix_event_ring_setup_fork(proc, env))) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* pass the MCA parameter values we read from files so the
+     * client doesn't have to parse them again - this depends on
+     * what the child's environment already holds */
+    if (PMIX_SUCCESS != (rc = pmix_mca_base_var_export_file_values(env))) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    return PMIX_SUCCESS;
+}
+
 /***************************************************************************************************
  *  Support calls from the host server down to us requesting direct modex data provided by one     *
  *  of our local clients                                                                           *
@@ -1306,8 +1762,8 @@ PMIX_EXPORT pmix_status_t PMIx_server_setup_fork(const pmix_proc_t *proc, char *
 static void _dmodex_req(int sd, short args, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
-    pmix_rank_info_t *info, *iptr;
-    pmix_namespace_t *nptr, *ns;
+    pmix_rank_info_t *info;
+    pmix_namespace_t *nptr;
     char *data = NULL;
     size_t sz = 0;
     pmix_dmdx_remote_t *dcd;
@@ -1327,12 +1783,7 @@ static void _dmodex_req(int sd, short args, void *cbdata)
      * been informed of it - so first check to see if we know
      * about this nspace yet */
     nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(ns->nspace, cd->proc.nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, cd->proc.nspace);
     if (NULL == nptr) {
         /* we don't know this namespace yet, and so we obviously
          * haven't received the data from this proc yet - defer
@@ -1376,13 +1827,7 @@ static void _dmodex_req(int sd, short args, void *cbdata)
     }
 
     /* see if we have this peer in our list */
-    info = NULL;
-    PMIX_LIST_FOREACH(iptr, &nptr->ranks, pmix_rank_info_t) {
-        if (iptr->pname.rank == cd->proc.rank) {
-            info = iptr;
-            break;
-        }
-    }
+    info = pmix_nspace_find_rank(nptr, cd->proc.rank);
     if (NULL == info) {
         /* rank isn't known yet - defer
          * the request until we do */
@@ -1477,6 +1922,11 @@ static void _store_internal(int sd, short args, void *cbdata)
 
     pmix_strncpy(proc.nspace, cd->pname.nspace, PMIX_MAX_NSLEN);
     proc.rank = cd->pname.rank;
+    if (PMIX_RANK_WILDCARD == proc.rank &&
+        0 == strncmp(proc.nspace, pmix_globals.myid.nspace, PMIX_MAX_NSLEN)) {
+        /* the client's job-level snapshot no longer reflects our storage */
+        pmix_client_snapshot_invalidate();
+    }
     PMIX_GDS_STORE_KV(cd->status, pmix_globals.mypeer,
                       &proc, PMIX_INTERNAL, cd->kv);
     if (cd->lock.active) {
@@ -1709,10 +2159,9 @@ static void _iofdeliver(int sd, short args, void *cbdata)
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
     pmix_iof_req_t *req;
     pmix_status_t rc;
-    pmix_buffer_t *msg;
     bool found = false;
-    bool cached = false;
-    int ignore;
+    pmix_op_cbfunc_t opcbfunc;
+    void *opcbdata;
 
     pmix_output_verbose(2, pmix_server_globals.iof_output,
                         "PMIX:SERVER delivering IOF from %s on channel %0x",
@@ -1741,61 +2190,37 @@ static void _iofdeliver(int sd, short args, void *cbdata)
             continue;
         }
         found = true;
-        /* setup the msg */
-        if (NULL == (msg = PMIX_NEW(pmix_buffer_t))) {
-            PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
-            rc = PMIX_ERR_OUT_OF_RESOURCE;
-            break;
-        }
-        /* provide the source */
-        PMIX_BFROPS_PACK(rc, req->peer, msg, cd->procs, 1, PMIX_PROC);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(msg);
-            break;
-        }
-        /* provide the channel */
-        PMIX_BFROPS_PACK(rc, req->peer, msg, &cd->channels, 1, PMIX_IOF_CHANNEL);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(msg);
-            break;
-        }
-        /* pack the data */
-        PMIX_BFROPS_PACK(rc, req->peer, msg, cd->bo, 1, PMIX_BYTE_OBJECT);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(msg);
-            break;
-        }
         /* send it to the requestor */
-        PMIX_PTL_SEND_ONEWAY(rc, req->peer, msg, PMIX_PTL_TAG_IOF);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_RELEASE(msg);
+        rc = pmix_server_iof_forward(req->peer, cd->procs, cd->channels, cd->bo);
+        if (PMIX_ERR_OUT_OF_RESOURCE == rc || PMIX_ERR_NOMEM == rc) {
+            break;
         }
     }
 
     /* if nobody has registered for this yet, then cache it */
     if (!found) {
-        /* add this output to our hotel so it is cached until someone
-         * registers to receive it */
-        if (PMIX_SUCCESS != (rc = pmix_hotel_checkin(&pmix_server_globals.iof, cd, &ignore))) {
+        /* add this output to our cache so it is held until someone
+         * registers to receive it - the cache may drop it at once
+         * if it is full, so we cannot touch it afterwards */
+        opcbfunc = cd->opcbfunc;
+        opcbdata = cd->cbdata;
+        if (PMIX_SUCCESS != (rc = pmix_server_iof_cache(cd))) {
             /* we can't cache it for some reason */
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(cd);
             return;
         }
-        cached = true;
+        if (NULL != opcbfunc) {
+            opcbfunc(rc, opcbdata);
+        }
+        return;
     }
 
 
     if (NULL != cd->opcbfunc) {
         cd->opcbfunc(rc, cd->cbdata);
     }
-    if (!cached) {
-        PMIX_RELEASE(cd);
-    }
+    PMIX_RELEASE(cd);
 }
 
 pmix_status_t PMIx_server_IOF_deliver(const pmix_proc_t *source,
@@ -1836,6 +2261,7 @@ pmix_status_t PMIx_server_IOF_deliver(const pmix_proc_t *source,
     }
     memcpy(cd->bo[0].bytes, bo->bytes, bo->size);
     cd->bo[0].size = bo->size;
+    pmix_counter_add(PMIX_CTR_IOF_BYTES, bo->size);
     if (0 < ninfo) {
         PMIX_INFO_CREATE(cd->info, ninfo);
         if (NULL == cd->info) {
@@ -2285,6 +2711,52 @@ static void lookup_cbfunc(pmix_status_t status, pmix_pdata_t pdata[], size_t nda
  * which contains byte objects, one for each set of data. Our
  * peer servers will have packed the blobs using our common
  * GDS module, so use the mypeer one to unpack them */
+/* emit one record per fence with the time spent in each phase:
+ * waiting for the local participants, packing their data, waiting
+ * on the host, and storing/distributing the result. A slow local
+ * phase points at stragglers, a slow host phase at the RM */
+static void fence_trace(pmix_server_trkr_t *trk, uint64_t done)
+{
+    if (0 == trk->t_local || 0 == trk->t_upcall || 0 == trk->t_host) {
+        /* the fence did not get to the host */
+        return;
+    }
+    pmix_output_verbose(1, pmix_server_globals.fence_output,
+                        "fence-trace: nprocs=%lu nlocal=%u bytes=%lu local=%lu pack=%lu "
+                        "host=%lu store=%lu (usec)",
+                        (unsigned long)trk->npcs, trk->nlocal,
+                        (unsigned long)trk->upcall_bytes,
+                        (unsigned long)((trk->t_local - trk->t_start) / 1000),
+                        (unsigned long)((trk->t_upcall - trk->t_local) / 1000),
+                        (unsigned long)((trk->t_host - trk->t_upcall) / 1000),
+                        (unsigned long)((done - trk->t_host) / 1000));
+}
+
+static void _mark_partial(pmix_server_trkr_t *trk)
+{
+    pmix_namespace_t *ns;
+    pmix_rank_t r;
+    size_t n;
+
+    for (n=0; n < trk->npcs; n++) {
+        ns = pmix_nspace_lookup(&pmix_server_globals.nspaces, trk->pcs[n].nspace);
+        if (NULL == ns) {
+            /* we will have to ask for anything from it anyway */
+            continue;
+        }
+        if (PMIX_RANK_WILDCARD == trk->pcs[n].rank) {
+            for (r=0; r < ns->nprocs; r++) {
+                if (NULL == pmix_nspace_find_rank(ns, r)) {
+                    pmix_bitmap_set_bit(&ns->mdxpart, (int)r);
+                }
+            }
+        } else if (0 <= (int)trk->pcs[n].rank &&
+                   NULL == pmix_nspace_find_rank(ns, trk->pcs[n].rank)) {
+            pmix_bitmap_set_bit(&ns->mdxpart, (int)trk->pcs[n].rank);
+        }
+    }
+}
+
 static void _mdxcbfunc(int sd, short argc, void *cbdata)
 {
     pmix_shift_caddy_t *scd = (pmix_shift_caddy_t*)cbdata;
@@ -2313,7 +2785,7 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
 
     /* if the timer is active, clear it */
     if (tracker->event_active) {
-        pmix_event_del(&tracker->ev);
+        pmix_timer_del(&tracker->timer);
     }
 
     /* pass the blobs being returned */
@@ -2364,6 +2836,12 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
         }
     }
 
+    /* if only some keys were collected, the rest of each remote
+     * participant's data has to be fetched when asked for */
+    if (PMIX_SUCCESS == rc && NULL != tracker->collect_keys) {
+        _mark_partial(tracker);
+    }
+
   finish_collective:
     /* loop across all procs in the tracker, sending them the reply */
     PMIX_LIST_FOREACH_SAFE(cd, nxt, &tracker->local_cbs, pmix_server_caddy_t) {
@@ -2386,11 +2864,12 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
             PMIX_RELEASE(reply);
         }
         /* remove this entry */
-        pmix_list_remove_item(&tracker->local_cbs, &cd->super);
+        pmix_server_trk_del_local(cd);
         PMIX_RELEASE(cd);
     }
 
   cleanup:
+    fence_trace(tracker, pmix_counter_now());
     /* Protect data from being free'd because RM pass
      * the pointer that is set to the middle of some
      * buffer (the case with SLURM).
@@ -2404,7 +2883,7 @@ static void _mdxcbfunc(int sd, short argc, void *cbdata)
         /* if this tracker has gone thru the "lost_connection" procedure,
          * then it has already been removed from the list - otherwise,
          * remove it now */
-        pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
+        pmix_server_trk_remove(tracker);
     }
     PMIX_RELEASE(tracker);
     PMIX_LIST_DESTRUCT(&nslist);
@@ -2424,6 +2903,9 @@ static void modex_cbfunc(pmix_status_t status, const char *data, size_t ndata, v
 
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "server:modex_cbfunc called with %d bytes", (int)ndata);
+    if (NULL != tracker) {
+        tracker->t_host = pmix_counter_now();
+    }
 
     /* need to thread-shift this callback as it accesses global data */
     scd = PMIX_NEW(pmix_shift_caddy_t);
@@ -2519,6 +3001,7 @@ static void _cnct(int sd, short args, void *cbdata)
     pmix_proc_t proc;
     pmix_cb_t cb;
     pmix_kval_t *kptr;
+    pmix_namespace_t *nptr;
 
     PMIX_ACQUIRE_OBJECT(scd);
 
@@ -2532,7 +3015,7 @@ static void _cnct(int sd, short args, void *cbdata)
 
     /* if the timer is active, clear it */
     if (tracker->event_active) {
-        pmix_event_del(&tracker->ev);
+        pmix_timer_del(&tracker->timer);
     }
 
     /* find the unique nspaces that are participating */
@@ -2578,6 +3061,17 @@ static void _cnct(int sd, short args, void *cbdata)
                 if (0 == strncmp(nspaces[i], cd->peer->info->pname.nspace, PMIX_MAX_NSLEN)) {
                     continue;
                 }
+                /* nor do we resend what it kept from an earlier
+                 * connect, so long as it hasn't changed since */
+                nptr = NULL;
+                nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, nspaces[i]);
+                if (NULL != nptr && pmix_server_cnct_known(cd->peer, nptr)) {
+                    pmix_output_verbose(2, pmix_server_globals.connect_output,
+                                        "server:cnct %s:%u already holds info for %s",
+                                        cd->peer->info->pname.nspace,
+                                        cd->peer->info->pname.rank, nspaces[i]);
+                    continue;
+                }
 
                 /* this is a local request, so give the gds the option
                  * of returning a copy of the data, or a pointer to
@@ -2643,6 +3137,9 @@ static void _cnct(int sd, short args, void *cbdata)
                 }
 
                 PMIX_DESTRUCT(&pbkt);
+                if (NULL != nptr) {
+                    pmix_server_cnct_record(cd->peer, nptr);
+                }
             }
         }
         pmix_output_verbose(2, pmix_server_globals.base_output,
@@ -2662,7 +3159,7 @@ static void _cnct(int sd, short args, void *cbdata)
         /* if this tracker has gone thru the "lost_connection" procedure,
          * then it has already been removed from the list - otherwise,
          * remove it now */
-        pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
+        pmix_server_trk_remove(tracker);
     }
     PMIX_RELEASE(tracker);
 
@@ -2709,7 +3206,7 @@ static void _discnct(int sd, short args, void *cbdata)
 
     /* if the timer is active, clear it */
     if (tracker->event_active) {
-        pmix_event_del(&tracker->ev);
+        pmix_timer_del(&tracker->timer);
     }
 
     /* loop across all local procs in the tracker, sending them the reply */
@@ -2744,7 +3241,7 @@ static void _discnct(int sd, short args, void *cbdata)
         /* if this tracker has gone thru the "lost_connection" procedure,
          * then it has already been removed from the list - otherwise,
          * remove it now */
-        pmix_list_remove_item(&pmix_server_globals.collectives, &tracker->super);
+        pmix_server_trk_remove(tracker);
     }
     PMIX_RELEASE(tracker);
 
@@ -2842,6 +3339,8 @@ static void query_cbfunc(pmix_status_t status,
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "pmix:query callback with status %d", status);
 
+    pmix_server_watchdog_query_done(cd);
+
     reply = PMIX_NEW(pmix_buffer_t);
     if (NULL == reply) {
         PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
@@ -3085,6 +3584,33 @@ static void iof_cbfunc(pmix_status_t status,
  * Should an error be encountered at any time within the switchyard, an
  * error reply buffer will be returned so that the caller can be notified,
  * thereby preventing the process from hanging. */
+/* see if the tag of the job info a tool already holds, if it
+ * sent one along with its request, is that of our current info */
+static bool _jobinfo_current(pmix_peer_t *peer, pmix_buffer_t *buf)
+{
+    pmix_status_t rc;
+    int32_t cnt;
+    char *held, *tag;
+    bool current;
+
+    if (!PMIX_PROC_IS_TOOL(peer) ||
+        buf->unpack_ptr >= buf->base_ptr + buf->bytes_used) {
+        return false;
+    }
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &held, &cnt, PMIX_STRING);
+    if (PMIX_SUCCESS != rc || NULL == held) {
+        return false;
+    }
+    tag = _jobinfo_tag(peer->nptr);
+    current = (NULL != tag && 0 == strcmp(held, tag));
+    free(held);
+    if (NULL != tag) {
+        free(tag);
+    }
+    return current;
+}
+
 static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag,
                                        pmix_buffer_t *buf)
 {
@@ -3094,6 +3620,7 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag,
     pmix_server_caddy_t *cd;
     pmix_proc_t proc;
     pmix_buffer_t *reply;
+    char *msg;
 
     /* retrieve the cmd */
     cnt = 1;
@@ -3112,9 +3639,18 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag,
             PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
             return PMIX_ERR_NOMEM;
         }
-        PMIX_GDS_REGISTER_JOB_INFO(rc, peer, reply);
+        /* a tool that kept the job info from an earlier attach
+         * tells us which it holds - if that is still current,
+         * it only needs the nspace back */
+        if (_jobinfo_current(peer, buf)) {
+            msg = peer->nptr->nspace;
+            PMIX_BFROPS_PACK(rc, peer, reply, &msg, 1, PMIX_STRING);
+        } else {
+            PMIX_GDS_REGISTER_JOB_INFO(rc, peer, reply);
+        }
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(reply);
             return rc;
         }
         PMIX_SERVER_QUEUE_REPLY(rc, peer, tag, reply);
@@ -3133,8 +3669,8 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag,
         return rc;
     }
 
-    if (PMIX_COMMIT_CMD == cmd) {
-        rc = pmix_server_commit(peer, buf);
+    if (PMIX_COMMIT_CMD == cmd || PMIX_COMMIT_DELTA_CMD == cmd) {
+        rc = pmix_server_commit(peer, buf, PMIX_COMMIT_DELTA_CMD == cmd);
         if (!PMIX_PROC_IS_V1(peer)) {
             reply = PMIX_NEW(pmix_buffer_t);
             if (NULL == reply) {
@@ -3298,7 +3834,9 @@ static pmix_status_t server_switchyard(pmix_peer_t *peer, uint32_t tag,
 
     if (PMIX_QUERY_CMD == cmd) {
         PMIX_GDS_CADDY(cd, peer, tag);
+        pmix_server_watchdog_query(cd);
         if (PMIX_SUCCESS != (rc = pmix_server_query(peer, buf, query_cbfunc, cd))) {
+            pmix_server_watchdog_query_done(cd);
             PMIX_RELEASE(cd);
         }
         return rc;
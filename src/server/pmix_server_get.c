@@ -46,10 +46,12 @@
 #endif
 #include PMIX_EVENT_HEADER
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/mca/bfrops/bfrops.h"
 #include "src/mca/gds/gds.h"
 #include "src/util/argv.h"
+#include "src/util/counters.h"
 #include "src/util/error.h"
 #include "src/util/output.h"
 #include "src/util/pmix_environ.h"
@@ -87,6 +89,7 @@ static void dmdx_cbfunc(pmix_status_t status, const char *data,
 static pmix_status_t _satisfy_request(pmix_namespace_t *ns, pmix_rank_t rank,
                                       pmix_server_caddy_t *cd,
                                       pmix_modex_cbfunc_t cbfunc, void *cbdata, bool *scope);
+static bool _have_key(pmix_namespace_t *nptr, pmix_rank_t rank, const char *key);
 static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank,
                                           pmix_info_t info[], size_t ninfo,
                                           pmix_modex_cbfunc_t cbfunc,
@@ -95,7 +98,102 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank,
                                           pmix_dmdx_request_t **rq);
 
 static void get_timeout(int sd, short args, void *cbdata);
+static void prefetch_timeout(int sd, short args, void *cbdata);
+static void _prefetch(pmix_namespace_t *nptr, pmix_rank_t rank,
+                      struct timeval *tv);
+
+
+/* outstanding direct modex requests are indexed by the proc
+ * whose data is being requested so that a storm of requests
+ * for the same target can be coalesced without scanning the
+ * entire list. The key is the complete proc struct with any
+ * unused portion of the nspace zeroed */
+static inline void dmdx_key(pmix_proc_t *key, const char *nspace,
+                            pmix_rank_t rank)
+{
+    memset(key, 0, sizeof(pmix_proc_t));
+    pmix_strncpy(key->nspace, nspace, PMIX_MAX_NSLEN);
+    key->rank = rank;
+}
+
+static pmix_dmdx_local_t* dmdx_lookup(const char *nspace, pmix_rank_t rank)
+{
+    pmix_proc_t key;
+    void *ptr;
+
+    dmdx_key(&key, nspace, rank);
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pmix_server_globals.dmdxidx,
+                                                      &key, sizeof(key), &ptr)) {
+        return NULL;
+    }
+    return (pmix_dmdx_local_t*)ptr;
+}
+
+/* the requests for each nspace are also chained together, with
+ * the head of the chain indexed by nspace, so that registration
+ * of an nspace only visits the requests waiting on it */
+static pmix_dmdx_local_t* dmdx_ns_first(const char *nspace)
+{
+    void *ptr;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pmix_server_globals.dmdxns,
+                                                      nspace, strlen(nspace), &ptr)) {
+        return NULL;
+    }
+    return (pmix_dmdx_local_t*)ptr;
+}
 
+void pmix_pending_add(pmix_dmdx_local_t *lcd)
+{
+    pmix_proc_t key;
+    pmix_dmdx_local_t *first;
+
+    pmix_list_append(&pmix_server_globals.local_reqs, &lcd->super);
+    dmdx_key(&key, lcd->proc.nspace, lcd->proc.rank);
+    pmix_hash_table_set_value_ptr(&pmix_server_globals.dmdxidx,
+                                  &key, sizeof(key), lcd);
+    lcd->ns_prev = NULL;
+    lcd->ns_next = first = dmdx_ns_first(lcd->proc.nspace);
+    if (NULL != first) {
+        first->ns_prev = lcd;
+    }
+    pmix_hash_table_set_value_ptr(&pmix_server_globals.dmdxns, lcd->proc.nspace,
+                                  strlen(lcd->proc.nspace), lcd);
+    lcd->indexed = true;
+}
+
+void pmix_pending_remove(pmix_dmdx_local_t *lcd)
+{
+    pmix_proc_t key;
+
+    if (lcd->event_active) {
+        pmix_timer_del(&lcd->timer);
+        lcd->event_active = false;
+    }
+    /* an expired prefetch was already taken off */
+    if (!lcd->indexed) {
+        return;
+    }
+    lcd->indexed = false;
+    dmdx_key(&key, lcd->proc.nspace, lcd->proc.rank);
+    pmix_hash_table_remove_value_ptr(&pmix_server_globals.dmdxidx,
+                                     &key, sizeof(key));
+    if (NULL != lcd->ns_next) {
+        lcd->ns_next->ns_prev = lcd->ns_prev;
+    }
+    if (NULL != lcd->ns_prev) {
+        lcd->ns_prev->ns_next = lcd->ns_next;
+    } else if (NULL != lcd->ns_next) {
+        pmix_hash_table_set_value_ptr(&pmix_server_globals.dmdxns, lcd->proc.nspace,
+                                      strlen(lcd->proc.nspace), lcd->ns_next);
+    } else {
+        pmix_hash_table_remove_value_ptr(&pmix_server_globals.dmdxns, lcd->proc.nspace,
+                                         strlen(lcd->proc.nspace));
+    }
+    lcd->ns_prev = NULL;
+    lcd->ns_next = NULL;
+    pmix_list_remove_item(&pmix_server_globals.local_reqs, &lcd->super);
+}
 
 /* declare a function whose sole purpose is to
  * free data that we provided to our host server
@@ -126,6 +224,7 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
     pmix_dmdx_request_t *req;
     bool local;
     bool localonly = false;
+    char *reqkey = NULL;
     struct timeval tv = {0, 0};
     pmix_buffer_t pbkt, pkt;
     pmix_byte_object_t bo;
@@ -134,6 +233,7 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
     char *data;
     size_t sz, n;
     pmix_peer_t *peer;
+    uint64_t start = pmix_counter_now();
 
     pmix_output_verbose(2, pmix_server_globals.get_output,
                         "recvd GET");
@@ -186,17 +286,14 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
             localonly = PMIX_INFO_TRUE(&info[n]);
         } else if (0 == strncmp(info[n].key, PMIX_TIMEOUT, PMIX_MAX_KEYLEN)) {
             tv.tv_sec = info[n].value.data.uint32;
+        } else if (0 == strncmp(info[n].key, PMIX_GET_REQ_KEY, PMIX_MAX_KEYLEN)) {
+            reqkey = info[n].value.data.string;
         }
     }
 
     /* find the nspace object for this client */
     nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(nspace, ns->nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, nspace);
 
     pmix_output_verbose(2, pmix_server_globals.get_output,
                         "%s:%d EXECUTE GET FOR %s:%d ON BEHALF OF %s:%d",
@@ -226,6 +323,21 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
      * we add the nspace to our list of known nspaces so the
      * info has a "landing zone" upon return */
 
+    /* a group construct may already have given us the endpoint
+     * data of this proc even though we host none of its peers */
+    if (NULL == nptr && PMIX_RANK_WILDCARD != rank &&
+        pmix_server_group_endpt_known(nspace, rank)) {
+        ns = PMIX_NEW(pmix_namespace_t);
+        ns->nspace = strdup(nspace);
+        rc = _satisfy_request(ns, rank, cd, cbfunc, cbdata, NULL);
+        PMIX_RELEASE(ns);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_INFO_FREE(info, ninfo);
+            pmix_counter_time(PMIX_CTR_GET_LOCAL, start);
+            return PMIX_SUCCESS;
+        }
+    }
+
     if (NULL == nptr) {
         if (localonly) {
             /* the user doesn't want us to look for the info,
@@ -250,9 +362,7 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
             /* if they specified a timeout for this specific
              * request, set it up now */
             if (0 < tv.tv_sec) {
-                pmix_event_evtimer_set(pmix_globals.evbase, &req->ev,
-                                       get_timeout, req);
-                pmix_event_evtimer_add(&req->ev, &tv);
+                pmix_timer_add(&req->timer, get_timeout, req, &tv);
                 req->event_active = true;
             }
             /* we already asked for this info - no need to
@@ -271,22 +381,20 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
             rc = pmix_host_server.direct_modex(&lcd->proc, info, ninfo, dmdx_cbfunc, lcd);
             if (PMIX_SUCCESS != rc) {
                 PMIX_INFO_FREE(info, ninfo);
-                pmix_list_remove_item(&pmix_server_globals.local_reqs, &lcd->super);
+                pmix_pending_remove(lcd);
                 PMIX_RELEASE(lcd);
                 return rc;
             }
             /* if they specified a timeout for this specific
              * request, set it up now */
             if (0 < tv.tv_sec) {
-                pmix_event_evtimer_set(pmix_globals.evbase, &req->ev,
-                                       get_timeout, req);
-                pmix_event_evtimer_add(&req->ev, &tv);
+                pmix_timer_add(&req->timer, get_timeout, req, &tv);
                 req->event_active = true;
             }
         } else {
         /* if we don't have direct modex feature, just respond with "not found" */
             PMIX_INFO_FREE(info, ninfo);
-            pmix_list_remove_item(&pmix_server_globals.local_reqs, &lcd->super);
+            pmix_pending_remove(lcd);
             PMIX_RELEASE(lcd);
             return PMIX_ERR_NOT_FOUND;
         }
@@ -347,6 +455,7 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
         /* call the internal callback function - it will
          * release the cbdata */
         cbfunc(PMIX_SUCCESS, data, sz, cbdata, relfn, data);
+        pmix_counter_time(PMIX_CTR_GET_LOCAL, start);
         /* return success so the server doesn't duplicate
          * the release of cbdata */
         return PMIX_SUCCESS;
@@ -386,9 +495,7 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
                             pmix_globals.myid.rank);
         /* if they specified a timeout, set it up now */
         if (0 < tv.tv_sec) {
-            pmix_event_evtimer_set(pmix_globals.evbase, &req->ev,
-                                   get_timeout, req);
-            pmix_event_evtimer_add(&req->ev, &tv);
+            pmix_timer_add(&req->timer, get_timeout, req, &tv);
             req->event_active = true;
         }
         /* the peer object has been added to the new lcd tracker,
@@ -396,11 +503,20 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
         return PMIX_SUCCESS;
     }
 
-    /* if everyone has registered, see if we already have this data */
-    rc = _satisfy_request(nptr, rank, cd, cbfunc, cbdata, &local);
+    /* if everyone has registered, see if we already have this data - a
+     * fence that collected only some keys may have left us without it */
+    if (NULL != reqkey && 0 <= (int)rank &&
+        pmix_bitmap_is_set_bit(&nptr->mdxpart, (int)rank) &&
+        !_have_key(nptr, rank, reqkey)) {
+        local = false;
+        rc = PMIX_ERR_NOT_FOUND;
+    } else {
+        rc = _satisfy_request(nptr, rank, cd, cbfunc, cbdata, &local);
+    }
     if( PMIX_SUCCESS == rc ){
         /* request was successfully satisfied */
         PMIX_INFO_FREE(info, ninfo);
+        pmix_counter_time(PMIX_CTR_GET_LOCAL, start);
         /* return success as the satisfy_request function
          * calls the cbfunc for us, and it will have
          * released the cbdata object */
@@ -422,6 +538,17 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
         return PMIX_ERR_NOT_FOUND;
     }
 
+    /* if the host has already told us that it doesn't have any
+     * data for this proc, then there is no point in asking again */
+    if (0 <= (int)rank && pmix_bitmap_is_set_bit(&nptr->dmdxmiss, (int)rank)) {
+        pmix_output_verbose(2, pmix_server_globals.get_output,
+                            "%s:%d DATA PREVIOUSLY NOT FOUND",
+                            pmix_globals.myid.nspace,
+                            pmix_globals.myid.rank);
+        PMIX_INFO_FREE(info, ninfo);
+        return PMIX_ERR_NOT_FOUND;
+    }
+
     /* Check to see if we already have a pending request for the data - if
      * we do, then we can just wait for it to arrive */
     rc = create_local_tracker(nspace, rank, info, ninfo,
@@ -433,9 +560,7 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
     }
     /* if they specified a timeout, set it up now */
     if (0 < tv.tv_sec) {
-        pmix_event_evtimer_set(pmix_globals.evbase, &req->ev,
-                               get_timeout, req);
-        pmix_event_evtimer_add(&req->ev, &tv);
+        pmix_timer_add(&req->timer, get_timeout, req, &tv);
         req->event_active = true;
     }
     if (PMIX_SUCCESS == rc) {
@@ -462,8 +587,12 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
         if (PMIX_SUCCESS != rc) {
             /* may have a function entry but not support the request */
             PMIX_INFO_FREE(info, ninfo);
-            pmix_list_remove_item(&pmix_server_globals.local_reqs, &lcd->super);
+            pmix_pending_remove(lcd);
             PMIX_RELEASE(lcd);
+        } else {
+            /* the requestor is likely to ask for its neighbours
+             * next, so go ahead and request them now */
+            _prefetch(nptr, rank, &tv);
         }
     } else {
         pmix_output_verbose(2, pmix_server_globals.get_output,
@@ -472,7 +601,7 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
                             pmix_globals.myid.rank);
         /* if we don't have direct modex feature, just respond with "not found" */
         PMIX_INFO_FREE(info, ninfo);
-        pmix_list_remove_item(&pmix_server_globals.local_reqs, &lcd->super);
+        pmix_pending_remove(lcd);
         PMIX_RELEASE(lcd);
         rc = PMIX_ERR_NOT_FOUND;
     }
@@ -480,6 +609,24 @@ pmix_status_t pmix_server_get(pmix_buffer_t *buf,
     return rc;
 }
 
+/* see if we hold the given key of a remote proc */
+static bool _have_key(pmix_namespace_t *nptr, pmix_rank_t rank, const char *key)
+{
+    pmix_cb_t cb;
+    pmix_proc_t proc;
+    pmix_status_t rc;
+
+    PMIX_LOAD_PROCID(&proc, nptr->nspace, rank);
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = &proc;
+    cb.key = (char*)key;
+    cb.scope = PMIX_REMOTE;
+    cb.copy = false;
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+    PMIX_DESTRUCT(&cb);
+    return (PMIX_SUCCESS == rc);
+}
+
 static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank,
                                           pmix_info_t info[], size_t ninfo,
                                           pmix_modex_cbfunc_t cbfunc,
@@ -487,7 +634,7 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank,
                                           pmix_dmdx_local_t **ld,
                                           pmix_dmdx_request_t **rq)
 {
-    pmix_dmdx_local_t *lcd, *cd;
+    pmix_dmdx_local_t *lcd;
     pmix_dmdx_request_t *req;
     pmix_status_t rc;
 
@@ -497,15 +644,7 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank,
 
     /* see if we already have an existing request for data
      * from this namespace/rank */
-    lcd = NULL;
-    PMIX_LIST_FOREACH(cd, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
-        if (0 != strncmp(nspace, cd->proc.nspace, PMIX_MAX_NSLEN) ||
-                rank != cd->proc.rank ) {
-            continue;
-        }
-        lcd = cd;
-        break;
-    }
+    lcd = dmdx_lookup(nspace, rank);
     if (NULL != lcd) {
         /* we already have a request, so just track that someone
          * else wants data from the same target */
@@ -522,7 +661,7 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank,
     lcd->proc.rank = rank;
     lcd->info = info;
     lcd->ninfo = ninfo;
-    pmix_list_append(&pmix_server_globals.local_reqs, &lcd->super);
+    pmix_pending_add(lcd);
     rc = PMIX_ERR_NOT_FOUND;  // indicates that we created a new request tracker
 
   complete:
@@ -543,29 +682,163 @@ static pmix_status_t create_local_tracker(char nspace[], pmix_rank_t rank,
     return rc;
 }
 
+/* get the name of the node hosting the given proc, if known */
+static char* _get_hostname(const char *nspace, pmix_rank_t rank)
+{
+    pmix_status_t rc;
+    pmix_cb_t cb;
+    pmix_proc_t proc;
+    pmix_kval_t *kv;
+    char *hostname = NULL;
+
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    pmix_strncpy(proc.nspace, nspace, PMIX_MAX_NSLEN);
+    proc.rank = rank;
+    cb.proc = &proc;
+    cb.key = PMIX_HOSTNAME;
+    cb.scope = PMIX_INTERNAL;
+    cb.copy = false;
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+    if (PMIX_SUCCESS == rc) {
+        kv = (pmix_kval_t*)pmix_list_get_first(&cb.kvs);
+        if (NULL != kv && NULL != kv->value &&
+            PMIX_STRING == kv->value->type &&
+            NULL != kv->value->data.string) {
+            hostname = strdup(kv->value->data.string);
+        }
+    }
+    PMIX_DESTRUCT(&cb);
+    return hostname;
+}
+
+/* speculatively request the data for ranks neighbouring one whose
+ * data we just had to request from the host. Only ranks hosted on
+ * the same remote node are requested if we know where they are,
+ * as those requests are likely to be serviced by the same remote
+ * server. Nobody is waiting on the prefetched data - it will be
+ * stored upon arrival so we can locally satisfy any later request.
+ * Each prefetch carries the timeout of the get that triggered it,
+ * or the default if that gave none, so the host gives up on it and
+ * we stop treating it as outstanding */
+static void _prefetch(pmix_namespace_t *nptr, pmix_rank_t rank,
+                      struct timeval *tv)
+{
+    pmix_dmdx_local_t *lcd;
+    pmix_proc_t key;
+    pmix_rank_t r;
+    pmix_status_t rc;
+    pmix_cb_t cb;
+    char *hostname, *h;
+    bool skip;
+    int n, dir, tmo;
+    struct timeval ptv = {0, 0};
+
+    if (0 >= pmix_server_globals.get_prefetch ||
+        NULL == pmix_host_server.direct_modex ||
+        0 == nptr->nprocs) {
+        return;
+    }
+    ptv.tv_sec = (0 < tv->tv_sec) ? tv->tv_sec : pmix_server_globals.get_prefetch_timeout;
+    hostname = _get_hostname(nptr->nspace, rank);
+
+    for (n=1; n <= pmix_server_globals.get_prefetch; n++) {
+        for (dir=-1; dir <= 1; dir += 2) {
+            if (0 > dir && rank < (pmix_rank_t)n) {
+                continue;
+            }
+            r = (0 > dir) ? rank - n : rank + n;
+            if (r >= nptr->nprocs) {
+                continue;
+            }
+            /* ignore it if we already asked for it */
+            if (NULL != dmdx_lookup(nptr->nspace, r) ||
+                (0 <= (int)r && pmix_bitmap_is_set_bit(&nptr->dmdxmiss, (int)r))) {
+                continue;
+            }
+            /* local procs will provide their data upon commit */
+            if (NULL != pmix_nspace_find_rank(nptr, r)) {
+                continue;
+            }
+            /* if we know where the original target lives, only
+             * take neighbours from the same node */
+            if (NULL != hostname) {
+                h = _get_hostname(nptr->nspace, r);
+                skip = (NULL == h || 0 != strcmp(h, hostname));
+                if (NULL != h) {
+                    free(h);
+                }
+                if (skip) {
+                    continue;
+                }
+            }
+            /* ignore it if we already have its data */
+            PMIX_CONSTRUCT(&cb, pmix_cb_t);
+            key.rank = r;
+            pmix_strncpy(key.nspace, nptr->nspace, PMIX_MAX_NSLEN);
+            cb.proc = &key;
+            cb.scope = PMIX_REMOTE;
+            cb.copy = false;
+            PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+            PMIX_DESTRUCT(&cb);
+            if (PMIX_SUCCESS == rc) {
+                continue;
+            }
+            /* create a tracker that nobody is waiting on */
+            lcd = PMIX_NEW(pmix_dmdx_local_t);
+            if (NULL == lcd) {
+                break;
+            }
+            pmix_strncpy(lcd->proc.nspace, nptr->nspace, PMIX_MAX_NSLEN);
+            lcd->proc.rank = r;
+            if (0 < ptv.tv_sec) {
+                PMIX_INFO_CREATE(lcd->info, 1);
+                lcd->ninfo = 1;
+                tmo = ptv.tv_sec;
+                PMIX_INFO_LOAD(&lcd->info[0], PMIX_TIMEOUT, &tmo, PMIX_INT);
+            }
+            pmix_pending_add(lcd);
+            pmix_output_verbose(2, pmix_server_globals.get_output,
+                                "%s:%d PREFETCHING DATA FOR %s:%d",
+                                pmix_globals.myid.nspace,
+                                pmix_globals.myid.rank,
+                                nptr->nspace, r);
+            rc = pmix_host_server.direct_modex(&lcd->proc, lcd->info, lcd->ninfo, dmdx_cbfunc, lcd);
+            if (PMIX_SUCCESS == rc && 0 < ptv.tv_sec) {
+                pmix_timer_add(&lcd->timer, prefetch_timeout, lcd, &ptv);
+                lcd->event_active = true;
+            }
+            if (PMIX_SUCCESS != rc) {
+                /* the host won't take it, so don't keep trying */
+                pmix_pending_remove(lcd);
+                PMIX_RELEASE(lcd);
+                goto done;
+            }
+        }
+    }
+
+  done:
+    if (NULL != hostname) {
+        free(hostname);
+    }
+}
+
 void pmix_pending_nspace_requests(pmix_namespace_t *nptr)
 {
     pmix_dmdx_local_t *cd, *cd_next;
     pmix_status_t rc;
 
+    cd = dmdx_ns_first(nptr->nspace);
+
     /* Now that we know all local ranks, go along request list and ask for remote data
      * for the non-local ranks, and resolve all pending requests for local procs
      * that were waiting for registration to complete
      */
-    PMIX_LIST_FOREACH_SAFE(cd, cd_next, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
-        pmix_rank_info_t *info;
-        bool found = false;
-
-        if (0 != strncmp(nptr->nspace, cd->proc.nspace, PMIX_MAX_NSLEN) ) {
-            continue;
-        }
+    for (; NULL != cd; cd = cd_next) {
+        bool found;
 
-        PMIX_LIST_FOREACH(info, &nptr->ranks, pmix_rank_info_t) {
-            if (info->pname.rank == cd->proc.rank) {
-                found = true;  // we will satisy this request upon commit from new proc
-                break;
-            }
-        }
+        cd_next = cd->ns_next;
+        /* we will satisy this request upon commit from new proc */
+        found = (NULL != pmix_nspace_find_rank(nptr, cd->proc.rank));
 
         /* if not found - this is remote process and we need to send
          * corresponding direct modex request */
@@ -581,7 +854,7 @@ void pmix_pending_nspace_requests(pmix_namespace_t *nptr)
                     pmix_list_remove_item(&cd->loc_reqs, &req->super);
                     PMIX_RELEASE(req);
                 }
-                pmix_list_remove_item(&pmix_server_globals.local_reqs, &cd->super);
+                pmix_pending_remove(cd);
                 PMIX_RELEASE(cd);
             }
         }
@@ -627,17 +900,14 @@ static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
         if (PMIX_RANK_WILDCARD != rank) {
             peer = NULL;
             /* see if the requested rank is local */
-            PMIX_LIST_FOREACH(iptr, &nptr->ranks, pmix_rank_info_t) {
-                if (rank == iptr->pname.rank) {
-                    scope = PMIX_LOCAL;
-                    if (0 <= iptr->peerid) {
-                        peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, iptr->peerid);
-                    }
-                    if (NULL == peer) {
-                        /* this rank has not connected yet, so this request needs to be held */
-                        return PMIX_ERR_NOT_FOUND;
-                    }
-                    break;
+            if (NULL != (iptr = pmix_nspace_find_rank(nptr, rank))) {
+                scope = PMIX_LOCAL;
+                if (0 <= iptr->peerid) {
+                    peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, iptr->peerid);
+                }
+                if (NULL == peer) {
+                    /* this rank has not connected yet, so this request needs to be held */
+                    return PMIX_ERR_NOT_FOUND;
                 }
             }
             if (PMIX_LOCAL != scope)  {
@@ -805,7 +1075,7 @@ static pmix_status_t _satisfy_request(pmix_namespace_t *nptr, pmix_rank_t rank,
 pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr, pmix_rank_t rank,
                                    pmix_status_t status, pmix_dmdx_local_t *lcd)
 {
-    pmix_dmdx_local_t *cd, *ptr;
+    pmix_dmdx_local_t *ptr;
     pmix_dmdx_request_t *req;
     pmix_server_caddy_t *scd;
 
@@ -813,14 +1083,7 @@ pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr, pmix_rank_t rank,
     if (NULL == lcd) {
         ptr = NULL;
         if (NULL != nptr) {
-            PMIX_LIST_FOREACH(cd, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
-                if (!PMIX_CHECK_NSPACE(nptr->nspace, cd->proc.nspace) ||
-                        rank != cd->proc.rank) {
-                    continue;
-                }
-                ptr = cd;
-                break;
-            }
+            ptr = dmdx_lookup(nptr->nspace, rank);
         }
         if (NULL == ptr) {
             return PMIX_SUCCESS;
@@ -863,7 +1126,7 @@ pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr, pmix_rank_t rank,
 
   cleanup:
     /* remove all requests to this rank and cleanup the corresponding structure */
-    pmix_list_remove_item(&pmix_server_globals.local_reqs, &ptr->super);
+    pmix_pending_remove(ptr);
     PMIX_RELEASE(ptr);
 
     return PMIX_SUCCESS;
@@ -878,7 +1141,7 @@ static void _process_dmdx_reply(int fd, short args, void *cbdata)
     pmix_rank_info_t *rinfo;
     int32_t cnt;
     pmix_kval_t *kv;
-    pmix_namespace_t *ns, *nptr;
+    pmix_namespace_t *nptr;
     pmix_status_t rc;
     pmix_list_t nspaces;
     pmix_nspace_caddy_t *nm;
@@ -888,6 +1151,7 @@ static void _process_dmdx_reply(int fd, short args, void *cbdata)
     pmix_cb_t cb;
 
     PMIX_ACQUIRE_OBJECT(caddy);
+    pmix_counter_time(PMIX_CTR_GET_DMODEX, caddy->lcd->start);
 
     pmix_output_verbose(2, pmix_server_globals.get_output,
                     "[%s:%d] process dmdx reply from %s:%u",
@@ -896,12 +1160,7 @@ static void _process_dmdx_reply(int fd, short args, void *cbdata)
 
     /* find the nspace object for the proc whose data is being received */
     nptr = NULL;
-    PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-        if (0 == strcmp(caddy->lcd->proc.nspace, ns->nspace)) {
-            nptr = ns;
-            break;
-        }
-    }
+    nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, caddy->lcd->proc.nspace);
 
     if (NULL == nptr) {
         /* We may not have this namespace because there are no local
@@ -910,7 +1169,7 @@ static void _process_dmdx_reply(int fd, short args, void *cbdata)
         nptr = PMIX_NEW(pmix_namespace_t);
         nptr->nspace = strdup(caddy->lcd->proc.nspace);
         /* add to the list */
-        pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+        pmix_nspace_add(&pmix_server_globals.nspaces, nptr);
     }
 
     /* if the request was successfully satisfied, then store the data.
@@ -948,10 +1207,19 @@ static void _process_dmdx_reply(int fd, short args, void *cbdata)
                 pmix_list_append(&nspaces, &nm->super);
             }
         }
+        /* if nobody is waiting on this data, then it was prefetched - store
+         * it under our own GDS so we can satisfy any future requests */
+        if (0 == pmix_list_get_size(&nspaces)) {
+            nm = PMIX_NEW(pmix_nspace_caddy_t);
+            PMIX_RETAIN(pmix_globals.mypeer->nptr);
+            nm->ns = pmix_globals.mypeer->nptr;
+            pmix_list_append(&nspaces, &nm->super);
+        }
         /* now go thru each unique nspace and store the data using its
          * assigned GDS component */
         PMIX_LIST_FOREACH(nm, &nspaces, pmix_nspace_caddy_t) {
-            if (NULL == nm->ns->compat.gds || 0 == nm->ns->nlocalprocs) {
+            if (NULL == nm->ns->compat.gds || 0 == nm->ns->nlocalprocs ||
+                nm->ns == pmix_globals.mypeer->nptr) {
                 peer = pmix_globals.mypeer;
             } else {
                 /* there must be at least one local proc */
@@ -1025,6 +1293,18 @@ static void _process_dmdx_reply(int fd, short args, void *cbdata)
     }
 
   complete:
+    /* remember that the host has no data for this proc so that
+     * repeated requests can be answered locally */
+    if (PMIX_ERR_NOT_FOUND == caddy->status &&
+        0 <= (int)caddy->lcd->proc.rank) {
+        pmix_bitmap_set_bit(&nptr->dmdxmiss, (int)caddy->lcd->proc.rank);
+    }
+    /* we now hold all of this proc's data, not just what
+     * a fence collected */
+    if (PMIX_SUCCESS == caddy->status &&
+        0 <= (int)caddy->lcd->proc.rank) {
+        pmix_bitmap_clear_bit(&nptr->mdxpart, (int)caddy->lcd->proc.rank);
+    }
     /* always execute the callback to avoid having the client hang */
     pmix_pending_resolve(nptr, caddy->lcd->proc.rank, caddy->status, caddy->lcd);
 
@@ -1079,3 +1359,24 @@ static void get_timeout(int sd, short args, void *cbdata)
     pmix_list_remove_item(&req->lcd->loc_reqs, &req->super);
     PMIX_RELEASE(req);
 }
+
+static void prefetch_timeout(int sd, short args, void *cbdata)
+{
+    pmix_dmdx_local_t *lcd = (pmix_dmdx_local_t*)cbdata;
+
+    lcd->event_active = false;
+    /* anyone who has since asked for it has their own timer */
+    if (0 < pmix_list_get_size(&lcd->loc_reqs)) {
+        return;
+    }
+    pmix_output_verbose(2, pmix_server_globals.get_output,
+                        "%s:%d PREFETCH FOR %s:%d TIMED OUT",
+                        pmix_globals.myid.nspace,
+                        pmix_globals.myid.rank,
+                        lcd->proc.nspace, lcd->proc.rank);
+    /* stop matching new requests against it. The host still
+     * holds it as the cbdata of its request, so it is released
+     * when the host answers - which it must, as it was given
+     * the timeout too */
+    pmix_pending_remove(lcd);
+}
@@ -49,15 +49,22 @@
 #ifdef HAVE_TIME_H
 #include <time.h>
 #endif
+#include <signal.h>
 #include PMIX_EVENT_HEADER
 
 #include "src/class/pmix_hotel.h"
 #include "src/class/pmix_list.h"
+#include "src/event/pmix_event_ring.h"
 #include "src/mca/bfrops/bfrops.h"
+#include "src/mca/bfrops/base/base.h"
+#include "src/mca/gds/base/base.h"
 #include "src/mca/plog/plog.h"
 #include "src/mca/psensor/psensor.h"
 #include "src/util/argv.h"
+#include "src/util/compress.h"
+#include "src/util/counters.h"
 #include "src/util/error.h"
+#include "src/util/name_fns.h"
 #include "src/util/output.h"
 #include "src/util/pmix_environ.h"
 
@@ -137,11 +144,11 @@ pmix_status_t pmix_server_abort(pmix_peer_t *peer, pmix_buffer_t *buf,
     return rc;
 }
 
-pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
+pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf, bool delta)
 {
     int32_t cnt;
     pmix_status_t rc;
-    pmix_buffer_t b2, pbkt;
+    pmix_buffer_t b2, pbkt, mdx, lbkt, *batch;
     pmix_kval_t *kp;
     pmix_scope_t scope;
     pmix_namespace_t *nptr;
@@ -149,7 +156,7 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
     pmix_proc_t proc;
     pmix_dmdx_remote_t *dcd, *dcdnext;
     char *data;
-    size_t sz;
+    size_t sz, hdr;
     pmix_cb_t cb;
 
     /* shorthand */
@@ -164,6 +171,21 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
                         pmix_globals.myid.rank,
                         nptr->nspace, info->pname.rank);
 
+    /* the client sends either its complete set of values or,
+     * for a delta, just those changed since its last commit. We
+     * assemble its contribution to any collective fence as we
+     * go - this saves us from having to fetch and repack the
+     * data when the fence completes. We pack it in our native
+     * BFROPS form as it will be sent to other daemons */
+    PMIX_CONSTRUCT(&mdx, pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &mdx, &proc, 1, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&mdx);
+        return rc;
+    }
+    hdr = mdx.bytes_used;
+
     /* this buffer will contain one or more buffers, each
      * representing a different scope. These need to be locally
      * stored separately so we can provide required data based
@@ -178,8 +200,34 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
         PMIX_BFROPS_UNPACK(rc, peer, buf, &b2, &cnt, PMIX_BUFFER);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&mdx);
             return rc;
         }
+        /* a GDS that can take the whole set for this proc in one
+         * store gets it that way. Values that only go to local
+         * procs need nothing else from us, so if the client
+         * packed them in our own form they are passed straight
+         * through without being unpacked here */
+        batch = NULL;
+        if ((PMIX_LOCAL == scope || PMIX_GLOBAL == scope) &&
+            NULL != peer->nptr->compat.gds->store_buf) {
+            if (PMIX_LOCAL == scope &&
+                peer->nptr->compat.bfrops == pmix_globals.mypeer->nptr->compat.bfrops &&
+                peer->nptr->compat.type == pmix_globals.mypeer->nptr->compat.type) {
+                PMIX_GDS_STORE_BUF(rc, peer, &proc, scope, &b2);
+                PMIX_DESTRUCT(&b2);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    PMIX_DESTRUCT(&mdx);
+                    return rc;
+                }
+                cnt = 1;
+                PMIX_BFROPS_UNPACK(rc, peer, buf, &scope, &cnt, PMIX_SCOPE);
+                continue;
+            }
+            PMIX_CONSTRUCT(&lbkt, pmix_buffer_t);
+            batch = &lbkt;
+        }
         /* unpack the buffer and store the values - we store them
          * in this peer's native GDS component so that other local
          * procs from that nspace can access it */
@@ -187,12 +235,23 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
         cnt = 1;
         PMIX_BFROPS_UNPACK(rc, peer, &b2, kp, &cnt, PMIX_KVAL);
         while (PMIX_SUCCESS == rc) {
-            if( PMIX_LOCAL == scope || PMIX_GLOBAL == scope){
+            if (NULL != batch) {
+                PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, batch, kp, 1, PMIX_KVAL);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    PMIX_RELEASE(kp);
+                    PMIX_DESTRUCT(&lbkt);
+                    PMIX_DESTRUCT(&b2);
+                    PMIX_DESTRUCT(&mdx);
+                    return rc;
+                }
+            } else if (PMIX_LOCAL == scope || PMIX_GLOBAL == scope) {
                 PMIX_GDS_STORE_KV(rc, peer, &proc, scope, kp);
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
                     PMIX_RELEASE(kp);
                     PMIX_DESTRUCT(&b2);
+                    PMIX_DESTRUCT(&mdx);
                     return rc;
                 }
             }
@@ -201,7 +260,22 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
                     PMIX_RELEASE(kp);
+                    if (NULL != batch) {
+                        PMIX_DESTRUCT(&lbkt);
+                    }
+                    PMIX_DESTRUCT(&b2);
+                    PMIX_DESTRUCT(&mdx);
+                    return rc;
+                }
+                PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &mdx, kp, 1, PMIX_KVAL);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    PMIX_RELEASE(kp);
+                    if (NULL != batch) {
+                        PMIX_DESTRUCT(&lbkt);
+                    }
                     PMIX_DESTRUCT(&b2);
+                    PMIX_DESTRUCT(&mdx);
                     return rc;
                 }
             }
@@ -215,18 +289,52 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
         PMIX_DESTRUCT(&b2);
         if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
             PMIX_ERROR_LOG(rc);
+            if (NULL != batch) {
+                PMIX_DESTRUCT(&lbkt);
+            }
+            PMIX_DESTRUCT(&mdx);
             return rc;
         }
+        if (NULL != batch) {
+            PMIX_GDS_STORE_BUF(rc, peer, &proc, scope, batch);
+            PMIX_DESTRUCT(&lbkt);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_DESTRUCT(&mdx);
+                return rc;
+            }
+        }
         cnt = 1;
         PMIX_BFROPS_UNPACK(rc, peer, buf, &scope, &cnt, PMIX_SCOPE);
     }
     if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
         PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&mdx);
         return rc;
     }
     rc = PMIX_SUCCESS;
     /* mark us as having successfully received a blob from this proc */
     info->modex_recvd = true;
+    if (delta && NULL != info->modex.bytes) {
+        /* add the changes to the prior contribution - the values
+         * are stored in order wherever it is unpacked, so a key
+         * given again here replaces its earlier value */
+        if (hdr < mdx.bytes_used) {
+            data = (char*)realloc(info->modex.bytes, info->modex.size + mdx.bytes_used - hdr);
+            if (NULL == data) {
+                PMIX_DESTRUCT(&mdx);
+                return PMIX_ERR_NOMEM;
+            }
+            memcpy(data + info->modex.size, mdx.base_ptr + hdr, mdx.bytes_used - hdr);
+            info->modex.bytes = data;
+            info->modex.size += mdx.bytes_used - hdr;
+        }
+    } else {
+        /* replace any prior contribution with the new one */
+        PMIX_BYTE_OBJECT_DESTRUCT(&info->modex);
+        PMIX_UNLOAD_BUFFER(&mdx, info->modex.bytes, info->modex.size);
+    }
+    PMIX_DESTRUCT(&mdx);
 
     /* update the commit counter */
     peer->commit_cnt++;
@@ -276,6 +384,227 @@ pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf)
     return rc;
 }
 
+/* compute a digest identifying a collective. Collective operations
+ * are uniquely identified by the set of participating processes and
+ * the type of collective, or by the operation ID. The procs may be
+ * given in different order by each participant, so the digest is
+ * formed as an order-independent sum of the individual proc hashes.
+ * Note that the collect flag is deliberately not included - callers
+ * that disagree on it must land on the same tracker so the mismatch
+ * can be reported */
+static inline uint64_t trk_mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static inline uint64_t trk_strhash(const char *str, uint64_t h)
+{
+    while ('\0' != *str) {
+        h ^= (unsigned char)*str++;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static uint64_t trk_digest(char *id, pmix_proc_t *procs,
+                           size_t nprocs, pmix_cmd_t type)
+{
+    uint64_t digest, nshash = 0;
+    size_t i;
+    char *ns = NULL;
+
+    if (NULL != id) {
+        /* the ID alone identifies the operation */
+        return trk_mix(trk_strhash(id, 0xcbf29ce484222325ULL));
+    }
+
+    digest = trk_mix(((uint64_t)type << 56) ^ (uint64_t)nprocs);
+    for (i=0; i < nprocs; i++) {
+        /* procs are usually grouped by nspace, so avoid
+         * rehashing the same nspace over and over */
+        if (NULL == ns || 0 != strcmp(ns, procs[i].nspace)) {
+            ns = procs[i].nspace;
+            nshash = trk_strhash(ns, 0xcbf29ce484222325ULL);
+        }
+        digest += trk_mix(nshash ^ ((uint64_t)procs[i].rank * 0x9e3779b97f4a7c15ULL));
+    }
+    return digest;
+}
+
+/* check if the given tracker corresponds to the collective */
+static bool trk_match(pmix_server_trkr_t *trk, char *id,
+                      pmix_proc_t *procs, size_t nprocs,
+                      pmix_cmd_t type)
+{
+    size_t i, j;
+    size_t matches;
+
+    if (NULL != id) {
+        return (NULL != trk->id && 0 == strcmp(id, trk->id));
+    }
+    if (nprocs != trk->npcs) {
+        return false;
+    }
+    if (type != trk->type) {
+        return false;
+    }
+    /* participants typically provide the procs in the same
+     * order, so check for that first */
+    for (i=0; i < nprocs; i++) {
+        if (procs[i].rank != trk->pcs[i].rank ||
+            0 != strcmp(procs[i].nspace, trk->pcs[i].nspace)) {
+            break;
+        }
+    }
+    if (nprocs == i) {
+        return true;
+    }
+    matches = 0;
+    for (i=0; i < nprocs; i++) {
+        /* the procs may be in different order, so we have
+         * to do an exhaustive search */
+        for (j=0; j < trk->npcs; j++) {
+            if (0 == strcmp(procs[i].nspace, trk->pcs[j].nspace) &&
+                procs[i].rank == trk->pcs[j].rank) {
+                ++matches;
+                break;
+            }
+        }
+    }
+    return (trk->npcs == matches);
+}
+
+/* add a tracker to the list of active collectives, indexing it
+ * by its digest if that slot is available */
+static void trk_add(pmix_server_trkr_t *trk, char *id,
+                    pmix_proc_t *procs, size_t nprocs)
+{
+    void *ptr;
+
+    trk->digest = trk_digest(id, procs, nprocs, trk->type);
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint64(&pmix_server_globals.trkidx,
+                                                         trk->digest, &ptr)) {
+        pmix_hash_table_set_value_uint64(&pmix_server_globals.trkidx,
+                                         trk->digest, trk);
+        trk->indexed = true;
+    } else {
+        ++pmix_server_globals.nunindexed;
+    }
+    pmix_list_append(&pmix_server_globals.collectives, &trk->super);
+}
+
+void pmix_server_trk_remove(pmix_server_trkr_t *trk)
+{
+    pmix_server_caddy_t *cd;
+
+    pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+    if (trk->indexed) {
+        pmix_hash_table_remove_value_uint64(&pmix_server_globals.trkidx,
+                                            trk->digest);
+        trk->indexed = false;
+    } else {
+        --pmix_server_globals.nunindexed;
+    }
+    /* the tracker is done - a participant that now goes away has
+     * nothing to account for, and the caddies may well outlive the
+     * tracker's last reference, so drop them from their peers */
+    PMIX_LIST_FOREACH(cd, &trk->local_cbs, pmix_server_caddy_t) {
+        if (NULL != cd->ref) {
+            pmix_list_remove_item(&cd->peer->collectives, &cd->ref->super);
+            PMIX_RELEASE(cd->ref);
+            cd->ref = NULL;
+        }
+    }
+}
+
+void pmix_server_trk_add_local(pmix_server_trkr_t *trk, pmix_server_caddy_t *cd)
+{
+    pmix_list_append(&trk->local_cbs, &cd->super);
+    ++trk->local_cnt;
+    cd->member = trk;
+    cd->ref = PMIX_NEW(pmix_peer_ref_t);
+    cd->ref->member = cd;
+    pmix_list_append(&cd->peer->collectives, &cd->ref->super);
+}
+
+void pmix_server_trk_del_local(pmix_server_caddy_t *cd)
+{
+    if (NULL == cd->member) {
+        return;
+    }
+    pmix_list_remove_item(&cd->member->local_cbs, &cd->super);
+    --cd->member->local_cnt;
+    cd->member = NULL;
+    if (NULL != cd->ref) {
+        pmix_list_remove_item(&cd->peer->collectives, &cd->ref->super);
+        PMIX_RELEASE(cd->ref);
+        cd->ref = NULL;
+    }
+}
+
+void pmix_server_reg_add_peer(pmix_regevents_info_t *reg, pmix_peer_events_info_t *prev)
+{
+    pmix_list_append(&reg->peers, &prev->super);
+    if (0 <= prev->peer->index) {
+        pmix_bitmap_set_bit(&reg->members, prev->peer->index);
+    }
+    prev->reg = reg;
+    prev->ref = PMIX_NEW(pmix_peer_ref_t);
+    prev->ref->member = prev;
+    pmix_list_append(&prev->peer->evregs, &prev->ref->super);
+}
+
+void pmix_server_reg_del_peer(pmix_peer_events_info_t *prev)
+{
+    if (NULL == prev->reg) {
+        return;
+    }
+    pmix_list_remove_item(&prev->reg->peers, &prev->super);
+    if (0 <= prev->peer->index) {
+        pmix_bitmap_clear_bit(&prev->reg->members, prev->peer->index);
+    }
+    prev->reg = NULL;
+    pmix_list_remove_item(&prev->peer->evregs, &prev->ref->super);
+    PMIX_RELEASE(prev->ref);
+    prev->ref = NULL;
+}
+
+pmix_regevents_info_t* pmix_server_reg_lookup(int code)
+{
+    pmix_regevents_info_t *reg;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_uint32(&pmix_server_globals.evidx,
+                                                         (uint32_t)code, (void**)&reg)) {
+        return NULL;
+    }
+    return reg;
+}
+
+pmix_regevents_info_t* pmix_server_reg_create(int code)
+{
+    pmix_regevents_info_t *reg;
+
+    if (NULL == (reg = PMIX_NEW(pmix_regevents_info_t))) {
+        return NULL;
+    }
+    reg->code = code;
+    pmix_list_append(&pmix_server_globals.events, &reg->super);
+    pmix_hash_table_set_value_uint32(&pmix_server_globals.evidx, (uint32_t)code, reg);
+    return reg;
+}
+
+void pmix_server_reg_remove(pmix_regevents_info_t *reg)
+{
+    pmix_hash_table_remove_value_uint32(&pmix_server_globals.evidx, (uint32_t)reg->code);
+    pmix_list_remove_item(&pmix_server_globals.events, &reg->super);
+    PMIX_RELEASE(reg);
+}
+
 /* get an existing object for tracking LOCAL participation in a collective
  * operation such as "fence". The only way this function can be
  * called is if at least one local client process is participating
@@ -296,8 +625,8 @@ static pmix_server_trkr_t* get_tracker(char *id, pmix_proc_t *procs,
                                        size_t nprocs, pmix_cmd_t type)
 {
     pmix_server_trkr_t *trk;
-    size_t i, j;
-    size_t matches;
+    uint64_t digest;
+    void *ptr;
 
     pmix_output_verbose(5, pmix_server_globals.base_output,
                         "get_tracker called with %d procs", (int)nprocs);
@@ -308,43 +637,29 @@ static pmix_server_trkr_t* get_tracker(char *id, pmix_proc_t *procs,
         return NULL;
     }
 
-    /* there is no shortcut way to search the trackers - all
-     * we can do is perform a brute-force search. Fortunately,
-     * it is highly unlikely that there will be more than one
-     * or two active at a time, and they are most likely to
-     * involve only a single proc with WILDCARD rank - so this
-     * shouldn't take long */
+    /* look for the tracker in the index of active collectives - we
+     * still have to check that the participants match in case
+     * two different collectives happen to yield the same digest */
+    digest = trk_digest(id, procs, nprocs, type);
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint64(&pmix_server_globals.trkidx,
+                                                         digest, &ptr)) {
+        trk = (pmix_server_trkr_t*)ptr;
+        if (trk_match(trk, id, procs, nprocs, type)) {
+            return trk;
+        }
+    }
+
+    /* if every active tracker is in the index, then we are done */
+    if (0 == pmix_server_globals.nunindexed) {
+        return NULL;
+    }
+
+    /* otherwise, we have to perform a brute-force search of
+     * the trackers that could not be indexed. Fortunately, this
+     * only happens when two active collectives collide in the index */
     PMIX_LIST_FOREACH(trk, &pmix_server_globals.collectives, pmix_server_trkr_t) {
-        /* Collective operation if unique identified by
-         * the set of participating processes and the type of collective,
-         * or by the operation ID
-         */
-        if (NULL != id) {
-            if (NULL != trk->id && 0 == strcmp(id, trk->id)) {
-                return trk;
-            }
-        } else {
-            if (nprocs != trk->npcs) {
-                continue;
-            }
-            if (type != trk->type) {
-                continue;
-            }
-            matches = 0;
-            for (i=0; i < nprocs; i++) {
-                /* the procs may be in different order, so we have
-                 * to do an exhaustive search */
-                for (j=0; j < trk->npcs; j++) {
-                    if (0 == strcmp(procs[i].nspace, trk->pcs[j].nspace) &&
-                        procs[i].rank == trk->pcs[j].rank) {
-                        ++matches;
-                        break;
-                    }
-                }
-            }
-            if (trk->npcs == matches) {
-                return trk;
-            }
+        if (!trk->indexed && trk_match(trk, id, procs, nprocs, type)) {
+            return trk;
         }
     }
     /* No tracker was found */
@@ -373,7 +688,7 @@ static pmix_server_trkr_t* new_tracker(char *id, pmix_proc_t *procs,
     pmix_server_trkr_t *trk;
     size_t i;
     bool all_def;
-    pmix_namespace_t *nptr, *ns;
+    pmix_namespace_t *nptr;
     pmix_rank_info_t *info;
 
     pmix_output_verbose(5, pmix_server_globals.base_output,
@@ -415,6 +730,9 @@ static pmix_server_trkr_t* new_tracker(char *id, pmix_proc_t *procs,
 
     all_def = true;
     for (i=0; i < nprocs; i++) {
+        if (0 < i && 0 != strncmp(procs[i].nspace, procs[0].nspace, PMIX_MAX_NSLEN)) {
+            trk->multi_ns = true;
+        }
         if (NULL == id) {
             pmix_strncpy(trk->pcs[i].nspace, procs[i].nspace, PMIX_MAX_NSLEN);
             trk->pcs[i].rank = procs[i].rank;
@@ -424,12 +742,7 @@ static pmix_server_trkr_t* new_tracker(char *id, pmix_proc_t *procs,
         }
         /* is this nspace known to us? */
         nptr = NULL;
-        PMIX_LIST_FOREACH(ns, &pmix_server_globals.nspaces, pmix_namespace_t) {
-            if (0 == strcmp(procs[i].nspace, ns->nspace)) {
-                nptr = ns;
-                break;
-            }
-        }
+        nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, procs[i].nspace);
         if (NULL == nptr) {
             /* cannot be a local proc */
             pmix_output_verbose(5, pmix_server_globals.base_output,
@@ -449,25 +762,28 @@ static pmix_server_trkr_t* new_tracker(char *id, pmix_proc_t *procs,
              * to setup the trk->pcs array, so don't break out
              * of the loop */
         }
+        /* if all ranks are included, then all of my local ranks from
+         * this nspace participate - no need to walk the list */
+        if (PMIX_RANK_WILDCARD == procs[i].rank) {
+            pmix_output_verbose(5, pmix_server_globals.base_output,
+                                "adding %d local procs from %s to tracker",
+                                (int)pmix_list_get_size(&nptr->ranks), nptr->nspace);
+            trk->nlocal += pmix_list_get_size(&nptr->ranks);
+            continue;
+        }
         /* is this one of my local ranks? */
-        PMIX_LIST_FOREACH(info, &nptr->ranks, pmix_rank_info_t) {
-            if (procs[i].rank == info->pname.rank ||
-                PMIX_RANK_WILDCARD == procs[i].rank) {
-                    pmix_output_verbose(5, pmix_server_globals.base_output,
-                                        "adding local proc %s.%d to tracker",
-                                        info->pname.nspace, info->pname.rank);
-                /* track the count */
-                ++trk->nlocal;
-                if (PMIX_RANK_WILDCARD != procs[i].rank) {
-                    break;
-                }
-            }
+        if (NULL != (info = pmix_nspace_find_rank(nptr, procs[i].rank))) {
+            pmix_output_verbose(5, pmix_server_globals.base_output,
+                                "adding local proc %s.%d to tracker",
+                                info->pname.nspace, info->pname.rank);
+            /* track the count */
+            ++trk->nlocal;
         }
     }
     if (all_def) {
         trk->def_complete = true;
     }
-    pmix_list_append(&pmix_server_globals.collectives, &trk->super);
+    trk_add(trk, id, procs, nprocs);
     return trk;
 }
 
@@ -485,104 +801,253 @@ static void fence_timeout(int sd, short args, void *cbdata)
     }
     cd->event_active = false;
     /* remove it from the list */
-    pmix_list_remove_item(&cd->trk->local_cbs, &cd->super);
+    pmix_server_trk_del_local(cd);
     PMIX_RELEASE(cd);
 }
 
-static pmix_status_t _collect_data(pmix_server_trkr_t *trk,
-                                   pmix_buffer_t *buf)
+bool pmix_server_collect_key(pmix_server_trkr_t *trk, const char *key)
+{
+    size_t n;
+
+    if (NULL == trk->collect_keys) {
+        return true;
+    }
+    for (n=0; NULL != trk->collect_keys[n]; n++) {
+        if (0 == strncmp(trk->collect_keys[n], key, PMIX_MAX_KEYLEN)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* check a participant's PMIX_COLLECT_KEYS against the list the
+ * tracker was created with */
+static bool _same_keys(char **keys, const char *ckeys)
+{
+    char **tmp;
+    bool same;
+    size_t n;
+
+    if (NULL == keys || NULL == ckeys) {
+        return (NULL == keys && NULL == ckeys);
+    }
+    tmp = pmix_argv_split(ckeys, ',');
+    same = (NULL != tmp);
+    for (n=0; same && (NULL != keys[n] || NULL != tmp[n]); n++) {
+        same = (NULL != keys[n] && NULL != tmp[n] && 0 == strcmp(keys[n], tmp[n]));
+    }
+    pmix_argv_free(tmp);
+    return same;
+}
+
+/* add the remote/global contribution of the given peer to
+ * the tracker's running collection of local data - this is
+ * done as each participant arrives so that the assembled
+ * payload is ready for the host as soon as the last local
+ * participant calls in */
+static pmix_status_t _add_contribution(pmix_server_trkr_t *trk,
+                                       pmix_peer_t *peer)
 {
-    pmix_buffer_t bucket, pbkt;
+    pmix_buffer_t pbkt;
     pmix_cb_t cb;
     pmix_kval_t *kv;
     pmix_byte_object_t bo;
-    unsigned char tmp = (unsigned char)trk->collect_type;
-    pmix_server_caddy_t *scd;
     pmix_proc_t pcs;
     pmix_status_t rc;
 
+    /* if the contribution was assembled when the proc
+     * committed its data, then just pass it along - unless
+     * only some of its keys are wanted */
+    if (NULL != peer->info->modex.bytes && NULL == trk->collect_keys) {
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &trk->bucket,
+                         &peer->info->modex, 1, PMIX_BYTE_OBJECT);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+        }
+        return rc;
+    }
+    /* get any remote contribution - note that there
+     * may not be a contribution */
+    pmix_strncpy(pcs.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
+    pcs.rank = peer->info->pname.rank;
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = &pcs;
+    cb.scope = PMIX_REMOTE;
+    cb.copy = true;
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+    if (PMIX_SUCCESS != rc) {
+        /* nothing to contribute */
+        PMIX_DESTRUCT(&cb);
+        return PMIX_SUCCESS;
+    }
+    PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
+    /* pack the proc so we know the source */
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &pbkt,
+                     &pcs, 1, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&cb);
+        PMIX_DESTRUCT(&pbkt);
+        return rc;
+    }
+    /* pack the returned kval's */
+    PMIX_LIST_FOREACH(kv, &cb.kvs, pmix_kval_t) {
+        if (!pmix_server_collect_key(trk, kv->key)) {
+            continue;
+        }
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &pbkt, kv, 1, PMIX_KVAL);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DESTRUCT(&cb);
+            PMIX_DESTRUCT(&pbkt);
+            return rc;
+        }
+    }
+    PMIX_DESTRUCT(&cb);
+    /* extract the blob */
+    PMIX_UNLOAD_BUFFER(&pbkt, bo.bytes, bo.size);
+    PMIX_DESTRUCT(&pbkt);
+    /* pack the returned blob */
+    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &trk->bucket,
+                     &bo, 1, PMIX_BYTE_OBJECT);
+    PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    return rc;
+}
+
+static pmix_status_t _collect_data(pmix_server_trkr_t *trk,
+                                   pmix_buffer_t *buf)
+{
+    pmix_buffer_t bucket;
+    pmix_byte_object_t bo;
+    unsigned char tmp = (unsigned char)trk->collect_type;
+    uint8_t *zbytes = NULL;
+    size_t zsize = 0;
+    pmix_status_t rc;
+
     PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
+
+    /* if the contributions are large, pass them as a single
+     * compressed block and flag that in the marker */
+    if (0 < pmix_server_globals.fence_compress &&
+        PMIX_COLLECT_YES == trk->collect_type &&
+        (size_t)pmix_server_globals.fence_compress < trk->bucket.bytes_used &&
+        pmix_util_compress_block((uint8_t*)trk->bucket.unpack_ptr,
+                                 trk->bucket.pack_ptr - trk->bucket.unpack_ptr,
+                                 &zbytes, &zsize)) {
+        pmix_output_verbose(2, pmix_server_globals.fence_output,
+                            "fence - compressed %lu bytes of data to %lu",
+                            (unsigned long)trk->bucket.bytes_used,
+                            (unsigned long)zsize);
+        tmp |= PMIX_COLLECT_COMPRESSED;
+    }
+
+    /* size the bucket once for the marker plus the accumulated
+     * contributions so the copy below doesn't have to grow it */
+    rc = pmix_bfrops_base_reserve(&bucket, pmix_bfrops_base_sizeof(&tmp, 1, PMIX_BYTE) +
+                                           ((NULL == zbytes) ? trk->bucket.bytes_used :
+                                            zsize + pmix_bfrops_base_sizeof(&bo, 0, PMIX_BYTE_OBJECT)));
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
     /* mark the collection type so we can check on the
      * receiving end that all participants did the same */
     PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket,
                      &tmp, 1, PMIX_BYTE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
 
-    if (PMIX_COLLECT_YES == trk->collect_type) {
+    if (NULL != zbytes) {
+        bo.bytes = (char*)zbytes;
+        bo.size = zsize;
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket,
+                         &bo, 1, PMIX_BYTE_OBJECT);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto cleanup;
+        }
+    } else if (PMIX_COLLECT_YES == trk->collect_type &&
+        0 < trk->bucket.bytes_used) {
         pmix_output_verbose(2, pmix_server_globals.fence_output,
                             "fence - assembling data");
-        PMIX_LIST_FOREACH(scd, &trk->local_cbs, pmix_server_caddy_t) {
-            /* get any remote contribution - note that there
-             * may not be a contribution */
-            pmix_strncpy(pcs.nspace, scd->peer->info->pname.nspace, PMIX_MAX_NSLEN);
-            pcs.rank = scd->peer->info->pname.rank;
-            PMIX_CONSTRUCT(&cb, pmix_cb_t);
-            cb.proc = &pcs;
-            cb.scope = PMIX_REMOTE;
-            cb.copy = true;
-            PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
-            if (PMIX_SUCCESS == rc) {
-                PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
-                /* pack the proc so we know the source */
-                PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &pbkt,
-                                 &pcs, 1, PMIX_PROC);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DESTRUCT(&cb);
-                    PMIX_DESTRUCT(&pbkt);
-                    goto cleanup;
-                }
-                /* pack the returned kval's */
-                PMIX_LIST_FOREACH(kv, &cb.kvs, pmix_kval_t) {
-                    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &pbkt, kv, 1, PMIX_KVAL);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_DESTRUCT(&cb);
-                        PMIX_DESTRUCT(&pbkt);
-                        goto cleanup;
-                    }
-                }
-                /* extract the blob */
-                PMIX_UNLOAD_BUFFER(&pbkt, bo.bytes, bo.size);
-                PMIX_DESTRUCT(&pbkt);
-                /* pack the returned blob */
-                PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &bucket,
-                                 &bo, 1, PMIX_BYTE_OBJECT);
-                PMIX_BYTE_OBJECT_DESTRUCT(&bo);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DESTRUCT(&cb);
-                    goto cleanup;
-                }
-            }
-            PMIX_DESTRUCT(&cb);
+        /* the contributions were accumulated as the
+         * participants arrived, so just transfer them */
+        PMIX_BFROPS_COPY_PAYLOAD(rc, pmix_globals.mypeer, &bucket, &trk->bucket);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto cleanup;
         }
     }
     /* because the remote servers have to unpack things
      * in chunks, we have to pack the bucket as a single
      * byte object to allow remote unpack */
     PMIX_UNLOAD_BUFFER(&bucket, bo.bytes, bo.size);
-    PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf,
-                     &bo, 1, PMIX_BYTE_OBJECT);
+    rc = pmix_bfrops_base_reserve(buf, pmix_bfrops_base_sizeof(&bo, 1, PMIX_BYTE_OBJECT));
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, buf,
+                         &bo, 1, PMIX_BYTE_OBJECT);
+    }
     PMIX_BYTE_OBJECT_DESTRUCT(&bo);  // releases the data
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
     }
 
   cleanup:
+    if (NULL != zbytes) {
+        free(zbytes);
+    }
     PMIX_DESTRUCT(&bucket);
     return rc;
 }
 
-pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
-                                pmix_buffer_t *buf,
-                                pmix_modex_cbfunc_t modexcbfunc,
-                                pmix_op_cbfunc_t opcbfunc)
+/* if we were told how the host should run collectives among the
+ * servers, and the caller didn't say, pass that along */
+static void _add_algo(pmix_server_trkr_t *trk)
+{
+    pmix_info_t *iptr;
+    size_t n;
+
+    if (NULL == pmix_server_globals.collective_algo) {
+        return;
+    }
+    for (n=0; n < trk->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&trk->info[n], PMIX_COLLECTIVE_ALGO)) {
+            return;
+        }
+    }
+    PMIX_INFO_CREATE(iptr, trk->ninfo + 1);
+    if (NULL == iptr) {
+        return;
+    }
+    for (n=0; n < trk->ninfo; n++) {
+        PMIX_INFO_XFER(&iptr[n], &trk->info[n]);
+    }
+    PMIX_INFO_LOAD(&iptr[trk->ninfo], PMIX_COLLECTIVE_ALGO,
+                   pmix_server_globals.collective_algo, PMIX_STRING);
+    if (NULL != trk->info) {
+        PMIX_INFO_FREE(trk->info, trk->ninfo);
+    }
+    trk->info = iptr;
+    trk->ninfo = n + 1;
+}
+
+pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
+                                pmix_buffer_t *buf,
+                                pmix_modex_cbfunc_t modexcbfunc,
+                                pmix_op_cbfunc_t opcbfunc)
 {
     int32_t cnt;
+    int rank;
     pmix_status_t rc;
     size_t nprocs;
     pmix_proc_t *procs=NULL, *newprocs;
     bool collect_data = false;
+    char *ckeys = NULL;
     pmix_server_trkr_t *trk;
     char *data = NULL;
     size_t sz = 0;
@@ -602,9 +1067,8 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
         return PMIX_ERR_NOT_SUPPORTED;
     }
 
-    /* unpack the number of procs */
-    cnt = 1;
-    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &nprocs, &cnt, PMIX_SIZE);
+    /* unpack the procs - these may come as rank ranges */
+    rc = pmix_bfrops_base_unpack_procset(cd->peer, buf, &procs, &nprocs);
     if (PMIX_SUCCESS != rc) {
         return rc;
     }
@@ -617,18 +1081,6 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
         return PMIX_ERR_BAD_PARAM;
     }
 
-    /* create space for the procs */
-    PMIX_PROC_CREATE(procs, nprocs);
-    if (NULL == procs) {
-        return PMIX_ERR_NOMEM;
-    }
-    /* unpack the procs */
-    cnt = nprocs;
-    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, procs, &cnt, PMIX_PROC);
-    if (PMIX_SUCCESS != rc) {
-        goto cleanup;
-    }
-
     /* cycle thru the procs and check to see if any reference
      * a PMIx group */
     nmbrs = nprocs;
@@ -705,6 +1157,9 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
         for (n=0; n < ninfo; n++) {
             if (0 == strcmp(info[n].key, PMIX_COLLECT_DATA)) {
                 collect_data = true;
+            } else if (0 == strncmp(info[n].key, PMIX_COLLECT_KEYS, PMIX_MAX_KEYLEN)) {
+                collect_data = true;
+                ckeys = info[n].value.data.string;
             } else if (0 == strncmp(info[n].key, PMIX_TIMEOUT, PMIX_MAX_KEYLEN)) {
                 tv.tv_sec = info[n].value.data.uint32;
             }
@@ -729,10 +1184,18 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
        /* mark if they want the data back */
         if (collect_data) {
             trk->collect_type = PMIX_COLLECT_YES;
+            if (NULL != ckeys) {
+                trk->collect_keys = pmix_argv_split(ckeys, ',');
+            }
         } else {
             trk->collect_type = PMIX_COLLECT_NO;
         }
     } else {
+        /* everyone has to ask for the same keys */
+        if (PMIX_COLLECT_YES == trk->collect_type &&
+            !_same_keys(trk->collect_keys, ckeys)) {
+            trk->collect_type = PMIX_COLLECT_INVALID;
+        }
         switch (trk->collect_type) {
         case PMIX_COLLECT_NO:
             if (collect_data) {
@@ -760,16 +1223,33 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
         info = NULL;
     }
 
+    /* if we are collecting data, then add this proc's
+     * contribution to the running collection now. Clones of
+     * a proc share its data, so when all participants are from
+     * a single nspace we only take it from the first to arrive */
+    if (PMIX_COLLECT_YES == trk->collect_type) {
+        rank = (int)cd->peer->info->pname.rank;
+        if (trk->multi_ns || rank < 0) {
+            if (PMIX_SUCCESS != (rc = _add_contribution(trk, cd->peer))) {
+                goto cleanup;
+            }
+            ++trk->ndata;
+        } else if (!pmix_bitmap_is_set_bit(&trk->arrivals, rank)) {
+            if (PMIX_SUCCESS != (rc = _add_contribution(trk, cd->peer))) {
+                goto cleanup;
+            }
+            pmix_bitmap_set_bit(&trk->arrivals, rank);
+            ++trk->ndata;
+        }
+    }
     /* add this contributor to the tracker so they get
      * notified when we are done */
-    pmix_list_append(&trk->local_cbs, &cd->super);
+    pmix_server_trk_add_local(trk, cd);
     /* if a timeout was specified, set it */
     if (0 < tv.tv_sec) {
         PMIX_RETAIN(trk);
         cd->trk = trk;
-        pmix_event_evtimer_set(pmix_globals.evbase, &cd->ev,
-                               fence_timeout, cd);
-        pmix_event_evtimer_add(&cd->ev, &tv);
+        pmix_timer_add(&cd->timer, fence_timeout, cd, &tv);
         cd->event_active = true;
     }
 
@@ -781,6 +1261,7 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
         pmix_list_get_size(&trk->local_cbs) == trk->nlocal) {
         pmix_output_verbose(2, pmix_server_globals.base_output,
                             "fence complete");
+        trk->t_local = pmix_counter_now();
         /* if the user asked us to collect data, then we have
          * to provide any locally collected data to the host
          * server so they can circulate it - only take data
@@ -797,11 +1278,14 @@ pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
         /* now unload the blob and pass it upstairs */
         PMIX_UNLOAD_BUFFER(&bucket, data, sz);
         PMIX_DESTRUCT(&bucket);
+        trk->upcall_bytes = sz;
+        trk->t_upcall = pmix_counter_now();
+        _add_algo(trk);
         rc = pmix_host_server.fence_nb(trk->pcs, trk->npcs,
                                        trk->info, trk->ninfo,
                                        data, sz, trk->modexcbfunc, trk);
         if (PMIX_SUCCESS != rc) {
-            pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+            pmix_server_trk_remove(trk);
             PMIX_RELEASE(trk);
         }
     }
@@ -830,6 +1314,35 @@ static void opcbfunc(pmix_status_t status, void *cbdata)
     PMIX_RELEASE(cd);
 }
 
+static void _published(int sd, short args, void *cbdata)
+{
+    pmix_shift_caddy_t *scd = (pmix_shift_caddy_t*)cbdata;
+
+    PMIX_ACQUIRE_OBJECT(scd);
+    pmix_server_pubsub_wake(scd->info, scd->ninfo);
+    PMIX_INFO_FREE(scd->info, scd->ninfo);
+    PMIX_RELEASE(scd);
+}
+
+static void pubcbfunc(pmix_status_t status, void *cbdata)
+{
+    pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
+    pmix_shift_caddy_t *scd;
+
+    /* lookups parked on these keys can now be retried - need
+     * to thread-shift as that accesses global data */
+    if (PMIX_SUCCESS == status && NULL != cd->info) {
+        scd = PMIX_NEW(pmix_shift_caddy_t);
+        if (NULL != scd) {
+            scd->info = cd->info;
+            scd->ninfo = cd->ninfo;
+            cd->info = NULL;
+            PMIX_THREADSHIFT(scd, _published);
+        }
+    }
+    opcbfunc(status, cd);
+}
+
 pmix_status_t pmix_server_publish(pmix_peer_t *peer,
                                   pmix_buffer_t *buf,
                                   pmix_op_cbfunc_t cbfunc, void *cbdata)
@@ -844,7 +1357,7 @@ pmix_status_t pmix_server_publish(pmix_peer_t *peer,
     pmix_output_verbose(2, pmix_server_globals.pub_output,
                         "recvd PUBLISH");
 
-    if (NULL == pmix_host_server.publish) {
+    if (NULL == pmix_host_server.publish && !pmix_server_globals.pubsub) {
         return PMIX_ERR_NOT_SUPPORTED;
     }
 
@@ -876,8 +1389,8 @@ pmix_status_t pmix_server_publish(pmix_peer_t *peer,
         goto cleanup;
     }
     /* unpack the array of info objects */
-    if (0 < cd->ninfo) {
-        cnt=cd->ninfo;
+    if (0 < ninfo) {
+        cnt=ninfo;
         PMIX_BFROPS_UNPACK(rc, peer, buf, cd->info, &cnt, PMIX_INFO);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
@@ -888,10 +1401,26 @@ pmix_status_t pmix_server_publish(pmix_peer_t *peer,
     cd->info[cd->ninfo-1].value.type = PMIX_UINT32;
     cd->info[cd->ninfo-1].value.data.uint32 = uid;
 
+    /* see if we hold it ourselves */
+    if (pmix_server_globals.pubsub) {
+        rc = pmix_server_pubsub_publish(peer, cd->info, cd->ninfo,
+                                        NULL != pmix_host_server.publish,
+                                        cbfunc, cbdata);
+        if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+            PMIX_INFO_FREE(cd->info, cd->ninfo);
+            PMIX_RELEASE(cd);
+            return rc;
+        }
+    }
+    if (NULL == pmix_host_server.publish) {
+        rc = PMIX_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
     /* call the local server */
     pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
     proc.rank = peer->info->pname.rank;
-    rc = pmix_host_server.publish(&proc, cd->info, cd->ninfo, opcbfunc, cd);
+    rc = pmix_host_server.publish(&proc, cd->info, cd->ninfo, pubcbfunc, cd);
 
   cleanup:
     if (PMIX_SUCCESS != rc) {
@@ -939,7 +1468,7 @@ pmix_status_t pmix_server_lookup(pmix_peer_t *peer,
     pmix_output_verbose(2, pmix_server_globals.pub_output,
                         "recvd LOOKUP");
 
-    if (NULL == pmix_host_server.lookup) {
+    if (NULL == pmix_host_server.lookup && !pmix_server_globals.pubsub) {
         return PMIX_ERR_NOT_SUPPORTED;
     }
 
@@ -1002,6 +1531,24 @@ pmix_status_t pmix_server_lookup(pmix_peer_t *peer,
     cd->info[cd->ninfo-1].value.type = PMIX_UINT32;
     cd->info[cd->ninfo-1].value.data.uint32 = uid;
 
+    /* see if we can answer it ourselves, or must hold it
+     * until the keys are published */
+    rc = pmix_server_pubsub_lookup(peer, cd->keys, cd->info, cd->ninfo,
+                                   NULL != pmix_host_server.lookup,
+                                   cbfunc, cbdata);
+    if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+        if (NULL != cd->keys) {
+            pmix_argv_free(cd->keys);
+        }
+        PMIX_INFO_FREE(cd->info, cd->ninfo);
+        PMIX_RELEASE(cd);
+        return rc;
+    }
+    if (NULL == pmix_host_server.lookup) {
+        rc = PMIX_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
     /* call the local server */
     pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
     proc.rank = peer->info->pname.rank;
@@ -1035,7 +1582,7 @@ pmix_status_t pmix_server_unpublish(pmix_peer_t *peer,
     pmix_output_verbose(2, pmix_server_globals.pub_output,
                         "recvd UNPUBLISH");
 
-    if (NULL == pmix_host_server.unpublish) {
+    if (NULL == pmix_host_server.unpublish && !pmix_server_globals.pubsub) {
         return PMIX_ERR_NOT_SUPPORTED;
     }
 
@@ -1098,6 +1645,25 @@ pmix_status_t pmix_server_unpublish(pmix_peer_t *peer,
     cd->info[cd->ninfo-1].value.type = PMIX_UINT32;
     cd->info[cd->ninfo-1].value.data.uint32 = uid;
 
+    /* remove anything we hold ourselves */
+    if (pmix_server_globals.pubsub) {
+        rc = pmix_server_pubsub_unpublish(peer, cd->keys, cd->info, cd->ninfo,
+                                          NULL != pmix_host_server.unpublish,
+                                          cbfunc, cbdata);
+        if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+            if (NULL != cd->keys) {
+                pmix_argv_free(cd->keys);
+            }
+            PMIX_INFO_FREE(cd->info, cd->ninfo);
+            PMIX_RELEASE(cd);
+            return rc;
+        }
+    }
+    if (NULL == pmix_host_server.unpublish) {
+        rc = PMIX_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
     /* call the local server */
     pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
     proc.rank = peer->info->pname.rank;
@@ -1121,10 +1687,6 @@ static void spcbfunc(pmix_status_t status,
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
     pmix_iof_req_t *req;
-    pmix_setup_caddy_t *occupant;
-    int i;
-    pmix_buffer_t *msg;
-    pmix_status_t rc;
 
     /* if it was successful, and there are IOF requests, then
      * register them now */
@@ -1142,61 +1704,7 @@ static void spcbfunc(pmix_status_t status,
         req->channels = cd->channels;
         pmix_list_append(&pmix_globals.iof_requests, &req->super);
         /* process any cached IO */
-        for (i=0; i < PMIX_IOF_HOTEL_SIZE; i++) {
-            pmix_hotel_knock(&pmix_server_globals.iof, PMIX_IOF_HOTEL_SIZE-i-1, (void**)&occupant);
-            if (NULL != occupant) {
-                if (!(occupant->channels & req->channels)) {
-                    continue;
-                }
-                /* if the source matches the request, then forward this along */
-                if (0 != strncmp(occupant->procs->nspace, req->pname.nspace, PMIX_MAX_NSLEN) ||
-                    (PMIX_RANK_WILDCARD != req->pname.rank && occupant->procs->rank != req->pname.rank)) {
-                    continue;
-                }
-                /* never forward back to the source! This can happen if the source
-                 * is a launcher */
-                if (0 == strncmp(occupant->procs->nspace, req->peer->info->pname.nspace, PMIX_MAX_NSLEN) &&
-                    occupant->procs->rank == req->peer->info->pname.rank) {
-                    continue;
-                }
-                /* setup the msg */
-                if (NULL == (msg = PMIX_NEW(pmix_buffer_t))) {
-                    PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
-                    rc = PMIX_ERR_OUT_OF_RESOURCE;
-                    break;
-                }
-                /* provide the source */
-                PMIX_BFROPS_PACK(rc, req->peer, msg, occupant->procs, 1, PMIX_PROC);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(msg);
-                    break;
-                }
-                /* provide the channel */
-                PMIX_BFROPS_PACK(rc, req->peer, msg, &occupant->channels, 1, PMIX_IOF_CHANNEL);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(msg);
-                    break;
-                }
-                /* pack the data */
-                PMIX_BFROPS_PACK(rc, req->peer, msg, occupant->bo, 1, PMIX_BYTE_OBJECT);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(msg);
-                    break;
-                }
-                /* send it to the requestor */
-                PMIX_PTL_SEND_ONEWAY(rc, req->peer, msg, PMIX_PTL_TAG_IOF);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(msg);
-                }
-                /* remove it from the hotel since it has now been forwarded */
-                pmix_hotel_checkout(&pmix_server_globals.iof, PMIX_IOF_HOTEL_SIZE-i-1);
-                PMIX_RELEASE(occupant);
-            }
-        }
+        pmix_server_iof_replay(req, true);
     }
 
   cleanup:
@@ -1213,6 +1721,211 @@ static void spcbfunc(pmix_status_t status,
     PMIX_RELEASE(cd);
 }
 
+static bool spawn_dirs_match(pmix_setup_caddy_t *a, pmix_setup_caddy_t *b)
+{
+    size_t n;
+    pmix_value_cmp_t cmp;
+
+    if (a->ninfo != b->ninfo) {
+        return false;
+    }
+    for (n=0; n < a->ninfo; n++) {
+        if (!PMIX_CHECK_KEY(&a->info[n], b->info[n].key)) {
+            return false;
+        }
+        PMIX_BFROPS_VALUE_CMP(cmp, pmix_globals.mypeer,
+                              &a->info[n].value, &b->info[n].value);
+        if (PMIX_EQUAL != cmp) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void spawn_batch_fail(pmix_spawn_batch_t *batch, pmix_status_t status)
+{
+    pmix_setup_caddy_t *cd;
+    pmix_nspace_t nspace;
+    int i;
+
+    memset(nspace, 0, sizeof(nspace));
+    for (i=0; i < batch->members.size; i++) {
+        if (NULL == (cd = (pmix_setup_caddy_t*)pmix_pointer_array_get_item(&batch->members, i))) {
+            continue;
+        }
+        pmix_pointer_array_set_item(&batch->members, i, NULL);
+        spcbfunc(status, nspace, cd);
+    }
+}
+
+static void spawn_batch_complete(int sd, short args, void *cbdata)
+{
+    pmix_spawn_batch_t *batch = (pmix_spawn_batch_t*)cbdata;
+    pmix_setup_caddy_t *cd;
+    bool first = true;
+    int i;
+
+    PMIX_ACQUIRE_OBJECT(batch);
+
+    if (PMIX_SUCCESS != batch->status || NULL == batch->nspace) {
+        spawn_batch_fail(batch, (PMIX_SUCCESS == batch->status) ? PMIX_ERROR : batch->status);
+        PMIX_RELEASE(batch);
+        return;
+    }
+
+    pmix_output_verbose(2, pmix_server_globals.spawn_output,
+                        "spawn batch of %d requests launched as %s",
+                        batch->nmembers, batch->nspace);
+
+    /* every member gets the nspace of the combined job - they
+     * all came from the same peer with the same directives, so
+     * only the first needs to register for its IO */
+    for (i=0; i < batch->members.size; i++) {
+        if (NULL == (cd = (pmix_setup_caddy_t*)pmix_pointer_array_get_item(&batch->members, i))) {
+            continue;
+        }
+        pmix_pointer_array_set_item(&batch->members, i, NULL);
+        if (!first) {
+            cd->channels = PMIX_FWD_NO_CHANNELS;
+        }
+        first = false;
+        spcbfunc(PMIX_SUCCESS, batch->nspace, cd);
+    }
+    PMIX_RELEASE(batch);
+}
+
+static void spawn_batch_cbfunc(pmix_status_t status,
+                               char nspace[], void *cbdata)
+{
+    pmix_spawn_batch_t *batch = (pmix_spawn_batch_t*)cbdata;
+
+    /* the host may answer on its own thread */
+    batch->status = status;
+    if (NULL != nspace) {
+        batch->nspace = strdup(nspace);
+    }
+    PMIX_THREADSHIFT(batch, spawn_batch_complete);
+}
+
+static void spawn_batch_flush(pmix_spawn_batch_t *batch)
+{
+    pmix_setup_caddy_t *cd;
+    pmix_proc_t proc;
+    pmix_status_t rc;
+    size_t m = 0;
+    int i;
+
+    pmix_list_remove_item(&pmix_server_globals.spawn_batches, &batch->super);
+
+    /* a lone request goes to the host as it came */
+    cd = (pmix_setup_caddy_t*)pmix_pointer_array_get_item(&batch->members, 0);
+    pmix_strncpy(proc.nspace, batch->peer->info->pname.nspace, PMIX_MAX_NSLEN);
+    proc.rank = batch->peer->info->pname.rank;
+    if (1 == batch->nmembers) {
+        rc = pmix_host_server.spawn(&proc, cd->info, cd->ninfo, cd->apps, cd->napps, spcbfunc, cd);
+        if (PMIX_SUCCESS == rc) {
+            pmix_pointer_array_set_item(&batch->members, 0, NULL);
+        } else {
+            spawn_batch_fail(batch, rc);
+        }
+        PMIX_RELEASE(batch);
+        return;
+    }
+
+    /* the directives all match, so take those of the first
+     * and lay the apps of each member end to end */
+    batch->info = cd->info;
+    batch->ninfo = cd->ninfo;
+    cd->info = NULL;
+    cd->ninfo = 0;
+    PMIX_APP_CREATE(batch->apps, batch->napps);
+    if (NULL == batch->apps) {
+        spawn_batch_fail(batch, PMIX_ERR_NOMEM);
+        PMIX_RELEASE(batch);
+        return;
+    }
+    for (i=0; i < batch->members.size; i++) {
+        if (NULL == (cd = (pmix_setup_caddy_t*)pmix_pointer_array_get_item(&batch->members, i))) {
+            continue;
+        }
+        if (NULL != cd->apps) {
+            memcpy(&batch->apps[m], cd->apps, cd->napps * sizeof(pmix_app_t));
+            m += cd->napps;
+            /* the batch now owns their contents */
+            free(cd->apps);
+            cd->apps = NULL;
+            cd->napps = 0;
+        }
+        if (NULL != cd->info) {
+            PMIX_INFO_FREE(cd->info, cd->ninfo);
+        }
+    }
+
+    pmix_output_verbose(2, pmix_server_globals.spawn_output,
+                        "spawning batch of %d requests with %lu apps",
+                        batch->nmembers, (unsigned long)batch->napps);
+
+    rc = pmix_host_server.spawn(&proc, batch->info, batch->ninfo,
+                                batch->apps, batch->napps,
+                                spawn_batch_cbfunc, batch);
+    if (PMIX_SUCCESS != rc) {
+        spawn_batch_fail(batch, rc);
+        PMIX_RELEASE(batch);
+    }
+}
+
+static void spawn_batch_timeout(int sd, short args, void *cbdata)
+{
+    pmix_spawn_batch_t *batch = (pmix_spawn_batch_t*)cbdata;
+
+    PMIX_ACQUIRE_OBJECT(batch);
+    batch->active = false;
+    spawn_batch_flush(batch);
+}
+
+static void spawn_batch_add(pmix_setup_caddy_t *cd)
+{
+    pmix_spawn_batch_t *batch = NULL, *b;
+    pmix_setup_caddy_t *first;
+    struct timeval tv;
+
+    PMIX_LIST_FOREACH(b, &pmix_server_globals.spawn_batches, pmix_spawn_batch_t) {
+        if (b->peer != cd->peer) {
+            continue;
+        }
+        first = (pmix_setup_caddy_t*)pmix_pointer_array_get_item(&b->members, 0);
+        if (spawn_dirs_match(first, cd)) {
+            batch = b;
+            break;
+        }
+    }
+    if (NULL == batch) {
+        batch = PMIX_NEW(pmix_spawn_batch_t);
+        PMIX_RETAIN(cd->peer);
+        batch->peer = cd->peer;
+        pmix_list_append(&pmix_server_globals.spawn_batches, &batch->super);
+        pmix_event_evtimer_set(pmix_globals.evbase, &batch->ev,
+                               spawn_batch_timeout, batch);
+        tv.tv_sec = pmix_server_globals.spawn_batch_msec / 1000;
+        tv.tv_usec = (pmix_server_globals.spawn_batch_msec % 1000) * 1000;
+        batch->active = true;
+        PMIX_POST_OBJECT(batch);
+        pmix_event_evtimer_add(&batch->ev, &tv);
+    }
+    pmix_pointer_array_add(&batch->members, cd);
+    batch->nmembers++;
+    batch->napps += cd->napps;
+
+    /* full - no point waiting any longer */
+    if (batch->napps >= (size_t)pmix_server_globals.spawn_batch_apps) {
+        if (batch->active) {
+            pmix_event_evtimer_del(&batch->ev);
+            batch->active = false;
+        }
+        spawn_batch_flush(batch);
+    }
+}
+
 pmix_status_t pmix_server_spawn(pmix_peer_t *peer,
                                 pmix_buffer_t *buf,
                                 pmix_spawn_cbfunc_t cbfunc,
@@ -1335,6 +2048,14 @@ pmix_status_t pmix_server_spawn(pmix_peer_t *peer,
             goto cleanup;
         }
     }
+    /* task farms issue streams of small spawns - hold this
+     * one briefly so that others like it can go to the host
+     * as a single request */
+    if (0 < pmix_server_globals.spawn_batch_msec) {
+        spawn_batch_add(cd);
+        return PMIX_SUCCESS;
+    }
+
     /* call the local server */
     pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
     proc.rank = peer->info->pname.rank;
@@ -1353,6 +2074,59 @@ pmix_status_t pmix_server_spawn(pmix_peer_t *peer,
     return rc;
 }
 
+bool pmix_server_cnct_known(pmix_peer_t *peer, pmix_namespace_t *nptr)
+{
+    char *tag;
+    int i;
+    bool found = false;
+
+    if (NULL == peer->cnct_ns) {
+        return false;
+    }
+    if (0 > asprintf(&tag, "%s:%u", nptr->nspace, nptr->jobgen)) {
+        return false;
+    }
+    for (i=0; NULL != peer->cnct_ns[i]; i++) {
+        if (0 == strcmp(tag, peer->cnct_ns[i])) {
+            found = true;
+            break;
+        }
+    }
+    free(tag);
+    return found;
+}
+
+void pmix_server_cnct_record(pmix_peer_t *peer, pmix_namespace_t *nptr)
+{
+    char *tag;
+
+    /* drop any copy of an earlier generation */
+    pmix_server_cnct_forget(peer, nptr->nspace);
+    if (0 > asprintf(&tag, "%s:%u", nptr->nspace, nptr->jobgen)) {
+        return;
+    }
+    pmix_argv_append_nosize(&peer->cnct_ns, tag);
+    free(tag);
+}
+
+void pmix_server_cnct_forget(pmix_peer_t *peer, const char *nspace)
+{
+    size_t len = strlen(nspace);
+    int i, argc;
+
+    if (NULL == peer->cnct_ns) {
+        return;
+    }
+    argc = pmix_argv_count(peer->cnct_ns);
+    for (i=0; NULL != peer->cnct_ns[i]; i++) {
+        if (0 == strncmp(peer->cnct_ns[i], nspace, len) &&
+            ':' == peer->cnct_ns[i][len]) {
+            pmix_argv_delete(&argc, &peer->cnct_ns, i, 1);
+            break;
+        }
+    }
+}
+
 pmix_status_t pmix_server_disconnect(pmix_server_caddy_t *cd,
                                      pmix_buffer_t *buf,
                                      pmix_op_cbfunc_t cbfunc)
@@ -1360,7 +2134,8 @@ pmix_status_t pmix_server_disconnect(pmix_server_caddy_t *cd,
     int32_t cnt;
     pmix_status_t rc;
     pmix_info_t *info = NULL;
-    size_t nprocs, ninfo;
+    size_t nprocs, ninfo, n;
+    bool cache = false;
     pmix_server_trkr_t *trk;
     pmix_proc_t *procs = NULL;
 
@@ -1368,9 +2143,8 @@ pmix_status_t pmix_server_disconnect(pmix_server_caddy_t *cd,
         return PMIX_ERR_NOT_SUPPORTED;
     }
 
-    /* unpack the number of procs */
-    cnt = 1;
-    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &nprocs, &cnt, PMIX_SIZE);
+    /* unpack the procs - these may come as rank ranges */
+    rc = pmix_bfrops_base_unpack_procset(cd->peer, buf, &procs, &nprocs);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         goto cleanup;
@@ -1386,19 +2160,6 @@ pmix_status_t pmix_server_disconnect(pmix_server_caddy_t *cd,
         goto cleanup;
     }
 
-    /* unpack the procs */
-    PMIX_PROC_CREATE(procs, nprocs);
-    if (NULL == procs) {
-        rc = PMIX_ERR_NOMEM;
-        goto cleanup;
-    }
-    cnt = nprocs;
-    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, procs, &cnt, PMIX_PROC);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        goto cleanup;
-    }
-
     /* unpack the number of provided info structs */
     cnt = 1;
     PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &ninfo, &cnt, PMIX_SIZE);
@@ -1417,6 +2178,20 @@ pmix_status_t pmix_server_disconnect(pmix_server_caddy_t *cd,
         if (PMIX_SUCCESS != rc) {
             goto cleanup;
         }
+        for (n=0; n < ninfo; n++) {
+            if (PMIX_CHECK_KEY(&info[n], PMIX_CONNECT_CACHE)) {
+                cache = PMIX_INFO_TRUE(&info[n]);
+                break;
+            }
+        }
+    }
+
+    /* unless asked to keep it, the client drops the other
+     * nspaces' data - so we must resend it on the next connect */
+    if (!cache) {
+        for (n=0; n < nprocs; n++) {
+            pmix_server_cnct_forget(cd->peer, procs[n].nspace);
+        }
     }
 
     /* find/create the local tracker for this operation */
@@ -1442,18 +2217,19 @@ pmix_status_t pmix_server_disconnect(pmix_server_caddy_t *cd,
 
     /* add this contributor to the tracker so they get
      * notified when we are done */
-    pmix_list_append(&trk->local_cbs, &cd->super);
+    pmix_server_trk_add_local(trk, cd);
     /* if all local contributions have been received,
      * let the local host's server know that we are at the
      * "fence" point - they will callback once the [dis]connect
      * across all participants has been completed */
     if (trk->def_complete &&
         pmix_list_get_size(&trk->local_cbs) == trk->nlocal) {
+        _add_algo(trk);
         rc = pmix_host_server.disconnect(trk->pcs, trk->npcs, trk->info, trk->ninfo, cbfunc, trk);
         if (PMIX_SUCCESS != rc) {
             /* remove this contributor from the list - they will be notified
              * by the switchyard */
-            pmix_list_remove_item(&trk->local_cbs, &cd->super);
+            pmix_server_trk_del_local(cd);
         }
     } else {
         rc = PMIX_SUCCESS;
@@ -1480,7 +2256,7 @@ static void connect_timeout(int sd, short args, void *cbdata)
     }
     cd->event_active = false;
     /* remove it from the list */
-    pmix_list_remove_item(&cd->trk->local_cbs, &cd->super);
+    pmix_server_trk_del_local(cd);
     PMIX_RELEASE(cd);
 }
 
@@ -1505,9 +2281,8 @@ pmix_status_t pmix_server_connect(pmix_server_caddy_t *cd,
         return PMIX_ERR_NOT_SUPPORTED;
     }
 
-    /* unpack the number of procs */
-    cnt = 1;
-    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &nprocs, &cnt, PMIX_SIZE);
+    /* unpack the procs - these may come as rank ranges */
+    rc = pmix_bfrops_base_unpack_procset(cd->peer, buf, &procs, &nprocs);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         goto cleanup;
@@ -1523,19 +2298,6 @@ pmix_status_t pmix_server_connect(pmix_server_caddy_t *cd,
         goto cleanup;
     }
 
-    /* unpack the procs */
-    PMIX_PROC_CREATE(procs, nprocs);
-    if (NULL == procs) {
-        rc = PMIX_ERR_NOMEM;
-        goto cleanup;
-    }
-    cnt = nprocs;
-    PMIX_BFROPS_UNPACK(rc, cd->peer, buf, procs, &cnt, PMIX_PROC);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        goto cleanup;
-    }
-
     /* unpack the number of provided info structs */
     cnt = 1;
     PMIX_BFROPS_UNPACK(rc, cd->peer, buf, &ninfo, &cnt, PMIX_SIZE);
@@ -1590,7 +2352,7 @@ pmix_status_t pmix_server_connect(pmix_server_caddy_t *cd,
 
     /* add this contributor to the tracker so they get
      * notified when we are done */
-    pmix_list_append(&trk->local_cbs, &cd->super);
+    pmix_server_trk_add_local(trk, cd);
 
     /* if all local contributions have been received,
      * let the local host's server know that we are at the
@@ -1598,11 +2360,12 @@ pmix_status_t pmix_server_connect(pmix_server_caddy_t *cd,
      * across all participants has been completed */
     if (trk->def_complete &&
         pmix_list_get_size(&trk->local_cbs) == trk->nlocal) {
+        _add_algo(trk);
         rc = pmix_host_server.connect(trk->pcs, trk->npcs, trk->info, trk->ninfo, cbfunc, trk);
         if (PMIX_SUCCESS != rc) {
             /* remove this contributor from the list - they will be notified
              * by the switchyard */
-            pmix_list_remove_item(&trk->local_cbs, &cd->super);
+            pmix_server_trk_del_local(cd);
         }
     } else {
         rc = PMIX_SUCCESS;
@@ -1611,9 +2374,7 @@ pmix_status_t pmix_server_connect(pmix_server_caddy_t *cd,
     if (PMIX_SUCCESS == rc && 0 < tv.tv_sec) {
         PMIX_RETAIN(trk);
         cd->trk = trk;
-        pmix_event_evtimer_set(pmix_globals.evbase, &cd->ev,
-                               connect_timeout, cd);
-        pmix_event_evtimer_add(&cd->ev, &tv);
+        pmix_timer_add(&cd->timer, connect_timeout, cd, &tv);
         cd->event_active = true;
     }
 
@@ -1641,13 +2402,16 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer,
     pmix_peer_events_info_t *prev;
     pmix_notify_caddy_t *cd;
     pmix_setup_caddy_t *scd;
-    int i;
+    int *rooms = NULL;
+    size_t i, nrooms = 0;
     bool enviro_events = false;
     bool found, matched;
     pmix_buffer_t *relay;
     pmix_cmd_t cmd = PMIX_NOTIFY_CMD;
     pmix_proc_t *affected = NULL;
     size_t naffected = 0;
+    pmix_proc_set_t *aset = NULL;
+    int code;
 
     pmix_output_verbose(2, pmix_server_globals.event_output,
                         "recvd register events for peer %s:%d",
@@ -1717,6 +2481,15 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer,
             naffected = info[n].value.data.darray->size;
             PMIX_PROC_CREATE(affected, naffected);
             memcpy(affected, info[n].value.data.darray->array, naffected * sizeof(pmix_proc_t));
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_EVENT_RING_READER)) {
+            /* the client is reading the event ring - we can only
+             * write into it what it can unpack with our own bfrops */
+            if (peer->nptr->compat.bfrops == pmix_globals.mypeer->nptr->compat.bfrops &&
+                peer->nptr->compat.type == pmix_globals.mypeer->nptr->compat.type) {
+                pmix_proc_t proc;
+                PMIX_LOAD_PROCID(&proc, peer->info->pname.nspace, peer->info->pname.rank);
+                peer->evring_idx = pmix_event_ring_lookup_reader(&proc);
+            }
         }
     }
 
@@ -1740,37 +2513,24 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer,
      * client when the server notifies the event */
     k=0;
     do {
-        found = false;
-        PMIX_LIST_FOREACH(reginfo, &pmix_server_globals.events, pmix_regevents_info_t) {
-            if (NULL == codes) {
-                if (PMIX_MAX_ERR_CONSTANT == reginfo->code) {
-                    /* both are default handlers */
-                    found = true;
-                    break;
-                } else {
-                    continue;
-                }
-            } else {
-                if (PMIX_MAX_ERR_CONSTANT == reginfo->code) {
-                    continue;
-                } else if (codes[k] == reginfo->code) {
-                    found = true;
-                    break;
-                }
-            }
-        }
-        if (found) {
+        code = (NULL == codes) ? PMIX_MAX_ERR_CONSTANT : codes[k];
+        if (NULL != (reginfo = pmix_server_reg_lookup(code))) {
             /* found it - add this peer if we don't already have it */
             found = false;
-            PMIX_LIST_FOREACH(prev, &reginfo->peers, pmix_peer_events_info_t) {
-                if (prev->peer == peer) {
-                    /* already have it */
-                    rc = PMIX_SUCCESS;
-                    found = true;
-                    break;
+            if (0 <= peer->index) {
+                found = pmix_bitmap_is_set_bit(&reginfo->members, peer->index);
+            } else {
+                PMIX_LIST_FOREACH(prev, &reginfo->peers, pmix_peer_events_info_t) {
+                    if (prev->peer == peer) {
+                        found = true;
+                        break;
+                    }
                 }
             }
-            if (!found) {
+            if (found) {
+                /* already have it */
+                rc = PMIX_SUCCESS;
+            } else {
                 /* get here if we don't already have this peer */
                 prev = PMIX_NEW(pmix_peer_events_info_t);
                 if (NULL == prev) {
@@ -1780,21 +2540,14 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer,
                 PMIX_RETAIN(peer);
                 prev->peer = peer;
                 prev->enviro_events = enviro_events;
-                pmix_list_append(&reginfo->peers, &prev->super);
+                pmix_server_reg_add_peer(reginfo, prev);
             }
         } else {
             /* if we get here, then we didn't find an existing registration for this code */
-            reginfo = PMIX_NEW(pmix_regevents_info_t);
-            if (NULL == reginfo) {
+            if (NULL == (reginfo = pmix_server_reg_create(code))) {
                 rc = PMIX_ERR_NOMEM;
                 goto cleanup;
             }
-            if (NULL == codes) {
-                reginfo->code = PMIX_MAX_ERR_CONSTANT;
-            } else {
-                reginfo->code = codes[k];
-            }
-            pmix_list_append(&pmix_server_globals.events, &reginfo->super);
             prev = PMIX_NEW(pmix_peer_events_info_t);
             if (NULL == prev) {
                 rc = PMIX_ERR_NOMEM;
@@ -1803,7 +2556,7 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer,
             PMIX_RETAIN(peer);
             prev->peer = peer;
             prev->enviro_events = enviro_events;
-            pmix_list_append(&reginfo->peers, &prev->super);
+            pmix_server_reg_add_peer(reginfo, prev);
         }
         ++k;
     } while (k < ncodes);
@@ -1881,9 +2634,13 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer,
         return rc;
     }
 
-    /* check if any matching notifications have been cached */
-    for (i=0; i < pmix_globals.max_events; i++) {
-        pmix_hotel_knock(&pmix_globals.notifications, i, (void**)&cd);
+    /* check if any matching notifications have been cached - only
+     * the notifications for these codes need to be visited */
+    if (PMIX_SUCCESS != (ret = pmix_notify_cache_rooms(codes, ncodes, &rooms, &nrooms))) {
+        PMIX_ERROR_LOG(ret);
+    }
+    for (i=0; i < nrooms; i++) {
+        pmix_hotel_knock(&pmix_globals.notifications, rooms[i], (void**)&cd);
         if (NULL == cd) {
             continue;
         }
@@ -1930,8 +2687,8 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer,
             }
         }
         /* if they specified affected proc(s) they wanted to know about, check */
-        if (!pmix_notify_check_affected(cd->affected, cd->naffected,
-                                        affected, naffected)) {
+        if (!pmix_notify_check_affected(cd->affected, cd->naffected, NULL,
+                                        affected, naffected, &aset)) {
             continue;
         }
         /* all matches - notify */
@@ -1975,12 +2732,18 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer,
             PMIX_RELEASE(relay);
         }
     }
+    if (NULL != rooms) {
+        free(rooms);
+    }
     if (NULL != codes) {
         free(codes);
     }
     if (NULL != affected) {
         PMIX_PROC_FREE(affected, naffected);
     }
+    if (NULL != aset) {
+        PMIX_RELEASE(aset);
+    }
     if (PMIX_SUCCESS != ret) {
         rc = ret;
     }
@@ -1992,8 +2755,7 @@ void pmix_server_deregister_events(pmix_peer_t *peer,
 {
     int32_t cnt;
     pmix_status_t rc, code;
-    pmix_regevents_info_t *reginfo = NULL;
-    pmix_regevents_info_t *reginfo_next;
+    pmix_regevents_info_t *reginfo;
     pmix_peer_events_info_t *prev;
 
     pmix_output_verbose(2, pmix_server_globals.event_output,
@@ -2003,24 +2765,21 @@ void pmix_server_deregister_events(pmix_peer_t *peer,
     cnt=1;
     PMIX_BFROPS_UNPACK(rc, peer, buf, &code, &cnt, PMIX_STATUS);
     while (PMIX_SUCCESS == rc) {
-        PMIX_LIST_FOREACH_SAFE(reginfo, reginfo_next, &pmix_server_globals.events, pmix_regevents_info_t) {
-            if (code == reginfo->code) {
-                /* found it - remove this peer from the list */
-                PMIX_LIST_FOREACH(prev, &reginfo->peers, pmix_peer_events_info_t) {
-                    if (prev->peer == peer) {
-                        /* found it */
-                        pmix_list_remove_item(&reginfo->peers, &prev->super);
-                        PMIX_RELEASE(prev);
-                        break;
-                    }
-                }
-                /* if all of the peers for this code are now gone, then remove it */
-                if (0 == pmix_list_get_size(&reginfo->peers)) {
-                    pmix_list_remove_item(&pmix_server_globals.events, &reginfo->super);
-                    /* if this was registered with the host, then deregister it */
-                    PMIX_RELEASE(reginfo);
+        if (NULL != (reginfo = pmix_server_reg_lookup(code))) {
+            /* found it - remove this peer from the list */
+            PMIX_LIST_FOREACH(prev, &reginfo->peers, pmix_peer_events_info_t) {
+                if (prev->peer == peer) {
+                    /* found it */
+                    pmix_server_reg_del_peer(prev);
+                    PMIX_RELEASE(prev);
+                    break;
                 }
             }
+            /* if all of the peers for this code are now gone, then remove it */
+            if (0 == pmix_list_get_size(&reginfo->peers)) {
+                /* if this was registered with the host, then deregister it */
+                pmix_server_reg_remove(reginfo);
+            }
         }
         cnt=1;
         PMIX_BFROPS_UNPACK(rc, peer, buf, &code, &cnt, PMIX_STATUS);
@@ -2187,6 +2946,687 @@ pmix_status_t pmix_server_event_recvd_from_client(pmix_peer_t *peer,
     return rc;
 }
 
+/* bytes of messages waiting to go out to the peer */
+static pmix_status_t peer_stats_load(pmix_value_t *val)
+{
+    pmix_peer_t *pr;
+    pmix_data_array_t *darray, *stats;
+    pmix_info_t *info;
+    uint64_t *u64;
+    size_t n, npeers = 0;
+    int i;
+
+    for (i=0; i < pmix_server_globals.clients.size; i++) {
+        if (NULL != pmix_pointer_array_get_item(&pmix_server_globals.clients, i)) {
+            ++npeers;
+        }
+    }
+    PMIX_DATA_ARRAY_CREATE(darray, npeers, PMIX_INFO);
+    if (NULL == darray) {
+        return PMIX_ERR_NOMEM;
+    }
+    val->type = PMIX_DATA_ARRAY;
+    val->data.darray = darray;
+    if (0 == npeers) {
+        return PMIX_SUCCESS;
+    }
+    PMIX_INFO_CREATE(info, npeers);
+    if (NULL == info) {
+        return PMIX_ERR_NOMEM;
+    }
+    darray->array = info;
+
+    n = 0;
+    for (i=0; i < pmix_server_globals.clients.size && n < npeers; i++) {
+        if (NULL == (pr = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, i))) {
+            continue;
+        }
+        PMIX_DATA_ARRAY_CREATE(stats, 7, PMIX_UINT64);
+        if (NULL == stats) {
+            return PMIX_ERR_NOMEM;
+        }
+        if (NULL == (u64 = (uint64_t*)malloc(7 * sizeof(uint64_t)))) {
+            free(stats);
+            return PMIX_ERR_NOMEM;
+        }
+        u64[0] = pr->msgs_sent;
+        u64[1] = pr->msgs_recvd;
+        u64[2] = pr->bytes_sent;
+        u64[3] = pr->bytes_recvd;
+        u64[4] = pr->queued_bytes;
+        u64[5] = pr->queued_hwm;
+        u64[6] = pr->msgs_dropped;
+        stats->array = u64;
+        snprintf(info[n].key, PMIX_MAX_KEYLEN, "%s.%u",
+                 pr->info->pname.nspace, pr->info->pname.rank);
+        info[n].value.type = PMIX_DATA_ARRAY;
+        info[n].value.data.darray = stats;
+        ++n;
+    }
+    return PMIX_SUCCESS;
+}
+
+static void add_usage(pmix_list_t *usage, const char *name, size_t sz)
+{
+    pmix_kval_t *kv;
+
+    kv = PMIX_NEW(pmix_kval_t);
+    if (NULL == kv) {
+        return;
+    }
+    kv->key = strdup(name);
+    PMIX_VALUE_CREATE(kv->value, 1);
+    if (NULL == kv->key || NULL == kv->value) {
+        PMIX_RELEASE(kv);
+        return;
+    }
+    kv->value->type = PMIX_SIZE;
+    kv->value->data.size = sz;
+    pmix_list_append(usage, &kv->super);
+}
+
+/* rough accounting of what the server library holds, by subsystem */
+static pmix_status_t memory_usage_load(pmix_value_t *val)
+{
+    pmix_list_t usage;
+    pmix_gds_base_active_module_t *active;
+    pmix_notify_caddy_t *ncd;
+    pmix_dmdx_local_t *lcd;
+    pmix_peer_t *pr;
+    pmix_kval_t *kv;
+    pmix_data_array_t *darray;
+    pmix_info_t *info;
+    size_t sz, n;
+    int i;
+
+    PMIX_CONSTRUCT(&usage, pmix_list_t);
+    PMIX_LIST_FOREACH(active, &pmix_gds_globals.actives, pmix_gds_base_active_module_t) {
+        if (NULL != active->module->mem_usage) {
+            active->module->mem_usage(&usage);
+        }
+    }
+
+    sz = 0;
+    for (i=0; i < pmix_globals.max_events; i++) {
+        pmix_hotel_knock(&pmix_globals.notifications, i, (void**)&ncd);
+        if (NULL != ncd) {
+            sz += sizeof(pmix_notify_caddy_t) +
+                  ncd->ninfo * sizeof(pmix_info_t) +
+                  ncd->ntargets * sizeof(pmix_proc_t) +
+                  ncd->naffected * sizeof(pmix_proc_t);
+            if (NULL != ncd->buf) {
+                sz += ncd->buf->bytes_allocated;
+            }
+        }
+    }
+    add_usage(&usage, "notify.cache", sz);
+
+    add_usage(&usage, "iof.cache", pmix_server_globals.iof_size);
+
+    sz = pmix_list_get_size(&pmix_server_globals.remote_pnd) * sizeof(pmix_dmdx_remote_t);
+    PMIX_LIST_FOREACH(lcd, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
+        sz += sizeof(pmix_dmdx_local_t) +
+              lcd->ninfo * sizeof(pmix_info_t) +
+              pmix_list_get_size(&lcd->loc_reqs) * sizeof(pmix_dmdx_request_t);
+    }
+    add_usage(&usage, "dmodex.pending", sz);
+
+    sz = 0;
+    for (i=0; i < pmix_server_globals.clients.size; i++) {
+        if (NULL != (pr = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, i))) {
+            sz += pr->queued_bytes;
+        }
+    }
+    add_usage(&usage, "ptl.queued", sz);
+
+    n = pmix_list_get_size(&usage);
+    PMIX_DATA_ARRAY_CREATE(darray, n, PMIX_INFO);
+    if (NULL == darray) {
+        PMIX_LIST_DESTRUCT(&usage);
+        return PMIX_ERR_NOMEM;
+    }
+    val->type = PMIX_DATA_ARRAY;
+    val->data.darray = darray;
+    PMIX_INFO_CREATE(info, n);
+    if (NULL == info) {
+        PMIX_LIST_DESTRUCT(&usage);
+        return PMIX_ERR_NOMEM;
+    }
+    darray->array = info;
+    n = 0;
+    PMIX_LIST_FOREACH(kv, &usage, pmix_kval_t) {
+        PMIX_INFO_LOAD(&info[n], kv->key, &kv->value->data.size, PMIX_SIZE);
+        ++n;
+    }
+    PMIX_LIST_DESTRUCT(&usage);
+    return PMIX_SUCCESS;
+}
+
+static bool server_internal(pmix_query_t *q)
+{
+    size_t n;
+
+    for (n=0; n < q->nqual; n++) {
+        if (PMIX_CHECK_KEY(&q->qualifiers[n], PMIX_QUERY_SERVER_INTERNAL)) {
+            return PMIX_INFO_TRUE(&q->qualifiers[n]);
+        }
+    }
+    return false;
+}
+
+/* proc tables of our local clients are answered from what we
+ * already hold - each nspace's table is built from gds on the first
+ * query for it and then kept current as clients come and go */
+static pmix_status_t ptable_fetch(pmix_proc_t *proc, const char *key,
+                                  pmix_data_type_t type, pmix_value_t **val)
+{
+    pmix_status_t rc;
+    pmix_cb_t cb;
+    pmix_kval_t *kv;
+
+    *val = NULL;
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = proc;
+    cb.key = (char*)key;
+    cb.scope = PMIX_INTERNAL;
+    cb.copy = false;
+    PMIX_GDS_FETCH_KV(rc, pmix_globals.mypeer, &cb);
+    if (PMIX_SUCCESS == rc) {
+        kv = (pmix_kval_t*)pmix_list_get_first(&cb.kvs);
+        if (NULL != kv && NULL != kv->value && type == kv->value->type) {
+            PMIX_VALUE_XFER(rc, *val, kv->value);
+        } else {
+            rc = PMIX_ERR_NOT_FOUND;
+        }
+    }
+    PMIX_DESTRUCT(&cb);
+    return rc;
+}
+
+static void ptable_fill(pmix_namespace_t *nptr, pmix_rank_info_t *info,
+                        pmix_proc_info_t *pi)
+{
+    pmix_value_t *val;
+    pmix_peer_t *peer;
+    char path[PMIX_PATH_MAX], exe[PMIX_PATH_MAX];
+    ssize_t len;
+
+    PMIX_PROC_INFO_DESTRUCT(pi);
+    PMIX_LOAD_PROCID(&pi->proc, nptr->nspace, info->pname.rank);
+
+    /* the host may have told us the pid and where it runs -
+     * otherwise use what we saw ourselves */
+    if (PMIX_SUCCESS == ptable_fetch(&pi->proc, PMIX_HOSTNAME, PMIX_STRING, &val)) {
+        pi->hostname = val->data.string;
+        val->data.string = NULL;
+        PMIX_VALUE_RELEASE(val);
+    } else if (0 == gethostname(path, sizeof(path))) {
+        path[sizeof(path)-1] = '\0';
+        pi->hostname = strdup(path);
+    }
+    if (PMIX_SUCCESS == ptable_fetch(&pi->proc, PMIX_PROC_PID, PMIX_PID, &val)) {
+        pi->pid = val->data.pid;
+        PMIX_VALUE_RELEASE(val);
+    } else {
+        pi->pid = info->pid;
+    }
+    if (0 < pi->pid) {
+        snprintf(path, sizeof(path), "/proc/%d/exe", (int)pi->pid);
+        len = readlink(path, exe, sizeof(exe) - 1);
+        if (0 < len) {
+            exe[len] = '\0';
+            pi->executable_name = strdup(exe);
+        }
+    }
+
+    if (0 > info->peerid) {
+        pi->state = PMIX_PROC_STATE_PREPPED;
+    } else {
+        peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, info->peerid);
+        if (NULL == peer || peer->finalized) {
+            pi->state = PMIX_PROC_STATE_TERMINATED;
+        } else {
+            pi->state = PMIX_PROC_STATE_CONNECTED;
+        }
+    }
+}
+
+static pmix_proc_info_t* ptable_find(pmix_namespace_t *nptr, pmix_rank_t rank)
+{
+    size_t n;
+
+    for (n=0; n < nptr->nptable; n++) {
+        if (nptr->ptable[n].proc.rank == rank) {
+            return &nptr->ptable[n];
+        }
+    }
+    return NULL;
+}
+
+void pmix_server_ptable_update(pmix_namespace_t *nptr, pmix_rank_info_t *info)
+{
+    pmix_proc_info_t *pi;
+
+    if (NULL == nptr->ptable) {
+        /* nobody has asked for it yet */
+        return;
+    }
+    if (NULL == (pi = ptable_find(nptr, info->pname.rank))) {
+        pi = (pmix_proc_info_t*)realloc(nptr->ptable, (nptr->nptable + 1) * sizeof(pmix_proc_info_t));
+        if (NULL == pi) {
+            PMIX_PROC_INFO_FREE(nptr->ptable, nptr->nptable);
+            nptr->ptable = NULL;
+            nptr->nptable = 0;
+            return;
+        }
+        nptr->ptable = pi;
+        pi = &nptr->ptable[nptr->nptable];
+        PMIX_PROC_INFO_CONSTRUCT(pi);
+        ++nptr->nptable;
+    }
+    ptable_fill(nptr, info, pi);
+}
+
+void pmix_server_ptable_remove(pmix_namespace_t *nptr, pmix_rank_t rank)
+{
+    pmix_proc_info_t *pi;
+    size_t n;
+
+    if (NULL == (pi = ptable_find(nptr, rank))) {
+        return;
+    }
+    PMIX_PROC_INFO_DESTRUCT(pi);
+    n = pi - nptr->ptable;
+    memmove(pi, pi + 1, (nptr->nptable - n - 1) * sizeof(pmix_proc_info_t));
+    --nptr->nptable;
+}
+
+/* find the nspace a proc table query is about if we can answer
+ * it ourselves - the full table only if every proc is one of ours */
+static pmix_namespace_t* ptable_get(pmix_query_t *q, bool all)
+{
+    pmix_namespace_t *nptr;
+    pmix_rank_info_t *info;
+    char *nspace = NULL;
+    size_t n;
+
+    for (n=0; n < q->nqual; n++) {
+        if (PMIX_CHECK_KEY(&q->qualifiers[n], PMIX_NSPACE) &&
+            PMIX_STRING == q->qualifiers[n].value.type) {
+            nspace = q->qualifiers[n].value.data.string;
+            break;
+        }
+    }
+    if (NULL == nspace) {
+        return NULL;
+    }
+    nptr = NULL;
+    nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, nspace);
+    if (NULL == nptr || !nptr->all_registered ||
+        (all && nptr->nprocs != nptr->nlocalprocs)) {
+        return NULL;
+    }
+    if (NULL == nptr->ptable) {
+        PMIX_PROC_INFO_CREATE(nptr->ptable, pmix_list_get_size(&nptr->ranks));
+        if (NULL == nptr->ptable) {
+            return NULL;
+        }
+        nptr->nptable = 0;
+        PMIX_LIST_FOREACH(info, &nptr->ranks, pmix_rank_info_t) {
+            ptable_fill(nptr, info, &nptr->ptable[nptr->nptable]);
+            ++nptr->nptable;
+        }
+    }
+    /* a debugger needs the pids - leave it to the
+     * host if we don't know them all yet */
+    for (n=0; n < nptr->nptable; n++) {
+        if (0 >= nptr->ptable[n].pid) {
+            return NULL;
+        }
+    }
+    return nptr;
+}
+
+static pmix_status_t ptable_load(pmix_namespace_t *nptr, pmix_value_t *val)
+{
+    pmix_data_array_t *darray;
+    pmix_proc_info_t *pi;
+    size_t n;
+
+    PMIX_PROC_INFO_CREATE(pi, nptr->nptable);
+    darray = (pmix_data_array_t*)malloc(sizeof(pmix_data_array_t));
+    if (NULL == pi || NULL == darray) {
+        if (NULL != pi) {
+            free(pi);
+        }
+        if (NULL != darray) {
+            free(darray);
+        }
+        return PMIX_ERR_NOMEM;
+    }
+    for (n=0; n < nptr->nptable; n++) {
+        memcpy(&pi[n].proc, &nptr->ptable[n].proc, sizeof(pmix_proc_t));
+        if (NULL != nptr->ptable[n].hostname) {
+            pi[n].hostname = strdup(nptr->ptable[n].hostname);
+        }
+        if (NULL != nptr->ptable[n].executable_name) {
+            pi[n].executable_name = strdup(nptr->ptable[n].executable_name);
+        }
+        pi[n].pid = nptr->ptable[n].pid;
+        pi[n].exit_code = nptr->ptable[n].exit_code;
+        pi[n].state = nptr->ptable[n].state;
+    }
+    darray->type = PMIX_PROC_INFO;
+    darray->size = nptr->nptable;
+    darray->array = pi;
+    val->type = PMIX_DATA_ARRAY;
+    val->data.darray = darray;
+    return PMIX_SUCCESS;
+}
+
+/* answer the request from our own state if every key in it is one
+ * we hold, else return PMIX_ERR_TAKE_NEXT_OPTION so it goes to the host */
+static pmix_status_t local_query(pmix_query_caddy_t *cd)
+{
+    size_t n, m, nkeys = 0;
+    char *key;
+    pmix_status_t rc;
+
+    for (n=0; n < cd->nqueries; n++) {
+        for (m=0; NULL != cd->queries[n].keys && NULL != cd->queries[n].keys[m]; m++) {
+            key = cd->queries[n].keys[m];
+            if (0 == strcmp(key, PMIX_QUERY_PROC_TABLE) ||
+                0 == strcmp(key, PMIX_QUERY_LOCAL_PROC_TABLE)) {
+                if (NULL == ptable_get(&cd->queries[n], 0 == strcmp(key, PMIX_QUERY_PROC_TABLE))) {
+                    return PMIX_ERR_TAKE_NEXT_OPTION;
+                }
+            } else if (0 != strcmp(key, PMIX_QUERY_COUNTERS) &&
+                0 != strcmp(key, PMIX_QUERY_PEER_STATS) &&
+                0 != strcmp(key, PMIX_QUERY_SLOW_REQUESTS) &&
+                (0 != strcmp(key, PMIX_QUERY_MEMORY_USAGE) ||
+                 (!server_internal(&cd->queries[n]) &&
+                  PMIX_SUCCESS != pmix_psensor.query(key, &cd->queries[n], NULL)))) {
+                return PMIX_ERR_TAKE_NEXT_OPTION;
+            }
+            ++nkeys;
+        }
+    }
+    if (0 == nkeys) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    PMIX_INFO_CREATE(cd->info, nkeys);
+    if (NULL == cd->info) {
+        return PMIX_ERR_NOMEM;
+    }
+    cd->ninfo = nkeys;
+    nkeys = 0;
+    for (n=0; n < cd->nqueries; n++) {
+        for (m=0; NULL != cd->queries[n].keys && NULL != cd->queries[n].keys[m]; m++) {
+            key = cd->queries[n].keys[m];
+            PMIX_LOAD_KEY(cd->info[nkeys].key, key);
+            if (0 == strcmp(key, PMIX_QUERY_COUNTERS)) {
+                rc = pmix_counters_load(&cd->info[nkeys].value);
+            } else if (0 == strcmp(key, PMIX_QUERY_MEMORY_USAGE)) {
+                if (server_internal(&cd->queries[n])) {
+                    rc = memory_usage_load(&cd->info[nkeys].value);
+                } else {
+                    /* the usage sensor of the proc(s) in question */
+                    rc = pmix_psensor.query(key, &cd->queries[n], &cd->info[nkeys].value);
+                    if (PMIX_ERR_TAKE_NEXT_OPTION == rc) {
+                        /* the process left since we looked */
+                        rc = PMIX_ERR_NOT_FOUND;
+                    }
+                }
+            } else if (0 == strcmp(key, PMIX_QUERY_SLOW_REQUESTS)) {
+                rc = pmix_server_watchdog_load(&cd->info[nkeys].value);
+            } else if (0 == strcmp(key, PMIX_QUERY_PROC_TABLE) ||
+                       0 == strcmp(key, PMIX_QUERY_LOCAL_PROC_TABLE)) {
+                rc = ptable_load(ptable_get(&cd->queries[n], 0 == strcmp(key, PMIX_QUERY_PROC_TABLE)),
+                                 &cd->info[nkeys].value);
+            } else {
+                rc = peer_stats_load(&cd->info[nkeys].value);
+            }
+            if (PMIX_SUCCESS != rc) {
+                return rc;
+            }
+            ++nkeys;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+/* host answers to queries whose result does not depend on who is
+ * asking are held for pmix_server_query_cache_ttl msec, so the
+ * same query arriving from many tools is answered without the host */
+#define PMIX_SERVER_QCACHE_MAX  64
+
+typedef struct {
+    pmix_list_item_t super;
+    pmix_byte_object_t key;     // the packed queries
+    pmix_info_t *info;
+    size_t ninfo;
+    uint64_t stamp;
+} pmix_qcache_t;
+static void qccon(pmix_qcache_t *p)
+{
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->key);
+    p->info = NULL;
+    p->ninfo = 0;
+    p->stamp = 0;
+}
+static void qcdes(pmix_qcache_t *p)
+{
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->key);
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_qcache_t,
+                           pmix_list_item_t,
+                           qccon, qcdes);
+
+/* a query out with the host whose answer is to be cached */
+typedef struct {
+    pmix_object_t super;
+    pmix_query_caddy_t *cd;
+    pmix_info_cbfunc_t cbfunc;
+    pmix_byte_object_t key;
+} pmix_qcache_req_t;
+static void qrcon(pmix_qcache_req_t *p)
+{
+    p->cd = NULL;
+    p->cbfunc = NULL;
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->key);
+}
+static void qrdes(pmix_qcache_req_t *p)
+{
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->key);
+}
+static PMIX_CLASS_INSTANCE(pmix_qcache_req_t,
+                           pmix_object_t,
+                           qrcon, qrdes);
+
+static bool qcache_init = false;
+static pmix_list_t qcache;          // pmix_qcache_t, oldest first
+static pmix_hash_table_t qcacheidx; // index of qcache by key
+
+static const char *qcache_keys[] = {
+    PMIX_QUERY_NAMESPACES,
+    PMIX_QUERY_JOB_STATUS,
+    PMIX_QUERY_QUEUE_LIST,
+    PMIX_QUERY_QUEUE_STATUS,
+    PMIX_QUERY_PROC_TABLE,
+    PMIX_QUERY_LOCAL_PROC_TABLE,
+    PMIX_QUERY_SPAWN_SUPPORT,
+    PMIX_QUERY_DEBUG_SUPPORT,
+    PMIX_QUERY_ALLOC_STATUS,
+    PMIX_QUERY_NUM_PSETS,
+    PMIX_QUERY_PSET_NAMES,
+    NULL
+};
+
+static void qcache_drop(pmix_qcache_t *qc)
+{
+    pmix_hash_table_remove_value_ptr(&qcacheidx, qc->key.bytes, qc->key.size);
+    pmix_list_remove_item(&qcache, &qc->super);
+    PMIX_RELEASE(qc);
+}
+
+void pmix_server_query_cache_flush(void)
+{
+    if (!qcache_init) {
+        return;
+    }
+    PMIX_DESTRUCT(&qcacheidx);
+    PMIX_LIST_DESTRUCT(&qcache);
+    qcache_init = false;
+}
+
+/* build the cache key for a request, noting whether the caller
+ * wants fresh data - returns false if the request can't be cached */
+static bool qcache_key(pmix_query_caddy_t *cd, pmix_byte_object_t *key, bool *refresh)
+{
+    pmix_buffer_t pbkt;
+    pmix_status_t rc;
+    size_t n, m, k;
+    bool found;
+
+    *refresh = false;
+    PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
+    for (n=0; n < cd->nqueries; n++) {
+        if (NULL == cd->queries[n].keys) {
+            PMIX_DESTRUCT(&pbkt);
+            return false;
+        }
+        for (m=0; NULL != cd->queries[n].keys[m]; m++) {
+            found = false;
+            for (k=0; NULL != qcache_keys[k]; k++) {
+                if (0 == strcmp(cd->queries[n].keys[m], qcache_keys[k])) {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                PMIX_DESTRUCT(&pbkt);
+                return false;
+            }
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &pbkt, &cd->queries[n].keys[m], 1, PMIX_STRING);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_DESTRUCT(&pbkt);
+                return false;
+            }
+        }
+        for (m=0; m < cd->queries[n].nqual; m++) {
+            if (PMIX_CHECK_KEY(&cd->queries[n].qualifiers[m], PMIX_QUERY_REFRESH_CACHE)) {
+                if (PMIX_INFO_TRUE(&cd->queries[n].qualifiers[m])) {
+                    *refresh = true;
+                }
+                continue;
+            }
+            PMIX_BFROPS_PACK(rc, pmix_globals.mypeer, &pbkt, &cd->queries[n].qualifiers[m], 1, PMIX_INFO);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_DESTRUCT(&pbkt);
+                return false;
+            }
+        }
+    }
+    PMIX_UNLOAD_BUFFER(&pbkt, key->bytes, key->size);
+    PMIX_DESTRUCT(&pbkt);
+    return (NULL != key->bytes);
+}
+
+static pmix_qcache_t* qcache_find(pmix_byte_object_t *key)
+{
+    pmix_qcache_t *qc;
+    uint64_t ttl;
+
+    if (!qcache_init) {
+        return NULL;
+    }
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&qcacheidx, key->bytes,
+                                                      key->size, (void**)&qc)) {
+        return NULL;
+    }
+    ttl = (uint64_t)pmix_server_globals.query_cache_ttl * 1000000;
+    if (pmix_counter_now() - qc->stamp > ttl) {
+        qcache_drop(qc);
+        return NULL;
+    }
+    return qc;
+}
+
+static void _qcache_store(int sd, short args, void *cbdata)
+{
+    pmix_shift_caddy_t *scd = (pmix_shift_caddy_t*)cbdata;
+    pmix_qcache_req_t *req = (pmix_qcache_req_t*)scd->cbdata;
+    pmix_qcache_t *qc;
+
+    PMIX_ACQUIRE_OBJECT(scd);
+
+    if (!qcache_init) {
+        PMIX_CONSTRUCT(&qcache, pmix_list_t);
+        PMIX_CONSTRUCT(&qcacheidx, pmix_hash_table_t);
+        pmix_hash_table_init(&qcacheidx, 64);
+        qcache_init = true;
+    }
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&qcacheidx, req->key.bytes,
+                                                      req->key.size, (void**)&qc)) {
+        qcache_drop(qc);
+    }
+    if (PMIX_SERVER_QCACHE_MAX <= pmix_list_get_size(&qcache)) {
+        qcache_drop((pmix_qcache_t*)pmix_list_get_first(&qcache));
+    }
+    qc = PMIX_NEW(pmix_qcache_t);
+    qc->key = req->key;
+    PMIX_BYTE_OBJECT_CONSTRUCT(&req->key);
+    qc->info = scd->info;
+    qc->ninfo = scd->ninfo;
+    qc->stamp = pmix_counter_now();
+    pmix_list_append(&qcache, &qc->super);
+    pmix_hash_table_set_value_ptr(&qcacheidx, qc->key.bytes, qc->key.size, qc);
+
+    PMIX_RELEASE(req);
+    PMIX_RELEASE(scd);
+}
+
+static void qcache_cbfunc(pmix_status_t status,
+                          pmix_info_t *info, size_t ninfo,
+                          void *cbdata,
+                          pmix_release_cbfunc_t release_fn,
+                          void *release_cbdata)
+{
+    pmix_qcache_req_t *req = (pmix_qcache_req_t*)cbdata;
+    pmix_shift_caddy_t *scd = NULL;
+    pmix_info_t *cpy = NULL;
+    size_t n;
+
+    /* keep a copy of a good answer - need to thread-shift
+     * to store it as that accesses global data */
+    if (PMIX_SUCCESS == status && 0 < ninfo) {
+        PMIX_INFO_CREATE(cpy, ninfo);
+        scd = PMIX_NEW(pmix_shift_caddy_t);
+    }
+    if (NULL != cpy && NULL != scd) {
+        for (n=0; n < ninfo; n++) {
+            PMIX_INFO_XFER(&cpy[n], &info[n]);
+        }
+        scd->info = cpy;
+        scd->ninfo = ninfo;
+        scd->cbdata = req;
+    } else if (NULL != cpy) {
+        PMIX_INFO_FREE(cpy, ninfo);
+    }
+
+    req->cbfunc(status, info, ninfo, req->cd, release_fn, release_cbdata);
+
+    if (NULL != scd) {
+        PMIX_THREADSHIFT(scd, _qcache_store);
+    } else {
+        PMIX_RELEASE(req);
+    }
+}
+
 pmix_status_t pmix_server_query(pmix_peer_t *peer,
                                 pmix_buffer_t *buf,
                                 pmix_info_cbfunc_t cbfunc,
@@ -2196,14 +3636,15 @@ pmix_status_t pmix_server_query(pmix_peer_t *peer,
     pmix_status_t rc;
     pmix_query_caddy_t *cd;
     pmix_proc_t proc;
+    pmix_byte_object_t key;
+    bool refresh;
+    pmix_qcache_t *qc;
+    pmix_qcache_req_t *req;
+    size_t n;
 
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "recvd query from client");
 
-    if (NULL == pmix_host_server.query) {
-        return PMIX_ERR_NOT_SUPPORTED;
-    }
-
     cd = PMIX_NEW(pmix_query_caddy_t);
     if (NULL == cd) {
         return PMIX_ERR_NOMEM;
@@ -2223,17 +3664,73 @@ pmix_status_t pmix_server_query(pmix_peer_t *peer,
             rc = PMIX_ERR_NOMEM;
             goto exit;
         }
-        cnt = cd->nqueries;
-        PMIX_BFROPS_UNPACK(rc, peer, buf, cd->queries, &cnt, PMIX_QUERY);
+        cnt = cd->nqueries;
+        PMIX_BFROPS_UNPACK(rc, peer, buf, cd->queries, &cnt, PMIX_QUERY);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto exit;
+        }
+    }
+
+    /* a request made up only of keys about this server
+     * itself is answered without the host */
+    if (PMIX_SUCCESS == (rc = local_query(cd))) {
+        /* the callback releases cd along with the results */
+        cbfunc(PMIX_SUCCESS, cd->info, cd->ninfo, cd, NULL, NULL);
+        return PMIX_SUCCESS;
+    } else if (PMIX_ERR_TAKE_NEXT_OPTION != rc) {
+        goto exit;
+    }
+
+    if (NULL == pmix_host_server.query) {
+        rc = PMIX_ERR_NOT_SUPPORTED;
+        goto exit;
+    }
+
+    /* setup the requesting peer name */
+    pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
+    proc.rank = peer->info->pname.rank;
+
+    /* see if we recently had the same answer from the host */
+    PMIX_BYTE_OBJECT_CONSTRUCT(&key);
+    if (0 < pmix_server_globals.query_cache_ttl &&
+        qcache_key(cd, &key, &refresh)) {
+        if (!refresh && NULL != (qc = qcache_find(&key))) {
+            PMIX_BYTE_OBJECT_DESTRUCT(&key);
+            pmix_output_verbose(2, pmix_server_globals.base_output,
+                                "query answered from cache");
+            PMIX_INFO_CREATE(cd->info, qc->ninfo);
+            if (NULL == cd->info) {
+                rc = PMIX_ERR_NOMEM;
+                goto exit;
+            }
+            cd->ninfo = qc->ninfo;
+            for (n=0; n < qc->ninfo; n++) {
+                PMIX_INFO_XFER(&cd->info[n], &qc->info[n]);
+            }
+            /* the callback releases cd along with the results */
+            cbfunc(PMIX_SUCCESS, cd->info, cd->ninfo, cd, NULL, NULL);
+            return PMIX_SUCCESS;
+        }
+        /* have the answer kept on its way back */
+        req = PMIX_NEW(pmix_qcache_req_t);
+        if (NULL == req) {
+            PMIX_BYTE_OBJECT_DESTRUCT(&key);
+            rc = PMIX_ERR_NOMEM;
+            goto exit;
+        }
+        req->cd = cd;
+        req->cbfunc = cbfunc;
+        req->key = key;
+        rc = pmix_host_server.query(&proc, cd->queries, cd->nqueries,
+                                    qcache_cbfunc, req);
         if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
+            PMIX_RELEASE(req);
             goto exit;
         }
+        return PMIX_SUCCESS;
     }
-
-    /* setup the requesting peer name */
-    pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
-    proc.rank = peer->info->pname.rank;
+    PMIX_BYTE_OBJECT_DESTRUCT(&key);
 
     /* ask the host for the info */
     if (PMIX_SUCCESS != (rc = pmix_host_server.query(&proc, cd->queries, cd->nqueries,
@@ -2427,6 +3924,133 @@ static PMIX_CLASS_INSTANCE(pmix_srvr_epi_caddy_t,
                            pmix_list_item_t,
                            NULL, NULL);
 
+static bool jctrl_cleanup_key(const char *key)
+{
+    return (0 == strncmp(key, PMIX_REGISTER_CLEANUP, PMIX_MAX_KEYLEN) ||
+            0 == strncmp(key, PMIX_REGISTER_CLEANUP_DIR, PMIX_MAX_KEYLEN) ||
+            0 == strncmp(key, PMIX_CLEANUP_RECURSIVE, PMIX_MAX_KEYLEN) ||
+            0 == strncmp(key, PMIX_CLEANUP_IGNORE, PMIX_MAX_KEYLEN) ||
+            0 == strncmp(key, PMIX_CLEANUP_LEAVE_TOPDIR, PMIX_MAX_KEYLEN));
+}
+
+/* signal a local rank ourselves - returns false if it has to
+ * be left to the host */
+static bool jctrl_signal_rank(pmix_rank_info_t *info, int sig)
+{
+    if (NULL == info || 0 > info->peerid || 0 >= info->pid) {
+        return false;
+    }
+    if (0 != kill(info->pid, sig) && ESRCH != errno) {
+        return false;
+    }
+    return true;
+}
+
+/* if the request is nothing but a signal or kill, deliver it to
+ * the targets that are our own clients. Returns PMIX_OPERATION_SUCCEEDED
+ * if nothing is left for the host, PMIX_SUCCESS if cd->targets now
+ * holds only the procs the host must handle, or an error if we
+ * can't help */
+static pmix_status_t jctrl_local(pmix_peer_t *peer, pmix_query_caddy_t *cd)
+{
+    pmix_namespace_t *nptr;
+    pmix_rank_info_t *info;
+    pmix_proc_t *remote;
+    size_t n, nremote;
+    pmix_status_t rc;
+    int sig = 0;
+    bool local;
+
+    for (n=0; n < cd->ninfo; n++) {
+        if (jctrl_cleanup_key(cd->info[n].key)) {
+            continue;
+        }
+        if (0 != sig) {
+            /* more than one action - leave it to the host */
+            return PMIX_ERR_TAKE_NEXT_OPTION;
+        }
+        if (PMIX_CHECK_KEY(&cd->info[n], PMIX_JOB_CTRL_SIGNAL)) {
+            PMIX_VALUE_GET_NUMBER(rc, &cd->info[n].value, sig, int);
+            if (PMIX_SUCCESS != rc || 0 >= sig) {
+                return PMIX_ERR_TAKE_NEXT_OPTION;
+            }
+        } else if (PMIX_CHECK_KEY(&cd->info[n], PMIX_JOB_CTRL_KILL) &&
+                   PMIX_INFO_TRUE(&cd->info[n])) {
+            sig = SIGKILL;
+        } else {
+            return PMIX_ERR_TAKE_NEXT_OPTION;
+        }
+    }
+    if (0 == sig) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    if (NULL == cd->targets) {
+        /* the requestor's own job */
+        PMIX_PROC_CREATE(cd->targets, 1);
+        if (NULL == cd->targets) {
+            return PMIX_ERR_NOMEM;
+        }
+        cd->ntargets = 1;
+        PMIX_LOAD_PROCID(&cd->targets[0], peer->nptr->nspace, PMIX_RANK_WILDCARD);
+    }
+
+    PMIX_PROC_CREATE(remote, cd->ntargets);
+    if (NULL == remote) {
+        return PMIX_ERR_NOMEM;
+    }
+    nremote = 0;
+    for (n=0; n < cd->ntargets; n++) {
+        nptr = NULL;
+        nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, cd->targets[n].nspace);
+        local = false;
+        if (NULL == nptr) {
+            /* not one of ours */
+        } else if (PMIX_RANK_WILDCARD == cd->targets[n].rank) {
+            /* we can only take the whole job - the host
+             * cannot be asked to skip the ranks we signal */
+            if (nptr->all_registered && 0 < nptr->nprocs &&
+                nptr->nprocs == nptr->nlocalprocs) {
+                local = true;
+                PMIX_LIST_FOREACH(info, &nptr->ranks, pmix_rank_info_t) {
+                    if (0 > info->peerid || 0 >= info->pid) {
+                        local = false;
+                        break;
+                    }
+                }
+                if (local) {
+                    PMIX_LIST_FOREACH(info, &nptr->ranks, pmix_rank_info_t) {
+                        if (!jctrl_signal_rank(info, sig)) {
+                            local = false;
+                        }
+                    }
+                }
+            }
+        } else {
+            info = pmix_nspace_find_rank(nptr, cd->targets[n].rank);
+            local = jctrl_signal_rank(info, sig);
+        }
+        if (!local) {
+            memcpy(&remote[nremote], &cd->targets[n], sizeof(pmix_proc_t));
+            ++nremote;
+        }
+    }
+
+    pmix_output_verbose(2, pmix_server_globals.base_output,
+                        "job control: signal %d delivered locally to %lu of %lu targets",
+                        sig, (unsigned long)(cd->ntargets - nremote),
+                        (unsigned long)cd->ntargets);
+
+    if (0 == nremote) {
+        PMIX_PROC_FREE(remote, cd->ntargets);
+        return PMIX_OPERATION_SUCCEEDED;
+    }
+    PMIX_PROC_FREE(cd->targets, cd->ntargets);
+    cd->targets = remote;
+    cd->ntargets = nremote;
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer,
                                    pmix_buffer_t *buf,
                                    pmix_info_cbfunc_t cbfunc,
@@ -2435,7 +4059,7 @@ pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer,
     int32_t cnt, m;
     pmix_status_t rc;
     pmix_query_caddy_t *cd;
-    pmix_namespace_t *nptr, *tmp;
+    pmix_namespace_t *nptr;
     pmix_peer_t *pr;
     pmix_proc_t proc;
     size_t n;
@@ -2448,7 +4072,8 @@ pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer,
     pmix_output_verbose(2, pmix_server_globals.base_output,
                         "recvd job control request from client");
 
-    if (NULL == pmix_host_server.job_control) {
+    if (NULL == pmix_host_server.job_control &&
+        !pmix_server_globals.job_ctrl_local) {
         return PMIX_ERR_NOT_SUPPORTED;
     }
 
@@ -2486,12 +4111,7 @@ pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer,
         for (n=0; n < cd->ntargets; n++) {
             /* find the nspace of this proc */
             nptr = NULL;
-            PMIX_LIST_FOREACH(tmp, &pmix_server_globals.nspaces, pmix_namespace_t) {
-                if (0 == strcmp(tmp->nspace, cd->targets[n].nspace)) {
-                    nptr = tmp;
-                    break;
-                }
-            }
+            nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, cd->targets[n].nspace);
             if (NULL == nptr) {
                 nptr = PMIX_NEW(pmix_namespace_t);
                 if (NULL == nptr) {
@@ -2499,7 +4119,7 @@ pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer,
                     goto exit;
                 }
                 nptr->nspace = strdup(cd->targets[n].nspace);
-                pmix_list_append(&pmix_server_globals.nspaces, &nptr->super);
+                pmix_nspace_add(&pmix_server_globals.nspaces, nptr);
             }
             /* if the rank is wildcard, then we use the epilog for the nspace */
             if (PMIX_RANK_WILDCARD == cd->targets[n].rank) {
@@ -2706,6 +4326,19 @@ pmix_status_t pmix_server_job_ctrl(pmix_peer_t *peer,
         }
     }
 
+    /* signals and kills for our own clients can be delivered
+     * here - only whatever is left goes to the host */
+    if (pmix_server_globals.job_ctrl_local) {
+        rc = jctrl_local(peer, cd);
+        if (PMIX_OPERATION_SUCCEEDED == rc || PMIX_ERR_NOMEM == rc) {
+            goto exit;
+        }
+    }
+    if (NULL == pmix_host_server.job_control) {
+        rc = PMIX_ERR_NOT_SUPPORTED;
+        goto exit;
+    }
+
     /* setup the requesting peer name */
     pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
     proc.rank = peer->info->pname.rank;
@@ -2941,6 +4574,9 @@ pmix_status_t pmix_server_validate_credential(pmix_peer_t *peer,
     return rc;
 }
 
+static pmix_iof_batch_t* iof_batch(pmix_peer_t *peer);
+static void iof_batch_timeout(int sd, short args, void *cbdata);
+
 pmix_status_t pmix_server_iofreg(pmix_peer_t *peer,
                                  pmix_buffer_t *buf,
                                  pmix_op_cbfunc_t cbfunc,
@@ -2950,11 +4586,10 @@ pmix_status_t pmix_server_iofreg(pmix_peer_t *peer,
     pmix_status_t rc;
     pmix_setup_caddy_t *cd;
     pmix_iof_req_t *req;
-    bool notify, match;
+    pmix_iof_batch_t *batch;
+    bool notify, match, batched = false;
     size_t n;
-    int i;
-    pmix_setup_caddy_t *occupant;
-    pmix_buffer_t *msg;
+    uint32_t bsize = 0, btime = 0;
 
     pmix_output_verbose(2, pmix_server_globals.iof_output,
                         "recvd IOF PULL request from client");
@@ -3013,6 +4648,49 @@ pmix_status_t pmix_server_iofreg(pmix_peer_t *peer,
         goto exit;
     }
 
+    /* see if the requestor can take its output in batches */
+    for (n=0; n < cd->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&cd->info[n], PMIX_IOF_BATCH_KEY)) {
+            batched = PMIX_INFO_TRUE(&cd->info[n]);
+        } else if (PMIX_CHECK_KEY(&cd->info[n], PMIX_IOF_BUFFERING_SIZE)) {
+            PMIX_VALUE_GET_NUMBER(rc, &cd->info[n].value, bsize, uint32_t);
+        } else if (PMIX_CHECK_KEY(&cd->info[n], PMIX_IOF_BUFFERING_TIME)) {
+            PMIX_VALUE_GET_NUMBER(rc, &cd->info[n].value, btime, uint32_t);
+        }
+    }
+    if (batched &&
+        (0 < bsize || 0 < btime || 0 < pmix_server_globals.iof_batch_msec)) {
+        if (NULL == (batch = iof_batch(peer))) {
+            batch = PMIX_NEW(pmix_iof_batch_t);
+            if (NULL == batch) {
+                rc = PMIX_ERR_NOMEM;
+                goto exit;
+            }
+            PMIX_RETAIN(peer);
+            batch->peer = peer;
+            pmix_event_evtimer_set(pmix_globals.evbase, &batch->ev,
+                                   iof_batch_timeout, batch);
+            pmix_list_append(&pmix_server_globals.iof_batches, &batch->super);
+        }
+        batch->limit = (0 < bsize) ? bsize : pmix_server_globals.iof_batch_size;
+        if (0 < btime) {
+            batch->hold.tv_sec = btime;
+            batch->hold.tv_usec = 0;
+        } else if (0 < pmix_server_globals.iof_batch_msec) {
+            batch->hold.tv_sec = pmix_server_globals.iof_batch_msec / 1000;
+            batch->hold.tv_usec = (pmix_server_globals.iof_batch_msec % 1000) * 1000;
+        } else {
+            /* they only gave a size - don't hold output forever */
+            batch->hold.tv_sec = 1;
+            batch->hold.tv_usec = 0;
+        }
+        pmix_output_verbose(2, pmix_server_globals.iof_output,
+                            "IOF for %s:%u batched up to %lu bytes",
+                            peer->info->pname.nspace, peer->info->pname.rank,
+                            (unsigned long)batch->limit);
+    }
+    rc = PMIX_SUCCESS;
+
     /* check to see if we have already registered this source/channel combination */
     notify = false;
     for (n=0; n < cd->nprocs; n++) {
@@ -3051,55 +4729,7 @@ pmix_status_t pmix_server_iofreg(pmix_peer_t *peer,
             pmix_list_append(&pmix_globals.iof_requests, &req->super);
         }
         /* process any cached IO */
-        for (i=0; i < PMIX_IOF_HOTEL_SIZE; i++) {
-            pmix_hotel_knock(&pmix_server_globals.iof, PMIX_IOF_HOTEL_SIZE-i-1, (void**)&occupant);
-            if (NULL != occupant) {
-                if (!(occupant->channels & req->channels)) {
-                    continue;
-                }
-                /* if the source matches the request, then forward this along */
-                if (0 != strncmp(occupant->procs->nspace, req->pname.nspace, PMIX_MAX_NSLEN) ||
-                    (PMIX_RANK_WILDCARD != req->pname.rank && occupant->procs->rank != req->pname.rank)) {
-                    continue;
-                }
-                /* setup the msg */
-                if (NULL == (msg = PMIX_NEW(pmix_buffer_t))) {
-                    PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
-                    rc = PMIX_ERR_OUT_OF_RESOURCE;
-                    break;
-                }
-                /* provide the source */
-                PMIX_BFROPS_PACK(rc, req->peer, msg, occupant->procs, 1, PMIX_PROC);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(msg);
-                    break;
-                }
-                /* provide the channel */
-                PMIX_BFROPS_PACK(rc, req->peer, msg, &occupant->channels, 1, PMIX_IOF_CHANNEL);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(msg);
-                    break;
-                }
-                /* pack the data */
-                PMIX_BFROPS_PACK(rc, req->peer, msg, occupant->bo, 1, PMIX_BYTE_OBJECT);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(msg);
-                    break;
-                }
-                /* send it to the requestor */
-                PMIX_PTL_SEND_ONEWAY(rc, req->peer, msg, PMIX_PTL_TAG_IOF);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_RELEASE(msg);
-                }
-                /* remove it from the hotel since it has now been forwarded */
-                pmix_hotel_checkout(&pmix_server_globals.iof, PMIX_IOF_HOTEL_SIZE-i-1);
-                PMIX_RELEASE(occupant);
-            }
-        }
+        rc = pmix_server_iof_replay(req, false);
     }
     if (notify) {
         /* ask the host to execute the request */
@@ -3117,6 +4747,350 @@ pmix_status_t pmix_server_iofreg(pmix_peer_t *peer,
     return rc;
 }
 
+static pmix_iof_residency_t* iof_residency(const char *nspace)
+{
+    pmix_iof_residency_t *res;
+
+    PMIX_LIST_FOREACH(res, &pmix_server_globals.iof, pmix_iof_residency_t) {
+        if (0 == strncmp(res->nspace, nspace, PMIX_MAX_NSLEN)) {
+            return res;
+        }
+    }
+    return NULL;
+}
+
+/* release the oldest cached IO across all sources */
+static void iof_evict(void)
+{
+    pmix_iof_residency_t *res, *oldest = NULL;
+    pmix_iof_cache_t *ic = NULL, *first;
+
+    PMIX_LIST_FOREACH(res, &pmix_server_globals.iof, pmix_iof_residency_t) {
+        first = (pmix_iof_cache_t*)pmix_list_get_first(&res->cache);
+        if (NULL == oldest || first->seq < ic->seq) {
+            oldest = res;
+            ic = first;
+        }
+    }
+    if (NULL == oldest) {
+        return;
+    }
+    pmix_output_verbose(2, pmix_server_globals.iof_output,
+                        "IOF cache full - dropping %lu bytes from %s",
+                        (unsigned long)ic->size, PMIX_NAME_PRINT(ic->cd->procs));
+    pmix_list_remove_item(&oldest->cache, &ic->super);
+    pmix_server_globals.iof_size -= ic->size;
+    PMIX_RELEASE(ic);
+    if (pmix_list_is_empty(&oldest->cache)) {
+        pmix_list_remove_item(&pmix_server_globals.iof, &oldest->super);
+        PMIX_RELEASE(oldest);
+    }
+}
+
+pmix_status_t pmix_server_iof_cache(pmix_setup_caddy_t *cd)
+{
+    pmix_iof_residency_t *res;
+    pmix_iof_cache_t *ic;
+    size_t n;
+
+    if (NULL == (res = iof_residency(cd->procs->nspace))) {
+        res = PMIX_NEW(pmix_iof_residency_t);
+        if (NULL == res) {
+            return PMIX_ERR_NOMEM;
+        }
+        if (NULL == (res->nspace = strdup(cd->procs->nspace))) {
+            PMIX_RELEASE(res);
+            return PMIX_ERR_NOMEM;
+        }
+        pmix_list_append(&pmix_server_globals.iof, &res->super);
+    }
+    ic = PMIX_NEW(pmix_iof_cache_t);
+    if (NULL == ic) {
+        if (pmix_list_is_empty(&res->cache)) {
+            pmix_list_remove_item(&pmix_server_globals.iof, &res->super);
+            PMIX_RELEASE(res);
+        }
+        return PMIX_ERR_NOMEM;
+    }
+    ic->cd = cd;
+    ic->seq = pmix_server_globals.iof_seq++;
+    ic->size = sizeof(pmix_setup_caddy_t);
+    for (n=0; n < cd->nbo; n++) {
+        ic->size += cd->bo[n].size;
+    }
+    pmix_list_append(&res->cache, &ic->super);
+    pmix_server_globals.iof_size += ic->size;
+
+    /* make room by dropping the oldest output - which may
+     * include this one if it alone exceeds the budget */
+    while (pmix_server_globals.iof_cache_size < pmix_server_globals.iof_size) {
+        iof_evict();
+    }
+    return PMIX_SUCCESS;
+}
+
+static pmix_iof_batch_t* iof_batch(pmix_peer_t *peer)
+{
+    pmix_iof_batch_t *batch;
+
+    PMIX_LIST_FOREACH(batch, &pmix_server_globals.iof_batches, pmix_iof_batch_t) {
+        if (peer == batch->peer) {
+            return batch;
+        }
+    }
+    return NULL;
+}
+
+/* send one message holding everything in the batch */
+static void iof_batch_flush(pmix_iof_batch_t *batch)
+{
+    pmix_iof_chunk_t *chunk;
+    pmix_buffer_t bucket, *msg;
+    pmix_byte_object_t pbo;
+    pmix_status_t rc = PMIX_SUCCESS;
+    uint8_t *cbytes;
+    size_t csize, n;
+    bool compressed = false;
+
+    if (batch->active) {
+        pmix_event_del(&batch->ev);
+        batch->active = false;
+    }
+    if (0 == (n = pmix_list_get_size(&batch->chunks))) {
+        return;
+    }
+    /* nobody left to send it to */
+    if (NULL == batch->peer->info || batch->peer->finalized) {
+        goto done;
+    }
+
+    PMIX_CONSTRUCT(&bucket, pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, batch->peer, &bucket, &n, 1, PMIX_SIZE);
+    PMIX_LIST_FOREACH(chunk, &batch->chunks, pmix_iof_chunk_t) {
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        PMIX_BFROPS_PACK(rc, batch->peer, &bucket, &chunk->source, 1, PMIX_PROC);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, batch->peer, &bucket, &chunk->channel, 1, PMIX_IOF_CHANNEL);
+        }
+        if (PMIX_SUCCESS == rc) {
+            PMIX_BFROPS_PACK(rc, batch->peer, &bucket, &chunk->bo, 1, PMIX_BYTE_OBJECT);
+        }
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DESTRUCT(&bucket);
+        goto done;
+    }
+    /* output is usually quite repetitive, so large
+     * batches are worth compressing */
+    if (0 < pmix_server_globals.iof_compress &&
+        pmix_server_globals.iof_compress < bucket.bytes_used &&
+        pmix_util_compress_block((uint8_t*)bucket.base_ptr, bucket.bytes_used,
+                                 &cbytes, &csize)) {
+        pmix_output_verbose(2, pmix_server_globals.iof_output,
+                            "IOF batch - compressed %lu bytes of output to %lu",
+                            (unsigned long)bucket.bytes_used, (unsigned long)csize);
+        compressed = true;
+        pbo.bytes = (char*)cbytes;
+        pbo.size = csize;
+        PMIX_DESTRUCT(&bucket);
+    } else {
+        PMIX_UNLOAD_BUFFER(&bucket, pbo.bytes, pbo.size);
+        PMIX_DESTRUCT(&bucket);
+    }
+
+    pmix_output_verbose(2, pmix_server_globals.iof_output,
+                        "IOF batch of %lu runs (%lu bytes) to %s:%u",
+                        (unsigned long)n, (unsigned long)batch->bytes,
+                        batch->peer->info->pname.nspace, batch->peer->info->pname.rank);
+    msg = PMIX_NEW(pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, batch->peer, msg, &compressed, 1, PMIX_BOOL);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, batch->peer, msg, &pbo, 1, PMIX_BYTE_OBJECT);
+    }
+    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_PTL_SEND_ONEWAY(rc, batch->peer, msg, PMIX_PTL_TAG_IOF_BATCH);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(msg);
+    }
+
+  done:
+    PMIX_LIST_DESTRUCT(&batch->chunks);
+    PMIX_CONSTRUCT(&batch->chunks, pmix_list_t);
+    batch->bytes = 0;
+}
+
+static void iof_batch_timeout(int sd, short args, void *cbdata)
+{
+    pmix_iof_batch_t *batch = (pmix_iof_batch_t*)cbdata;
+
+    PMIX_ACQUIRE_OBJECT(batch);
+    batch->active = false;
+    iof_batch_flush(batch);
+}
+
+void pmix_server_iof_unbatch(pmix_peer_t *peer, const pmix_proc_t *proc)
+{
+    pmix_iof_batch_t *batch, *bnxt;
+
+    PMIX_LIST_FOREACH_SAFE(batch, bnxt, &pmix_server_globals.iof_batches, pmix_iof_batch_t) {
+        if ((NULL != peer && batch->peer == peer) ||
+            (NULL != proc && NULL != batch->peer->info &&
+             PMIX_CHECK_PROCID(&batch->peer->info->pname, proc))) {
+            pmix_list_remove_item(&pmix_server_globals.iof_batches, &batch->super);
+            iof_batch_flush(batch);
+            PMIX_RELEASE(batch);
+        }
+    }
+}
+
+pmix_status_t pmix_server_iof_forward(pmix_peer_t *peer,
+                                      const pmix_proc_t *source,
+                                      pmix_iof_channel_t channel,
+                                      const pmix_byte_object_t *bo)
+{
+    pmix_iof_batch_t *batch;
+    pmix_iof_chunk_t *chunk;
+    pmix_buffer_t *msg;
+    pmix_status_t rc;
+    char *tmp;
+
+    if (NULL != (batch = iof_batch(peer))) {
+        /* output from a source that was also the last to be
+         * held is merged into that run - runs are kept in
+         * arrival order, so each source's order is preserved */
+        chunk = (pmix_iof_chunk_t*)pmix_list_get_last(&batch->chunks);
+        if (!pmix_list_is_empty(&batch->chunks) &&
+            channel == chunk->channel &&
+            PMIX_CHECK_PROCID(source, &chunk->source)) {
+            tmp = (char*)realloc(chunk->bo.bytes, chunk->bo.size + bo->size);
+            if (NULL == tmp) {
+                return PMIX_ERR_NOMEM;
+            }
+            memcpy(tmp + chunk->bo.size, bo->bytes, bo->size);
+            chunk->bo.bytes = tmp;
+            chunk->bo.size += bo->size;
+        } else {
+            chunk = PMIX_NEW(pmix_iof_chunk_t);
+            if (NULL == chunk) {
+                return PMIX_ERR_NOMEM;
+            }
+            PMIX_LOAD_PROCID(&chunk->source, source->nspace, source->rank);
+            chunk->channel = channel;
+            if (0 < bo->size) {
+                if (NULL == (chunk->bo.bytes = (char*)malloc(bo->size))) {
+                    PMIX_RELEASE(chunk);
+                    return PMIX_ERR_NOMEM;
+                }
+                memcpy(chunk->bo.bytes, bo->bytes, bo->size);
+                chunk->bo.size = bo->size;
+            }
+            pmix_list_append(&batch->chunks, &chunk->super);
+        }
+        batch->bytes += bo->size;
+        if (batch->limit <= batch->bytes) {
+            iof_batch_flush(batch);
+        } else if (!batch->active) {
+            batch->active = true;
+            PMIX_POST_OBJECT(batch);
+            pmix_event_evtimer_add(&batch->ev, &batch->hold);
+        }
+        return PMIX_SUCCESS;
+    }
+
+    /* setup the msg */
+    if (NULL == (msg = PMIX_NEW(pmix_buffer_t))) {
+        PMIX_ERROR_LOG(PMIX_ERR_OUT_OF_RESOURCE);
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    /* provide the source */
+    PMIX_BFROPS_PACK(rc, peer, msg, source, 1, PMIX_PROC);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(msg);
+        return rc;
+    }
+    /* provide the channel */
+    PMIX_BFROPS_PACK(rc, peer, msg, &channel, 1, PMIX_IOF_CHANNEL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(msg);
+        return rc;
+    }
+    /* pack the data */
+    PMIX_BFROPS_PACK(rc, peer, msg, bo, 1, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(msg);
+        return rc;
+    }
+    /* send it to the requestor */
+    PMIX_PTL_SEND_ONEWAY(rc, peer, msg, PMIX_PTL_TAG_IOF);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(msg);
+    }
+    return rc;
+}
+
+pmix_status_t pmix_server_iof_replay(pmix_iof_req_t *req, bool skipself)
+{
+    pmix_iof_residency_t *res;
+    pmix_iof_cache_t *ic, *next;
+    pmix_setup_caddy_t *occupant;
+    pmix_status_t rc = PMIX_SUCCESS;
+
+    if (NULL == (res = iof_residency(req->pname.nspace))) {
+        return PMIX_SUCCESS;
+    }
+
+    PMIX_LIST_FOREACH_SAFE(ic, next, &res->cache, pmix_iof_cache_t) {
+        occupant = ic->cd;
+        if (!(occupant->channels & req->channels)) {
+            continue;
+        }
+        /* if the source matches the request, then forward this along */
+        if (PMIX_RANK_WILDCARD != req->pname.rank && occupant->procs->rank != req->pname.rank) {
+            continue;
+        }
+        /* never forward back to the source! This can happen if the source
+         * is a launcher */
+        if (skipself &&
+            0 == strncmp(occupant->procs->nspace, req->peer->info->pname.nspace, PMIX_MAX_NSLEN) &&
+            occupant->procs->rank == req->peer->info->pname.rank) {
+            continue;
+        }
+        /* send it to the requestor */
+        rc = pmix_server_iof_forward(req->peer, occupant->procs,
+                                     occupant->channels, occupant->bo);
+        if (PMIX_ERR_OUT_OF_RESOURCE == rc || PMIX_ERR_NOMEM == rc) {
+            break;
+        }
+        /* remove it from the cache since it has now been forwarded */
+        pmix_list_remove_item(&res->cache, &ic->super);
+        pmix_server_globals.iof_size -= ic->size;
+        PMIX_RELEASE(ic);
+    }
+    if (pmix_list_is_empty(&res->cache)) {
+        pmix_list_remove_item(&pmix_server_globals.iof, &res->super);
+        PMIX_RELEASE(res);
+    }
+    return rc;
+}
+
+void pmix_server_iof_purge(void)
+{
+    PMIX_LIST_DESTRUCT(&pmix_server_globals.iof);
+    pmix_server_globals.iof_size = 0;
+    /* anything still batched goes nowhere */
+    PMIX_LIST_DESTRUCT(&pmix_server_globals.iof_batches);
+}
+
 static void stdcbfunc(pmix_status_t status, void *cbdata)
 {
     pmix_setup_caddy_t *cd = (pmix_setup_caddy_t*)cbdata;
@@ -3136,6 +5110,49 @@ static void stdcbfunc(pmix_status_t status, void *cbdata)
     PMIX_RELEASE(cd);
 }
 
+static void stdin_collapse_targets(pmix_setup_caddy_t *cd)
+{
+    size_t n, m, nkeep = 0;
+    bool *drop;
+
+    if (cd->nprocs < 2) {
+        return;
+    }
+    drop = (bool*)calloc(cd->nprocs, sizeof(bool));
+    if (NULL == drop) {
+        return;
+    }
+    for (n=0; n < cd->nprocs; n++) {
+        for (m=0; m < cd->nprocs && !drop[n]; m++) {
+            if (m == n ||
+                !PMIX_CHECK_NSPACE(cd->procs[m].nspace, cd->procs[n].nspace)) {
+                continue;
+            }
+            if (PMIX_RANK_WILDCARD == cd->procs[m].rank) {
+                /* a wildcard covers every other rank, and
+                 * the first of several wildcards is kept */
+                drop[n] = (PMIX_RANK_WILDCARD != cd->procs[n].rank || m < n);
+            } else if (m < n && cd->procs[m].rank == cd->procs[n].rank) {
+                drop[n] = true;
+            }
+        }
+    }
+    for (n=0; n < cd->nprocs; n++) {
+        if (drop[n]) {
+            continue;
+        }
+        if (nkeep != n) {
+            memcpy(&cd->procs[nkeep], &cd->procs[n], sizeof(pmix_proc_t));
+        }
+        nkeep++;
+    }
+    free(drop);
+    pmix_output_verbose(2, pmix_server_globals.iof_output,
+                        "stdin broadcast: %lu targets reduced to %lu",
+                        (unsigned long)cd->nprocs, (unsigned long)nkeep);
+    cd->nprocs = nkeep;
+}
+
 pmix_status_t pmix_server_iofstdin(pmix_peer_t *peer,
                                    pmix_buffer_t *buf,
                                    pmix_op_cbfunc_t cbfunc,
@@ -3145,6 +5162,7 @@ pmix_status_t pmix_server_iofstdin(pmix_peer_t *peer,
     pmix_status_t rc;
     pmix_proc_t source;
     pmix_setup_caddy_t *cd;
+    size_t n;
 
     pmix_output_verbose(2, pmix_server_globals.iof_output,
                         "recvd stdin IOF data from tool");
@@ -3216,6 +5234,18 @@ pmix_status_t pmix_server_iofstdin(pmix_peer_t *peer,
         goto error;
     }
 
+    /* if the sender wants this broadcast, then the host only
+     * needs to hear about each target once - drop repeats and
+     * ranks already covered by a wildcard in the same nspace */
+    for (n=0; n < cd->ninfo; n++) {
+        if (PMIX_CHECK_KEY(&cd->info[n], PMIX_IOF_BCAST)) {
+            if (PMIX_INFO_TRUE(&cd->info[n])) {
+                stdin_collapse_targets(cd);
+            }
+            break;
+        }
+    }
+
     /* pass the data to the host */
     pmix_strncpy(source.nspace, peer->nptr->nspace, PMIX_MAX_NSLEN);
     source.rank = peer->info->pname.rank;
@@ -3263,8 +5293,227 @@ static void grp_timeout(int sd, short args, void *cbdata)
   error:
     cd->event_active = false;
     /* remove it from the list */
-    pmix_list_remove_item(&cd->trk->local_cbs, &cd->super);
+    pmix_server_trk_del_local(cd);
+    PMIX_RELEASE(cd);
+}
+
+/* the endpoint data returned by a group construct is stored for the
+ * local participants like that of a fence. Also keep a copy in our
+ * own GDS under each member's nspace - members from nspaces that
+ * have no local procs would otherwise be looked up by direct modex */
+static pmix_status_t _grp_store_endpt(pmix_gds_base_store_modex_cbdata_t cbdata,
+                                      struct pmix_namespace_t *nspace,
+                                      pmix_list_t *cbs,
+                                      pmix_byte_object_t *bo)
+{
+    pmix_buffer_t pbkt;
+    pmix_proc_t proc;
+    pmix_kval_t *kv;
+    int32_t cnt;
+    pmix_status_t rc;
+
+    PMIX_CONSTRUCT(&pbkt, pmix_buffer_t);
+    PMIX_LOAD_BUFFER(pmix_globals.mypeer, &pbkt, bo->bytes, bo->size);
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &pbkt, &proc, &cnt, PMIX_PROC);
+    if (PMIX_SUCCESS == rc) {
+        kv = PMIX_NEW(pmix_kval_t);
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &pbkt, kv, &cnt, PMIX_KVAL);
+        while (PMIX_SUCCESS == rc) {
+            PMIX_GDS_STORE_KV(rc, pmix_globals.mypeer, &proc, PMIX_REMOTE, kv);
+            PMIX_RELEASE(kv);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                kv = NULL;
+                break;
+            }
+            kv = PMIX_NEW(pmix_kval_t);
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, pmix_globals.mypeer, &pbkt, kv, &cnt, PMIX_KVAL);
+        }
+        if (NULL != kv) {
+            PMIX_RELEASE(kv);
+        }
+        if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER == rc) {
+            rc = PMIX_SUCCESS;
+        }
+    }
+    /* loading the buffer took the bytes from the byte object */
+    bo->bytes = pbkt.base_ptr;
+    bo->size = pbkt.bytes_used;
+    pbkt.base_ptr = NULL;
+    PMIX_DESTRUCT(&pbkt);
+    return rc;
+}
+
+bool pmix_server_group_endpt_known(const char *nspace, pmix_rank_t rank)
+{
+    pmix_group_t *grp;
+    size_t n;
+
+    PMIX_LIST_FOREACH(grp, &pmix_server_globals.groups, pmix_group_t) {
+        if (!grp->endpts) {
+            continue;
+        }
+        for (n=0; n < grp->nmbrs; n++) {
+            if (PMIX_CHECK_NSPACE(grp->members[n].nspace, nspace) &&
+                (rank == grp->members[n].rank ||
+                 PMIX_RANK_WILDCARD == grp->members[n].rank)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/* groups tend to be constructed and destructed at a high rate
+ * (e.g., one per communicator), so released group objects are
+ * kept on a short list for reuse instead of being freed */
+#define PMIX_SERVER_GRP_CACHE_MAX   32
+
+static pmix_group_t* grp_get(void)
+{
+    pmix_group_t *grp;
+
+    grp = (pmix_group_t*)pmix_list_remove_first(&pmix_server_globals.grp_cache);
+    if (NULL == grp) {
+        grp = PMIX_NEW(pmix_group_t);
+    }
+    return grp;
+}
+
+static void grp_put(pmix_group_t *grp)
+{
+    if (PMIX_SERVER_GRP_CACHE_MAX <= pmix_list_get_size(&pmix_server_globals.grp_cache)) {
+        PMIX_RELEASE(grp);
+        return;
+    }
+    if (NULL != grp->grpid) {
+        free(grp->grpid);
+        grp->grpid = NULL;
+    }
+    if (NULL != grp->members) {
+        PMIX_PROC_FREE(grp->members, grp->nmbrs);
+        grp->members = NULL;
+    }
+    grp->nmbrs = 0;
+    grp->ctxid = SIZE_MAX;
+    grp->endpts = false;
+    grp->nleft = 0;
+    pmix_list_append(&pmix_server_globals.grp_cache, &grp->super);
+}
+
+/* count the group members that are local clients of ours */
+static size_t grp_nlocal(pmix_group_t *grp)
+{
+    pmix_namespace_t *nptr;
+    size_t n, nlocal = 0;
+
+    for (n=0; n < grp->nmbrs; n++) {
+        nptr = NULL;
+        nptr = pmix_nspace_lookup(&pmix_server_globals.nspaces, grp->members[n].nspace);
+        if (NULL == nptr) {
+            continue;
+        }
+        if (PMIX_RANK_WILDCARD == grp->members[n].rank) {
+            nlocal += pmix_list_get_size(&nptr->ranks);
+            continue;
+        }
+        if (NULL != pmix_nspace_find_rank(nptr, grp->members[n].rank)) {
+            ++nlocal;
+        }
+    }
+    return nlocal;
+}
+
+static void _lazy_grpcbfunc(int sd, short args, void *cbdata)
+{
+    pmix_shift_caddy_t *scd = (pmix_shift_caddy_t*)cbdata;
+
+    PMIX_ACQUIRE_OBJECT(scd);
+    grp_put((pmix_group_t*)scd->cbdata);
+    PMIX_INFO_FREE(scd->directives, scd->ndirs);
+    PMIX_RELEASE(scd);
+}
+
+static void lazy_grpcbfunc(pmix_status_t status,
+                           pmix_info_t *info, size_t ninfo,
+                           void *cbdata,
+                           pmix_release_cbfunc_t relfn,
+                           void *relcbd)
+{
+    pmix_shift_caddy_t *scd = (pmix_shift_caddy_t*)cbdata;
+
+    /* nobody is waiting on the result */
+    if (NULL != relfn) {
+        relfn(relcbd);
+    }
+    /* need to thread-shift to recycle the group object */
+    PMIX_THREADSHIFT(scd, _lazy_grpcbfunc);
+}
+
+/* a lazy destruct releases the caller at once - no collective is
+ * run across the members. Once all of our local members have left,
+ * the group is dropped and the host is told so it can drop any
+ * state of its own */
+static pmix_status_t grp_lazy_destruct(pmix_server_caddy_t *cd,
+                                       pmix_group_t *grp)
+{
+    pmix_buffer_t *reply;
+    pmix_status_t ret, rc = PMIX_SUCCESS;
+    pmix_shift_caddy_t *scd;
+
+    reply = PMIX_NEW(pmix_buffer_t);
+    if (NULL == reply) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_BFROPS_PACK(ret, cd->peer, reply, &rc, 1, PMIX_STATUS);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_RELEASE(reply);
+        return ret;
+    }
+    PMIX_SERVER_QUEUE_REPLY(ret, cd->peer, cd->hdr.tag, reply);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_RELEASE(reply);
+    }
     PMIX_RELEASE(cd);
+
+    ++grp->nleft;
+    if (grp->nleft < grp_nlocal(grp)) {
+        return PMIX_SUCCESS;
+    }
+
+    pmix_output_verbose(2, pmix_server_globals.base_output,
+                        "all local members left group %s", grp->grpid);
+    pmix_list_remove_item(&pmix_server_globals.groups, &grp->super);
+    if (NULL == pmix_host_server.group) {
+        grp_put(grp);
+        return PMIX_SUCCESS;
+    }
+    /* the host may hold the group ID and membership until it
+     * calls back, so keep the object until then */
+    scd = PMIX_NEW(pmix_shift_caddy_t);
+    if (NULL == scd) {
+        grp_put(grp);
+        return PMIX_SUCCESS;
+    }
+    scd->ndirs = 1;
+    PMIX_INFO_CREATE(scd->directives, scd->ndirs);
+    PMIX_INFO_LOAD(&scd->directives[0], PMIX_GROUP_LAZY_DESTRUCT, NULL, PMIX_BOOL);
+    scd->cbdata = grp;
+    rc = pmix_host_server.group(PMIX_GROUP_DESTRUCT, grp->grpid,
+                                grp->members, grp->nmbrs,
+                                scd->directives, scd->ndirs,
+                                lazy_grpcbfunc, scd);
+    if (PMIX_SUCCESS != rc) {
+        /* nothing more to be done - the caller was already released */
+        grp_put(grp);
+        PMIX_INFO_FREE(scd->directives, scd->ndirs);
+        PMIX_RELEASE(scd);
+    }
+    return PMIX_SUCCESS;
 }
 
 static void _grpcbfunc(int sd, short argc, void *cbdata)
@@ -3299,7 +5548,7 @@ static void _grpcbfunc(int sd, short argc, void *cbdata)
 
     /* if the timer is active, clear it */
     if (trk->event_active) {
-        pmix_event_del(&trk->ev);
+        pmix_timer_del(&trk->timer);
     }
 
     /* the tracker's "hybrid" field is used to indicate construct
@@ -3308,7 +5557,8 @@ static void _grpcbfunc(int sd, short argc, void *cbdata)
         /* we destructed the group */
         if (NULL != grp) {
             pmix_list_remove_item(&pmix_server_globals.groups, &grp->super);
-            PMIX_RELEASE(grp);
+            grp_put(grp);
+            grp = NULL;
         }
     } else {
         /* see if this group was assigned a context ID or collected data */
@@ -3347,12 +5597,34 @@ static void _grpcbfunc(int sd, short argc, void *cbdata)
         }
 
         PMIX_LIST_FOREACH(nptr, &nslist, pmix_nspace_caddy_t) {
+            /* each store reads the blob through */
+            xfer.unpack_ptr = xfer.base_ptr;
             PMIX_GDS_STORE_MODEX(ret, nptr->ns, &trk->local_cbs, &xfer);
             if (PMIX_SUCCESS != ret) {
                 PMIX_ERROR_LOG(ret);
                 break;
             }
         }
+        xfer.unpack_ptr = xfer.base_ptr;
+        ret = pmix_gds_base_store_modex((struct pmix_namespace_t*)pmix_globals.mypeer->nptr,
+                                        &trk->local_cbs, &xfer, _grp_store_endpt, NULL);
+        if (PMIX_SUCCESS == ret && NULL != grp) {
+            grp->endpts = true;
+        }
+        /* the blob belongs to the host */
+        xfer.base_ptr = NULL;
+        xfer.bytes_used = 0;
+        PMIX_DESTRUCT(&xfer);
+        PMIX_LIST_DESTRUCT(&nslist);
+    }
+    if (NULL != grp) {
+        /* a group keeps its context ID - hand back the one we
+         * already have if the host didn't include it this time */
+        if (SIZE_MAX != ctxid) {
+            grp->ctxid = ctxid;
+        } else {
+            ctxid = grp->ctxid;
+        }
     }
 
     /* loop across all procs in the tracker, sending them the reply */
@@ -3387,7 +5659,7 @@ static void _grpcbfunc(int sd, short argc, void *cbdata)
     }
 
     /* remove the tracker from the list */
-    pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+    pmix_server_trk_remove(trk);
     PMIX_RELEASE(trk);
 
     /* we are done */
@@ -3484,7 +5756,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
     }
     if (NULL == grp) {
         /* create a new entry */
-        grp = PMIX_NEW(pmix_group_t);
+        grp = grp_get();
         if (NULL == grp) {
             rc = PMIX_ERR_NOMEM;
             goto error;
@@ -3564,6 +5836,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
             while (NULL != (nm = (pmix_namelist_t*)pmix_list_remove_first(&mbrs))) {
                 PMIX_LOAD_PROCID(&procs[n], nm->pname->nspace, nm->pname->rank);
                 PMIX_RELEASE(nm);
+                n++;
             }
             PMIX_DESTRUCT(&mbrs);
         }
@@ -3670,13 +5943,11 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
 
     /* add this contributor to the tracker so they get
      * notified when we are done */
-    pmix_list_append(&trk->local_cbs, &cd->super);
+    pmix_server_trk_add_local(trk, cd);
 
     /* if a timeout was specified, set it */
     if (0 < tv.tv_sec) {
-        pmix_event_evtimer_set(pmix_globals.evbase, &trk->ev,
-                               grp_timeout, trk);
-        pmix_event_evtimer_add(&trk->ev, &tv);
+        pmix_timer_add(&trk->timer, grp_timeout, trk, &tv);
         trk->event_active = true;
     }
 
@@ -3700,7 +5971,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
         /* check if our host supports group operations */
         if (NULL == pmix_host_server.group) {
             /* remove the tracker from the list */
-            pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+            pmix_server_trk_remove(trk);
             PMIX_RELEASE(trk);
             return PMIX_ERR_NOT_SUPPORTED;
         }
@@ -3714,10 +5985,10 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
             rc = _collect_data(trk, &bucket);
             if (PMIX_SUCCESS != rc) {
                 if (trk->event_active) {
-                    pmix_event_del(&trk->ev);
+                    pmix_timer_del(&trk->timer);
                 }
                 /* remove the tracker from the list */
-                pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+                pmix_server_trk_remove(trk);
                 PMIX_RELEASE(trk);
                 PMIX_DESTRUCT(&bucket);
                 return rc;
@@ -3732,7 +6003,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
             for (n=0; n < trk->ninfo; n++) {
                 PMIX_INFO_XFER(&iptr[n], &trk->info[n]);
             }
-            PMIX_INFO_LOAD(&iptr[ninfo], PMIX_GROUP_ENDPT_DATA, &bo, PMIX_BYTE_OBJECT);
+            PMIX_INFO_LOAD(&iptr[trk->ninfo], PMIX_GROUP_ENDPT_DATA, &bo, PMIX_BYTE_OBJECT);
             PMIX_BYTE_OBJECT_DESTRUCT(&bo);
             PMIX_INFO_FREE(trk->info, trk->ninfo);
             trk->info = iptr;
@@ -3744,7 +6015,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
                                     grpcbfunc, trk);
         if (PMIX_SUCCESS != rc) {
             if (trk->event_active) {
-                pmix_event_del(&trk->ev);
+                pmix_timer_del(&trk->timer);
             }
             if (PMIX_OPERATION_SUCCEEDED == rc) {
                 /* let the grpcbfunc threadshift the result */
@@ -3752,7 +6023,7 @@ pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
                 return PMIX_SUCCESS;
             }
             /* remove the tracker from the list */
-            pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+            pmix_server_trk_remove(trk);
             PMIX_RELEASE(trk);
             return rc;
         }
@@ -3781,15 +6052,11 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd,
     pmix_server_trkr_t *trk;
     pmix_group_t *grp, *pgrp;
     struct timeval tv = {0, 0};
+    bool lazy = false;
 
     pmix_output_verbose(2, pmix_server_globals.iof_output,
                         "recvd grpdestruct cmd");
 
-    if (NULL == pmix_host_server.group) {
-        PMIX_ERROR_LOG(PMIX_ERR_NOT_SUPPORTED);
-        return PMIX_ERR_NOT_SUPPORTED;
-    }
-
     /* unpack the group ID */
     cnt = 1;
     PMIX_BFROPS_UNPACK(rc, peer, buf, &grpid, &cnt, PMIX_STRING);
@@ -3830,16 +6097,30 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd,
             PMIX_ERROR_LOG(rc);
             goto error;
         }
-        /* see if we are to enforce a timeout - we don't internally care
-         * about any other directives */
+        /* see if we are to enforce a timeout or to leave without
+         * waiting - we don't internally care about any other directives */
         for (n=0; n < ninfo; n++) {
             if (PMIX_CHECK_KEY(&info[n], PMIX_TIMEOUT)) {
                 tv.tv_sec = info[n].value.data.uint32;
-                break;
+            } else if (PMIX_CHECK_KEY(&info[n], PMIX_GROUP_LAZY_DESTRUCT)) {
+                lazy = PMIX_INFO_TRUE(&info[n]);
             }
         }
     }
 
+    if (lazy) {
+        if (NULL != info) {
+            PMIX_INFO_FREE(info, ninfo);
+        }
+        return grp_lazy_destruct(cd, grp);
+    }
+
+    if (NULL == pmix_host_server.group) {
+        rc = PMIX_ERR_NOT_SUPPORTED;
+        PMIX_ERROR_LOG(rc);
+        goto error;
+    }
+
     /* find/create the local tracker for this operation */
     if (NULL == (trk = get_tracker(grp->grpid, grp->members, grp->nmbrs, PMIX_GROUP_DESTRUCT_CMD))) {
         /* If no tracker was found - create and initialize it once */
@@ -3870,13 +6151,11 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd,
 
     /* add this contributor to the tracker so they get
      * notified when we are done */
-    pmix_list_append(&trk->local_cbs, &cd->super);
+    pmix_server_trk_add_local(trk, cd);
 
     /* if a timeout was specified, set it */
     if (0 < tv.tv_sec) {
-        pmix_event_evtimer_set(pmix_globals.evbase, &trk->ev,
-                               grp_timeout, trk);
-        pmix_event_evtimer_add(&trk->ev, &tv);
+        pmix_timer_add(&trk->timer, grp_timeout, trk, &tv);
         trk->event_active = true;
     }
 
@@ -3895,7 +6174,7 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd,
                                     grpcbfunc, trk);
         if (PMIX_SUCCESS != rc) {
             if (trk->event_active) {
-                pmix_event_del(&trk->ev);
+                pmix_timer_del(&trk->timer);
             }
             if (PMIX_OPERATION_SUCCEEDED == rc) {
                 /* let the grpcbfunc threadshift the result */
@@ -3903,7 +6182,7 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd,
                 return PMIX_SUCCESS;
             }
             /* remove the tracker from the list */
-            pmix_list_remove_item(&pmix_server_globals.collectives, &trk->super);
+            pmix_server_trk_remove(trk);
             PMIX_RELEASE(trk);
             return rc;
         }
@@ -3921,8 +6200,11 @@ pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd,
 /*****    INSTANCE SERVER LIBRARY CLASSES    *****/
 static void tcon(pmix_server_trkr_t *t)
 {
+    memset(&t->timer, 0, sizeof(pmix_timer_t));
     t->event_active = false;
     t->lost_connection = false;
+    t->digest = 0;
+    t->indexed = false;
     t->local = false;
     t->id = NULL;
     memset(t->pname.nspace, 0, PMIX_MAX_NSLEN+1);
@@ -3934,17 +6216,33 @@ static void tcon(pmix_server_trkr_t *t)
     PMIX_CONSTRUCT(&t->local_cbs, pmix_list_t);
     t->nlocal = 0;
     t->local_cnt = 0;
+    t->ndata = 0;
     t->info = NULL;
     t->ninfo = 0;
     /* this needs to be set explicitly */
     t->collect_type = PMIX_COLLECT_INVALID;
+    t->collect_keys = NULL;
+    PMIX_CONSTRUCT(&t->bucket, pmix_buffer_t);
+    PMIX_CONSTRUCT(&t->arrivals, pmix_bitmap_t);
     t->modexcbfunc = NULL;
     t->op_cbfunc = NULL;
     t->hybrid = false;
+    t->multi_ns = false;
     t->cbdata = NULL;
+    t->t_start = pmix_counter_now();
+    t->t_local = 0;
+    t->t_upcall = 0;
+    t->t_host = 0;
+    t->upcall_bytes = 0;
+    t->slow = false;
 }
 static void tdes(pmix_server_trkr_t *t)
 {
+    pmix_server_caddy_t *cd;
+
+    if (t->event_active) {
+        pmix_timer_del(&t->timer);
+    }
     if (NULL != t->id) {
         free(t->id);
     }
@@ -3952,10 +6250,20 @@ static void tdes(pmix_server_trkr_t *t)
     if (NULL != t->pcs) {
         free(t->pcs);
     }
-    PMIX_LIST_DESTRUCT(&t->local_cbs);
+    while (NULL != (cd = (pmix_server_caddy_t*)pmix_list_get_first(&t->local_cbs)) &&
+           pmix_list_get_end(&t->local_cbs) != &cd->super) {
+        pmix_server_trk_del_local(cd);
+        PMIX_RELEASE(cd);
+    }
+    PMIX_DESTRUCT(&t->local_cbs);
     if (NULL != t->info) {
         PMIX_INFO_FREE(t->info, t->ninfo);
     }
+    if (NULL != t->collect_keys) {
+        pmix_argv_free(t->collect_keys);
+    }
+    PMIX_DESTRUCT(&t->bucket);
+    PMIX_DESTRUCT(&t->arrivals);
 }
 PMIX_CLASS_INSTANCE(pmix_server_trkr_t,
                    pmix_list_item_t,
@@ -3964,14 +6272,19 @@ PMIX_CLASS_INSTANCE(pmix_server_trkr_t,
 static void cdcon(pmix_server_caddy_t *cd)
 {
     memset(&cd->ev, 0, sizeof(pmix_event_t));
+    memset(&cd->timer, 0, sizeof(pmix_timer_t));
     cd->event_active = false;
     cd->trk = NULL;
+    cd->member = NULL;
+    cd->ref = NULL;
     cd->peer = NULL;
+    cd->start = 0;
+    cd->slow = false;
 }
 static void cddes(pmix_server_caddy_t *cd)
 {
     if (cd->event_active) {
-        pmix_event_del(&cd->ev);
+        pmix_timer_del(&cd->timer);
     }
     if (NULL != cd->trk) {
         PMIX_RELEASE(cd->trk);
@@ -3980,9 +6293,9 @@ static void cddes(pmix_server_caddy_t *cd)
         PMIX_RELEASE(cd->peer);
     }
 }
-PMIX_CLASS_INSTANCE(pmix_server_caddy_t,
-                   pmix_list_item_t,
-                   cdcon, cddes);
+PMIX_CLASS_INSTANCE_CACHED(pmix_server_caddy_t,
+                          pmix_list_item_t,
+                          cdcon, cddes);
 
 
 static void scadcon(pmix_setup_caddy_t *p)
@@ -3998,6 +6311,9 @@ static void scadcon(pmix_setup_caddy_t *p)
     p->apps = NULL;
     p->napps = 0;
     p->server_object = NULL;
+    p->uids = NULL;
+    p->gids = NULL;
+    p->server_objects = NULL;
     p->nlocalprocs = 0;
     p->info = NULL;
     p->ninfo = 0;
@@ -4018,6 +6334,15 @@ static void scaddes(pmix_setup_caddy_t *p)
         PMIX_RELEASE(p->peer);
     }
     PMIX_PROC_FREE(p->procs, p->nprocs);
+    if (NULL != p->uids) {
+        free(p->uids);
+    }
+    if (NULL != p->gids) {
+        free(p->gids);
+    }
+    if (NULL != p->server_objects) {
+        free(p->server_objects);
+    }
     if (NULL != p->apps) {
         PMIX_APP_FREE(p->apps, p->napps);
     }
@@ -4085,14 +6410,14 @@ PMIX_CLASS_INSTANCE(pmix_dmdx_remote_t,
 
 static void dmrqcon(pmix_dmdx_request_t *p)
 {
-    memset(&p->ev, 0, sizeof(pmix_event_t));
+    memset(&p->timer, 0, sizeof(pmix_timer_t));
     p->event_active = false;
     p->lcd = NULL;
 }
 static void dmrqdes(pmix_dmdx_request_t *p)
 {
     if (p->event_active) {
-        pmix_event_del(&p->ev);
+        pmix_timer_del(&p->timer);
     }
     if (NULL != p->lcd) {
         PMIX_RELEASE(p->lcd);
@@ -4105,12 +6430,22 @@ PMIX_CLASS_INSTANCE(pmix_dmdx_request_t,
 static void lmcon(pmix_dmdx_local_t *p)
 {
     memset(&p->proc, 0, sizeof(pmix_proc_t));
+    p->ns_prev = NULL;
+    p->ns_next = NULL;
     PMIX_CONSTRUCT(&p->loc_reqs, pmix_list_t);
     p->info = NULL;
     p->ninfo = 0;
+    p->start = pmix_counter_now();
+    p->slow = false;
+    p->indexed = false;
+    memset(&p->timer, 0, sizeof(pmix_timer_t));
+    p->event_active = false;
 }
 static void lmdes(pmix_dmdx_local_t *p)
 {
+    if (p->event_active) {
+        pmix_timer_del(&p->timer);
+    }
     if (NULL != p->info) {
         PMIX_INFO_FREE(p->info, p->ninfo);
     }
@@ -4123,6 +6458,8 @@ PMIX_CLASS_INSTANCE(pmix_dmdx_local_t,
 static void prevcon(pmix_peer_events_info_t *p)
 {
     p->peer = NULL;
+    p->reg = NULL;
+    p->ref = NULL;
 }
 static void prevdes(pmix_peer_events_info_t *p)
 {
@@ -4137,10 +6474,19 @@ PMIX_CLASS_INSTANCE(pmix_peer_events_info_t,
 static void regcon(pmix_regevents_info_t *p)
 {
     PMIX_CONSTRUCT(&p->peers, pmix_list_t);
+    PMIX_CONSTRUCT(&p->members, pmix_bitmap_t);
 }
 static void regdes(pmix_regevents_info_t *p)
 {
-    PMIX_LIST_DESTRUCT(&p->peers);
+    pmix_peer_events_info_t *prev;
+
+    while (NULL != (prev = (pmix_peer_events_info_t*)pmix_list_get_first(&p->peers)) &&
+           pmix_list_get_end(&p->peers) != &prev->super) {
+        pmix_server_reg_del_peer(prev);
+        PMIX_RELEASE(prev);
+    }
+    PMIX_DESTRUCT(&p->peers);
+    PMIX_DESTRUCT(&p->members);
 }
 PMIX_CLASS_INSTANCE(pmix_regevents_info_t,
                     pmix_list_item_t,
@@ -4175,6 +6521,9 @@ static void grcon(pmix_group_t *p)
     p->grpid = NULL;
     p->members = NULL;
     p->nmbrs = 0;
+    p->ctxid = SIZE_MAX;
+    p->endpts = false;
+    p->nleft = 0;
 }
 static void grdes(pmix_group_t *p)
 {
@@ -4189,6 +6538,149 @@ PMIX_CLASS_INSTANCE(pmix_group_t,
                     pmix_list_item_t,
                     grcon, grdes);
 
+static void iccon(pmix_iof_cache_t *p)
+{
+    p->cd = NULL;
+    p->seq = 0;
+    p->size = 0;
+}
+static void icdes(pmix_iof_cache_t *p)
+{
+    if (NULL != p->cd) {
+        PMIX_RELEASE(p->cd);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_iof_cache_t,
+                    pmix_list_item_t,
+                    iccon, icdes);
+
+static void irescon(pmix_iof_residency_t *p)
+{
+    p->nspace = NULL;
+    PMIX_CONSTRUCT(&p->cache, pmix_list_t);
+}
+static void iresdes(pmix_iof_residency_t *p)
+{
+    if (NULL != p->nspace) {
+        free(p->nspace);
+    }
+    PMIX_LIST_DESTRUCT(&p->cache);
+}
+PMIX_CLASS_INSTANCE(pmix_iof_residency_t,
+                    pmix_list_item_t,
+                    irescon, iresdes);
+
+static void ichcon(pmix_iof_chunk_t *p)
+{
+    PMIX_PROC_CONSTRUCT(&p->source);
+    p->channel = PMIX_FWD_NO_CHANNELS;
+    PMIX_BYTE_OBJECT_CONSTRUCT(&p->bo);
+}
+static void ichdes(pmix_iof_chunk_t *p)
+{
+    PMIX_BYTE_OBJECT_DESTRUCT(&p->bo);
+}
+PMIX_CLASS_INSTANCE(pmix_iof_chunk_t,
+                    pmix_list_item_t,
+                    ichcon, ichdes);
+
+static void ibcon(pmix_iof_batch_t *p)
+{
+    p->peer = NULL;
+    PMIX_CONSTRUCT(&p->chunks, pmix_list_t);
+    p->bytes = 0;
+    p->limit = 0;
+    p->hold.tv_sec = 0;
+    p->hold.tv_usec = 0;
+    p->active = false;
+}
+static void ibdes(pmix_iof_batch_t *p)
+{
+    if (p->active) {
+        pmix_event_del(&p->ev);
+    }
+    PMIX_LIST_DESTRUCT(&p->chunks);
+    if (NULL != p->peer) {
+        PMIX_RELEASE(p->peer);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_iof_batch_t,
+                    pmix_list_item_t,
+                    ibcon, ibdes);
+
+static void sbcon(pmix_spawn_batch_t *p)
+{
+    p->active = false;
+    p->peer = NULL;
+    PMIX_CONSTRUCT(&p->members, pmix_pointer_array_t);
+    pmix_pointer_array_init(&p->members, 4, INT_MAX, 4);
+    p->nmembers = 0;
+    p->info = NULL;
+    p->ninfo = 0;
+    p->apps = NULL;
+    p->napps = 0;
+    p->status = PMIX_SUCCESS;
+    p->nspace = NULL;
+}
+static void sbdes(pmix_spawn_batch_t *p)
+{
+    pmix_setup_caddy_t *cd;
+    int i;
+
+    if (p->active) {
+        pmix_event_del(&p->ev);
+    }
+    for (i=0; i < p->members.size; i++) {
+        if (NULL != (cd = (pmix_setup_caddy_t*)pmix_pointer_array_get_item(&p->members, i))) {
+            if (NULL != cd->info) {
+                PMIX_INFO_FREE(cd->info, cd->ninfo);
+            }
+            PMIX_RELEASE(cd);
+        }
+    }
+    PMIX_DESTRUCT(&p->members);
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+    if (NULL != p->apps) {
+        PMIX_APP_FREE(p->apps, p->napps);
+    }
+    if (NULL != p->nspace) {
+        free(p->nspace);
+    }
+    if (NULL != p->peer) {
+        PMIX_RELEASE(p->peer);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_spawn_batch_t,
+                    pmix_list_item_t,
+                    sbcon, sbdes);
+
+static void agcon(pmix_event_aggregate_t *p)
+{
+    p->active = false;
+    p->cd = NULL;
+    p->procs = NULL;
+    p->nprocs = 0;
+    p->size = 0;
+    p->nevents = 0;
+}
+static void agdes(pmix_event_aggregate_t *p)
+{
+    if (p->active) {
+        pmix_event_del(&p->ev);
+    }
+    if (NULL != p->cd) {
+        PMIX_RELEASE(p->cd);
+    }
+    if (NULL != p->procs) {
+        PMIX_PROC_FREE(p->procs, p->size);
+    }
+}
+PMIX_CLASS_INSTANCE(pmix_event_aggregate_t,
+                    pmix_list_item_t,
+                    agcon, agdes);
+
 PMIX_CLASS_INSTANCE(pmix_group_caddy_t,
                     pmix_list_item_t,
                     NULL, NULL);
@@ -18,15 +18,14 @@
 #include "src/include/types.h"
 #include <pmix_common.h>
 
+#include <src/class/pmix_bitmap.h>
 #include <src/class/pmix_hotel.h>
+#include <src/class/pmix_ring_buffer.h>
 #include <pmix_server.h>
 #include "src/threads/threads.h"
 #include "src/include/pmix_globals.h"
 #include "src/util/hash.h"
 
-#define PMIX_IOF_HOTEL_SIZE  256
-#define PMIX_IOF_MAX_STAY    300000000
-
 typedef struct {
     pmix_object_t super;
     pmix_event_t ev;
@@ -49,6 +48,9 @@ typedef struct {
     uid_t uid;
     gid_t gid;
     void *server_object;
+    uid_t *uids;                // per-proc values when registering several clients
+    gid_t *gids;
+    void **server_objects;
     int nlocalprocs;
     pmix_info_t *info;
     size_t ninfo;
@@ -67,6 +69,45 @@ typedef struct {
 } pmix_setup_caddy_t;
 PMIX_CLASS_DECLARATION(pmix_setup_caddy_t);
 
+/* a chunk of IO held until someone registers to receive it */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_setup_caddy_t *cd;     // source, channel, and data
+    uint64_t seq;               // arrival order across all sources
+    size_t size;                // bytes charged against the cache budget
+} pmix_iof_cache_t;
+PMIX_CLASS_DECLARATION(pmix_iof_cache_t);
+
+/* the undelivered IO from the procs of one nspace */
+typedef struct {
+    pmix_list_item_t super;
+    char *nspace;
+    pmix_list_t cache;          // list of pmix_iof_cache_t, oldest first
+} pmix_iof_residency_t;
+PMIX_CLASS_DECLARATION(pmix_iof_residency_t);
+
+/* a run of IO from one source and channel awaiting a batch */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_proc_t source;
+    pmix_iof_channel_t channel;
+    pmix_byte_object_t bo;
+} pmix_iof_chunk_t;
+PMIX_CLASS_DECLARATION(pmix_iof_chunk_t);
+
+/* the IO held for a requestor that takes it in batches */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_peer_t *peer;
+    pmix_list_t chunks;         // list of pmix_iof_chunk_t in arrival order
+    size_t bytes;               // bytes of IO held in chunks
+    size_t limit;               // send once this many bytes are held
+    struct timeval hold;        // max time to hold IO before sending
+    pmix_event_t ev;
+    bool active;                // hold timer is running
+} pmix_iof_batch_t;
+PMIX_CLASS_DECLARATION(pmix_iof_batch_t);
+
 /* define a callback function returning inventory */
 typedef void (*pmix_inventory_cbfunc_t)(pmix_status_t status,
                                         pmix_list_t *inventory,
@@ -96,20 +137,27 @@ typedef struct {
 } pmix_dmdx_remote_t;
 PMIX_CLASS_DECLARATION(pmix_dmdx_remote_t);
 
-typedef struct {
+typedef struct pmix_dmdx_local_t {
     pmix_list_item_t super;
     pmix_proc_t proc;               // id of proc whose data is being requested
+    struct pmix_dmdx_local_t *ns_prev;  // other requests for the same nspace
+    struct pmix_dmdx_local_t *ns_next;
     pmix_list_t loc_reqs;           // list of pmix_dmdx_request_t elem's keeping track of
                                     // all local ranks that are interested in this namespace-rank
     pmix_info_t *info;              // array of info structs for this request
     size_t ninfo;                   // number of info structs
+    uint64_t start;                 // when the tracker was created
+    bool slow;                      // already reported by the watchdog
+    bool indexed;                   // on local_reqs and the lookup indices
+    pmix_timer_t timer;             // expiry of a prefetch nobody has asked for
+    bool event_active;              // timer is armed
 } pmix_dmdx_local_t;
 PMIX_CLASS_DECLARATION(pmix_dmdx_local_t);
 
 typedef struct {
     pmix_list_item_t super;
-    pmix_event_t ev;
-    bool event_active;
+    pmix_timer_t timer;
+    bool event_active;              // timer is armed
     pmix_dmdx_local_t *lcd;
     pmix_modex_cbfunc_t cbfunc;     // cbfunc to be executed when data is available
     void *cbdata;
@@ -117,18 +165,23 @@ typedef struct {
 PMIX_CLASS_DECLARATION(pmix_dmdx_request_t);
 
 /* event/error registration book keeping */
+typedef struct pmix_regevents_info_t pmix_regevents_info_t;
+
 typedef struct {
     pmix_list_item_t super;
     pmix_peer_t *peer;
     bool enviro_events;
+    pmix_regevents_info_t *reg;     // registration whose peers we are on (not retained)
+    pmix_peer_ref_t *ref;           // our entry on peer->evregs
 } pmix_peer_events_info_t;
 PMIX_CLASS_DECLARATION(pmix_peer_events_info_t);
 
-typedef struct {
+struct pmix_regevents_info_t {
     pmix_list_item_t super;
     pmix_list_t peers;              // list of pmix_peer_events_info_t
+    pmix_bitmap_t members;          // peers by their index in the clients array
     int code;
-} pmix_regevents_info_t;
+};
 PMIX_CLASS_DECLARATION(pmix_regevents_info_t);
 
 typedef struct {
@@ -136,6 +189,9 @@ typedef struct {
     char *grpid;
     pmix_proc_t *members;
     size_t nmbrs;
+    size_t ctxid;           // context ID assigned at construct (SIZE_MAX => none)
+    bool endpts;            // members' endpoint data is held in our own GDS
+    size_t nleft;           // local members that have lazily destructed
 } pmix_group_t;
 PMIX_CLASS_DECLARATION(pmix_group_t);
 
@@ -147,28 +203,102 @@ typedef struct {
 } pmix_group_caddy_t;
 PMIX_CLASS_DECLARATION(pmix_group_caddy_t);
 
+/* a burst of same-code host events being coalesced into
+ * a single notification */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_event_t ev;
+    bool active;                // timer is pending
+    pmix_notify_caddy_t *cd;    // first event of the burst - delivered on timeout
+    pmix_proc_t *procs;         // affected procs collected across the burst
+    size_t nprocs;
+    size_t size;
+    size_t nevents;             // #events absorbed into cd
+} pmix_event_aggregate_t;
+PMIX_CLASS_DECLARATION(pmix_event_aggregate_t);
+
+/* spawn requests from one requestor being merged into
+ * a single multi-app spawn by the host */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_event_t ev;
+    bool active;                // hold timer is running
+    pmix_peer_t *peer;
+    pmix_pointer_array_t members;   // pmix_setup_caddy_t of the merged requests
+    int nmembers;
+    pmix_info_t *info;          // directives shared by the members
+    size_t ninfo;
+    pmix_app_t *apps;           // apps of all members, in arrival order
+    size_t napps;
+    pmix_status_t status;       // returned by the host
+    char *nspace;
+} pmix_spawn_batch_t;
+PMIX_CLASS_DECLARATION(pmix_spawn_batch_t);
+
 typedef struct {
     pmix_list_t nspaces;                    // list of pmix_nspace_t for the nspaces we know about
     pmix_pointer_array_t clients;           // array of pmix_peer_t local clients
     pmix_list_t collectives;                // list of active pmix_server_trkr_t
+    pmix_hash_table_t trkidx;               // index of active collectives by digest
+    size_t nunindexed;                      // #active collectives not in the index
     pmix_list_t remote_pnd;                 // list of pmix_dmdx_remote_t awaiting arrival of data fror servicing remote req's
     pmix_list_t local_reqs;                 // list of pmix_dmdx_local_t awaiting arrival of data from local neighbours
+    pmix_hash_table_t dmdxidx;              // index of local_reqs by requested proc
+    pmix_hash_table_t dmdxns;               // first of local_reqs for each requested nspace
     pmix_list_t gdata;                      // cache of data given to me for passing to all clients
     pmix_list_t events;                     // list of pmix_regevents_info_t registered events
+    pmix_hash_table_t evidx;                // index of events by code
     pmix_list_t groups;                     // list of pmix_group_t group memberships
-    pmix_hotel_t iof;                       // IO to be forwarded to clients
+    pmix_list_t grp_cache;                  // released pmix_group_t objects held for reuse
+    pmix_list_t aggregates;                 // list of pmix_event_aggregate_t host event bursts
+    int event_aggregation;                  // msec to coalesce same-code host events (0 => off)
+    int event_ring_slots;                   // #slots in the local event ring (0 => off)
+    int event_ring_slot_size;               // bytes of packed event a ring slot holds
+    int event_ring_readers;                 // #local clients that can read the ring
+    pmix_list_t iof;                        // list of pmix_iof_residency_t IO yet to be forwarded
+    size_t iof_size;                        // bytes of IO held in iof
+    size_t iof_cache_size;                  // max bytes of IO to hold before dropping the oldest
+    uint64_t iof_seq;                       // arrival counter for IO placed in iof
+    pmix_list_t iof_batches;                // list of pmix_iof_batch_t per-requestor batches
+    int iof_batch_msec;                     // msec to batch IO for requestors that accept it (0 => only on request)
+    size_t iof_batch_size;                  // bytes of IO that fill a batch
+    size_t iof_compress;                    // compress IO batches larger than this (0 = never)
+    int watchdog;                           // msec a request may be outstanding before it is recorded (0 => off)
+    int watchdog_records;                   // #slow-request records to keep
+    int watchdog_signal;                    // signal that dumps the records to stderr (0 => none)
+    pmix_ring_buffer_t slow;                // most recent slow-request records (char*)
+    pmix_list_t queries;                    // pmix_server_caddy_t of queries out with the host
+    pmix_mutex_t query_lock;                // protects queries - the host may answer on its own thread
+    pmix_event_t watchdog_ev;
+    pmix_event_t watchdog_sigev;
+    bool watchdog_active;
+    bool pubsub;                            // serve local/nspace-range publish/lookup on-node
+    bool job_ctrl_local;                    // deliver signals/kills to local clients without the host
+    int lookup_recheck;                     // msec between host re-checks of parked lookups (0 => never)
+    int query_cache_ttl;                    // msec to reuse a host's answer to a query (0 => off)
+    pmix_list_t spawn_batches;              // list of pmix_spawn_batch_t collecting requests
+    int spawn_batch_msec;                   // msec to collect matching spawn requests (0 => off)
+    int spawn_batch_apps;                   // #apps that fill a spawn batch
+    bool ds12_shm_lock;                     // give ds12 readers a shared-memory rwlock
+    int gds_small_job;                      // nspaces up to this size only get hash (0 => off)
+    int gds_large_job;                      // nspaces from this size get gds_large_modules (0 => off)
+    char *gds_large_modules;                // gds modules preferred for large nspaces
+    char *collective_algo;                  // PMIX_COLLECTIVE_ALGO to give the host when callers don't
     bool tool_connections_allowed;
     char *tmpdir;                           // temporary directory for this server
     char *system_tmpdir;                    // system tmpdir
     // verbosity for server get operations
     int get_output;
     int get_verbose;
+    int get_prefetch;                       // #neighbouring ranks to request on a direct modex miss
+    int get_prefetch_timeout;               // secs a prefetch is tracked when the get gave no timeout
     // verbosity for server connect operations
     int connect_output;
     int connect_verbose;
     // verbosity for server fence operations
     int fence_output;
     int fence_verbose;
+    int fence_compress;                     // compress fence buckets larger than this (0 = never)
     // verbosity for server pub operations
     int pub_output;
     int pub_verbose;
@@ -213,7 +343,58 @@ typedef struct {
 
 bool pmix_server_trk_update(pmix_server_trkr_t *trk);
 
+/* watch for requests outstanding longer than pmix_server_globals.watchdog */
+void pmix_server_watchdog_start(void);
+void pmix_server_watchdog_stop(void);
+void pmix_server_watchdog_query(pmix_server_caddy_t *cd);
+void pmix_server_watchdog_query_done(pmix_server_caddy_t *cd);
+pmix_status_t pmix_server_watchdog_load(pmix_value_t *val);
+
+/* node-local store for data published with PMIX_RANGE_LOCAL or
+ * PMIX_RANGE_NAMESPACE - each returns PMIX_ERR_TAKE_NEXT_OPTION when
+ * the request must (also) go to the host, else PMIX_SUCCESS once the
+ * callback has been or will be executed, or an error */
+void pmix_server_pubsub_init(void);
+void pmix_server_pubsub_finalize(void);
+pmix_status_t pmix_server_pubsub_publish(pmix_peer_t *peer,
+                                         pmix_info_t *info, size_t ninfo,
+                                         bool host, pmix_op_cbfunc_t cbfunc,
+                                         void *cbdata);
+pmix_status_t pmix_server_pubsub_lookup(pmix_peer_t *peer, char **keys,
+                                        pmix_info_t *info, size_t ninfo,
+                                        bool host, pmix_lookup_cbfunc_t cbfunc,
+                                        void *cbdata);
+pmix_status_t pmix_server_pubsub_unpublish(pmix_peer_t *peer, char **keys,
+                                           pmix_info_t *info, size_t ninfo,
+                                           bool host, pmix_op_cbfunc_t cbfunc,
+                                           void *cbdata);
+void pmix_server_pubsub_purge(const char *nspace);
+/* retry lookups parked on any of the given (published) keys */
+void pmix_server_pubsub_wake(pmix_info_t *info, size_t ninfo);
+
+/* remove a tracker from the active collectives - its local
+ * participants are no longer tracked by their peers */
+void pmix_server_trk_remove(pmix_server_trkr_t *trk);
+/* add/remove a local participant's caddy to/from a tracker,
+ * keeping the peer's list of its collectives in step */
+void pmix_server_trk_add_local(pmix_server_trkr_t *trk, pmix_server_caddy_t *cd);
+void pmix_server_trk_del_local(pmix_server_caddy_t *cd);
+
+/* true if the given key is to be collected by the tracker */
+bool pmix_server_collect_key(pmix_server_trkr_t *trk, const char *key);
+/* likewise for a peer's entry on an event registration */
+void pmix_server_reg_add_peer(pmix_regevents_info_t *reg, pmix_peer_events_info_t *prev);
+void pmix_server_reg_del_peer(pmix_peer_events_info_t *prev);
+/* find, add or remove the registration for an event code - default
+ * handlers are registered under PMIX_MAX_ERR_CONSTANT */
+pmix_regevents_info_t* pmix_server_reg_lookup(int code);
+pmix_regevents_info_t* pmix_server_reg_create(int code);
+void pmix_server_reg_remove(pmix_regevents_info_t *reg);
+
 void pmix_pending_nspace_requests(pmix_namespace_t *nptr);
+/* remove a direct modex request from the outstanding requests */
+void pmix_pending_add(pmix_dmdx_local_t *lcd);
+void pmix_pending_remove(pmix_dmdx_local_t *lcd);
 pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr, pmix_rank_t rank,
                                    pmix_status_t status, pmix_dmdx_local_t *lcd);
 
@@ -221,7 +402,7 @@ pmix_status_t pmix_pending_resolve(pmix_namespace_t *nptr, pmix_rank_t rank,
 pmix_status_t pmix_server_abort(pmix_peer_t *peer, pmix_buffer_t *buf,
                                 pmix_op_cbfunc_t cbfunc, void *cbdata);
 
-pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf);
+pmix_status_t pmix_server_commit(pmix_peer_t *peer, pmix_buffer_t *buf, bool delta);
 
 pmix_status_t pmix_server_fence(pmix_server_caddy_t *cd,
                                 pmix_buffer_t *buf,
@@ -260,6 +441,12 @@ pmix_status_t pmix_server_disconnect(pmix_server_caddy_t *cd,
                                      pmix_buffer_t *buf,
                                      pmix_op_cbfunc_t cbfunc);
 
+/* track the job-level info of other nspaces already given
+ * to a peer by a connect */
+bool pmix_server_cnct_known(pmix_peer_t *peer, pmix_namespace_t *nptr);
+void pmix_server_cnct_record(pmix_peer_t *peer, pmix_namespace_t *nptr);
+void pmix_server_cnct_forget(pmix_peer_t *peer, const char *nspace);
+
 pmix_status_t pmix_server_notify_error(pmix_status_t status,
                                        pmix_proc_t procs[], size_t nprocs,
                                        pmix_proc_t error_procs[], size_t error_nprocs,
@@ -274,6 +461,13 @@ pmix_status_t pmix_server_register_events(pmix_peer_t *peer,
 void pmix_server_deregister_events(pmix_peer_t *peer,
                                    pmix_buffer_t *buf);
 
+/* keep the proc table of an nspace's local clients current */
+PMIX_EXPORT void pmix_server_ptable_update(pmix_namespace_t *nptr, pmix_rank_info_t *info);
+void pmix_server_ptable_remove(pmix_namespace_t *nptr, pmix_rank_t rank);
+
+/* drop any host query results being held for reuse */
+void pmix_server_query_cache_flush(void);
+
 pmix_status_t pmix_server_query(pmix_peer_t *peer,
                                 pmix_buffer_t *buf,
                                 pmix_info_cbfunc_t cbfunc,
@@ -319,12 +513,35 @@ pmix_status_t pmix_server_iofstdin(pmix_peer_t *peer,
                                    pmix_op_cbfunc_t cbfunc,
                                    void *cbdata);
 
+/* hold IO that nobody has registered for yet, dropping the
+ * oldest cached IO once the cache exceeds its byte budget.
+ * The cache takes the caller's reference on cd */
+pmix_status_t pmix_server_iof_cache(pmix_setup_caddy_t *cd);
+
+/* forward and release any cached IO that matches the request. IO
+ * from the requestor itself is left in place if skipself is set */
+pmix_status_t pmix_server_iof_replay(pmix_iof_req_t *req, bool skipself);
+
+/* release all cached IO */
+void pmix_server_iof_purge(void);
+
+/* send a chunk of IO to a requestor, batching it if they asked */
+pmix_status_t pmix_server_iof_forward(pmix_peer_t *peer,
+                                      const pmix_proc_t *source,
+                                      pmix_iof_channel_t channel,
+                                      const pmix_byte_object_t *bo);
+
+/* send any IO batched for a departing requestor and stop batching */
+void pmix_server_iof_unbatch(pmix_peer_t *peer, const pmix_proc_t *proc);
+
 pmix_status_t pmix_server_grpconstruct(pmix_server_caddy_t *cd,
                                        pmix_buffer_t *buf);
 
 pmix_status_t pmix_server_grpdestruct(pmix_server_caddy_t *cd,
                                       pmix_buffer_t *buf);
 
+bool pmix_server_group_endpt_known(const char *nspace, pmix_rank_t rank);
+
 pmix_status_t pmix_server_event_recvd_from_client(pmix_peer_t *peer,
                                                   pmix_buffer_t *buf,
                                                   pmix_op_cbfunc_t cbfunc,
@@ -0,0 +1,785 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * A node-local store for published data. Data published with
+ * PMIX_RANGE_LOCAL is held only here - no other node can see it,
+ * so the host is never involved. Data published with
+ * PMIX_RANGE_NAMESPACE is held here and also passed up to the
+ * host, so that local members of the nspace find it on-node while
+ * members elsewhere still reach it through the host. Lookups are
+ * answered from here when every requested key is found. Lookups
+ * that can only be satisfied locally may wait (PMIX_WAIT) for the
+ * keys to be published.
+ *
+ * Entries are indexed by range, nspace (for PMIX_RANGE_NAMESPACE)
+ * and key. Enabled by the pmix_server_pubsub MCA parameter.
+ *
+ * Independent of the store, a lookup carrying PMIX_WAIT that cannot
+ * yet be satisfied is parked here, indexed by the keys it is waiting
+ * on, rather than being failed back to a polling client. A publish
+ * through this server of any of those keys wakes it: it is answered
+ * from the store, or asked of the host once more. Publishes the host
+ * receives from other nodes are caught by re-asking the host for
+ * parked lookups every pmix_server_lookup_recheck msec.
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <src/include/types.h>
+#include <src/include/pmix_stdint.h>
+
+#include <pmix_server.h>
+#include <pmix_rename.h>
+#include "src/include/pmix_globals.h"
+
+#ifdef HAVE_STRING_H
+#include <string.h>
+#endif
+#include <stdio.h>
+#include PMIX_EVENT_HEADER
+
+#include "src/class/pmix_hash_table.h"
+#include "src/class/pmix_list.h"
+#include "src/util/argv.h"
+#include "src/util/error.h"
+#include "src/util/output.h"
+
+#include "pmix_server_ops.h"
+
+typedef struct {
+    pmix_list_item_t super;
+    char *idx;                  // index key - range, nspace and key
+    pmix_proc_t owner;
+    pmix_data_range_t range;
+    pmix_key_t key;
+    pmix_value_t value;
+} pmix_pubsub_data_t;
+static void pdcon(pmix_pubsub_data_t *p)
+{
+    p->idx = NULL;
+    p->range = PMIX_RANGE_UNDEF;
+    memset(p->key, 0, sizeof(pmix_key_t));
+    p->value.type = PMIX_UNDEF;
+}
+static void pddes(pmix_pubsub_data_t *p)
+{
+    if (NULL != p->idx) {
+        free(p->idx);
+    }
+    PMIX_VALUE_DESTRUCT(&p->value);
+}
+static PMIX_CLASS_INSTANCE(pmix_pubsub_data_t,
+                           pmix_list_item_t,
+                           pdcon, pddes);
+
+typedef struct {
+    pmix_list_item_t super;
+    pmix_peer_t *peer;
+    pmix_data_range_t range;
+    char **keys;
+    size_t nwait;               // #keys that must be found
+    pmix_info_t *info;          // directives to repeat to the host
+    size_t ninfo;
+    pmix_lookup_cbfunc_t cbfunc;
+    void *cbdata;
+    pmix_timer_t timer;
+    bool timer_active;
+    bool host;                  // the host may hold the keys
+    bool parked;
+    bool inflight;              // a lookup is out with the host
+    bool expired;               // timed out while out with the host
+    bool woken;
+} pmix_pubsub_wait_t;
+static void pwcon(pmix_pubsub_wait_t *p)
+{
+    memset(&p->timer, 0, sizeof(pmix_timer_t));
+    p->peer = NULL;
+    p->range = PMIX_RANGE_UNDEF;
+    p->keys = NULL;
+    p->nwait = 0;
+    p->info = NULL;
+    p->ninfo = 0;
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+    p->timer_active = false;
+    p->host = false;
+    p->parked = false;
+    p->inflight = false;
+    p->expired = false;
+    p->woken = false;
+}
+static void pwdes(pmix_pubsub_wait_t *p)
+{
+    if (p->timer_active) {
+        pmix_timer_del(&p->timer);
+    }
+    if (NULL != p->peer) {
+        PMIX_RELEASE(p->peer);
+    }
+    if (NULL != p->keys) {
+        pmix_argv_free(p->keys);
+    }
+    if (NULL != p->info) {
+        PMIX_INFO_FREE(p->info, p->ninfo);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_pubsub_wait_t,
+                           pmix_list_item_t,
+                           pwcon, pwdes);
+
+/* one parked lookup waiting on one key */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_pubsub_wait_t *pw;
+} pmix_pubsub_wref_t;
+static PMIX_CLASS_INSTANCE(pmix_pubsub_wref_t,
+                           pmix_list_item_t,
+                           NULL, NULL);
+
+static bool initialized = false;
+static bool store = false;
+static pmix_list_t pubdata;         // pmix_pubsub_data_t
+static pmix_hash_table_t pubidx;    // index of pubdata
+static pmix_list_t pubwait;         // pmix_pubsub_wait_t parked lookups
+static pmix_hash_table_t waitidx;   // key => pmix_list_t of pmix_pubsub_wref_t
+static pmix_event_t recheck_ev;
+static bool recheck_active = false;
+
+static void ask_host(pmix_pubsub_wait_t *pw);
+
+void pmix_server_pubsub_init(void)
+{
+    if (initialized) {
+        return;
+    }
+    PMIX_CONSTRUCT(&pubwait, pmix_list_t);
+    PMIX_CONSTRUCT(&waitidx, pmix_hash_table_t);
+    pmix_hash_table_init(&waitidx, 256);
+    if (pmix_server_globals.pubsub) {
+        PMIX_CONSTRUCT(&pubdata, pmix_list_t);
+        PMIX_CONSTRUCT(&pubidx, pmix_hash_table_t);
+        pmix_hash_table_init(&pubidx, 256);
+        store = true;
+    }
+    initialized = true;
+}
+
+void pmix_server_pubsub_finalize(void)
+{
+    pmix_list_t *lst;
+    void *key, *node;
+    size_t keylen;
+    int rc;
+
+    if (!initialized) {
+        return;
+    }
+    if (recheck_active) {
+        pmix_event_del(&recheck_ev);
+        recheck_active = false;
+    }
+    rc = pmix_hash_table_get_first_key_ptr(&waitidx, &key, &keylen, (void**)&lst, &node);
+    while (PMIX_SUCCESS == rc) {
+        PMIX_LIST_RELEASE(lst);
+        rc = pmix_hash_table_get_next_key_ptr(&waitidx, &key, &keylen, (void**)&lst, node, &node);
+    }
+    PMIX_DESTRUCT(&waitidx);
+    PMIX_LIST_DESTRUCT(&pubwait);
+    if (store) {
+        PMIX_DESTRUCT(&pubidx);
+        PMIX_LIST_DESTRUCT(&pubdata);
+        store = false;
+    }
+    initialized = false;
+}
+
+static char* idx_key(pmix_data_range_t range, const char *nspace, const char *key)
+{
+    char *idx;
+
+    if (PMIX_RANGE_LOCAL == range) {
+        if (0 > asprintf(&idx, "L/%s", key)) {
+            return NULL;
+        }
+    } else {
+        if (0 > asprintf(&idx, "N/%s/%s", nspace, key)) {
+            return NULL;
+        }
+    }
+    return idx;
+}
+
+static pmix_pubsub_data_t* find(pmix_data_range_t range, const char *nspace, const char *key)
+{
+    pmix_pubsub_data_t *pd = NULL;
+    char *idx;
+
+    if (NULL == (idx = idx_key(range, nspace, key))) {
+        return NULL;
+    }
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&pubidx, idx, strlen(idx), (void**)&pd)) {
+        pd = NULL;
+    }
+    free(idx);
+    return pd;
+}
+
+static void drop(pmix_pubsub_data_t *pd)
+{
+    pmix_hash_table_remove_value_ptr(&pubidx, pd->idx, strlen(pd->idx));
+    pmix_list_remove_item(&pubdata, &pd->super);
+    PMIX_RELEASE(pd);
+}
+
+/* lookups and unpublishes in these ranges may touch local data */
+static bool serves(pmix_data_range_t range)
+{
+    switch (range) {
+        case PMIX_RANGE_UNDEF:
+        case PMIX_RANGE_LOCAL:
+        case PMIX_RANGE_NAMESPACE:
+        case PMIX_RANGE_SESSION:
+        case PMIX_RANGE_GLOBAL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static pmix_data_range_t get_range(pmix_info_t *info, size_t ninfo)
+{
+    size_t n;
+
+    for (n=0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_RANGE)) {
+            return info[n].value.data.range;
+        }
+    }
+    /* the standard's default */
+    return PMIX_RANGE_SESSION;
+}
+
+/* directives passed with published data are not themselves data */
+static bool is_directive(pmix_info_t *info)
+{
+    return (PMIX_CHECK_KEY(info, PMIX_RANGE) ||
+            PMIX_CHECK_KEY(info, PMIX_PERSISTENCE) ||
+            PMIX_CHECK_KEY(info, PMIX_USERID) ||
+            PMIX_CHECK_KEY(info, PMIX_GRPID) ||
+            PMIX_CHECK_KEY(info, PMIX_TIMEOUT));
+}
+
+/* look for the given keys in what the requester may see - the
+ * narrowest range is searched first */
+static size_t lookup_keys(pmix_peer_t *peer, pmix_data_range_t range,
+                          char **keys, pmix_pdata_t **pdata)
+{
+    pmix_pubsub_data_t *pd;
+    size_t n, nkeys, nfound = 0;
+    pmix_pdata_t *pdt;
+
+    *pdata = NULL;
+    nkeys = pmix_argv_count(keys);
+    if (!store || 0 == nkeys) {
+        return 0;
+    }
+    PMIX_PDATA_CREATE(pdt, nkeys);
+    if (NULL == pdt) {
+        return 0;
+    }
+    for (n=0; n < nkeys; n++) {
+        pd = NULL;
+        if (PMIX_RANGE_LOCAL != range) {
+            pd = find(PMIX_RANGE_NAMESPACE, peer->info->pname.nspace, keys[n]);
+        }
+        if (NULL == pd && PMIX_RANGE_NAMESPACE != range) {
+            pd = find(PMIX_RANGE_LOCAL, NULL, keys[n]);
+        }
+        if (NULL == pd) {
+            continue;
+        }
+        pdt[nfound].proc = pd->owner;
+        pmix_strncpy(pdt[nfound].key, pd->key, PMIX_MAX_KEYLEN);
+        pmix_value_xfer(&pdt[nfound].value, &pd->value);
+        ++nfound;
+    }
+    if (0 == nfound) {
+        PMIX_PDATA_FREE(pdt, nkeys);
+        return 0;
+    }
+    *pdata = pdt;
+    return nfound;
+}
+
+static void recheck(int sd, short args, void *cbdata);
+
+static void park(pmix_pubsub_wait_t *pw)
+{
+    pmix_pubsub_wref_t *wr;
+    pmix_list_t *lst;
+    struct timeval tv;
+    int n;
+
+    for (n=0; NULL != pw->keys[n]; n++) {
+        if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&waitidx, pw->keys[n],
+                                                          strlen(pw->keys[n]), (void**)&lst)) {
+            lst = PMIX_NEW(pmix_list_t);
+            pmix_hash_table_set_value_ptr(&waitidx, pw->keys[n], strlen(pw->keys[n]), lst);
+        }
+        wr = PMIX_NEW(pmix_pubsub_wref_t);
+        wr->pw = pw;
+        pmix_list_append(lst, &wr->super);
+    }
+    pmix_list_append(&pubwait, &pw->super);
+    pw->parked = true;
+    pmix_output_verbose(2, pmix_server_globals.pub_output,
+                        "pmix:server parked lookup of %d keys for %s:%u",
+                        n, pw->peer->info->pname.nspace, pw->peer->info->pname.rank);
+
+    if (pw->host && 0 < pmix_server_globals.lookup_recheck && !recheck_active) {
+        tv.tv_sec = pmix_server_globals.lookup_recheck / 1000;
+        tv.tv_usec = (pmix_server_globals.lookup_recheck % 1000) * 1000;
+        pmix_event_evtimer_set(pmix_globals.evbase, &recheck_ev, recheck, NULL);
+        pmix_event_evtimer_add(&recheck_ev, &tv);
+        recheck_active = true;
+    }
+}
+
+static void unpark(pmix_pubsub_wait_t *pw)
+{
+    pmix_pubsub_wref_t *wr;
+    pmix_list_t *lst;
+    int n;
+
+    for (n=0; NULL != pw->keys[n]; n++) {
+        if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&waitidx, pw->keys[n],
+                                                          strlen(pw->keys[n]), (void**)&lst)) {
+            continue;
+        }
+        PMIX_LIST_FOREACH(wr, lst, pmix_pubsub_wref_t) {
+            if (wr->pw == pw) {
+                pmix_list_remove_item(lst, &wr->super);
+                PMIX_RELEASE(wr);
+                break;
+            }
+        }
+        if (0 == pmix_list_get_size(lst)) {
+            pmix_hash_table_remove_value_ptr(&waitidx, pw->keys[n], strlen(pw->keys[n]));
+            PMIX_RELEASE(lst);
+        }
+    }
+    pmix_list_remove_item(&pubwait, &pw->super);
+    pw->parked = false;
+}
+
+/* see if a parked lookup can now complete */
+static void retry(pmix_pubsub_wait_t *pw)
+{
+    pmix_pdata_t *pdata;
+    size_t nfound, nkeys;
+
+    nkeys = pmix_argv_count(pw->keys);
+    nfound = lookup_keys(pw->peer, pw->range, pw->keys, &pdata);
+    if (0 < nfound && nfound >= pw->nwait) {
+        unpark(pw);
+        pw->cbfunc(PMIX_SUCCESS, pdata, nfound, pw->cbdata);
+        PMIX_PDATA_FREE(pdata, nkeys);
+        PMIX_RELEASE(pw);
+        return;
+    }
+    if (NULL != pdata) {
+        PMIX_PDATA_FREE(pdata, nkeys);
+    }
+    if (pw->host) {
+        unpark(pw);
+        ask_host(pw);
+    }
+}
+
+static void recheck(int sd, short args, void *cbdata)
+{
+    pmix_pubsub_wait_t *pw, *next;
+
+    recheck_active = false;
+    PMIX_LIST_FOREACH_SAFE(pw, next, &pubwait, pmix_pubsub_wait_t) {
+        if (pw->host) {
+            unpark(pw);
+            ask_host(pw);
+        }
+    }
+}
+
+void pmix_server_pubsub_wake(pmix_info_t *info, size_t ninfo)
+{
+    pmix_pubsub_wait_t *pw, *next;
+    pmix_pubsub_wref_t *wr;
+    pmix_list_t *lst;
+    size_t n;
+    bool any = false;
+
+    if (!initialized || 0 == pmix_list_get_size(&pubwait)) {
+        return;
+    }
+    /* mark everyone waiting on any of these keys... */
+    for (n=0; n < ninfo; n++) {
+        if (is_directive(&info[n])) {
+            continue;
+        }
+        if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&waitidx, info[n].key,
+                                                          strlen(info[n].key), (void**)&lst)) {
+            continue;
+        }
+        PMIX_LIST_FOREACH(wr, lst, pmix_pubsub_wref_t) {
+            wr->pw->woken = true;
+            any = true;
+        }
+    }
+    if (!any) {
+        return;
+    }
+    /* ...and then give each of them another try */
+    PMIX_LIST_FOREACH_SAFE(pw, next, &pubwait, pmix_pubsub_wait_t) {
+        if (pw->woken) {
+            pw->woken = false;
+            retry(pw);
+        }
+    }
+}
+
+static void _host_lkcb(int sd, short args, void *cbdata)
+{
+    pmix_shift_caddy_t *scd = (pmix_shift_caddy_t*)cbdata;
+    pmix_pubsub_wait_t *pw = (pmix_pubsub_wait_t*)scd->cbdata;
+    pmix_pdata_t *pdata = (pmix_pdata_t*)scd->data;
+
+    PMIX_ACQUIRE_OBJECT(scd);
+    pw->inflight = false;
+
+    if (pw->expired) {
+        /* the requester was already told */
+        PMIX_RELEASE(pw);
+    } else if (PMIX_SUCCESS == scd->status && 0 < scd->ndata && scd->ndata >= pw->nwait) {
+        pw->cbfunc(PMIX_SUCCESS, pdata, scd->ndata, pw->cbdata);
+        PMIX_RELEASE(pw);
+    } else if (PMIX_SUCCESS != scd->status && PMIX_ERR_NOT_FOUND != scd->status) {
+        pw->cbfunc(scd->status, NULL, 0, pw->cbdata);
+        PMIX_RELEASE(pw);
+    } else if (initialized) {
+        /* not there yet - wait for it */
+        park(pw);
+    } else {
+        PMIX_RELEASE(pw);
+    }
+    if (NULL != pdata) {
+        PMIX_PDATA_FREE(pdata, scd->ndata);
+    }
+    PMIX_RELEASE(scd);
+}
+
+static void host_lkcb(pmix_status_t status,
+                      pmix_pdata_t data[], size_t ndata,
+                      void *cbdata)
+{
+    pmix_shift_caddy_t *scd;
+    pmix_pdata_t *pdata = NULL;
+    size_t n;
+
+    /* the data is only ours for the duration of the call */
+    if (PMIX_SUCCESS == status && 0 < ndata) {
+        PMIX_PDATA_CREATE(pdata, ndata);
+        for (n=0; NULL != pdata && n < ndata; n++) {
+            pdata[n].proc = data[n].proc;
+            pmix_strncpy(pdata[n].key, data[n].key, PMIX_MAX_KEYLEN);
+            pmix_value_xfer(&pdata[n].value, &data[n].value);
+        }
+    }
+    /* need to thread-shift this callback as it accesses global data */
+    scd = PMIX_NEW(pmix_shift_caddy_t);
+    scd->status = status;
+    scd->data = (const char*)pdata;
+    scd->ndata = (NULL == pdata) ? 0 : ndata;
+    scd->cbdata = cbdata;
+    PMIX_THREADSHIFT(scd, _host_lkcb);
+}
+
+static void ask_host(pmix_pubsub_wait_t *pw)
+{
+    pmix_status_t rc;
+    pmix_proc_t proc;
+
+    pmix_strncpy(proc.nspace, pw->peer->info->pname.nspace, PMIX_MAX_NSLEN);
+    proc.rank = pw->peer->info->pname.rank;
+    pw->inflight = true;
+    rc = pmix_host_server.lookup(&proc, pw->keys,
+                                 pw->info, pw->ninfo, host_lkcb, pw);
+    if (PMIX_SUCCESS != rc) {
+        pw->inflight = false;
+        if (PMIX_ERR_NOT_FOUND == rc) {
+            park(pw);
+            return;
+        }
+        pw->cbfunc(rc, NULL, 0, pw->cbdata);
+        PMIX_RELEASE(pw);
+    }
+}
+
+static void wait_timeout(int sd, short args, void *cbdata)
+{
+    pmix_pubsub_wait_t *pw = (pmix_pubsub_wait_t*)cbdata;
+
+    pmix_output_verbose(2, pmix_server_globals.pub_output,
+                        "pmix:server lookup wait timed out");
+    pw->timer_active = false;
+    pw->cbfunc(PMIX_ERR_TIMEOUT, NULL, 0, pw->cbdata);
+    if (pw->inflight) {
+        /* released when the host answers */
+        pw->expired = true;
+        return;
+    }
+    unpark(pw);
+    PMIX_RELEASE(pw);
+}
+
+pmix_status_t pmix_server_pubsub_publish(pmix_peer_t *peer,
+                                         pmix_info_t *info, size_t ninfo,
+                                         bool host, pmix_op_cbfunc_t cbfunc,
+                                         void *cbdata)
+{
+    pmix_data_range_t range;
+    pmix_pubsub_data_t *pd;
+    size_t n;
+
+    range = get_range(info, ninfo);
+    if (!store || (PMIX_RANGE_LOCAL != range && PMIX_RANGE_NAMESPACE != range)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    /* a key may only be published once in a given range */
+    for (n=0; n < ninfo; n++) {
+        if (is_directive(&info[n])) {
+            continue;
+        }
+        if (NULL != find(range, peer->info->pname.nspace, info[n].key)) {
+            return PMIX_EXISTS;
+        }
+    }
+
+    for (n=0; n < ninfo; n++) {
+        if (is_directive(&info[n])) {
+            continue;
+        }
+        pd = PMIX_NEW(pmix_pubsub_data_t);
+        if (NULL == pd) {
+            return PMIX_ERR_NOMEM;
+        }
+        pd->idx = idx_key(range, peer->info->pname.nspace, info[n].key);
+        if (NULL == pd->idx) {
+            PMIX_RELEASE(pd);
+            return PMIX_ERR_NOMEM;
+        }
+        pmix_strncpy(pd->owner.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
+        pd->owner.rank = peer->info->pname.rank;
+        pd->range = range;
+        pmix_strncpy(pd->key, info[n].key, PMIX_MAX_KEYLEN);
+        pmix_value_xfer(&pd->value, &info[n].value);
+        pmix_list_append(&pubdata, &pd->super);
+        pmix_hash_table_set_value_ptr(&pubidx, pd->idx, strlen(pd->idx), pd);
+        pmix_output_verbose(2, pmix_server_globals.pub_output,
+                            "pmix:server pubsub stored %s", pd->idx);
+    }
+
+    pmix_server_pubsub_wake(info, ninfo);
+
+    /* procs of the nspace may live elsewhere */
+    if (PMIX_RANGE_NAMESPACE == range && host) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    cbfunc(PMIX_SUCCESS, cbdata);
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_server_pubsub_lookup(pmix_peer_t *peer, char **keys,
+                                        pmix_info_t *info, size_t ninfo,
+                                        bool host, pmix_lookup_cbfunc_t cbfunc,
+                                        void *cbdata)
+{
+    pmix_data_range_t range;
+    pmix_pubsub_wait_t *pw;
+    pmix_pdata_t *pdata;
+    size_t n, nkeys, nfound, nwait = 0;
+    bool wait = false;
+    struct timeval tv = {0, 0};
+    pmix_status_t rc;
+    pmix_proc_t proc;
+
+    range = get_range(info, ninfo);
+    if (!serves(range)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    for (n=0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_WAIT)) {
+            wait = true;
+            PMIX_VALUE_GET_NUMBER(rc, &info[n].value, nwait, size_t);
+            if (PMIX_SUCCESS != rc) {
+                nwait = 0;
+            }
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_TIMEOUT)) {
+            tv.tv_sec = info[n].value.data.uint32;
+        }
+    }
+    nkeys = pmix_argv_count(keys);
+    if (0 == nwait || nkeys < nwait) {
+        nwait = nkeys;
+    }
+
+    nfound = lookup_keys(peer, range, keys, &pdata);
+    if (0 < nfound && nfound >= nwait) {
+        pmix_output_verbose(2, pmix_server_globals.pub_output,
+                            "pmix:server pubsub lookup satisfied locally");
+        cbfunc(PMIX_SUCCESS, pdata, nfound, cbdata);
+        PMIX_PDATA_FREE(pdata, nkeys);
+        return PMIX_SUCCESS;
+    }
+
+    /* let the host look for anything that isn't node-local */
+    if (!wait && PMIX_RANGE_LOCAL != range && host) {
+        if (NULL != pdata) {
+            PMIX_PDATA_FREE(pdata, nkeys);
+        }
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    if (!wait) {
+        /* whatever we have is all there is */
+        if (0 == nfound) {
+            cbfunc(PMIX_ERR_NOT_FOUND, NULL, 0, cbdata);
+        } else {
+            cbfunc(PMIX_SUCCESS, pdata, nfound, cbdata);
+            PMIX_PDATA_FREE(pdata, nkeys);
+        }
+        return PMIX_SUCCESS;
+    }
+    if (NULL != pdata) {
+        PMIX_PDATA_FREE(pdata, nkeys);
+    }
+
+    /* wait for the rest to be published */
+    pw = PMIX_NEW(pmix_pubsub_wait_t);
+    if (NULL == pw) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_RETAIN(peer);
+    pw->peer = peer;
+    pw->range = range;
+    pw->keys = pmix_argv_copy(keys);
+    pw->nwait = nwait;
+    pw->cbfunc = cbfunc;
+    pw->cbdata = cbdata;
+    pw->host = (PMIX_RANGE_LOCAL != range && host);
+    if (pw->host && 0 < ninfo) {
+        pw->ninfo = ninfo;
+        PMIX_INFO_CREATE(pw->info, pw->ninfo);
+        for (n=0; n < ninfo; n++) {
+            PMIX_INFO_XFER(&pw->info[n], &info[n]);
+        }
+    }
+    if (0 < tv.tv_sec) {
+        pmix_timer_add(&pw->timer, wait_timeout, pw, &tv);
+        pw->timer_active = true;
+    }
+    if (!pw->host) {
+        park(pw);
+        return PMIX_SUCCESS;
+    }
+    /* if the host won't even take the request, fail it as before */
+    pmix_strncpy(proc.nspace, peer->info->pname.nspace, PMIX_MAX_NSLEN);
+    proc.rank = peer->info->pname.rank;
+    pw->inflight = true;
+    rc = pmix_host_server.lookup(&proc, pw->keys,
+                                 pw->info, pw->ninfo, host_lkcb, pw);
+    if (PMIX_SUCCESS != rc) {
+        pw->cbfunc = NULL;
+        PMIX_RELEASE(pw);
+        return rc;
+    }
+    return PMIX_SUCCESS;
+}
+
+static bool has_key(char **keys, const char *key)
+{
+    int n;
+
+    for (n=0; NULL != keys[n]; n++) {
+        if (0 == strcmp(keys[n], key)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+pmix_status_t pmix_server_pubsub_unpublish(pmix_peer_t *peer, char **keys,
+                                           pmix_info_t *info, size_t ninfo,
+                                           bool host, pmix_op_cbfunc_t cbfunc,
+                                           void *cbdata)
+{
+    pmix_data_range_t range;
+    pmix_pubsub_data_t *pd, *next;
+
+    range = get_range(info, ninfo);
+    if (!store || !serves(range)) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+
+    /* only the publisher can remove its data */
+    PMIX_LIST_FOREACH_SAFE(pd, next, &pubdata, pmix_pubsub_data_t) {
+        if (!PMIX_CHECK_PROCID(&pd->owner, &peer->info->pname)) {
+            continue;
+        }
+        if ((PMIX_RANGE_LOCAL == range || PMIX_RANGE_NAMESPACE == range) &&
+            range != pd->range) {
+            continue;
+        }
+        if (NULL != keys && !has_key(keys, pd->key)) {
+            continue;
+        }
+        drop(pd);
+    }
+
+    if (PMIX_RANGE_LOCAL != range && host) {
+        return PMIX_ERR_TAKE_NEXT_OPTION;
+    }
+    cbfunc(PMIX_SUCCESS, cbdata);
+    return PMIX_SUCCESS;
+}
+
+void pmix_server_pubsub_purge(const char *nspace)
+{
+    pmix_pubsub_data_t *pd, *pdnext;
+    pmix_pubsub_wait_t *pw, *pwnext;
+
+    if (!initialized) {
+        return;
+    }
+    if (store) {
+        PMIX_LIST_FOREACH_SAFE(pd, pdnext, &pubdata, pmix_pubsub_data_t) {
+            if (PMIX_CHECK_NSPACE(pd->owner.nspace, nspace)) {
+                drop(pd);
+            }
+        }
+    }
+    PMIX_LIST_FOREACH_SAFE(pw, pwnext, &pubwait, pmix_pubsub_wait_t) {
+        if (PMIX_CHECK_NSPACE(pw->peer->info->pname.nspace, nspace)) {
+            unpark(pw);
+            pw->cbfunc(PMIX_ERR_NOT_FOUND, NULL, 0, pw->cbdata);
+            PMIX_RELEASE(pw);
+        }
+    }
+}
@@ -0,0 +1,252 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * A periodic scan of the requests the server is holding on behalf
+ * of its clients - collectives (fence, connect, disconnect, group),
+ * direct modex gets, and queries passed to the host. Anything that
+ * has been outstanding longer than pmix_server_watchdog msec is
+ * recorded once, with the requester and the phase it is stuck in,
+ * in a bounded ring. The ring can be read with a PMIX_QUERY_SLOW_REQUESTS
+ * query or printed by sending the server pmix_server_watchdog_signal.
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <src/include/types.h>
+#include <src/include/pmix_stdint.h>
+
+#include <pmix_server.h>
+#include <pmix_rename.h>
+#include "src/include/pmix_globals.h"
+
+#ifdef HAVE_STRING_H
+#include <string.h>
+#endif
+#include <stdio.h>
+#include PMIX_EVENT_HEADER
+
+#include "src/class/pmix_list.h"
+#include "src/class/pmix_ring_buffer.h"
+#include "src/util/counters.h"
+#include "src/util/error.h"
+#include "src/util/output.h"
+
+#include "pmix_server_ops.h"
+
+static void record(uint64_t now, uint64_t start, const char *fmt, ...)
+    __pmix_attribute_format__(__printf__, 3, 4);
+
+static void record(uint64_t now, uint64_t start, const char *fmt, ...)
+{
+    va_list ap;
+    char *what, *rec;
+
+    va_start(ap, fmt);
+    if (0 > vasprintf(&what, fmt, ap)) {
+        va_end(ap);
+        return;
+    }
+    va_end(ap);
+    if (0 > asprintf(&rec, "%s age=%lums", what,
+                     (unsigned long)((now - start) / 1000000))) {
+        free(what);
+        return;
+    }
+    free(what);
+
+    pmix_output_verbose(1, pmix_server_globals.base_output,
+                        "pmix:server slow request: %s", rec);
+    /* the ring hands back whatever it displaced */
+    free(pmix_ring_buffer_push(&pmix_server_globals.slow, rec));
+}
+
+static void scan(int sd, short args, void *cbdata)
+{
+    pmix_server_trkr_t *trk;
+    pmix_server_caddy_t *cd;
+    pmix_dmdx_local_t *lcd;
+    uint64_t now, limit;
+    const char *phase;
+
+    now = pmix_counter_now();
+    limit = (uint64_t)pmix_server_globals.watchdog * 1000000;
+
+    PMIX_LIST_FOREACH(trk, &pmix_server_globals.collectives, pmix_server_trkr_t) {
+        if (trk->slow || now - trk->t_start < limit) {
+            continue;
+        }
+        trk->slow = true;
+        if (trk->local_cnt < trk->nlocal || !trk->def_complete) {
+            phase = "local";
+        } else if (0 != trk->t_upcall) {
+            phase = "host";
+        } else {
+            phase = "upcall";
+        }
+        cd = (pmix_server_caddy_t*)pmix_list_get_first(&trk->local_cbs);
+        if (pmix_list_get_end(&trk->local_cbs) == &cd->super || NULL == cd->peer) {
+            record(now, trk->t_start, "%s id=%s nprocs=%lu phase=%s arrived=%u/%u",
+                   pmix_command_string(trk->type),
+                   (NULL == trk->id) ? "-" : trk->id, (unsigned long)trk->npcs,
+                   phase, trk->local_cnt, trk->nlocal);
+        } else {
+            record(now, trk->t_start, "%s id=%s nprocs=%lu phase=%s arrived=%u/%u peer=%s:%u",
+                   pmix_command_string(trk->type),
+                   (NULL == trk->id) ? "-" : trk->id, (unsigned long)trk->npcs,
+                   phase, trk->local_cnt, trk->nlocal,
+                   cd->peer->info->pname.nspace, cd->peer->info->pname.rank);
+        }
+    }
+
+    PMIX_LIST_FOREACH(lcd, &pmix_server_globals.local_reqs, pmix_dmdx_local_t) {
+        if (lcd->slow || now - lcd->start < limit) {
+            continue;
+        }
+        lcd->slow = true;
+        record(now, lcd->start, "get key=%s:%u phase=dmodex waiters=%lu",
+               lcd->proc.nspace, lcd->proc.rank,
+               (unsigned long)pmix_list_get_size(&lcd->loc_reqs));
+    }
+
+    pmix_mutex_lock(&pmix_server_globals.query_lock);
+    PMIX_LIST_FOREACH(cd, &pmix_server_globals.queries, pmix_server_caddy_t) {
+        if (cd->slow || now - cd->start < limit) {
+            continue;
+        }
+        cd->slow = true;
+        record(now, cd->start, "query phase=host peer=%s:%u",
+               cd->peer->info->pname.nspace, cd->peer->info->pname.rank);
+    }
+    pmix_mutex_unlock(&pmix_server_globals.query_lock);
+}
+
+static void dump(int sd, short args, void *cbdata)
+{
+    char *rec;
+    int n;
+
+    pmix_output(0, "pmix:server %s:%u: most recent slow requests",
+                pmix_globals.myid.nspace, pmix_globals.myid.rank);
+    for (n=0; NULL != (rec = (char*)pmix_ring_buffer_poke(&pmix_server_globals.slow, n)); n++) {
+        pmix_output(0, "    %s", rec);
+    }
+}
+
+void pmix_server_watchdog_start(void)
+{
+    struct timeval tv;
+
+    PMIX_CONSTRUCT(&pmix_server_globals.slow, pmix_ring_buffer_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.queries, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_server_globals.query_lock, pmix_mutex_t);
+    pmix_server_globals.watchdog_active = false;
+    if (0 >= pmix_server_globals.watchdog) {
+        return;
+    }
+    if (PMIX_SUCCESS != pmix_ring_buffer_init(&pmix_server_globals.slow,
+                                              pmix_server_globals.watchdog_records)) {
+        PMIX_ERROR_LOG(PMIX_ERR_NOMEM);
+        return;
+    }
+
+    /* scanning at half the threshold reports a request
+     * at most 1.5x the threshold after it arrived */
+    tv.tv_sec = pmix_server_globals.watchdog / 2000;
+    tv.tv_usec = ((pmix_server_globals.watchdog / 2) % 1000) * 1000;
+    if (0 == tv.tv_sec && 0 == tv.tv_usec) {
+        tv.tv_usec = 1000;
+    }
+    pmix_event_set(pmix_globals.evbase, &pmix_server_globals.watchdog_ev,
+                   -1, EV_PERSIST, scan, NULL);
+    pmix_event_add(&pmix_server_globals.watchdog_ev, &tv);
+    if (0 < pmix_server_globals.watchdog_signal) {
+        pmix_event_signal_set(pmix_globals.evbase, &pmix_server_globals.watchdog_sigev,
+                              pmix_server_globals.watchdog_signal, dump, NULL);
+        pmix_event_add(&pmix_server_globals.watchdog_sigev, NULL);
+    }
+    pmix_server_globals.watchdog_active = true;
+}
+
+void pmix_server_watchdog_stop(void)
+{
+    char *rec;
+
+    if (pmix_server_globals.watchdog_active) {
+        pmix_event_del(&pmix_server_globals.watchdog_ev);
+        if (0 < pmix_server_globals.watchdog_signal) {
+            pmix_event_del(&pmix_server_globals.watchdog_sigev);
+        }
+        pmix_server_globals.watchdog_active = false;
+    }
+    while (NULL != (rec = (char*)pmix_ring_buffer_pop(&pmix_server_globals.slow))) {
+        free(rec);
+    }
+    PMIX_DESTRUCT(&pmix_server_globals.slow);
+    /* the queries still out belong to the host */
+    while (NULL != pmix_list_remove_first(&pmix_server_globals.queries));
+    PMIX_DESTRUCT(&pmix_server_globals.queries);
+    PMIX_DESTRUCT(&pmix_server_globals.query_lock);
+}
+
+/* the host may answer a query on its own thread, so the
+ * list of queries out with it is guarded by a lock */
+void pmix_server_watchdog_query(pmix_server_caddy_t *cd)
+{
+    if (!pmix_server_globals.watchdog_active) {
+        return;
+    }
+    cd->start = pmix_counter_now();
+    pmix_mutex_lock(&pmix_server_globals.query_lock);
+    pmix_list_append(&pmix_server_globals.queries, &cd->super);
+    pmix_mutex_unlock(&pmix_server_globals.query_lock);
+}
+
+void pmix_server_watchdog_query_done(pmix_server_caddy_t *cd)
+{
+    if (0 == cd->start) {
+        return;
+    }
+    pmix_mutex_lock(&pmix_server_globals.query_lock);
+    pmix_list_remove_item(&pmix_server_globals.queries, &cd->super);
+    pmix_mutex_unlock(&pmix_server_globals.query_lock);
+    cd->start = 0;
+}
+
+pmix_status_t pmix_server_watchdog_load(pmix_value_t *val)
+{
+    pmix_data_array_t *darray;
+    char **recs, *rec;
+    int n, nrecs;
+
+    for (nrecs=0; NULL != pmix_ring_buffer_poke(&pmix_server_globals.slow, nrecs); nrecs++);
+
+    PMIX_DATA_ARRAY_CREATE(darray, nrecs, PMIX_STRING);
+    if (NULL == darray) {
+        return PMIX_ERR_NOMEM;
+    }
+    val->type = PMIX_DATA_ARRAY;
+    val->data.darray = darray;
+    if (0 == nrecs) {
+        return PMIX_SUCCESS;
+    }
+    recs = (char**)calloc(nrecs, sizeof(char*));
+    if (NULL == recs) {
+        return PMIX_ERR_NOMEM;
+    }
+    darray->array = recs;
+    for (n=0; n < nrecs; n++) {
+        rec = (char*)pmix_ring_buffer_poke(&pmix_server_globals.slow, n);
+        if (NULL == (recs[n] = strdup(rec))) {
+            return PMIX_ERR_NOMEM;
+        }
+    }
+    return PMIX_SUCCESS;
+}
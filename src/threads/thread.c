@@ -27,6 +27,7 @@
 #include "pmix_common.h"
 
 bool pmix_debug_threads = false;
+int pmix_thread_spin_limit = 1000;
 
 static void pmix_thread_construct(pmix_thread_t *t);
 
@@ -55,6 +55,10 @@ typedef struct pmix_thread_t pmix_thread_t;
 PMIX_EXPORT extern bool pmix_debug_threads;
 #endif
 
+/* number of polls of a lock made before PMIX_WAIT_THREAD
+ * falls back to sleeping on its condition variable */
+PMIX_EXPORT extern int pmix_thread_spin_limit;
+
 
 PMIX_EXPORT PMIX_CLASS_DECLARATION(pmix_thread_t);
 
@@ -116,9 +120,34 @@ typedef struct {
 #endif
 
 
+/* tell the core we are in a spin-wait loop */
+#if PMIX_ASSEMBLY_ARCH == PMIX_X86_64 || PMIX_ASSEMBLY_ARCH == PMIX_IA32
+#define PMIX_THREAD_PAUSE()     __asm__ __volatile__ ("pause" ::: "memory")
+#elif PMIX_ASSEMBLY_ARCH == PMIX_ARM64
+#define PMIX_THREAD_PAUSE()     __asm__ __volatile__ ("yield" ::: "memory")
+#elif PMIX_ASSEMBLY_ARCH == PMIX_POWERPC64
+#define PMIX_THREAD_PAUSE()     __asm__ __volatile__ ("or 27,27,27" ::: "memory")
+#else
+#define PMIX_THREAD_PAUSE()     __asm__ __volatile__ ("" ::: "memory")
+#endif
+
+/* a blocking call answered locally is usually released within a
+ * few microseconds, so poll the lock briefly before paying for a
+ * sleep/wakeup on the condition. The mutex is still taken once the
+ * lock is seen released so the releaser is done with the lock
+ * before the caller can destruct it */
+#define PMIX_SPIN_THREAD(lck)                                   \
+    do {                                                        \
+        int _spins = pmix_thread_spin_limit;                    \
+        while ((lck)->active && 0 < _spins--) {                 \
+            PMIX_THREAD_PAUSE();                                \
+        }                                                       \
+    } while(0)
+
 #if PMIX_ENABLE_DEBUG
 #define PMIX_WAIT_THREAD(lck)                                   \
     do {                                                        \
+        PMIX_SPIN_THREAD(lck);                                  \
         pmix_mutex_lock(&(lck)->mutex);                         \
         if (pmix_debug_threads) {                               \
             pmix_output(0, "Waiting for thread %s:%d",          \
@@ -137,6 +166,7 @@ typedef struct {
 #else
 #define PMIX_WAIT_THREAD(lck)                                   \
     do {                                                        \
+        PMIX_SPIN_THREAD(lck);                                  \
         pmix_mutex_lock(&(lck)->mutex);                         \
         while ((lck)->active) {                                 \
             pmix_condition_wait(&(lck)->cond, &(lck)->mutex);   \
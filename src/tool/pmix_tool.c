@@ -56,6 +56,7 @@
 #include "src/util/argv.h"
 #include "src/util/error.h"
 #include "src/util/hash.h"
+#include "src/util/name_fns.h"
 #include "src/util/output.h"
 #include "src/util/pmix_environ.h"
 #include "src/util/show_help.h"
@@ -226,15 +227,92 @@ static void tool_iof_handler(struct pmix_peer_t *pr,
     PMIX_BYTE_OBJECT_DESTRUCT(&bo);
 }
 
+/* job info kept across PMIx_tool_finalize so that a tool attaching
+ * to the same job again need not have it resent. This has to
+ * outlive the class system, so it is held in plain memory */
+typedef struct tool_jobcache_t {
+    struct tool_jobcache_t *next;
+    char *nspace;
+    char *tag;                  // server's PMIX_JOB_INFO_TAG_KEY for the blob
+    pmix_byte_object_t blob;    // job info as the server packed it
+} tool_jobcache_t;
+static tool_jobcache_t *jobcache = NULL;
+
+static tool_jobcache_t* jobcache_find(const char *nspace)
+{
+    tool_jobcache_t *jc;
+
+    for (jc = jobcache; NULL != jc; jc = jc->next) {
+        if (0 == strncmp(jc->nspace, nspace, PMIX_MAX_NSLEN)) {
+            return jc;
+        }
+    }
+    return NULL;
+}
+
+/* keep a copy of the job info about to be stored, provided
+ * the server tagged it */
+static void jobcache_save(const char *nspace, char *bytes, size_t size)
+{
+    tool_jobcache_t *jc;
+    pmix_cb_t cb;
+    pmix_proc_t wildcard;
+    pmix_kval_t *kv;
+    pmix_status_t rc;
+    char *copy;
+
+    PMIX_LOAD_PROCID(&wildcard, nspace, PMIX_RANK_WILDCARD);
+    PMIX_CONSTRUCT(&cb, pmix_cb_t);
+    cb.proc = &wildcard;
+    cb.key = PMIX_JOB_INFO_TAG_KEY;
+    cb.scope = PMIX_INTERNAL;
+    cb.copy = false;
+    PMIX_GDS_FETCH_KV(rc, pmix_client_globals.myserver, &cb);
+    if (PMIX_SUCCESS != rc || 1 != pmix_list_get_size(&cb.kvs)) {
+        PMIX_DESTRUCT(&cb);
+        return;
+    }
+    kv = (pmix_kval_t*)pmix_list_get_first(&cb.kvs);
+    if (PMIX_STRING != kv->value->type || NULL == kv->value->data.string ||
+        NULL == (copy = (char*)malloc(size))) {
+        PMIX_DESTRUCT(&cb);
+        return;
+    }
+    memcpy(copy, bytes, size);
+
+    if (NULL == (jc = jobcache_find(nspace))) {
+        jc = (tool_jobcache_t*)calloc(1, sizeof(tool_jobcache_t));
+        if (NULL == jc) {
+            free(copy);
+            PMIX_DESTRUCT(&cb);
+            return;
+        }
+        jc->nspace = strdup(nspace);
+        jc->next = jobcache;
+        jobcache = jc;
+    }
+    if (NULL != jc->tag) {
+        free(jc->tag);
+    }
+    jc->tag = strdup(kv->value->data.string);
+    PMIX_BYTE_OBJECT_DESTRUCT(&jc->blob);
+    jc->blob.bytes = copy;
+    jc->blob.size = size;
+    PMIX_DESTRUCT(&cb);
+}
+
 /* callback to receive job info */
 static void job_data(struct pmix_peer_t *pr,
                      pmix_ptl_hdr_t *hdr,
                      pmix_buffer_t *buf, void *cbdata)
 {
     pmix_status_t rc;
-    char *nspace;
+    char *nspace, *bytes;
     int32_t cnt = 1;
+    size_t size;
     pmix_cb_t *cb = (pmix_cb_t*)cbdata;
+    tool_jobcache_t *jc;
+    pmix_buffer_t held;
 
     /* unpack the nspace - should be same as our own */
     PMIX_BFROPS_UNPACK(rc, pmix_client_globals.myserver,
@@ -247,10 +325,37 @@ static void job_data(struct pmix_peer_t *pr,
         return;
     }
 
-    /* decode it */
-    PMIX_GDS_STORE_JOB_INFO(cb->status,
-                            pmix_client_globals.myserver,
-                            nspace, buf);
+    bytes = buf->unpack_ptr;
+    size = buf->bytes_used - (buf->unpack_ptr - buf->base_ptr);
+    jc = (NULL == cb->key) ? NULL : jobcache_find(nspace);
+    if (0 == size && NULL != jc) {
+        /* the server agreed that what we kept is current */
+        size = jc->blob.size;
+        bytes = (char*)malloc(size);
+        if (NULL == bytes) {
+            free(nspace);
+            cb->status = PMIX_ERR_NOMEM;
+            PMIX_POST_OBJECT(cb);
+            PMIX_WAKEUP_THREAD(&cb->lock);
+            return;
+        }
+        memcpy(bytes, jc->blob.bytes, size);
+        PMIX_CONSTRUCT(&held, pmix_buffer_t);
+        PMIX_LOAD_BUFFER(pmix_client_globals.myserver, &held, bytes, size);
+        PMIX_GDS_STORE_JOB_INFO(cb->status,
+                                pmix_client_globals.myserver,
+                                nspace, &held);
+        PMIX_DESTRUCT(&held);
+    } else {
+        /* decode it */
+        PMIX_GDS_STORE_JOB_INFO(cb->status,
+                                pmix_client_globals.myserver,
+                                nspace, buf);
+        if (0 < size) {
+            jobcache_save(nspace, bytes, size);
+        }
+    }
+    free(nspace);
     cb->status = PMIX_SUCCESS;
     PMIX_POST_OBJECT(cb);
     PMIX_WAKEUP_THREAD(&cb->lock);
@@ -278,6 +383,7 @@ PMIX_EXPORT int PMIx_tool_init(pmix_proc_t *proc,
     pmix_cb_t cb;
     pmix_buffer_t *req;
     pmix_cmd_t cmd = PMIX_REQ_CMD;
+    tool_jobcache_t *jc;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
 
@@ -449,12 +555,20 @@ PMIX_EXPORT int PMIx_tool_init(pmix_proc_t *proc,
     rcv->cbfunc = tool_iof_handler;
     /* add it to the end of the list of recvs */
     pmix_list_append(&pmix_ptl_globals.posted_recvs, &rcv->super);
+    /* and the one for output sent in batches */
+    rcv = PMIX_NEW(pmix_ptl_posted_recv_t);
+    rcv->tag = PMIX_PTL_TAG_IOF_BATCH;
+    rcv->cbfunc = pmix_iof_batch_recv;
+    pmix_list_append(&pmix_ptl_globals.posted_recvs, &rcv->super);
 
 
     /* setup the globals */
     PMIX_CONSTRUCT(&pmix_client_globals.pending_requests, pmix_list_t);
+    PMIX_CONSTRUCT(&pmix_client_globals.resolved, pmix_list_t);
     PMIX_CONSTRUCT(&pmix_client_globals.peers, pmix_pointer_array_t);
     pmix_pointer_array_init(&pmix_client_globals.peers, 1, INT_MAX, 1);
+    PMIX_CONSTRUCT(&pmix_client_globals.servers, pmix_pointer_array_t);
+    pmix_pointer_array_init(&pmix_client_globals.servers, 1, INT_MAX, 1);
     pmix_client_globals.myserver = PMIX_NEW(pmix_peer_t);
     if (NULL == pmix_client_globals.myserver) {
         if (gdsfound) {
@@ -714,8 +828,22 @@ PMIX_EXPORT int PMIx_tool_init(pmix_proc_t *proc,
             PMIX_RELEASE_THREAD(&pmix_global_lock);
             return rc;
         }
-        /* send to the server */
         PMIX_CONSTRUCT(&cb, pmix_cb_t);
+        /* if we kept the job info from an earlier attach, say
+         * which we have so the server need not resend it */
+        if (NULL != (jc = jobcache_find(pmix_globals.myid.nspace))) {
+            PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
+                             req, &jc->tag, 1, PMIX_STRING);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                PMIX_RELEASE(req);
+                PMIX_DESTRUCT(&cb);
+                PMIX_RELEASE_THREAD(&pmix_global_lock);
+                return rc;
+            }
+            cb.key = jc->tag;
+        }
+        /* send to the server */
         PMIX_PTL_SEND_RECV(rc, pmix_client_globals.myserver,
                            req, job_data, (void*)&cb);
         if (PMIX_SUCCESS != rc) {
@@ -1098,7 +1226,6 @@ PMIX_EXPORT pmix_status_t PMIx_tool_finalize(void)
     struct timeval tv = {5, 0};
     int n;
     pmix_peer_t *peer;
-    pmix_setup_caddy_t *cd;
 
     PMIX_ACQUIRE_THREAD(&pmix_global_lock);
     if (1 != pmix_globals.init_cntr) {
@@ -1174,23 +1301,27 @@ PMIX_EXPORT pmix_status_t PMIx_tool_finalize(void)
 
 //    PMIX_RELEASE(pmix_client_globals.myserver);
     PMIX_LIST_DESTRUCT(&pmix_client_globals.pending_requests);
+    PMIX_LIST_DESTRUCT(&pmix_client_globals.resolved);
     for (n=0; n < pmix_client_globals.peers.size; n++) {
         if (NULL != (peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_client_globals.peers, n))) {
             PMIX_RELEASE(peer);
         }
     }
+    /* any servers we attached to in addition to our primary
+     * one simply see our connection close */
+    for (n=0; n < pmix_client_globals.servers.size; n++) {
+        if (NULL != (peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_client_globals.servers, n))) {
+            PMIX_RELEASE(peer);
+        }
+    }
+    PMIX_DESTRUCT(&pmix_client_globals.servers);
 
     if (PMIX_PROC_IS_LAUNCHER(pmix_globals.mypeer)) {
         pmix_ptl_base_stop_listening();
+        pmix_server_watchdog_stop();
 
         /* cleanout any IOF */
-        for (n=0; n < PMIX_IOF_HOTEL_SIZE; n++) {
-            pmix_hotel_checkout_and_return_occupant(&pmix_server_globals.iof, n, (void**)&cd);
-            if (NULL != cd) {
-                PMIX_RELEASE(cd);
-            }
-        }
-        PMIX_DESTRUCT(&pmix_server_globals.iof);
+        pmix_server_iof_purge();
         for (n=0; n < pmix_server_globals.clients.size; n++) {
             if (NULL != (peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_server_globals.clients, n))) {
                 PMIX_RELEASE(peer);
@@ -1199,10 +1330,14 @@ PMIX_EXPORT pmix_status_t PMIx_tool_finalize(void)
 
         PMIX_DESTRUCT(&pmix_server_globals.clients);
         PMIX_LIST_DESTRUCT(&pmix_server_globals.collectives);
+        PMIX_DESTRUCT(&pmix_server_globals.trkidx);
         PMIX_LIST_DESTRUCT(&pmix_server_globals.remote_pnd);
         PMIX_LIST_DESTRUCT(&pmix_server_globals.local_reqs);
+        PMIX_DESTRUCT(&pmix_server_globals.dmdxidx);
+        PMIX_DESTRUCT(&pmix_server_globals.dmdxns);
         PMIX_LIST_DESTRUCT(&pmix_server_globals.gdata);
         PMIX_LIST_DESTRUCT(&pmix_server_globals.events);
+        PMIX_DESTRUCT(&pmix_server_globals.evidx);
         PMIX_LIST_DESTRUCT(&pmix_server_globals.nspaces);
     }
 
@@ -1290,3 +1425,540 @@ pmix_status_t PMIx_tool_connect_to_server(pmix_proc_t *proc,
     rc = pmix_ptl_base_connect_to_peer((struct pmix_peer_t*)pmix_client_globals.myserver, info, ninfo);
     return rc;
 }
+
+/****    MULTIPLE SERVER SUPPORT    ****/
+
+/* tracks an operation on the servers this tool is attached to */
+typedef struct {
+    pmix_object_t super;
+    pmix_event_t ev;
+    pmix_lock_t lock;
+    pmix_status_t status;
+    pmix_peer_t *peer;
+    pmix_proc_t *procs;
+    pmix_peer_t **peers;
+    size_t npeers;
+    pmix_buffer_t *msg;
+    pmix_info_t *results;
+    size_t nresults;
+    size_t nreplies;
+    pmix_info_cbfunc_t cbfunc;
+    void *cbdata;
+} tool_fanout_t;
+static void focon(tool_fanout_t *p)
+{
+    PMIX_CONSTRUCT_LOCK(&p->lock);
+    p->status = PMIX_SUCCESS;
+    p->peer = NULL;
+    p->procs = NULL;
+    p->peers = NULL;
+    p->npeers = 0;
+    p->msg = NULL;
+    p->results = NULL;
+    p->nresults = 0;
+    p->nreplies = 0;
+    p->cbfunc = NULL;
+    p->cbdata = NULL;
+}
+static void fodes(tool_fanout_t *p)
+{
+    size_t n;
+
+    PMIX_DESTRUCT_LOCK(&p->lock);
+    if (NULL != p->procs) {
+        PMIX_PROC_FREE(p->procs, p->npeers);
+    }
+    if (NULL != p->peers) {
+        for (n=0; n < p->npeers; n++) {
+            PMIX_RELEASE(p->peers[n]);
+        }
+        free(p->peers);
+    }
+    if (NULL != p->msg) {
+        PMIX_RELEASE(p->msg);
+    }
+    if (NULL != p->results) {
+        PMIX_INFO_FREE(p->results, p->npeers);
+    }
+}
+static PMIX_CLASS_INSTANCE(tool_fanout_t,
+                           pmix_object_t,
+                           focon, fodes);
+
+static bool _is_server(pmix_peer_t *peer, const pmix_proc_t *proc)
+{
+    if (NULL == peer || NULL == peer->info || NULL == peer->info->pname.nspace) {
+        return false;
+    }
+    return (PMIX_CHECK_NSPACE(peer->info->pname.nspace, proc->nspace) &&
+            peer->info->pname.rank == proc->rank);
+}
+
+static void _attach(int sd, short args, void *cbdata)
+{
+    tool_fanout_t *cd = (tool_fanout_t*)cbdata;
+    pmix_peer_t *peer;
+    int n;
+
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    /* a second connection to the same server gains nothing */
+    if (_is_server(pmix_client_globals.myserver, cd->procs)) {
+        cd->status = PMIX_EXISTS;
+    }
+    for (n=0; PMIX_SUCCESS == cd->status && n < pmix_client_globals.servers.size; n++) {
+        peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_client_globals.servers, n);
+        if (_is_server(peer, cd->procs)) {
+            cd->status = PMIX_EXISTS;
+        }
+    }
+    if (PMIX_SUCCESS == cd->status) {
+        if (0 > pmix_pointer_array_add(&pmix_client_globals.servers, cd->peer)) {
+            cd->status = PMIX_ERR_NOMEM;
+        } else {
+            /* the array now holds our reference */
+            cd->peer = NULL;
+        }
+    }
+    PMIX_POST_OBJECT(cd);
+    PMIX_WAKEUP_THREAD(&cd->lock);
+}
+
+PMIX_EXPORT pmix_status_t PMIx_tool_attach_to_server(pmix_proc_t *server,
+                                                     pmix_info_t info[], size_t ninfo)
+{
+    pmix_peer_t *peer;
+    tool_fanout_t *cd;
+    pmix_status_t rc;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    /* additional servers are only tracked alongside a primary one */
+    if (!pmix_globals.connected) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_UNREACH;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (NULL == info || 0 == ninfo) {
+        pmix_show_help("help-pmix-runtime.txt", "tool:no-server", true);
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    /* the new server talks to us the same way our primary does */
+    peer = PMIX_NEW(pmix_peer_t);
+    if (NULL == peer) {
+        return PMIX_ERR_NOMEM;
+    }
+    peer->nptr = PMIX_NEW(pmix_namespace_t);
+    peer->info = PMIX_NEW(pmix_rank_info_t);
+    if (NULL == peer->nptr || NULL == peer->info) {
+        PMIX_RELEASE(peer);
+        return PMIX_ERR_NOMEM;
+    }
+    peer->nptr->compat.bfrops = pmix_client_globals.myserver->nptr->compat.bfrops;
+    peer->nptr->compat.psec = pmix_client_globals.myserver->nptr->compat.psec;
+    peer->nptr->compat.type = pmix_client_globals.myserver->nptr->compat.type;
+    peer->nptr->compat.gds = pmix_client_globals.myserver->nptr->compat.gds;
+
+    rc = pmix_ptl_base_connect_to_peer((struct pmix_peer_t*)peer, info, ninfo);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_RELEASE(peer);
+        return rc;
+    }
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "pmix:tool attached to server %s:%u",
+                        peer->info->pname.nspace, peer->info->pname.rank);
+
+    /* record it in the progress thread */
+    cd = PMIX_NEW(tool_fanout_t);
+    cd->peer = peer;
+    PMIX_PROC_CREATE(cd->procs, 1);
+    cd->npeers = 1;
+    PMIX_LOAD_PROCID(cd->procs, peer->info->pname.nspace, peer->info->pname.rank);
+    PMIX_THREADSHIFT(cd, _attach);
+    PMIX_WAIT_THREAD(&cd->lock);
+    rc = cd->status;
+    if (PMIX_SUCCESS == rc && NULL != server) {
+        PMIX_LOAD_PROCID(server, cd->procs->nspace, cd->procs->rank);
+    }
+    if (NULL != cd->peer) {
+        /* not kept - this closes the connection */
+        PMIX_RELEASE(cd->peer);
+    }
+    PMIX_RELEASE(cd);
+    return rc;
+}
+
+static void _detach_release(int sd, short args, void *cbdata)
+{
+    tool_fanout_t *cd = (tool_fanout_t*)cbdata;
+
+    PMIX_ACQUIRE_OBJECT(cd);
+    /* let the recv handler finish with the peer before we
+     * close its connection */
+    PMIX_RELEASE(cd->peer);
+    cd->peer = NULL;
+    PMIX_POST_OBJECT(cd);
+    PMIX_WAKEUP_THREAD(&cd->lock);
+}
+
+static void detach_cbfunc(struct pmix_peer_t *pr,
+                          pmix_ptl_hdr_t *hdr,
+                          pmix_buffer_t *buf, void *cbdata)
+{
+    tool_fanout_t *cd = (tool_fanout_t*)cbdata;
+
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "pmix:tool detach sync received");
+    PMIX_THREADSHIFT(cd, _detach_release);
+}
+
+static void _detach(int sd, short args, void *cbdata)
+{
+    tool_fanout_t *cd = (tool_fanout_t*)cbdata;
+    pmix_peer_t *peer = NULL;
+    pmix_buffer_t *msg;
+    pmix_cmd_t cmd = PMIX_FINALIZE_CMD;
+    pmix_status_t rc;
+    int n;
+
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    for (n=0; n < pmix_client_globals.servers.size; n++) {
+        peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_client_globals.servers, n);
+        if (_is_server(peer, cd->procs)) {
+            break;
+        }
+        peer = NULL;
+    }
+    if (NULL == peer) {
+        /* the primary server can only be switched */
+        if (_is_server(pmix_client_globals.myserver, cd->procs)) {
+            cd->status = PMIX_ERR_NOT_SUPPORTED;
+        } else {
+            cd->status = PMIX_ERR_NOT_FOUND;
+        }
+        goto done;
+    }
+    /* take it out of the array - we now hold its reference */
+    pmix_pointer_array_set_item(&pmix_client_globals.servers, n, NULL);
+    cd->peer = peer;
+
+    /* gracefully terminate the connection */
+    msg = PMIX_NEW(pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, peer, msg, &cmd, 1, PMIX_COMMAND);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(msg);
+    } else {
+        PMIX_PTL_SEND_RECV(rc, peer, msg, detach_cbfunc, (void*)cd);
+        if (PMIX_SUCCESS == rc) {
+            /* we will be woken up once the server answers */
+            return;
+        }
+        PMIX_RELEASE(msg);
+    }
+    /* just drop the connection */
+    PMIX_RELEASE(cd->peer);
+    cd->peer = NULL;
+
+  done:
+    PMIX_POST_OBJECT(cd);
+    PMIX_WAKEUP_THREAD(&cd->lock);
+}
+
+PMIX_EXPORT pmix_status_t PMIx_tool_detach_from_server(const pmix_proc_t *server)
+{
+    tool_fanout_t *cd;
+    pmix_status_t rc;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (NULL == server) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    cd = PMIX_NEW(tool_fanout_t);
+    PMIX_PROC_CREATE(cd->procs, 1);
+    cd->npeers = 1;
+    PMIX_LOAD_PROCID(cd->procs, server->nspace, server->rank);
+    PMIX_THREADSHIFT(cd, _detach);
+    PMIX_WAIT_THREAD(&cd->lock);
+    rc = cd->status;
+    PMIX_RELEASE(cd);
+    return rc;
+}
+
+/* collect the servers we are connected to, primary first. The
+ * caddy takes a reference to each peer */
+static void _collect_servers(tool_fanout_t *cd)
+{
+    pmix_peer_t *peer;
+    size_t n;
+    int m;
+
+    n = pmix_globals.connected ? 1 : 0;
+    for (m=0; m < pmix_client_globals.servers.size; m++) {
+        if (NULL != pmix_pointer_array_get_item(&pmix_client_globals.servers, m)) {
+            ++n;
+        }
+    }
+    if (0 == n) {
+        return;
+    }
+    PMIX_PROC_CREATE(cd->procs, n);
+    cd->peers = (pmix_peer_t**)malloc(n * sizeof(pmix_peer_t*));
+    if (NULL == cd->procs || NULL == cd->peers) {
+        cd->status = PMIX_ERR_NOMEM;
+        return;
+    }
+    n = 0;
+    if (pmix_globals.connected) {
+        cd->peers[n++] = pmix_client_globals.myserver;
+    }
+    for (m=0; m < pmix_client_globals.servers.size; m++) {
+        if (NULL != (peer = (pmix_peer_t*)pmix_pointer_array_get_item(&pmix_client_globals.servers, m))) {
+            cd->peers[n++] = peer;
+        }
+    }
+    for (cd->npeers=0; cd->npeers < n; cd->npeers++) {
+        peer = cd->peers[cd->npeers];
+        PMIX_RETAIN(peer);
+        PMIX_LOAD_PROCID(&cd->procs[cd->npeers], peer->info->pname.nspace, peer->info->pname.rank);
+    }
+}
+
+static void _getservers(int sd, short args, void *cbdata)
+{
+    tool_fanout_t *cd = (tool_fanout_t*)cbdata;
+
+    PMIX_ACQUIRE_OBJECT(cd);
+    _collect_servers(cd);
+    PMIX_POST_OBJECT(cd);
+    PMIX_WAKEUP_THREAD(&cd->lock);
+}
+
+PMIX_EXPORT pmix_status_t PMIx_tool_get_servers(pmix_proc_t **servers, size_t *nservers)
+{
+    tool_fanout_t *cd;
+    pmix_status_t rc;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (NULL == servers || NULL == nservers) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    *servers = NULL;
+    *nservers = 0;
+
+    cd = PMIX_NEW(tool_fanout_t);
+    PMIX_THREADSHIFT(cd, _getservers);
+    PMIX_WAIT_THREAD(&cd->lock);
+    rc = cd->status;
+    if (PMIX_SUCCESS == rc && 0 < cd->npeers) {
+        /* hand the array to the caller */
+        *servers = cd->procs;
+        *nservers = cd->npeers;
+        cd->procs = NULL;
+    }
+    PMIX_RELEASE(cd);
+    return rc;
+}
+
+static void fanout_release(void *cbdata)
+{
+    tool_fanout_t *cd = (tool_fanout_t*)cbdata;
+    PMIX_RELEASE(cd);
+}
+
+static void fanout_complete(tool_fanout_t *cd)
+{
+    pmix_status_t rc;
+
+    if (cd->nresults == cd->npeers) {
+        rc = PMIX_SUCCESS;
+    } else if (0 < cd->nresults) {
+        rc = PMIX_QUERY_PARTIAL_SUCCESS;
+    } else {
+        /* report the first failure */
+        rc = cd->status;
+    }
+    if (NULL != cd->cbfunc) {
+        cd->cbfunc(rc, cd->results, cd->nresults, cd->cbdata, fanout_release, cd);
+        return;
+    }
+    PMIX_RELEASE(cd);
+}
+
+static void fanout_cbfunc(struct pmix_peer_t *pr,
+                          pmix_ptl_hdr_t *hdr,
+                          pmix_buffer_t *buf, void *cbdata)
+{
+    tool_fanout_t *cd = (tool_fanout_t*)cbdata;
+    pmix_peer_t *peer = (pmix_peer_t*)pr;
+    pmix_status_t rc, ret;
+    pmix_info_t *info = NULL, *iptr;
+    pmix_data_array_t *darray;
+    size_t n, idx, ninfo = 0;
+    int cnt;
+
+    /* find the server this reply is from */
+    for (idx=0; idx < cd->npeers; idx++) {
+        if (peer == cd->peers[idx]) {
+            break;
+        }
+    }
+
+    /* a lost connection gives us an empty buffer, which
+     * fails to unpack like any other garbled reply */
+    cnt = 1;
+    PMIX_BFROPS_UNPACK(rc, peer, buf, &ret, &cnt, PMIX_STATUS);
+    if (PMIX_SUCCESS == rc) {
+        rc = ret;
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, peer, buf, &ninfo, &cnt, PMIX_SIZE);
+    }
+    if (PMIX_SUCCESS == rc && 0 < ninfo) {
+        PMIX_INFO_CREATE(info, ninfo);
+        cnt = ninfo;
+        PMIX_BFROPS_UNPACK(rc, peer, buf, info, &cnt, PMIX_INFO);
+    }
+    if (PMIX_SUCCESS != rc || idx == cd->npeers) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                            "pmix:tool query of server %s failed: %s",
+                            (idx < cd->npeers) ? PMIX_NAME_PRINT(&cd->procs[idx]) : "UNKNOWN",
+                            PMIx_Error_string(rc));
+        if (PMIX_SUCCESS == cd->status) {
+            cd->status = (PMIX_SUCCESS == rc) ? PMIX_ERR_NOT_FOUND : rc;
+        }
+        goto done;
+    }
+
+    /* label the results with the server that provided them */
+    PMIX_INFO_CREATE(iptr, ninfo + 1);
+    PMIX_INFO_LOAD(&iptr[0], PMIX_PROCID, &cd->procs[idx], PMIX_PROC);
+    for (n=0; n < ninfo; n++) {
+        PMIX_INFO_XFER(&iptr[n+1], &info[n]);
+    }
+    darray = (pmix_data_array_t*)malloc(sizeof(pmix_data_array_t));
+    darray->type = PMIX_INFO;
+    darray->size = ninfo + 1;
+    darray->array = iptr;
+    PMIX_LOAD_KEY(cd->results[cd->nresults].key, PMIX_QUERY_SERVER_RESULTS);
+    cd->results[cd->nresults].value.type = PMIX_DATA_ARRAY;
+    cd->results[cd->nresults].value.data.darray = darray;
+    ++cd->nresults;
+
+  done:
+    if (NULL != info) {
+        PMIX_INFO_FREE(info, ninfo);
+    }
+    ++cd->nreplies;
+    if (cd->nreplies == cd->npeers) {
+        fanout_complete(cd);
+    }
+}
+
+static void _fanout_query(int sd, short args, void *cbdata)
+{
+    tool_fanout_t *cd = (tool_fanout_t*)cbdata;
+    pmix_buffer_t *msg;
+    pmix_status_t rc;
+    size_t n;
+
+    PMIX_ACQUIRE_OBJECT(cd);
+
+    _collect_servers(cd);
+    if (0 == cd->npeers) {
+        if (PMIX_SUCCESS == cd->status) {
+            cd->status = PMIX_ERR_UNREACH;
+        }
+        fanout_complete(cd);
+        return;
+    }
+    PMIX_INFO_CREATE(cd->results, cd->npeers);
+
+    for (n=0; n < cd->npeers; n++) {
+        /* every server gets its own copy of the request */
+        msg = PMIX_NEW(pmix_buffer_t);
+        PMIX_BFROPS_COPY_PAYLOAD(rc, cd->peers[n], msg, cd->msg);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_PTL_SEND_RECV(rc, cd->peers[n], msg, fanout_cbfunc, (void*)cd);
+        }
+        if (PMIX_SUCCESS != rc) {
+            /* count this server as having failed */
+            PMIX_RELEASE(msg);
+            if (PMIX_SUCCESS == cd->status) {
+                cd->status = rc;
+            }
+            ++cd->nreplies;
+        }
+    }
+    PMIX_RELEASE(cd->msg);
+    cd->msg = NULL;
+    if (cd->nreplies == cd->npeers) {
+        fanout_complete(cd);
+    }
+}
+
+PMIX_EXPORT pmix_status_t PMIx_tool_query_servers_nb(pmix_query_t queries[], size_t nqueries,
+                                                     pmix_info_cbfunc_t cbfunc, void *cbdata)
+{
+    tool_fanout_t *cd;
+    pmix_cmd_t cmd = PMIX_QUERY_CMD;
+    pmix_status_t rc;
+
+    PMIX_ACQUIRE_THREAD(&pmix_global_lock);
+    if (pmix_globals.init_cntr <= 0) {
+        PMIX_RELEASE_THREAD(&pmix_global_lock);
+        return PMIX_ERR_INIT;
+    }
+    PMIX_RELEASE_THREAD(&pmix_global_lock);
+
+    if (0 == nqueries || NULL == queries) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+
+    pmix_output_verbose(2, pmix_globals.debug_output,
+                        "pmix:tool query of all servers");
+
+    /* pack the request once - our servers all speak the
+     * same dialect as the primary one */
+    cd = PMIX_NEW(tool_fanout_t);
+    cd->msg = PMIX_NEW(pmix_buffer_t);
+    PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
+                     cd->msg, &cmd, 1, PMIX_COMMAND);
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
+                         cd->msg, &nqueries, 1, PMIX_SIZE);
+    }
+    if (PMIX_SUCCESS == rc) {
+        PMIX_BFROPS_PACK(rc, pmix_client_globals.myserver,
+                         cd->msg, queries, nqueries, PMIX_QUERY);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(cd);
+        return rc;
+    }
+    cd->cbfunc = cbfunc;
+    cd->cbdata = cbdata;
+    PMIX_THREADSHIFT(cd, _fanout_query);
+    return PMIX_SUCCESS;
+}
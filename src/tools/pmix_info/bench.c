@@ -0,0 +1,420 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * pmix_info --bench: quick in-process measurements of each component
+ * selected on this host, to help choose component priorities.
+ *
+ *   bfrops  pack and unpack throughput of a typical job-info array
+ *   gds     store and fetch latency of a proc's keys
+ *   psec    credential create and validate cost
+ *   ptl     round trip of a blocking send/recv over the transport the
+ *           component uses (unix socket for usock, loopback for tcp)
+ *
+ * Components whose operation cannot be exercised in-process (e.g. a
+ * psec module that validates against a real peer's socket) report the
+ * status they returned instead of a time.
+ */
+
+#include "pmix_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <pmix_common.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/base/base.h"
+#include "src/mca/gds/base/base.h"
+#include "src/mca/psec/base/base.h"
+#include "src/mca/ptl/base/base.h"
+#include "src/runtime/pmix_rte.h"
+#include "src/util/output.h"
+
+#include "support.h"
+
+#define BENCH_NINFO     64
+#define BENCH_NKEYS     256
+#define BENCH_ITERS     1000
+
+static double bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000000.0 + (double)ts.tv_nsec / 1000.0;
+}
+
+static void bench_out(const char *framework, const char *component,
+                      const char *metric, const char *fmt, double value)
+{
+    char *pretty, *plain, *str;
+
+    if (0 > asprintf(&pretty, "%s %s %s", framework, component, metric)) {
+        return;
+    }
+    if (0 > asprintf(&plain, "bench:%s:%s:%s", framework, component, metric)) {
+        free(pretty);
+        return;
+    }
+    if (0 <= asprintf(&str, fmt, value)) {
+        pmix_info_out(pretty, plain, str);
+        free(str);
+    }
+    free(pretty);
+    free(plain);
+}
+
+static void bench_fail(const char *framework, const char *component,
+                       const char *metric, pmix_status_t rc)
+{
+    char *pretty, *plain;
+
+    if (0 > asprintf(&pretty, "%s %s %s", framework, component, metric)) {
+        return;
+    }
+    if (0 <= asprintf(&plain, "bench:%s:%s:%s", framework, component, metric)) {
+        pmix_info_out(pretty, plain, PMIx_Error_string(rc));
+        free(plain);
+    }
+    free(pretty);
+}
+
+static void bench_bfrops(void)
+{
+    pmix_bfrops_base_active_module_t *active;
+    pmix_info_t *info, *out;
+    pmix_buffer_t buf;
+    pmix_byte_object_t bo;
+    char key[PMIX_MAX_KEYLEN+1], blob[64];
+    uint32_t u32;
+    int32_t cnt;
+    size_t n, bytes = 0;
+    double start, tpack, tunpack;
+    pmix_status_t rc = PMIX_SUCCESS;
+    int it;
+
+    /* a mix of the types that dominate job info */
+    memset(blob, 'x', sizeof(blob));
+    bo.bytes = blob;
+    bo.size = sizeof(blob);
+    PMIX_INFO_CREATE(info, BENCH_NINFO);
+    for (n=0; n < BENCH_NINFO; n++) {
+        snprintf(key, sizeof(key), "pmix.bench.%lu", (unsigned long)n);
+        u32 = n;
+        switch (n % 3) {
+            case 0:
+                PMIX_INFO_LOAD(&info[n], key, &u32, PMIX_UINT32);
+                break;
+            case 1:
+                PMIX_INFO_LOAD(&info[n], key, "node0001,node0002,node0003", PMIX_STRING);
+                break;
+            default:
+                PMIX_INFO_LOAD(&info[n], key, &bo, PMIX_BYTE_OBJECT);
+                break;
+        }
+    }
+    PMIX_INFO_CREATE(out, BENCH_NINFO);
+
+    PMIX_LIST_FOREACH(active, &pmix_bfrops_globals.actives, pmix_bfrops_base_active_module_t) {
+        tpack = 0;
+        tunpack = 0;
+        for (it=0; it < BENCH_ITERS; it++) {
+            PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+            buf.type = pmix_bfrops_globals.default_type;
+            start = bench_now();
+            rc = active->module->pack(&buf, info, BENCH_NINFO, PMIX_INFO);
+            tpack += bench_now() - start;
+            if (PMIX_SUCCESS != rc) {
+                PMIX_DESTRUCT(&buf);
+                break;
+            }
+            bytes = buf.bytes_used;
+            cnt = BENCH_NINFO;
+            start = bench_now();
+            rc = active->module->unpack(&buf, out, &cnt, PMIX_INFO);
+            tunpack += bench_now() - start;
+            PMIX_DESTRUCT(&buf);
+            for (n=0; n < (size_t)cnt; n++) {
+                PMIX_INFO_DESTRUCT(&out[n]);
+            }
+            if (PMIX_SUCCESS != rc) {
+                break;
+            }
+        }
+        if (PMIX_SUCCESS != rc) {
+            bench_fail("bfrops", active->module->version, "pack", rc);
+            continue;
+        }
+        bench_out("bfrops", active->module->version, "pack_MBps", "%.1f",
+                  (double)bytes * BENCH_ITERS / tpack);
+        bench_out("bfrops", active->module->version, "unpack_MBps", "%.1f",
+                  (double)bytes * BENCH_ITERS / tunpack);
+    }
+    PMIX_INFO_FREE(info, BENCH_NINFO);
+    PMIX_INFO_FREE(out, BENCH_NINFO);
+}
+
+static void bench_gds(void)
+{
+    pmix_gds_base_active_module_t *active;
+    pmix_proc_t proc;
+    pmix_kval_t *kv;
+    pmix_list_t kvs;
+    char key[PMIX_MAX_KEYLEN+1];
+    double start, tstore, tfetch;
+    pmix_status_t rc;
+    int n;
+
+    PMIX_LIST_FOREACH(active, &pmix_gds_globals.actives, pmix_gds_base_active_module_t) {
+        PMIX_PROC_CONSTRUCT(&proc);
+        snprintf(proc.nspace, sizeof(proc.nspace), "pmix-bench-%s", active->module->name);
+        proc.rank = 0;
+        if (NULL != active->module->add_nspace &&
+            PMIX_SUCCESS != (rc = active->module->add_nspace(proc.nspace, NULL, 0))) {
+            bench_fail("gds", active->module->name, "store", rc);
+            continue;
+        }
+
+        tstore = 0;
+        rc = PMIX_SUCCESS;
+        for (n=0; n < BENCH_NKEYS && PMIX_SUCCESS == rc; n++) {
+            snprintf(key, sizeof(key), "pmix.bench.%d", n);
+            kv = PMIX_NEW(pmix_kval_t);
+            kv->key = strdup(key);
+            PMIX_VALUE_CREATE(kv->value, 1);
+            kv->value->type = PMIX_UINT64;
+            kv->value->data.uint64 = n;
+            start = bench_now();
+            rc = active->module->store(&proc, PMIX_GLOBAL, kv);
+            tstore += bench_now() - start;
+            PMIX_RELEASE(kv);
+        }
+        if (PMIX_SUCCESS != rc) {
+            bench_fail("gds", active->module->name, "store", rc);
+            goto next;
+        }
+        bench_out("gds", active->module->name, "store_us", "%.3f", tstore / BENCH_NKEYS);
+
+        tfetch = 0;
+        for (n=0; n < BENCH_NKEYS && PMIX_SUCCESS == rc; n++) {
+            snprintf(key, sizeof(key), "pmix.bench.%d", n);
+            PMIX_CONSTRUCT(&kvs, pmix_list_t);
+            start = bench_now();
+            rc = active->module->fetch(&proc, PMIX_GLOBAL, true, key, NULL, 0, &kvs);
+            tfetch += bench_now() - start;
+            PMIX_LIST_DESTRUCT(&kvs);
+        }
+        if (PMIX_SUCCESS != rc) {
+            bench_fail("gds", active->module->name, "fetch", rc);
+        } else {
+            bench_out("gds", active->module->name, "fetch_us", "%.3f", tfetch / BENCH_NKEYS);
+        }
+
+      next:
+        if (NULL != active->module->del_nspace) {
+            active->module->del_nspace(proc.nspace);
+        }
+    }
+}
+
+static void bench_psec(void)
+{
+    pmix_psec_base_active_module_t *active;
+    pmix_byte_object_t cred;
+    pmix_info_t *info;
+    size_t ninfo;
+    double start, tcreate, tvalidate;
+    pmix_status_t rc;
+    int it;
+
+    PMIX_LIST_FOREACH(active, &pmix_psec_globals.actives, pmix_psec_base_active_module_t) {
+        if (NULL == active->module->create_cred) {
+            continue;
+        }
+        tcreate = 0;
+        tvalidate = 0;
+        rc = PMIX_SUCCESS;
+        for (it=0; it < BENCH_ITERS && PMIX_SUCCESS == rc; it++) {
+            PMIX_BYTE_OBJECT_CONSTRUCT(&cred);
+            info = NULL;
+            ninfo = 0;
+            start = bench_now();
+            rc = active->module->create_cred(pmix_globals.mypeer, NULL, 0, &info, &ninfo, &cred);
+            tcreate += bench_now() - start;
+            if (NULL != info) {
+                PMIX_INFO_FREE(info, ninfo);
+            }
+            if (PMIX_SUCCESS == rc && NULL != active->module->validate_cred) {
+                info = NULL;
+                ninfo = 0;
+                start = bench_now();
+                rc = active->module->validate_cred(pmix_globals.mypeer, NULL, 0,
+                                                   &info, &ninfo, &cred);
+                tvalidate += bench_now() - start;
+                if (NULL != info) {
+                    PMIX_INFO_FREE(info, ninfo);
+                }
+                if (PMIX_SUCCESS != rc) {
+                    /* creation was measured - only validation failed */
+                    bench_out("psec", active->module->name, "create_us", "%.2f",
+                              tcreate / (it + 1));
+                    bench_fail("psec", active->module->name, "validate", rc);
+                }
+            } else if (PMIX_SUCCESS != rc) {
+                bench_fail("psec", active->module->name, "create", rc);
+            }
+            PMIX_BYTE_OBJECT_DESTRUCT(&cred);
+        }
+        if (PMIX_SUCCESS == rc) {
+            bench_out("psec", active->module->name, "create_us", "%.2f", tcreate / BENCH_ITERS);
+            bench_out("psec", active->module->name, "validate_us", "%.2f", tvalidate / BENCH_ITERS);
+        }
+    }
+}
+
+typedef struct {
+    int sd;
+    size_t size;
+    int iters;
+} bench_echo_t;
+
+static void* echo(void *arg)
+{
+    bench_echo_t *e = (bench_echo_t*)arg;
+    char *msg;
+    int it;
+
+    msg = (char*)malloc(e->size);
+    for (it=0; NULL != msg && it < e->iters; it++) {
+        if (PMIX_SUCCESS != pmix_ptl_base_recv_blocking(e->sd, msg, e->size) ||
+            PMIX_SUCCESS != pmix_ptl_base_send_blocking(e->sd, msg, e->size)) {
+            break;
+        }
+    }
+    free(msg);
+    return NULL;
+}
+
+/* a connected pair of sockets of the given family */
+static int bench_sockets(int family, int sd[2])
+{
+    struct sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+    int lsd;
+
+    if (AF_UNIX == family) {
+        return socketpair(AF_UNIX, SOCK_STREAM, 0, sd);
+    }
+    if (0 > (lsd = socket(AF_INET, SOCK_STREAM, 0))) {
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (0 > bind(lsd, (struct sockaddr*)&addr, sizeof(addr)) ||
+        0 > listen(lsd, 1) ||
+        0 > getsockname(lsd, (struct sockaddr*)&addr, &len) ||
+        0 > (sd[0] = socket(AF_INET, SOCK_STREAM, 0))) {
+        close(lsd);
+        return -1;
+    }
+    if (0 > connect(sd[0], (struct sockaddr*)&addr, sizeof(addr)) ||
+        0 > (sd[1] = accept(lsd, NULL, NULL))) {
+        close(sd[0]);
+        close(lsd);
+        return -1;
+    }
+    close(lsd);
+    return 0;
+}
+
+static void bench_ptl(void)
+{
+    pmix_ptl_base_active_t *active;
+    static const size_t sizes[] = {64, 65536};
+    const char *name;
+    char *msg, metric[64];
+    bench_echo_t e;
+    pthread_t thread;
+    double start, elapsed;
+    pmix_status_t rc;
+    int sd[2], family, it;
+    size_t s;
+
+    PMIX_LIST_FOREACH(active, &pmix_ptl_globals.actives, pmix_ptl_base_active_t) {
+        name = active->component->base.pmix_mca_component_name;
+        if (0 == strcmp(name, "usock")) {
+            family = AF_UNIX;
+        } else if (0 == strcmp(name, "tcp")) {
+            family = AF_INET;
+        } else {
+            continue;
+        }
+        for (s=0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            snprintf(metric, sizeof(metric), "rtt_%lu_us", (unsigned long)sizes[s]);
+            if (0 != bench_sockets(family, sd)) {
+                bench_fail("ptl", name, metric, PMIX_ERR_UNREACH);
+                break;
+            }
+            e.sd = sd[1];
+            e.size = sizes[s];
+            e.iters = BENCH_ITERS;
+            msg = (char*)calloc(1, sizes[s]);
+            pthread_create(&thread, NULL, echo, &e);
+            rc = PMIX_SUCCESS;
+            start = bench_now();
+            for (it=0; it < BENCH_ITERS && PMIX_SUCCESS == rc; it++) {
+                if (PMIX_SUCCESS == (rc = pmix_ptl_base_send_blocking(sd[0], msg, sizes[s]))) {
+                    rc = pmix_ptl_base_recv_blocking(sd[0], msg, sizes[s]);
+                }
+            }
+            elapsed = bench_now() - start;
+            /* closing our end releases the echo thread if we failed */
+            close(sd[0]);
+            pthread_join(thread, NULL);
+            close(sd[1]);
+            free(msg);
+            if (PMIX_SUCCESS != rc) {
+                bench_fail("ptl", name, metric, rc);
+            } else {
+                bench_out("ptl", name, metric, "%.2f", elapsed / BENCH_ITERS);
+            }
+        }
+    }
+}
+
+int pmix_info_do_bench(void)
+{
+    pmix_status_t rc;
+
+    /* bring up the frameworks as a server would, so every
+     * component that could be selected on this host is active */
+    if (PMIX_SUCCESS != (rc = pmix_rte_init(PMIX_PROC_SERVER, NULL, 0, NULL))) {
+        fprintf(stderr, "pmix_info: unable to initialize the PMIx runtime: %s\n",
+                PMIx_Error_string(rc));
+        return 1;
+    }
+    bench_bfrops();
+    bench_gds();
+    bench_psec();
+    bench_ptl();
+    pmix_rte_finalize();
+    return 0;
+}
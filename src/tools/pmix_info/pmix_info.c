@@ -123,6 +123,14 @@ int main(int argc, char *argv[])
         return ret;
     }
 
+    /* the benchmarks bring up the full runtime, whose
+     * finalize also tears down what we set up above */
+    if (pmix_cmd_line_is_taken(pmix_info_cmd_line, "bench")) {
+        ret = pmix_info_do_bench();
+        PMIX_RELEASE(pmix_info_cmd_line);
+        return ret;
+    }
+
     /* setup the mca_types array */
     PMIX_CONSTRUCT(&mca_types, pmix_pointer_array_t);
     pmix_pointer_array_init(&mca_types, 256, INT_MAX, 128);
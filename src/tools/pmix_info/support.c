@@ -157,6 +157,8 @@ int pmix_info_init(int argc, char **argv,
                             "Show only variables from selected components");
     pmix_cmd_line_make_opt3(pmix_info_cmd_line, '\0', NULL, "show-failed", 0,
                             "Show the components that failed to load along with the reason why they failed.");
+    pmix_cmd_line_make_opt3(pmix_info_cmd_line, '\0', NULL, "bench", 0,
+                            "Run quick in-process benchmarks of the bfrops, gds, psec, and ptl components available on this host");
 
     if( PMIX_SUCCESS != pmix_mca_base_open() ) {
         pmix_show_help("help-pinfo.txt", "lib-call-fail", true, "mca_base_open", __FILE__, __LINE__ );
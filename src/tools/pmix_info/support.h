@@ -105,6 +105,8 @@ PMIX_EXPORT void pmix_info_do_hostname(void);
 
 PMIX_EXPORT void pmix_info_do_type(pmix_cmd_line_t *pmix_info_cmd_line);
 
+PMIX_EXPORT int pmix_info_do_bench(void);
+
 PMIX_EXPORT void pmix_info_out(const char *pretty_message, const char *plain_message, const char *value);
 
 PMIX_EXPORT void pmix_info_out_int(const char *pretty_message,
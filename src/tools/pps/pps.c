@@ -15,7 +15,7 @@
  * Copyright (c) 2007-2016 Los Alamos National Security, LLC.  All rights
  *                         reserved.
  * Copyright (c) 2010      Oracle and/or its affiliates.  All rights reserved.
- * Copyright (c) 2014-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2018 Intel, Inc. All rights reserved.
  * Copyright (c) 2015      Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * $COPYRIGHT$
@@ -50,6 +50,8 @@
 #include <sys/wait.h>
 #endif  /* HAVE_SYS_WAIT_H */
 #include <string.h>
+#include <signal.h>
+#include <time.h>
 #ifdef HAVE_DIRENT_H
 #include <dirent.h>
 #endif  /* HAVE_DIRENT_H */
@@ -113,6 +115,9 @@ typedef struct {
     bool nodes;
     char *nspace;
     pid_t pid;
+    bool top;
+    int interval;
+    int lines;
 } pmix_ps_globals_t;
 
 pmix_ps_globals_t pmix_ps_globals = {0};
@@ -148,6 +153,24 @@ pmix_cmd_line_init_t cmd_line_opts[] = {
       &pmix_ps_globals.nodes, PMIX_CMD_LINE_TYPE_BOOL,
       "Display Node Information" },
 
+    { NULL,
+      '\0', NULL, "top",
+      0,
+      &pmix_ps_globals.top, PMIX_CMD_LINE_TYPE_BOOL,
+      "Continuously display the server's operation rates and its busiest clients" },
+
+    { NULL,
+      'd', NULL, "interval",
+      1,
+      &pmix_ps_globals.interval, PMIX_CMD_LINE_TYPE_INT,
+      "Seconds between refreshes in --top mode (default: 2)" },
+
+    { NULL,
+      '\0', NULL, "lines",
+      1,
+      &pmix_ps_globals.lines, PMIX_CMD_LINE_TYPE_INT,
+      "Number of clients and nspaces to list in --top mode (default: 20)" },
+
     /* End of list */
     { NULL,
       '\0', NULL, NULL,
@@ -184,7 +207,9 @@ static void cbfunc(pmix_status_t status,
         PMIX_INFO_CREATE(mq->info, ninfo);
         mq->ninfo = ninfo;
         for (n=0; n < ninfo; n++) {
-            fprintf(stderr, "Transferring %s\n", info[n].key);
+            if (!pmix_ps_globals.top) {
+                fprintf(stderr, "Transferring %s\n", info[n].key);
+            }
             PMIX_INFO_XFER(&mq->info[n], &info[n]);
         }
     }
@@ -237,6 +262,202 @@ static void evhandler_reg_callbk(pmix_status_t status,
     PMIX_WAKEUP_THREAD(&lock->lock);
 }
 
+/* one client (or nspace) in the --top display */
+typedef struct {
+    char name[PMIX_MAX_KEYLEN+1];
+    uint64_t stats[5];              // as returned for PMIX_QUERY_PEER_STATS
+    double rate[4];                 // per-second deltas of the first four
+} top_entry_t;
+
+static volatile bool top_done = false;
+
+static void top_sigint(int sig)
+{
+    top_done = true;
+}
+
+static int top_cmp(const void *a, const void *b)
+{
+    const top_entry_t *x = (const top_entry_t*)a, *y = (const top_entry_t*)b;
+    double rx = x->rate[0] + x->rate[1], ry = y->rate[0] + y->rate[1];
+
+    return (rx < ry) ? 1 : (rx > ry) ? -1 : 0;
+}
+
+static top_entry_t* top_find(top_entry_t *entries, size_t n, size_t hint, const char *name)
+{
+    size_t k;
+
+    /* the server reports clients in the same order each time */
+    if (hint < n && 0 == strcmp(entries[hint].name, name)) {
+        return &entries[hint];
+    }
+    for (k=0; k < n; k++) {
+        if (0 == strcmp(entries[k].name, name)) {
+            return &entries[k];
+        }
+    }
+    return NULL;
+}
+
+static void top_print(const char *title, top_entry_t *entries, size_t n)
+{
+    size_t k;
+
+    printf("\n%-32s %10s %10s %10s %10s %12s\n", title,
+           "MSG/s OUT", "MSG/s IN", "KB/s OUT", "KB/s IN", "QUEUED");
+    for (k=0; k < n && (int)k < pmix_ps_globals.lines; k++) {
+        printf("%-32s %10.1f %10.1f %10.1f %10.1f %12lu\n", entries[k].name,
+               entries[k].rate[0], entries[k].rate[1],
+               entries[k].rate[2] / 1024.0, entries[k].rate[3] / 1024.0,
+               (unsigned long)entries[k].stats[4]);
+    }
+}
+
+/* refresh with a single query for both the server's counters and
+ * its per-client statistics, so watching costs the server one reply */
+static pmix_status_t run_top(void)
+{
+    pmix_query_t *query;
+    myquery_data_t mq;
+    pmix_info_t *ctrs = NULL, *peers = NULL;
+    pmix_data_array_t *darray;
+    top_entry_t *cur = NULL, *prev = NULL, *nsp = NULL, *e;
+    size_t ncur = 0, nprev = 0, nctrs = 0, nnsp, n, k, m;
+    uint64_t *u64, prevctr[32][2];
+    double dt;
+    char *dot, stamp[64];
+    time_t now;
+    pmix_status_t rc;
+
+    if (0 >= pmix_ps_globals.interval) {
+        pmix_ps_globals.interval = 2;
+    }
+    if (0 >= pmix_ps_globals.lines) {
+        pmix_ps_globals.lines = 20;
+    }
+    dt = (double)pmix_ps_globals.interval;
+    memset(prevctr, 0, sizeof(prevctr));
+    signal(SIGINT, top_sigint);
+
+    PMIX_QUERY_CREATE(query, 1);
+    PMIX_ARGV_APPEND(rc, query[0].keys, PMIX_QUERY_COUNTERS);
+    PMIX_ARGV_APPEND(rc, query[0].keys, PMIX_QUERY_PEER_STATS);
+
+    while (!top_done) {
+        PMIX_CONSTRUCT_LOCK(&mq.lock.lock);
+        mq.info = NULL;
+        mq.ninfo = 0;
+        if (PMIX_SUCCESS != (rc = PMIx_Query_info_nb(query, 1, cbfunc, (void*)&mq))) {
+            fprintf(stderr, "PMIx_Query_info failed: %s\n", PMIx_Error_string(rc));
+            PMIX_DESTRUCT_LOCK(&mq.lock.lock);
+            break;
+        }
+        PMIX_WAIT_THREAD(&mq.lock.lock);
+        PMIX_DESTRUCT_LOCK(&mq.lock.lock);
+
+        ctrs = NULL;
+        peers = NULL;
+        nctrs = 0;
+        ncur = 0;
+        for (n=0; n < mq.ninfo; n++) {
+            if (PMIX_DATA_ARRAY != mq.info[n].value.type) {
+                continue;
+            }
+            darray = mq.info[n].value.data.darray;
+            if (PMIX_CHECK_KEY(&mq.info[n], PMIX_QUERY_COUNTERS)) {
+                ctrs = (pmix_info_t*)darray->array;
+                nctrs = darray->size;
+            } else if (PMIX_CHECK_KEY(&mq.info[n], PMIX_QUERY_PEER_STATS)) {
+                peers = (pmix_info_t*)darray->array;
+                ncur = darray->size;
+            }
+        }
+        if (NULL == ctrs && NULL == peers) {
+            fprintf(stderr, "pps: the server does not support --top\n");
+            PMIX_INFO_FREE(mq.info, mq.ninfo);
+            rc = PMIX_ERR_NOT_SUPPORTED;
+            break;
+        }
+
+        /* per-client rates */
+        cur = (top_entry_t*)calloc(ncur + 1, sizeof(top_entry_t));
+        for (n=0; n < ncur; n++) {
+            pmix_strncpy(cur[n].name, peers[n].key, PMIX_MAX_KEYLEN);
+            u64 = (uint64_t*)peers[n].value.data.darray->array;
+            memcpy(cur[n].stats, u64, sizeof(cur[n].stats));
+            if (NULL != (e = top_find(prev, nprev, n, cur[n].name))) {
+                for (k=0; k < 4; k++) {
+                    cur[n].rate[k] = (double)(cur[n].stats[k] - e->stats[k]) / dt;
+                }
+            }
+        }
+        /* and the same summed over each nspace */
+        nsp = (top_entry_t*)calloc(ncur + 1, sizeof(top_entry_t));
+        nnsp = 0;
+        for (n=0; n < ncur; n++) {
+            char name[PMIX_MAX_KEYLEN+1];
+            pmix_strncpy(name, cur[n].name, PMIX_MAX_KEYLEN);
+            if (NULL != (dot = strrchr(name, '.'))) {
+                *dot = '\0';
+            }
+            if (NULL == (e = top_find(nsp, nnsp, nnsp - 1, name))) {
+                e = &nsp[nnsp++];
+                pmix_strncpy(e->name, name, PMIX_MAX_KEYLEN);
+            }
+            for (k=0; k < 5; k++) {
+                e->stats[k] += cur[n].stats[k];
+            }
+            for (k=0; k < 4; k++) {
+                e->rate[k] += cur[n].rate[k];
+            }
+        }
+
+        now = time(NULL);
+        strftime(stamp, sizeof(stamp), "%H:%M:%S", localtime(&now));
+        printf("\033[H\033[2J");
+        printf("pps --top  %s  every %ds  clients: %lu  nspaces: %lu\n\n", stamp,
+               pmix_ps_globals.interval, (unsigned long)ncur, (unsigned long)nnsp);
+        printf("%-24s %14s %10s %12s\n", "OPERATION", "COUNT", "RATE/s", "AVG usec");
+        for (n=0; n < nctrs && n < 32; n++) {
+            u64 = (uint64_t*)ctrs[n].value.data.darray->array;
+            m = ctrs[n].value.data.darray->size;
+            printf("%-24s %14lu %10.1f", ctrs[n].key, (unsigned long)u64[0],
+                   (double)(u64[0] - prevctr[n][0]) / dt);
+            if (2 < m && u64[0] > prevctr[n][0]) {
+                /* timed counter - average over the interval */
+                printf(" %12.1f", (double)(u64[1] - prevctr[n][1]) /
+                       (double)(u64[0] - prevctr[n][0]));
+            }
+            printf("\n");
+            prevctr[n][0] = u64[0];
+            prevctr[n][1] = u64[1];
+        }
+        qsort(nsp, nnsp, sizeof(top_entry_t), top_cmp);
+        top_print("NSPACE", nsp, nnsp);
+        qsort(cur, ncur, sizeof(top_entry_t), top_cmp);
+        top_print("CLIENT", cur, ncur);
+        fflush(stdout);
+        free(nsp);
+
+        /* keep this sample in the server's order for the next delta */
+        for (n=0; n < ncur; n++) {
+            pmix_strncpy(cur[n].name, peers[n].key, PMIX_MAX_KEYLEN);
+            memcpy(cur[n].stats, peers[n].value.data.darray->array, sizeof(cur[n].stats));
+        }
+        free(prev);
+        prev = cur;
+        nprev = ncur;
+        PMIX_INFO_FREE(mq.info, mq.ninfo);
+
+        sleep(pmix_ps_globals.interval);
+    }
+
+    free(prev);
+    PMIX_QUERY_FREE(query, 1);
+    return (PMIX_ERR_NOT_SUPPORTED == rc) ? rc : PMIX_SUCCESS;
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -334,6 +555,11 @@ main(int argc, char *argv[])
     PMIX_WAIT_THREAD(&mylock.lock);
     PMIX_DESTRUCT_LOCK(&mylock.lock);
 
+    if (pmix_ps_globals.top) {
+        rc = run_top();
+        goto done;
+    }
+
     /* if we were given a specific nspace to ask about, then do so */
 
     /* if we were asked to provide the status of the nodes, then do that */
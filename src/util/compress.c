@@ -20,8 +20,26 @@
 #endif
 
 #include "src/include/pmix_globals.h"
+#include "src/threads/mutex.h"
 #include "src/util/compress.h"
 
+/* number of decompressed strings we hold on to - the values that
+ * get compressed (regexes, topologies) are few but large, and are
+ * often fetched repeatedly */
+#define PMIX_UNCOMPRESS_CACHE_SIZE  8
+
+typedef struct {
+    uint8_t *bytes;     // the compressed value
+    size_t len;
+    uint32_t hash;
+    char *string;       // what it decompresses to
+    unsigned long used;
+} pmix_uncompress_entry_t;
+
+static pmix_uncompress_entry_t uncache[PMIX_UNCOMPRESS_CACHE_SIZE];
+static unsigned long uncache_clock = 0;
+static pmix_mutex_t uncache_lock = PMIX_MUTEX_STATIC_INIT;
+
 #if PMIX_HAVE_ZLIB
 bool pmix_util_compress_string(char *instring,
                                uint8_t **outbytes,
@@ -146,3 +164,203 @@ void pmix_util_uncompress_string(char **outstring,
     *outstring = NULL;
 }
 #endif
+
+#if PMIX_HAVE_ZLIB
+bool pmix_util_compress_block(uint8_t *inbytes, size_t size,
+                              uint8_t **outbytes,
+                              size_t *nbytes)
+{
+    z_stream strm;
+    size_t len;
+    uint8_t *tmp;
+    uint64_t inlen;
+
+    *outbytes = NULL;
+    *nbytes = 0;
+
+    memset (&strm, 0, sizeof (strm));
+    /* these blocks are on the critical path of a collective, so
+     * favor speed over ratio */
+    if (Z_OK != deflateInit (&strm, Z_BEST_SPEED)) {
+        return false;
+    }
+    len = deflateBound(&strm, size);
+    if (NULL == (tmp = (uint8_t*)malloc(len + sizeof(uint64_t)))) {
+        deflateEnd (&strm);
+        return false;
+    }
+    strm.next_in = inbytes;
+    strm.avail_in = size;
+    strm.avail_out = len;
+    strm.next_out = tmp + sizeof(uint64_t);
+
+    if (Z_STREAM_END != deflate (&strm, Z_FINISH)) {
+        deflateEnd (&strm);
+        free(tmp);
+        return false;
+    }
+    deflateEnd (&strm);
+
+    len = len - strm.avail_out + sizeof(uint64_t);
+    if (len >= size) {
+        /* not worth it */
+        free(tmp);
+        return false;
+    }
+    /* fold the uncompressed length into the front */
+    inlen = pmix_hton64((uint64_t)size);
+    memcpy(tmp, &inlen, sizeof(uint64_t));
+    *outbytes = tmp;
+    *nbytes = len;
+    pmix_output_verbose(10, pmix_globals.debug_output,
+                        "COMPRESS BLOCK OF LEN %lu OUTPUT SIZE %lu",
+                        (unsigned long)size, (unsigned long)len);
+    return true;
+}
+
+bool pmix_util_uncompress_block(uint8_t **outbytes, size_t *outlen,
+                                uint8_t *inbytes, size_t len)
+{
+    z_stream strm;
+    uint8_t *dest;
+    uint64_t len2;
+    int rc;
+
+    *outbytes = NULL;
+    *outlen = 0;
+
+    if (len < sizeof(uint64_t)) {
+        return false;
+    }
+    memcpy(&len2, inbytes, sizeof(uint64_t));
+    len2 = pmix_ntoh64(len2);
+
+    if (NULL == (dest = (uint8_t*)malloc(len2))) {
+        return false;
+    }
+    memset (&strm, 0, sizeof (strm));
+    if (Z_OK != inflateInit(&strm)) {
+        free(dest);
+        return false;
+    }
+    strm.avail_in = len - sizeof(uint64_t);
+    strm.next_in = inbytes + sizeof(uint64_t);
+    strm.avail_out = len2;
+    strm.next_out = dest;
+
+    rc = inflate (&strm, Z_FINISH);
+    inflateEnd (&strm);
+    if (Z_STREAM_END != rc) {
+        free(dest);
+        return false;
+    }
+    *outbytes = dest;
+    *outlen = len2;
+    return true;
+}
+#else
+bool pmix_util_compress_block(uint8_t *inbytes, size_t size,
+                              uint8_t **outbytes,
+                              size_t *nbytes)
+{
+    return false;  // we did not compress
+}
+
+bool pmix_util_uncompress_block(uint8_t **outbytes, size_t *outlen,
+                                uint8_t *inbytes, size_t len)
+{
+    *outbytes = NULL;
+    *outlen = 0;
+    return false;
+}
+#endif
+
+static uint32_t uncache_hash(const uint8_t *bytes, size_t len)
+{
+    uint32_t h = 2166136261u;
+    size_t n;
+
+    for (n=0; n < len; n++) {
+        h = (h ^ bytes[n]) * 16777619u;
+    }
+    return h;
+}
+
+void pmix_util_uncompress_string_cached(char **outstring,
+                                        uint8_t *inbytes, size_t len)
+{
+    pmix_uncompress_entry_t *e, *victim = NULL;
+    uint32_t h;
+    char *str;
+    int n;
+
+    *outstring = NULL;
+    h = uncache_hash(inbytes, len);
+
+    pmix_mutex_lock(&uncache_lock);
+    for (n=0; n < PMIX_UNCOMPRESS_CACHE_SIZE; n++) {
+        e = &uncache[n];
+        if (NULL != e->string && e->hash == h && e->len == len &&
+            0 == memcmp(e->bytes, inbytes, len)) {
+            e->used = ++uncache_clock;
+            *outstring = strdup(e->string);
+            pmix_mutex_unlock(&uncache_lock);
+            return;
+        }
+        /* evict the least recently used if we need room */
+        if (NULL == victim || e->used < victim->used) {
+            victim = e;
+        }
+    }
+    pmix_mutex_unlock(&uncache_lock);
+
+    pmix_util_uncompress_string(&str, inbytes, len);
+    if (NULL == str) {
+        return;
+    }
+    *outstring = strdup(str);
+    if (NULL == *outstring) {
+        *outstring = str;
+        return;
+    }
+
+    pmix_mutex_lock(&uncache_lock);
+    /* another thread may have filled the entry we picked while
+     * we were decompressing - replacing it only costs a later
+     * decompression */
+    if (NULL != victim->bytes) {
+        free(victim->bytes);
+        free(victim->string);
+        victim->string = NULL;
+    }
+    if (NULL != (victim->bytes = (uint8_t*)malloc(len))) {
+        memcpy(victim->bytes, inbytes, len);
+        victim->len = len;
+        victim->hash = h;
+        victim->string = str;
+        victim->used = ++uncache_clock;
+        str = NULL;
+    }
+    pmix_mutex_unlock(&uncache_lock);
+    if (NULL != str) {
+        free(str);
+    }
+}
+
+void pmix_util_uncompress_cache_finalize(void)
+{
+    int n;
+
+    pmix_mutex_lock(&uncache_lock);
+    for (n=0; n < PMIX_UNCOMPRESS_CACHE_SIZE; n++) {
+        if (NULL != uncache[n].bytes) {
+            free(uncache[n].bytes);
+        }
+        if (NULL != uncache[n].string) {
+            free(uncache[n].string);
+        }
+        memset(&uncache[n], 0, sizeof(pmix_uncompress_entry_t));
+    }
+    uncache_clock = 0;
+    pmix_mutex_unlock(&uncache_lock);
+}
@@ -52,6 +52,35 @@ PMIX_EXPORT bool pmix_util_compress_string(char *instring,
 PMIX_EXPORT void pmix_util_uncompress_string(char **outstring,
                                              uint8_t *inbytes, size_t len);
 
+/**
+ * Decompress a byte object into a string, remembering the result
+ * so that the same compressed value is only inflated once. The
+ * returned string is a copy owned by the caller
+ */
+PMIX_EXPORT void pmix_util_uncompress_string_cached(char **outstring,
+                                                    uint8_t *inbytes, size_t len);
+
+/**
+ * Release the strings held by pmix_util_uncompress_string_cached
+ */
+PMIX_EXPORT void pmix_util_uncompress_cache_finalize(void);
+
+/**
+ * Compress a block of bytes using Zlib. The uncompressed size is
+ * folded into the output in network byte order, so the result can
+ * be decompressed on a host of different endianness. Returns false
+ * if compression isn't available or would not reduce the size.
+ */
+PMIX_EXPORT bool pmix_util_compress_block(uint8_t *inbytes, size_t size,
+                                          uint8_t **outbytes,
+                                          size_t *nbytes);
+
+/**
+ * Decompress a block created by pmix_util_compress_block
+ */
+PMIX_EXPORT bool pmix_util_uncompress_block(uint8_t **outbytes, size_t *outlen,
+                                            uint8_t *inbytes, size_t len);
+
 END_C_DECLS
 
 #endif /* PMIX_COMPRESS_H */
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pmix_common.h"
+#include "src/util/counters.h"
+
+#if PMIX_HAVE_THREAD_LOCAL
+pmix_thread_local pmix_counter_slot_t *pmix_counter_myslot = NULL;
+#else
+pmix_counter_slot_t *pmix_counter_myslot = NULL;
+#endif
+
+static const char *ctr_names[PMIX_CTR_MAX] = {
+    "pmix.ctr.commit",
+    "pmix.ctr.fence",
+    "pmix.ctr.get.local",
+    "pmix.ctr.get.dmodex",
+    "pmix.ctr.notify",
+    "pmix.ctr.iof",
+    "pmix.ctr.connect",
+    "pmix.ctr.msg.sent",
+    "pmix.ctr.msg.recvd",
+    "pmix.ctr.pack",
+    "pmix.ctr.msg.dropped"
+};
+
+/* which counters carry a histogram */
+static const bool ctr_timed[PMIX_CTR_MAX] = {
+    true, true, true, true,
+    false, false, false, false, false, false, false
+};
+
+static pthread_mutex_t slot_lock = PTHREAD_MUTEX_INITIALIZER;
+static pmix_counter_slot_t *slots = NULL;
+/* totals of threads that have exited */
+static pmix_counter_slot_t retired;
+
+static void fold(pmix_counter_slot_t *dst, pmix_counter_slot_t *src)
+{
+    int n, k;
+
+    for (n=0; n < PMIX_CTR_MAX; n++) {
+        dst->ctr[n].count += src->ctr[n].count;
+        dst->ctr[n].sum += src->ctr[n].sum;
+        for (k=0; k < PMIX_COUNTER_HIST_BINS; k++) {
+            dst->ctr[n].hist[k] += src->ctr[n].hist[k];
+        }
+    }
+}
+
+#if PMIX_HAVE_THREAD_LOCAL
+static pthread_once_t slot_once = PTHREAD_ONCE_INIT;
+static pthread_key_t slot_key;
+
+static void slot_detach(void *arg)
+{
+    pmix_counter_slot_t *slot = (pmix_counter_slot_t*)arg, **sp;
+
+    pthread_mutex_lock(&slot_lock);
+    for (sp = &slots; NULL != *sp; sp = &(*sp)->next) {
+        if (*sp == slot) {
+            *sp = slot->next;
+            break;
+        }
+    }
+    fold(&retired, slot);
+    pthread_mutex_unlock(&slot_lock);
+    free(slot);
+}
+
+static void slot_key_create(void)
+{
+    pthread_key_create(&slot_key, slot_detach);
+}
+#endif
+
+pmix_counter_slot_t* pmix_counter_attach(void)
+{
+    pmix_counter_slot_t *slot;
+
+#if PMIX_HAVE_THREAD_LOCAL
+    if (0 != posix_memalign((void**)&slot, 64, sizeof(pmix_counter_slot_t))) {
+        /* count into the shared totals rather than fail */
+        return &retired;
+    }
+    memset(slot, 0, sizeof(pmix_counter_slot_t));
+    pthread_once(&slot_once, slot_key_create);
+    pthread_setspecific(slot_key, slot);
+    pthread_mutex_lock(&slot_lock);
+    slot->next = slots;
+    slots = slot;
+    pthread_mutex_unlock(&slot_lock);
+#else
+    /* all threads share one slot */
+    slot = &retired;
+#endif
+    pmix_counter_myslot = slot;
+    return slot;
+}
+
+pmix_status_t pmix_counters_load(pmix_value_t *val)
+{
+    pmix_counter_slot_t total, *slot;
+    pmix_data_array_t *darray, *vals;
+    pmix_info_t *info;
+    uint64_t *u64;
+    size_t n, nvals;
+
+    memset(&total, 0, sizeof(total));
+    pthread_mutex_lock(&slot_lock);
+    fold(&total, &retired);
+    for (slot = slots; NULL != slot; slot = slot->next) {
+        fold(&total, slot);
+    }
+    pthread_mutex_unlock(&slot_lock);
+
+    PMIX_DATA_ARRAY_CREATE(darray, PMIX_CTR_MAX, PMIX_INFO);
+    if (NULL == darray) {
+        return PMIX_ERR_NOMEM;
+    }
+    PMIX_INFO_CREATE(info, PMIX_CTR_MAX);
+    if (NULL == info) {
+        free(darray);
+        return PMIX_ERR_NOMEM;
+    }
+    darray->array = info;
+    val->type = PMIX_DATA_ARRAY;
+    val->data.darray = darray;
+
+    for (n=0; n < PMIX_CTR_MAX; n++) {
+        nvals = ctr_timed[n] ? 2 + PMIX_COUNTER_HIST_BINS : 2;
+        PMIX_DATA_ARRAY_CREATE(vals, nvals, PMIX_UINT64);
+        if (NULL == vals) {
+            return PMIX_ERR_NOMEM;
+        }
+        if (NULL == (u64 = (uint64_t*)malloc(nvals * sizeof(uint64_t)))) {
+            free(vals);
+            return PMIX_ERR_NOMEM;
+        }
+        u64[0] = total.ctr[n].count;
+        u64[1] = total.ctr[n].sum;
+        if (ctr_timed[n]) {
+            memcpy(&u64[2], total.ctr[n].hist, sizeof(total.ctr[n].hist));
+        }
+        vals->array = u64;
+        PMIX_LOAD_KEY(info[n].key, ctr_names[n]);
+        info[n].value.type = PMIX_DATA_ARRAY;
+        info[n].value.data.darray = vals;
+    }
+    return PMIX_SUCCESS;
+}
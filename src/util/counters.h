@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef PMIX_UTIL_COUNTERS_H
+#define PMIX_UTIL_COUNTERS_H
+
+#include "pmix_config.h"
+
+#ifdef HAVE_STDINT_H
+#include <stdint.h>
+#endif
+#include <time.h>
+
+#include "pmix_common.h"
+#include "src/include/prefetch.h"
+#include "src/threads/thread_usage.h"
+
+BEGIN_C_DECLS
+
+/* Always-on operation counters. Each thread updates its own
+ * cache-aligned slot without atomics, and PMIX_QUERY_COUNTERS
+ * sums the slots of all threads when asked - the totals are
+ * therefore approximate while operations are in flight */
+
+typedef enum {
+    PMIX_CTR_COMMIT,        // timed: PMIx_Commit
+    PMIX_CTR_FENCE,         // timed: PMIx_Fence
+    PMIX_CTR_GET_LOCAL,     // timed: gets answered from local data
+    PMIX_CTR_GET_DMODEX,    // timed: gets that needed a direct modex
+    PMIX_CTR_NOTIFY,        // events delivered to local clients
+    PMIX_CTR_IOF_BYTES,     // IO forwarded by the server - sum is bytes
+    PMIX_CTR_CONNECTIONS,   // connections accepted by the server
+    PMIX_CTR_MSGS_SENT,     // messages sent - sum is bytes
+    PMIX_CTR_MSGS_RECVD,    // messages received - sum is bytes
+    PMIX_CTR_PACK,          // top-level bfrops pack calls - sum is bytes
+    PMIX_CTR_MSGS_DROPPED,  // messages dropped at a full peer queue - sum is bytes
+    PMIX_CTR_MAX
+} pmix_counter_id_t;
+
+typedef struct {
+    uint64_t count;
+    uint64_t sum;
+    uint64_t hist[PMIX_COUNTER_HIST_BINS];
+} pmix_counter_t;
+
+typedef struct pmix_counter_slot_t {
+    pmix_counter_t ctr[PMIX_CTR_MAX];
+    struct pmix_counter_slot_t *next;
+} __pmix_attribute_aligned__(64) pmix_counter_slot_t;
+
+#if PMIX_HAVE_THREAD_LOCAL
+PMIX_EXPORT extern pmix_thread_local pmix_counter_slot_t *pmix_counter_myslot;
+#else
+PMIX_EXPORT extern pmix_counter_slot_t *pmix_counter_myslot;
+#endif
+
+/* attach a slot to the calling thread - do not call directly */
+PMIX_EXPORT pmix_counter_slot_t* pmix_counter_attach(void);
+
+/* fill val with the counters summed across all threads */
+PMIX_EXPORT pmix_status_t pmix_counters_load(pmix_value_t *val);
+
+static inline pmix_counter_slot_t* pmix_counter_slot(void)
+{
+    pmix_counter_slot_t *slot = pmix_counter_myslot;
+
+    if (PMIX_UNLIKELY(NULL == slot)) {
+        slot = pmix_counter_attach();
+    }
+    return slot;
+}
+
+/* monotonic timestamp in nsec for timed counters */
+static inline uint64_t pmix_counter_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static inline void pmix_counter_add(pmix_counter_id_t id, uint64_t val)
+{
+    pmix_counter_t *ctr = &pmix_counter_slot()->ctr[id];
+
+    ++ctr->count;
+    ctr->sum += val;
+}
+
+/* record an operation that began at start (from pmix_counter_now) */
+static inline void pmix_counter_time(pmix_counter_id_t id, uint64_t start)
+{
+    pmix_counter_t *ctr = &pmix_counter_slot()->ctr[id];
+    uint64_t usec = (pmix_counter_now() - start) / 1000;
+    int bin = 0;
+
+    ++ctr->count;
+    ctr->sum += usec;
+    while (bin < PMIX_COUNTER_HIST_BINS - 1 && (((uint64_t)1) << bin) <= usec) {
+        ++bin;
+    }
+    ++ctr->hist[bin];
+}
+
+END_C_DECLS
+
+#endif
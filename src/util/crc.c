@@ -1203,3 +1203,240 @@ unsigned int pmix_uicrc_partial(
 
     return partial_crc;
 }
+
+/*
+ * CRC32C (Castagnoli) support.  The polynomial is the one implemented
+ * by the SSE4.2 crc32 instruction and by the ARMv8 CRC extension, so
+ * where the processor has either we let it do the work.  The choice is
+ * made the first time through - everywhere else falls back to a
+ * slice-by-8 table.
+ */
+
+#define PMIX_CRC32C_POLYNOMIAL ((uint32_t)0x82f63b78)
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PMIX_CRC32C_HW_X86 1
+#include <nmmintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(HAVE_SYS_AUXV_H)
+#define PMIX_CRC32C_HW_ARM 1
+#include <sys/auxv.h>
+#include <arm_acle.h>
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+#endif
+
+typedef uint32_t (*pmix_crc32c_fn_t)(const void *source, void *destination,
+                                     size_t copylen, size_t crclen,
+                                     uint32_t crc);
+
+static uint32_t _pmix_crc32c_table[8][256];
+static pmix_crc32c_fn_t _pmix_crc32c_fn = NULL;
+
+static uint32_t crc32c_sw(const void *source, void *destination,
+                          size_t copylen, size_t crclen, uint32_t crc)
+{
+    const unsigned char *src = (const unsigned char *)source;
+    unsigned char *dst = (unsigned char *)destination;
+    size_t len = (crclen > copylen) ? crclen : copylen;
+    uint64_t w;
+
+    if (NULL == dst) {
+        copylen = 0;
+    }
+    /* bring the source up to a word boundary */
+    while (0 < len && ((uintptr_t)src & 7)) {
+        if (0 < copylen) {
+            *dst++ = *src;
+            copylen--;
+        }
+        crc = _pmix_crc32c_table[0][(crc ^ *src++) & 0xff] ^ (crc >> 8);
+        len--;
+    }
+    while (len >= 8) {
+        memcpy(&w, src, 8);
+        if (copylen >= 8) {
+            memcpy(dst, &w, 8);
+            dst += 8;
+            copylen -= 8;
+        } else if (0 < copylen) {
+            memcpy(dst, &w, copylen);
+            dst += copylen;
+            copylen = 0;
+        }
+#ifdef WORDS_BIGENDIAN
+        w = __builtin_bswap64(w);
+#endif
+        w ^= crc;
+        crc = _pmix_crc32c_table[7][w & 0xff] ^
+              _pmix_crc32c_table[6][(w >> 8) & 0xff] ^
+              _pmix_crc32c_table[5][(w >> 16) & 0xff] ^
+              _pmix_crc32c_table[4][(w >> 24) & 0xff] ^
+              _pmix_crc32c_table[3][(w >> 32) & 0xff] ^
+              _pmix_crc32c_table[2][(w >> 40) & 0xff] ^
+              _pmix_crc32c_table[1][(w >> 48) & 0xff] ^
+              _pmix_crc32c_table[0][w >> 56];
+        src += 8;
+        len -= 8;
+    }
+    while (0 < len--) {
+        if (0 < copylen) {
+            *dst++ = *src;
+            copylen--;
+        }
+        crc = _pmix_crc32c_table[0][(crc ^ *src++) & 0xff] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if defined(PMIX_CRC32C_HW_X86) || defined(PMIX_CRC32C_HW_ARM)
+
+#if defined(PMIX_CRC32C_HW_X86)
+#define PMIX_CRC32C_TARGET __attribute__((target("sse4.2")))
+#if defined(__x86_64__)
+#define PMIX_CRC32C_WORD(c, w) ((uint32_t)_mm_crc32_u64((c), (w)))
+#else
+#define PMIX_CRC32C_WORD(c, w) \
+    _mm_crc32_u32(_mm_crc32_u32((c), (uint32_t)(w)), (uint32_t)((w) >> 32))
+#endif
+#define PMIX_CRC32C_BYTE(c, b) _mm_crc32_u8((c), (b))
+#else
+#define PMIX_CRC32C_TARGET __attribute__((target("+crc")))
+#define PMIX_CRC32C_WORD(c, w) __crc32cd((c), (w))
+#define PMIX_CRC32C_BYTE(c, b) __crc32cb((c), (b))
+#endif
+
+/* same walk as the table version, but a whole word at a time goes
+ * through the instruction - the copy rides along on the same loads */
+static PMIX_CRC32C_TARGET uint32_t
+crc32c_hw(const void *source, void *destination,
+          size_t copylen, size_t crclen, uint32_t crc)
+{
+    const unsigned char *src = (const unsigned char *)source;
+    unsigned char *dst = (unsigned char *)destination;
+    size_t len = (crclen > copylen) ? crclen : copylen;
+    uint64_t w0, w1, w2, w3;
+
+    if (NULL == dst) {
+        copylen = 0;
+    }
+    while (0 < len && ((uintptr_t)src & 7)) {
+        if (0 < copylen) {
+            *dst++ = *src;
+            copylen--;
+        }
+        crc = PMIX_CRC32C_BYTE(crc, *src++);
+        len--;
+    }
+    /* the common case of copying everything we sum is unrolled */
+    while (len >= 32 && copylen >= 32) {
+        memcpy(&w0, src, 8);
+        memcpy(&w1, src + 8, 8);
+        memcpy(&w2, src + 16, 8);
+        memcpy(&w3, src + 24, 8);
+        memcpy(dst, &w0, 8);
+        memcpy(dst + 8, &w1, 8);
+        memcpy(dst + 16, &w2, 8);
+        memcpy(dst + 24, &w3, 8);
+        crc = PMIX_CRC32C_WORD(crc, w0);
+        crc = PMIX_CRC32C_WORD(crc, w1);
+        crc = PMIX_CRC32C_WORD(crc, w2);
+        crc = PMIX_CRC32C_WORD(crc, w3);
+        src += 32;
+        dst += 32;
+        len -= 32;
+        copylen -= 32;
+    }
+    if (0 == copylen) {
+        while (len >= 32) {
+            memcpy(&w0, src, 8);
+            memcpy(&w1, src + 8, 8);
+            memcpy(&w2, src + 16, 8);
+            memcpy(&w3, src + 24, 8);
+            crc = PMIX_CRC32C_WORD(crc, w0);
+            crc = PMIX_CRC32C_WORD(crc, w1);
+            crc = PMIX_CRC32C_WORD(crc, w2);
+            crc = PMIX_CRC32C_WORD(crc, w3);
+            src += 32;
+            len -= 32;
+        }
+    }
+    while (len >= 8) {
+        memcpy(&w0, src, 8);
+        if (copylen >= 8) {
+            memcpy(dst, &w0, 8);
+            dst += 8;
+            copylen -= 8;
+        } else if (0 < copylen) {
+            memcpy(dst, &w0, copylen);
+            dst += copylen;
+            copylen = 0;
+        }
+        crc = PMIX_CRC32C_WORD(crc, w0);
+        src += 8;
+        len -= 8;
+    }
+    while (0 < len--) {
+        if (0 < copylen) {
+            *dst++ = *src;
+            copylen--;
+        }
+        crc = PMIX_CRC32C_BYTE(crc, *src++);
+    }
+    return crc;
+}
+#endif
+
+static void pmix_initialize_crc32c(void)
+{
+    uint32_t crc;
+    int i, j;
+
+    for (i = 0; i < 256; i++) {
+        crc = i;
+        for (j = 0; j < 8; j++) {
+            crc = (crc & 1) ? (crc >> 1) ^ PMIX_CRC32C_POLYNOMIAL : (crc >> 1);
+        }
+        _pmix_crc32c_table[0][i] = crc;
+    }
+    for (i = 0; i < 256; i++) {
+        crc = _pmix_crc32c_table[0][i];
+        for (j = 1; j < 8; j++) {
+            crc = _pmix_crc32c_table[0][crc & 0xff] ^ (crc >> 8);
+            _pmix_crc32c_table[j][i] = crc;
+        }
+    }
+
+#if defined(PMIX_CRC32C_HW_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) {
+        _pmix_crc32c_fn = crc32c_hw;
+        return;
+    }
+#elif defined(PMIX_CRC32C_HW_ARM)
+    if (getauxval(AT_HWCAP) & HWCAP_CRC32) {
+        _pmix_crc32c_fn = crc32c_hw;
+        return;
+    }
+#endif
+    _pmix_crc32c_fn = crc32c_sw;
+}
+
+uint32_t pmix_bcopy_crc32c_partial(const void *source, void *destination,
+                                   size_t copylen, size_t crclen,
+                                   uint32_t partial_crc)
+{
+    if (NULL == _pmix_crc32c_fn) {
+        pmix_initialize_crc32c();
+    }
+    return ~_pmix_crc32c_fn(source, destination, copylen, crclen, ~partial_crc);
+}
+
+uint32_t pmix_crc32c_partial(const void *source, size_t crclen,
+                             uint32_t partial_crc)
+{
+    if (NULL == _pmix_crc32c_fn) {
+        pmix_initialize_crc32c();
+    }
+    return ~_pmix_crc32c_fn(source, NULL, 0, crclen, ~partial_crc);
+}
@@ -24,9 +24,11 @@
 #define _PMIX_CRC_H_
 
 #include <src/include/pmix_config.h>
+#include <pmix_common.h>
 
 
 #include <stddef.h>
+#include <stdint.h>
 
 BEGIN_C_DECLS
 
@@ -167,7 +169,7 @@ pmix_bcopy_uicrc(
     return pmix_bcopy_uicrc_partial(source, destination, copylen, crclen, CRC_INITIAL_REGISTER);
 }
 
-unsigned int
+PMIX_EXPORT unsigned int
 pmix_uicrc_partial(
     const void *  source,
     size_t crclen,
@@ -180,6 +182,45 @@ pmix_uicrc(const void *  source, size_t crclen)
     return pmix_uicrc_partial(source, crclen, CRC_INITIAL_REGISTER);
 }
 
+/*
+ * CRC32C (Castagnoli) - computed with the processor's crc32
+ * instruction when it has one.  Partial results chain directly:
+ * pass the value returned for the previous piece, starting from
+ * PMIX_CRC32C_INITIAL.
+ */
+
+#define PMIX_CRC32C_INITIAL ((uint32_t)0)
+
+PMIX_EXPORT uint32_t
+pmix_bcopy_crc32c_partial(
+    const void *  source,
+    void *  destination,
+    size_t copylen,
+    size_t crclen,
+    uint32_t partial_crc);
+
+static inline uint32_t
+pmix_bcopy_crc32c(
+    const void *  source,
+    void *  destination,
+    size_t copylen,
+    size_t crclen)
+{
+    return pmix_bcopy_crc32c_partial(source, destination, copylen, crclen, PMIX_CRC32C_INITIAL);
+}
+
+PMIX_EXPORT uint32_t
+pmix_crc32c_partial(
+    const void *  source,
+    size_t crclen,
+    uint32_t partial_crc);
+
+static inline uint32_t
+pmix_crc32c(const void *  source, size_t crclen)
+{
+    return pmix_crc32c_partial(source, crclen, PMIX_CRC32C_INITIAL);
+}
+
 END_C_DECLS
 
 #endif
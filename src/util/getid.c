@@ -84,3 +84,30 @@ pmix_status_t pmix_util_getid(int sd, uid_t *uid, gid_t *gid)
 
     return PMIX_SUCCESS;
 }
+
+pmix_status_t pmix_util_getpid(int sd, pid_t *pid)
+{
+#if defined(SO_PEERCRED) && (defined(HAVE_STRUCT_UCRED_UID) || defined(HAVE_STRUCT_UCRED_CR_UID))
+#ifdef HAVE_STRUCT_SOCKPEERCRED_UID
+    struct sockpeercred ucred;
+#else
+    struct ucred ucred;
+#endif
+    socklen_t crlen = sizeof (ucred);
+
+    if (getsockopt(sd, SOL_SOCKET, SO_PEERCRED, &ucred, &crlen) < 0) {
+        pmix_output_verbose(2, pmix_globals.debug_output,
+                            "getpid: getsockopt SO_PEERCRED failed: %s",
+                            strerror (pmix_socket_errno));
+        return PMIX_ERR_NOT_FOUND;
+    }
+#if defined(HAVE_STRUCT_UCRED_UID)
+    *pid = ucred.pid;
+#else
+    *pid = ucred.cr_pid;
+#endif
+    return PMIX_SUCCESS;
+#else
+    return PMIX_ERR_NOT_SUPPORTED;
+#endif
+}
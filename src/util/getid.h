@@ -25,6 +25,9 @@ BEGIN_C_DECLS
 /* lookup the effective uid and gid of a socket */
 PMIX_EXPORT pmix_status_t pmix_util_getid(int sd, uid_t *uid, gid_t *gid);
 
+/* lookup the pid of the process at the other end of a local socket */
+PMIX_EXPORT pmix_status_t pmix_util_getpid(int sd, pid_t *pid);
+
 END_C_DECLS
 
 #endif /* PMIX_PRINTF_H */
@@ -47,21 +47,37 @@ typedef struct {
     /* List of pmix_kval_t structures containing all data
        received from this process */
     pmix_list_t data;
+    /* index of the kvals on the list by key - only created
+     * once the proc holds enough keys to make it worthwhile */
+    pmix_hash_table_t *keyidx;
 } pmix_proc_data_t;
 static void pdcon(pmix_proc_data_t *p)
 {
     PMIX_CONSTRUCT(&p->data, pmix_list_t);
+    p->keyidx = NULL;
 }
 static void pddes(pmix_proc_data_t *p)
 {
+    if (NULL != p->keyidx) {
+        PMIX_RELEASE(p->keyidx);
+    }
     PMIX_LIST_DESTRUCT(&p->data);
 }
 static PMIX_CLASS_INSTANCE(pmix_proc_data_t,
                            pmix_list_item_t,
                            pdcon, pddes);
 
-static pmix_kval_t* lookup_keyval(pmix_list_t *data,
+/* number of keys a proc must hold before its keys get indexed -
+ * most procs only carry a handful of keys, and a short list walk
+ * beats a hash lookup there */
+#define PMIX_HASH_KEYIDX_MIN    8
+
+static pmix_kval_t* lookup_keyval(pmix_proc_data_t *proc_data,
                                   const char *key);
+static void add_keyval(pmix_proc_data_t *proc_data,
+                       pmix_kval_t *kv);
+static void remove_keyval(pmix_proc_data_t *proc_data,
+                          pmix_kval_t *kv);
 static pmix_proc_data_t* lookup_proc(pmix_hash_table_t *jtable,
                                      uint64_t id, bool create);
 
@@ -89,15 +105,15 @@ pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
     }
 
     /* see if we already have this key-value */
-    hv = lookup_keyval(&proc_data->data, kin->key);
+    hv = lookup_keyval(proc_data, kin->key);
     if (NULL != hv) {
         /* yes we do - so remove the current value
          * and replace it */
-        pmix_list_remove_item(&proc_data->data, &hv->super);
+        remove_keyval(proc_data, hv);
         PMIX_RELEASE(hv);
     }
     PMIX_RETAIN(kin);
-    pmix_list_append(&proc_data->data, &kin->super);
+    add_keyval(proc_data, kin);
 
     return PMIX_SUCCESS;
 }
@@ -182,7 +198,7 @@ pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank,
             return PMIX_SUCCESS;
         } else {
             /* find the value from within this proc_data object */
-            hv = lookup_keyval(&proc_data->data, key);
+            hv = lookup_keyval(proc_data, key);
             if (NULL != hv) {
                 /* create the copy */
                 PMIX_BFROPS_COPY(rc, pmix_globals.mypeer,
@@ -211,6 +227,44 @@ pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank,
     return rc;
 }
 
+pmix_status_t pmix_hash_fetch_shared(pmix_hash_table_t *table, pmix_rank_t rank,
+                                     const char *key, pmix_list_t *kvs)
+{
+    pmix_proc_data_t *proc_data;
+    pmix_kval_t *hv, *kv;
+
+    pmix_output_verbose(10, pmix_globals.debug_output,
+                        "HASH:FETCH SHARED rank %d key %s",
+                        rank, (NULL == key) ? "NULL" : key);
+
+    if (PMIX_RANK_UNDEF == rank) {
+        return PMIX_ERR_BAD_PARAM;
+    }
+    proc_data = lookup_proc(table, (uint64_t)rank, false);
+    if (NULL == proc_data) {
+        return PMIX_ERR_PROC_ENTRY_NOT_FOUND;
+    }
+
+    if (NULL != key) {
+        if (NULL == (hv = lookup_keyval(proc_data, key))) {
+            return PMIX_ERR_NOT_FOUND;
+        }
+        if (NULL == (kv = pmix_bfrops_base_kval_share(hv))) {
+            return PMIX_ERR_NOMEM;
+        }
+        pmix_list_append(kvs, &kv->super);
+        return PMIX_SUCCESS;
+    }
+
+    PMIX_LIST_FOREACH(hv, &proc_data->data, pmix_kval_t) {
+        if (NULL == (kv = pmix_bfrops_base_kval_share(hv))) {
+            return PMIX_ERR_NOMEM;
+        }
+        pmix_list_append(kvs, &kv->super);
+    }
+    return PMIX_SUCCESS;
+}
+
 pmix_status_t pmix_hash_fetch_by_key(pmix_hash_table_t *table, const char *key,
                                      pmix_rank_t *rank, pmix_value_t **kvs, void **last)
 {
@@ -250,7 +304,7 @@ pmix_status_t pmix_hash_fetch_by_key(pmix_hash_table_t *table, const char *key,
     }
 
     /* find the value from within this proc_data object */
-    hv = lookup_keyval(&proc_data->data, key_r);
+    hv = lookup_keyval(proc_data, key_r);
     if (hv) {
         /* create the copy */
         PMIX_BFROPS_COPY(rc, pmix_globals.mypeer,
@@ -289,14 +343,9 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
             if (NULL != proc_data) {
                 if (NULL == key) {
                     PMIX_RELEASE(proc_data);
-                } else {
-                    PMIX_LIST_FOREACH(kv, &proc_data->data, pmix_kval_t) {
-                        if (0 == strcmp(key, kv->key)) {
-                            pmix_list_remove_item(&proc_data->data, &kv->super);
-                            PMIX_RELEASE(kv);
-                            break;
-                        }
-                    }
+                } else if (NULL != (kv = lookup_keyval(proc_data, key))) {
+                    remove_keyval(proc_data, kv);
+                    PMIX_RELEASE(kv);
                 }
             }
             rc = pmix_hash_table_get_next_key_uint64(table, &id,
@@ -324,26 +373,98 @@ pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
     }
 
     /* remove this item */
-    PMIX_LIST_FOREACH(kv, &proc_data->data, pmix_kval_t) {
-        if (0 == strcmp(key, kv->key)) {
-            pmix_list_remove_item(&proc_data->data, &kv->super);
-            PMIX_RELEASE(kv);
-            break;
-        }
+    if (NULL != (kv = lookup_keyval(proc_data, key))) {
+        remove_keyval(proc_data, kv);
+        PMIX_RELEASE(kv);
     }
 
     return PMIX_SUCCESS;
 }
 
+/* count a value at its own size plus whatever it points to - nested
+ * arrays are only followed one level, which is enough for an estimate */
+static size_t value_mem_usage(pmix_value_t *val)
+{
+    size_t sz = sizeof(pmix_value_t);
+
+    if (NULL == val) {
+        return 0;
+    }
+    switch (val->type) {
+        case PMIX_STRING:
+            if (NULL != val->data.string) {
+                sz += strlen(val->data.string) + 1;
+            }
+            break;
+        case PMIX_BYTE_OBJECT:
+        case PMIX_COMPRESSED_STRING:
+            sz += val->data.bo.size;
+            break;
+        case PMIX_DATA_ARRAY:
+            if (NULL != val->data.darray) {
+                sz += sizeof(pmix_data_array_t);
+                if (PMIX_INFO == val->data.darray->type) {
+                    sz += val->data.darray->size * sizeof(pmix_info_t);
+                } else {
+                    sz += val->data.darray->size * sizeof(pmix_value_t);
+                }
+            }
+            break;
+        default:
+            break;
+    }
+    return sz;
+}
+
+size_t pmix_hash_mem_usage(pmix_hash_table_t *table)
+{
+    pmix_proc_data_t *proc_data;
+    pmix_kval_t *kv;
+    uint64_t id;
+    char *node;
+    size_t sz;
+    pmix_status_t rc;
+
+    /* each table slot is an element of about four words */
+    sz = table->ht_capacity * 4 * sizeof(void*);
+    rc = pmix_hash_table_get_first_key_uint64(table, &id,
+            (void**)&proc_data, (void**)&node);
+    while (PMIX_SUCCESS == rc) {
+        if (NULL != proc_data) {
+            sz += sizeof(pmix_proc_data_t);
+            if (NULL != proc_data->keyidx) {
+                sz += sizeof(pmix_hash_table_t) +
+                      proc_data->keyidx->ht_capacity * 4 * sizeof(void*);
+            }
+            PMIX_LIST_FOREACH(kv, &proc_data->data, pmix_kval_t) {
+                sz += sizeof(pmix_kval_t) + value_mem_usage(kv->value);
+                if (NULL != kv->key) {
+                    sz += strlen(kv->key) + 1;
+                }
+            }
+        }
+        rc = pmix_hash_table_get_next_key_uint64(table, &id,
+                (void**)&proc_data, node, (void**)&node);
+    }
+    return sz;
+}
+
 /**
- * Find data for a given key in a given pmix_list_t.
+ * Find data for a given key in a given proc_data object.
  */
-static pmix_kval_t* lookup_keyval(pmix_list_t *data,
+static pmix_kval_t* lookup_keyval(pmix_proc_data_t *proc_data,
                                   const char *key)
 {
-    pmix_kval_t *kv;
+    pmix_kval_t *kv = NULL;
 
-    PMIX_LIST_FOREACH(kv, data, pmix_kval_t) {
+    if (NULL != proc_data->keyidx) {
+        if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(proc_data->keyidx, key,
+                                                          strlen(key), (void**)&kv)) {
+            return NULL;
+        }
+        return kv;
+    }
+    PMIX_LIST_FOREACH(kv, &proc_data->data, pmix_kval_t) {
         if (0 == strcmp(key, kv->key)) {
             return kv;
         }
@@ -351,6 +472,48 @@ static pmix_kval_t* lookup_keyval(pmix_list_t *data,
     return NULL;
 }
 
+/**
+ * Append a kval to the proc's data, keeping the key index
+ * in sync. The list preserves the order in which the keys
+ * were stored, so fetching all of them stays a list walk.
+ */
+static void add_keyval(pmix_proc_data_t *proc_data,
+                       pmix_kval_t *kv)
+{
+    pmix_kval_t *kp;
+
+    pmix_list_append(&proc_data->data, &kv->super);
+
+    if (NULL != proc_data->keyidx) {
+        pmix_hash_table_set_value_ptr(proc_data->keyidx, kv->key,
+                                      strlen(kv->key), kv);
+        return;
+    }
+    if (PMIX_HASH_KEYIDX_MIN > pmix_list_get_size(&proc_data->data)) {
+        return;
+    }
+    /* the proc now holds enough keys - index all of them */
+    proc_data->keyidx = PMIX_NEW(pmix_hash_table_t);
+    if (NULL == proc_data->keyidx) {
+        return;
+    }
+    pmix_hash_table_init(proc_data->keyidx, 2 * PMIX_HASH_KEYIDX_MIN);
+    PMIX_LIST_FOREACH(kp, &proc_data->data, pmix_kval_t) {
+        pmix_hash_table_set_value_ptr(proc_data->keyidx, kp->key,
+                                      strlen(kp->key), kp);
+    }
+}
+
+static void remove_keyval(pmix_proc_data_t *proc_data,
+                          pmix_kval_t *kv)
+{
+    pmix_list_remove_item(&proc_data->data, &kv->super);
+    if (NULL != proc_data->keyidx) {
+        pmix_hash_table_remove_value_ptr(proc_data->keyidx, kv->key,
+                                         strlen(kv->key));
+    }
+}
+
 
 /**
  * Find proc_data_t container associated with given
@@ -32,6 +32,13 @@ PMIX_EXPORT pmix_status_t pmix_hash_store(pmix_hash_table_t *table,
 PMIX_EXPORT pmix_status_t pmix_hash_fetch(pmix_hash_table_t *table, pmix_rank_t rank,
                                           const char *key, pmix_value_t **kvs);
 
+/* Append kvals sharing the stored value for a specified key
+ * (or all keys if key is NULL) and rank to the given list instead
+ * of copying them. The rank must be specific. Returns the same
+ * status codes as pmix_hash_fetch */
+PMIX_EXPORT pmix_status_t pmix_hash_fetch_shared(pmix_hash_table_t *table, pmix_rank_t rank,
+                                                 const char *key, pmix_list_t *kvs);
+
 /* Fetch the value for a specified key from within
  * the given hash_table
  * It gets the next portion of data from table, where matching key.
@@ -50,6 +57,10 @@ PMIX_EXPORT pmix_status_t pmix_hash_fetch_by_key(pmix_hash_table_t *table, const
 PMIX_EXPORT pmix_status_t pmix_hash_remove_data(pmix_hash_table_t *table,
                                                 pmix_rank_t rank, const char *key);
 
+/* estimate the bytes held by the given hash_table, including
+ * the keys and values stored in it */
+PMIX_EXPORT size_t pmix_hash_mem_usage(pmix_hash_table_t *table);
+
 END_C_DECLS
 
 #endif /* PMIX_HASH_H */
@@ -26,8 +26,18 @@
 #include "src/util/keyval_parse.h"
 #include "src/util/keyval/keyval_lex.h"
 #include "src/util/output.h"
+#include "src/util/crc.h"
+#include "src/util/printf.h"
 #include <string.h>
 #include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 int pmix_util_keyval_parse_lineno = 0;
 
@@ -43,6 +53,49 @@ static void parse_error(int num);
 static char *env_str = NULL;
 static int envsize = 1024;
 
+/*
+ * Parsed files are cached under the session tmpdir our server gave
+ * us, so the other procs on the node can replay the results instead
+ * of lexing the same (often NFS-hosted) file again. The cache holds
+ * the callbacks a parse made, in order, and is only trusted while the
+ * file's path, size, inode and mtime still match.
+ */
+#define PMIX_KEYVAL_CACHE_MAGIC     0x504b5643
+#define PMIX_KEYVAL_CACHE_VERSION   1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t size;
+    uint64_t ino;
+    int64_t mtime;
+    uint32_t pathlen;   /* includes the NUL */
+    uint32_t nentries;
+    uint64_t bodylen;
+} pmix_keyval_cache_hdr_t;
+
+/* each entry is a type byte followed by the NUL-terminated key
+ * and, unless the type says there is none, the NUL-terminated value */
+#define PMIX_KEYVAL_CACHE_VAL       'v'
+#define PMIX_KEYVAL_CACHE_NOVAL     'n'
+#define PMIX_KEYVAL_CACHE_ENV       'e'
+#define PMIX_KEYVAL_CACHE_ENVNOVAL  'x'
+
+static bool recording = false;
+static bool record_failed = false;
+static char *record_buf = NULL;
+static size_t record_len = 0;
+static size_t record_size = 0;
+static uint32_t record_count = 0;
+
+static int add_to_env_str(char *var, char *val);
+static void emit(char type, const char *key, const char *value);
+static char* cache_filename(const char *filename);
+static bool cache_replay(const char *cachefile, const char *filename,
+                         struct stat *fst);
+static void cache_store(const char *cachefile, const char *filename,
+                        struct stat *fst);
+
 int pmix_util_keyval_parse_init(void)
 {
     return PMIX_SUCCESS;
@@ -65,10 +118,25 @@ pmix_util_keyval_parse(const char *filename,
 {
     int val;
     int ret = PMIX_SUCCESS;;
+    struct stat fst;
+    char *cachefile = NULL;
 
     keyval_filename = filename;
     keyval_callback = callback;
 
+    /* if someone already parsed this version of the file, use that */
+    if (0 == stat(keyval_filename, &fst) &&
+        NULL != (cachefile = cache_filename(keyval_filename))) {
+        if (cache_replay(cachefile, keyval_filename, &fst)) {
+            free(cachefile);
+            return PMIX_SUCCESS;
+        }
+        recording = true;
+        record_failed = false;
+        record_len = 0;
+        record_count = 0;
+    }
+
     /* Open the pmix */
     pmix_util_keyval_yyin = fopen(keyval_filename, "r");
     if (NULL == pmix_util_keyval_yyin) {
@@ -110,10 +178,237 @@ pmix_util_keyval_parse(const char *filename,
     fclose(pmix_util_keyval_yyin);
     pmix_util_keyval_yylex_destroy ();
 
+    /* only files that parsed cleanly are cached - that way any
+     * errors in them continue to be reported */
+    if (recording && !record_failed) {
+        cache_store(cachefile, keyval_filename, &fst);
+    }
+
 cleanup:
+    recording = false;
+    if (NULL != record_buf) {
+        free(record_buf);
+        record_buf = NULL;
+    }
+    record_size = 0;
+    if (NULL != cachefile) {
+        free(cachefile);
+    }
     return ret;
 }
 
+static void record(char type, const char *key, const char *value)
+{
+    size_t klen, vlen, need;
+    char *tmp;
+
+    klen = strlen(key) + 1;
+    vlen = (NULL == value) ? 0 : strlen(value) + 1;
+    need = record_len + 1 + klen + vlen;
+    if (record_size < need) {
+        record_size = (0 == record_size) ? 4096 : record_size;
+        while (record_size < need) {
+            record_size *= 2;
+        }
+        tmp = (char*)realloc(record_buf, record_size);
+        if (NULL == tmp) {
+            record_failed = true;
+            return;
+        }
+        record_buf = tmp;
+    }
+    record_buf[record_len++] = type;
+    memcpy(record_buf + record_len, key, klen);
+    record_len += klen;
+    if (NULL != value) {
+        memcpy(record_buf + record_len, value, vlen);
+        record_len += vlen;
+    }
+    record_count++;
+}
+
+/* hand a parsed entry to its consumer, noting it for the cache */
+static void emit(char type, const char *key, const char *value)
+{
+    if (recording && !record_failed) {
+        record(type, key, value);
+    }
+    switch (type) {
+    case PMIX_KEYVAL_CACHE_VAL:
+    case PMIX_KEYVAL_CACHE_NOVAL:
+        keyval_callback(key, value);
+        break;
+    default:
+        add_to_env_str((char*)key, (char*)value);
+        break;
+    }
+}
+
+static char* cache_filename(const char *filename)
+{
+    char *tdir, *cachefile;
+
+    if (NULL == (tdir = getenv("PMIX_SERVER_TMPDIR"))) {
+        return NULL;
+    }
+    if (0 > asprintf(&cachefile, "%s/pmix-keyval-%lu-%08x", tdir,
+                     (unsigned long)geteuid(),
+                     pmix_uicrc(filename, strlen(filename)))) {
+        return NULL;
+    }
+    return cachefile;
+}
+
+static bool cache_replay(const char *cachefile, const char *filename,
+                         struct stat *fst)
+{
+    int fd;
+    struct stat cst;
+    void *map;
+    pmix_keyval_cache_hdr_t *hdr;
+    char *ptr, *end, type;
+    const char *key, *value;
+    uint32_t n;
+    bool valid = false;
+    int pass;
+
+    if (0 > (fd = open(cachefile, O_RDONLY))) {
+        return false;
+    }
+    /* only trust a cache that we wrote and nobody else can touch */
+    if (0 != fstat(fd, &cst) || !S_ISREG(cst.st_mode) ||
+        cst.st_uid != geteuid() || 0 != (cst.st_mode & (S_IWGRP | S_IWOTH)) ||
+        (size_t)cst.st_size < sizeof(pmix_keyval_cache_hdr_t)) {
+        close(fd);
+        return false;
+    }
+    map = mmap(NULL, cst.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == map) {
+        return false;
+    }
+
+    hdr = (pmix_keyval_cache_hdr_t*)map;
+    ptr = (char*)map + sizeof(pmix_keyval_cache_hdr_t);
+    end = (char*)map + cst.st_size;
+    if (PMIX_KEYVAL_CACHE_MAGIC != hdr->magic ||
+        PMIX_KEYVAL_CACHE_VERSION != hdr->version ||
+        (uint64_t)fst->st_size != hdr->size ||
+        (uint64_t)fst->st_ino != hdr->ino ||
+        (int64_t)fst->st_mtime != hdr->mtime ||
+        strlen(filename) + 1 != hdr->pathlen ||
+        (uint64_t)(end - ptr) != hdr->pathlen + hdr->bodylen ||
+        0 != memcmp(ptr, filename, hdr->pathlen)) {
+        goto done;
+    }
+    ptr += hdr->pathlen;
+
+    /* check the whole body before replaying any of it so a
+     * damaged cache can't leave us with half a file */
+    for (pass=0; pass < 2; pass++) {
+        char *p = ptr;
+        for (n=0; n < hdr->nentries; n++) {
+            if (p >= end) {
+                goto done;
+            }
+            type = *p++;
+            key = p;
+            if (NULL == (p = memchr(p, '\0', end - p))) {
+                goto done;
+            }
+            p++;
+            value = NULL;
+            if (PMIX_KEYVAL_CACHE_VAL == type || PMIX_KEYVAL_CACHE_ENV == type) {
+                value = p;
+                if (p >= end || NULL == (p = memchr(p, '\0', end - p))) {
+                    goto done;
+                }
+                p++;
+            } else if (PMIX_KEYVAL_CACHE_NOVAL != type &&
+                       PMIX_KEYVAL_CACHE_ENVNOVAL != type) {
+                goto done;
+            }
+            if (1 == pass) {
+                emit(type, key, value);
+            }
+        }
+        if (p != end) {
+            goto done;
+        }
+    }
+    valid = true;
+
+  done:
+    munmap(map, cst.st_size);
+    return valid;
+}
+
+static void cache_store(const char *cachefile, const char *filename,
+                        struct stat *fst)
+{
+    pmix_keyval_cache_hdr_t hdr;
+    struct {
+        const void *base;
+        size_t len;
+    } parts[3];
+    const char *ptr;
+    size_t left;
+    ssize_t rc;
+    char *tmpfile;
+    int fd, n;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = PMIX_KEYVAL_CACHE_MAGIC;
+    hdr.version = PMIX_KEYVAL_CACHE_VERSION;
+    hdr.size = fst->st_size;
+    hdr.ino = fst->st_ino;
+    hdr.mtime = fst->st_mtime;
+    hdr.pathlen = strlen(filename) + 1;
+    hdr.nentries = record_count;
+    hdr.bodylen = record_len;
+    parts[0].base = &hdr;
+    parts[0].len = sizeof(hdr);
+    parts[1].base = filename;
+    parts[1].len = hdr.pathlen;
+    parts[2].base = record_buf;
+    parts[2].len = record_len;
+
+    /* write it aside and rename it into place so nobody ever maps
+     * a partial cache */
+    if (0 > asprintf(&tmpfile, "%s.%lu", cachefile, (unsigned long)getpid())) {
+        return;
+    }
+    if (0 > (fd = open(tmpfile, O_WRONLY | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR))) {
+        free(tmpfile);
+        return;
+    }
+    for (n=0; n < 3; n++) {
+        ptr = (const char*)parts[n].base;
+        left = parts[n].len;
+        while (0 < left) {
+            rc = write(fd, ptr, left);
+            if (0 > rc) {
+                if (EINTR == errno) {
+                    continue;
+                }
+                close(fd);
+                goto error;
+            }
+            ptr += rc;
+            left -= rc;
+        }
+    }
+    if (0 != close(fd) || 0 != rename(tmpfile, cachefile)) {
+        goto error;
+    }
+    free(tmpfile);
+    return;
+
+  error:
+    unlink(tmpfile);
+    free(tmpfile);
+}
+
 
 
 static int parse_line(void)
@@ -151,7 +446,7 @@ static int parse_line(void)
     val = pmix_util_keyval_yylex();
     if (PMIX_UTIL_KEYVAL_PARSE_SINGLE_WORD == val ||
         PMIX_UTIL_KEYVAL_PARSE_VALUE == val) {
-        keyval_callback(key_buffer, pmix_util_keyval_yytext);
+        emit(PMIX_KEYVAL_CACHE_VAL, key_buffer, pmix_util_keyval_yytext);
 
         /* Now we need to see the newline */
 
@@ -166,7 +461,7 @@ static int parse_line(void)
 
     else if (PMIX_UTIL_KEYVAL_PARSE_DONE == val ||
              PMIX_UTIL_KEYVAL_PARSE_NEWLINE == val) {
-        keyval_callback(key_buffer, NULL);
+        emit(PMIX_KEYVAL_CACHE_NOVAL, key_buffer, NULL);
         return PMIX_SUCCESS;
     }
 
@@ -178,6 +473,7 @@ static int parse_line(void)
 
 static void parse_error(int num)
 {
+    record_failed = true;
     /* JMS need better error/warning message here */
     pmix_output(0, "keyval parser: error %d reading file %s at line %d:\n  %s\n",
                 num, keyval_filename, pmix_util_keyval_yynewlines, pmix_util_keyval_yytext);
@@ -328,7 +624,7 @@ static int parse_line_new(pmix_keyval_parse_state_t first_val)
                         trim_name (tmp, "\'", "\'");
                         trim_name (tmp, "\"", "\"");
                     }
-                    keyval_callback(key_buffer, tmp);
+                    emit(PMIX_KEYVAL_CACHE_VAL, key_buffer, tmp);
                     free(tmp);
                 }
             } else {
@@ -341,7 +637,7 @@ static int parse_line_new(pmix_keyval_parse_state_t first_val)
 
             val = pmix_util_keyval_yylex();
             if (PMIX_UTIL_KEYVAL_PARSE_VALUE == val) {
-                add_to_env_str(key_buffer, pmix_util_keyval_yytext);
+                emit(PMIX_KEYVAL_CACHE_ENV, key_buffer, pmix_util_keyval_yytext);
             } else {
                 parse_error(5);
                 return PMIX_ERROR;
@@ -349,7 +645,7 @@ static int parse_line_new(pmix_keyval_parse_state_t first_val)
         } else if (PMIX_UTIL_KEYVAL_PARSE_ENVVAR == val) {
             trim_name (key_buffer, "-x", "=");
             trim_name (key_buffer, "--x", NULL);
-            add_to_env_str(key_buffer, NULL);
+            emit(PMIX_KEYVAL_CACHE_ENVNOVAL, key_buffer, NULL);
         } else {
             /* we got something unexpected.  Bonk! */
             parse_error(6);
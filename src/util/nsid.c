@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pmix_common.h"
+#include "src/class/pmix_hash_table.h"
+#include "src/util/nsid.h"
+
+/* IDs are looked up from any thread, and interned far less often */
+static pthread_rwlock_t nsid_lock = PTHREAD_RWLOCK_INITIALIZER;
+static bool nsid_inited = false;
+static pmix_hash_table_t nsids;     // name -> ID
+static char **names = NULL;         // ID -> name, names[0] unused
+static pmix_nsid_t nnames = 0;
+static pmix_nsid_t nalloc = 0;
+
+static pmix_nsid_t lookup(const char *nspace, size_t len)
+{
+    void *val;
+
+    if (!nsid_inited ||
+        PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&nsids, nspace, len, &val)) {
+        return PMIX_NSID_INVALID;
+    }
+    return (pmix_nsid_t)(uintptr_t)val;
+}
+
+pmix_nsid_t pmix_nsid_intern(const char *nspace)
+{
+    size_t len;
+    pmix_nsid_t id;
+    char **tmp;
+
+    if (NULL == nspace) {
+        return PMIX_NSID_INVALID;
+    }
+    len = strnlen(nspace, PMIX_MAX_NSLEN);
+
+    pthread_rwlock_rdlock(&nsid_lock);
+    id = lookup(nspace, len);
+    pthread_rwlock_unlock(&nsid_lock);
+    if (PMIX_NSID_INVALID != id) {
+        return id;
+    }
+
+    pthread_rwlock_wrlock(&nsid_lock);
+    /* someone may have beaten us to it */
+    if (PMIX_NSID_INVALID != (id = lookup(nspace, len))) {
+        goto done;
+    }
+    if (!nsid_inited) {
+        PMIX_CONSTRUCT(&nsids, pmix_hash_table_t);
+        pmix_hash_table_init(&nsids, 32);
+        nsid_inited = true;
+    }
+    if (nnames + 1 >= nalloc) {
+        tmp = (char**)realloc(names, (nalloc + 32) * sizeof(char*));
+        if (NULL == tmp) {
+            goto done;
+        }
+        names = tmp;
+        nalloc += 32;
+    }
+    if (NULL == (names[nnames + 1] = strndup(nspace, len))) {
+        goto done;
+    }
+    id = ++nnames;
+    pmix_hash_table_set_value_ptr(&nsids, nspace, len, (void*)(uintptr_t)id);
+
+  done:
+    pthread_rwlock_unlock(&nsid_lock);
+    return id;
+}
+
+pmix_nsid_t pmix_nsid_find(const char *nspace)
+{
+    pmix_nsid_t id;
+
+    if (NULL == nspace) {
+        return PMIX_NSID_INVALID;
+    }
+    pthread_rwlock_rdlock(&nsid_lock);
+    id = lookup(nspace, strnlen(nspace, PMIX_MAX_NSLEN));
+    pthread_rwlock_unlock(&nsid_lock);
+    return id;
+}
+
+const char* pmix_nsid_name(pmix_nsid_t id)
+{
+    const char *name = NULL;
+
+    pthread_rwlock_rdlock(&nsid_lock);
+    if (PMIX_NSID_INVALID != id && id <= nnames) {
+        name = names[id];
+    }
+    pthread_rwlock_unlock(&nsid_lock);
+    return name;
+}
+
+void pmix_nsid_finalize(void)
+{
+    pmix_nsid_t n;
+
+    pthread_rwlock_wrlock(&nsid_lock);
+    if (nsid_inited) {
+        PMIX_DESTRUCT(&nsids);
+        nsid_inited = false;
+    }
+    for (n=1; n <= nnames; n++) {
+        free(names[n]);
+    }
+    free(names);
+    names = NULL;
+    nnames = 0;
+    nalloc = 0;
+    pthread_rwlock_unlock(&nsid_lock);
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef PMIX_UTIL_NSID_H
+#define PMIX_UTIL_NSID_H
+
+#include "pmix_config.h"
+
+#ifdef HAVE_STDINT_H
+#include <stdint.h>
+#endif
+
+#include "pmix_common.h"
+
+BEGIN_C_DECLS
+
+/* Process-wide interning of nspace names. Each distinct name is
+ * given a small integer ID the first time it is interned, and keeps
+ * it until pmix_nsid_finalize - so internal structures can carry the
+ * ID next to the string and compare or hash the ID instead. IDs are
+ * never reused, and the public pmix_proc_t is unchanged */
+
+typedef uint32_t pmix_nsid_t;
+#define PMIX_NSID_INVALID   0
+
+/* return the ID of the nspace, giving it one if it has none */
+PMIX_EXPORT pmix_nsid_t pmix_nsid_intern(const char *nspace);
+
+/* return the ID of the nspace, or PMIX_NSID_INVALID if it was
+ * never interned */
+PMIX_EXPORT pmix_nsid_t pmix_nsid_find(const char *nspace);
+
+/* return the name given an ID, or NULL */
+PMIX_EXPORT const char* pmix_nsid_name(pmix_nsid_t id);
+
+PMIX_EXPORT void pmix_nsid_finalize(void);
+
+END_C_DECLS
+
+#endif
@@ -95,7 +95,6 @@ static int make_string(char **out, char **no_newline_string, output_desc_t *ldi,
 static int output(int output_id, const char *format, va_list arglist);
 
 
-#define PMIX_OUTPUT_MAX_STREAMS 64
 #if defined(HAVE_SYSLOG)
 #define USE_SYSLOG 1
 #else
@@ -112,6 +111,7 @@ int pmix_output_redirected_syslog_pri = 0;
 static bool initialized = false;
 static int default_stderr_fd = -1;
 static output_desc_t info[PMIX_OUTPUT_MAX_STREAMS];
+PMIX_EXPORT int pmix_output_verbosity[PMIX_OUTPUT_MAX_STREAMS] = {0};
 #if defined(HAVE_SYSLOG)
 static bool syslog_opened = false;
 #endif
@@ -332,7 +332,7 @@ PMIX_EXPORT void pmix_output(int output_id, const char *format, ...)
 /*
  * Send a message to a stream if the verbose level is high enough
  */
- PMIX_EXPORT void pmix_output_verbose(int level, int output_id, const char *format, ...)
+PMIX_EXPORT void pmix_output_verbose_emit(int level, int output_id, const char *format, ...)
 {
     if (output_id >= 0 && output_id < PMIX_OUTPUT_MAX_STREAMS &&
         info[output_id].ldi_verbose_level >= level) {
@@ -364,6 +364,7 @@ void pmix_output_set_verbosity(int output_id, int level)
 {
     if (output_id >= 0 && output_id < PMIX_OUTPUT_MAX_STREAMS) {
         info[output_id].ldi_verbose_level = level;
+        pmix_output_verbosity[output_id] = level;
     }
 }
 
@@ -550,6 +551,7 @@ static int do_open(int output_id, pmix_output_stream_t * lds)
     info[i].ldi_enabled = lds->lds_is_debugging ?
         (bool) PMIX_ENABLE_DEBUG : true;
     info[i].ldi_verbose_level = lds->lds_verbose_level;
+    pmix_output_verbosity[i] = lds->lds_verbose_level;
 
 #if USE_SYSLOG
 #if defined(HAVE_SYSLOG)
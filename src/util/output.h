@@ -414,8 +414,48 @@ PMIX_EXPORT void pmix_output(int output_id, const char *format, ...) __pmix_attr
  *
  * @see pmix_output_set_verbosity()
  */
-PMIX_EXPORT void pmix_output_verbose(int verbose_level, int output_id,
-                                     const char *format, ...) __pmix_attribute_format__(__printf__, 3, 4);
+PMIX_EXPORT void pmix_output_verbose_emit(int verbose_level, int output_id,
+                                          const char *format, ...) __pmix_attribute_format__(__printf__, 3, 4);
+
+/**
+ * Maximum number of streams that can be open at once.
+ */
+#define PMIX_OUTPUT_MAX_STREAMS 64
+
+/**
+ * Current verbosity of each stream, mirrored here so that callers of
+ * pmix_output_verbose() can skip the call - and the marshaling of its
+ * arguments - when the message would be discarded anyway. Use
+ * pmix_output_set_verbosity() to change it.
+ */
+PMIX_EXPORT extern int pmix_output_verbosity[PMIX_OUTPUT_MAX_STREAMS];
+
+/**
+ * Defining PMIX_OUTPUT_MAX_VERBOSITY at build time (e.g., in CPPFLAGS)
+ * removes every pmix_output_verbose() call above that level from the
+ * code.
+ */
+#ifdef PMIX_OUTPUT_MAX_VERBOSITY
+#define PMIX_OUTPUT_LEVEL_BUILT(l) ((l) <= PMIX_OUTPUT_MAX_VERBOSITY)
+#else
+#define PMIX_OUTPUT_LEVEL_BUILT(l) 1
+#endif
+
+/**
+ * Callers use pmix_output_verbose(), which checks the level inline
+ * and only calls pmix_output_verbose_emit() if the message will be
+ * written.
+ */
+#define pmix_output_verbose(verbose_level, output_id, ...)                      \
+    do {                                                                        \
+        const int _pmix_ov_level = (verbose_level);                             \
+        const int _pmix_ov_id = (output_id);                                    \
+        if (PMIX_OUTPUT_LEVEL_BUILT(_pmix_ov_level) &&                          \
+            0 <= _pmix_ov_id && _pmix_ov_id < PMIX_OUTPUT_MAX_STREAMS &&       \
+            pmix_output_verbosity[_pmix_ov_id] >= _pmix_ov_level) {             \
+            pmix_output_verbose_emit(_pmix_ov_level, _pmix_ov_id, __VA_ARGS__); \
+        }                                                                       \
+    } while (0)
 
 /**
 * Same as pmix_output_verbose(), but takes a va_list form of varargs.
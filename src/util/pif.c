@@ -62,6 +62,8 @@
 #include <ctype.h>
 
 #include "src/class/pmix_list.h"
+#include "src/class/pmix_hash_table.h"
+#include "src/class/pmix_pointer_array.h"
 #include "src/util/error.h"
 #include "src/util/pif.h"
 #include "src/util/net.h"
@@ -77,6 +79,184 @@
 #  define MIN(a,b)                ((a) < (b) ? (a) : (b))
 #endif
 
+/* lookup tables over pmix_if_list - they are built once the pif
+ * components have enumerated the interfaces, and the lookups fall
+ * back to walking the list until then. Where several interfaces
+ * match, the table holds the first in list order so the answers
+ * don't change */
+static bool if_indexed = false;
+static pmix_pointer_array_t if_byorder;     // list position -> interface
+static pmix_pointer_array_t if_byindex;     // if_index -> interface
+static pmix_pointer_array_t if_bykindex;    // kernel index -> interface
+static pmix_hash_table_t if_byname;         // name -> position+1
+static pmix_hash_table_t if_bynet;          // ipv4 (network, prefix) -> position+1
+static uint32_t if_prefixes[33];            // distinct ipv4 prefix lengths
+static int if_nprefixes = 0;
+
+typedef struct {
+    uint32_t net;
+    uint32_t plen;
+} pmix_if_netkey_t;
+
+static uint32_t if_plen(pmix_pif_t *intf)
+{
+    /* as in pmix_net_samenetwork, no prefix means the whole address */
+    return (0 == intf->if_mask) ? 32 : intf->if_mask;
+}
+
+void pmix_ifindex_build(void)
+{
+    pmix_pif_t *intf;
+    pmix_if_netkey_t nk;
+    struct sockaddr_in *inaddr;
+    void *pos;
+    int n, k;
+
+    pmix_ifindex_clear();
+
+    PMIX_CONSTRUCT(&if_byorder, pmix_pointer_array_t);
+    pmix_pointer_array_init(&if_byorder, 8, INT_MAX, 8);
+    PMIX_CONSTRUCT(&if_byindex, pmix_pointer_array_t);
+    pmix_pointer_array_init(&if_byindex, 8, INT_MAX, 8);
+    PMIX_CONSTRUCT(&if_bykindex, pmix_pointer_array_t);
+    pmix_pointer_array_init(&if_bykindex, 8, INT_MAX, 8);
+    PMIX_CONSTRUCT(&if_byname, pmix_hash_table_t);
+    pmix_hash_table_init(&if_byname, 32);
+    PMIX_CONSTRUCT(&if_bynet, pmix_hash_table_t);
+    pmix_hash_table_init(&if_bynet, 32);
+    if_nprefixes = 0;
+
+    n = 0;
+    PMIX_LIST_FOREACH(intf, &pmix_if_list, pmix_pif_t) {
+        pmix_pointer_array_set_item(&if_byorder, n, intf);
+        if (0 <= intf->if_index &&
+            NULL == pmix_pointer_array_get_item(&if_byindex, intf->if_index)) {
+            pmix_pointer_array_set_item(&if_byindex, intf->if_index, intf);
+        }
+        if ((uint16_t)-1 != intf->if_kernel_index &&
+            NULL == pmix_pointer_array_get_item(&if_bykindex, intf->if_kernel_index)) {
+            pmix_pointer_array_set_item(&if_bykindex, intf->if_kernel_index, intf);
+        }
+        if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&if_byname, intf->if_name,
+                                                          strlen(intf->if_name), &pos)) {
+            pmix_hash_table_set_value_ptr(&if_byname, intf->if_name, strlen(intf->if_name),
+                                          (void*)(uintptr_t)(n + 1));
+        }
+        if (AF_INET == intf->af_family) {
+            inaddr = (struct sockaddr_in*)&intf->if_addr;
+            memset(&nk, 0, sizeof(nk));
+            nk.plen = if_plen(intf);
+            nk.net = inaddr->sin_addr.s_addr & pmix_net_prefix2netmask(nk.plen);
+            if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&if_bynet, &nk, sizeof(nk), &pos)) {
+                pmix_hash_table_set_value_ptr(&if_bynet, &nk, sizeof(nk),
+                                              (void*)(uintptr_t)(n + 1));
+            }
+            for (k=0; k < if_nprefixes; k++) {
+                if (if_prefixes[k] == nk.plen) {
+                    break;
+                }
+            }
+            if (k == if_nprefixes && if_nprefixes < 33) {
+                if_prefixes[if_nprefixes++] = nk.plen;
+            }
+        }
+        ++n;
+    }
+    if_indexed = true;
+}
+
+void pmix_ifindex_clear(void)
+{
+    if (!if_indexed) {
+        return;
+    }
+    if_indexed = false;
+    PMIX_DESTRUCT(&if_byorder);
+    PMIX_DESTRUCT(&if_byindex);
+    PMIX_DESTRUCT(&if_bykindex);
+    PMIX_DESTRUCT(&if_byname);
+    PMIX_DESTRUCT(&if_bynet);
+    if_nprefixes = 0;
+}
+
+static pmix_pif_t* if_find_name(const char *if_name)
+{
+    pmix_pif_t *intf;
+    void *pos;
+
+    if (if_indexed) {
+        if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&if_byname, if_name,
+                                                          strlen(if_name), &pos)) {
+            return NULL;
+        }
+        return (pmix_pif_t*)pmix_pointer_array_get_item(&if_byorder, (int)((uintptr_t)pos - 1));
+    }
+    PMIX_LIST_FOREACH(intf, &pmix_if_list, pmix_pif_t) {
+        if (0 == strcmp(intf->if_name, if_name)) {
+            return intf;
+        }
+    }
+    return NULL;
+}
+
+/* find the first ipv4 interface on the same network as addr */
+static pmix_pif_t* if_find_net(const struct sockaddr_in *addr)
+{
+    pmix_if_netkey_t nk;
+    void *pos;
+    int k, best = -1;
+
+    memset(&nk, 0, sizeof(nk));
+    for (k=0; k < if_nprefixes; k++) {
+        nk.plen = if_prefixes[k];
+        nk.net = addr->sin_addr.s_addr & pmix_net_prefix2netmask(nk.plen);
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&if_bynet, &nk, sizeof(nk), &pos) &&
+            (0 > best || (int)((uintptr_t)pos - 1) < best)) {
+            best = (int)((uintptr_t)pos - 1);
+        }
+    }
+    if (0 > best) {
+        return NULL;
+    }
+    return (pmix_pif_t*)pmix_pointer_array_get_item(&if_byorder, best);
+}
+
+static pmix_pif_t* if_find_index(int if_index)
+{
+    pmix_pif_t *intf;
+
+    if (if_indexed) {
+        if (0 > if_index) {
+            return NULL;
+        }
+        return (pmix_pif_t*)pmix_pointer_array_get_item(&if_byindex, if_index);
+    }
+    PMIX_LIST_FOREACH(intf, &pmix_if_list, pmix_pif_t) {
+        if (intf->if_index == if_index) {
+            return intf;
+        }
+    }
+    return NULL;
+}
+
+static pmix_pif_t* if_find_kindex(int if_kindex)
+{
+    pmix_pif_t *intf;
+
+    if (if_indexed) {
+        if (0 > if_kindex) {
+            return NULL;
+        }
+        return (pmix_pif_t*)pmix_pointer_array_get_item(&if_bykindex, if_kindex);
+    }
+    PMIX_LIST_FOREACH(intf, &pmix_if_list, pmix_pif_t) {
+        if (intf->if_kernel_index == if_kindex) {
+            return intf;
+        }
+    }
+    return NULL;
+}
+
 /*
  *  Look for interface by name and returns its address
  *  as a dotted decimal formatted string.
@@ -86,15 +266,11 @@ int pmix_ifnametoaddr(const char* if_name, struct sockaddr* addr, int length)
 {
     pmix_pif_t* intf;
 
-    for (intf =  (pmix_pif_t*)pmix_list_get_first(&pmix_if_list);
-        intf != (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-        intf =  (pmix_pif_t*)pmix_list_get_next(intf)) {
-        if (strcmp(intf->if_name, if_name) == 0) {
-            memcpy(addr, &intf->if_addr, length);
-            return PMIX_SUCCESS;
-        }
+    if (NULL == (intf = if_find_name(if_name))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    memcpy(addr, &intf->if_addr, length);
+    return PMIX_SUCCESS;
 }
 
 
@@ -107,14 +283,10 @@ int pmix_ifnametoindex(const char* if_name)
 {
     pmix_pif_t* intf;
 
-    for (intf =  (pmix_pif_t*)pmix_list_get_first(&pmix_if_list);
-        intf != (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-        intf =  (pmix_pif_t*)pmix_list_get_next(intf)) {
-        if (strcmp(intf->if_name, if_name) == 0) {
-            return intf->if_index;
-        }
+    if (NULL == (intf = if_find_name(if_name))) {
+        return -1;
     }
-    return -1;
+    return intf->if_index;
 }
 
 
@@ -127,14 +299,10 @@ int16_t pmix_ifnametokindex(const char* if_name)
 {
     pmix_pif_t* intf;
 
-    for (intf =  (pmix_pif_t*)pmix_list_get_first(&pmix_if_list);
-        intf != (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-        intf =  (pmix_pif_t*)pmix_list_get_next(intf)) {
-        if (strcmp(intf->if_name, if_name) == 0) {
-            return intf->if_kernel_index;
-        }
+    if (NULL == (intf = if_find_name(if_name))) {
+        return -1;
     }
-    return -1;
+    return intf->if_kernel_index;
 }
 
 
@@ -147,14 +315,10 @@ int pmix_ifindextokindex(int if_index)
 {
     pmix_pif_t* intf;
 
-    for (intf =  (pmix_pif_t*)pmix_list_get_first(&pmix_if_list);
-        intf != (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-        intf =  (pmix_pif_t*)pmix_list_get_next(intf)) {
-        if (if_index == intf->if_index) {
-            return intf->if_kernel_index;
-        }
+    if (NULL == (intf = if_find_index(if_index))) {
+        return -1;
     }
-    return -1;
+    return intf->if_kernel_index;
 }
 
 
@@ -251,6 +415,18 @@ int16_t pmix_ifaddrtokindex(const char* if_addr)
     }
 
     for (r = res; r != NULL; r = r->ai_next) {
+        if (if_indexed && AF_INET == r->ai_family) {
+            struct sockaddr_in ipv4;
+            memset(&ipv4, 0, sizeof(struct sockaddr_in));
+            len = (r->ai_addrlen < sizeof(struct sockaddr_in)) ? r->ai_addrlen : sizeof(struct sockaddr_in);
+            memcpy(&ipv4, r->ai_addr, len);
+            if (NULL != (intf = if_find_net(&ipv4))) {
+                if_kernel_index = intf->if_kernel_index;
+                freeaddrinfo (res);
+                return if_kernel_index;
+            }
+            continue;
+        }
         PMIX_LIST_FOREACH(intf, &pmix_if_list, pmix_pif_t) {
             if (AF_INET == r->ai_family && AF_INET == intf->af_family) {
                 struct sockaddr_in ipv4, intv4;
@@ -320,24 +496,20 @@ int pmix_ifbegin(void)
 
 int pmix_ifnext(int if_index)
 {
-    pmix_pif_t *intf;
+    pmix_pif_t *intf, *if_next;
+    pmix_pif_t *if_end = (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
 
-    for (intf =  (pmix_pif_t*)pmix_list_get_first(&pmix_if_list);
-        intf != (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-        intf =  (pmix_pif_t*)pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            do {
-                pmix_pif_t* if_next = (pmix_pif_t*)pmix_list_get_next(intf);
-                pmix_pif_t* if_end =  (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-                if (if_next == if_end) {
-                    return -1;
-                }
-                intf = if_next;
-            } while(intf->if_index == if_index);
-            return intf->if_index;
-        }
+    if (NULL == (intf = if_find_index(if_index))) {
+        return (-1);
     }
-    return (-1);
+    do {
+        if_next = (pmix_pif_t*)pmix_list_get_next(intf);
+        if (if_next == if_end) {
+            return -1;
+        }
+        intf = if_next;
+    } while(intf->if_index == if_index);
+    return intf->if_index;
 }
 
 
@@ -350,15 +522,11 @@ int pmix_ifindextoaddr(int if_index, struct sockaddr* if_addr, unsigned int leng
 {
     pmix_pif_t* intf;
 
-    for (intf =  (pmix_pif_t*)pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-         intf =  (pmix_pif_t*)pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            memcpy(if_addr, &intf->if_addr, MIN(length, sizeof (intf->if_addr)));
-            return PMIX_SUCCESS;
-        }
+    if (NULL == (intf = if_find_index(if_index))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    memcpy(if_addr, &intf->if_addr, MIN(length, sizeof (intf->if_addr)));
+    return PMIX_SUCCESS;
 }
 
 
@@ -370,15 +538,11 @@ int pmix_ifkindextoaddr(int if_kindex, struct sockaddr* if_addr, unsigned int le
 {
     pmix_pif_t* intf;
 
-    for (intf =  (pmix_pif_t*)pmix_list_get_first(&pmix_if_list);
-         intf != (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-         intf =  (pmix_pif_t*)pmix_list_get_next(intf)) {
-        if (intf->if_kernel_index == if_kindex) {
-            memcpy(if_addr, &intf->if_addr, MIN(length, sizeof (intf->if_addr)));
-            return PMIX_SUCCESS;
-        }
+    if (NULL == (intf = if_find_kindex(if_kindex))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    memcpy(if_addr, &intf->if_addr, MIN(length, sizeof (intf->if_addr)));
+    return PMIX_SUCCESS;
 }
 
 
@@ -391,15 +555,11 @@ int pmix_ifindextomask(int if_index, uint32_t* if_mask, int length)
 {
     pmix_pif_t* intf;
 
-    for (intf =  (pmix_pif_t*)pmix_list_get_first(&pmix_if_list);
-        intf != (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-        intf =  (pmix_pif_t*)pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            memcpy(if_mask, &intf->if_mask, length);
-            return PMIX_SUCCESS;
-        }
+    if (NULL == (intf = if_find_index(if_index))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    memcpy(if_mask, &intf->if_mask, length);
+    return PMIX_SUCCESS;
 }
 
 /*
@@ -411,15 +571,11 @@ int pmix_ifindextomac(int if_index, uint8_t mac[6])
 {
     pmix_pif_t* intf;
 
-    for (intf = (pmix_pif_t*)pmix_list_get_first(&pmix_if_list);
-        intf != (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-        intf = (pmix_pif_t*)pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            memcpy(mac, &intf->if_mac, 6);
-            return PMIX_SUCCESS;
-        }
+    if (NULL == (intf = if_find_index(if_index))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    memcpy(mac, &intf->if_mac, 6);
+    return PMIX_SUCCESS;
 }
 
 /*
@@ -431,15 +587,11 @@ int pmix_ifindextomtu(int if_index, int *mtu)
 {
     pmix_pif_t* intf;
 
-    for (intf = (pmix_pif_t*)pmix_list_get_first(&pmix_if_list);
-        intf != (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-        intf = (pmix_pif_t*)pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            *mtu = intf->ifmtu;
-            return PMIX_SUCCESS;
-        }
+    if (NULL == (intf = if_find_index(if_index))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    *mtu = intf->ifmtu;
+    return PMIX_SUCCESS;
 }
 
 /*
@@ -451,15 +603,11 @@ int pmix_ifindextoflags(int if_index, uint32_t* if_flags)
 {
     pmix_pif_t* intf;
 
-    for (intf =  (pmix_pif_t*)pmix_list_get_first(&pmix_if_list);
-        intf != (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-        intf =  (pmix_pif_t*)pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            memcpy(if_flags, &intf->if_flags, sizeof(uint32_t));
-            return PMIX_SUCCESS;
-        }
+    if (NULL == (intf = if_find_index(if_index))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    memcpy(if_flags, &intf->if_flags, sizeof(uint32_t));
+    return PMIX_SUCCESS;
 }
 
 
@@ -473,15 +621,11 @@ int pmix_ifindextoname(int if_index, char* if_name, int length)
 {
     pmix_pif_t *intf;
 
-    for (intf =  (pmix_pif_t*)pmix_list_get_first(&pmix_if_list);
-        intf != (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-        intf =  (pmix_pif_t*)pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            pmix_strncpy(if_name, intf->if_name, length-1);
-            return PMIX_SUCCESS;
-        }
+    if (NULL == (intf = if_find_index(if_index))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    pmix_strncpy(if_name, intf->if_name, length-1);
+    return PMIX_SUCCESS;
 }
 
 
@@ -494,15 +638,11 @@ int pmix_ifkindextoname(int if_kindex, char* if_name, int length)
 {
     pmix_pif_t *intf;
 
-    for (intf =  (pmix_pif_t*)pmix_list_get_first(&pmix_if_list);
-        intf != (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-        intf =  (pmix_pif_t*)pmix_list_get_next(intf)) {
-        if (intf->if_kernel_index == if_kindex) {
-            pmix_strncpy(if_name, intf->if_name, length-1);
-            return PMIX_SUCCESS;
-        }
+    if (NULL == (intf = if_find_kindex(if_kindex))) {
+        return PMIX_ERROR;
     }
-    return PMIX_ERROR;
+    pmix_strncpy(if_name, intf->if_name, length-1);
+    return PMIX_SUCCESS;
 }
 
 
@@ -622,16 +762,10 @@ bool pmix_ifisloopback(int if_index)
 {
     pmix_pif_t* intf;
 
-    for (intf =  (pmix_pif_t*)pmix_list_get_first(&pmix_if_list);
-        intf != (pmix_pif_t*)pmix_list_get_end(&pmix_if_list);
-        intf =  (pmix_pif_t*)pmix_list_get_next(intf)) {
-        if (intf->if_index == if_index) {
-            if ((intf->if_flags & IFF_LOOPBACK) != 0) {
-                return true;
-            }
-        }
+    if (NULL == (intf = if_find_index(if_index))) {
+        return false;
     }
-    return false;
+    return ((intf->if_flags & IFF_LOOPBACK) != 0);
 }
 
 /* Determine if an interface matches any entry in the given list, taking
@@ -817,4 +951,12 @@ void pmix_ifgetaliases(char ***aliases)
     *aliases = NULL;
 }
 
+void pmix_ifindex_build(void)
+{
+}
+
+void pmix_ifindex_clear(void)
+{
+}
+
 #endif /* HAVE_STRUCT_SOCKADDR_IN */
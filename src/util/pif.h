@@ -226,6 +226,15 @@ PMIX_EXPORT int pmix_ifmatches(int kidx, char **nets);
  */
 PMIX_EXPORT void pmix_ifgetaliases(char ***aliases);
 
+/*
+ * Build the tables used to look up interfaces by name, index,
+ * kernel index and ipv4 network, or release them. The pif
+ * framework does this when it opens and closes - until the tables
+ * are built, lookups walk the list of interfaces
+ */
+PMIX_EXPORT void pmix_ifindex_build(void);
+PMIX_EXPORT void pmix_ifindex_clear(void);
+
 END_C_DECLS
 
 #endif
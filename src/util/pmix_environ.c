@@ -35,6 +35,121 @@
 
 #define PMIX_DEFAULT_TMPDIR "/tmp"
 
+/* look up the position of a variable - the index holds the
+ * position plus one so that it never stores a NULL */
+static int env_builder_find(pmix_env_builder_t *bld,
+                            const char *name, size_t len)
+{
+    void *pos;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&bld->index, name, len, &pos)) {
+        return -1;
+    }
+    return (int)((uintptr_t)pos - 1);
+}
+
+static pmix_status_t env_builder_put(pmix_env_builder_t *bld, char *entry,
+                                     size_t len, bool overwrite)
+{
+    int pos;
+    char **tmp;
+
+    if (0 <= (pos = env_builder_find(bld, entry, len))) {
+        if (!overwrite) {
+            free(entry);
+            return PMIX_EXISTS;
+        }
+        free(bld->env[pos]);
+        bld->env[pos] = entry;
+        return PMIX_SUCCESS;
+    }
+
+    if (bld->count == bld->size) {
+        bld->size = (0 == bld->size) ? 16 : 2 * bld->size;
+        tmp = (char**)realloc(bld->env, (bld->size + 1) * sizeof(char*));
+        if (NULL == tmp) {
+            free(entry);
+            return PMIX_ERR_OUT_OF_RESOURCE;
+        }
+        bld->env = tmp;
+    }
+    bld->env[bld->count] = entry;
+    pmix_hash_table_set_value_ptr(&bld->index, entry, len,
+                                  (void*)(uintptr_t)(bld->count + 1));
+    bld->count++;
+    bld->env[bld->count] = NULL;
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_env_builder_init(pmix_env_builder_t *bld, char **env)
+{
+    char *eq;
+    size_t len;
+    int i;
+
+    bld->env = env;
+    bld->count = pmix_argv_count(env);
+    bld->size = bld->count;
+    PMIX_CONSTRUCT(&bld->index, pmix_hash_table_t);
+    pmix_hash_table_init(&bld->index, (0 == bld->count) ? 32 : 2 * bld->count);
+
+    /* like pmix_setenv, the first occurrence of a name is the
+     * one that gets found */
+    for (i=0; i < bld->count; i++) {
+        eq = strchr(env[i], '=');
+        len = (NULL == eq) ? strlen(env[i]) : (size_t)(eq - env[i]);
+        if (0 > env_builder_find(bld, env[i], len)) {
+            pmix_hash_table_set_value_ptr(&bld->index, env[i], len,
+                                          (void*)(uintptr_t)(i + 1));
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+pmix_status_t pmix_env_builder_set(pmix_env_builder_t *bld,
+                                   const char *name, const char *value,
+                                   bool overwrite)
+{
+    char *entry;
+    int rc;
+
+    if (NULL == value) {
+        rc = asprintf(&entry, "%s=", name);
+    } else {
+        rc = asprintf(&entry, "%s=%s", name, value);
+    }
+    if (NULL == entry || 0 > rc) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    return env_builder_put(bld, entry, strlen(name), overwrite);
+}
+
+pmix_status_t pmix_env_builder_set_entry(pmix_env_builder_t *bld,
+                                         const char *entry,
+                                         bool overwrite)
+{
+    char *eq, *copy;
+
+    if (NULL == (eq = strchr(entry, '='))) {
+        return pmix_env_builder_set(bld, entry, NULL, overwrite);
+    }
+    if (NULL == (copy = strdup(entry))) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+    return env_builder_put(bld, copy, eq - entry, overwrite);
+}
+
+char** pmix_env_builder_finish(pmix_env_builder_t *bld)
+{
+    char **env = bld->env;
+
+    PMIX_DESTRUCT(&bld->index);
+    bld->env = NULL;
+    bld->count = 0;
+    bld->size = 0;
+    return env;
+}
+
 /*
  * Merge two environ-like char arrays, ensuring that there are no
  * duplicate entires
@@ -43,7 +158,7 @@ char **pmix_environ_merge(char **minor, char **major)
 {
     int i;
     char **ret = NULL;
-    char *name, *value;
+    pmix_env_builder_t bld;
 
     /* Check for bozo cases */
 
@@ -65,28 +180,17 @@ char **pmix_environ_merge(char **minor, char **major)
         return ret;
     }
 
-    /* Now go through minor and call pmix_setenv(), but with overwrite
+    /* Now go through minor and add each entry, but with overwrite
        as false */
 
+    pmix_env_builder_init(&bld, ret);
     for (i = 0; NULL != minor[i]; ++i) {
-        value = strchr(minor[i], '=');
-        if (NULL == value) {
-            pmix_setenv(minor[i], NULL, false, &ret);
-        } else {
-
-            /* strdup minor[i] in case it's a constat string */
-
-            name = strdup(minor[i]);
-            value = name + (value - minor[i]);
-            *value = '\0';
-            pmix_setenv(name, value + 1, false, &ret);
-            free(name);
-        }
+        pmix_env_builder_set_entry(&bld, minor[i], false);
     }
 
     /* All done */
 
-    return ret;
+    return pmix_env_builder_finish(&bld);
 }
 
 /*
@@ -39,9 +39,59 @@
 #endif
 
 #include <pmix_common.h>
+#include "src/class/pmix_hash_table.h"
 
 BEGIN_C_DECLS
 
+/**
+ * Incrementally built environ-like array.
+ *
+ * pmix_setenv scans the whole array and regrows it for every
+ * variable, which makes building an environment quadratic. A
+ * builder indexes the variable names and grows its array
+ * geometrically, and only produces the final NULL-terminated
+ * array when asked:
+ *
+ * \code
+ *   pmix_env_builder_t bld;
+ *   pmix_env_builder_init(&bld, *env);
+ *   pmix_env_builder_set(&bld, "foo", "bar", true);
+ *   *env = pmix_env_builder_finish(&bld);
+ * \endcode
+ *
+ * The builder takes ownership of the array it is given, which
+ * must not be the real environ.
+ */
+typedef struct {
+    char **env;
+    int count;
+    int size;
+    pmix_hash_table_t index;
+} pmix_env_builder_t;
+
+PMIX_EXPORT pmix_status_t pmix_env_builder_init(pmix_env_builder_t *bld, char **env);
+
+/**
+ * Set a variable in the builder - the return codes are the same
+ * as for pmix_setenv
+ */
+PMIX_EXPORT pmix_status_t pmix_env_builder_set(pmix_env_builder_t *bld,
+                                               const char *name, const char *value,
+                                               bool overwrite) __pmix_attribute_nonnull__(2);
+
+/**
+ * Set a variable given as a "name=value" string
+ */
+PMIX_EXPORT pmix_status_t pmix_env_builder_set_entry(pmix_env_builder_t *bld,
+                                                     const char *entry,
+                                                     bool overwrite) __pmix_attribute_nonnull__(2);
+
+/**
+ * Release the builder, returning the array it built. The array
+ * should later be freed with pmix_argv_free()
+ */
+PMIX_EXPORT char** pmix_env_builder_finish(pmix_env_builder_t *bld);
+
 /**
  * Merge two environ-like arrays into a single, new array, ensuring
  * that there are no duplicate entries.
@@ -27,6 +27,7 @@
 #include <locale.h>
 #include <errno.h>
 
+#include "src/class/pmix_list.h"
 #include "src/mca/pinstalldirs/pinstalldirs.h"
 #include "src/util/show_help.h"
 #include "src/util/show_help_lex.h"
@@ -45,6 +46,58 @@ static const char *dash_line = "------------------------------------------------
 static int output_stream = -1;
 static char **search_dirs = NULL;
 
+/*
+ * Each help file is lexed once, the first time a topic is wanted
+ * from it, and all of its topics are kept so later lookups (often
+ * on error paths) don't have to read the file again
+ */
+typedef struct {
+    pmix_list_item_t super;
+    char *name;
+    char **lines;
+} pmix_show_help_topic_t;
+static void tcon(pmix_show_help_topic_t *p)
+{
+    p->name = NULL;
+    p->lines = NULL;
+}
+static void tdes(pmix_show_help_topic_t *p)
+{
+    if (NULL != p->name) {
+        free(p->name);
+    }
+    if (NULL != p->lines) {
+        pmix_argv_free(p->lines);
+    }
+}
+static PMIX_CLASS_INSTANCE(pmix_show_help_topic_t,
+                           pmix_list_item_t,
+                           tcon, tdes);
+
+typedef struct {
+    pmix_list_item_t super;
+    char *base;
+    pmix_list_t topics;
+} pmix_show_help_file_t;
+static void fcon(pmix_show_help_file_t *p)
+{
+    p->base = NULL;
+    PMIX_CONSTRUCT(&p->topics, pmix_list_t);
+}
+static void fdes(pmix_show_help_file_t *p)
+{
+    if (NULL != p->base) {
+        free(p->base);
+    }
+    PMIX_LIST_DESTRUCT(&p->topics);
+}
+static PMIX_CLASS_INSTANCE(pmix_show_help_file_t,
+                           pmix_list_item_t,
+                           fcon, fdes);
+
+static pmix_list_t help_files;
+static bool help_files_init = false;
+
 /*
  * Local functions
  */
@@ -67,6 +120,9 @@ int pmix_show_help_init(void)
 
     pmix_argv_append_nosize(&search_dirs, pmix_pinstall_dirs.pmixdatadir);
 
+    PMIX_CONSTRUCT(&help_files, pmix_list_t);
+    help_files_init = true;
+
     return PMIX_SUCCESS;
 }
 
@@ -81,6 +137,11 @@ int pmix_show_help_finalize(void)
         search_dirs = NULL;
     };
 
+    if (help_files_init) {
+        PMIX_LIST_DESTRUCT(&help_files);
+        help_files_init = false;
+    }
+
     return PMIX_SUCCESS;
 }
 
@@ -202,41 +263,48 @@ static int open_file(const char *base, const char *topic)
 
 
 /*
- * In the file that has already been opened, find the topic that we're
- * supposed to output
+ * In the file that has already been opened, read every topic along
+ * with the lines that make it up
  */
-static int find_topic(const char *base, const char *topic)
+static int index_topics(pmix_show_help_file_t *hf)
 {
-    int token, ret;
+    int token;
     char *tmp;
-
-    /* Examine every topic */
+    pmix_show_help_topic_t *tp = NULL;
 
     while (1) {
         token = pmix_show_help_yylex();
         switch (token) {
         case PMIX_SHOW_HELP_PARSE_TOPIC:
-            tmp = strdup(pmix_show_help_yytext);
+            tmp = strdup(pmix_show_help_yytext + 1);
             if (NULL == tmp) {
                 return PMIX_ERR_OUT_OF_RESOURCE;
             }
             tmp[strlen(tmp) - 1] = '\0';
-            ret = strcmp(tmp + 1, topic);
-            free(tmp);
-            if (0 == ret) {
-                return PMIX_SUCCESS;
+            tp = PMIX_NEW(pmix_show_help_topic_t);
+            if (NULL == tp) {
+                free(tmp);
+                return PMIX_ERR_OUT_OF_RESOURCE;
             }
+            tp->name = tmp;
+            pmix_list_append(&hf->topics, &tp->super);
             break;
 
         case PMIX_SHOW_HELP_PARSE_MESSAGE:
+            /* lines before the first topic belong to nobody */
+            if (NULL != tp) {
+                /* pmix_argv_append_nosize does strdup(pmix_show_help_yytext) */
+                if (PMIX_SUCCESS != pmix_argv_append_nosize(&tp->lines, pmix_show_help_yytext)) {
+                    return PMIX_ERR_OUT_OF_RESOURCE;
+                }
+            }
             break;
 
         case PMIX_SHOW_HELP_PARSE_DONE:
-            pmix_output(output_stream, "%sSorry!  You were supposed to get help about:\n    %s\nfrom the file:\n    %s\nBut I couldn't find that topic in the file.  Sorry!\n%s", dash_line, topic, base, dash_line);
-            return PMIX_ERR_NOT_FOUND;
-            break;
+            return PMIX_SUCCESS;
 
         default:
+            tp = NULL;
             break;
         }
     }
@@ -246,52 +314,71 @@ static int find_topic(const char *base, const char *topic)
 
 
 /*
- * We have an open file, and we're pointed at the right topic.  So
- * read in all the lines in the topic and make a list of them.
+ * Find the indexed file, lexing it first if we haven't seen it before
  */
-static int read_topic(char ***array)
+static pmix_show_help_file_t* load_file(const char *filename, const char *topic)
 {
-    int token, rc;
+    pmix_show_help_file_t *hf;
+    const char *base = (NULL == filename) ? default_filename : filename;
+    int ret;
 
-    while (1) {
-        token = pmix_show_help_yylex();
-        switch (token) {
-        case PMIX_SHOW_HELP_PARSE_MESSAGE:
-            /* pmix_argv_append_nosize does strdup(pmix_show_help_yytext) */
-            rc = pmix_argv_append_nosize(array, pmix_show_help_yytext);
-            if (rc != PMIX_SUCCESS) {
-                return rc;
+    if (help_files_init) {
+        PMIX_LIST_FOREACH(hf, &help_files, pmix_show_help_file_t) {
+            if (0 == strcmp(hf->base, base)) {
+                return hf;
             }
-            break;
+        }
+    }
 
-        default:
-            return PMIX_SUCCESS;
-            break;
+    if (PMIX_SUCCESS != open_file(filename, topic)) {
+        return NULL;
+    }
+
+    hf = PMIX_NEW(pmix_show_help_file_t);
+    if (NULL != hf) {
+        hf->base = strdup(base);
+        ret = index_topics(hf);
+        if (PMIX_SUCCESS != ret || NULL == hf->base) {
+            PMIX_RELEASE(hf);
+            hf = NULL;
         }
     }
 
-    /* Never get here */
+    fclose(pmix_show_help_yyin);
+    pmix_show_help_yylex_destroy ();
+
+    if (NULL != hf && help_files_init) {
+        pmix_list_append(&help_files, &hf->super);
+    }
+    return hf;
 }
 
 
 static int load_array(char ***array, const char *filename, const char *topic)
 {
+    pmix_show_help_file_t *hf;
+    pmix_show_help_topic_t *tp;
     int ret;
 
-    if (PMIX_SUCCESS != (ret = open_file(filename, topic))) {
-        return ret;
+    if (NULL == (hf = load_file(filename, topic))) {
+        return PMIX_ERR_NOT_FOUND;
     }
 
-    ret = find_topic(filename, topic);
-    if (PMIX_SUCCESS == ret) {
-        ret = read_topic(array);
+    ret = PMIX_ERR_NOT_FOUND;
+    PMIX_LIST_FOREACH(tp, &hf->topics, pmix_show_help_topic_t) {
+        if (0 == strcmp(tp->name, topic)) {
+            *array = pmix_argv_copy(tp->lines);
+            ret = PMIX_SUCCESS;
+            break;
+        }
     }
-
-    fclose(pmix_show_help_yyin);
-    pmix_show_help_yylex_destroy ();
-
     if (PMIX_SUCCESS != ret) {
-        pmix_argv_free(*array);
+        pmix_output(output_stream, "%sSorry!  You were supposed to get help about:\n    %s\nfrom the file:\n    %s\nBut I couldn't find that topic in the file.  Sorry!\n%s", dash_line, topic, hf->base, dash_line);
+    }
+
+    if (!help_files_init) {
+        /* called before init - nowhere to keep it */
+        PMIX_RELEASE(hf);
     }
 
     return ret;
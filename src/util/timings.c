@@ -1,6 +1,6 @@
 /*
  * Copyright (C) 2014      Artem Polyakov <artpol84@gmail.com>
- * Copyright (c) 2014-2016 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2018 Intel, Inc. All rights reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -35,8 +35,11 @@
 
 #if PMIX_ENABLE_TIMING
 
+#include <pthread.h>
+
 #include "src/class/pmix_pointer_array.h"
 #include "src/class/pmix_list.h"
+#include "src/include/pmix_globals.h"
 #include "src/util/output.h"
 #include "src/util/basename.h"
 
@@ -642,4 +645,135 @@ void pmix_timing_release(pmix_timing_t *t)
     PMIX_RELEASE(t->events);
     t->events = NULL;
 }
+
+bool pmix_trace_active = false;
+static char *trace_fname = NULL;
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static pmix_trace_buf_t *trace_bufs = NULL;
+static unsigned long trace_ntids = 0;
+#if PMIX_HAVE_THREAD_LOCAL
+/* a flush releases every buffer, so a thread re-attaches
+ * when it sees that the generation has moved on */
+static int trace_gen = 0;
+static pmix_thread_local pmix_trace_buf_t *trace_mybuf = NULL;
+static pmix_thread_local int trace_mygen = -1;
+#endif
+
+/* call with trace_lock held */
+static pmix_trace_buf_t* trace_attach(void)
+{
+    pmix_trace_buf_t *buf;
+
+    if (NULL == (buf = (pmix_trace_buf_t*)malloc(sizeof(pmix_trace_buf_t)))) {
+        return NULL;
+    }
+    buf->tid = ++trace_ntids;
+    buf->nevents = 0;
+    buf->dropped = 0;
+    buf->next = trace_bufs;
+    trace_bufs = buf;
+    return buf;
+}
+
+void pmix_trace_init(const char *fname)
+{
+    if (NULL == fname || pmix_trace_active) {
+        return;
+    }
+    trace_fname = strdup(fname);
+#if PMIX_HAVE_THREAD_LOCAL
+    ++trace_gen;
+#endif
+    pmix_trace_active = true;
+}
+
+void pmix_trace_record(const char *name, uint64_t start)
+{
+    pmix_trace_buf_t *buf;
+    pmix_trace_event_t *ev;
+    uint64_t now = pmix_counter_now();
+
+#if PMIX_HAVE_THREAD_LOCAL
+    if (trace_mygen != trace_gen) {
+        pthread_mutex_lock(&trace_lock);
+        trace_mybuf = trace_attach();
+        pthread_mutex_unlock(&trace_lock);
+        trace_mygen = trace_gen;
+    }
+    if (NULL == (buf = trace_mybuf)) {
+        return;
+    }
+#else
+    /* all threads share one buffer */
+    pthread_mutex_lock(&trace_lock);
+    if (NULL == (buf = trace_bufs) && NULL == (buf = trace_attach())) {
+        pthread_mutex_unlock(&trace_lock);
+        return;
+    }
+#endif
+    if (PMIX_TRACE_BUFSIZE <= buf->nevents) {
+        ++buf->dropped;
+    } else {
+        ev = &buf->ev[buf->nevents];
+        ev->name = name;
+        ev->start = start;
+        ev->dur = now - start;
+        ++buf->nevents;
+    }
+#if !PMIX_HAVE_THREAD_LOCAL
+    pthread_mutex_unlock(&trace_lock);
+#endif
+}
+
+void pmix_trace_flush(void)
+{
+    pmix_trace_buf_t *buf, *next;
+    char *path = NULL;
+    FILE *fp = NULL;
+    size_t n, dropped = 0;
+    int pid = getpid();
+
+    if (!pmix_trace_active) {
+        return;
+    }
+    pmix_trace_active = false;
+
+    pthread_mutex_lock(&trace_lock);
+    buf = trace_bufs;
+    trace_bufs = NULL;
+    pthread_mutex_unlock(&trace_lock);
+
+    /* one file per process - all use the same monotonic clock,
+     * so the files from a node can be merged into one trace */
+    if (0 <= asprintf(&path, "%s.%d.json", trace_fname, pid)) {
+        fp = fopen(path, "w");
+        free(path);
+    }
+    if (NULL != fp) {
+        fprintf(fp, "{\"traceEvents\":[\n");
+        fprintf(fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+                "\"args\":{\"name\":\"%s:%u\"}}", pid,
+                pmix_globals.myid.nspace, pmix_globals.myid.rank);
+    }
+    for (; NULL != buf; buf = next) {
+        next = buf->next;
+        for (n=0; NULL != fp && n < buf->nevents; n++) {
+            fprintf(fp, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%lu,"
+                    "\"ts\":%.3f,\"dur\":%.3f}", buf->ev[n].name, pid, buf->tid,
+                    (double)buf->ev[n].start / 1000.0,
+                    (double)buf->ev[n].dur / 1000.0);
+        }
+        dropped += buf->dropped;
+        free(buf);
+    }
+    if (NULL != fp) {
+        fprintf(fp, "\n],\"otherData\":{\"dropped\":\"%lu\"}}\n", (unsigned long)dropped);
+        fclose(fp);
+    }
+    free(trace_fname);
+    trace_fname = NULL;
+#if PMIX_HAVE_THREAD_LOCAL
+    ++trace_gen;
+#endif
+}
 #endif
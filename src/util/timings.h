@@ -1,6 +1,6 @@
 /*
  * Copyright (C) 2014      Artem Polyakov <artpol84@gmail.com>
- * Copyright (c) 2014-2017 Intel, Inc. All rights reserved.
+ * Copyright (c) 2014-2018 Intel, Inc. All rights reserved.
  * Copyright (c) 2015      Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * $COPYRIGHT$
@@ -17,6 +17,7 @@
 
 
 #include "src/class/pmix_list.h"
+#include "src/util/counters.h"
 
 #if PMIX_ENABLE_TIMING
 
@@ -386,6 +387,51 @@ PMIX_EXPORT void pmix_timing_release(pmix_timing_t *t);
  */
 #define PMIX_TIMING_RELEASE(t) pmix_timing_release(t)
 
+/*
+ * Event trace. Unlike the PMIX_TIMING_* handlers above, spans are
+ * recorded into a fixed-size buffer owned by the calling thread, so
+ * recording takes no lock and allocates nothing after the first event
+ * on a thread. The buffers are written out at finalize as a Chrome
+ * trace (JSON "traceEvents"), loadable in chrome://tracing or Perfetto.
+ * Tracing is off unless the pmix_trace_output MCA param names a file.
+ */
+
+#define PMIX_TRACE_BUFSIZE 65536
+
+typedef struct {
+    const char *name;       // must be a string literal
+    uint64_t start;         // nsec, pmix_counter_now() clock
+    uint64_t dur;           // nsec
+} pmix_trace_event_t;
+
+typedef struct pmix_trace_buf_t {
+    struct pmix_trace_buf_t *next;
+    unsigned long tid;
+    size_t nevents;
+    size_t dropped;         // events lost to a full buffer
+    pmix_trace_event_t ev[PMIX_TRACE_BUFSIZE];
+} pmix_trace_buf_t;
+
+PMIX_EXPORT extern bool pmix_trace_active;
+
+/* turn tracing on if an output file was requested */
+PMIX_EXPORT void pmix_trace_init(const char *fname);
+
+/* record a span of the calling thread */
+PMIX_EXPORT void pmix_trace_record(const char *name, uint64_t start);
+
+/* write all buffers to the output file and release them */
+PMIX_EXPORT void pmix_trace_flush(void);
+
+#define PMIX_TRACE_START(t) uint64_t t = pmix_counter_now()
+
+#define PMIX_TRACE_SPAN(n, t)           \
+    do {                                \
+        if (pmix_trace_active) {        \
+            pmix_trace_record((n), (t));\
+        }                               \
+    } while(0)
+
 #else
 
 #define PMIX_TIMING_ID(n, r)
@@ -416,6 +462,10 @@ PMIX_EXPORT void pmix_timing_release(pmix_timing_t *t);
 
 #define PMIX_TIMING_RELEASE(t)
 
+#define PMIX_TRACE_START(t)
+
+#define PMIX_TRACE_SPAN(n, t)
+
 #endif
 
 #endif
@@ -13,6 +13,7 @@
  */
 
 #include "cli_stages.h"
+#include "test_emulate.h"
 
 cli_info_t *cli_info = NULL;
 int cli_info_cnt = 0;
@@ -205,6 +206,7 @@ void cli_wait_all(double timeout)
         struct timespec ts;
         int status, i;
         pid_t pid;
+        emu_reap();
         while( 0 < (pid = waitpid(-1, &status, WNOHANG) ) ){
             TEST_VERBOSE(("waitpid = %d", pid));
             for(i=0; i < cli_info_cnt; i++){
@@ -220,7 +222,9 @@ void cli_wait_all(double timeout)
             }
         }
         if( pid < 0 ){
-            if( errno == ECHILD ){
+            if( errno == ECHILD && emu_active() ){
+                /* only virtual peers left - keep waiting on them */
+            } else if( errno == ECHILD ){
                 TEST_VERBOSE(("No more children to wait. Happens on the last cli_wait_all call "
                             "which is used to ensure that all children terminated.\n"));
                 if (pmix_test_verbose) {
@@ -255,7 +259,10 @@ void cli_kill_all(void)
 
         }
         TEST_VERBOSE(("Kill rank %d (pid = %d).", i, cli_info[i].pid));
-        kill(cli_info[i].pid, SIGKILL);
+        /* virtual peers have no process to kill */
+        if (0 < cli_info[i].pid) {
+            kill(cli_info[i].pid, SIGKILL);
+        }
         cli_cleanup(&cli_info[i]);
     }
 }
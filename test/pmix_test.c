@@ -38,6 +38,7 @@
 #include "utils.h"
 #include "test_server.h"
 #include "test_common.h"
+#include "test_emulate.h"
 
 bool spawn_wait = false;
 
@@ -77,8 +78,10 @@ int main(int argc, char **argv)
     TEST_VERBOSE(("Executing test: %s", tmp));
     free(tmp);
 
-    /* verify executable */
-    if( 0 > ( rc = stat(params.binary, &stat_buf) ) ){
+    /* verify executable - not needed if we are emulating the clients */
+    if (0 < params.emulate) {
+        /* nothing to check */
+    } else if( 0 > ( rc = stat(params.binary, &stat_buf) ) ){
         TEST_ERROR(("Cannot stat() executable \"%s\": %d: %s", params.binary, errno, strerror(errno)));
         FREE_TEST_PARAMS(params);
         return 0;
@@ -98,6 +101,10 @@ int main(int argc, char **argv)
     }
 
     cli_init(params.lsize);
+    if (0 < params.emulate && PMIX_SUCCESS != emu_init(params.lsize)) {
+        FREE_TEST_PARAMS(params);
+        return PMIX_ERR_NOMEM;
+    }
 
     int launched = 0;
     /* set namespaces and fork clients */
@@ -136,6 +143,10 @@ int main(int argc, char **argv)
         TEST_ERROR(("Total number of processes doesn't correspond number specified by ns_dist parameter."));
         cli_kill_all();
         test_fail = 1;
+    } else if (0 < params.emulate &&
+               PMIX_SUCCESS != emu_start(params.emulate, params.collect)) {
+        cli_kill_all();
+        test_fail = 1;
     }
 
     /* hang around until the client(s) finalize */
@@ -175,6 +186,7 @@ int main(int argc, char **argv)
     PMIx_Deregister_event_handler(0, op_callbk, NULL);
 
     cli_wait_all(1.0);
+    emu_finalize();
 
     test_fail += server_finalize(&params);
 
@@ -170,6 +170,10 @@ pmix_status_t publish_fn(const pmix_proc_t *proc,
         }
         if (!found) {
             new_info = PMIX_NEW(pmix_test_info_t);
+            if (NULL == new_info) {
+                TEST_ERROR(("Out of memory publishing %s", info[i].key));
+                return PMIX_ERR_NOMEM;
+            }
             strncpy(new_info->data.key, info[i].key, strlen(info[i].key)+1);
             pmix_value_xfer(&new_info->data.value, (pmix_value_t*)&info[i].value);
             new_info->namespace_published = strdup(proc->nspace);
@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2018      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+/*
+ * Micro-benchmark of the client/server hot paths, meant to be run
+ * under simptest:
+ *
+ *     simptest -n <ranks> -e ./simpbench [-k nkeys] [-s bytes]
+ *              [-t nthreads] [-i iters]
+ *
+ * Every rank puts nkeys values of the given size and fences with
+ * PMIX_COLLECT_DATA. We then time:
+ *
+ *   - Get: each of nthreads threads fetches every key of every other
+ *     rank; the latencies are reported as percentiles
+ *   - fence: iters empty fences
+ *   - connect: how long PMIx_Init took on the slowest rank
+ *   - notify: rank 0 generates iters events that all others receive
+ *
+ * Rank 0 prints one JSON object per run so results can be collected
+ * by a script (see simpbench.sh) and compared across builds. The gds
+ * component being measured is whatever PMIX_MCA_gds selects.
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_EVENT (PMIX_EXTERNAL_ERR_BASE - 1)
+
+static pmix_proc_t myproc;
+static uint32_t nprocs;
+static int nkeys = 10;
+static size_t keysize = 64;
+static int nthreads = 1;
+static int iters = 100;
+static volatile int nevents = 0;
+
+typedef struct {
+    pthread_t thread;
+    int index;
+    double *lat;            // usec, one per Get
+    size_t nlat;
+    pmix_status_t status;
+} bench_thread_t;
+
+static double now_usec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000000.0 + (double)ts.tv_nsec / 1000.0;
+}
+
+static int dblcmp(const void *a, const void *b)
+{
+    double x = *(const double*)a, y = *(const double*)b;
+
+    return (x < y) ? -1 : (x > y);
+}
+
+static void *getter(void *arg)
+{
+    bench_thread_t *t = (bench_thread_t*)arg;
+    pmix_proc_t proc;
+    pmix_value_t *val;
+    char key[PMIX_MAX_KEYLEN+1];
+    uint32_t r, n;
+    int k;
+    double start;
+
+    t->status = PMIX_SUCCESS;
+    t->nlat = 0;
+    PMIX_PROC_CONSTRUCT(&proc);
+    (void)strncpy(proc.nspace, myproc.nspace, PMIX_MAX_NSLEN);
+    for (n=1; n < nprocs; n++) {
+        /* stagger the starting peer across threads */
+        r = (myproc.rank + n + t->index) % nprocs;
+        if (r == myproc.rank) {
+            continue;
+        }
+        proc.rank = r;
+        for (k=0; k < nkeys; k++) {
+            snprintf(key, sizeof(key), "bench.%d", k);
+            start = now_usec();
+            if (PMIX_SUCCESS != (t->status = PMIx_Get(&proc, key, NULL, 0, &val))) {
+                return NULL;
+            }
+            t->lat[t->nlat++] = now_usec() - start;
+            PMIX_VALUE_RELEASE(val);
+        }
+    }
+    return NULL;
+}
+
+static void evhandler(size_t evhdlr_registration_id,
+                      pmix_status_t status,
+                      const pmix_proc_t *source,
+                      pmix_info_t info[], size_t ninfo,
+                      pmix_info_t results[], size_t nresults,
+                      pmix_event_notification_cbfunc_fn_t cbfunc,
+                      void *cbdata)
+{
+    __sync_fetch_and_add(&nevents, 1);
+    if (NULL != cbfunc) {
+        cbfunc(PMIX_EVENT_ACTION_COMPLETE, NULL, 0, NULL, NULL, cbdata);
+    }
+}
+
+static void regcbfunc(pmix_status_t status, size_t ref, void *cbdata)
+{
+    volatile int *active = (volatile int*)cbdata;
+
+    *active = (PMIX_SUCCESS == status) ? 0 : -1;
+}
+
+static void opcbfunc(pmix_status_t status, void *cbdata)
+{
+    volatile int *pending = (volatile int*)cbdata;
+
+    __sync_fetch_and_sub(pending, 1);
+}
+
+static pmix_status_t fence(bool collect)
+{
+    pmix_info_t info;
+    pmix_status_t rc;
+    bool flag = collect;
+
+    PMIX_INFO_CONSTRUCT(&info);
+    PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, &flag, PMIX_BOOL);
+    rc = PMIx_Fence(NULL, 0, &info, 1);
+    PMIX_INFO_DESTRUCT(&info);
+    return rc;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc, code = BENCH_EVENT;
+    pmix_value_t value, *val;
+    pmix_proc_t proc;
+    pmix_byte_object_t bo;
+    char key[PMIX_MAX_KEYLEN+1], *gds;
+    bench_thread_t *threads = NULL;
+    double start, tinit, tfence = 0, tnotify = 0, *lat = NULL, init_max = 0;
+    size_t nlat = 0, maxlat;
+    volatile int active, pending;
+    uint64_t u64;
+    int n, k;
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp(argv[n], "-k") && NULL != argv[n+1]) {
+            nkeys = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp(argv[n], "-s") && NULL != argv[n+1]) {
+            keysize = strtoul(argv[++n], NULL, 10);
+        } else if (0 == strcmp(argv[n], "-t") && NULL != argv[n+1]) {
+            nthreads = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp(argv[n], "-i") && NULL != argv[n+1]) {
+            iters = strtol(argv[++n], NULL, 10);
+        }
+    }
+    if (nkeys < 1 || nthreads < 1 || iters < 1) {
+        fprintf(stderr, "simpbench: -k, -t and -i must be positive\n");
+        exit(1);
+    }
+
+    start = now_usec();
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "simpbench: PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(rc);
+    }
+    tinit = now_usec() - start;
+
+    PMIX_PROC_CONSTRUCT(&proc);
+    (void)strncpy(proc.nspace, myproc.nspace, PMIX_MAX_NSLEN);
+    proc.rank = PMIX_RANK_WILDCARD;
+    if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, PMIX_JOB_SIZE, NULL, 0, &val))) {
+        fprintf(stderr, "simpbench: get job size failed: %s\n", PMIx_Error_string(rc));
+        goto done;
+    }
+    nprocs = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+
+    /* publish our data, including how long it took us to connect */
+    bo.size = keysize;
+    bo.bytes = (char*)malloc(keysize + 1);
+    memset(bo.bytes, 'a' + (myproc.rank % 26), keysize);
+    for (k=0; k < nkeys; k++) {
+        snprintf(key, sizeof(key), "bench.%d", k);
+        value.type = PMIX_BYTE_OBJECT;
+        value.data.bo = bo;
+        if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, key, &value))) {
+            goto done;
+        }
+    }
+    free(bo.bytes);
+    u64 = (uint64_t)tinit;
+    value.type = PMIX_UINT64;
+    value.data.uint64 = u64;
+    if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, "bench.init", &value)) ||
+        PMIX_SUCCESS != (rc = PMIx_Commit()) ||
+        PMIX_SUCCESS != (rc = fence(true))) {
+        goto done;
+    }
+
+    /* Get latency */
+    if (1 < nprocs) {
+        maxlat = (size_t)(nprocs - 1) * nkeys;
+        threads = (bench_thread_t*)calloc(nthreads, sizeof(bench_thread_t));
+        lat = (double*)malloc(maxlat * nthreads * sizeof(double));
+        for (n=0; n < nthreads; n++) {
+            threads[n].index = n;
+            threads[n].lat = lat + n * maxlat;
+            pthread_create(&threads[n].thread, NULL, getter, &threads[n]);
+        }
+        for (n=0; n < nthreads; n++) {
+            pthread_join(threads[n].thread, NULL);
+            if (PMIX_SUCCESS != threads[n].status) {
+                rc = threads[n].status;
+            }
+            /* compact the samples */
+            memmove(lat + nlat, threads[n].lat, threads[n].nlat * sizeof(double));
+            nlat += threads[n].nlat;
+        }
+        free(threads);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "simpbench: get failed: %s\n", PMIx_Error_string(rc));
+            goto done;
+        }
+        qsort(lat, nlat, sizeof(double), dblcmp);
+    }
+
+    /* fence throughput */
+    start = now_usec();
+    for (n=0; n < iters; n++) {
+        if (PMIX_SUCCESS != (rc = fence(false))) {
+            goto done;
+        }
+    }
+    tfence = now_usec() - start;
+
+    /* notify fan-out - everyone but rank 0 listens */
+    if (0 != myproc.rank) {
+        active = 1;
+        PMIx_Register_event_handler(&code, 1, NULL, 0, evhandler, regcbfunc, (void*)&active);
+        while (1 == active) {
+            usleep(10);
+        }
+    }
+    if (PMIX_SUCCESS != (rc = fence(false))) {
+        goto done;
+    }
+    start = now_usec();
+    if (0 == myproc.rank) {
+        pending = iters;
+        for (n=0; n < iters; n++) {
+            rc = PMIx_Notify_event(code, &myproc, PMIX_RANGE_NAMESPACE,
+                                   NULL, 0, opcbfunc, (void*)&pending);
+            if (PMIX_SUCCESS != rc) {
+                __sync_fetch_and_sub(&pending, 1);
+            }
+        }
+        while (0 < pending) {
+            usleep(10);
+        }
+    } else {
+        while (nevents < iters) {
+            usleep(10);
+        }
+    }
+    if (PMIX_SUCCESS != (rc = fence(false))) {
+        goto done;
+    }
+    tnotify = now_usec() - start;
+
+    if (0 == myproc.rank) {
+        for (n=0; n < (int)nprocs; n++) {
+            proc.rank = n;
+            if (PMIX_SUCCESS == PMIx_Get(&proc, "bench.init", NULL, 0, &val)) {
+                if (init_max < (double)val->data.uint64) {
+                    init_max = (double)val->data.uint64;
+                }
+                PMIX_VALUE_RELEASE(val);
+            }
+        }
+        gds = getenv("PMIX_MCA_gds");
+        printf("{\"nprocs\":%u,\"gds\":\"%s\",\"nkeys\":%d,\"keysize\":%lu,\"nthreads\":%d,"
+               "\"iters\":%d,\"get_p50_us\":%.2f,\"get_p90_us\":%.2f,\"get_p99_us\":%.2f,"
+               "\"get_max_us\":%.2f,\"fence_per_sec\":%.1f,\"init_max_us\":%.1f,"
+               "\"connect_per_sec\":%.1f,\"notify_per_sec\":%.1f}\n",
+               nprocs, (NULL == gds) ? "default" : gds, nkeys, (unsigned long)keysize,
+               nthreads, iters,
+               (0 == nlat) ? 0.0 : lat[nlat / 2],
+               (0 == nlat) ? 0.0 : lat[(nlat * 9) / 10],
+               (0 == nlat) ? 0.0 : lat[(nlat * 99) / 100],
+               (0 == nlat) ? 0.0 : lat[nlat - 1],
+               (double)iters * 1000000.0 / tfence,
+               init_max,
+               (0 == init_max) ? 0.0 : (double)nprocs * 1000000.0 / init_max,
+               (double)iters * (double)(nprocs - 1) * 1000000.0 / tnotify);
+        fflush(stdout);
+    }
+
+  done:
+    free(lat);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "simpbench %s:%u: failed: %s\n", myproc.nspace, myproc.rank,
+                PMIx_Error_string(rc));
+    }
+    PMIx_Finalize(NULL, 0);
+    return (PMIX_SUCCESS == rc) ? 0 : 1;
+}
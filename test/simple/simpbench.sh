@@ -0,0 +1,31 @@
+#!/bin/bash
+#
+# Sweep simpbench across gds components, ranks, keys, value sizes
+# and thread counts. Each run prints one JSON line on stdout, so
+#
+#     ./simpbench.sh > results.json
+#
+# gives a file that can be diffed or plotted between builds.
+# Override any of the lists from the environment, e.g.
+#
+#     RANKS="4 16" GDS="hash" ./simpbench.sh
+
+GDS=${GDS:-"hash ds12 ds21"}
+RANKS=${RANKS:-"2 8 32"}
+KEYS=${KEYS:-"10 100"}
+SIZES=${SIZES:-"8 1024"}
+THREADS=${THREADS:-"1 4"}
+ITERS=${ITERS:-100}
+
+for gds in $GDS; do
+    for n in $RANKS; do
+        for k in $KEYS; do
+            for s in $SIZES; do
+                for t in $THREADS; do
+                    PMIX_MCA_gds=$gds ./simptest -n $n -e ./simpbench \
+                        -k $k -s $s -t $t -i $ITERS | grep '^{'
+                done
+            done
+        done
+    done
+done
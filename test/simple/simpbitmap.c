@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2018      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+/*
+ * Check the word-at-a-time scans in pmix_bitmap against a plain array
+ * of flags. For bitmaps of every size up to a few words, filled at a
+ * range of densities (including empty and full), we compare
+ *
+ *   - pmix_bitmap_find_next_set_bit / find_next_unset_bit from every
+ *     starting position
+ *   - the bits visited by PMIX_BITMAP_FOREACH_SET_BIT
+ *   - pmix_bitmap_are_all_set for every prefix length
+ *   - pmix_bitmap_bitwise_andnot_inplace
+ *
+ * and then walk a sparse bitmap of a few million bits.
+ *
+ * usage: simpbitmap
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_common.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/class/pmix_bitmap.h"
+
+#define MAXBITS     200
+#define BIGBITS     (4 * 1024 * 1024)
+
+static int nfailed = 0;
+
+#define FAIL(fmt, ...)                                              \
+    do {                                                            \
+        fprintf(stderr, "size %d density %d: " fmt "\n",            \
+                size, density, ## __VA_ARGS__);                     \
+        nfailed++;                                                  \
+    } while (0)
+
+static void fill(pmix_bitmap_t *bm, bool *ref, int size, int density)
+{
+    int n;
+
+    pmix_bitmap_init(bm, size);
+    for (n=0; n < size; n++) {
+        ref[n] = ((random() % 100) < density);
+        if (ref[n]) {
+            pmix_bitmap_set_bit(bm, n);
+        }
+    }
+}
+
+static void check_scans(int size, int density)
+{
+    pmix_bitmap_t bm, other;
+    bool ref[MAXBITS], ref2[MAXBITS], allset;
+    int n, m, want, got, bit;
+
+    PMIX_CONSTRUCT(&bm, pmix_bitmap_t);
+    PMIX_CONSTRUCT(&other, pmix_bitmap_t);
+    fill(&bm, ref, size, density);
+
+    for (n=0; n < size; n++) {
+        want = -1;
+        for (m=n; m < size; m++) {
+            if (ref[m]) {
+                want = m;
+                break;
+            }
+        }
+        got = pmix_bitmap_find_next_set_bit(&bm, n);
+        if (got != want) {
+            FAIL("find_next_set_bit(%d) returned %d, expected %d", n, got, want);
+        }
+
+        /* bits past the end of the map are clear, so the only
+         * requirement there is that we don't stop before them */
+        want = -1;
+        for (m=n; m < size; m++) {
+            if (!ref[m]) {
+                want = m;
+                break;
+            }
+        }
+        got = pmix_bitmap_find_next_unset_bit(&bm, n);
+        if (0 <= want ? got != want : (0 <= got && got < size)) {
+            FAIL("find_next_unset_bit(%d) returned %d, expected %d", n, got, want);
+        }
+    }
+
+    m = 0;
+    PMIX_BITMAP_FOREACH_SET_BIT(bit, &bm) {
+        while (m < size && !ref[m]) {
+            m++;
+        }
+        if (bit != m) {
+            FAIL("FOREACH_SET_BIT visited %d, expected %d", bit, m);
+            break;
+        }
+        m++;
+    }
+    while (m < size && !ref[m]) {
+        m++;
+    }
+    if (m < size) {
+        FAIL("FOREACH_SET_BIT missed bit %d", m);
+    }
+
+    allset = true;
+    for (n=0; n <= size; n++) {
+        if (pmix_bitmap_are_all_set(&bm, n) != allset) {
+            FAIL("are_all_set(%d) returned %s", n, allset ? "false" : "true");
+        }
+        if (n < size && !ref[n]) {
+            allset = false;
+        }
+    }
+
+    fill(&other, ref2, size, 50);
+    if (PMIX_SUCCESS != pmix_bitmap_bitwise_andnot_inplace(&bm, &other)) {
+        FAIL("andnot failed");
+    }
+    for (n=0; n < size; n++) {
+        if (pmix_bitmap_is_set_bit(&bm, n) != (ref[n] && !ref2[n])) {
+            FAIL("andnot: bit %d is wrong", n);
+        }
+    }
+
+    PMIX_DESTRUCT(&bm);
+    PMIX_DESTRUCT(&other);
+}
+
+static void check_big(void)
+{
+    pmix_bitmap_t bm;
+    int bit, cnt = 0, last = -1, size = BIGBITS, density = 0;
+
+    PMIX_CONSTRUCT(&bm, pmix_bitmap_t);
+    pmix_bitmap_init(&bm, BIGBITS);
+    /* one bit in every 4097, so most words are empty */
+    for (bit=0; bit < BIGBITS; bit += 4097) {
+        pmix_bitmap_set_bit(&bm, bit);
+    }
+    PMIX_BITMAP_FOREACH_SET_BIT(bit, &bm) {
+        if (bit != last + (0 > last ? 1 : 4097)) {
+            FAIL("sparse FOREACH_SET_BIT visited %d after %d", bit, last);
+            break;
+        }
+        last = bit;
+        cnt++;
+    }
+    if (cnt != (BIGBITS + 4096) / 4097) {
+        FAIL("sparse FOREACH_SET_BIT visited %d bits", cnt);
+    }
+
+    pmix_bitmap_set_all_bits(&bm);
+    pmix_bitmap_clear_bit(&bm, BIGBITS - 3);
+    if (pmix_bitmap_are_all_set(&bm, BIGBITS)) {
+        FAIL("are_all_set missed the clear bit");
+    }
+    if (!pmix_bitmap_are_all_set(&bm, BIGBITS - 3)) {
+        FAIL("are_all_set of the prefix failed");
+    }
+    if (BIGBITS - 3 != (bit = pmix_bitmap_find_next_unset_bit(&bm, 0))) {
+        FAIL("find_next_unset_bit returned %d", bit);
+    }
+    PMIX_DESTRUCT(&bm);
+}
+
+int main(int argc, char **argv)
+{
+    static const int densities[] = {0, 3, 50, 97, 100};
+    int size, n;
+
+    srandom(1);
+    for (size=1; size <= MAXBITS; size++) {
+        for (n=0; n < (int)(sizeof(densities) / sizeof(densities[0])); n++) {
+            check_scans(size, densities[n]);
+        }
+    }
+    check_big();
+
+    if (0 != nfailed) {
+        fprintf(stderr, "simpbitmap: %d checks FAILED\n", nfailed);
+        return 1;
+    }
+    fprintf(stderr, "Test finished OK!\n");
+    return 0;
+}
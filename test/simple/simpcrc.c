@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2018      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+/*
+ * Known answers for the CRC32C routines in src/util/crc.c. Whichever
+ * implementation was picked for this processor must give the published
+ * Castagnoli check value, agree with a bit-at-a-time reference for
+ * every length and source alignment around the word and unrolled
+ * boundaries, chain across pieces, and - for the copy variant - leave
+ * exactly copylen bytes in the destination.
+ *
+ * usage: simpcrc
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_common.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/util/crc.h"
+
+#define MAXLEN  300
+#define GUARD   0xa5
+
+static int nfailed = 0;
+
+static uint32_t crc32c_ref(const unsigned char *p, size_t len)
+{
+    uint32_t crc = 0xffffffff;
+    int j;
+
+    while (0 < len--) {
+        crc ^= *p++;
+        for (j=0; j < 8; j++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0x82f63b78 : (crc >> 1);
+        }
+    }
+    return ~crc;
+}
+
+static void check(const char *what, size_t len, size_t off,
+                  uint32_t got, uint32_t want)
+{
+    if (got != want) {
+        fprintf(stderr, "%s: len %lu offset %lu: got 0x%08x expected 0x%08x\n",
+                what, (unsigned long)len, (unsigned long)off, got, want);
+        nfailed++;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    unsigned char src[MAXLEN + 8], dst[MAXLEN + 16];
+    const char *check_str = "123456789";
+    unsigned char zeros[32];
+    uint32_t want, crc;
+    size_t len, off, n, split;
+
+    /* published check values */
+    check("check", 9, 0, pmix_crc32c(check_str, 9), 0xe3069283);
+    memset(zeros, 0, sizeof(zeros));
+    check("zeros", 32, 0, pmix_crc32c(zeros, 32), 0x8a9136aa);
+    check("empty", 0, 0, pmix_crc32c(check_str, 0), 0);
+
+    srandom(1);
+    for (n=0; n < sizeof(src); n++) {
+        src[n] = (unsigned char)random();
+    }
+
+    for (off=0; off < 8; off++) {
+        for (len=0; len <= MAXLEN; len++) {
+            want = crc32c_ref(&src[off], len);
+            check("crc32c", len, off, pmix_crc32c(&src[off], len), want);
+
+            /* chained in two pieces */
+            split = len / 3;
+            crc = pmix_crc32c_partial(&src[off], split, PMIX_CRC32C_INITIAL);
+            crc = pmix_crc32c_partial(&src[off + split], len - split, crc);
+            check("crc32c_partial", len, off, crc, want);
+
+            /* copy all of it */
+            memset(dst, GUARD, sizeof(dst));
+            check("bcopy_crc32c", len, off,
+                  pmix_bcopy_crc32c(&src[off], &dst[off], len, len), want);
+            if (0 != memcmp(&dst[off], &src[off], len) ||
+                GUARD != dst[off + len]) {
+                fprintf(stderr, "bcopy_crc32c: len %lu offset %lu: bad copy\n",
+                        (unsigned long)len, (unsigned long)off);
+                nfailed++;
+            }
+
+            /* copy only the first half of what we sum */
+            memset(dst, GUARD, sizeof(dst));
+            check("bcopy_crc32c short copy", len, off,
+                  pmix_bcopy_crc32c(&src[off], dst, len / 2, len), want);
+            if (0 != memcmp(dst, &src[off], len / 2) || GUARD != dst[len / 2]) {
+                fprintf(stderr, "bcopy_crc32c: len %lu offset %lu: bad short copy\n",
+                        (unsigned long)len, (unsigned long)off);
+                nfailed++;
+            }
+        }
+    }
+
+    if (0 != nfailed) {
+        fprintf(stderr, "simpcrc: %d checks FAILED\n", nfailed);
+        return 1;
+    }
+    fprintf(stderr, "Test finished OK!\n");
+    return 0;
+}
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2018      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+/*
+ * Operation counts for the commit, fence and get paths, meant to be
+ * run under simptest by simpgate.sh:
+ *
+ *     simptest -n <ranks> -e ./simpgate [-k keys] [-s size] [-r seed]
+ *
+ * Wall time is too noisy to gate on, so instead each rank counts
+ * what it did during each phase - mallocs, socket I/O calls, messages
+ * and bytes sent and received, and bfrops pack calls and bytes - and
+ * prints one line per phase:
+ *
+ *     <phase> <metric> <value>
+ *
+ * The keys and values are generated from a fixed seed, so the same
+ * build run with the same arguments does the same work every time.
+ * The I/O call counts depend on how the progress thread's reads and
+ * writes happen to line up with the socket, so they can move a little
+ * between runs - simpgate.sh allows for that with a per-metric tolerance.
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix.h>
+
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "simptest.h"
+
+static volatile bool counting = false;
+static uint64_t nmallocs = 0;
+static uint64_t nsyscalls = 0;
+
+#define GATE_COUNT(c)                                               \
+    do {                                                            \
+        if (counting) {                                             \
+            (void)__atomic_fetch_add(&(c), 1, __ATOMIC_RELAXED);    \
+        }                                                           \
+    } while(0)
+
+/* count allocations by interposing the allocator in the executable -
+ * the library's calls resolve to these ahead of libc's */
+#ifdef __GLIBC__
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size)
+{
+    GATE_COUNT(nmallocs);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+    GATE_COUNT(nmallocs);
+    return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    GATE_COUNT(nmallocs);
+    return __libc_realloc(ptr, size);
+}
+#endif
+
+/* count the calls the ptl uses to move data over its sockets */
+#define GATE_NEXT(fn, name)                                         \
+    do {                                                            \
+        if (NULL == (fn)) {                                         \
+            *(void**)(&(fn)) = dlsym(RTLD_NEXT, (name));            \
+        }                                                           \
+    } while(0)
+
+static ssize_t (*real_read)(int, void*, size_t) = NULL;
+static ssize_t (*real_write)(int, const void*, size_t) = NULL;
+static ssize_t (*real_readv)(int, const struct iovec*, int) = NULL;
+static ssize_t (*real_writev)(int, const struct iovec*, int) = NULL;
+static ssize_t (*real_send)(int, const void*, size_t, int) = NULL;
+static ssize_t (*real_recv)(int, void*, size_t, int) = NULL;
+
+ssize_t read(int fd, void *buf, size_t count)
+{
+    GATE_NEXT(real_read, "read");
+    GATE_COUNT(nsyscalls);
+    return real_read(fd, buf, count);
+}
+
+ssize_t write(int fd, const void *buf, size_t count)
+{
+    GATE_NEXT(real_write, "write");
+    GATE_COUNT(nsyscalls);
+    return real_write(fd, buf, count);
+}
+
+ssize_t readv(int fd, const struct iovec *iov, int iovcnt)
+{
+    GATE_NEXT(real_readv, "readv");
+    GATE_COUNT(nsyscalls);
+    return real_readv(fd, iov, iovcnt);
+}
+
+ssize_t writev(int fd, const struct iovec *iov, int iovcnt)
+{
+    GATE_NEXT(real_writev, "writev");
+    GATE_COUNT(nsyscalls);
+    return real_writev(fd, iov, iovcnt);
+}
+
+ssize_t send(int fd, const void *buf, size_t len, int flags)
+{
+    GATE_NEXT(real_send, "send");
+    GATE_COUNT(nsyscalls);
+    return real_send(fd, buf, len, flags);
+}
+
+ssize_t recv(int fd, void *buf, size_t len, int flags)
+{
+    GATE_NEXT(real_recv, "recv");
+    GATE_COUNT(nsyscalls);
+    return real_recv(fd, buf, len, flags);
+}
+
+typedef enum {
+    GATE_MALLOCS,
+    GATE_SYSCALLS,
+    GATE_MSGS_SENT,
+    GATE_BYTES_SENT,
+    GATE_MSGS_RECVD,
+    GATE_BYTES_RECVD,
+    GATE_PACKS,
+    GATE_BYTES_PACKED,
+    GATE_MAX
+} gate_metric_t;
+
+static const char *metric_names[GATE_MAX] = {
+    "mallocs", "syscalls", "msgs_sent", "bytes_sent",
+    "msgs_recvd", "bytes_recvd", "packs", "bytes_packed"
+};
+
+typedef struct {
+    uint64_t val[GATE_MAX];
+} gate_snap_t;
+
+typedef struct {
+    mylock_t lock;
+    gate_snap_t *snap;
+} gate_query_t;
+
+static pmix_proc_t myproc;
+
+static void qcbfunc(pmix_status_t status,
+                    pmix_info_t *info, size_t ninfo,
+                    void *cbdata,
+                    pmix_release_cbfunc_t release_fn,
+                    void *release_cbdata)
+{
+    gate_query_t *q = (gate_query_t*)cbdata;
+    gate_snap_t *snap = q->snap;
+    pmix_info_t *ctrs;
+    uint64_t *u64;
+    size_t n, nctrs;
+
+    q->lock.status = status;
+    if (PMIX_SUCCESS == status && 0 < ninfo &&
+        PMIX_DATA_ARRAY == info[0].value.type) {
+        ctrs = (pmix_info_t*)info[0].value.data.darray->array;
+        nctrs = info[0].value.data.darray->size;
+        for (n=0; n < nctrs; n++) {
+            u64 = (uint64_t*)ctrs[n].value.data.darray->array;
+            if (PMIX_CHECK_KEY(&ctrs[n], "pmix.ctr.msg.sent")) {
+                snap->val[GATE_MSGS_SENT] = u64[0];
+                snap->val[GATE_BYTES_SENT] = u64[1];
+            } else if (PMIX_CHECK_KEY(&ctrs[n], "pmix.ctr.msg.recvd")) {
+                snap->val[GATE_MSGS_RECVD] = u64[0];
+                snap->val[GATE_BYTES_RECVD] = u64[1];
+            } else if (PMIX_CHECK_KEY(&ctrs[n], "pmix.ctr.pack")) {
+                snap->val[GATE_PACKS] = u64[0];
+                snap->val[GATE_BYTES_PACKED] = u64[1];
+            }
+        }
+    }
+    if (NULL != release_fn) {
+        release_fn(release_cbdata);
+    }
+    DEBUG_WAKEUP_THREAD(&q->lock);
+}
+
+/* read our own counters - the query itself is not counted */
+static pmix_status_t load_counters(gate_snap_t *snap)
+{
+    pmix_query_t query;
+    gate_query_t q;
+    pmix_status_t rc;
+    bool flag = true;
+
+    PMIX_QUERY_CONSTRUCT(&query);
+    PMIX_ARGV_APPEND(rc, query.keys, PMIX_QUERY_COUNTERS);
+    PMIX_INFO_CREATE(query.qualifiers, 1);
+    query.nqual = 1;
+    PMIX_INFO_LOAD(&query.qualifiers[0], PMIX_QUERY_LOCAL_ONLY, &flag, PMIX_BOOL);
+    DEBUG_CONSTRUCT_LOCK(&q.lock);
+    q.snap = snap;
+    if (PMIX_SUCCESS == (rc = PMIx_Query_info_nb(&query, 1, qcbfunc, &q))) {
+        DEBUG_WAIT_THREAD(&q.lock);
+        rc = q.lock.status;
+    }
+    DEBUG_DESTRUCT_LOCK(&q.lock);
+    PMIX_QUERY_DESTRUCT(&query);
+    return rc;
+}
+
+static pmix_status_t phase_begin(gate_snap_t *snap)
+{
+    pmix_status_t rc;
+
+    memset(snap, 0, sizeof(*snap));
+    if (PMIX_SUCCESS != (rc = load_counters(snap))) {
+        return rc;
+    }
+    snap->val[GATE_MALLOCS] = nmallocs;
+    snap->val[GATE_SYSCALLS] = nsyscalls;
+    counting = true;
+    return PMIX_SUCCESS;
+}
+
+static pmix_status_t phase_end(const char *phase, gate_snap_t *start)
+{
+    gate_snap_t end;
+    pmix_status_t rc;
+    int n;
+
+    counting = false;
+    memset(&end, 0, sizeof(end));
+    end.val[GATE_MALLOCS] = nmallocs;
+    end.val[GATE_SYSCALLS] = nsyscalls;
+    if (PMIX_SUCCESS != (rc = load_counters(&end))) {
+        return rc;
+    }
+    for (n=0; n < GATE_MAX; n++) {
+        printf("%s %s %lu\n", phase, metric_names[n],
+               (unsigned long)(end.val[n] - start->val[n]));
+    }
+    fflush(stdout);
+    return PMIX_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    int nkeys = 10, size = 64, n, k;
+    unsigned int seed = 42, kseed;
+    pmix_status_t rc;
+    pmix_value_t value, *val;
+    pmix_proc_t proc;
+    pmix_info_t info;
+    gate_snap_t snap;
+    uint32_t nprocs;
+    char key[PMIX_MAX_KEYLEN+1];
+    char *data;
+    bool flag = true;
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp(argv[n], "-k") && NULL != argv[n+1]) {
+            nkeys = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp(argv[n], "-s") && NULL != argv[n+1]) {
+            size = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp(argv[n], "-r") && NULL != argv[n+1]) {
+            seed = strtoul(argv[++n], NULL, 10);
+        }
+    }
+    if (nkeys < 1 || size < 1) {
+        fprintf(stderr, "simpgate: -k and -s must be positive\n");
+        exit(1);
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "simpgate: PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(rc);
+    }
+    PMIX_PROC_CONSTRUCT(&proc);
+    (void)strncpy(proc.nspace, myproc.nspace, PMIX_MAX_NSLEN);
+    proc.rank = PMIX_RANK_WILDCARD;
+    if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, PMIX_JOB_SIZE, NULL, 0, &val))) {
+        goto done;
+    }
+    nprocs = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+
+    /* the values depend only on the seed and our rank */
+    data = (char*)malloc(size);
+    kseed = seed + myproc.rank;
+    value.type = PMIX_BYTE_OBJECT;
+    value.data.bo.bytes = data;
+    value.data.bo.size = size;
+
+    if (PMIX_SUCCESS != (rc = phase_begin(&snap))) {
+        goto done;
+    }
+    for (k=0; k < nkeys; k++) {
+        for (n=0; n < size; n++) {
+            data[n] = (char)rand_r(&kseed);
+        }
+        (void)snprintf(key, sizeof(key), "gate.%d", k);
+        if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, key, &value))) {
+            goto done;
+        }
+    }
+    if (PMIX_SUCCESS != (rc = PMIx_Commit()) ||
+        PMIX_SUCCESS != (rc = phase_end("commit", &snap))) {
+        goto done;
+    }
+    free(data);
+
+    if (PMIX_SUCCESS != (rc = phase_begin(&snap))) {
+        goto done;
+    }
+    PMIX_INFO_CONSTRUCT(&info);
+    PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, &flag, PMIX_BOOL);
+    rc = PMIx_Fence(NULL, 0, &info, 1);
+    PMIX_INFO_DESTRUCT(&info);
+    if (PMIX_SUCCESS != rc ||
+        PMIX_SUCCESS != (rc = phase_end("fence", &snap))) {
+        goto done;
+    }
+
+    if (PMIX_SUCCESS != (rc = phase_begin(&snap))) {
+        goto done;
+    }
+    for (n=0; n < (int)nprocs; n++) {
+        if (n == (int)myproc.rank) {
+            continue;
+        }
+        proc.rank = n;
+        for (k=0; k < nkeys; k++) {
+            (void)snprintf(key, sizeof(key), "gate.%d", k);
+            if (PMIX_SUCCESS != (rc = PMIx_Get(&proc, key, NULL, 0, &val))) {
+                goto done;
+            }
+            if (PMIX_BYTE_OBJECT != val->type || size != (int)val->data.bo.size) {
+                PMIX_VALUE_RELEASE(val);
+                rc = PMIX_ERR_BAD_PARAM;
+                goto done;
+            }
+            PMIX_VALUE_RELEASE(val);
+        }
+    }
+    rc = phase_end("get", &snap);
+
+  done:
+    counting = false;
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "simpgate %s:%u: failed: %s\n", myproc.nspace, myproc.rank,
+                PMIx_Error_string(rc));
+    }
+    PMIx_Finalize(NULL, 0);
+    return (PMIX_SUCCESS == rc) ? 0 : 1;
+}
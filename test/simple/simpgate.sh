@@ -0,0 +1,74 @@
+#!/bin/bash
+#
+# Regression gate on operation counts for the commit, fence and get
+# paths. Runs simpgate under simptest at fixed process counts with a
+# fixed seed, sums each metric across the ranks, and compares the
+# totals against a stored baseline:
+#
+#     ./simpgate.sh -u        # record simpgate.baseline for this build
+#     ./simpgate.sh           # exit 1 if any metric grew past tolerance
+#
+# Allocation and I/O call counts depend on the libc and configure
+# options, so record the baseline on the machine and configuration
+# that will be gated against it. Override any of the settings from
+# the environment, e.g.
+#
+#     RANKS="2 16" BASELINE=/tmp/gate.txt ./simpgate.sh
+
+RANKS=${RANKS:-"2 4 8"}
+KEYS=${KEYS:-10}
+SIZE=${SIZE:-64}
+SEED=${SEED:-42}
+BASELINE=${BASELINE:-simpgate.baseline}
+# percent growth allowed before a metric fails - the I/O call counts
+# move with the timing of the progress thread, the rest should not
+TOL=${TOL:-2}
+SYSCALL_TOL=${SYSCALL_TOL:-15}
+
+update=0
+if [ "$1" = "-u" ]; then
+    update=1
+fi
+
+run() {
+    for n in $RANKS; do
+        ./simptest -n $n -e ./simpgate -k $KEYS -s $SIZE -r $SEED > simpgate.out.$$
+        if [ $? -ne 0 ]; then
+            echo "simpgate.sh: simptest -n $n failed" >&2
+            rm -f simpgate.out.$$
+            exit 2
+        fi
+        awk -v n=$n 'NF == 3 && $3 ~ /^[0-9]+$/ { sum[$1 " " $2] += $3 }
+                     END { for (k in sum) print n, k, sum[k] }' simpgate.out.$$
+        rm -f simpgate.out.$$
+    done | sort -k1,1n -k2,3
+}
+
+if [ $update -eq 1 ]; then
+    run > $BASELINE
+    echo "simpgate.sh: recorded $(wc -l < $BASELINE) metrics in $BASELINE"
+    exit 0
+fi
+
+if [ ! -f $BASELINE ]; then
+    echo "simpgate.sh: no baseline $BASELINE - record one with -u" >&2
+    exit 2
+fi
+
+run | awk -v tol=$TOL -v systol=$SYSCALL_TOL '
+    NR == FNR { base[$1 " " $2 " " $3] = $4; next }
+    {
+        k = $1 " " $2 " " $3
+        if (!(k in base)) {
+            printf("NEW   np=%s %s %s %s\n", $1, $2, $3, $4)
+            next
+        }
+        t = ($3 == "syscalls") ? systol : tol
+        if ($4 > base[k] * (1 + t / 100)) {
+            printf("FAIL  np=%s %s %s %s -> %s\n", $1, $2, $3, base[k], $4)
+            bad = 1
+        } else if ($4 < base[k]) {
+            printf("less  np=%s %s %s %s -> %s\n", $1, $2, $3, base[k], $4)
+        }
+    }
+    END { exit bad }' $BASELINE -
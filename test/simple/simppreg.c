@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2018      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+/*
+ * Known answers and round trips for the compact preg component. The
+ * component is raised above native, so PMIx_generate_ppn must give the
+ * compact form for the regular maps below and fall back to native for
+ * the ones it can't or shouldn't encode. Every map, whichever module
+ * encoded it, must parse back to the per-node rank lists it came from.
+ *
+ * usage: simppreg
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/util/argv.h"
+#include "src/mca/preg/preg.h"
+
+static pmix_server_module_t mymodule;
+static int nfailed = 0;
+
+/* build the proc map of nnodes x ppn ranks, by slot or by node */
+static char* procmap(int nnodes, int ppn, bool byslot)
+{
+    char **nodes = NULL, **ranks, rank[16], *map;
+    int n, k;
+
+    for (n=0; n < nnodes; n++) {
+        ranks = NULL;
+        for (k=0; k < ppn; k++) {
+            snprintf(rank, sizeof(rank), "%d", byslot ? n * ppn + k : k * nnodes + n);
+            pmix_argv_append_nosize(&ranks, rank);
+        }
+        map = pmix_argv_join(ranks, ',');
+        pmix_argv_append_nosize(&nodes, map);
+        free(map);
+        pmix_argv_free(ranks);
+    }
+    map = pmix_argv_join(nodes, ';');
+    pmix_argv_free(nodes);
+    return map;
+}
+
+/* expected is the whole encoding, or a prefix ending in '[' for
+ * maps that should be left to another module */
+static void check(const char *what, const char *map, const char *expected)
+{
+    char *regex = NULL, **procs = NULL, **nodes;
+    size_t len = strlen(expected);
+    pmix_status_t rc;
+    int n;
+
+    if (PMIX_SUCCESS != (rc = PMIx_generate_ppn(map, &regex))) {
+        fprintf(stderr, "%s: generate_ppn failed: %s\n", what, PMIx_Error_string(rc));
+        nfailed++;
+        return;
+    }
+    if ('[' == expected[len-1] ? 0 != strncmp(regex, expected, len)
+                               : 0 != strcmp(regex, expected)) {
+        fprintf(stderr, "%s: encoded as %s, expected %s\n", what, regex, expected);
+        nfailed++;
+    }
+
+    if (PMIX_SUCCESS != (rc = pmix_preg.parse_procs(regex, &procs))) {
+        fprintf(stderr, "%s: parse_procs of %s failed: %s\n", what, regex,
+                PMIx_Error_string(rc));
+        nfailed++;
+        free(regex);
+        return;
+    }
+    nodes = pmix_argv_split(map, ';');
+    if (pmix_argv_count(procs) != pmix_argv_count(nodes)) {
+        fprintf(stderr, "%s: %d nodes came back for %d\n", what,
+                pmix_argv_count(procs), pmix_argv_count(nodes));
+        nfailed++;
+    } else {
+        for (n=0; NULL != nodes[n]; n++) {
+            if (0 != strcmp(procs[n], nodes[n])) {
+                fprintf(stderr, "%s: node %d came back as %s, expected %s\n",
+                        what, n, procs[n], nodes[n]);
+                nfailed++;
+                break;
+            }
+        }
+    }
+    pmix_argv_free(nodes);
+    pmix_argv_free(procs);
+    free(regex);
+}
+
+int main(int argc, char **argv)
+{
+    char *map, *tail;
+    pmix_status_t rc;
+
+    /* compact only runs ahead of native when asked to */
+    setenv("PMIX_MCA_preg_compact_priority", "200", 1);
+
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, NULL, 0))) {
+        fprintf(stderr, "simppreg: server init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+
+    map = procmap(4, 16, true);
+    check("byslot", map, "compact[4:0:16:16:1]");
+    free(map);
+
+    map = procmap(4, 16, false);
+    check("bynode", map, "compact[4:0:1:16:4]");
+    free(map);
+
+    map = procmap(2000, 16, true);
+    check("byslot 2000 nodes", map, "compact[2000:0:16:16:1]");
+    free(map);
+
+    /* a short last node starts a second run */
+    map = procmap(64, 8, true);
+    if (0 > asprintf(&tail, "%s;512,513,514,515", map)) {
+        exit(1);
+    }
+    check("two runs", tail, "compact[64:0:8:8:1;1:512:0:4:1]");
+    free(tail);
+    free(map);
+
+    /* ranks out of order - no progression to encode */
+    check("irregular", "0,5,2;1,3,4", "pmix[");
+
+    /* too small to be worth it */
+    check("tiny", "0;1", "pmix[");
+
+    PMIx_server_finalize();
+
+    if (0 != nfailed) {
+        fprintf(stderr, "simppreg: %d checks FAILED\n", nfailed);
+        return 1;
+    }
+    fprintf(stderr, "Test finished OK!\n");
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2018      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+/*
+ * Round trips of the proc sets carried by fence and connect requests
+ * (pmix_bfrops_base_pack_procset / unpack_procset). Each case is packed
+ * in both the plain and the range encoding with our own peer's bfrops
+ * module, and must unpack to exactly the array that went in - order,
+ * duplicates and special ranks included. For the large regular sets
+ * the range encoding must also come out smaller than the plain one.
+ *
+ * usage: simpprocset
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/base/base.h"
+
+static pmix_server_module_t mymodule;
+static int nfailed = 0;
+
+static size_t roundtrip(const char *what, pmix_proc_t *procs, size_t nprocs,
+                        bool ranges)
+{
+    pmix_buffer_t buf;
+    pmix_proc_t *out;
+    size_t nout, n, used = 0;
+    pmix_status_t rc;
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    rc = pmix_bfrops_base_pack_procset(pmix_globals.mypeer, &buf, procs, nprocs, ranges);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "%s: pack failed: %s\n", what, PMIx_Error_string(rc));
+        nfailed++;
+        goto done;
+    }
+    used = buf.bytes_used;
+    rc = pmix_bfrops_base_unpack_procset(pmix_globals.mypeer, &buf, &out, &nout);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "%s: unpack failed: %s\n", what, PMIx_Error_string(rc));
+        nfailed++;
+        goto done;
+    }
+    if (nout != nprocs) {
+        fprintf(stderr, "%s: %lu procs came back for %lu\n", what,
+                (unsigned long)nout, (unsigned long)nprocs);
+        nfailed++;
+    } else {
+        for (n=0; n < nprocs; n++) {
+            if (0 != strncmp(out[n].nspace, procs[n].nspace, PMIX_MAX_NSLEN) ||
+                out[n].rank != procs[n].rank) {
+                fprintf(stderr, "%s: proc %lu came back as %s:%u, expected %s:%u\n",
+                        what, (unsigned long)n, out[n].nspace, out[n].rank,
+                        procs[n].nspace, procs[n].rank);
+                nfailed++;
+                break;
+            }
+        }
+    }
+    if (NULL != out) {
+        PMIX_PROC_FREE(out, nout);
+    }
+
+  done:
+    PMIX_DESTRUCT(&buf);
+    return used;
+}
+
+static void check(const char *what, pmix_proc_t *procs, size_t nprocs,
+                  bool smaller)
+{
+    size_t plain, ranged;
+
+    plain = roundtrip(what, procs, nprocs, false);
+    ranged = roundtrip(what, procs, nprocs, true);
+    if (smaller && ranged >= plain) {
+        fprintf(stderr, "%s: range encoding took %lu bytes, plain %lu\n", what,
+                (unsigned long)ranged, (unsigned long)plain);
+        nfailed++;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    pmix_proc_t *procs;
+    size_t n, np;
+    pmix_status_t rc;
+
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, NULL, 0))) {
+        fprintf(stderr, "simpprocset: server init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+
+    PMIX_PROC_CREATE(procs, 4096);
+
+    check("empty", procs, 0, false);
+
+    PMIX_PROC_LOAD(&procs[0], "foo", 7);
+    check("single", procs, 1, false);
+
+    /* one dense run - a single range */
+    for (n=0; n < 4096; n++) {
+        PMIX_PROC_LOAD(&procs[n], "foo", n);
+    }
+    check("dense", procs, 4096, true);
+
+    /* every other rank - the bitmap */
+    for (n=0; n < 2048; n++) {
+        PMIX_PROC_LOAD(&procs[n], "foo", 2 * n + 1);
+    }
+    check("strided", procs, 2048, true);
+
+    /* a few far apart - ranges */
+    PMIX_PROC_LOAD(&procs[0], "foo", 0);
+    PMIX_PROC_LOAD(&procs[1], "foo", 100000);
+    PMIX_PROC_LOAD(&procs[2], "foo", 100001);
+    check("sparse", procs, 3, false);
+
+    /* out of order and repeated */
+    np = 0;
+    PMIX_PROC_LOAD(&procs[np++], "foo", 9);
+    PMIX_PROC_LOAD(&procs[np++], "foo", 3);
+    PMIX_PROC_LOAD(&procs[np++], "foo", 4);
+    PMIX_PROC_LOAD(&procs[np++], "foo", 4);
+    PMIX_PROC_LOAD(&procs[np++], "foo", 5);
+    PMIX_PROC_LOAD(&procs[np++], "foo", 0);
+    check("unordered", procs, np, false);
+
+    /* special ranks never join a run, even one ending just below them */
+    np = 0;
+    PMIX_PROC_LOAD(&procs[np++], "foo", PMIX_RANK_LOCAL_PEERS - 2);
+    PMIX_PROC_LOAD(&procs[np++], "foo", PMIX_RANK_LOCAL_PEERS - 1);
+    PMIX_PROC_LOAD(&procs[np++], "foo", PMIX_RANK_LOCAL_PEERS);
+    PMIX_PROC_LOAD(&procs[np++], "foo", PMIX_RANK_INVALID);
+    PMIX_PROC_LOAD(&procs[np++], "foo", PMIX_RANK_WILDCARD);
+    PMIX_PROC_LOAD(&procs[np++], "bar", 1);
+    PMIX_PROC_LOAD(&procs[np++], "bar", PMIX_RANK_LOCAL_PEERS);
+    PMIX_PROC_LOAD(&procs[np++], "bar", PMIX_RANK_WILDCARD);
+    PMIX_PROC_LOAD(&procs[np++], "bar", PMIX_RANK_UNDEF);
+    check("special", procs, np, false);
+
+    /* nspaces interleaved - each switch starts a new segment */
+    for (n=0; n < 3000; n++) {
+        PMIX_PROC_LOAD(&procs[n], (n / 1000) % 2 ? "bar" : "foo", n % 1000);
+    }
+    check("interleaved", procs, 3000, true);
+
+    PMIX_PROC_FREE(procs, 4096);
+    PMIx_server_finalize();
+
+    if (0 != nfailed) {
+        fprintf(stderr, "simpprocset: %d checks FAILED\n", nfailed);
+        return 1;
+    }
+    fprintf(stderr, "Test finished OK!\n");
+    return 0;
+}
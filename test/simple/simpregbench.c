@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2018      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+/*
+ * Measure what it costs a server to take on a large job, without
+ * needing the cluster. We synthesize the node and proc maps of a job
+ * of nnodes x ppn ranks in which we host the first node, and time
+ *
+ *   - PMIx_generate_regex / PMIx_generate_ppn on those maps
+ *   - PMIx_server_register_nspace, which parses the maps and stores
+ *     the job info in the gds component
+ *   - PMIx_server_register_client and PMIx_server_setup_fork for each
+ *     of our local ranks, i.e. the server side of client attach
+ *   - PMIx_server_deregister_nspace
+ *
+ * usage: simpregbench [-N nnodes] [-p ppn] [-i iters] [-m byslot|bynode]
+ *
+ * One JSON line is printed per iteration. The gds and preg components
+ * are selected the usual way (PMIX_MCA_gds, PMIX_MCA_preg).
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "simptest.h"
+
+static pmix_server_module_t mymodule;
+
+static double now_usec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000000.0 + (double)ts.tv_nsec / 1000.0;
+}
+
+static void opcbfunc(pmix_status_t status, void *cbdata)
+{
+    mylock_t *lock = (mylock_t*)cbdata;
+
+    lock->status = status;
+    DEBUG_WAKEUP_THREAD(lock);
+}
+
+/* append to a growing string */
+static void append(char **buf, size_t *used, size_t *size, const char *str)
+{
+    size_t n = strlen(str);
+
+    if (*size < *used + n + 1) {
+        *size = 2 * (*used + n + 1);
+        *buf = (char*)realloc(*buf, *size);
+        if (NULL == *buf) {
+            fprintf(stderr, "simpregbench: out of memory\n");
+            exit(1);
+        }
+    }
+    memcpy(*buf + *used, str, n + 1);
+    *used += n;
+}
+
+int main(int argc, char **argv)
+{
+    int nnodes = 1000, ppn = 16, iters = 3, it, n, k, rank;
+    bool byslot = true;
+    char hostname[PMIX_MAXHOSTNAMELEN], name[PMIX_MAXHOSTNAMELEN + 16];
+    char *nodes = NULL, *procs = NULL, *local = NULL, *regex, *ppnregex, **env;
+    size_t nused = 0, nsize = 0, pused = 0, psize = 0, lused = 0, lsize = 0;
+    pmix_nspace_t nspace;
+    pmix_proc_t proc;
+    pmix_info_t *info;
+    size_t ninfo = 7;
+    uint32_t nprocs;
+    pmix_status_t rc;
+    mylock_t lock;
+    double start, tregex, tppn, treg, tclient, tfork, tdereg;
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp(argv[n], "-N") && NULL != argv[n+1]) {
+            nnodes = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp(argv[n], "-p") && NULL != argv[n+1]) {
+            ppn = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp(argv[n], "-i") && NULL != argv[n+1]) {
+            iters = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp(argv[n], "-m") && NULL != argv[n+1]) {
+            byslot = (0 != strcmp(argv[++n], "bynode"));
+        } else {
+            fprintf(stderr, "usage: simpregbench [-N nnodes] [-p ppn] [-i iters] "
+                    "[-m byslot|bynode]\n");
+            exit(0 == strcmp(argv[n], "-h") ? 0 : 1);
+        }
+    }
+    if (nnodes < 1 || ppn < 1 || iters < 1) {
+        fprintf(stderr, "simpregbench: -N, -p and -i must be positive\n");
+        exit(1);
+    }
+    nprocs = (uint32_t)nnodes * ppn;
+
+    /* we are the first node of the job */
+    gethostname(hostname, sizeof(hostname));
+    for (n=0; n < nnodes; n++) {
+        if (0 == n) {
+            snprintf(name, sizeof(name), "%s", hostname);
+        } else {
+            snprintf(name, sizeof(name), ",node%06d", n);
+        }
+        append(&nodes, &nused, &nsize, name);
+        for (k=0; k < ppn; k++) {
+            rank = byslot ? n * ppn + k : k * nnodes + n;
+            snprintf(name, sizeof(name), (0 == k) ? "%d" : ",%d", rank);
+            append(&procs, &pused, &psize, name);
+            if (0 == n) {
+                append(&local, &lused, &lsize, name);
+            }
+        }
+        if (n < nnodes - 1) {
+            append(&procs, &pused, &psize, ";");
+        }
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, NULL, 0))) {
+        fprintf(stderr, "simpregbench: server init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+
+    for (it=0; it < iters; it++) {
+        start = now_usec();
+        if (PMIX_SUCCESS != (rc = PMIx_generate_regex(nodes, &regex))) {
+            break;
+        }
+        tregex = now_usec() - start;
+        start = now_usec();
+        if (PMIX_SUCCESS != (rc = PMIx_generate_ppn(procs, &ppnregex))) {
+            free(regex);
+            break;
+        }
+        tppn = now_usec() - start;
+
+        PMIX_INFO_CREATE(info, ninfo);
+        PMIX_INFO_LOAD(&info[0], PMIX_UNIV_SIZE, &nprocs, PMIX_UINT32);
+        PMIX_INFO_LOAD(&info[1], PMIX_JOB_SIZE, &nprocs, PMIX_UINT32);
+        PMIX_INFO_LOAD(&info[2], PMIX_LOCAL_SIZE, &ppn, PMIX_UINT32);
+        PMIX_INFO_LOAD(&info[3], PMIX_LOCAL_PEERS, local, PMIX_STRING);
+        PMIX_INFO_LOAD(&info[4], PMIX_NODE_MAP, regex, PMIX_STRING);
+        PMIX_INFO_LOAD(&info[5], PMIX_PROC_MAP, ppnregex, PMIX_STRING);
+        PMIX_INFO_LOAD(&info[6], PMIX_NUM_NODES, &nnodes, PMIX_UINT32);
+
+        snprintf(nspace, sizeof(nspace), "regbench-%d", it);
+        DEBUG_CONSTRUCT_LOCK(&lock);
+        start = now_usec();
+        rc = PMIx_server_register_nspace(nspace, ppn, info, ninfo, opcbfunc, &lock);
+        if (PMIX_SUCCESS == rc) {
+            DEBUG_WAIT_THREAD(&lock);
+            rc = lock.status;
+        }
+        treg = now_usec() - start;
+        DEBUG_DESTRUCT_LOCK(&lock);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "simpregbench: register nspace failed: %s\n",
+                    PMIx_Error_string(rc));
+            goto cleanup;
+        }
+
+        /* the server side of each local client attaching */
+        PMIX_PROC_CONSTRUCT(&proc);
+        (void)strncpy(proc.nspace, nspace, PMIX_MAX_NSLEN);
+        tclient = 0;
+        tfork = 0;
+        for (k=0; k < ppn && PMIX_SUCCESS == rc; k++) {
+            proc.rank = byslot ? k : k * nnodes;
+            DEBUG_CONSTRUCT_LOCK(&lock);
+            start = now_usec();
+            rc = PMIx_server_register_client(&proc, getuid(), getgid(), NULL,
+                                             opcbfunc, &lock);
+            if (PMIX_SUCCESS == rc) {
+                DEBUG_WAIT_THREAD(&lock);
+                rc = lock.status;
+            }
+            tclient += now_usec() - start;
+            DEBUG_DESTRUCT_LOCK(&lock);
+            if (PMIX_SUCCESS == rc) {
+                env = NULL;
+                start = now_usec();
+                rc = PMIx_server_setup_fork(&proc, &env);
+                tfork += now_usec() - start;
+                for (n=0; NULL != env && NULL != env[n]; n++) {
+                    free(env[n]);
+                }
+                free(env);
+            }
+        }
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "simpregbench: client setup failed: %s\n",
+                    PMIx_Error_string(rc));
+            goto cleanup;
+        }
+
+        DEBUG_CONSTRUCT_LOCK(&lock);
+        start = now_usec();
+        PMIx_server_deregister_nspace(nspace, opcbfunc, &lock);
+        DEBUG_WAIT_THREAD(&lock);
+        tdereg = now_usec() - start;
+        DEBUG_DESTRUCT_LOCK(&lock);
+
+        printf("{\"nnodes\":%d,\"ppn\":%d,\"nprocs\":%u,\"map\":\"%s\","
+               "\"node_map_bytes\":%lu,\"proc_map_bytes\":%lu,"
+               "\"node_regex_us\":%.1f,\"proc_regex_us\":%.1f,"
+               "\"register_nspace_us\":%.1f,\"register_client_us\":%.2f,"
+               "\"setup_fork_us\":%.2f,\"deregister_us\":%.1f}\n",
+               nnodes, ppn, nprocs, byslot ? "byslot" : "bynode",
+               (unsigned long)strlen(regex), (unsigned long)strlen(ppnregex),
+               tregex, tppn, treg, tclient / ppn, tfork / ppn, tdereg);
+        fflush(stdout);
+
+      cleanup:
+        PMIX_INFO_FREE(info, ninfo);
+        free(regex);
+        free(ppnregex);
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+    }
+
+    free(nodes);
+    free(procs);
+    free(local);
+    PMIx_server_finalize();
+    return (PMIX_SUCCESS == rc) ? 0 : 1;
+}
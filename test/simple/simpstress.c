@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2018      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+/*
+ * Concurrency scaling of the client library, meant to be run under
+ * simptest:
+ *
+ *     simptest -n <ranks> -e ./simpstress [-t maxthreads] [-d secs]
+ *
+ * For each operation below and each thread count 1, 2, 4, ... up to
+ * maxthreads, every thread issues the operation back to back for the
+ * given duration. Rank 0 prints one JSON line per (op, threads) with
+ * the aggregate ops/sec, so contention on the client's global lock
+ * and event thread shows up as a flat or falling curve.
+ *
+ *   get       PMIx_Get of a peer's key (satisfied from the local cache)
+ *   get_nb    PMIx_Get_nb of the same key, waiting on each callback
+ *   notify    PMIx_Notify_event to PMIX_RANGE_PROC_LOCAL
+ *   query_nb  PMIx_Query_info_nb of the server's PMIX_QUERY_COUNTERS
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "simptest.h"
+
+typedef enum {
+    OP_GET,
+    OP_GET_NB,
+    OP_NOTIFY,
+    OP_QUERY_NB,
+    OP_MAX
+} stress_op_t;
+
+static const char *opnames[OP_MAX] = {
+    "get", "get_nb", "notify", "query_nb"
+};
+
+typedef struct {
+    pthread_t thread;
+    stress_op_t op;
+    uint64_t nops;
+    pmix_status_t status;
+    mylock_t lock;
+} stress_thread_t;
+
+static pmix_proc_t myproc, peer;
+static double duration = 1.0;
+static volatile bool go = false;
+
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+static void valcbfunc(pmix_status_t status, pmix_value_t *kv, void *cbdata)
+{
+    mylock_t *lock = (mylock_t*)cbdata;
+
+    lock->status = status;
+    DEBUG_WAKEUP_THREAD(lock);
+}
+
+static void opcbfunc(pmix_status_t status, void *cbdata)
+{
+    mylock_t *lock = (mylock_t*)cbdata;
+
+    lock->status = status;
+    DEBUG_WAKEUP_THREAD(lock);
+}
+
+static void qcbfunc(pmix_status_t status,
+                    pmix_info_t *info, size_t ninfo,
+                    void *cbdata,
+                    pmix_release_cbfunc_t release_fn,
+                    void *release_cbdata)
+{
+    mylock_t *lock = (mylock_t*)cbdata;
+
+    lock->status = status;
+    if (NULL != release_fn) {
+        release_fn(release_cbdata);
+    }
+    DEBUG_WAKEUP_THREAD(lock);
+}
+
+static void evhandler(size_t evhdlr_registration_id,
+                      pmix_status_t status,
+                      const pmix_proc_t *source,
+                      pmix_info_t info[], size_t ninfo,
+                      pmix_info_t results[], size_t nresults,
+                      pmix_event_notification_cbfunc_fn_t cbfunc,
+                      void *cbdata)
+{
+    if (NULL != cbfunc) {
+        cbfunc(PMIX_EVENT_ACTION_COMPLETE, NULL, 0, NULL, NULL, cbdata);
+    }
+}
+
+static void regcbfunc(pmix_status_t status, size_t ref, void *cbdata)
+{
+    mylock_t *lock = (mylock_t*)cbdata;
+
+    lock->status = status;
+    DEBUG_WAKEUP_THREAD(lock);
+}
+
+static pmix_status_t one_op(stress_thread_t *t, pmix_query_t *query)
+{
+    pmix_value_t *val;
+    pmix_status_t rc;
+
+    if (OP_GET == t->op) {
+        rc = PMIx_Get(&peer, "stress.key", NULL, 0, &val);
+        if (PMIX_SUCCESS == rc) {
+            PMIX_VALUE_RELEASE(val);
+        }
+        return rc;
+    }
+
+    DEBUG_CONSTRUCT_LOCK(&t->lock);
+    switch (t->op) {
+        case OP_GET_NB:
+            rc = PMIx_Get_nb(&peer, "stress.key", NULL, 0, valcbfunc, &t->lock);
+            break;
+        case OP_NOTIFY:
+            rc = PMIx_Notify_event(PMIX_EXTERNAL_ERR_BASE - 2, &myproc, PMIX_RANGE_PROC_LOCAL,
+                                   NULL, 0, opcbfunc, &t->lock);
+            break;
+        default:
+            rc = PMIx_Query_info_nb(query, 1, qcbfunc, &t->lock);
+            break;
+    }
+    if (PMIX_SUCCESS == rc) {
+        DEBUG_WAIT_THREAD(&t->lock);
+        rc = t->lock.status;
+        /* an empty query reply is not a failure of the path */
+        if (PMIX_ERR_NOT_FOUND == rc || PMIX_ERR_NOT_SUPPORTED == rc) {
+            rc = PMIX_SUCCESS;
+        }
+    }
+    DEBUG_DESTRUCT_LOCK(&t->lock);
+    return rc;
+}
+
+static void *worker(void *arg)
+{
+    stress_thread_t *t = (stress_thread_t*)arg;
+    pmix_query_t query;
+    double end;
+
+    PMIX_QUERY_CONSTRUCT(&query);
+    PMIX_ARGV_APPEND(t->status, query.keys, PMIX_QUERY_COUNTERS);
+
+    while (!go) {
+        usleep(1);
+    }
+    t->nops = 0;
+    t->status = PMIX_SUCCESS;
+    end = now_sec() + duration;
+    while (now_sec() < end) {
+        if (PMIX_SUCCESS != (t->status = one_op(t, &query))) {
+            break;
+        }
+        ++t->nops;
+    }
+    PMIX_QUERY_DESTRUCT(&query);
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    int maxthreads = 8, nthreads, n;
+    pmix_status_t rc, code = PMIX_EXTERNAL_ERR_BASE - 2;
+    pmix_value_t value, *val;
+    pmix_proc_t wildcard;
+    pmix_info_t info;
+    stress_thread_t *threads;
+    stress_op_t op;
+    uint32_t nprocs;
+    uint64_t total;
+    mylock_t lock;
+    double start, elapsed;
+    bool flag = true;
+
+    for (n=1; n < argc; n++) {
+        if (0 == strcmp(argv[n], "-t") && NULL != argv[n+1]) {
+            maxthreads = strtol(argv[++n], NULL, 10);
+        } else if (0 == strcmp(argv[n], "-d") && NULL != argv[n+1]) {
+            duration = strtod(argv[++n], NULL);
+        }
+    }
+    if (maxthreads < 1 || duration <= 0) {
+        fprintf(stderr, "simpstress: -t and -d must be positive\n");
+        exit(1);
+    }
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "simpstress: PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(rc);
+    }
+    PMIX_PROC_CONSTRUCT(&wildcard);
+    (void)strncpy(wildcard.nspace, myproc.nspace, PMIX_MAX_NSLEN);
+    wildcard.rank = PMIX_RANK_WILDCARD;
+    if (PMIX_SUCCESS != (rc = PMIx_Get(&wildcard, PMIX_JOB_SIZE, NULL, 0, &val))) {
+        goto done;
+    }
+    nprocs = val->data.uint32;
+    PMIX_VALUE_RELEASE(val);
+    PMIX_PROC_CONSTRUCT(&peer);
+    (void)strncpy(peer.nspace, myproc.nspace, PMIX_MAX_NSLEN);
+    peer.rank = (myproc.rank + 1) % nprocs;
+
+    /* everyone posts a key, and we register a handler for our own events */
+    value.type = PMIX_UINT64;
+    value.data.uint64 = myproc.rank;
+    if (PMIX_SUCCESS != (rc = PMIx_Put(PMIX_GLOBAL, "stress.key", &value)) ||
+        PMIX_SUCCESS != (rc = PMIx_Commit())) {
+        goto done;
+    }
+    PMIX_INFO_CONSTRUCT(&info);
+    PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, &flag, PMIX_BOOL);
+    rc = PMIx_Fence(NULL, 0, &info, 1);
+    PMIX_INFO_DESTRUCT(&info);
+    if (PMIX_SUCCESS != rc) {
+        goto done;
+    }
+    DEBUG_CONSTRUCT_LOCK(&lock);
+    PMIx_Register_event_handler(&code, 1, NULL, 0, evhandler, regcbfunc, &lock);
+    DEBUG_WAIT_THREAD(&lock);
+    DEBUG_DESTRUCT_LOCK(&lock);
+
+    threads = (stress_thread_t*)calloc(maxthreads, sizeof(stress_thread_t));
+    for (op=OP_GET; op < OP_MAX && PMIX_SUCCESS == rc; op++) {
+        for (nthreads=1; nthreads <= maxthreads; nthreads *= 2) {
+            /* line the ranks up so they load the server together */
+            if (PMIX_SUCCESS != (rc = PMIx_Fence(NULL, 0, NULL, 0))) {
+                break;
+            }
+            go = false;
+            for (n=0; n < nthreads; n++) {
+                threads[n].op = op;
+                pthread_create(&threads[n].thread, NULL, worker, &threads[n]);
+            }
+            start = now_sec();
+            go = true;
+            total = 0;
+            for (n=0; n < nthreads; n++) {
+                pthread_join(threads[n].thread, NULL);
+                total += threads[n].nops;
+                if (PMIX_SUCCESS != threads[n].status) {
+                    rc = threads[n].status;
+                }
+            }
+            elapsed = now_sec() - start;
+            if (PMIX_SUCCESS != rc) {
+                fprintf(stderr, "simpstress: %s failed: %s\n", opnames[op],
+                        PMIx_Error_string(rc));
+                break;
+            }
+            if (0 == myproc.rank) {
+                printf("{\"op\":\"%s\",\"nprocs\":%u,\"nthreads\":%d,\"ops\":%lu,"
+                       "\"ops_per_sec\":%.1f}\n", opnames[op], nprocs, nthreads,
+                       (unsigned long)total, (double)total / elapsed);
+                fflush(stdout);
+            }
+        }
+    }
+    free(threads);
+
+  done:
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "simpstress %s:%u: failed: %s\n", myproc.nspace, myproc.rank,
+                PMIx_Error_string(rc));
+    }
+    PMIx_Finalize(NULL, 0);
+    return (PMIX_SUCCESS == rc) ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2018      Intel, Inc.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+/*
+ * Exercise the shared timer wheel (pmix_timer_add / pmix_timer_del).
+ * Timers may only be touched from the progress thread, so everything
+ * below is threadshifted there. We check that
+ *
+ *   - timers fire in order, no earlier than asked and at most a
+ *     little late
+ *   - a cancelled timer never fires, including one cancelled by the
+ *     callback of another that expires on the same tick
+ *   - re-arming a timer replaces the earlier expiry
+ *   - a timer more than a full turn of the wheel away is not fired
+ *     when its slot first comes round
+ *
+ * usage: simptimer
+ */
+
+#include <src/include/pmix_config.h>
+#include <pmix_server.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "src/include/pmix_globals.h"
+
+#include "simptest.h"
+
+/* how late a timer may fire - two ticks, plus room for a busy machine */
+#define SLACK   0.5
+
+typedef struct {
+    const char *name;
+    double after;       // seconds to arm it for
+    bool fire;          // whether it should fire at all
+    pmix_timer_t timer;
+    int nfired;
+    double when;        // seconds after arming that it fired
+} timer_case_t;
+
+static timer_case_t cases[] = {
+    {.name = "early",     .after = 0.2,  .fire = true},
+    {.name = "late",      .after = 0.5,  .fire = true},
+    {.name = "cancelled", .after = 0.3,  .fire = false},
+    {.name = "canceller", .after = 0.3,  .fire = true},
+    {.name = "victim",    .after = 0.3,  .fire = false},
+    {.name = "rearmed",   .after = 0.4,  .fire = true},
+    /* more than a turn (512 ticks) away - its slot comes round
+     * again within the first second */
+    {.name = "next turn", .after = 51.8, .fire = false},
+};
+#define NCASES  (int)(sizeof(cases) / sizeof(cases[0]))
+#define CANCELLED   2
+#define CANCELLER   3
+#define VICTIM      4
+#define REARMED     5
+#define NEXTTURN    6
+
+typedef struct {
+    pmix_event_t ev;
+    mylock_t lock;
+} shift_t;
+
+static double start;
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+static void fired(int sd, short args, void *cbdata)
+{
+    timer_case_t *tc = (timer_case_t*)cbdata;
+
+    tc->nfired++;
+    tc->when = now() - start;
+    if (tc == &cases[CANCELLER]) {
+        pmix_timer_del(&cases[VICTIM].timer);
+    }
+}
+
+static void arm(int sd, short args, void *cbdata)
+{
+    shift_t *cd = (shift_t*)cbdata;
+    struct timeval tv;
+    int n;
+
+    start = now();
+    for (n=0; n < NCASES; n++) {
+        tv.tv_sec = (int)cases[n].after;
+        tv.tv_usec = (int)((cases[n].after - tv.tv_sec) * 1000000.0 + 0.5);
+        if (n == REARMED) {
+            /* armed for sooner first - the second add must win */
+            struct timeval soon = {0, 100000};
+            pmix_timer_add(&cases[n].timer, fired, &cases[n], &soon);
+        }
+        pmix_timer_add(&cases[n].timer, fired, &cases[n], &tv);
+    }
+    pmix_timer_del(&cases[CANCELLED].timer);
+    DEBUG_WAKEUP_THREAD(&cd->lock);
+}
+
+static void disarm(int sd, short args, void *cbdata)
+{
+    shift_t *cd = (shift_t*)cbdata;
+
+    pmix_timer_del(&cases[NEXTTURN].timer);
+    DEBUG_WAKEUP_THREAD(&cd->lock);
+}
+
+static void shift(void (*cbfunc)(int, short, void*))
+{
+    shift_t cd;
+
+    DEBUG_CONSTRUCT_LOCK(&cd.lock);
+    pmix_threadshift(&cd.ev, cbfunc, &cd);
+    DEBUG_WAIT_THREAD(&cd.lock);
+    DEBUG_DESTRUCT_LOCK(&cd.lock);
+}
+
+static pmix_server_module_t mymodule;
+
+int main(int argc, char **argv)
+{
+    pmix_status_t rc;
+    int n, nfailed = 0;
+    timer_case_t *tc;
+
+    if (PMIX_SUCCESS != (rc = PMIx_server_init(&mymodule, NULL, 0))) {
+        fprintf(stderr, "simptimer: server init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+
+    shift(arm);
+    /* long enough for all the short ones and for the
+     * long one's slot to have been visited */
+    sleep(2);
+    shift(disarm);
+
+    for (n=0; n < NCASES; n++) {
+        tc = &cases[n];
+        if (tc->nfired != (tc->fire ? 1 : 0)) {
+            fprintf(stderr, "%s: fired %d times\n", tc->name, tc->nfired);
+            nfailed++;
+        } else if (tc->fire && (tc->when < tc->after || tc->when > tc->after + SLACK)) {
+            fprintf(stderr, "%s: armed for %.2fs fired after %.2fs\n",
+                    tc->name, tc->after, tc->when);
+            nfailed++;
+        }
+    }
+    if (cases[1].nfired && cases[0].nfired && cases[1].when < cases[0].when) {
+        fprintf(stderr, "%s fired before %s\n", cases[1].name, cases[0].name);
+        nfailed++;
+    }
+
+    PMIx_server_finalize();
+
+    if (0 != nfailed) {
+        fprintf(stderr, "simptimer: %d checks FAILED\n", nfailed);
+        return 1;
+    }
+    fprintf(stderr, "Test finished OK!\n");
+    return 0;
+}
@@ -81,6 +81,8 @@ void parse_cmd(int argc, char **argv, test_params *params)
             fprintf(stderr, "\t--test-replace N:k0,k1,...,k(N-1)   test key replace for N keys, k0,k1,k(N-1) - key indexes to replace  \n");
             fprintf(stderr, "\t--test-internal N  test store internal key, N - number of internal keys\n");
             fprintf(stderr, "\t--gds <external gds name>           set GDS module \"--gds hash|ds12\", default is hash\n");
+            fprintf(stderr, "\t--emulate N  play the local clients as virtual peers driven by N threads instead of forking them.\n");
+            fprintf(stderr, "\t             Each peer connects, commits, fences (collecting if -c), gets, waits for an event and finalizes.\n");
             exit(0);
         } else if (0 == strcmp(argv[i], "--exec") || 0 == strcmp(argv[i], "-e")) {
             i++;
@@ -199,6 +201,11 @@ void parse_cmd(int argc, char **argv, test_params *params)
         } else if(0 == strcmp(argv[i], "--gds") ) {
             i++;
             params->gds_mode = strdup(argv[i]);
+        } else if (0 == strcmp(argv[i], "--emulate")) {
+            i++;
+            if (NULL != argv[i]) {
+                params->emulate = strtol(argv[i], NULL, 10);
+            }
         }
 
         else {
@@ -87,11 +87,11 @@ extern FILE *file;
     char *fname = malloc( strlen(prefix) + MAX_DIGIT_LEN + 2 ); \
     sprintf(fname, "%s.%d.%d", prefix, ns_id, rank); \
     file = fopen(fname, "w"); \
-    free(fname); \
     if( NULL == file ){ \
         fprintf(stderr, "Cannot open file %s for writing!", fname); \
         exit(1); \
     } \
+    free(fname); \
 }
 
 #define TEST_CLOSE_FILE() { \
@@ -131,6 +131,7 @@ typedef struct {
     char *gds_mode;
     int nservers;
     uint32_t lsize;
+    int emulate;
 } test_params;
 
 #define INIT_TEST_PARAMS(params) do { \
@@ -164,6 +165,7 @@ typedef struct {
     params.gds_mode = NULL;           \
     params.nservers = 1;              \
     params.lsize = 0;                 \
+    params.emulate = 0;               \
 } while (0)
 
 #define FREE_TEST_PARAMS(params) do { \
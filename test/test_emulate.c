@@ -0,0 +1,690 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <src/include/pmix_config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "src/include/pmix_globals.h"
+#include "src/mca/bfrops/base/base.h"
+#include "src/mca/ptl/base/base.h"
+
+#include "cli_stages.h"
+#include "test_common.h"
+#include "test_emulate.h"
+
+typedef enum {
+    EMU_CONNECT, EMU_JOBINFO, EMU_REGEVENTS, EMU_COMMIT, EMU_FENCE,
+    EMU_GET, EMU_NOTIFY, EMU_FINALIZE, EMU_DONE, EMU_FAILED
+} emu_state_t;
+
+typedef struct {
+    pmix_proc_t proc;
+    int nsize;
+    int cli;
+    int sd;
+    uint32_t pindex;
+    volatile emu_state_t state;
+    uint32_t tag;
+    bool notified;
+    bool reaped;
+    /* the message being read */
+    pmix_ptl_hdr_t hdr;
+    size_t hdrbytes;
+    char *data;
+    size_t rdbytes;
+} emu_peer_t;
+
+typedef struct {
+    pthread_t thread;
+    int first;
+    int npeers;
+} emu_thread_t;
+
+static emu_peer_t *peers = NULL;
+static int npeers = 0;
+static int maxpeers = 0;
+static emu_thread_t *threads = NULL;
+static int nthreads = 0;
+static int collect_data = 0;
+static volatile bool emu_stop = false;
+static pthread_mutex_t emu_lock = PTHREAD_MUTEX_INITIALIZER;
+static int nready = 0;
+
+static char *server_uri = NULL;
+static char *bfrops_version = NULL;
+/* gives the pack/unpack routines the bfrops the server expects */
+static pmix_peer_t *emu_server = NULL;
+
+int emu_init(int n)
+{
+    peers = (emu_peer_t*)calloc(n, sizeof(emu_peer_t));
+    if (NULL == peers) {
+        return PMIX_ERR_NOMEM;
+    }
+    maxpeers = n;
+    return PMIX_SUCCESS;
+}
+
+int emu_add_peer(const pmix_proc_t *proc, int nsize, int cli_idx, char **env)
+{
+    emu_peer_t *p;
+    char *evar = NULL;
+    int n, m;
+
+    if (npeers == maxpeers) {
+        return PMIX_ERR_OUT_OF_RESOURCE;
+    }
+
+    /* all peers use the same server, so get the uri once */
+    if (NULL == server_uri) {
+        const char *vars[] = {"PMIX_SERVER_URI3=", "PMIX_SERVER_URI21=", "PMIX_SERVER_URI2=", NULL};
+        const char *bfrops[] = {"v3", "v21", "v20", NULL};
+        for (n=0; NULL == evar && NULL != vars[n]; n++) {
+            for (m=0; NULL != env[m]; m++) {
+                if (0 == strncmp(env[m], vars[n], strlen(vars[n]))) {
+                    evar = env[m] + strlen(vars[n]);
+                    break;
+                }
+            }
+        }
+        if (NULL == evar) {
+            TEST_ERROR(("No tcp server URI given to clients - cannot emulate"));
+            return PMIX_ERR_NOT_SUPPORTED;
+        }
+        --n;
+        /* the uri is "<server nspace>.<rank>;<rendezvous>" */
+        if (NULL == (evar = strchr(evar, ';'))) {
+            TEST_ERROR(("Bad server URI - cannot emulate"));
+            return PMIX_ERR_BAD_PARAM;
+        }
+        server_uri = strdup(evar + 1);
+        bfrops_version = strdup(bfrops[n]);
+    }
+
+    p = &peers[npeers++];
+    memcpy(&p->proc, proc, sizeof(pmix_proc_t));
+    p->nsize = nsize;
+    p->cli = cli_idx;
+    p->sd = -1;
+    p->state = EMU_CONNECT;
+    return PMIX_SUCCESS;
+}
+
+static int emu_connect(emu_peer_t *p)
+{
+    struct sockaddr_storage addr;
+    struct sockaddr_in *in;
+    struct sockaddr_in6 *in6;
+    pmix_ptl_hdr_t hdr;
+    pmix_bfrop_buffer_type_t bftype;
+    char *host, *port, *msg, *sec = "native", *gds = "hash";
+    size_t len, csize;
+    uint32_t u32, creds[2];
+    uint8_t flag = 0;
+    pmix_status_t rc;
+
+    /* parse the rendezvous point */
+    memset(&addr, 0, sizeof(addr));
+    host = strdup(server_uri + 7);
+    if (NULL == (port = strrchr(host, ':'))) {
+        free(host);
+        return PMIX_ERR_BAD_PARAM;
+    }
+    *port++ = '\0';
+    if (0 == strncmp(server_uri, "tcp4", 4)) {
+        in = (struct sockaddr_in*)&addr;
+        in->sin_family = AF_INET;
+        in->sin_addr.s_addr = inet_addr(host);
+        in->sin_port = htons(atoi(port));
+        len = sizeof(struct sockaddr_in);
+    } else {
+        if (']' == host[strlen(host)-1]) {
+            host[strlen(host)-1] = '\0';
+        }
+        in6 = (struct sockaddr_in6*)&addr;
+        in6->sin6_family = AF_INET6;
+        if (0 == inet_pton(AF_INET6, ('[' == host[0]) ? host + 1 : host, &in6->sin6_addr)) {
+            free(host);
+            return PMIX_ERR_BAD_PARAM;
+        }
+        in6->sin6_port = htons(atoi(port));
+        len = sizeof(struct sockaddr_in6);
+    }
+    free(host);
+
+    if (PMIX_SUCCESS != (rc = pmix_ptl_base_connect(&addr, len, &p->sd))) {
+        return rc;
+    }
+
+    /* send the same connect request a simple client sends - the
+     * native psec credential over tcp is just our uid/gid */
+    creds[0] = geteuid();
+    creds[1] = getegid();
+    bftype = emu_server->nptr->compat.type;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.pindex = -1;
+    hdr.tag = UINT32_MAX;
+    hdr.nbytes = strlen(sec) + 1 + sizeof(uint32_t) + sizeof(creds) + 1 +
+                 strlen(p->proc.nspace) + 1 + sizeof(uint32_t) +
+                 strlen(PMIX_VERSION) + 1 + strlen(bfrops_version) + 1 +
+                 sizeof(bftype) + strlen(gds) + 1;
+    msg = (char*)calloc(1, sizeof(hdr) + hdr.nbytes);
+    if (NULL == msg) {
+        return PMIX_ERR_NOMEM;
+    }
+    memcpy(msg, &hdr, sizeof(hdr));
+    csize = sizeof(hdr);
+    memcpy(msg+csize, sec, strlen(sec));
+    csize += strlen(sec) + 1;
+    u32 = htonl(sizeof(creds));
+    memcpy(msg+csize, &u32, sizeof(uint32_t));
+    csize += sizeof(uint32_t);
+    memcpy(msg+csize, creds, sizeof(creds));
+    csize += sizeof(creds);
+    memcpy(msg+csize, &flag, 1);
+    csize += 1;
+    memcpy(msg+csize, p->proc.nspace, strlen(p->proc.nspace));
+    csize += strlen(p->proc.nspace) + 1;
+    u32 = htonl(p->proc.rank);
+    memcpy(msg+csize, &u32, sizeof(uint32_t));
+    csize += sizeof(uint32_t);
+    memcpy(msg+csize, PMIX_VERSION, strlen(PMIX_VERSION));
+    csize += strlen(PMIX_VERSION) + 1;
+    memcpy(msg+csize, bfrops_version, strlen(bfrops_version));
+    csize += strlen(bfrops_version) + 1;
+    memcpy(msg+csize, &bftype, sizeof(bftype));
+    csize += sizeof(bftype);
+    memcpy(msg+csize, gds, strlen(gds));
+    csize += strlen(gds) + 1;
+
+    rc = pmix_ptl_base_send_blocking(p->sd, msg, csize);
+    free(msg);
+    if (PMIX_SUCCESS != rc) {
+        return rc;
+    }
+
+    /* the server answers with a status and, if all is well,
+     * our index in its client array */
+    if (PMIX_SUCCESS != (rc = pmix_ptl_base_recv_blocking(p->sd, (char*)&u32, sizeof(uint32_t)))) {
+        return rc;
+    }
+    if (PMIX_SUCCESS != (rc = (pmix_status_t)ntohl(u32))) {
+        return rc;
+    }
+    if (PMIX_SUCCESS != (rc = pmix_ptl_base_recv_blocking(p->sd, (char*)&u32, sizeof(uint32_t)))) {
+        return rc;
+    }
+    p->pindex = ntohl(u32);
+    return PMIX_SUCCESS;
+}
+
+static int emu_send(emu_peer_t *p, pmix_buffer_t *buf)
+{
+    pmix_ptl_hdr_t hdr;
+    int rc;
+
+    /* every peer has at most one request outstanding */
+    p->tag = PMIX_PTL_TAG_DYNAMIC;
+    hdr.pindex = htonl(p->pindex);
+    hdr.tag = htonl(p->tag);
+    hdr.nbytes = htonl(buf->bytes_used);
+    /* the server never blocks on us, so a blocking send is fine */
+    pmix_ptl_base_set_blocking(p->sd);
+    rc = pmix_ptl_base_send_blocking(p->sd, (char*)&hdr, sizeof(hdr));
+    if (PMIX_SUCCESS == rc) {
+        rc = pmix_ptl_base_send_blocking(p->sd, buf->base_ptr, buf->bytes_used);
+    }
+    pmix_ptl_base_set_nonblocking(p->sd);
+    return rc;
+}
+
+/* pack and send the request for the state the peer is entering */
+static int emu_request(emu_peer_t *p)
+{
+    pmix_buffer_t buf, bkt;
+    pmix_cmd_t cmd;
+    pmix_status_t rc, code = EMU_EVENT;
+    pmix_scope_t scope = PMIX_GLOBAL;
+    pmix_kval_t kv;
+    pmix_value_t val;
+    pmix_proc_t wildcard;
+    pmix_info_t info;
+    size_t n;
+    char *nsp;
+    pmix_rank_t rank;
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    switch (p->state) {
+    case EMU_JOBINFO:
+        cmd = PMIX_REQ_CMD;
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &cmd, 1, PMIX_COMMAND);
+        break;
+
+    case EMU_REGEVENTS:
+        cmd = PMIX_REGEVENTS_CMD;
+        n = 1;
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &cmd, 1, PMIX_COMMAND);
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &n, 1, PMIX_SIZE);
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &code, 1, PMIX_STATUS);
+        n = 0;
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &n, 1, PMIX_SIZE);
+        break;
+
+    case EMU_COMMIT:
+        cmd = PMIX_COMMIT_CMD;
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &cmd, 1, PMIX_COMMAND);
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &scope, 1, PMIX_SCOPE);
+        PMIX_CONSTRUCT(&bkt, pmix_buffer_t);
+        kv.key = "emu.key";
+        kv.value = &val;
+        val.type = PMIX_UINT32;
+        val.data.uint32 = p->proc.rank;
+        PMIX_BFROPS_PACK(rc, emu_server, &bkt, &kv, 1, PMIX_KVAL);
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &bkt, 1, PMIX_BUFFER);
+        PMIX_DESTRUCT(&bkt);
+        break;
+
+    case EMU_FENCE:
+        cmd = PMIX_FENCENB_CMD;
+        PMIX_LOAD_PROCID(&wildcard, p->proc.nspace, PMIX_RANK_WILDCARD);
+        n = 1;
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &cmd, 1, PMIX_COMMAND);
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &n, 1, PMIX_SIZE);
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &wildcard, 1, PMIX_PROC);
+        if (collect_data) {
+            PMIX_INFO_LOAD(&info, PMIX_COLLECT_DATA, NULL, PMIX_BOOL);
+            PMIX_BFROPS_PACK(rc, emu_server, &buf, &n, 1, PMIX_SIZE);
+            PMIX_BFROPS_PACK(rc, emu_server, &buf, &info, 1, PMIX_INFO);
+            PMIX_INFO_DESTRUCT(&info);
+        } else {
+            n = 0;
+            PMIX_BFROPS_PACK(rc, emu_server, &buf, &n, 1, PMIX_SIZE);
+        }
+        break;
+
+    case EMU_GET:
+        /* ask for our right-hand neighbor's data */
+        cmd = PMIX_GETNB_CMD;
+        nsp = p->proc.nspace;
+        rank = (p->proc.rank + 1) % (pmix_rank_t)p->nsize;
+        n = 0;
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &cmd, 1, PMIX_COMMAND);
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &nsp, 1, PMIX_STRING);
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &rank, 1, PMIX_PROC_RANK);
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &n, 1, PMIX_SIZE);
+        break;
+
+    case EMU_FINALIZE:
+        cmd = PMIX_FINALIZE_CMD;
+        PMIX_BFROPS_PACK(rc, emu_server, &buf, &cmd, 1, PMIX_COMMAND);
+        break;
+
+    default:
+        rc = PMIX_ERR_BAD_PARAM;
+        break;
+    }
+
+    if (PMIX_SUCCESS == rc) {
+        rc = emu_send(p, &buf);
+    }
+    PMIX_DESTRUCT(&buf);
+    return rc;
+}
+
+static void emu_notify_cb(pmix_status_t status, void *cbdata)
+{
+    if (PMIX_SUCCESS != status) {
+        TEST_ERROR(("Emulated event notification failed: %d", status));
+        test_abort = true;
+    }
+}
+
+/* all peers are registered and have done their fence and get, so
+ * generate the event they are waiting on */
+static void emu_ready(void)
+{
+    bool all;
+
+    pthread_mutex_lock(&emu_lock);
+    all = (++nready == npeers);
+    pthread_mutex_unlock(&emu_lock);
+    if (all) {
+        TEST_VERBOSE(("All %d virtual peers ready - notifying", npeers));
+        PMIx_Notify_event(EMU_EVENT, &pmix_globals.myid, PMIX_RANGE_LOCAL,
+                          NULL, 0, emu_notify_cb, NULL);
+    }
+}
+
+static void emu_fail(emu_peer_t *p, int rc)
+{
+    TEST_ERROR(("Virtual peer %s:%d failed in state %d: %d",
+                p->proc.nspace, p->proc.rank, p->state, rc));
+    if (0 <= p->sd) {
+        close(p->sd);
+        p->sd = -1;
+    }
+    p->state = EMU_FAILED;
+}
+
+/* a complete message has arrived for the peer */
+static void emu_recv(emu_peer_t *p)
+{
+    pmix_buffer_t buf;
+    pmix_cmd_t cmd;
+    pmix_status_t rc, ret = PMIX_SUCCESS;
+    int32_t cnt;
+
+    PMIX_CONSTRUCT(&buf, pmix_buffer_t);
+    PMIX_BFROPS_ASSIGN_TYPE(emu_server, &buf);
+    PMIX_LOAD_BUFFER(emu_server, &buf, p->data, p->hdr.nbytes);
+    p->data = NULL;
+
+    if (PMIX_PTL_TAG_NOTIFY == p->hdr.tag) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, emu_server, &buf, &cmd, &cnt, PMIX_COMMAND);
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            PMIX_BFROPS_UNPACK(rc, emu_server, &buf, &ret, &cnt, PMIX_STATUS);
+        }
+        if (PMIX_SUCCESS == rc && EMU_EVENT == ret) {
+            p->notified = true;
+        }
+        PMIX_DESTRUCT(&buf);
+        if (p->notified && EMU_NOTIFY == p->state) {
+            goto next;
+        }
+        return;
+    }
+    if (p->hdr.tag != p->tag) {
+        PMIX_DESTRUCT(&buf);
+        emu_fail(p, PMIX_ERR_BAD_PARAM);
+        return;
+    }
+    /* everything but the job info reply leads with a status */
+    if (EMU_JOBINFO != p->state) {
+        cnt = 1;
+        PMIX_BFROPS_UNPACK(rc, emu_server, &buf, &ret, &cnt, PMIX_STATUS);
+        if (PMIX_SUCCESS != rc) {
+            ret = rc;
+        }
+    }
+    PMIX_DESTRUCT(&buf);
+    if (PMIX_SUCCESS != ret) {
+        emu_fail(p, ret);
+        return;
+    }
+    if (EMU_FINALIZE == p->state) {
+        close(p->sd);
+        p->sd = -1;
+        p->state = EMU_DONE;
+        return;
+    }
+
+    p->state++;
+    if (EMU_NOTIFY == p->state) {
+        emu_ready();
+        if (!p->notified) {
+            return;
+        }
+    } else {
+        goto send;
+    }
+
+  next:
+    p->state = EMU_FINALIZE;
+  send:
+    if (PMIX_SUCCESS != (rc = emu_request(p))) {
+        emu_fail(p, rc);
+    }
+}
+
+/* read whatever is available on the peer's socket */
+static void emu_read(emu_peer_t *p)
+{
+    ssize_t rc;
+
+    while (0 <= p->sd) {
+        if (p->hdrbytes < sizeof(pmix_ptl_hdr_t)) {
+            rc = read(p->sd, (char*)&p->hdr + p->hdrbytes,
+                      sizeof(pmix_ptl_hdr_t) - p->hdrbytes);
+        } else {
+            rc = read(p->sd, p->data + p->rdbytes, p->hdr.nbytes - p->rdbytes);
+        }
+        if (0 > rc) {
+            if (EAGAIN == errno || EWOULDBLOCK == errno) {
+                return;
+            }
+            if (EINTR == errno) {
+                continue;
+            }
+            emu_fail(p, PMIX_ERR_UNREACH);
+            return;
+        }
+        if (0 == rc) {
+            emu_fail(p, PMIX_ERR_UNREACH);
+            return;
+        }
+        if (p->hdrbytes < sizeof(pmix_ptl_hdr_t)) {
+            p->hdrbytes += rc;
+            if (p->hdrbytes < sizeof(pmix_ptl_hdr_t)) {
+                continue;
+            }
+            p->hdr.pindex = ntohl(p->hdr.pindex);
+            p->hdr.tag = ntohl(p->hdr.tag);
+            p->hdr.nbytes = ntohl(p->hdr.nbytes);
+            p->rdbytes = 0;
+            p->data = (char*)malloc(p->hdr.nbytes + 1);
+            if (NULL == p->data) {
+                emu_fail(p, PMIX_ERR_NOMEM);
+                return;
+            }
+        } else {
+            p->rdbytes += rc;
+        }
+        if (p->rdbytes == p->hdr.nbytes) {
+            p->hdrbytes = 0;
+            emu_recv(p);
+        }
+    }
+}
+
+static void* emu_thread(void *arg)
+{
+    emu_thread_t *t = (emu_thread_t*)arg;
+    emu_peer_t *p;
+    struct pollfd *fds;
+    int n, m, nfds, rc;
+
+    fds = (struct pollfd*)calloc(t->npeers, sizeof(struct pollfd));
+    if (NULL == fds) {
+        TEST_ERROR(("Out of memory"));
+        test_abort = true;
+        return NULL;
+    }
+
+    /* connect all of our peers - with a thread per block of peers
+     * this is as close to a storm as one process can manage */
+    for (n=0; n < t->npeers && !emu_stop; n++) {
+        p = &peers[t->first + n];
+        if (PMIX_SUCCESS != (rc = emu_connect(p))) {
+            emu_fail(p, rc);
+            continue;
+        }
+        pmix_ptl_base_set_nonblocking(p->sd);
+        p->state = EMU_JOBINFO;
+        if (PMIX_SUCCESS != (rc = emu_request(p))) {
+            emu_fail(p, rc);
+        }
+    }
+
+    while (!emu_stop) {
+        nfds = 0;
+        for (n=0; n < t->npeers; n++) {
+            p = &peers[t->first + n];
+            if (0 <= p->sd) {
+                fds[nfds].fd = p->sd;
+                fds[nfds].events = POLLIN;
+                fds[nfds].revents = 0;
+                nfds++;
+            }
+        }
+        if (0 == nfds) {
+            break;
+        }
+        rc = poll(fds, nfds, 100);
+        if (0 >= rc) {
+            continue;
+        }
+        for (n=0, m=0; n < t->npeers && m < nfds; n++) {
+            p = &peers[t->first + n];
+            if (0 > p->sd || p->sd != fds[m].fd) {
+                continue;
+            }
+            if (0 != fds[m].revents) {
+                emu_read(p);
+            }
+            m++;
+        }
+    }
+
+    /* drop whatever is left if we were told to stop */
+    for (n=0; n < t->npeers; n++) {
+        p = &peers[t->first + n];
+        if (0 <= p->sd) {
+            close(p->sd);
+            p->sd = -1;
+        }
+        if (NULL != p->data) {
+            free(p->data);
+            p->data = NULL;
+        }
+    }
+    free(fds);
+    return NULL;
+}
+
+int emu_start(int n, int collect)
+{
+    int i, per, extra, first;
+
+    if (0 == npeers) {
+        return PMIX_SUCCESS;
+    }
+    collect_data = collect;
+
+    emu_server = PMIX_NEW(pmix_peer_t);
+    emu_server->nptr = PMIX_NEW(pmix_namespace_t);
+    emu_server->nptr->compat.bfrops = pmix_bfrops_base_assign_module(bfrops_version);
+    if (NULL == emu_server->nptr->compat.bfrops) {
+        TEST_ERROR(("No %s bfrops module - cannot emulate", bfrops_version));
+        return PMIX_ERR_NOT_SUPPORTED;
+    }
+    emu_server->nptr->compat.type = pmix_bfrops_globals.default_type;
+
+    nthreads = (n < npeers) ? n : npeers;
+    threads = (emu_thread_t*)calloc(nthreads, sizeof(emu_thread_t));
+    if (NULL == threads) {
+        return PMIX_ERR_NOMEM;
+    }
+    per = npeers / nthreads;
+    extra = npeers % nthreads;
+    first = 0;
+    for (i=0; i < nthreads; i++) {
+        threads[i].first = first;
+        threads[i].npeers = per + ((i < extra) ? 1 : 0);
+        first += threads[i].npeers;
+    }
+    TEST_VERBOSE(("Emulating %d peers on %d threads", npeers, nthreads));
+    for (i=0; i < nthreads; i++) {
+        if (0 != pthread_create(&threads[i].thread, NULL, emu_thread, &threads[i])) {
+            TEST_ERROR(("Cannot start emulator thread"));
+            emu_stop = true;
+            nthreads = i;
+            return PMIX_ERROR;
+        }
+    }
+    return PMIX_SUCCESS;
+}
+
+void emu_reap(void)
+{
+    emu_peer_t *p;
+    int n;
+
+    for (n=0; n < npeers; n++) {
+        p = &peers[n];
+        if (p->reaped) {
+            continue;
+        }
+        /* wait for the server to have told the host about the
+         * finalize before calling the peer terminated */
+        if (EMU_FAILED == p->state ||
+            (EMU_DONE == p->state && CLI_FIN == cli_info[p->cli].state)) {
+            p->reaped = true;
+            cli_cleanup(&cli_info[p->cli]);
+        }
+    }
+}
+
+bool emu_active(void)
+{
+    int n;
+
+    for (n=0; n < npeers; n++) {
+        if (!peers[n].reaped) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void emu_finalize(void)
+{
+    int n;
+
+    emu_stop = true;
+    for (n=0; n < nthreads; n++) {
+        pthread_join(threads[n].thread, NULL);
+    }
+    if (NULL != threads) {
+        free(threads);
+        threads = NULL;
+    }
+    nthreads = 0;
+    if (NULL != peers) {
+        free(peers);
+        peers = NULL;
+    }
+    npeers = 0;
+    maxpeers = 0;
+    if (NULL != emu_server) {
+        PMIX_RELEASE(emu_server);
+        emu_server = NULL;
+    }
+    if (NULL != server_uri) {
+        free(server_uri);
+        server_uri = NULL;
+    }
+    if (NULL != bfrops_version) {
+        free(bfrops_version);
+        bfrops_version = NULL;
+    }
+}
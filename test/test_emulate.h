@@ -0,0 +1,42 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2018      Intel, Inc. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef TEST_EMULATE_H
+#define TEST_EMULATE_H
+
+#include <src/include/pmix_config.h>
+#include <pmix_common.h>
+
+/* Scale emulation: instead of forking a client process per rank,
+ * each local rank is played by a "virtual peer" - a socket speaking
+ * the client side of the ptl wire protocol to our own server. Many
+ * virtual peers are driven by each emulator thread, so a single box
+ * can put 10k+ clients on one server. Every peer connects, fetches
+ * its job info, registers for an event, commits a key, joins a
+ * job-wide fence, gets its neighbor's key, waits for the event that
+ * is generated once all peers are ready, and then finalizes */
+
+/* the event the virtual peers wait on */
+#define EMU_EVENT   (PMIX_EXTERNAL_ERR_BASE - 50)
+
+int emu_init(int npeers);
+/* add a virtual peer for the given client of an nspace with nsize
+ * procs - the env is the one PMIx_server_setup_fork filled in for it */
+int emu_add_peer(const pmix_proc_t *proc, int nsize, int cli_idx, char **env);
+/* start the given number of threads driving the peers */
+int emu_start(int nthreads, int collect);
+/* cleanup the cli_info entries of any virtual peers that are done */
+void emu_reap(void);
+/* true if any virtual peer is still running */
+bool emu_active(void);
+/* stop the threads and release everything */
+void emu_finalize(void);
+
+#endif // TEST_EMULATE_H
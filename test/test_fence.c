@@ -175,6 +175,12 @@ int test_fence(test_params params, char *my_nspace, pmix_rank_t my_rank)
                     for (i = 0; i < nranks; i++) {
                         participant_t *prt;
                         prt = PMIX_NEW(participant_t);
+                        if (NULL == prt) {
+                            TEST_ERROR(("%s:%d: Out of memory expanding the participants of namespace %s", my_nspace, my_rank, p->proc.nspace));
+                            PMIX_PROC_FREE(ranks, nranks);
+                            PMIX_LIST_DESTRUCT(&test_fences);
+                            return PMIX_ERROR;
+                        }
                         strncpy(prt->proc.nspace, ranks[i].nspace, strlen(ranks[i].nspace)+1);
                         prt->proc.rank = ranks[i].rank;
                         pmix_list_append(desc->participants, &prt->super);
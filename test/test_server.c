@@ -24,6 +24,7 @@
 
 #include "test_server.h"
 #include "test_common.h"
+#include "test_emulate.h"
 #include "cli_stages.h"
 #include "server_callbacks.h"
 
@@ -220,6 +221,10 @@ static void server_unpack_procs(char *buf, size_t size)
             }
             if (NULL == ns_item) {
                 ns_item = PMIX_NEW(server_nspace_t);
+                if (NULL == ns_item) {
+                    TEST_ERROR(("Out of memory unpacking nspace %s", nspace));
+                    return;
+                }
                 memcpy(ns_item->name, nspace, PMIX_MAX_NSLEN);
                 pmix_list_append(server_nspace, &ns_item->super);
                 ns_item->ltasks = ltasks;
@@ -942,6 +947,21 @@ int server_launch_clients(int local_size, int univ_size, int base_rank,
             return 0;
         }
 
+        if (0 < params->emulate) {
+            /* no process - the emulator plays this client */
+            cli_info[cli_counter].rank = proc.rank;
+            cli_info[cli_counter].ns = strdup(proc.nspace);
+            if (PMIX_SUCCESS != emu_add_peer(&proc, univ_size, cli_counter, *client_env)) {
+                PMIx_server_finalize();
+                cli_kill_all();
+                return 0;
+            }
+            cli_info[cli_counter].state = CLI_FORKED;
+            cli_counter++;
+            rank_counter++;
+            continue;
+        }
+
         cli_info[cli_counter].pid = fork();
         if (cli_info[cli_counter].pid < 0) {
             TEST_ERROR(("Fork failed"));